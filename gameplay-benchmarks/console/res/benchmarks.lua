@@ -0,0 +1,32 @@
+-- Lua functions for the script binding benchmarks.
+-- Each function except empty() makes 100 binding calls.
+
+function empty()
+end
+
+function vectorLength()
+    local sum = 0
+    for i = 1, 100 do
+        sum = sum + Vector3.new(i, 2, 3):length()
+    end
+    return sum
+end
+
+function matrixMultiply()
+    local m = Matrix.new()
+    local r = Matrix.new()
+    Matrix.createRotationY(0.1, r)
+    for i = 1, 100 do
+        m:multiply(r)
+    end
+    return m:determinant()
+end
+
+function gameGetWidth()
+    local game = Game.getInstance()
+    local sum = 0
+    for i = 1, 100 do
+        sum = sum + game:getWidth()
+    end
+    return sum
+end
@@ -0,0 +1,110 @@
+#include "ConsoleBenchmarks.h"
+#include "SyntheticBundle.h"
+
+// The number of points of the benchmarked curves, and the times evaluated per iteration.
+#define CURVE_POINT_COUNT       8
+#define CURVE_SAMPLE_COUNT      64
+
+static const char* __interpolationTypeNames[] =
+{
+    "BEZIER", "BSPLINE", "FLAT", "HERMITE", "LINEAR", "SMOOTH", "STEP",
+    "QUADRATIC_IN", "QUADRATIC_OUT", "QUADRATIC_IN_OUT", "QUADRATIC_OUT_IN",
+    "CUBIC_IN", "CUBIC_OUT", "CUBIC_IN_OUT", "CUBIC_OUT_IN",
+    "QUARTIC_IN", "QUARTIC_OUT", "QUARTIC_IN_OUT", "QUARTIC_OUT_IN",
+    "QUINTIC_IN", "QUINTIC_OUT", "QUINTIC_IN_OUT", "QUINTIC_OUT_IN",
+    "SINE_IN", "SINE_OUT", "SINE_IN_OUT", "SINE_OUT_IN",
+    "EXPONENTIAL_IN", "EXPONENTIAL_OUT", "EXPONENTIAL_IN_OUT", "EXPONENTIAL_OUT_IN",
+    "CIRCULAR_IN", "CIRCULAR_OUT", "CIRCULAR_IN_OUT", "CIRCULAR_OUT_IN",
+    "ELASTIC_IN", "ELASTIC_OUT", "ELASTIC_IN_OUT", "ELASTIC_OUT_IN",
+    "OVERSHOOT_IN", "OVERSHOOT_OUT", "OVERSHOOT_IN_OUT", "OVERSHOOT_OUT_IN",
+    "BOUNCE_IN", "BOUNCE_OUT", "BOUNCE_IN_OUT", "BOUNCE_OUT_IN"
+};
+
+static void curveEvaluate(benchmark::State& state, Curve::InterpolationType type)
+{
+    // A curve of 4 components, as for a quaternion or color.
+    Curve* curve = Curve::create(CURVE_POINT_COUNT, 4);
+    for (unsigned int i = 0; i < CURVE_POINT_COUNT; ++i)
+    {
+        float value[4] = { (float)i, (float)(i % 2), 1.0f - (float)i, 0.5f };
+        float tangent[4] = { 1.0f, -1.0f, 0.5f, 0.0f };
+        curve->setPoint(i, (float)i / (CURVE_POINT_COUNT - 1), value, type, tangent, tangent);
+    }
+
+    float dst[4];
+    while (state.KeepRunning())
+    {
+        for (unsigned int i = 0; i < CURVE_SAMPLE_COUNT; ++i)
+        {
+            curve->evaluate((float)i / (CURVE_SAMPLE_COUNT - 1), dst);
+        }
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * CURVE_SAMPLE_COUNT);
+
+    SAFE_RELEASE(curve);
+}
+
+// Registers a benchmark of each interpolation type.
+static class CurveBenchmarks
+{
+public:
+
+    CurveBenchmarks()
+    {
+        unsigned int count = sizeof(__interpolationTypeNames) / sizeof(__interpolationTypeNames[0]);
+        GP_ASSERT(count == Curve::BOUNCE_OUT_IN + 1);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            std::string name = std::string("Curve::evaluate/") + __interpolationTypeNames[i];
+            benchmark::RegisterBenchmark(name.c_str(), &curveEvaluate, (Curve::InterpolationType)i);
+        }
+    }
+} __curveBenchmarks;
+
+static void meshSkinGetMatrixPalette(benchmark::State& state)
+{
+    unsigned int jointCount = (unsigned int)state.range(0);
+
+    SyntheticBundle synthetic;
+    synthetic.addScene("scene", 0, 1, jointCount, 4);
+    if (!synthetic.write("skin.gpb"))
+    {
+        state.SkipWithError("Failed to write the bundle.");
+        return;
+    }
+
+    Bundle* bundle = Bundle::create("skin.gpb");
+    Scene* scene = bundle ? bundle->loadScene("scene") : NULL;
+    SAFE_RELEASE(bundle);
+    Node* node = scene ? scene->findNode("character0_mesh") : NULL;
+    Node* root = scene ? scene->findNode("character0_joint0") : NULL;
+    if (!node || !root || !node->getModel() || !node->getModel()->getSkin())
+    {
+        state.SkipWithError("Failed to load the skinned character.");
+        SAFE_RELEASE(scene);
+        return;
+    }
+
+    // Moving the root joint dirties every joint, so the whole palette is recomputed.
+    MeshSkin* skin = node->getModel()->getSkin();
+    while (state.KeepRunning())
+    {
+        root->rotateY(0.01f);
+        benchmark::DoNotOptimize(skin->getMatrixPalette());
+    }
+    state.SetItemsProcessed(state.iterations() * jointCount);
+
+    SAFE_RELEASE(scene);
+}
+
+// Registers a benchmark of each skeleton size.
+static class MeshSkinBenchmarks
+{
+public:
+
+    MeshSkinBenchmarks()
+    {
+        benchmark::RegisterBenchmark("MeshSkin::getMatrixPalette", &meshSkinGetMatrixPalette)->Arg(16)->Arg(64);
+    }
+} __meshSkinBenchmarks;
@@ -0,0 +1,140 @@
+#include "ConsoleBenchmarks.h"
+#include "SyntheticBundle.h"
+
+static void propertiesCreate(benchmark::State& state)
+{
+    unsigned int namespaceCount = (unsigned int)state.range(0);
+
+    // A file of material-like namespaces, each with nested technique and pass namespaces.
+    FILE* file = FileSystem::openFile("benchmark.properties", "w");
+    if (file == NULL)
+    {
+        state.SkipWithError("Failed to write the properties file.");
+        return;
+    }
+    for (unsigned int i = 0; i < namespaceCount; ++i)
+    {
+        fprintf(file, "material material%u\n{\n", i);
+        fprintf(file, "    u_worldViewProjectionMatrix = WORLD_VIEW_PROJECTION_MATRIX\n");
+        fprintf(file, "    u_inverseTransposeWorldViewMatrix = INVERSE_TRANSPOSE_WORLD_VIEW_MATRIX\n");
+        fprintf(file, "    u_diffuseColor = 1.0, %u.5, 0.0, 1.0\n", i % 10);
+        fprintf(file, "    technique\n    {\n        pass\n        {\n");
+        fprintf(file, "            vertexShader = res/shaders/colored.vert\n");
+        fprintf(file, "            fragmentShader = res/shaders/colored.frag\n");
+        fprintf(file, "            renderState\n            {\n");
+        fprintf(file, "                cullFace = true\n                depthTest = true\n");
+        fprintf(file, "            }\n        }\n    }\n}\n");
+    }
+    fclose(file);
+
+    while (state.KeepRunning())
+    {
+        Properties* properties = Properties::create("benchmark.properties");
+        SAFE_DELETE(properties);
+    }
+    state.SetItemsProcessed(state.iterations() * namespaceCount);
+}
+
+static void bundleLoadScene(benchmark::State& state)
+{
+    unsigned int characterCount = (unsigned int)state.range(0);
+
+    SyntheticBundle synthetic;
+    synthetic.addScene("scene", characterCount * 4, characterCount, 16, 8);
+    if (!synthetic.write("scene.gpb"))
+    {
+        state.SkipWithError("Failed to write the bundle.");
+        return;
+    }
+
+    Bundle* bundle = Bundle::create("scene.gpb");
+    if (bundle == NULL)
+    {
+        state.SkipWithError("Failed to open the bundle.");
+        return;
+    }
+
+    while (state.KeepRunning())
+    {
+        Scene* scene = bundle->loadScene("scene");
+        SAFE_RELEASE(scene);
+    }
+    state.SetItemsProcessed(state.iterations() * characterCount * 5);
+
+    SAFE_RELEASE(bundle);
+}
+
+static void bundleLoadNode(benchmark::State& state)
+{
+    unsigned int jointCount = (unsigned int)state.range(0);
+
+    SyntheticBundle synthetic;
+    synthetic.addScene("scene", 1, 1, jointCount, 8);
+    if (!synthetic.write("node.gpb"))
+    {
+        state.SkipWithError("Failed to write the bundle.");
+        return;
+    }
+
+    Bundle* bundle = Bundle::create("node.gpb");
+    if (bundle == NULL)
+    {
+        state.SkipWithError("Failed to open the bundle.");
+        return;
+    }
+
+    // The character node loads its joint hierarchy and skinned model.
+    while (state.KeepRunning())
+    {
+        Node* node = bundle->loadNode("character0");
+        SAFE_RELEASE(node);
+    }
+    state.SetItemsProcessed(state.iterations() * (jointCount + 2));
+
+    SAFE_RELEASE(bundle);
+}
+
+static void fontMeasureText(benchmark::State& state)
+{
+    SyntheticBundle synthetic;
+    synthetic.addFont("font", 32);
+    if (!synthetic.write("font.gpb"))
+    {
+        state.SkipWithError("Failed to write the bundle.");
+        return;
+    }
+
+    Font* font = Font::create("font.gpb");
+    if (font == NULL)
+    {
+        state.SkipWithError("Failed to load the font.");
+        return;
+    }
+
+    const char* text =
+        "The quick brown fox jumps over the lazy dog.\n"
+        "Pack my box with five dozen liquor jugs!\n"
+        "How vexingly quick daft zebras jump; 0123456789.";
+    unsigned int width, height;
+    while (state.KeepRunning())
+    {
+        font->measureText(text, 24, &width, &height);
+    }
+    state.SetItemsProcessed(state.iterations() * strlen(text));
+
+    SAFE_RELEASE(font);
+}
+
+// Registers the asset benchmarks at a few sizes.
+static class AssetBenchmarks
+{
+public:
+
+    AssetBenchmarks()
+    {
+        benchmark::RegisterBenchmark("Properties::create", &propertiesCreate)->Arg(10)->Arg(100);
+        benchmark::RegisterBenchmark("Bundle::loadScene", &bundleLoadScene)->Arg(1)->Arg(16);
+        benchmark::RegisterBenchmark("Bundle::loadNode", &bundleLoadNode)->Arg(16)->Arg(64);
+        benchmark::RegisterBenchmark("Font::measureText", &fontMeasureText);
+    }
+} __assetBenchmarks;
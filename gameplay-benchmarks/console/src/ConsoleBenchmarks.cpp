@@ -0,0 +1,44 @@
+#include "ConsoleBenchmarks.h"
+
+// Declare our game instance
+ConsoleBenchmarks game;
+
+ConsoleBenchmarks::ConsoleBenchmarks()
+{
+}
+
+void ConsoleBenchmarks::initialize()
+{
+    benchmark::RunSpecifiedBenchmarks();
+    exit();
+}
+
+void ConsoleBenchmarks::finalize()
+{
+}
+
+void ConsoleBenchmarks::update(float elapsedTime)
+{
+}
+
+void ConsoleBenchmarks::render(float elapsedTime)
+{
+}
+
+/**
+ * Main entry point.
+ */
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    // The headless platform runs the game without a window or graphics context.
+    Platform* platform = Platform::create(&game);
+    if (platform == NULL)
+        return 1;
+    int result = platform->enterMessagePump();
+    delete platform;
+    return result;
+}
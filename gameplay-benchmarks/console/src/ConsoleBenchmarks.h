@@ -0,0 +1,58 @@
+#ifndef CONSOLEBENCHMARKS_H_
+#define CONSOLEBENCHMARKS_H_
+
+#include "gameplay.h"
+#include <benchmark/benchmark.h>
+
+using namespace gameplay;
+
+/**
+ * Runs the microbenchmarks of the engine, using Google Benchmark.
+ *
+ * The game runs on the headless platform and the null renderer of GLCapture, so the benchmarks
+ * have every engine system, and can create meshes, textures and effects, without a window or a
+ * GPU. The game.config next to the executable selects the null renderer and makes the systems
+ * that the benchmarks do not use lazy. The command line takes the options of Google Benchmark,
+ * such as:
+ * @code
+ * gameplay-benchmarks-console --benchmark_filter=Bundle:: --benchmark_out=benchmarks.json
+ * @endcode
+ *
+ * The benchmarks run from the first frame, after which the game exits. The frame benchmarks of
+ * whole scenes, which measure the GPU, are run by the windowed gameplay-benchmarks game.
+ */
+class ConsoleBenchmarks : public Game
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    ConsoleBenchmarks();
+
+protected:
+
+    /**
+     * Runs the benchmarks and exits.
+     *
+     * @see Game::initialize
+     */
+    void initialize();
+
+    /**
+     * @see Game::finalize
+     */
+    void finalize();
+
+    /**
+     * @see Game::update
+     */
+    void update(float elapsedTime);
+
+    /**
+     * @see Game::render
+     */
+    void render(float elapsedTime);
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "ConsoleBenchmarks.h"
+
+static void matrixMultiply(benchmark::State& state)
+{
+    Matrix m1, m2, dst;
+    Matrix::createRotation(Vector3(1, 2, 3).normalize(), 0.5f, &m1);
+    Matrix::createLookAt(Vector3(0, 5, 10), Vector3::zero(), Vector3::unitY(), &m2);
+    while (state.KeepRunning())
+    {
+        Matrix::multiply(m1, m2, &dst);
+        m1.m[12] = dst.m[0];
+    }
+}
+
+static void matrixInvert(benchmark::State& state)
+{
+    Matrix m, dst;
+    Matrix::createLookAt(Vector3(0, 5, 10), Vector3::zero(), Vector3::unitY(), &m);
+    while (state.KeepRunning())
+    {
+        m.invert(&dst);
+        m.m[12] = dst.m[0];
+    }
+}
+
+static void matrixDecompose(benchmark::State& state)
+{
+    Matrix m;
+    Matrix::createScale(1.0f, 2.0f, 3.0f, &m);
+    m.rotate(Vector3(1, 2, 3).normalize(), 0.5f);
+    m.translate(4.0f, 5.0f, 6.0f);
+
+    Vector3 scale, translation;
+    Quaternion rotation;
+    while (state.KeepRunning())
+    {
+        m.decompose(&scale, &rotation, &translation);
+        benchmark::DoNotOptimize(translation);
+    }
+}
+
+// Creates the frustum of a typical perspective camera and a grid of bounds around it,
+// so some volumes are inside, some outside and some intersect the frustum.
+static Frustum createFrustum()
+{
+    Matrix projection, view, viewProjection;
+    Matrix::createPerspective(60.0f, 16.0f / 9.0f, 1.0f, 100.0f, &projection);
+    Matrix::createLookAt(Vector3(0, 10, 20), Vector3::zero(), Vector3::unitY(), &view);
+    Matrix::multiply(projection, view, &viewProjection);
+    return Frustum(viewProjection);
+}
+
+#define FRUSTUM_BOUNDS_SIDE 32
+
+static void frustumIntersectsSphere(benchmark::State& state)
+{
+    Frustum frustum = createFrustum();
+    std::vector<BoundingSphere> spheres;
+    for (int z = 0; z < FRUSTUM_BOUNDS_SIDE; ++z)
+    {
+        for (int x = 0; x < FRUSTUM_BOUNDS_SIDE; ++x)
+        {
+            spheres.push_back(BoundingSphere(Vector3((float)(x - FRUSTUM_BOUNDS_SIDE / 2) * 4.0f, 0.0f, (float)(z - FRUSTUM_BOUNDS_SIDE / 2) * 4.0f), 1.5f));
+        }
+    }
+
+    unsigned int visible = 0;
+    while (state.KeepRunning())
+    {
+        for (unsigned int i = 0, count = spheres.size(); i < count; ++i)
+        {
+            if (frustum.intersects(spheres[i]))
+                ++visible;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(state.iterations() * spheres.size());
+}
+
+static void frustumIntersectsBox(benchmark::State& state)
+{
+    Frustum frustum = createFrustum();
+    std::vector<BoundingBox> boxes;
+    for (int z = 0; z < FRUSTUM_BOUNDS_SIDE; ++z)
+    {
+        for (int x = 0; x < FRUSTUM_BOUNDS_SIDE; ++x)
+        {
+            Vector3 center((float)(x - FRUSTUM_BOUNDS_SIDE / 2) * 4.0f, 0.0f, (float)(z - FRUSTUM_BOUNDS_SIDE / 2) * 4.0f);
+            boxes.push_back(BoundingBox(center - Vector3::one(), center + Vector3::one()));
+        }
+    }
+
+    unsigned int visible = 0;
+    while (state.KeepRunning())
+    {
+        for (unsigned int i = 0, count = boxes.size(); i < count; ++i)
+        {
+            if (frustum.intersects(boxes[i]))
+                ++visible;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+// Registers the math benchmarks under the names of the functions they measure.
+static class MathBenchmarks
+{
+public:
+
+    MathBenchmarks()
+    {
+        benchmark::RegisterBenchmark("Matrix::multiply", &matrixMultiply);
+        benchmark::RegisterBenchmark("Matrix::invert", &matrixInvert);
+        benchmark::RegisterBenchmark("Matrix::decompose", &matrixDecompose);
+        benchmark::RegisterBenchmark("Frustum::intersects/BoundingSphere", &frustumIntersectsSphere);
+        benchmark::RegisterBenchmark("Frustum::intersects/BoundingBox", &frustumIntersectsBox);
+    }
+} __mathBenchmarks;
@@ -0,0 +1,58 @@
+#include "ConsoleBenchmarks.h"
+
+// The duration of a simulated frame (in milliseconds).
+#define PARTICLE_FRAME_TIME     16.0f
+
+// The time simulated before timing starts, longer than the energy of a particle (in milliseconds).
+#define PARTICLE_WARMUP_TIME    2000.0f
+
+static void particleEmitterUpdate(benchmark::State& state)
+{
+    unsigned int emissionRate = (unsigned int)state.range(0);
+
+    // Emitters are culled against the active camera of their scene.
+    Scene* scene = Scene::createScene();
+    Camera* camera = Camera::createPerspective(45.0f, 16.0f / 9.0f, 0.25f, 100.0f);
+    Node* cameraNode = scene->addNode("camera");
+    cameraNode->setCamera(camera);
+    cameraNode->translate(0.0f, 5.0f, 30.0f);
+    scene->setActiveCamera(camera);
+    SAFE_RELEASE(camera);
+
+    ParticleEmitter* emitter = ParticleEmitter::create("res/spark.particle");
+    if (emitter == NULL)
+    {
+        state.SkipWithError("Failed to create the emitter.");
+        SAFE_RELEASE(scene);
+        return;
+    }
+    scene->addNode("emitter")->setParticleEmitter(emitter);
+    emitter->setEmissionRate(emissionRate);
+    emitter->start();
+
+    // Fill the emitter to its steady state, where particles die as fast as they are emitted.
+    for (float time = 0; time < PARTICLE_WARMUP_TIME; time += PARTICLE_FRAME_TIME)
+    {
+        emitter->update(PARTICLE_FRAME_TIME);
+    }
+
+    while (state.KeepRunning())
+    {
+        emitter->update(PARTICLE_FRAME_TIME);
+    }
+    state.SetItemsProcessed(state.iterations() * emitter->getParticlesCount());
+
+    SAFE_RELEASE(emitter);
+    SAFE_RELEASE(scene);
+}
+
+// Registers a benchmark of each emission rate.
+static class ParticleBenchmarks
+{
+public:
+
+    ParticleBenchmarks()
+    {
+        benchmark::RegisterBenchmark("ParticleEmitter::update", &particleEmitterUpdate)->Arg(100)->Arg(1000)->Arg(5000);
+    }
+} __particleBenchmarks;
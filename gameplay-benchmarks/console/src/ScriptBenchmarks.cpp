@@ -0,0 +1,40 @@
+#include "ConsoleBenchmarks.h"
+
+// The number of binding calls made by each of the Lua benchmark functions.
+#define SCRIPT_CALLS_PER_FUNCTION 100
+
+static void scriptExecuteFunction(benchmark::State& state)
+{
+    ScriptController* sc = Game::getInstance()->getScriptController();
+    sc->loadScript("res/benchmarks.lua");
+    while (state.KeepRunning())
+    {
+        sc->executeFunction<void>("empty");
+    }
+}
+
+// Runs a Lua function that makes a number of calls to the bindings of an engine class.
+static void scriptBindings(benchmark::State& state, const char* function)
+{
+    ScriptController* sc = Game::getInstance()->getScriptController();
+    sc->loadScript("res/benchmarks.lua");
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(sc->executeFunction<float>(function));
+    }
+    state.SetItemsProcessed(state.iterations() * SCRIPT_CALLS_PER_FUNCTION);
+}
+
+// Registers the script benchmarks.
+static class ScriptBenchmarks
+{
+public:
+
+    ScriptBenchmarks()
+    {
+        benchmark::RegisterBenchmark("ScriptController::executeFunction", &scriptExecuteFunction);
+        benchmark::RegisterBenchmark("Lua/Vector3", &scriptBindings, "vectorLength");
+        benchmark::RegisterBenchmark("Lua/Matrix", &scriptBindings, "matrixMultiply");
+        benchmark::RegisterBenchmark("Lua/Game", &scriptBindings, "gameGetWidth");
+    }
+} __scriptBenchmarks;
@@ -0,0 +1,45 @@
+#include "BenchmarkGame.h"
+
+// Declare our game instance
+BenchmarkGame game;
+
+BenchmarkGame::BenchmarkGame()
+    : _sceneRunner(NULL)
+{
+}
+
+BenchmarkGame::~BenchmarkGame()
+{
+}
+
+void BenchmarkGame::initialize()
+{
+    // The scene benchmarks run over the frames that follow.
+    Properties* sceneConfig = getConfig()->getNamespace("sceneBenchmarks", true);
+    if (sceneConfig)
+        _sceneRunner = SceneRunner::create(sceneConfig);
+    else
+        exit();
+}
+
+void BenchmarkGame::finalize()
+{
+    SAFE_DELETE(_sceneRunner);
+}
+
+void BenchmarkGame::update(float elapsedTime)
+{
+    if (_sceneRunner && !_sceneRunner->update(elapsedTime))
+    {
+        SAFE_DELETE(_sceneRunner);
+        exit();
+    }
+}
+
+void BenchmarkGame::render(float elapsedTime)
+{
+    if (_sceneRunner)
+        _sceneRunner->render(elapsedTime);
+    else
+        clear(CLEAR_COLOR_DEPTH, Vector4::zero(), 1.0f, 0);
+}
@@ -0,0 +1,59 @@
+#ifndef BENCHMARKGAME_H_
+#define BENCHMARKGAME_H_
+
+#include "gameplay.h"
+
+using namespace gameplay;
+
+#include "SceneRunner.h"
+
+/**
+ * Runs the scene benchmarks over the frames of the game, writes their results and exits.
+ *
+ * The scene benchmarks are run when game.config has a sceneBenchmarks section. The
+ * microbenchmarks of the engine, which need no GPU, are in the console executable under console/.
+ *
+ * @see SceneRunner
+ */
+class BenchmarkGame: public Game
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    BenchmarkGame();
+
+    /**
+     * Destructor.
+     */
+    virtual ~BenchmarkGame();
+
+protected:
+
+    /**
+     * @see Game::initialize
+     */
+    void initialize();
+
+    /**
+     * @see Game::finalize
+     */
+    void finalize();
+
+    /**
+     * @see Game::update
+     */
+    void update(float elapsedTime);
+
+    /**
+     * @see Game::render
+     */
+    void render(float elapsedTime);
+
+private:
+
+    SceneRunner* _sceneRunner;
+};
+
+#endif
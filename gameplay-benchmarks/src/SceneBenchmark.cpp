@@ -0,0 +1,96 @@
+#include "SceneBenchmark.h"
+
+SceneBenchmark::SceneBenchmark(const std::string& name, const std::string& resourcePath)
+    : _scene(NULL), _name(name), _resourcePath(resourcePath)
+{
+}
+
+SceneBenchmark::~SceneBenchmark()
+{
+    SAFE_RELEASE(_scene);
+}
+
+const char* SceneBenchmark::getName() const
+{
+    return _name.c_str();
+}
+
+const char* SceneBenchmark::getResourcePath() const
+{
+    return _resourcePath.c_str();
+}
+
+void SceneBenchmark::update(float elapsedTime)
+{
+}
+
+void SceneBenchmark::render(float elapsedTime)
+{
+    Game::getInstance()->clear(Game::CLEAR_COLOR_DEPTH, Vector4::zero(), 1.0f, 0);
+    if (_scene)
+        _scene->visit(this, &SceneBenchmark::drawNode);
+}
+
+void SceneBenchmark::unload()
+{
+    SAFE_RELEASE(_scene);
+}
+
+bool SceneBenchmark::drawNode(Node* node)
+{
+    Model* model = node->getModel();
+    if (model)
+        model->draw();
+    ParticleEmitter* emitter = node->getParticleEmitter();
+    if (emitter)
+        emitter->draw();
+    return true;
+}
+
+Material* SceneBenchmark::createColoredMaterial(const Vector4& color, unsigned int jointCount)
+{
+    std::string defines;
+    if (jointCount > 0)
+    {
+        char buffer[64];
+        sprintf(buffer, "SKINNING;SKINNING_JOINT_COUNT %u", jointCount);
+        defines = buffer;
+    }
+
+    Material* material = Material::create("res/shaders/colored.vert", "res/shaders/colored.frag", defines.empty() ? NULL : defines.c_str());
+    if (material == NULL)
+        return NULL;
+
+    material->setParameterAutoBinding("u_worldViewProjectionMatrix", RenderState::WORLD_VIEW_PROJECTION_MATRIX);
+    material->setParameterAutoBinding("u_inverseTransposeWorldViewMatrix", RenderState::INVERSE_TRANSPOSE_WORLD_VIEW_MATRIX);
+    if (jointCount > 0)
+        material->setParameterAutoBinding("u_matrixPalette", RenderState::MATRIX_PALETTE);
+    material->getParameter("u_diffuseColor")->setValue(color);
+    material->getParameter("u_ambientColor")->setValue(Vector3(0.2f, 0.2f, 0.2f));
+    material->getParameter("u_lightColor")->setValue(Vector3(0.8f, 0.8f, 0.8f));
+    material->getParameter("u_lightDirection")->setValue(Vector3(0.0f, -0.7071f, -0.7071f));
+    material->getStateBlock()->setDepthTest(true);
+    material->getStateBlock()->setCullFace(true);
+    return material;
+}
+
+void SceneBenchmark::addCamera(Scene* scene, const Vector3& position, const Vector3& target)
+{
+    GP_ASSERT(scene);
+
+    Game* game = Game::getInstance();
+    Camera* camera = Camera::createPerspective(45.0f, (float)game->getWidth() / (float)game->getHeight(), 0.25f, 1000.0f);
+    Node* node = scene->addNode("benchmarkCamera");
+    node->setCamera(camera);
+    scene->setActiveCamera(camera);
+    SAFE_RELEASE(camera);
+
+    // The camera node is placed with the inverse of the view matrix.
+    Matrix view;
+    Matrix::createLookAt(position, target, Vector3::unitY(), &view);
+    view.invert();
+    Vector3 scale, translation;
+    Quaternion rotation;
+    view.decompose(&scale, &rotation, &translation);
+    node->set(scale, rotation, translation);
+}
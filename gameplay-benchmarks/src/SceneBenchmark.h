@@ -0,0 +1,130 @@
+#ifndef SCENEBENCHMARK_H_
+#define SCENEBENCHMARK_H_
+
+#include "gameplay.h"
+
+using namespace gameplay;
+
+/**
+ * Defines a workload for the scene benchmark runner.
+ *
+ * A scene benchmark loads a scene, then updates and draws it every frame like a
+ * game would, while the runner records the cost of each frame. Workloads either
+ * load the assets of one of the samples, or build a synthetic scene of a given size.
+ *
+ * @see SceneRunner
+ */
+class SceneBenchmark
+{
+public:
+
+    /**
+     * Destructor.
+     */
+    virtual ~SceneBenchmark();
+
+    /**
+     * Gets the name of the benchmark, as written to the results.
+     *
+     * @return The name of the benchmark.
+     */
+    const char* getName() const;
+
+    /**
+     * Gets the directory the assets of the benchmark are loaded from.
+     *
+     * @return The path of the directory relative to the resource path of the game,
+     *      or the empty string for the resource path itself.
+     */
+    const char* getResourcePath() const;
+
+    /**
+     * Loads the scene of the benchmark.
+     *
+     * Called with the resource path of the benchmark set.
+     *
+     * @return true if the scene was loaded.
+     */
+    virtual bool load() = 0;
+
+    /**
+     * Updates the scene of the benchmark.
+     *
+     * The default implementation does nothing, since the animation, physics and AI
+     * controllers update the scene by themselves.
+     *
+     * @param elapsedTime The elapsed game time of the frame (in milliseconds).
+     */
+    virtual void update(float elapsedTime);
+
+    /**
+     * Draws the scene of the benchmark.
+     *
+     * The default implementation draws every model and particle emitter in the scene.
+     *
+     * @param elapsedTime The elapsed game time of the frame (in milliseconds).
+     */
+    virtual void render(float elapsedTime);
+
+    /**
+     * Releases the scene of the benchmark.
+     */
+    virtual void unload();
+
+    /**
+     * Creates the scene benchmarks: one for each sample, and one for each size of each synthetic workload.
+     *
+     * @param samplesPath The path of the gameplay-samples directory relative to the resource path of the game.
+     * @param counts The numbers of characters, emitters and rigid bodies of the synthetic workloads.
+     * @param benchmarks The list to add the benchmarks to. The caller owns the benchmarks.
+     */
+    static void createAll(const char* samplesPath, const std::vector<unsigned int>& counts, std::vector<SceneBenchmark*>& benchmarks);
+
+protected:
+
+    /**
+     * Constructor.
+     *
+     * @param name The name of the benchmark.
+     * @param resourcePath The directory the assets of the benchmark are loaded from, or the empty string.
+     */
+    SceneBenchmark(const std::string& name, const std::string& resourcePath);
+
+    /**
+     * Creates a lit, solid colored material.
+     *
+     * The light is fixed in view space, so the material does not depend on a light in the scene.
+     *
+     * @param color The diffuse color.
+     * @param jointCount The number of joints of the skin of the model, or zero if it is not skinned.
+     *
+     * @return The new material.
+     */
+    static Material* createColoredMaterial(const Vector4& color, unsigned int jointCount = 0);
+
+    /**
+     * Adds a perspective camera looking at a point to a scene, and makes it the active camera.
+     *
+     * @param scene The scene.
+     * @param position The position of the camera.
+     * @param target The point the camera looks at.
+     */
+    static void addCamera(Scene* scene, const Vector3& position, const Vector3& target);
+
+    /**
+     * The scene of the benchmark.
+     */
+    Scene* _scene;
+
+private:
+
+    SceneBenchmark(const SceneBenchmark& copy);
+    SceneBenchmark& operator=(const SceneBenchmark&);
+
+    bool drawNode(Node* node);
+
+    std::string _name;
+    std::string _resourcePath;
+};
+
+#endif
@@ -0,0 +1,557 @@
+#include "SceneBenchmark.h"
+#include "SyntheticBundle.h"
+
+// The number of joints of each synthetic character.
+#define CHARACTER_JOINT_COUNT   24
+
+// The number of quads along each side of the mesh of a synthetic character.
+#define CHARACTER_RESOLUTION    8
+
+// The number of particles emitted per second by each synthetic emitter.
+#define EMITTER_EMISSION_RATE   200
+
+// The number of rigid bodies in each column of the synthetic stacks.
+#define RIGID_BODY_STACK_HEIGHT 10
+
+// Converts an integer to a string for building names and ids.
+static std::string toString(unsigned int value)
+{
+    char buffer[16];
+    sprintf(buffer, "%u", value);
+    return buffer;
+}
+
+// The number of columns of a square grid of the given number of items.
+static unsigned int getGridColumns(unsigned int count)
+{
+    return std::max(1u, (unsigned int)ceil(sqrt((float)count)));
+}
+
+/**
+ * The duck of sample00-mesh, spinning.
+ */
+class MeshSample : public SceneBenchmark
+{
+public:
+
+    MeshSample(const std::string& samplesPath)
+        : SceneBenchmark("sample00-mesh", samplesPath + "sample00-mesh/"), _modelNode(NULL)
+    {
+    }
+
+    bool load()
+    {
+        Bundle* bundle = Bundle::create("res/duck.gpb");
+        if (bundle == NULL)
+            return false;
+        _scene = bundle->loadScene();
+        SAFE_RELEASE(bundle);
+
+        _modelNode = _scene ? _scene->findNode("duck") : NULL;
+        if (_modelNode == NULL || _modelNode->getModel() == NULL || _scene->getActiveCamera() == NULL)
+            return false;
+
+        Material* material = _modelNode->getModel()->setMaterial("res/duck.material");
+        Node* lightNode = _scene->findNode("directionalLight1");
+        if (material == NULL || lightNode == NULL)
+            return false;
+        material->getParameter("u_lightDirection")->bindValue(lightNode, &Node::getForwardVectorView);
+
+        Game* game = Game::getInstance();
+        _scene->getActiveCamera()->setAspectRatio((float)game->getWidth() / (float)game->getHeight());
+        return true;
+    }
+
+    void update(float elapsedTime)
+    {
+        _modelNode->rotateY(elapsedTime * MATH_DEG_TO_RAD(0.05f));
+    }
+
+private:
+
+    Node* _modelNode;
+};
+
+/**
+ * The textured ground and board of sample01-longboard, with the ground turning under the board.
+ */
+class LongboardSample : public SceneBenchmark
+{
+public:
+
+    LongboardSample(const std::string& samplesPath)
+        : SceneBenchmark("sample01-longboard", samplesPath + "sample01-longboard/"), _groundNode(NULL)
+    {
+    }
+
+    bool load()
+    {
+        _scene = Scene::createScene();
+        addCamera(_scene, Vector3(0.0f, 1.75f, 1.35f), Vector3(0.0f, 0.0f, -0.15f));
+
+        _groundNode = addQuad("ground", 20.0f, 20.0f, 0.0f, "res/asphalt.png", 10.0f);
+        return _groundNode &&
+            addQuad("board", 0.5f, 1.0f, 0.1f, "res/longboard.png", 1.0f) &&
+            addQuad("wheels", 0.5f, 0.25f, 0.025f, "res/longboard_wheels.png", 1.0f);
+    }
+
+    void update(float elapsedTime)
+    {
+        _groundNode->rotateY(elapsedTime * MATH_DEG_TO_RAD(0.01f));
+    }
+
+private:
+
+    Node* addQuad(const char* id, float halfWidth, float halfDepth, float height, const char* texturePath, float repeat)
+    {
+        Mesh* mesh = Mesh::createQuad(Vector3(-halfWidth, height, -halfDepth), Vector3(-halfWidth, height, halfDepth),
+                                      Vector3(halfWidth, height, -halfDepth), Vector3(halfWidth, height, halfDepth));
+        Model* model = Model::create(mesh);
+        SAFE_RELEASE(mesh);
+
+        Material* material = model->setMaterial("res/shaders/textured-unlit.vert", "res/shaders/textured-unlit.frag", "TEXTURE_REPEAT;TEXTURE_OFFSET");
+        if (material == NULL)
+        {
+            SAFE_RELEASE(model);
+            return NULL;
+        }
+        material->setParameterAutoBinding("u_worldViewProjectionMatrix", RenderState::WORLD_VIEW_PROJECTION_MATRIX);
+        Texture::Sampler* sampler = material->getParameter("u_diffuseTexture")->setValue(texturePath, true);
+        if (sampler)
+            sampler->setWrapMode(Texture::REPEAT, Texture::REPEAT);
+        material->getParameter("u_textureRepeat")->setValue(Vector2(repeat, repeat));
+        material->getParameter("u_textureOffset")->setValue(Vector2::zero());
+        material->getStateBlock()->setCullFace(true);
+        material->getStateBlock()->setBlend(true);
+        material->getStateBlock()->setBlendSrc(RenderState::BLEND_SRC_ALPHA);
+        material->getStateBlock()->setBlendDst(RenderState::BLEND_ONE_MINUS_SRC_ALPHA);
+
+        Node* node = _scene->addNode(id);
+        node->setModel(model);
+        SAFE_RELEASE(model);
+        return node;
+    }
+
+    Node* _groundNode;
+};
+
+/**
+ * The spaceship of sample02-spaceship, drawn with solid colored materials and turning.
+ */
+class SpaceshipSample : public SceneBenchmark
+{
+public:
+
+    SpaceshipSample(const std::string& samplesPath)
+        : SceneBenchmark("sample02-spaceship", samplesPath + "sample02-spaceship/"), _shipNode(NULL)
+    {
+    }
+
+    bool load()
+    {
+        Bundle* bundle = Bundle::create("res/spaceship.gpb");
+        if (bundle == NULL)
+            return false;
+        _scene = bundle->loadScene();
+        SAFE_RELEASE(bundle);
+
+        _shipNode = _scene ? _scene->findNode("gSpaceShip") : NULL;
+        if (_shipNode == NULL || _scene->getActiveCamera() == NULL)
+            return false;
+
+        Game* game = Game::getInstance();
+        _scene->getActiveCamera()->setAspectRatio((float)game->getWidth() / (float)game->getHeight());
+        _scene->visit(this, &SpaceshipSample::setMaterial);
+        return true;
+    }
+
+    void update(float elapsedTime)
+    {
+        _shipNode->rotateY(elapsedTime * MATH_DEG_TO_RAD(0.02f));
+    }
+
+private:
+
+    bool setMaterial(Node* node)
+    {
+        Model* model = node->getModel();
+        if (model)
+        {
+            Material* material = createColoredMaterial(Vector4(0.6f, 0.6f, 0.6f, 1.0f));
+            model->setMaterial(material);
+            SAFE_RELEASE(material);
+        }
+        return true;
+    }
+
+    Node* _shipNode;
+};
+
+/**
+ * The room of sample03-character, with physics, and the boy playing his idle animation.
+ */
+class CharacterSample : public SceneBenchmark
+{
+public:
+
+    CharacterSample(const std::string& samplesPath)
+        : SceneBenchmark("sample03-character", samplesPath + "sample03-character/")
+    {
+    }
+
+    bool load()
+    {
+        // The scene refers to its textures through the aliases of the sample's config.
+        FileSystem::loadResourceAliases("game.png.config");
+        _scene = Scene::load("res/common/scene.scene");
+        if (_scene == NULL || _scene->getActiveCamera() == NULL)
+            return false;
+
+        Game* game = Game::getInstance();
+        _scene->getActiveCamera()->setAspectRatio((float)game->getWidth() / (float)game->getHeight());
+        _scene->visit(this, &CharacterSample::bindLight);
+
+        Node* character = _scene->findNode("boycharacter");
+        Animation* animation = character ? character->getAnimation("animations") : NULL;
+        if (animation == NULL)
+            return false;
+        animation->createClips("res/common/boy.animation");
+        animation->play("idle");
+        return true;
+    }
+
+private:
+
+    bool bindLight(Node* node)
+    {
+        Model* model = node->getModel();
+        Node* lightNode = _scene->findNode("sun");
+        if (model && model->getMaterial() && node->isDynamic() && lightNode)
+        {
+            Material* material = model->getMaterial();
+            material->getParameter("u_ambientColor")->bindValue(_scene, &Scene::getAmbientColor);
+            material->getParameter("u_lightColor")->bindValue(lightNode->getLight(), &Light::getColor);
+            material->getParameter("u_lightDirection")->bindValue(lightNode, &Node::getForwardVectorView);
+        }
+        return true;
+    }
+};
+
+/**
+ * The fire, smoke and explosion emitters of sample04-particles, side by side.
+ */
+class ParticlesSample : public SceneBenchmark
+{
+public:
+
+    ParticlesSample(const std::string& samplesPath)
+        : SceneBenchmark("sample04-particles", samplesPath + "sample04-particles/")
+    {
+    }
+
+    bool load()
+    {
+        static const char* paths[] = { "res/fire.particle", "res/smoke.particle", "res/explosion.particle" };
+
+        _scene = Scene::createScene();
+        addCamera(_scene, Vector3(0.0f, 5.0f, 40.0f), Vector3::zero());
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            ParticleEmitter* emitter = ParticleEmitter::create(paths[i]);
+            if (emitter == NULL)
+                return false;
+            Node* node = _scene->addNode();
+            node->setTranslation((float)i * 15.0f - 15.0f, 0.0f, 0.0f);
+            node->setParticleEmitter(emitter);
+            emitter->start();
+            SAFE_RELEASE(emitter);
+        }
+        return true;
+    }
+
+    void update(float elapsedTime)
+    {
+        _scene->visit(this, &ParticlesSample::updateEmitter, elapsedTime);
+    }
+
+private:
+
+    bool updateEmitter(Node* node, float elapsedTime)
+    {
+        if (node->getParticleEmitter())
+            node->getParticleEmitter()->update(elapsedTime);
+        return true;
+    }
+};
+
+/**
+ * The game script of sample05-lua, run through its initialize, update, render and finalize functions.
+ */
+class LuaSample : public SceneBenchmark
+{
+public:
+
+    LuaSample(const std::string& samplesPath)
+        : SceneBenchmark("sample05-lua", samplesPath + "sample05-lua/")
+    {
+    }
+
+    bool load()
+    {
+        ScriptController* sc = Game::getInstance()->getScriptController();
+        sc->loadScript("res/game.lua");
+        sc->executeFunction<void>("initialize");
+        return true;
+    }
+
+    void update(float elapsedTime)
+    {
+        Game::getInstance()->getScriptController()->executeFunction<void>("update", "f", elapsedTime);
+    }
+
+    void render(float elapsedTime)
+    {
+        Game::getInstance()->getScriptController()->executeFunction<void>("render", "f", elapsedTime);
+    }
+
+    void unload()
+    {
+        Game::getInstance()->getScriptController()->executeFunction<void>("finalize");
+    }
+};
+
+/**
+ * A grid of synthetic skinned characters, each playing a looping animation of all its joints.
+ */
+class CharactersScene : public SceneBenchmark
+{
+public:
+
+    CharactersScene(unsigned int count)
+        : SceneBenchmark("characters/" + toString(count), ""), _count(count)
+    {
+    }
+
+    bool load()
+    {
+        std::string path = "characters" + toString(_count) + ".gpb";
+        SyntheticBundle synthetic;
+        synthetic.addScene("scene", 0, _count, CHARACTER_JOINT_COUNT, CHARACTER_RESOLUTION);
+        if (!synthetic.write(path.c_str()))
+            return false;
+
+        Bundle* bundle = Bundle::create(path.c_str());
+        if (bundle == NULL)
+            return false;
+        _scene = bundle->loadScene("scene");
+        SAFE_RELEASE(bundle);
+        if (_scene == NULL)
+            return false;
+
+        float extent = (float)getGridColumns(_count) * 2.0f;
+        addCamera(_scene, Vector3(extent * 0.5f, extent * 0.5f + CHARACTER_JOINT_COUNT, extent * 0.5f + 10.0f), Vector3(extent * 0.5f, 0.0f, -extent * 0.5f));
+
+        for (unsigned int i = 0; i < _count; ++i)
+        {
+            std::string id = "character" + toString(i);
+            Node* meshNode = _scene->findNode((id + "_mesh").c_str());
+            Node* rootJoint = _scene->findNode((id + "_joint0").c_str());
+            Animation* animation = rootJoint ? rootJoint->getAnimation((id + "_animation").c_str()) : NULL;
+            if (meshNode == NULL || meshNode->getModel() == NULL || animation == NULL)
+                return false;
+
+            Material* material = createColoredMaterial(Vector4(0.8f, 0.5f, 0.3f, 1.0f), CHARACTER_JOINT_COUNT);
+            meshNode->getModel()->setMaterial(material);
+            SAFE_RELEASE(material);
+
+            animation->getClip()->setRepeatCount(AnimationClip::REPEAT_INDEFINITE);
+            animation->play();
+        }
+        return true;
+    }
+
+private:
+
+    unsigned int _count;
+};
+
+/**
+ * A grid of particle emitters.
+ */
+class EmittersScene : public SceneBenchmark
+{
+public:
+
+    EmittersScene(unsigned int count)
+        : SceneBenchmark("emitters/" + toString(count), ""), _count(count)
+    {
+    }
+
+    bool load()
+    {
+        _scene = Scene::createScene();
+        unsigned int columns = getGridColumns(_count);
+        float extent = (float)columns * 10.0f;
+        addCamera(_scene, Vector3(0.0f, extent * 0.5f, extent), Vector3::zero());
+
+        for (unsigned int i = 0; i < _count; ++i)
+        {
+            ParticleEmitter* emitter = ParticleEmitter::create("res/spark.particle");
+            if (emitter == NULL)
+                return false;
+            Node* node = _scene->addNode();
+            node->setTranslation((float)(i % columns) * 10.0f - extent * 0.5f, 0.0f, (float)(i / columns) * -10.0f);
+            node->setParticleEmitter(emitter);
+            emitter->setEmissionRate(EMITTER_EMISSION_RATE);
+            emitter->start();
+            SAFE_RELEASE(emitter);
+        }
+        return true;
+    }
+
+    void update(float elapsedTime)
+    {
+        _scene->visit(this, &EmittersScene::updateEmitter, elapsedTime);
+    }
+
+private:
+
+    bool updateEmitter(Node* node, float elapsedTime)
+    {
+        if (node->getParticleEmitter())
+            node->getParticleEmitter()->update(elapsedTime);
+        return true;
+    }
+
+    unsigned int _count;
+};
+
+/**
+ * Stacks of boxes falling onto a static ground.
+ */
+class RigidBodiesScene : public SceneBenchmark
+{
+public:
+
+    RigidBodiesScene(unsigned int count)
+        : SceneBenchmark("rigidbodies/" + toString(count), ""), _count(count)
+    {
+    }
+
+    bool load()
+    {
+        _scene = Scene::createScene();
+        unsigned int columns = getGridColumns((_count + RIGID_BODY_STACK_HEIGHT - 1) / RIGID_BODY_STACK_HEIGHT);
+        float extent = (float)columns * 3.0f;
+        addCamera(_scene, Vector3(0.0f, extent + RIGID_BODY_STACK_HEIGHT, extent * 1.5f + 10.0f), Vector3::zero());
+
+        Mesh* mesh = createCubeMesh();
+        bool loaded = addBody("ground", mesh, Vector3(0.0f, -0.5f, 0.0f), Vector3(extent * 4.0f, 1.0f, extent * 4.0f), 0.0f);
+        for (unsigned int i = 0; i < _count && loaded; ++i)
+        {
+            // Slightly offset the boxes of each stack so they topple.
+            unsigned int stack = i / RIGID_BODY_STACK_HEIGHT;
+            unsigned int level = i % RIGID_BODY_STACK_HEIGHT;
+            Vector3 position((float)(stack % columns) * 3.0f - extent * 0.5f + (float)(level % 2) * 0.3f,
+                             0.5f + (float)level * 1.1f,
+                             (float)(stack / columns) * -3.0f);
+            loaded = addBody(NULL, mesh, position, Vector3::one(), 1.0f);
+        }
+        SAFE_RELEASE(mesh);
+        return loaded;
+    }
+
+private:
+
+    bool addBody(const char* id, Mesh* mesh, const Vector3& position, const Vector3& size, float mass)
+    {
+        Model* model = Model::create(mesh);
+        Material* material = createColoredMaterial(mass > 0 ? Vector4(0.3f, 0.5f, 0.8f, 1.0f) : Vector4(0.5f, 0.5f, 0.5f, 1.0f));
+        if (material == NULL)
+        {
+            SAFE_RELEASE(model);
+            return false;
+        }
+        model->setMaterial(material);
+        SAFE_RELEASE(material);
+
+        Node* node = _scene->addNode(id);
+        node->setModel(model);
+        SAFE_RELEASE(model);
+        node->setScale(size);
+        node->setTranslation(position);
+
+        PhysicsRigidBody::Parameters parameters;
+        parameters.mass = mass;
+        parameters.friction = 0.5f;
+        parameters.restitution = 0.2f;
+        return node->setCollisionObject(PhysicsCollisionObject::RIGID_BODY, PhysicsCollisionShape::box(), &parameters) != NULL;
+    }
+
+    // Creates a unit cube with a normal per face.
+    static Mesh* createCubeMesh()
+    {
+        static const float normals[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+        float vertices[24 * 6];
+        unsigned short indices[36];
+        float* v = vertices;
+        for (unsigned int face = 0; face < 6; ++face)
+        {
+            Vector3 normal(normals[face][0], normals[face][1], normals[face][2]);
+            Vector3 u(normal.y, normal.z, normal.x);
+            Vector3 w;
+            Vector3::cross(normal, u, &w);
+            for (unsigned int corner = 0; corner < 4; ++corner)
+            {
+                float s = (corner & 1) ? 0.5f : -0.5f;
+                float t = (corner & 2) ? 0.5f : -0.5f;
+                Vector3 position = normal * 0.5f + u * s + w * t;
+                *v++ = position.x;
+                *v++ = position.y;
+                *v++ = position.z;
+                *v++ = normal.x;
+                *v++ = normal.y;
+                *v++ = normal.z;
+            }
+            unsigned short base = (unsigned short)(face * 4);
+            unsigned short faceIndices[6] = { base, (unsigned short)(base + 1), (unsigned short)(base + 2), (unsigned short)(base + 2), (unsigned short)(base + 1), (unsigned short)(base + 3) };
+            memcpy(&indices[face * 6], faceIndices, sizeof(faceIndices));
+        }
+
+        VertexFormat::Element elements[] =
+        {
+            VertexFormat::Element(VertexFormat::POSITION, 3),
+            VertexFormat::Element(VertexFormat::NORMAL, 3)
+        };
+        Mesh* mesh = Mesh::createMesh(VertexFormat(elements, 2), 24, false);
+        mesh->setVertexData(vertices, 0, 24);
+        MeshPart* part = mesh->addPart(Mesh::TRIANGLES, Mesh::INDEX16, 36, false);
+        part->setIndexData(indices, 0, 36);
+        mesh->setBoundingBox(BoundingBox(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f)));
+        mesh->setBoundingSphere(BoundingSphere(Vector3::zero(), 0.866f));
+        return mesh;
+    }
+
+    unsigned int _count;
+};
+
+void SceneBenchmark::createAll(const char* samplesPath, const std::vector<unsigned int>& counts, std::vector<SceneBenchmark*>& benchmarks)
+{
+    GP_ASSERT(samplesPath);
+
+    std::string path = samplesPath;
+    benchmarks.push_back(new MeshSample(path));
+    benchmarks.push_back(new LongboardSample(path));
+    benchmarks.push_back(new SpaceshipSample(path));
+    benchmarks.push_back(new CharacterSample(path));
+    benchmarks.push_back(new ParticlesSample(path));
+    benchmarks.push_back(new LuaSample(path));
+
+    for (unsigned int i = 0, count = counts.size(); i < count; ++i)
+    {
+        benchmarks.push_back(new CharactersScene(counts[i]));
+        benchmarks.push_back(new EmittersScene(counts[i]));
+        benchmarks.push_back(new RigidBodiesScene(counts[i]));
+    }
+}
@@ -0,0 +1,282 @@
+#include "SceneRunner.h"
+
+// The defaults for the sceneBenchmarks section of game.config.
+#define DEFAULT_OUTPUT_PATH         "scenes.json"
+#define DEFAULT_SAMPLES_PATH        "../gameplay-samples/"
+#define DEFAULT_FRAME_COUNT         600
+#define DEFAULT_WARMUP_FRAME_COUNT  60
+#define DEFAULT_CLOCK_STEP          (1000.0f / 60.0f)
+#define DEFAULT_SEED                1
+
+// The names of the metrics in the results, starting with the frame phases.
+static const char* __metricNames[] =
+{
+    "animation",
+    "time_events",
+    "physics",
+    "ai",
+    "update",
+    "script_update",
+    "audio",
+    "render",
+    "script_render",
+    "frame",
+    "allocations",
+    "draw_calls",
+    "triangles",
+    "gl_calls"
+};
+
+SceneRunner::SceneRunner()
+    : _frameCount(DEFAULT_FRAME_COUNT), _warmupFrameCount(DEFAULT_WARMUP_FRAME_COUNT), _clockStep(DEFAULT_CLOCK_STEP),
+      _seed(DEFAULT_SEED), _current(0), _frame(0), _loaded(false)
+{
+}
+
+SceneRunner::~SceneRunner()
+{
+    if (_loaded)
+        unload();
+    for (unsigned int i = 0, count = _benchmarks.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_benchmarks[i]);
+    }
+    Game::setClockStep(0);
+}
+
+SceneRunner* SceneRunner::create(Properties* config)
+{
+    GP_ASSERT(config);
+    GP_ASSERT(sizeof(__metricNames) / sizeof(__metricNames[0]) == METRIC_COUNT);
+
+    SceneRunner* runner = new SceneRunner();
+    runner->_outputPath = config->exists("output") ? config->getString("output") : DEFAULT_OUTPUT_PATH;
+    if (config->exists("frames"))
+        runner->_frameCount = std::max(1, config->getInt("frames"));
+    if (config->exists("warmupFrames"))
+        runner->_warmupFrameCount = std::max(0, config->getInt("warmupFrames"));
+    if (config->exists("clockStep"))
+        runner->_clockStep = config->getFloat("clockStep");
+    if (config->exists("seed"))
+        runner->_seed = (unsigned int)config->getInt("seed");
+
+    // The frame a benchmark is loaded in is never recorded.
+    runner->_warmupFrameCount = std::max(1u, runner->_warmupFrameCount);
+
+    // The sizes of the synthetic workloads are a list of numbers, such as "10, 100".
+    std::vector<unsigned int> counts;
+    const char* list = config->exists("counts") ? config->getString("counts") : "10";
+    while (*list)
+    {
+        char* end;
+        unsigned long count = strtoul(list, &end, 10);
+        if (end == list)
+        {
+            ++list;
+            continue;
+        }
+        if (count > 0)
+            counts.push_back((unsigned int)count);
+        list = end;
+    }
+
+    const char* samplesPath = config->exists("samplesPath") ? config->getString("samplesPath") : DEFAULT_SAMPLES_PATH;
+    SceneBenchmark::createAll(samplesPath, counts, runner->_benchmarks);
+
+    // Scenes are loaded and recorded from the game update, which must run once per frame on the game thread.
+    Game* game = Game::getInstance();
+    game->setPipelined(false);
+    game->setFixedUpdateRate(0);
+
+    runner->_gameResourcePath = FileSystem::getResourcePath();
+    Game::setClockStep(runner->_clockStep);
+    return runner;
+}
+
+bool SceneRunner::update(float elapsedTime)
+{
+    if (_current >= _benchmarks.size())
+        return false;
+
+    if (!_loaded)
+    {
+        if (!load())
+        {
+            ++_current;
+            if (_current >= _benchmarks.size())
+            {
+                writeResults();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The game publishes the phase times and counters of a frame when it ends, so the last frame is recorded now.
+    if (_frame > _warmupFrameCount)
+    {
+        record();
+        if (_results.back().samples[0].size() >= _frameCount)
+        {
+            unload();
+            ++_current;
+            if (_current >= _benchmarks.size())
+            {
+                writeResults();
+                return false;
+            }
+            return true;
+        }
+    }
+
+    ++_frame;
+    _benchmarks[_current]->update(elapsedTime);
+    return true;
+}
+
+void SceneRunner::render(float elapsedTime)
+{
+    if (_loaded)
+        _benchmarks[_current]->render(elapsedTime);
+    else
+        Game::getInstance()->clear(Game::CLEAR_COLOR_DEPTH, Vector4::zero(), 1.0f, 0);
+}
+
+bool SceneRunner::load()
+{
+    SceneBenchmark* benchmark = _benchmarks[_current];
+
+    Result result;
+    result.name = benchmark->getName();
+    _results.push_back(result);
+
+    // The benchmark's assets stay reachable for as long as it runs, since some are loaded on demand.
+    std::string resourcePath = _gameResourcePath + benchmark->getResourcePath();
+    FileSystem::setResourcePath(resourcePath.c_str());
+
+    // Seed the random numbers used by the particle emitters and the game, so every run is the same.
+    srand(_seed);
+
+    if (!benchmark->load())
+    {
+        GP_WARN("Failed to load scene benchmark '%s' from '%s'.", benchmark->getName(), resourcePath.c_str());
+        _results.back().error = "Failed to load the scene.";
+        benchmark->unload();
+        FileSystem::setResourcePath(_gameResourcePath.c_str());
+        return false;
+    }
+
+    _loaded = true;
+    _frame = 0;
+    return true;
+}
+
+void SceneRunner::unload()
+{
+    _benchmarks[_current]->unload();
+    FileSystem::setResourcePath(_gameResourcePath.c_str());
+    _loaded = false;
+}
+
+void SceneRunner::record()
+{
+    Result& result = _results.back();
+    Game* game = Game::getInstance();
+
+    double frameTime = 0;
+    for (unsigned int i = 0; i < Game::PHASE_COUNT; ++i)
+    {
+        double time = game->getPhaseTime((Game::FramePhase)i);
+        result.samples[i].push_back(time);
+        frameTime += time;
+    }
+    result.samples[METRIC_FRAME].push_back(frameTime);
+
+    unsigned int allocations = 0;
+    for (unsigned int i = 0; i < MemoryTracker::TAG_COUNT; ++i)
+    {
+        allocations += MemoryTracker::getFrameAllocationCount((MemoryTracker::Tag)i);
+    }
+    result.samples[METRIC_ALLOCATIONS].push_back(allocations);
+    result.samples[METRIC_DRAW_CALLS].push_back(RenderStats::getDrawCallCount());
+    result.samples[METRIC_TRIANGLES].push_back(RenderStats::getTriangleCount());
+    result.samples[METRIC_GL_CALLS].push_back(GLCapture::getFrameCallCount());
+}
+
+void SceneRunner::writeStatistics(FILE* file, const char* name, std::vector<double> samples, bool last)
+{
+    double mean = 0;
+    std::sort(samples.begin(), samples.end());
+    for (unsigned int i = 0, count = samples.size(); i < count; ++i)
+    {
+        mean += samples[i];
+    }
+
+    // Percentiles use the nearest rank.
+    unsigned int count = samples.size();
+    double p50 = 0, p90 = 0, p99 = 0, max = 0;
+    if (count > 0)
+    {
+        mean /= count;
+        p50 = samples[std::max(1u, (unsigned int)ceil(count * 0.50)) - 1];
+        p90 = samples[std::max(1u, (unsigned int)ceil(count * 0.90)) - 1];
+        p99 = samples[std::max(1u, (unsigned int)ceil(count * 0.99)) - 1];
+        max = samples[count - 1];
+    }
+
+    fprintf(file, "        \"%s\": { \"mean\": %.6g, \"p50\": %.6g, \"p90\": %.6g, \"p99\": %.6g, \"max\": %.6g }%s\n",
+        name, mean, p50, p90, p99, max, last ? "" : ",");
+}
+
+bool SceneRunner::writeResults() const
+{
+    FILE* file = FileSystem::openFile(_outputPath.c_str(), "w");
+    if (file == NULL)
+    {
+        GP_ERROR("Failed to open scene benchmark results file '%s'.", _outputPath.c_str());
+        return false;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"context\": {\n");
+    fprintf(file, "    \"executable\": \"gameplay-benchmarks\",\n");
+#ifdef NDEBUG
+    fprintf(file, "    \"library_build_type\": \"release\",\n");
+#else
+    fprintf(file, "    \"library_build_type\": \"debug\",\n");
+#endif
+    fprintf(file, "    \"frames\": %u,\n", _frameCount);
+    fprintf(file, "    \"warmup_frames\": %u,\n", _warmupFrameCount);
+    fprintf(file, "    \"clock_step\": %.6g,\n", _clockStep);
+    fprintf(file, "    \"seed\": %u,\n", _seed);
+    fprintf(file, "    \"allocation_tracking\": %s,\n", MemoryTracker::isEnabled() ? "true" : "false");
+    fprintf(file, "    \"time_unit\": \"ms\"\n");
+    fprintf(file, "  },\n");
+    fprintf(file, "  \"scenes\": [\n");
+    for (unsigned int i = 0, count = _results.size(); i < count; ++i)
+    {
+        const Result& result = _results[i];
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"name\": \"%s\",\n", result.name.c_str());
+        if (!result.error.empty())
+        {
+            fprintf(file, "      \"error_occurred\": true,\n");
+            fprintf(file, "      \"error_message\": \"%s\"\n", result.error.c_str());
+        }
+        else
+        {
+            fprintf(file, "      \"frames\": %u,\n", (unsigned int)result.samples[0].size());
+            fprintf(file, "      \"metrics\": {\n");
+            for (unsigned int j = 0; j < METRIC_COUNT; ++j)
+            {
+                writeStatistics(file, __metricNames[j], result.samples[j], j + 1 == METRIC_COUNT);
+            }
+            fprintf(file, "      }\n");
+        }
+        fprintf(file, i + 1 < count ? "    },\n" : "    }\n");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+    fclose(file);
+    return true;
+}
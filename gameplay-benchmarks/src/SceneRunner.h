@@ -0,0 +1,125 @@
+#ifndef SCENERUNNER_H_
+#define SCENERUNNER_H_
+
+#include "SceneBenchmark.h"
+
+/**
+ * Runs scene benchmarks one after the other through the frames of the game, and
+ * writes the cost of their frames to a JSON file.
+ *
+ * Each benchmark is loaded, run for a number of warm-up frames that are not
+ * recorded, then for a number of recorded frames. The game clock advances by a
+ * fixed step each frame, so every run simulates exactly the same frames. For each
+ * benchmark the results hold the mean, median, 90th and 99th percentiles and maximum
+ * of the time of each frame phase and of the whole frame, the heap allocations per
+ * frame (when the engine is built with GAMEPLAY_MEM_TRACKING), the draw calls and
+ * triangles per frame, and the GL calls per frame (when the engine is built with
+ * GP_USE_GL_CAPTURE).
+ *
+ * The runner is configured by the sceneBenchmarks section of game.config:
+ * @code
+ * sceneBenchmarks
+ * {
+ *     output = scenes.json
+ *     samplesPath = ../gameplay-samples/
+ *     counts = 10, 100
+ *     frames = 600
+ *     warmupFrames = 60
+ *     clockStep = 16.666667
+ *     seed = 1
+ * }
+ * @endcode
+ */
+class SceneRunner
+{
+public:
+
+    /**
+     * Creates a runner from the sceneBenchmarks section of game.config.
+     *
+     * @param config The sceneBenchmarks section.
+     *
+     * @return The new runner.
+     */
+    static SceneRunner* create(Properties* config);
+
+    /**
+     * Destructor.
+     */
+    ~SceneRunner();
+
+    /**
+     * Records the last frame and advances the current benchmark, loading the next one when it is done.
+     *
+     * Called from the update of the game.
+     *
+     * @param elapsedTime The elapsed game time of the frame (in milliseconds).
+     *
+     * @return false once all the benchmarks have run and the results are written.
+     */
+    bool update(float elapsedTime);
+
+    /**
+     * Draws the current benchmark.
+     *
+     * Called from the render of the game.
+     *
+     * @param elapsedTime The elapsed game time of the frame (in milliseconds).
+     */
+    void render(float elapsedTime);
+
+private:
+
+    /**
+     * The metrics recorded for each frame.
+     */
+    enum Metric
+    {
+        METRIC_FRAME = Game::PHASE_COUNT,
+        METRIC_ALLOCATIONS,
+        METRIC_DRAW_CALLS,
+        METRIC_TRIANGLES,
+        METRIC_GL_CALLS,
+        METRIC_COUNT
+    };
+
+    /**
+     * The recorded frames of a benchmark.
+     */
+    struct Result
+    {
+        std::string name;
+        std::string error;
+        std::vector<double> samples[METRIC_COUNT];
+    };
+
+    SceneRunner();
+
+    SceneRunner(const SceneRunner& copy);
+
+    SceneRunner& operator=(const SceneRunner&);
+
+    bool load();
+
+    void unload();
+
+    void record();
+
+    bool writeResults() const;
+
+    static void writeStatistics(FILE* file, const char* name, std::vector<double> samples, bool last);
+
+    std::vector<SceneBenchmark*> _benchmarks;
+    std::vector<Result> _results;
+    std::string _outputPath;
+    std::string _gameResourcePath;
+    unsigned int _frameCount;
+    unsigned int _warmupFrameCount;
+    float _clockStep;
+    unsigned int _seed;
+    unsigned int _current;
+    unsigned int _frame;
+    bool _loaded;
+};
+
+#endif
@@ -0,0 +1,403 @@
+#include "SyntheticBundle.h"
+
+// The object types and version of the bundle format, as read by gameplay::Bundle.
+#define BUNDLE_VERSION_MAJOR            1
+#define BUNDLE_VERSION_MINOR            2
+#define BUNDLE_TYPE_SCENE               1
+#define BUNDLE_TYPE_NODE                2
+#define BUNDLE_TYPE_ANIMATIONS          3
+#define BUNDLE_TYPE_MESH                34
+#define BUNDLE_TYPE_FONT                128
+
+// The printable ASCII characters that synthetic fonts have glyphs for.
+#define FONT_FIRST_CHARACTER            32
+#define FONT_LAST_CHARACTER             126
+
+// Converts an integer to a string for building object ids.
+static std::string toString(unsigned int value)
+{
+    char buffer[16];
+    sprintf(buffer, "%u", value);
+    return buffer;
+}
+
+static unsigned int nextPowerOfTwo(unsigned int value)
+{
+    unsigned int result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+SyntheticBundle::SyntheticBundle()
+{
+}
+
+void SyntheticBundle::beginObject(const std::string& id, unsigned int type)
+{
+    Reference ref;
+    ref.id = id;
+    ref.type = type;
+    ref.offset = _data.size();
+    _references.push_back(ref);
+}
+
+void SyntheticBundle::writeUint(unsigned int value)
+{
+    const unsigned char* bytes = (const unsigned char*)&value;
+    _data.insert(_data.end(), bytes, bytes + sizeof(value));
+}
+
+void SyntheticBundle::writeByte(unsigned char value)
+{
+    _data.push_back(value);
+}
+
+void SyntheticBundle::writeFloat(float value)
+{
+    const unsigned char* bytes = (const unsigned char*)&value;
+    _data.insert(_data.end(), bytes, bytes + sizeof(value));
+}
+
+void SyntheticBundle::writeString(const std::string& value)
+{
+    writeUint(value.size());
+    _data.insert(_data.end(), value.begin(), value.end());
+}
+
+void SyntheticBundle::writeMatrix(const Matrix& matrix)
+{
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        writeFloat(matrix.m[i]);
+    }
+}
+
+void SyntheticBundle::writeMesh(const std::string& id, unsigned int resolution, bool skinned, unsigned int jointCount)
+{
+    // Indices are 16-bit, so the grid is limited to 65536 vertices.
+    resolution = std::max(1u, std::min(resolution, 255u));
+    unsigned int side = resolution + 1;
+
+    beginObject(id, BUNDLE_TYPE_MESH);
+
+    // Vertex format.
+    writeUint(skinned ? 5 : 3);
+    writeUint(VertexFormat::POSITION);
+    writeUint(3);
+    writeUint(VertexFormat::NORMAL);
+    writeUint(3);
+    writeUint(VertexFormat::TEXCOORD0);
+    writeUint(2);
+    if (skinned)
+    {
+        writeUint(VertexFormat::BLENDWEIGHTS);
+        writeUint(4);
+        writeUint(VertexFormat::BLENDINDICES);
+        writeUint(4);
+    }
+
+    // Vertices of a unit grid, upright and as tall as the joint chain for skinned meshes.
+    float height = skinned ? (float)jointCount : 0.0f;
+    writeUint(side * side * (skinned ? 16 : 8) * sizeof(float));
+    for (unsigned int z = 0; z < side; ++z)
+    {
+        for (unsigned int x = 0; x < side; ++x)
+        {
+            float u = (float)x / resolution;
+            float v = (float)z / resolution;
+            if (skinned)
+            {
+                writeFloat(u - 0.5f);
+                writeFloat(v * height);
+                writeFloat(0.0f);
+                writeFloat(0.0f);
+                writeFloat(0.0f);
+                writeFloat(1.0f);
+            }
+            else
+            {
+                writeFloat(u - 0.5f);
+                writeFloat(0.0f);
+                writeFloat(v - 0.5f);
+                writeFloat(0.0f);
+                writeFloat(1.0f);
+                writeFloat(0.0f);
+            }
+            writeFloat(u);
+            writeFloat(v);
+            if (skinned)
+            {
+                // Each row of vertices follows the joint at its height.
+                unsigned int joint = std::min((unsigned int)(v * height), jointCount - 1);
+                writeFloat(1.0f);
+                writeFloat(0.0f);
+                writeFloat(0.0f);
+                writeFloat(0.0f);
+                writeFloat((float)joint);
+                writeFloat(0.0f);
+                writeFloat(0.0f);
+                writeFloat(0.0f);
+            }
+        }
+    }
+
+    // Bounding box and sphere.
+    Vector3 min(-0.5f, 0.0f, skinned ? 0.0f : -0.5f);
+    Vector3 max(0.5f, skinned ? height : 0.0f, skinned ? 0.0f : 0.5f);
+    writeFloat(min.x);
+    writeFloat(min.y);
+    writeFloat(min.z);
+    writeFloat(max.x);
+    writeFloat(max.y);
+    writeFloat(max.z);
+    Vector3 center = (min + max) * 0.5f;
+    writeFloat(center.x);
+    writeFloat(center.y);
+    writeFloat(center.z);
+    writeFloat(center.distance(max));
+
+    // A single part of triangles.
+    writeUint(1);
+    writeUint(Mesh::TRIANGLES);
+    writeUint(Mesh::INDEX16);
+    writeUint(resolution * resolution * 6 * sizeof(unsigned short));
+    for (unsigned int z = 0; z < resolution; ++z)
+    {
+        for (unsigned int x = 0; x < resolution; ++x)
+        {
+            unsigned short i0 = (unsigned short)(z * side + x);
+            unsigned short i1 = (unsigned short)(i0 + 1);
+            unsigned short i2 = (unsigned short)(i0 + side);
+            unsigned short i3 = (unsigned short)(i2 + 1);
+            unsigned short indices[6] = { i0, i2, i1, i1, i2, i3 };
+            const unsigned char* bytes = (const unsigned char*)indices;
+            _data.insert(_data.end(), bytes, bytes + sizeof(indices));
+        }
+    }
+}
+
+void SyntheticBundle::writeNodeHeader(const std::string& id, Node::Type type, const Matrix& transform, const std::string& parentId, unsigned int childCount)
+{
+    beginObject(id, BUNDLE_TYPE_NODE);
+    writeUint(type);
+    writeMatrix(transform);
+    writeString(parentId);
+    writeUint(childCount);
+}
+
+void SyntheticBundle::writeNodeFooter(const std::string& meshId)
+{
+    // No camera or light.
+    writeByte(0);
+    writeByte(0);
+
+    // The model, without a skin or materials.
+    writeString(meshId.empty() ? meshId : "#" + meshId);
+    if (!meshId.empty())
+    {
+        writeByte(0);
+        writeUint(0);
+    }
+}
+
+void SyntheticBundle::addScene(const char* id, unsigned int propCount, unsigned int characterCount, unsigned int jointCount, unsigned int meshResolution)
+{
+    GP_ASSERT(id);
+
+    std::string sceneId = id;
+    std::string propMeshId = sceneId + "_propMesh";
+    std::string characterMeshId = sceneId + "_characterMesh";
+    if (propCount > 0)
+        writeMesh(propMeshId, meshResolution, false, 0);
+    if (characterCount > 0 && jointCount > 0)
+        writeMesh(characterMeshId, meshResolution, true, jointCount);
+    else
+        characterCount = 0;
+
+    beginObject(sceneId, BUNDLE_TYPE_SCENE);
+    writeUint(propCount + characterCount);
+
+    // Lay the props and characters out on square grids, two units apart.
+    unsigned int propColumns = std::max(1u, (unsigned int)ceil(sqrt((float)propCount)));
+    for (unsigned int i = 0; i < propCount; ++i)
+    {
+        Matrix transform;
+        Matrix::createTranslation((float)(i % propColumns) * 2.0f, 0.0f, (float)(i / propColumns) * 2.0f, &transform);
+        writeNodeHeader("prop" + toString(i), Node::NODE, transform, "", 0);
+        writeNodeFooter(propMeshId);
+    }
+
+    unsigned int characterColumns = std::max(1u, (unsigned int)ceil(sqrt((float)characterCount)));
+    for (unsigned int i = 0; i < characterCount; ++i)
+    {
+        std::string characterId = "character" + toString(i);
+        Matrix transform;
+        Matrix::createTranslation((float)(i % characterColumns) * 2.0f, 0.0f, -2.0f - (float)(i / characterColumns) * 2.0f, &transform);
+        writeNodeHeader(characterId, Node::NODE, transform, "", 2);
+
+        // A chain of joints, one unit apart.
+        for (unsigned int j = 0; j < jointCount; ++j)
+        {
+            Matrix jointTransform;
+            Matrix::createTranslation(0.0f, j > 0 ? 1.0f : 0.0f, 0.0f, &jointTransform);
+            std::string parentId = j > 0 ? characterId + "_joint" + toString(j - 1) : characterId;
+            writeNodeHeader(characterId + "_joint" + toString(j), Node::JOINT, jointTransform, parentId, j + 1 < jointCount ? 1 : 0);
+        }
+        for (unsigned int j = 0; j < jointCount; ++j)
+        {
+            writeNodeFooter("");
+        }
+
+        // The skinned model.
+        writeNodeHeader(characterId + "_mesh", Node::NODE, Matrix::identity(), characterId, 0);
+        writeByte(0);
+        writeByte(0);
+        writeString("#" + characterMeshId);
+        writeByte(1);
+        writeMatrix(Matrix::identity());
+        writeUint(jointCount);
+        for (unsigned int j = 0; j < jointCount; ++j)
+        {
+            writeString("#" + characterId + "_joint" + toString(j));
+        }
+        writeUint(jointCount * 16);
+        for (unsigned int j = 0; j < jointCount; ++j)
+        {
+            Matrix inverseBindPose;
+            Matrix::createTranslation(0.0f, -(float)j, 0.0f, &inverseBindPose);
+            writeMatrix(inverseBindPose);
+        }
+        writeUint(0);
+
+        writeNodeFooter("");
+    }
+
+    // No active camera, and a dim ambient light.
+    writeString("");
+    writeFloat(0.2f);
+    writeFloat(0.2f);
+    writeFloat(0.2f);
+
+    // Each joint sways back and forth about the z axis.
+    if (characterCount > 0)
+    {
+        beginObject(sceneId + "_animations", BUNDLE_TYPE_ANIMATIONS);
+        writeUint(characterCount);
+
+        Quaternion rest = Quaternion::identity();
+        Quaternion bent;
+        Quaternion::createFromAxisAngle(Vector3::unitZ(), 0.3f, &bent);
+        for (unsigned int i = 0; i < characterCount; ++i)
+        {
+            std::string characterId = "character" + toString(i);
+            writeString(characterId + "_animation");
+            writeUint(jointCount);
+            for (unsigned int j = 0; j < jointCount; ++j)
+            {
+                writeString(characterId + "_joint" + toString(j));
+                writeUint(Transform::ANIMATE_ROTATE);
+
+                writeUint(3);
+                writeUint(0);
+                writeUint(500);
+                writeUint(1000);
+
+                const Quaternion* keys[3] = { &rest, &bent, &rest };
+                writeUint(12);
+                for (unsigned int k = 0; k < 3; ++k)
+                {
+                    writeFloat(keys[k]->x);
+                    writeFloat(keys[k]->y);
+                    writeFloat(keys[k]->z);
+                    writeFloat(keys[k]->w);
+                }
+
+                // No tangents or interpolations; channels are linear.
+                writeUint(0);
+                writeUint(0);
+                writeUint(0);
+            }
+        }
+    }
+}
+
+void SyntheticBundle::addFont(const char* id, unsigned int size)
+{
+    GP_ASSERT(id);
+    GP_ASSERT(size > 0);
+
+    beginObject(id, BUNDLE_TYPE_FONT);
+    writeString("synthetic");
+    writeUint(Font::PLAIN);
+    writeUint(size);
+    writeString("");
+
+    // Glyphs are laid out in a texture of 16 columns.
+    unsigned int glyphCount = FONT_LAST_CHARACTER - FONT_FIRST_CHARACTER + 1;
+    unsigned int width = nextPowerOfTwo(16 * size);
+    unsigned int height = nextPowerOfTwo(((glyphCount + 15) / 16) * size);
+    writeUint(glyphCount);
+    for (unsigned int i = 0; i < glyphCount; ++i)
+    {
+        unsigned int glyphWidth = size / 2 + (i % 3);
+        float u = (float)((i % 16) * size) / width;
+        float v = (float)((i / 16) * size) / height;
+        writeUint(FONT_FIRST_CHARACTER + i);
+        writeUint(glyphWidth);
+        writeFloat(u);
+        writeFloat(v);
+        writeFloat(u + (float)glyphWidth / width);
+        writeFloat(v + (float)size / height);
+    }
+
+    writeUint(width);
+    writeUint(height);
+    writeUint(width * height);
+    _data.insert(_data.end(), width * height, (unsigned char)0xFF);
+}
+
+bool SyntheticBundle::write(const char* path) const
+{
+    GP_ASSERT(path);
+
+    // The offsets in the reference table are from the start of the file, after the table.
+    unsigned int headerSize = 9 + 2 + sizeof(unsigned int);
+    for (unsigned int i = 0, count = _references.size(); i < count; ++i)
+    {
+        headerSize += sizeof(unsigned int) + _references[i].id.size() + sizeof(unsigned int) * 2;
+    }
+
+    FILE* file = FileSystem::openFile(path, "wb");
+    if (file == NULL)
+    {
+        GP_ERROR("Failed to create bundle '%s'.", path);
+        return false;
+    }
+
+    unsigned char version[2] = { BUNDLE_VERSION_MAJOR, BUNDLE_VERSION_MINOR };
+    unsigned int referenceCount = _references.size();
+    fwrite("\xABGPB\xBB\r\n\x1A\n", 1, 9, file);
+    fwrite(version, 1, 2, file);
+    fwrite(&referenceCount, sizeof(referenceCount), 1, file);
+    for (unsigned int i = 0; i < referenceCount; ++i)
+    {
+        const Reference& ref = _references[i];
+        unsigned int length = ref.id.size();
+        unsigned int offset = headerSize + ref.offset;
+        fwrite(&length, sizeof(length), 1, file);
+        fwrite(ref.id.c_str(), 1, length, file);
+        fwrite(&ref.type, sizeof(ref.type), 1, file);
+        fwrite(&offset, sizeof(offset), 1, file);
+    }
+    if (!_data.empty())
+        fwrite(&_data[0], 1, _data.size(), file);
+
+    bool written = ferror(file) == 0;
+    if (fclose(file) != 0 || !written)
+    {
+        GP_ERROR("Failed to write bundle '%s'.", path);
+        return false;
+    }
+    return true;
+}
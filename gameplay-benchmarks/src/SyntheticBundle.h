@@ -0,0 +1,79 @@
+#ifndef SYNTHETICBUNDLE_H_
+#define SYNTHETICBUNDLE_H_
+
+#include "gameplay.h"
+
+using namespace gameplay;
+
+/**
+ * Writes gameplay bundles of generated content, so the benchmarks can load
+ * scenes of any size without depending on the assets of the samples.
+ *
+ * A scene holds a grid of static props and a grid of skinned characters. Each
+ * character has a chain of joints that is animated by a looping rotation.
+ */
+class SyntheticBundle
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    SyntheticBundle();
+
+    /**
+     * Adds a scene to the bundle.
+     *
+     * The props are named "prop0", "prop1", ..., and the characters "character0", ...
+     * The skinned model of a character is in its child node "characterN_mesh", and the
+     * animation of its joints has the id "characterN_animation".
+     *
+     * @param id The id of the scene.
+     * @param propCount The number of static props in the scene.
+     * @param characterCount The number of skinned characters in the scene.
+     * @param jointCount The number of joints of each character.
+     * @param meshResolution The number of quads along each side of the grid mesh of each prop and character.
+     */
+    void addScene(const char* id, unsigned int propCount, unsigned int characterCount, unsigned int jointCount, unsigned int meshResolution);
+
+    /**
+     * Adds a font with a glyph for each printable ASCII character to the bundle.
+     *
+     * @param id The id of the font.
+     * @param size The size of the font.
+     */
+    void addFont(const char* id, unsigned int size);
+
+    /**
+     * Writes the bundle to a file.
+     *
+     * @param path The path of the file.
+     *
+     * @return true if the bundle was written.
+     */
+    bool write(const char* path) const;
+
+private:
+
+    struct Reference
+    {
+        std::string id;
+        unsigned int type;
+        unsigned int offset;
+    };
+
+    void beginObject(const std::string& id, unsigned int type);
+    void writeUint(unsigned int value);
+    void writeByte(unsigned char value);
+    void writeFloat(float value);
+    void writeString(const std::string& value);
+    void writeMatrix(const Matrix& matrix);
+    void writeMesh(const std::string& id, unsigned int resolution, bool skinned, unsigned int jointCount);
+    void writeNodeHeader(const std::string& id, Node::Type type, const Matrix& transform, const std::string& parentId, unsigned int childCount);
+    void writeNodeFooter(const std::string& meshId);
+
+    std::vector<unsigned char> _data;
+    std::vector<Reference> _references;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "AnimationChannel.h"
 #include "Transform.h"
+#include "Quaternion.h"
 
 namespace gameplay
 {
@@ -169,6 +170,202 @@ void AnimationChannel::removeDuplicates()
     }
 }
 
+/**
+ * A range of the components of the key values of a transform property that is compared with one tolerance.
+ */
+struct KeyComponents
+{
+    unsigned int offset;
+    unsigned int size;
+    float tolerance;
+    bool quaternion;
+};
+
+/**
+ * Gets the component ranges of the key values of a transform property.
+ *
+ * @return The number of ranges, or zero if the property is not a transform property.
+ */
+static unsigned int getKeyComponents(unsigned int attrib, float positionTolerance, float rotationTolerance, float scaleTolerance, KeyComponents* components)
+{
+    const KeyComponents scale = { 0, 3, scaleTolerance, false };
+    const KeyComponents rotate = { 0, 4, rotationTolerance, true };
+    const KeyComponents translate = { 0, 3, positionTolerance, false };
+
+    switch (attrib)
+    {
+    case Transform::ANIMATE_SCALE:
+    case Transform::ANIMATE_SCALE_X:
+    case Transform::ANIMATE_SCALE_Y:
+    case Transform::ANIMATE_SCALE_Z:
+    case Transform::ANIMATE_SCALE_XY:
+    case Transform::ANIMATE_SCALE_XZ:
+    case Transform::ANIMATE_SCALE_YZ:
+        components[0] = scale;
+        components[0].size = Transform::getPropertySize(attrib);
+        return 1;
+    case Transform::ANIMATE_TRANSLATE:
+    case Transform::ANIMATE_TRANSLATE_X:
+    case Transform::ANIMATE_TRANSLATE_Y:
+    case Transform::ANIMATE_TRANSLATE_Z:
+    case Transform::ANIMATE_TRANSLATE_XY:
+    case Transform::ANIMATE_TRANSLATE_XZ:
+    case Transform::ANIMATE_TRANSLATE_YZ:
+        components[0] = translate;
+        components[0].size = Transform::getPropertySize(attrib);
+        return 1;
+    case Transform::ANIMATE_ROTATE:
+        components[0] = rotate;
+        return 1;
+    case Transform::ANIMATE_ROTATE_X:
+    case Transform::ANIMATE_ROTATE_Y:
+    case Transform::ANIMATE_ROTATE_Z:
+        // A single angle in radians
+        components[0] = rotate;
+        components[0].size = 1;
+        components[0].quaternion = false;
+        return 1;
+    case Transform::ANIMATE_ROTATE_TRANSLATE:
+        components[0] = rotate;
+        components[1] = translate;
+        components[1].offset = 4;
+        return 2;
+    case Transform::ANIMATE_SCALE_ROTATE_TRANSLATE:
+        components[0] = scale;
+        components[1] = rotate;
+        components[1].offset = 3;
+        components[2] = translate;
+        components[2].offset = 7;
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Returns true if the key value is within the tolerance of the interpolation at t between the key values from and to.
+ */
+static bool isInterpolated(const float* from, const float* to, const float* value, float t, const KeyComponents& components)
+{
+    from += components.offset;
+    to += components.offset;
+    value += components.offset;
+
+    if (components.quaternion)
+    {
+        Quaternion q;
+        Quaternion::slerp(Quaternion(from[0], from[1], from[2], from[3]), Quaternion(to[0], to[1], to[2], to[3]), t, &q);
+        Quaternion key(value[0], value[1], value[2], value[3]);
+        q.normalize();
+        key.normalize();
+
+        // The angle between two rotations is twice the angle between their quaternions
+        float dot = fabs(q.x * key.x + q.y * key.y + q.z * key.z + q.w * key.w);
+        float angle = 2.0f * acos(std::min(dot, 1.0f));
+        return angle <= components.tolerance;
+    }
+
+    for (unsigned int i = 0; i < components.size; ++i)
+    {
+        float interpolated = from[i] + (to[i] - from[i]) * t;
+        if (fabs(interpolated - value[i]) > components.tolerance)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AnimationChannel::isLinear() const
+{
+    if (_interpolations.empty())
+    {
+        return false;
+    }
+    for (std::vector<unsigned int>::const_iterator i = _interpolations.begin(); i != _interpolations.end(); ++i)
+    {
+        if (*i != LINEAR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AnimationChannel::reduceKeys(float positionTolerance, float rotationTolerance, float scaleTolerance)
+{
+    KeyComponents components[3];
+    const unsigned int componentsCount = getKeyComponents(_targetAttrib, positionTolerance, rotationTolerance, scaleTolerance, components);
+    const size_t propSize = Transform::getPropertySize(_targetAttrib);
+    const size_t keyCount = _keytimes.size();
+    if (componentsCount == 0 || keyCount < 3 || _keyValues.size() != keyCount * propSize || !isLinear())
+    {
+        return;
+    }
+
+    // Extend each segment from the last kept key frame for as long as all of the key frames
+    // inside of it are within the tolerances of the interpolation between its ends.
+    std::vector<size_t> keys;
+    keys.push_back(0);
+    size_t start = 0;
+    for (size_t end = 2; end < keyCount; ++end)
+    {
+        const float* from = &_keyValues[start * propSize];
+        const float* to = &_keyValues[end * propSize];
+        const float duration = _keytimes[end] - _keytimes[start];
+        bool interpolated = duration > 0.0f;
+        for (size_t i = start + 1; i < end && interpolated; ++i)
+        {
+            const float t = (_keytimes[i] - _keytimes[start]) / duration;
+            for (unsigned int j = 0; j < componentsCount && interpolated; ++j)
+            {
+                interpolated = isInterpolated(from, to, &_keyValues[i * propSize], t, components[j]);
+            }
+        }
+        if (!interpolated)
+        {
+            start = end - 1;
+            keys.push_back(start);
+        }
+    }
+    keys.push_back(keyCount - 1);
+
+    if (keys.size() == keyCount)
+    {
+        return;
+    }
+
+    // Tangents and per key interpolation types are only kept when there is one per key frame.
+    const size_t tangentSize = _tangentsIn.size() / keyCount;
+    std::vector<float> keytimes;
+    std::vector<float> keyValues;
+    std::vector<float> tangentsIn;
+    std::vector<float> tangentsOut;
+    std::vector<unsigned int> interpolations;
+    for (std::vector<size_t>::const_iterator i = keys.begin(); i != keys.end(); ++i)
+    {
+        keytimes.push_back(_keytimes[*i]);
+        keyValues.insert(keyValues.end(), _keyValues.begin() + *i * propSize, _keyValues.begin() + (*i + 1) * propSize);
+        if (tangentSize > 0 && _tangentsIn.size() == keyCount * tangentSize && _tangentsOut.size() == _tangentsIn.size())
+        {
+            tangentsIn.insert(tangentsIn.end(), _tangentsIn.begin() + *i * tangentSize, _tangentsIn.begin() + (*i + 1) * tangentSize);
+            tangentsOut.insert(tangentsOut.end(), _tangentsOut.begin() + *i * tangentSize, _tangentsOut.begin() + (*i + 1) * tangentSize);
+        }
+        if (_interpolations.size() == keyCount)
+        {
+            interpolations.push_back(_interpolations[*i]);
+        }
+    }
+    _keytimes.swap(keytimes);
+    _keyValues.swap(keyValues);
+    _tangentsIn.swap(tangentsIn);
+    _tangentsOut.swap(tangentsOut);
+    if (!interpolations.empty())
+    {
+        _interpolations.swap(interpolations);
+    }
+}
+
 void AnimationChannel::convertToQuaternion()
 {
     if (_targetAttrib == Transform::ANIMATE_ROTATE_X ||
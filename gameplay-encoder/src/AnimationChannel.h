@@ -65,6 +65,23 @@ public:
      */
     void removeDuplicates();
 
+    /**
+     * Removes the key frames of a linear animation channel that can be interpolated from the
+     * key frames before and after them within the given tolerances. Each removed key frame is
+     * compared against the interpolation between the kept key frames that replace it, so the
+     * error does not accumulate. Channels with other interpolation types are not changed.
+     *
+     * @param positionTolerance The largest error of each translation component.
+     * @param rotationTolerance The largest angle in radians between interpolated and original rotations.
+     * @param scaleTolerance The largest error of each scale component.
+     */
+    void reduceKeys(float positionTolerance, float rotationTolerance, float scaleTolerance);
+
+    /**
+     * Returns true if all of the key frames of the channel are interpolated linearly.
+     */
+    bool isLinear() const;
+
     void convertToQuaternion();
     void convertToTransform();
 
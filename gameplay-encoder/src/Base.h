@@ -16,6 +16,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <set>
 #include <algorithm>
 #include <sys/stat.h>
 
@@ -74,6 +75,19 @@ enum VertexUsage
     TEXCOORD7 = 15
 };
 
+/**
+ * The data type of the components of a vertex element, which matches VertexFormat::Type in the runtime.
+ */
+enum VertexType
+{
+    TYPE_FLOAT = 0,
+    TYPE_HALF_FLOAT = 1,
+    TYPE_SNORM8 = 2,
+    TYPE_UNORM8 = 3,
+    TYPE_UINT8 = 4,
+    TYPE_SNORM10_10_10_2 = 5
+};
+
 void fillArray(float values[], float value, size_t length);
 
 /**
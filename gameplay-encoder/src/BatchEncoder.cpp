@@ -0,0 +1,640 @@
+#include "Base.h"
+#include "BatchEncoder.h"
+#include "GPBFile.h"
+#include "StringUtil.h"
+#include "Thread.h"
+
+#ifdef WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <dirent.h>
+#include <sys/time.h>
+#endif
+
+namespace gameplay
+{
+
+const char* BatchEncoder::CACHE_FILE = "gameplay-encoder.cache";
+const char* BatchEncoder::REPORT_FILE = "gameplay-encoder-report.json";
+const char* BatchEncoder::ENCODER_VERSION = __DATE__ " " __TIME__;
+
+/**
+ * The offset basis and prime of the 64-bit FNV-1a hash.
+ */
+static const unsigned long long FNV_OFFSET = 14695981039346656037ULL;
+static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+/**
+ * Adds the bytes to the FNV-1a hash.
+ */
+static unsigned long long hashBytes(unsigned long long hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Adds the contents of the file to the FNV-1a hash.
+ *
+ * @return False if the file could not be read.
+ */
+static bool hashFile(unsigned long long* hash, const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+    unsigned char buffer[65536];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        *hash = hashBytes(*hash, buffer, size);
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * Returns the time in seconds from an unspecified starting point.
+ */
+static double getTime()
+{
+#ifdef WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timeval time;
+    gettimeofday(&time, NULL);
+    return (double)time.tv_sec + (double)time.tv_usec * 0.000001;
+#endif
+}
+
+static bool fileExists(const std::string& path)
+{
+    struct stat buf;
+    return stat(path.c_str(), &buf) != -1;
+}
+
+static bool isDirectory(const std::string& path)
+{
+    struct stat buf;
+    return stat(path.c_str(), &buf) != -1 && (buf.st_mode & S_IFDIR) != 0;
+}
+
+/**
+ * Creates the directory and all of its parent directories that do not exist.
+ */
+static void createDirectories(const std::string& path)
+{
+    for (size_t i = path.find('/', 1); ; i = path.find('/', i + 1))
+    {
+        std::string directory = path.substr(0, i);
+        if (!directory.empty() && !isDirectory(directory))
+        {
+#ifdef WIN32
+            _mkdir(directory.c_str());
+#else
+            mkdir(directory.c_str(), 0777);
+#endif
+        }
+        if (i == std::string::npos)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * Returns the path of the program, searching the directories of the PATH
+ * environment variable when it is run by name.
+ */
+static std::string findProgram(const std::string& program)
+{
+    if (fileExists(program) || program.find_first_of("/\\") != std::string::npos)
+    {
+        return program;
+    }
+#ifdef WIN32
+    const char separator = ';';
+    const char* extension = ".exe";
+#else
+    const char separator = ':';
+    const char* extension = "";
+#endif
+    const char* env = getenv("PATH");
+    std::string paths(env ? env : "");
+    for (size_t start = 0; start <= paths.size(); )
+    {
+        size_t end = paths.find(separator, start);
+        if (end == std::string::npos)
+        {
+            end = paths.size();
+        }
+        std::string path = paths.substr(start, end - start) + "/" + program;
+        if (!endsWith(path, extension))
+        {
+            path.append(extension);
+        }
+        if (end > start && fileExists(path))
+        {
+            return path;
+        }
+        start = end + 1;
+    }
+    return program;
+}
+
+/**
+ * Returns true if the encoder supports the file extension of the asset.
+ */
+static bool isAsset(const std::string& name)
+{
+    return endsWith(name, ".dae") || endsWith(name, ".fbx") || endsWith(name, ".ttf");
+}
+
+static std::string quote(const std::string& str)
+{
+    std::string quoted("\"");
+    quoted.append(str);
+    quoted.append("\"");
+    return quoted;
+}
+
+static const char* getStatusString(unsigned int status)
+{
+    static const char* strings[] = { "pending", "encoded", "cached", "failed" };
+    return strings[status];
+}
+
+/**
+ * Writes the string to the file as a quoted JSON string.
+ */
+static void writeJsonString(FILE* file, const std::string& str)
+{
+    fputc('"', file);
+    for (std::string::const_iterator i = str.begin(); i != str.end(); ++i)
+    {
+        unsigned char c = (unsigned char)*i;
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', file);
+            fputc(c, file);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(file, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+BatchEncoder::BatchEncoder(const char* program, const EncoderArguments& arguments) :
+    _program(program), _arguments(arguments), _encoderHash(FNV_OFFSET)
+{
+    _outputPath = arguments.getBatchOutputPath();
+    std::replace(_outputPath.begin(), _outputPath.end(), '\\', '/');
+    if (!endsWith(_outputPath, "/"))
+    {
+        _outputPath.append("/");
+    }
+
+    // Assets are encoded again when the bundle format, the encoder executable or the options change.
+    _encoderHash = hashBytes(_encoderHash, GPB_VERSION, sizeof(GPB_VERSION));
+    if (!hashFile(&_encoderHash, findProgram(_program)))
+    {
+        fprintf(stderr, "Warning: Failed to read the encoder executable %s, using its build time in the cache instead.\n", _program.c_str());
+        _encoderHash = hashBytes(_encoderHash, ENCODER_VERSION, strlen(ENCODER_VERSION));
+    }
+
+    _command = quote(_program);
+    const std::vector<std::string>& options = arguments.getOptions();
+    for (std::vector<std::string>::const_iterator i = options.begin(); i != options.end(); ++i)
+    {
+        _encoderHash = hashBytes(_encoderHash, i->c_str(), i->size() + 1);
+        _command.append(" ");
+        _command.append(quote(*i));
+    }
+}
+
+BatchEncoder::~BatchEncoder(void)
+{
+}
+
+unsigned int BatchEncoder::encode()
+{
+    const double startTime = getTime();
+
+    const std::string& input = _arguments.getFilePath();
+    if (isDirectory(input))
+    {
+        findJobs(input + "/", "");
+    }
+    else if (!readManifest(input))
+    {
+        fprintf(stderr, "Error: Failed to read manifest: %s\n", input.c_str());
+        return 1;
+    }
+
+    createDirectories(_outputPath);
+    readCache();
+
+    // Assets that would be written to the same file fail instead of overwriting each other.
+    std::map<std::string, size_t> outputs;
+    for (size_t i = 0; i < _jobs.size(); ++i)
+    {
+        std::map<std::string, size_t>::const_iterator j = outputs.find(_jobs[i].output);
+        if (j != outputs.end())
+        {
+            _jobs[i].status = FAILED;
+            _jobs[i].message = "Same output file as " + _jobs[j->second].input;
+        }
+        else
+        {
+            outputs[_jobs[i].output] = i;
+        }
+    }
+
+    // Each asset is built with the threads given by -j, or on one thread when several are encoded at once.
+    // The thread count does not change the output, so it is not part of the options hashed for the cache.
+    char threads[32];
+    if (_arguments.getThreadCount() > 0)
+    {
+        sprintf(threads, " -j %u", _arguments.getThreadCount());
+        _command.append(threads);
+    }
+    else if (Thread::getMaxThreadCount() > 1 && _jobs.size() > 1)
+    {
+        _command.append(" -j 1");
+    }
+    Thread::parallelFor((unsigned int)_jobs.size(), &encodeJob, this);
+
+    const double seconds = getTime() - startTime;
+    writeCache();
+    writeReport(seconds);
+
+    unsigned int counts[FAILED + 1] = { 0, 0, 0, 0 };
+    for (std::vector<Job>::const_iterator i = _jobs.begin(); i != _jobs.end(); ++i)
+    {
+        ++counts[i->status];
+    }
+    fprintf(stderr, "Batch: %u encoded, %u unchanged, %u failed in %.2f seconds.\n", counts[ENCODED], counts[CACHED], counts[FAILED], seconds);
+    return counts[FAILED];
+}
+
+void BatchEncoder::addJob(const std::string& input, const std::string& relativeDirectory)
+{
+    Job job;
+    job.input = input;
+    job.outputDirectory = _outputPath + relativeDirectory;
+    job.output = job.outputDirectory + getFilenameNoExt(getFilenameFromFilePath(input)) + ".gpb";
+    job.status = PENDING;
+    job.seconds = 0.0;
+    _jobs.push_back(job);
+}
+
+void BatchEncoder::findJobs(const std::string& directory, const std::string& relativeDirectory)
+{
+    std::vector<std::string> names;
+#ifdef WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE handle = FindFirstFileA((directory + "*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    do
+    {
+        names.push_back(data.cFileName);
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (!dir)
+    {
+        return;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        names.push_back(entry->d_name);
+    }
+    closedir(dir);
+#endif
+
+    // List the assets in the same order on every platform.
+    std::sort(names.begin(), names.end());
+    for (std::vector<std::string>::const_iterator i = names.begin(); i != names.end(); ++i)
+    {
+        if (i->empty() || (*i)[0] == '.')
+        {
+            continue;
+        }
+        std::string path = directory + *i;
+        if (isDirectory(path))
+        {
+            findJobs(path + "/", relativeDirectory + *i + "/");
+        }
+        else if (isAsset(*i))
+        {
+            addJob(path, relativeDirectory);
+        }
+    }
+}
+
+bool BatchEncoder::readManifest(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file)
+    {
+        return false;
+    }
+
+    // Relative asset paths are relative to the manifest, and keep their directories in the output directory.
+    std::string base = path.substr(0, path.find_last_of('/') + 1);
+    char line[4096];
+    while (fgets(line, sizeof(line), file))
+    {
+        std::string entry(line);
+        size_t first = entry.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos || entry[first] == '#')
+        {
+            continue;
+        }
+        entry = entry.substr(first, entry.find_last_not_of(" \t\r\n") - first + 1);
+        std::replace(entry.begin(), entry.end(), '\\', '/');
+
+        bool absolute = entry[0] == '/' || (entry.size() > 1 && entry[1] == ':');
+        std::string relativeDirectory;
+        size_t slash = entry.find_last_of('/');
+        if (!absolute && slash != std::string::npos && entry.find("..") == std::string::npos)
+        {
+            relativeDirectory = entry.substr(0, slash + 1);
+        }
+        addJob(absolute ? entry : base + entry, relativeDirectory);
+    }
+    fclose(file);
+    return true;
+}
+
+void BatchEncoder::findOutputs(Job& job) const
+{
+    job.outputs.clear();
+
+    // The cell bundles are listed in the cell index next to the main output file.
+    if (_arguments.getCellSize() > 0.0f)
+    {
+        std::string index = job.output.substr(0, job.output.length() - 4) + ".cells";
+        job.outputs.push_back(index);
+        FILE* file = fopen(index.c_str(), "r");
+        if (file)
+        {
+            char line[4096];
+            while (fgets(line, sizeof(line), file))
+            {
+                std::string entry(line);
+                size_t first = entry.find_first_not_of(" \t");
+                size_t equals = entry.find('=');
+                if (first == std::string::npos || equals == std::string::npos || entry.compare(first, 6, "bundle") != 0)
+                {
+                    continue;
+                }
+                size_t start = entry.find_first_not_of(" \t", equals + 1);
+                size_t end = entry.find_last_not_of(" \t\r\n");
+                if (start != std::string::npos && end >= start)
+                {
+                    std::string path = job.outputDirectory + entry.substr(start, end - start + 1);
+                    if (path != job.output)
+                    {
+                        job.outputs.push_back(path);
+                    }
+                }
+            }
+            fclose(file);
+        }
+    }
+
+    // The heightmaps are written to the output directory for the nodes of the asset that -h names.
+    const char* extension = _arguments.getHeightmapFormat() == EncoderArguments::HEIGHTMAP_FLOAT ? ".raw" : ".png";
+    const std::vector<std::string>& heightmapNodes = _arguments.getHeightmapNodeIds();
+    for (std::vector<std::string>::const_iterator i = heightmapNodes.begin(); i != heightmapNodes.end(); ++i)
+    {
+        std::string path = job.outputDirectory + "heightmap_" + *i + extension;
+        if (fileExists(path))
+        {
+            job.outputs.push_back(path);
+        }
+    }
+}
+
+void BatchEncoder::readCache()
+{
+    FILE* file = fopen((_outputPath + CACHE_FILE).c_str(), "r");
+    if (!file)
+    {
+        return;
+    }
+    // Each entry is a line with the hash of an asset followed by the file it was encoded to,
+    // and an indented line for each of the other files it was encoded to.
+    char line[4096];
+    CacheEntry* last = NULL;
+    while (fgets(line, sizeof(line), file))
+    {
+        std::string entry(line);
+        size_t end = entry.find_last_not_of("\r\n");
+        if (end == std::string::npos)
+        {
+            continue;
+        }
+        if (entry[0] == ' ')
+        {
+            size_t first = entry.find_first_not_of(' ');
+            if (last && first <= end)
+            {
+                last->outputs.push_back(entry.substr(first, end - first + 1));
+            }
+            continue;
+        }
+        size_t space = entry.find(' ');
+        if (space != std::string::npos && end > space)
+        {
+            last = &_cache[entry.substr(space + 1, end - space)];
+            last->hash = entry.substr(0, space);
+            last->outputs.clear();
+        }
+    }
+    fclose(file);
+}
+
+void BatchEncoder::writeCache() const
+{
+    // Keep the entries of assets that were not part of this batch.
+    std::map<std::string, CacheEntry> cache(_cache);
+    for (std::vector<Job>::const_iterator i = _jobs.begin(); i != _jobs.end(); ++i)
+    {
+        if (i->status == ENCODED || i->status == CACHED)
+        {
+            cache[i->output].hash = i->hash;
+            cache[i->output].outputs = i->outputs;
+        }
+        else
+        {
+            cache.erase(i->output);
+        }
+    }
+
+    FILE* file = fopen((_outputPath + CACHE_FILE).c_str(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "Error: Failed to write cache: %s%s\n", _outputPath.c_str(), CACHE_FILE);
+        return;
+    }
+    for (std::map<std::string, CacheEntry>::const_iterator i = cache.begin(); i != cache.end(); ++i)
+    {
+        fprintf(file, "%s %s\n", i->second.hash.c_str(), i->first.c_str());
+        for (std::vector<std::string>::const_iterator j = i->second.outputs.begin(); j != i->second.outputs.end(); ++j)
+        {
+            fprintf(file, "  %s\n", j->c_str());
+        }
+    }
+    fclose(file);
+}
+
+void BatchEncoder::writeReport(double seconds) const
+{
+    FILE* file = fopen((_outputPath + REPORT_FILE).c_str(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "Error: Failed to write build report: %s%s\n", _outputPath.c_str(), REPORT_FILE);
+        return;
+    }
+
+    unsigned int counts[FAILED + 1] = { 0, 0, 0, 0 };
+    for (std::vector<Job>::const_iterator i = _jobs.begin(); i != _jobs.end(); ++i)
+    {
+        ++counts[i->status];
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"version\": \"%u.%u\",\n", GPB_VERSION[0], GPB_VERSION[1]);
+    fprintf(file, "  \"input\": ");
+    writeJsonString(file, _arguments.getFilePath());
+    fprintf(file, ",\n  \"output\": ");
+    writeJsonString(file, _outputPath);
+    fprintf(file, ",\n  \"seconds\": %.3f,\n", seconds);
+    fprintf(file, "  \"encoded\": %u,\n  \"cached\": %u,\n  \"failed\": %u,\n", counts[ENCODED], counts[CACHED], counts[FAILED]);
+    fprintf(file, "  \"assets\": [");
+    for (size_t i = 0; i < _jobs.size(); ++i)
+    {
+        const Job& job = _jobs[i];
+        fprintf(file, "%s\n    {\n      \"input\": ", i > 0 ? "," : "");
+        writeJsonString(file, job.input);
+        fprintf(file, ",\n      \"output\": ");
+        writeJsonString(file, job.output);
+        fprintf(file, ",\n      \"hash\": ");
+        writeJsonString(file, job.hash);
+        fprintf(file, ",\n      \"status\": \"%s\",\n      \"seconds\": %.3f", getStatusString(job.status), job.seconds);
+        if (!job.message.empty())
+        {
+            fprintf(file, ",\n      \"message\": ");
+            writeJsonString(file, job.message);
+        }
+        fprintf(file, "\n    }");
+    }
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+}
+
+void BatchEncoder::encodeJob(unsigned int index, void* encoder)
+{
+    BatchEncoder* batch = (BatchEncoder*)encoder;
+    Job& job = batch->_jobs[index];
+    if (job.status != PENDING)
+    {
+        return;
+    }
+
+    const double startTime = getTime();
+
+    unsigned long long hash = hashBytes(batch->_encoderHash, job.input.c_str(), job.input.size() + 1);
+    if (!hashFile(&hash, job.input))
+    {
+        job.status = FAILED;
+        job.message = "Failed to read file";
+        fprintf(stderr, "Error: Failed to read file: %s\n", job.input.c_str());
+        return;
+    }
+    char hex[17];
+    sprintf(hex, "%016llx", hash);
+    job.hash = hex;
+
+    // The cache is only read while the jobs run, so the threads can share it.
+    // The asset is unchanged if its hash is the same and all of the files it was encoded to still exist.
+    std::map<std::string, CacheEntry>::const_iterator cached = batch->_cache.find(job.output);
+    bool unchanged = cached != batch->_cache.end() && cached->second.hash == job.hash && fileExists(job.output);
+    if (unchanged)
+    {
+        const std::vector<std::string>& outputs = cached->second.outputs;
+        for (std::vector<std::string>::const_iterator i = outputs.begin(); i != outputs.end() && unchanged; ++i)
+        {
+            unchanged = fileExists(*i);
+        }
+    }
+    if (unchanged)
+    {
+        job.outputs = cached->second.outputs;
+        job.status = CACHED;
+        job.seconds = getTime() - startTime;
+        return;
+    }
+
+    // The font size prompt would wait for input that never comes.
+    if (endsWith(job.input, ".ttf") && batch->_arguments.getFontSize() == 0)
+    {
+        job.status = FAILED;
+        job.message = "TrueType fonts need -s <size> in a batch";
+        fprintf(stderr, "Error: %s: %s\n", job.message.c_str(), job.input.c_str());
+        return;
+    }
+
+    // Remove the old output so that an encoder error is not hidden by it.
+    createDirectories(job.outputDirectory);
+    remove(job.output.c_str());
+
+    std::string log = job.output + ".log";
+    std::string command = batch->_command + " " + quote(job.input) + " " + quote(job.outputDirectory) + " > " + quote(log) + " 2>&1";
+#ifdef WIN32
+    // cmd.exe removes the first and last quotes of the command.
+    command = quote(command);
+#endif
+    int result = system(command.c_str());
+
+    job.seconds = getTime() - startTime;
+    if (result == 0 && fileExists(job.output))
+    {
+        batch->findOutputs(job);
+        job.status = ENCODED;
+        remove(log.c_str());
+        fprintf(stderr, "Encoded %s (%.2f seconds)\n", job.input.c_str(), job.seconds);
+    }
+    else
+    {
+        job.status = FAILED;
+        job.message = "See " + log;
+        fprintf(stderr, "Error: Failed to encode %s, see %s\n", job.input.c_str(), log.c_str());
+    }
+}
+
+}
@@ -0,0 +1,153 @@
+#ifndef BATCHENCODER_H_
+#define BATCHENCODER_H_
+
+#include "EncoderArguments.h"
+
+namespace gameplay
+{
+
+/**
+ * The BatchEncoder encodes all of the assets in a directory and its subdirectories, or listed in a
+ * manifest file, into an output directory with the same layout.
+ *
+ * The assets are encoded in parallel by running the encoder once for each of them. The content hash
+ * of each asset, its encoder options and the encoder itself is kept in a cache file in the output
+ * directory with the files it was encoded to, and assets whose hash has not changed since they
+ * were last encoded and whose files all still exist are skipped.
+ * A JSON build report with the status and encoding time of each asset is written next to the cache.
+ */
+class BatchEncoder
+{
+public:
+
+    /**
+     * The name of the cache file in the output directory.
+     */
+    static const char* CACHE_FILE;
+
+    /**
+     * The name of the build report file in the output directory.
+     */
+    static const char* REPORT_FILE;
+
+    /**
+     * The version of the encoder that is added to the content hash of assets
+     * when the encoder executable cannot be read. It is the time the encoder was built.
+     */
+    static const char* ENCODER_VERSION;
+
+    /**
+     * Constructor.
+     *
+     * @param program The path of the encoder executable to run for each asset.
+     * @param arguments The encoder arguments. The input file path is the directory or manifest file of the batch.
+     */
+    BatchEncoder(const char* program, const EncoderArguments& arguments);
+
+    /**
+     * Destructor.
+     */
+    ~BatchEncoder(void);
+
+    /**
+     * Encodes the assets that have changed and writes the cache and build report.
+     *
+     * @return The number of assets that failed to encode, or 1 if the manifest file could not be read.
+     */
+    unsigned int encode();
+
+private:
+
+    /**
+     * The status of an asset after the batch is encoded.
+     */
+    enum Status
+    {
+        PENDING,
+        ENCODED,
+        CACHED,
+        FAILED
+    };
+
+    /**
+     * An asset of the batch.
+     */
+    struct Job
+    {
+        std::string input;
+        std::string outputDirectory;
+        std::string output;
+        std::string hash;
+        std::string message;
+        Status status;
+        double seconds;
+        std::vector<std::string> outputs;
+    };
+
+    /**
+     * The cache entry of an asset: the hash it was encoded with and the files it
+     * was encoded to besides the main output file.
+     */
+    struct CacheEntry
+    {
+        std::string hash;
+        std::vector<std::string> outputs;
+    };
+
+    /**
+     * Hidden copy constructor.
+     */
+    BatchEncoder(const BatchEncoder& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    BatchEncoder& operator=(const BatchEncoder&);
+
+    /**
+     * Adds a job for an asset.
+     *
+     * @param input The path of the asset.
+     * @param relativeDirectory The directory of the asset relative to the batch, ending in a slash or empty.
+     */
+    void addJob(const std::string& input, const std::string& relativeDirectory);
+
+    /**
+     * Adds jobs for the supported assets in the directory and its subdirectories.
+     */
+    void findJobs(const std::string& directory, const std::string& relativeDirectory);
+
+    /**
+     * Adds jobs for the assets listed in the manifest file.
+     *
+     * @return False if the manifest could not be read.
+     */
+    bool readManifest(const std::string& path);
+
+    /**
+     * Finds the files that a job was encoded to besides its main output file:
+     * the cell bundles and index of -cells and the heightmaps of -h.
+     */
+    void findOutputs(Job& job) const;
+
+    void readCache();
+    void writeCache() const;
+    void writeReport(double seconds) const;
+
+    /**
+     * Encodes the asset of one job. Called by Thread::parallelFor.
+     */
+    static void encodeJob(unsigned int index, void* encoder);
+
+    std::string _program;
+    const EncoderArguments& _arguments;
+    std::string _outputPath;
+    std::string _command;
+    unsigned long long _encoderHash;
+    std::vector<Job> _jobs;
+    std::map<std::string, CacheEntry> _cache;
+};
+
+}
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "DAESceneEncoder.h"
 #include "DAEOptimizer.h"
+#include "Thread.h"
 
 //#define ENCODER_PRINT_TIME 1
 
@@ -12,12 +13,17 @@ namespace gameplay
 {
 
 DAESceneEncoder::DAESceneEncoder()
-    : _collada(NULL), _dom(NULL), file(NULL), _vertexBlendWeights(NULL), _vertexBlendIndices(NULL)
+    : _collada(NULL), _dom(NULL), file(NULL), _skinInfluences(NULL)
 {
 }
 
 DAESceneEncoder::~DAESceneEncoder()
 {
+    for (size_t i = 0; i < _meshJobs.size(); ++i)
+    {
+        delete _meshJobs[i];
+    }
+    delete _skinInfluences;
 }
 
 unsigned int getMaxOffset(domInputLocalOffset_Array& inputArray)
@@ -332,10 +338,15 @@ void DAESceneEncoder::write(const std::string& filepath, const EncoderArguments&
     {
         fprintf(stderr, "COLLADA File loaded to the dom, but missing <visual_scene>.\n");
     }
+
+    begin();
+    buildMeshes();
+    end("build meshes");
     
     // The animations should be loaded last
     begin();
     loadAnimations(_dom);
+    decomposeMatrixChannels();
     end("loadAnimations");
 
     _gamePlayFile.adjust();
@@ -495,6 +506,10 @@ void DAESceneEncoder::loadAnimation(const domAnimationRef animationRef, const ch
                 if (animationChannel->getKeyTimes().size() > 0)
                 {
                     animation->add(animationChannel);
+                    if (animationChannel->getTargetAttribute() == Transform::ANIMATE_SCALE_ROTATE_TRANSLATE)
+                    {
+                        _matrixChannels.push_back(animationChannel);
+                    }
                 }
             }
         }
@@ -662,43 +677,9 @@ bool DAESceneEncoder::loadTarget(const domChannelRef& channelRef, AnimationChann
             {
                 // If the animation is targeting a matrix then convert it into
                 // a scale, rotate, translate animation by decomposing the matrix.
+                // The keys are decomposed by decomposeMatrixChannels once all animations are loaded.
                 targetProperty = Transform::ANIMATE_SCALE_ROTATE_TRANSLATE;
-
-                const std::vector<float>& keyValues = animationChannel->getKeyValues();
-                assert(keyValues.size() % 16 == 0);
-                // The matrix was 16 floats and the new values will be 10 floats
-                size_t newSize = keyValues.size() / 16 * 10;
-                std::vector<float> floats(newSize);
-
-                size_t matrixCount = keyValues.size() / 16;
-                for (size_t i = 0; i < matrixCount; ++i)
-                {
-                    size_t j = i * 16;
-                    // COLLADA used row-major but the Matrix class uses column-major
-                    Matrix matrix(
-                        keyValues[j+0], keyValues[j+4], keyValues[j+8], keyValues[j+12],
-                        keyValues[j+1], keyValues[j+5], keyValues[j+9], keyValues[j+13],
-                        keyValues[j+2], keyValues[j+6], keyValues[j+10], keyValues[j+14],
-                        keyValues[j+3], keyValues[j+7], keyValues[j+11], keyValues[j+15]);
-                    Vector3 scale;
-                    Quaternion rotation;
-                    Vector3 translation;
-                    matrix.decompose(&scale, &rotation, &translation);
-                    rotation.normalize();
-
-                    size_t k = i * 10;
-                    floats[k+0] = scale.x;
-                    floats[k+1] = scale.y;
-                    floats[k+2] = scale.z;
-                    floats[k+3] = rotation.x;
-                    floats[k+4] = rotation.y;
-                    floats[k+5] = rotation.z;
-                    floats[k+6] = rotation.w;
-                    floats[k+7] = translation.x;
-                    floats[k+8] = translation.y;
-                    floats[k+9] = translation.z;
-                }
-                animationChannel->setKeyValues(floats);
+                assert(animationChannel->getKeyValues().size() % 16 == 0);
             }
         }
     }
@@ -708,6 +689,53 @@ bool DAESceneEncoder::loadTarget(const domChannelRef& channelRef, AnimationChann
     return true;
 }
 
+static void decomposeMatrixChannel(unsigned int index, void* channels)
+{
+    AnimationChannel* animationChannel = (*(std::vector<AnimationChannel*>*)channels)[index];
+    const std::vector<float>& keyValues = animationChannel->getKeyValues();
+
+    // The matrix was 16 floats and the new values will be 10 floats
+    size_t newSize = keyValues.size() / 16 * 10;
+    std::vector<float> floats(newSize);
+
+    size_t matrixCount = keyValues.size() / 16;
+    for (size_t i = 0; i < matrixCount; ++i)
+    {
+        size_t j = i * 16;
+        // COLLADA used row-major but the Matrix class uses column-major
+        Matrix matrix(
+            keyValues[j+0], keyValues[j+4], keyValues[j+8], keyValues[j+12],
+            keyValues[j+1], keyValues[j+5], keyValues[j+9], keyValues[j+13],
+            keyValues[j+2], keyValues[j+6], keyValues[j+10], keyValues[j+14],
+            keyValues[j+3], keyValues[j+7], keyValues[j+11], keyValues[j+15]);
+        Vector3 scale;
+        Quaternion rotation;
+        Vector3 translation;
+        matrix.decompose(&scale, &rotation, &translation);
+        rotation.normalize();
+
+        size_t k = i * 10;
+        floats[k+0] = scale.x;
+        floats[k+1] = scale.y;
+        floats[k+2] = scale.z;
+        floats[k+3] = rotation.x;
+        floats[k+4] = rotation.y;
+        floats[k+5] = rotation.z;
+        floats[k+6] = rotation.w;
+        floats[k+7] = translation.x;
+        floats[k+8] = translation.y;
+        floats[k+9] = translation.z;
+    }
+    animationChannel->setKeyValues(floats);
+}
+
+void DAESceneEncoder::decomposeMatrixChannels()
+{
+    // Each channel only writes its own keys, so they can be decomposed in parallel.
+    Thread::parallelFor((unsigned int)_matrixChannels.size(), &decomposeMatrixChannel, &_matrixChannels);
+    _matrixChannels.clear();
+}
+
 void DAESceneEncoder::begin()
 {
     #ifdef ENCODER_PRINT_TIME
@@ -1436,8 +1464,8 @@ Model* DAESceneEncoder::loadSkin(const domSkin* skinElement)
     // Get the vertex weights inputs
     domSkin::domVertex_weights* vertexWeights =  skinElement->getVertex_weights();
     domInputLocalOffset_Array& vertexWeightsInputs = vertexWeights->getInput_array();
-    unsigned int vertexWeightsCount = (unsigned int)vertexWeights->getCount();
-    domListOfFloats jointWeights;
+    DAESkinInfluences* skinInfluences = new DAESkinInfluences();
+    skinInfluences->vertexCount = (unsigned int)vertexWeights->getCount();
 
     for (unsigned int i = 0; i < jointInputs.getCount(); ++i)
     {
@@ -1452,34 +1480,62 @@ Model* DAESceneEncoder::loadSkin(const domSkin* skinElement)
             domFloat_array* weights = source->getFloat_array();
             if (weights)
             {
-                jointWeights = weights->getValue();
+                skinInfluences->weights = weights->getValue();
             }
         }
     }
     
     // Get the number of joint influences per vertex
     domSkin::domVertex_weights::domVcount* vCountElement = vertexWeights->getVcount();
-    domListOfUInts skinVertexInfluenceCounts = vCountElement->getValue();
+    skinInfluences->influenceCounts = vCountElement->getValue();
     // Get the joint/weight pair data.
     domSkin::domVertex_weights::domV* vElement = vertexWeights->getV();
-    domListOfInts skinVertexJointWeightPairIndices = vElement->getValue();
+    skinInfluences->jointWeightPairs = vElement->getValue();
         
     // Get the vertex influence count for any given vertex (up to max of 4)
-    unsigned int maxVertexInfluencesCount = SCENE_SKIN_VERTEXINFLUENCES_MAX;
-    skin->setVertexInfluenceCount(maxVertexInfluencesCount);
+    skin->setVertexInfluenceCount(SCENE_SKIN_VERTEXINFLUENCES_MAX);
 
-    // Get the vertex blend weights and joint indices and
-    // allocate our vertex blend weights and blend indices arrays.
-    // These will be used and cleaned up later in LoadMesh
-    int skinVertexInfluenceCountTotal = skinVertexInfluenceCounts.getCount();
-    int totalVertexInfluencesCount = vertexWeightsCount * maxVertexInfluencesCount;
-    _vertexBlendWeights = new float[totalVertexInfluencesCount];
-    _vertexBlendIndices = new unsigned int[totalVertexInfluencesCount];
+    // The influences are expanded into blend weights and indices when the mesh of the skin is built.
+    delete _skinInfluences;
+    _skinInfluences = skinInfluences;
+
+    model->setSkin(skin);
+
+    ///////////////////////////////////////////////////////////
+    // get geometry
+    xsAnyURI geometryURI = skinElement->getSource();
+    domGeometry* geometry = daeSafeCast<domGeometry>(geometryURI.getElement());
+    if (geometry)
+    {
+        const domMesh* meshElement = geometry->getMesh();
+        if (meshElement)
+        {
+            Mesh* mesh = loadMesh(meshElement, geometry->getId());
+            if (mesh)
+            {
+                model->setMesh(mesh);
+            }
+        }
+    }
+    ///////////////////////////////////////////////////////////
+
+    return model;
+}
+
+void DAESceneEncoder::expandSkinInfluences(const DAESkinInfluences* skin, std::vector<float>* blendWeights, std::vector<unsigned int>* blendIndices)
+{
+    const domListOfUInts& skinVertexInfluenceCounts = skin->influenceCounts;
+    const domListOfInts& skinVertexJointWeightPairIndices = skin->jointWeightPairs;
+    const domListOfFloats& jointWeights = skin->weights;
+    unsigned int vertexWeightsCount = skin->vertexCount;
+    unsigned int maxVertexInfluencesCount = SCENE_SKIN_VERTEXINFLUENCES_MAX;
 
     // Preset the default blend weights to 0.0f (no effect) and blend indices to 0 (uses the first which when multiplied
     // will have no effect anyhow.
-    memset(_vertexBlendWeights, 0, totalVertexInfluencesCount * sizeof(float));
-    memset(_vertexBlendIndices , 0, totalVertexInfluencesCount * sizeof(unsigned int));
+    int skinVertexInfluenceCountTotal = skinVertexInfluenceCounts.getCount();
+    int totalVertexInfluencesCount = vertexWeightsCount * maxVertexInfluencesCount;
+    blendWeights->assign(totalVertexInfluencesCount, 0.0f);
+    blendIndices->assign(totalVertexInfluencesCount, 0);
     
     int vOffset = 0;
     int weightOffset = 0;
@@ -1491,7 +1547,6 @@ Model* DAESceneEncoder::loadSkin(const domSkin* skinElement)
         unsigned int vertexInfluenceCount = (unsigned int)skinVertexInfluenceCounts.get(i);
         float vertexInfluencesTotalWeights = 0.0f;
         std::vector<SkinnedVertexWeightPair> vertexInfluences;
-        //vertexInfluences.SetCapacity(vertexInfluenceCount);
 
         // Get the index/weight pairs and some the weight totals while at it.
         for (unsigned int j = 0; j < vertexInfluenceCount; ++j)
@@ -1514,55 +1569,26 @@ Model* DAESceneEncoder::loadSkin(const domSkin* skinElement)
         }
 
         // Get up the the maximum vertex weight influence count.
-         for (unsigned int j = 0; j < maxVertexInfluencesCount; ++j)
+        for (unsigned int j = 0; j < maxVertexInfluencesCount; ++j)
         {
-            if (j < vertexInfluenceCount)
+            if (j < vertexInfluenceCount && weightOffset < totalVertexInfluencesCount)
             {
                 SkinnedVertexWeightPair pair = vertexInfluences[j];
-                _vertexBlendIndices[weightOffset] = pair.BlendIndex;
+                (*blendIndices)[weightOffset] = pair.BlendIndex;
                     
                 if (vertexInfluencesTotalWeights > 0.0f)
                 {
-                    _vertexBlendWeights[weightOffset] = pair.BlendWeight;
+                    (*blendWeights)[weightOffset] = pair.BlendWeight;
                 }
                 else
                 {
-                    if (j == 0)
-                    {
-                        _vertexBlendWeights[weightOffset] = 1.0f;
-                    }
-                    else
-                    {
-                        _vertexBlendWeights[weightOffset] = 0.0f;
-                    }
+                    (*blendWeights)[weightOffset] = j == 0 ? 1.0f : 0.0f;
                 }
             }
 
             weightOffset++;
         }
     }
-
-    model->setSkin(skin);
-
-    ///////////////////////////////////////////////////////////
-    // get geometry
-    xsAnyURI geometryURI = skinElement->getSource();
-    domGeometry* geometry = daeSafeCast<domGeometry>(geometryURI.getElement());
-    if (geometry)
-    {
-        const domMesh* meshElement = geometry->getMesh();
-        if (meshElement)
-        {
-            Mesh* mesh = loadMesh(meshElement, geometry->getId());
-            if (mesh)
-            {
-                model->setMesh(mesh);
-            }
-        }
-    }
-    ///////////////////////////////////////////////////////////
-
-    return model;
 }
 
 Model* DAESceneEncoder::loadGeometry(const domGeometry* geometry, const domBind_materialRef bindMaterial)
@@ -1593,6 +1619,10 @@ Model* DAESceneEncoder::loadGeometry(const domGeometry* geometry, const domBind_
 
 Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& geometryId)
 {
+    // Take the influences of the skin being loaded, if any, so that they are not applied to other meshes.
+    DAESkinInfluences* skinInfluences = _skinInfluences;
+    _skinInfluences = NULL;
+
     const domTriangles_Array& trianglesArray = meshElement->getTriangles_array();
     unsigned int trianglesArrayCount = (unsigned int)trianglesArray.getCount();
 
@@ -1600,6 +1630,7 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
     if (trianglesArrayCount == 0)
     {
         warning(std::string("Geometry mesh has no triangles: ") + geometryId);
+        delete skinInfluences;
         return NULL;
     }
 
@@ -1607,10 +1638,9 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
     Mesh* mesh = _gamePlayFile.getMesh(geometryId.c_str());
     if (mesh)
     {
+        delete skinInfluences;
         return mesh;
     }
-    mesh = new Mesh();
-    mesh->setId(geometryId.c_str());
     
     std::vector<DAEPolygonInput*> polygonInputs;
 
@@ -1693,7 +1723,18 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
                     if (technique.cast())
                     {
                         const domAccessorRef& accessor = technique->getAccessor();
-                        polygonInput->accessor = accessor;
+                        if (accessor)
+                        {
+                            polygonInput->hasAccessor = true;
+                            polygonInput->stride = (unsigned int)accessor->getStride();
+                            polygonInput->count = (unsigned int)accessor->getCount();
+                            const domParam_Array& paramArray = accessor->getParam_array();
+                            for (size_t p = 0; p < paramArray.getCount(); ++p)
+                            {
+                                const char* name = paramArray.get(p)->getName();
+                                polygonInput->paramNames += name ? name[0] : ' ';
+                            }
+                        }
                     }
 
                     polygonInputs.push_back(polygonInput);
@@ -1710,6 +1751,7 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
                     delete polygonInputs[j];
                 }
                 warning(std::string("Triangles do not all have the same number of input sources for geometry mesh: ") + geometryId);
+                delete skinInfluences;
                 return NULL;
             }
             else
@@ -1719,23 +1761,58 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
         }
     }
     
-    // Now we have validated that all input in all triangles are the same and in the same input layout.
+    // The vertices and parts are built by buildMeshes, after the whole scene is loaded.
+    mesh = new Mesh();
+    mesh->setId(geometryId.c_str());
+
+    DAEMeshJob* job = new DAEMeshJob();
+    job->mesh = mesh;
+    job->polygonInputs.swap(polygonInputs);
+    job->skin = skinInfluences;
+    for (unsigned int i = 0; i < trianglesArrayCount; ++i)
+    {
+        domTriangles* triangles = daeSafeCast<domTriangles>(trianglesArray.get(i));
+        job->triangleIndices.push_back(&triangles->getP()->getValue());
+    }
+    _meshJobs.push_back(job);
+
+    _gamePlayFile.addMesh(mesh);
+    return mesh;
+}
+
+void DAESceneEncoder::buildMeshes()
+{
+    Thread::parallelFor((unsigned int)_meshJobs.size(), &DAESceneEncoder::buildMesh, this);
+    for (size_t i = 0; i < _meshJobs.size(); ++i)
+    {
+        delete _meshJobs[i];
+    }
+    _meshJobs.clear();
+}
+
+void DAESceneEncoder::buildMesh(unsigned int index, void* encoder)
+{
+    // This runs on any thread, so it only reads the data gathered by loadMesh and writes to its own mesh.
+    DAEMeshJob* job = ((DAESceneEncoder*)encoder)->_meshJobs[index];
+    Mesh* mesh = job->mesh;
+    const std::vector<DAEPolygonInput*>& polygonInputs = job->polygonInputs;
+    unsigned int trianglesArrayCount = (unsigned int)job->triangleIndices.size();
+
+    std::vector<float> blendWeights;
+    std::vector<unsigned int> blendIndices;
+    if (job->skin)
+    {
+        expandSkinInfluences(job->skin, &blendWeights, &blendIndices);
+    }
+
+    // All input in all triangles are the same and in the same input layout.
     // Lets start to read them and build our subsets.
     for (unsigned int i = 0; i < trianglesArrayCount; ++i)
     {
         // Subset to be built.
         MeshPart* subset = new MeshPart();
 
-        // All of the information about the triangles and the sources to access the data from.
-        domTriangles* triangles = daeSafeCast<domTriangles>(trianglesArray.get(i));
-
-        // Parse the material for this subset
-        //string materialName = triangles->getMaterial() == NULL ? _T("") : triangles->getMaterial();
-        //if (materialName.size() > 0)
-        ///    subset->material = ParseMaterial(bindMaterial, materialName);
-
-        //const domInputLocalOffset_Array& inputArray = triangles->getInput_array();
-        const domListOfUInts& polyInts = triangles->getP()->getValue();
+        const domListOfUInts& polyInts = *job->triangleIndices[i];
         unsigned int polyIntsCount = (unsigned int)polyInts.getCount();
         unsigned int poly = 0;
         unsigned int inputSourceCount = (unsigned int)polygonInputs.size();
@@ -1760,19 +1837,21 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
             {
             case POSITION:
                 vertex = Vertex(); // TODO
-                if (_vertexBlendWeights && _vertexBlendIndices)
+                if (job->skin)
                 {
                     vertex.hasWeights = true;
-
-                    vertex.blendWeights.x =  _vertexBlendWeights[polyIndex * 4];
-                    vertex.blendWeights.y =  _vertexBlendWeights[polyIndex * 4 + 1];
-                    vertex.blendWeights.z =  _vertexBlendWeights[polyIndex * 4 + 2];
-                    vertex.blendWeights.w =  _vertexBlendWeights[polyIndex * 4 + 3];
-
-                    vertex.blendIndices.x =  (float)_vertexBlendIndices[polyIndex * 4];
-                    vertex.blendIndices.y =  (float)_vertexBlendIndices[polyIndex * 4 + 1];
-                    vertex.blendIndices.z =  (float)_vertexBlendIndices[polyIndex * 4 + 2];
-                    vertex.blendIndices.w =  (float)_vertexBlendIndices[polyIndex * 4 + 3];
+                }
+                if (job->skin && polyIndex * 4 + 3 < blendWeights.size())
+                {
+                    vertex.blendWeights.x =  blendWeights[polyIndex * 4];
+                    vertex.blendWeights.y =  blendWeights[polyIndex * 4 + 1];
+                    vertex.blendWeights.z =  blendWeights[polyIndex * 4 + 2];
+                    vertex.blendWeights.w =  blendWeights[polyIndex * 4 + 3];
+
+                    vertex.blendIndices.x =  (float)blendIndices[polyIndex * 4];
+                    vertex.blendIndices.y =  (float)blendIndices[polyIndex * 4 + 1];
+                    vertex.blendIndices.z =  (float)blendIndices[polyIndex * 4 + 2];
+                    vertex.blendIndices.w =  (float)blendIndices[polyIndex * 4 + 3];
                 }
 
                 vertex.position.x = (float)source.get(polyIndex * 3);
@@ -1790,44 +1869,38 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
             // TODO: We must examine the Collada input accessor and read the stride/count to verify this - not ONLY for Color, but we should be doing this for ALL components (i.e. Position, Normal, etc).
             case COLOR:
             {
-                domAccessor* accessor = polygonInputs[k]->accessor;
-                if (accessor)
+                if (polygonInputs[k]->hasAccessor)
                 {
                     vertex.hasDiffuse = true;
                     vertex.diffuse.w = 1.0f;
-                    unsigned int stride = (unsigned int)polygonInputs[k]->accessor->getStride();
+                    unsigned int stride = polygonInputs[k]->stride;
                     unsigned int index = polyIndex * stride;
 
-                    const domParam_Array& paramArray = accessor->getParam_array();
-                    const size_t paramArrayCount = paramArray.getCount();
+                    const std::string& paramNames = polygonInputs[k]->paramNames;
+                    const size_t paramArrayCount = paramNames.size();
 
                     for (size_t i = 0; i < paramArrayCount; ++i)
                     {
-                        const domParamRef& param = paramArray.get(i);
-                        const char* name = param->getName();
-                        if (name)
+                        switch (paramNames[i])
                         {
-                            switch (name[0])
-                            {
-                            case 'r':
-                            case 'R':
-                                vertex.diffuse.x = (float)source.get(index + i); // red
-                                break;
-                            case 'g':
-                            case 'G':
-                                vertex.diffuse.y = (float)source.get(index + i); // green
-                                break;
-                            case 'b':
-                            case 'B':
-                                vertex.diffuse.z = (float)source.get(index + i); // blue
-                                break;
-                            case 'a':
-                            case 'A':
-                                vertex.diffuse.w = (float)source.get(index + i); // alpha
-                                break;
-                            default:
-                                break;
-                            }
+                        case 'r':
+                        case 'R':
+                            vertex.diffuse.x = (float)source.get(index + i); // red
+                            break;
+                        case 'g':
+                        case 'G':
+                            vertex.diffuse.y = (float)source.get(index + i); // green
+                            break;
+                        case 'b':
+                        case 'B':
+                            vertex.diffuse.z = (float)source.get(index + i); // blue
+                            break;
+                        case 'a':
+                        case 'A':
+                            vertex.diffuse.w = (float)source.get(index + i); // alpha
+                            break;
+                        default:
+                            break;
                         }
                     }
                 }
@@ -1850,13 +1923,13 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
 
             case TEXCOORD0:
                 vertex.hasTexCoord = true;
-                if (polygonInputs[k]->accessor)
+                if (polygonInputs[k]->hasAccessor)
                 {
                     // TODO: This assumes (s, t) are first
-                    unsigned int stride = (unsigned int)polygonInputs[k]->accessor->getStride();
+                    unsigned int stride = polygonInputs[k]->stride;
                     if (polyIndexInt < 0)
                     {
-                        unsigned int i = (unsigned int)((int)polygonInputs[k]->accessor->getCount()) + polyIndexInt;
+                        unsigned int i = (unsigned int)((int)polygonInputs[k]->count) + polyIndexInt;
                         vertex.texCoord.x = (float)source.get(i * stride);
                         vertex.texCoord.y = (float)source.get(i * stride + 1);
                     }
@@ -1884,19 +1957,9 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
             // On the last input source attempt to add the vertex or index an existing one.
             if (k == (inputSourceCount - 1))
             {
-                // Only add unique vertices, use a hashtable and compare the hash functions of the
-                // vertices. If they exist simply lookup the index of the existing ones.
-                // otherwise add and new one and index it.
-                unsigned int index;
-                if (mesh->contains(vertex))
-                {
-                    index = mesh->getVertexIndex(vertex);
-                }
-                else
-                {
-                    index = mesh->addVertex(vertex);
-                }
-                subset->addIndex(index);
+                // Only add unique vertices, using a single lookup in the hashtable of the mesh
+                // that returns the index of an equal vertex or adds this one.
+                subset->addIndex(mesh->addUniqueVertex(vertex));
 
                 poly += (maxOffset+1);
                 k = 0;
@@ -1909,7 +1972,12 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
         // Add our new subset for the mesh.
         mesh->addMeshPart(subset);
     }
-    
+
+    if (mesh->vertices.empty())
+    {
+        return;
+    }
+
     bool hasNormals = mesh->vertices[0].hasNormal;
     bool hasDiffuses = mesh->vertices[0].hasDiffuse;
     bool hasTangents = mesh->vertices[0].hasTangent;
@@ -1954,11 +2022,9 @@ Mesh* DAESceneEncoder::loadMesh(const domMesh* meshElement, const std::string& g
         mesh->addVetexAttribute(BLENDWEIGHTS, Vertex::BLEND_WEIGHTS_COUNT);
         mesh->addVetexAttribute(BLENDINDICES, Vertex::BLEND_INDICES_COUNT);
     }
-
-    _gamePlayFile.addMesh(mesh);
-    return mesh;
 }
 
+
 void DAESceneEncoder::warning(const std::string& message)
 {
     printf("Warning: %s\n", message.c_str());
@@ -2024,7 +2090,9 @@ int DAESceneEncoder::getVertexUsageType(const std::string& semantic)
 DAESceneEncoder::DAEPolygonInput::DAEPolygonInput(void) :
     offset(0),
     type(0),
-    accessor(NULL)
+    hasAccessor(false),
+    stride(0),
+    count(0)
 {
 }
 
@@ -2032,4 +2100,24 @@ DAESceneEncoder::DAEPolygonInput::~DAEPolygonInput(void)
 {
 }
 
+DAESceneEncoder::DAESkinInfluences::DAESkinInfluences(void) :
+    vertexCount(0)
+{
+}
+
+DAESceneEncoder::DAEMeshJob::DAEMeshJob(void) :
+    mesh(NULL),
+    skin(NULL)
+{
+}
+
+DAESceneEncoder::DAEMeshJob::~DAEMeshJob(void)
+{
+    for (size_t i = 0; i < polygonInputs.size(); ++i)
+    {
+        delete polygonInputs[i];
+    }
+    delete skin;
+}
+
 }
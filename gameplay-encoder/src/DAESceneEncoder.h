@@ -62,7 +62,45 @@ private:
         unsigned int offset;
         int type;
         domListOfFloats sourceValues;
-        domAccessor* accessor;
+
+        // The layout of the source, read from its accessor so that meshes can be built off the COLLADA dom.
+        bool hasAccessor;
+        unsigned int stride;
+        unsigned int count;
+        std::string paramNames;     // The first letter of the name of each param, such as "RGBA".
+    };
+
+    /**
+     * The raw joint influences of a skin, expanded into blend weights and indices when its mesh is built.
+     */
+    class DAESkinInfluences
+    {
+    public:
+        DAESkinInfluences(void);
+
+        unsigned int vertexCount;
+        domListOfUInts influenceCounts;
+        domListOfInts jointWeightPairs;
+        domListOfFloats weights;
+    };
+
+    /**
+     * The data needed to build the vertices and parts of a mesh, gathered from the COLLADA
+     * dom while the scene is loaded so that the meshes can be built in parallel afterwards.
+     */
+    class DAEMeshJob
+    {
+    public:
+        DAEMeshJob(void);
+        /**
+         * Destructor.
+         */
+        ~DAEMeshJob(void);
+
+        Mesh* mesh;
+        std::vector<DAEPolygonInput*> polygonInputs;
+        std::vector<const domListOfUInts*> triangleIndices;     // The <p> of each <triangles>, one for each MeshPart.
+        DAESkinInfluences* skin;
     };
 
     class SkinnedVertexWeightPair
@@ -143,9 +181,36 @@ private:
 
     /**
      * Loads and returns a mesh (geometry). If the mesh has already been loaded, it is simply returned.
+     *
+     * The vertices and parts of the mesh are built later by buildMeshes.
      */
     Mesh* loadMesh(const domMesh* meshElement, const std::string& geometryId);
 
+    /**
+     * Builds the vertices and parts of the meshes that were loaded, in parallel.
+     * The meshes are independent, so the output does not depend on the number of threads.
+     */
+    void buildMeshes();
+
+    /**
+     * Builds the vertices and parts of a mesh from the data gathered by loadMesh.
+     *
+     * @param index The index of the mesh job to build.
+     * @param encoder The DAESceneEncoder that owns the mesh jobs.
+     */
+    static void buildMesh(unsigned int index, void* encoder);
+
+    /**
+     * Expands the joint influences of a skin into up to 4 blend weights and indices per vertex.
+     */
+    static void expandSkinInfluences(const DAESkinInfluences* skin, std::vector<float>* blendWeights, std::vector<unsigned int>* blendIndices);
+
+    /**
+     * Converts the matrix keys of the animation channels that target matrices into scale,
+     * rotate and translate keys, in parallel.
+     */
+    void decomposeMatrixChannels();
+
     /**
      * Sets the transform of node from the domNode transform.
      */
@@ -201,8 +266,9 @@ private:
 
     std::map<std::string, int> _jointLookupTable;
     std::vector<Matrix>_jointInverseBindPoseMatrices;
-    float* _vertexBlendWeights;
-    unsigned int* _vertexBlendIndices;
+    DAESkinInfluences* _skinInfluences;     // The influences of the skin whose mesh is loaded next.
+    std::vector<DAEMeshJob*> _meshJobs;
+    std::vector<AnimationChannel*> _matrixChannels;     // Channels whose keys are still matrices.
 
     std::vector<std::string> _tempGroupAnimationIds;
 
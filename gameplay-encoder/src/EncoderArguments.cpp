@@ -15,11 +15,28 @@ static EncoderArguments* __instance;
 
 EncoderArguments::EncoderArguments(size_t argc, const char** argv) :
     _fontSize(0),
+    _threadCount(0),
+    _jobCount(0),
+    _lodCount(0),
+    _maxJointCount(0),
+    _cellSize(0.0f),
+    _positionError(0.0005f),
+    _texCoordError(0.0005f),
+    _normalError(0.005f),
+    _animationPositionTolerance(0.001f),
+    _animationRotationTolerance(0.001f),
+    _animationScaleTolerance(0.001f),
     _parseError(false),
     _fontPreview(false),
     _textOutput(false),
     _daeOutput(false),
-    _isHeightmapHighP(false)
+    _heightmapFormat(HEIGHTMAP_8BIT),
+    _heightmapSpacing(1.0f),
+    _heightmapResolution(0),
+    _optimizeMeshes(true),
+    _quantizeMeshes(true),
+    _optimizeAnimations(true),
+    _flattenNodes(false)
 {
     __instance = this;
 
@@ -36,8 +53,13 @@ EncoderArguments::EncoderArguments(size_t argc, const char** argv) :
         {
             if (arguments[i][0] == '-')
             {
+                size_t start = i;
                 readOption(arguments, &i);
                 index = i + 1;
+                if (arguments[start].compare("-batch") != 0 && arguments[start].compare("-jobs") != 0 && arguments[start].compare("-j") != 0)
+                {
+                    _options.insert(_options.end(), arguments.begin() + start, arguments.begin() + index);
+                }
             }
         }
         if (arguments.size() - index == 2)
@@ -151,9 +173,19 @@ const std::vector<std::string>& EncoderArguments::getHeightmapNodeIds() const
     return _heightmapNodeIds;
 }
 
-bool EncoderArguments::isHeightmapHighP() const
+EncoderArguments::HeightmapFormat EncoderArguments::getHeightmapFormat() const
+{
+    return _heightmapFormat;
+}
+
+float EncoderArguments::getHeightmapSpacing() const
+{
+    return _heightmapSpacing;
+}
+
+unsigned int EncoderArguments::getHeightmapResolution() const
 {
-    return _isHeightmapHighP;
+    return _heightmapResolution;
 }
 
 bool EncoderArguments::parseErrorOccured() const
@@ -176,22 +208,71 @@ bool EncoderArguments::fileExists() const
 
 void EncoderArguments::printUsage() const
 {
-    fprintf(stderr,"Usage: gameplay-encoder [options] <input filepath> <output filepath>\n\n");
+    fprintf(stderr,"Usage: gameplay-encoder [options] <input filepath> <output filepath>\n");
+    fprintf(stderr,"       gameplay-encoder -batch <output directory> [options] <input directory or manifest>\n\n");
     fprintf(stderr,"Supported file extensions:\n");
     fprintf(stderr,"  .dae\t(COLLADA)\n");
     fprintf(stderr,"  .fbx\t(FBX)\n");
     fprintf(stderr,"  .ttf\t(TrueType Font)\n");
     fprintf(stderr,"\n");
+    fprintf(stderr,"Batch options:\n");
+    fprintf(stderr,"  -batch <output directory>\n" \
+        "\t\t\tEncode all of the assets in the input directory and its\n" \
+        "\t\t\tsubdirectories, or listed one per line in the input manifest\n" \
+        "\t\t\tfile, with the other options. Assets that have not changed\n" \
+        "\t\t\tsince they were last encoded with the same options are skipped.\n" \
+        "\t\t\tA build report is written to the output directory.\n");
+    fprintf(stderr,"  -jobs <count>\t\tNumber of assets to encode at once.\n" \
+        "\t\t\tDefaults to one per processor. When several assets are\n" \
+        "\t\t\tencoded at once, each is built on one thread unless -j is given.\n");
+    fprintf(stderr,"\n");
     fprintf(stderr,"COLLADA and FBX file options:\n");
     fprintf(stderr,"  -i <id>\t\tFilter by node ID.\n");
     fprintf(stderr,"  -t\t\t\tWrite text/xml.\n");
+    fprintf(stderr,"  -ap <tolerance>\tLargest translation error of removed animation key frames.\n" \
+        "\t\t\tDefaults to 0.001.\n");
+    fprintf(stderr,"  -ar <radians>\t\tLargest rotation error of removed animation key frames.\n" \
+        "\t\t\tDefaults to 0.001.\n");
+    fprintf(stderr,"  -as <tolerance>\tLargest scale error of removed animation key frames.\n" \
+        "\t\t\tDefaults to 0.001.\n");
+    fprintf(stderr,"  -cells <size>\t\tWrite the static models of each cell of a grid of this size\n" \
+        "\t\t\ton the X and Z axes to their own file, named after the output\n" \
+        "\t\t\tfile and the cell, and list the cells in a .cells file for\n" \
+        "\t\t\tSceneStreamer. Models that are animated, skinned or have cameras\n" \
+        "\t\t\tor lights stay in the output file.\n");
+    fprintf(stderr,"  -flatten\t\tRemove empty nodes and apply the transforms of nodes that\n" \
+        "\t\t\tonly group other nodes to their children. Animated nodes,\n" \
+        "\t\t\tjoints and nodes named by other options are kept.\n");
     fprintf(stderr,"  -g <node id> <animation id>\n" \
         "\t\t\tGroup all animation channels targeting the nodes into a new animation.\n");
     fprintf(stderr,"  -h \"<node ids>\"\n" \
         "\t\t\tList of nodes to generate heightmaps for.\n" \
         "\t\t\tNode id list should be in quotes with a space between each id.\n" \
-        "\t\t\tHeightmaps will be saved in files named <nodeid>.png.\n" \
+        "\t\t\tHeightmaps will be saved in files named heightmap_<nodeid>.png.\n" \
         "\t\t\tFor 24-bit packed height data use -hp instead of -h.\n");
+    fprintf(stderr,"  -hf <8|16|24|float>\tHeightmap format: 8-bit grayscale, 16-bit grayscale or\n" \
+        "\t\t\t24-bit packed RGB PNG, or raw 32-bit floats saved in\n" \
+        "\t\t\theightmap_<nodeid>.raw. Defaults to 8.\n");
+    fprintf(stderr,"  -hs <spacing>\t\tDistance between heightmap samples. Defaults to 1.\n");
+    fprintf(stderr,"  -hr <samples>\t\tNumber of heightmap samples along the longest side of\n" \
+        "\t\t\tthe mesh, instead of using the spacing.\n");
+    fprintf(stderr,"  -j <threads>\t\tNumber of threads to build meshes and animations with.\n" \
+        "\t\t\tDefaults to one per processor.\n");
+    fprintf(stderr,"  -joints <count>\tSplit the parts of skinned meshes so that each part uses\n" \
+        "\t\t\tat most this many joints, and store the joints of each part.\n");
+    fprintf(stderr,"  -lod <levels>\t\tGenerate up to this many levels of detail for each mesh,\n" \
+        "\t\t\teach with half the triangles of the one before.\n");
+    fprintf(stderr,"  -nomeshopt\t\tDo not reorder the triangles and vertices of static meshes\n" \
+        "\t\t\tfor the vertex cache and overdraw.\n");
+    fprintf(stderr,"  -noanimopt\t\tDo not merge component animation channels or remove\n" \
+        "\t\t\tanimation key frames.\n");
+    fprintf(stderr,"  -noquantize\t\tWrite all vertex elements as floats.\n");
+    fprintf(stderr,"  -qp <error>\t\tLargest position error of half float positions, relative\n" \
+        "\t\t\tto the size of the mesh. Defaults to 0.0005.\n");
+    fprintf(stderr,"  -qt <error>\t\tLargest error of half float texture coordinates.\n" \
+        "\t\t\tDefaults to 0.0005.\n");
+    fprintf(stderr,"  -qn <error>\t\tLargest error of packed normals, tangents and binormals.\n" \
+        "\t\t\tDefaults to 0.005.\n");
     fprintf(stderr,"\n");
     fprintf(stderr,"TTF file options:\n");
     fprintf(stderr,"  -s <size of font>\tSize of the font.\n");
@@ -214,6 +295,71 @@ bool EncoderArguments::DAEOutputEnabled() const
     return _daeOutput;
 }
 
+bool EncoderArguments::optimizeMeshesEnabled() const
+{
+    return _optimizeMeshes;
+}
+
+bool EncoderArguments::quantizeMeshesEnabled() const
+{
+    return _quantizeMeshes;
+}
+
+unsigned int EncoderArguments::getLodCount() const
+{
+    return _lodCount;
+}
+
+unsigned int EncoderArguments::getMaxJointCount() const
+{
+    return _maxJointCount;
+}
+
+float EncoderArguments::getCellSize() const
+{
+    return _cellSize;
+}
+
+float EncoderArguments::getPositionError() const
+{
+    return _positionError;
+}
+
+float EncoderArguments::getTexCoordError() const
+{
+    return _texCoordError;
+}
+
+float EncoderArguments::getNormalError() const
+{
+    return _normalError;
+}
+
+bool EncoderArguments::optimizeAnimationsEnabled() const
+{
+    return _optimizeAnimations;
+}
+
+bool EncoderArguments::flattenNodesEnabled() const
+{
+    return _flattenNodes;
+}
+
+float EncoderArguments::getAnimationPositionTolerance() const
+{
+    return _animationPositionTolerance;
+}
+
+float EncoderArguments::getAnimationRotationTolerance() const
+{
+    return _animationRotationTolerance;
+}
+
+float EncoderArguments::getAnimationScaleTolerance() const
+{
+    return _animationScaleTolerance;
+}
+
 const char* EncoderArguments::getNodeId() const
 {
     if (_nodeId.length() == 0)
@@ -228,6 +374,31 @@ unsigned int EncoderArguments::getFontSize() const
     return _fontSize;
 }
 
+unsigned int EncoderArguments::getThreadCount() const
+{
+    return _threadCount;
+}
+
+unsigned int EncoderArguments::getJobCount() const
+{
+    return _jobCount;
+}
+
+bool EncoderArguments::batchEnabled() const
+{
+    return !_batchOutputPath.empty();
+}
+
+const std::string& EncoderArguments::getBatchOutputPath() const
+{
+    return _batchOutputPath;
+}
+
+const std::vector<std::string>& EncoderArguments::getOptions() const
+{
+    return _options;
+}
+
 EncoderArguments::FileFormat EncoderArguments::getFileFormat() const
 {
     if (_filePath.length() < 5)
@@ -272,6 +443,69 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
     }
     switch (str[1])
     {
+    case 'a':
+        // Animation key frame tolerance
+        if (str.compare("-ap") == 0 || str.compare("-ar") == 0 || str.compare("-as") == 0)
+        {
+            (*index)++;
+            if (*index < options.size())
+            {
+                float tolerance = (float)atof(options[*index].c_str());
+                if (str[2] == 'p')
+                {
+                    _animationPositionTolerance = tolerance;
+                }
+                else if (str[2] == 'r')
+                {
+                    _animationRotationTolerance = tolerance;
+                }
+                else
+                {
+                    _animationScaleTolerance = tolerance;
+                }
+            }
+            else
+            {
+                fprintf(stderr, "Error: missing arguemnt for %s.\n", str.c_str());
+                _parseError = true;
+                return;
+            }
+        }
+        break;
+    case 'b':
+        if (str.compare("-batch") == 0)
+        {
+            // Batch output directory
+            (*index)++;
+            if (*index < options.size())
+            {
+                _batchOutputPath = options[*index];
+            }
+            else
+            {
+                fprintf(stderr, "Error: missing arguemnt for -batch.\n");
+                _parseError = true;
+                return;
+            }
+        }
+        break;
+    case 'c':
+        if (str.compare("-cells") == 0)
+        {
+            // Streaming cell size
+            (*index)++;
+            if (*index < options.size())
+            {
+                _cellSize = (float)atof(options[*index].c_str());
+            }
+            else
+            {
+                fprintf(stderr, "Error: missing arguemnt for -cells.\n");
+                _parseError = true;
+                return;
+            }
+        }
+        break;
     case 'd':
         if (str.compare("-dae") == 0)
         {
@@ -287,6 +521,12 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
             _daeOutput = true;
         }
         break;
+    case 'f':
+        if (str.compare("-flatten") == 0)
+        {
+            _flattenNodes = true;
+        }
+        break;
     case 'g':
         if (str.compare("-groupAnimations") == 0 || str.compare("-g") == 0)
         {
@@ -323,7 +563,10 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
             bool isHighPrecision = str.compare("-hp") == 0;
             if (str.compare("-heightmaps") == 0 || str.compare("-h") == 0 || isHighPrecision)
             {
-                _isHeightmapHighP = isHighPrecision;
+                if (isHighPrecision)
+                {
+                    _heightmapFormat = HEIGHTMAP_24BIT;
+                }
                 (*index)++;
                 if (*index < options.size())
                 {
@@ -345,6 +588,154 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
                     fprintf(stderr, "Error: missing argument for -heightmaps.\n");
                 }
             }
+            else if (str.compare("-hf") == 0 || str.compare("-hs") == 0 || str.compare("-hr") == 0)
+            {
+                (*index)++;
+                if (*index >= options.size())
+                {
+                    fprintf(stderr, "Error: missing arguemnt for %s.\n", str.c_str());
+                    _parseError = true;
+                    return;
+                }
+                const std::string& value = options[*index];
+                if (str[2] == 's')
+                {
+                    _heightmapSpacing = (float)atof(value.c_str());
+                }
+                else if (str[2] == 'r')
+                {
+                    _heightmapResolution = (unsigned int)atoi(value.c_str());
+                }
+                else if (value.compare("8") == 0)
+                {
+                    _heightmapFormat = HEIGHTMAP_8BIT;
+                }
+                else if (value.compare("16") == 0)
+                {
+                    _heightmapFormat = HEIGHTMAP_16BIT;
+                }
+                else if (value.compare("24") == 0)
+                {
+                    _heightmapFormat = HEIGHTMAP_24BIT;
+                }
+                else if (value.compare("float") == 0)
+                {
+                    _heightmapFormat = HEIGHTMAP_FLOAT;
+                }
+                else
+                {
+                    fprintf(stderr, "Error: unknown heightmap format: %s\n", value.c_str());
+                    _parseError = true;
+                    return;
+                }
+            }
+        }
+        break;
+    case 'j':
+        if (str.compare("-joints") == 0)
+        {
+            // Joint count of skinned mesh parts
+            (*index)++;
+            if (*index < options.size())
+            {
+                _maxJointCount = (unsigned int)atoi(options[*index].c_str());
+            }
+            else
+            {
+                fprintf(stderr, "Error: missing arguemnt for -joints.\n");
+                _parseError = true;
+                return;
+            }
+            break;
+        }
+        if (str.compare("-jobs") == 0)
+        {
+            // Number of assets of a batch to encode at once
+            (*index)++;
+            if (*index < options.size())
+            {
+                _jobCount = (unsigned int)atoi(options[*index].c_str());
+            }
+            else
+            {
+                fprintf(stderr, "Error: missing arguemnt for -jobs.\n");
+                _parseError = true;
+                return;
+            }
+            break;
+        }
+
+        // Thread count
+        (*index)++;
+        if (*index < options.size())
+        {
+            _threadCount = (unsigned int)atoi(options[*index].c_str());
+        }
+        else
+        {
+            fprintf(stderr, "Error: missing arguemnt for -%c.\n", str[1]);
+            _parseError = true;
+            return;
+        }
+        break;
+    case 'l':
+        if (str.compare("-lod") == 0)
+        {
+            // Level of detail count
+            (*index)++;
+            if (*index < options.size())
+            {
+                _lodCount = (unsigned int)atoi(options[*index].c_str());
+            }
+            else
+            {
+                fprintf(stderr, "Error: missing arguemnt for -lod.\n");
+                _parseError = true;
+                return;
+            }
+        }
+        break;
+    case 'n':
+        if (str.compare("-nomeshopt") == 0)
+        {
+            _optimizeMeshes = false;
+        }
+        else if (str.compare("-noquantize") == 0)
+        {
+            _quantizeMeshes = false;
+        }
+        else if (str.compare("-noanimopt") == 0)
+        {
+            _optimizeAnimations = false;
+        }
+        break;
+    case 'q':
+        // Quantization error
+        if (str.compare("-qp") == 0 || str.compare("-qt") == 0 || str.compare("-qn") == 0)
+        {
+            (*index)++;
+            if (*index < options.size())
+            {
+                float error = (float)atof(options[*index].c_str());
+                if (str[2] == 'p')
+                {
+                    _positionError = error;
+                }
+                else if (str[2] == 't')
+                {
+                    _texCoordError = error;
+                }
+                else
+                {
+                    _normalError = error;
+                }
+            }
+            else
+            {
+                fprintf(stderr, "Error: missing arguemnt for %s.\n", str.c_str());
+                _parseError = true;
+                return;
+            }
         }
         break;
     case 'p':
@@ -20,6 +20,17 @@ public:
         FILEFORMAT_GPB
     };
 
+    /**
+     * The formats that heightmaps can be written in.
+     */
+    enum HeightmapFormat
+    {
+        HEIGHTMAP_8BIT,     // 8-bit grayscale PNG
+        HEIGHTMAP_24BIT,    // 24-bit packed RGB PNG
+        HEIGHTMAP_16BIT,    // 16-bit grayscale PNG
+        HEIGHTMAP_FLOAT     // Raw 32-bit floats
+    };
+
     /**
      * Constructor.
      */
@@ -76,9 +87,19 @@ public:
     const std::vector<std::string>& getHeightmapNodeIds() const;
     
     /**
-     * Returns true if the heightmap is to be high precision (24-bit packed).
+     * Returns the format to write heightmaps in.
+     */
+    HeightmapFormat getHeightmapFormat() const;
+
+    /**
+     * Returns the distance between the samples of heightmaps, in the units of the mesh positions.
      */
-    bool isHeightmapHighP() const;
+    float getHeightmapSpacing() const;
+
+    /**
+     * Returns the number of samples along the longest side of heightmaps, or 0 to use the spacing.
+     */
+    unsigned int getHeightmapResolution() const;
 
     /**
      * Returns true if an error occurred while parsing the command line arguments.
@@ -101,9 +122,103 @@ public:
     bool textOutputEnabled() const;
     bool DAEOutputEnabled() const;
 
+    /**
+     * Returns true if the indices and vertices of static meshes should be reordered for the GPU vertex cache.
+     */
+    bool optimizeMeshesEnabled() const;
+
+    /**
+     * Returns true if vertex elements should be stored in smaller data types than floats when they are precise enough.
+     */
+    bool quantizeMeshesEnabled() const;
+
+    /**
+     * Returns true if component animation channels should be merged and animation key frames
+     * that can be interpolated within the tolerances should be removed.
+     */
+    bool optimizeAnimationsEnabled() const;
+
+    /**
+     * Returns true if nodes that only transform their children and empty nodes should be removed.
+     */
+    bool flattenNodesEnabled() const;
+
+    /**
+     * Returns the number of simplified levels of detail to generate for each mesh.
+     */
+    unsigned int getLodCount() const;
+
+    /**
+     * Returns the largest number of joints that each part of a skinned mesh may use, or zero
+     * if skinned mesh parts should not be split.
+     */
+    unsigned int getMaxJointCount() const;
+
+    /**
+     * Returns the size of the cells that static models are split into for streaming, or zero
+     * if all nodes should be written to one file.
+     */
+    float getCellSize() const;
+
+    /**
+     * Returns the largest position error of quantized vertices, relative to the largest dimension of the mesh.
+     */
+    float getPositionError() const;
+
+    /**
+     * Returns the largest texture coordinate error of quantized vertices.
+     */
+    float getTexCoordError() const;
+
+    /**
+     * Returns the largest error of each normal, tangent and binormal component of quantized vertices.
+     */
+    float getNormalError() const;
+
+    /**
+     * Returns the largest translation error of interpolating over removed animation key frames.
+     */
+    float getAnimationPositionTolerance() const;
+
+    /**
+     * Returns the largest angle in radians of interpolating over removed animation key frames.
+     */
+    float getAnimationRotationTolerance() const;
+
+    /**
+     * Returns the largest scale error of interpolating over removed animation key frames.
+     */
+    float getAnimationScaleTolerance() const;
+
     const char* getNodeId() const;
     unsigned int getFontSize() const;
 
+    /**
+     * Returns the number of threads to build the meshes and animations of an asset with,
+     * or 0 to use one per processor.
+     */
+    unsigned int getThreadCount() const;
+
+    /**
+     * Returns the number of assets of a batch to encode at once, or 0 to use one per processor.
+     */
+    unsigned int getJobCount() const;
+
+    /**
+     * Returns true if all of the assets in the input directory or manifest file should be encoded.
+     */
+    bool batchEnabled() const;
+
+    /**
+     * Returns the directory to write the assets of a batch to.
+     */
+    const std::string& getBatchOutputPath() const;
+
+    /**
+     * Returns the command line options to encode each asset of a batch with,
+     * which are all of the options except for -batch, -jobs and -j.
+     */
+    const std::vector<std::string>& getOptions() const;
 
     static std::string getRealPath(const std::string& filepath);
 
@@ -137,18 +252,37 @@ private:
     std::string _fileOutputPath;
     std::string _nodeId;
     std::string _daeOutputPath;
+    std::string _batchOutputPath;
 
     unsigned int _fontSize;
+    unsigned int _threadCount;
+    unsigned int _jobCount;
+    unsigned int _lodCount;
+    unsigned int _maxJointCount;
+    float _cellSize;
+    float _positionError;
+    float _texCoordError;
+    float _normalError;
+    float _animationPositionTolerance;
+    float _animationRotationTolerance;
+    float _animationScaleTolerance;
 
     bool _parseError;
     bool _fontPreview;
     bool _textOutput;
     bool _daeOutput;
-    bool _isHeightmapHighP;
+    HeightmapFormat _heightmapFormat;
+    float _heightmapSpacing;
+    unsigned int _heightmapResolution;
+    bool _optimizeMeshes;
+    bool _quantizeMeshes;
+    bool _optimizeAnimations;
+    bool _flattenNodes;
 
     std::vector<std::string> _groupAnimationNodeId;
     std::vector<std::string> _groupAnimationAnimationId;
     std::vector<std::string> _heightmapNodeIds;
+    std::vector<std::string> _options;
 
 };
 
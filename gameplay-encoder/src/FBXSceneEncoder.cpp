@@ -888,15 +888,7 @@ Mesh* FBXSceneEncoder::loadMesh(FbxMesh* fbxMesh)
             }
 
             // Add the vertex to the mesh if it hasn't already been added and find the vertex index.
-            unsigned int index;
-            if (mesh->contains(vertex))
-            {
-                index = mesh->getVertexIndex(vertex);
-            }
-            else
-            {
-                index = mesh->addVertex(vertex);
-            }
+            unsigned int index = mesh->addUniqueVertex(vertex);
             meshParts[meshPartIndex]->addIndex(index);
             vertexIndex++;
         }
@@ -2,6 +2,10 @@
 #include "GPBFile.h"
 #include "Transform.h"
 #include "StringUtil.h"
+#include "EncoderArguments.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "Thread.h"
 
 #define EPSILON 1.2e-7f;
 
@@ -52,8 +56,17 @@ GPBFile* GPBFile::getInstance()
 
 bool GPBFile::saveBinary(const std::string& filepath)
 {
-    _file = fopen(filepath.c_str(), "w+b");
-    if (!_file)
+    if (EncoderArguments::getInstance()->getCellSize() > 0.0f && !saveCells(filepath))
+    {
+        return false;
+    }
+    return saveBinary(filepath, _refTable, _geometry, _objects);
+}
+
+bool GPBFile::saveBinary(const std::string& filepath, ReferenceTable& refTable, const std::list<Mesh*>& geometry, const std::list<Object*>& objects)
+{
+    FILE* file = fopen(filepath.c_str(), "w+b");
+    if (!file)
     {
         return false;
     }
@@ -61,46 +74,283 @@ bool GPBFile::saveBinary(const std::string& filepath)
 
     // identifier
     char identifier[] = { '', 'G', 'P', 'B', '', '\r', '\n', '\x1A', '\n' };
-    n = fwrite(identifier, 1, sizeof(identifier), _file);
+    n = fwrite(identifier, 1, sizeof(identifier), file);
     if (n != sizeof(identifier))
     {
-        fclose(_file);
+        fclose(file);
         return false;
     }
 
     // version
-    n = fwrite(GPB_VERSION, 1, sizeof(GPB_VERSION), _file);
+    n = fwrite(GPB_VERSION, 1, sizeof(GPB_VERSION), file);
     if (n != sizeof(GPB_VERSION))
     {
-        fclose(_file);
+        fclose(file);
         return false;
     }
 
     // TODO: Check for errors on all file writing.
 
     // write refs
-    _refTable.writeBinary(_file);
+    refTable.writeBinary(file);
 
     // meshes
-    write(_geometry.size(), _file);
-    for (std::list<Mesh*>::const_iterator i = _geometry.begin(); i != _geometry.end(); ++i)
+    write(geometry.size(), file);
+    for (std::list<Mesh*>::const_iterator i = geometry.begin(); i != geometry.end(); ++i)
     {
-        (*i)->writeBinary(_file);
+        (*i)->writeBinary(file);
     }
 
     // Objects
-    write(_objects.size(), _file);
-    for (std::list<Object*>::const_iterator i = _objects.begin(); i != _objects.end(); ++i)
+    write(objects.size(), file);
+    for (std::list<Object*>::const_iterator i = objects.begin(); i != objects.end(); ++i)
     {
-        (*i)->writeBinary(_file);
+        (*i)->writeBinary(file);
     }
 
-    _refTable.updateOffsets(_file);
+    refTable.updateOffsets(file);
     
-    fclose(_file);
+    fclose(file);
+    return true;
+}
+
+/**
+ * A cell of the grid that static models are split into for streaming.
+ */
+struct StreamCell
+{
+    std::vector<Node*> nodes;
+    Vector3 min;
+    Vector3 max;
+};
+
+/**
+ * Returns true if the node and its descendants can be written to a cell: they have a model and
+ * no camera, light, skin or joint, and no node that must stay in the main file.
+ */
+static bool isStreamable(const Node* node, const std::set<std::string>& keep, bool* hasModel)
+{
+    if (node->getCamera() || node->getLight() || node->isJoint() || keep.find(node->getId()) != keep.end())
+    {
+        return false;
+    }
+    if (Model* model = node->getModel())
+    {
+        if (model->getSkin())
+        {
+            return false;
+        }
+        *hasModel = *hasModel || model->getMesh() != NULL;
+    }
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        if (!isStreamable(child, keep, hasModel))
+        {
+            return false;
+        }
+    }
     return true;
 }
 
+/**
+ * Adds the world space bounds of the meshes of the node and its descendants to the box.
+ */
+static void addWorldBounds(const Node* node, Vector3* min, Vector3* max)
+{
+    Model* model = node->getModel();
+    if (model && model->getMesh())
+    {
+        BoundingVolume bounds = model->getMesh()->bounds;
+        bounds.transform(node->getWorldMatrix());
+        min->set(std::min(min->x, bounds.min.x), std::min(min->y, bounds.min.y), std::min(min->z, bounds.min.z));
+        max->set(std::max(max->x, bounds.max.x), std::max(max->y, bounds.max.y), std::max(max->z, bounds.max.z));
+    }
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        addWorldBounds(child, min, max);
+    }
+}
+
+/**
+ * Adds the node and its descendants to the reference table and their meshes to the list.
+ */
+static void addCellObjects(Node* node, ReferenceTable& refTable, std::list<Mesh*>& geometry)
+{
+    if (node->getId().length() > 0 && refTable.get(node->getId()) == NULL)
+    {
+        refTable.add(node->getId(), node);
+    }
+    Model* model = node->getModel();
+    if (model && model->getMesh() && std::find(geometry.begin(), geometry.end(), model->getMesh()) == geometry.end())
+    {
+        if (model->getMesh()->getId().length() > 0)
+        {
+            refTable.add(model->getMesh()->getId(), model->getMesh());
+        }
+        geometry.push_back(model->getMesh());
+    }
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        addCellObjects(child, refTable, geometry);
+    }
+}
+
+/**
+ * Removes the node and its descendants from the reference table and the list of nodes.
+ */
+static void removeCellNodes(Node* node, ReferenceTable& refTable, std::list<Node*>& nodes)
+{
+    if (node->getId().length() > 0)
+    {
+        refTable.remove(node->getId());
+    }
+    nodes.remove(node);
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        removeCellNodes(child, refTable, nodes);
+    }
+}
+
+bool GPBFile::saveCells(const std::string& filepath)
+{
+    const float cellSize = EncoderArguments::getInstance()->getCellSize();
+    std::set<std::string> keep;
+    getReferencedNodeIds(keep);
+
+    // Each root node of a scene that only holds static models goes to the cell of the center of its bounds.
+    std::map<std::pair<int, int>, StreamCell> cells;
+    for (std::list<Object*>::const_iterator i = _objects.begin(); i != _objects.end(); ++i)
+    {
+        if ((*i)->getTypeId() != Object::SCENE_ID)
+        {
+            continue;
+        }
+        Scene* scene = static_cast<Scene*>(*i);
+        std::vector<Node*> roots(scene->getNodes().begin(), scene->getNodes().end());
+        for (std::vector<Node*>::const_iterator j = roots.begin(); j != roots.end(); ++j)
+        {
+            Node* node = *j;
+            bool hasModel = false;
+            if (!isStreamable(node, keep, &hasModel) || !hasModel)
+            {
+                continue;
+            }
+            Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
+            Vector3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+            addWorldBounds(node, &min, &max);
+            std::pair<int, int> key((int)floor((min.x + max.x) * 0.5f / cellSize), (int)floor((min.z + max.z) * 0.5f / cellSize));
+            StreamCell& cell = cells[key];
+            if (cell.nodes.empty())
+            {
+                cell.min = min;
+                cell.max = max;
+            }
+            else
+            {
+                cell.min.set(std::min(cell.min.x, min.x), std::min(cell.min.y, min.y), std::min(cell.min.z, min.z));
+                cell.max.set(std::max(cell.max.x, max.x), std::max(cell.max.y, max.y), std::max(cell.max.z, max.z));
+            }
+            cell.nodes.push_back(node);
+
+            // The node is no longer written to the main file.
+            scene->replace(node, std::vector<Node*>());
+            removeCellNodes(node, _refTable, _nodes);
+        }
+    }
+
+    // Meshes that only the nodes of cells use are no longer written to the main file.
+    std::set<Mesh*> cellMeshes;
+    for (std::map<std::pair<int, int>, StreamCell>::iterator i = cells.begin(); i != cells.end(); ++i)
+    {
+        ReferenceTable refTable;
+        std::list<Mesh*> geometry;
+        for (std::vector<Node*>::const_iterator j = i->second.nodes.begin(); j != i->second.nodes.end(); ++j)
+        {
+            addCellObjects(*j, refTable, geometry);
+        }
+        cellMeshes.insert(geometry.begin(), geometry.end());
+    }
+    for (std::list<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+    {
+        if ((*i)->getModel() && (*i)->getModel()->getMesh())
+        {
+            cellMeshes.erase((*i)->getModel()->getMesh());
+        }
+    }
+    for (std::list<Mesh*>::iterator i = _geometry.begin(); i != _geometry.end();)
+    {
+        if (cellMeshes.find(*i) != cellMeshes.end())
+        {
+            _refTable.remove((*i)->getId());
+            i = _geometry.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // Each cell is written to a file with a scene that holds its nodes. Meshes that are used
+    // by several cells are written to each of them, so that the cells load on their own.
+    std::string basePath = filepath;
+    if (endsWith(basePath, ".gpb"))
+    {
+        basePath = basePath.substr(0, basePath.length() - 4);
+    }
+    std::string indexPath = basePath + ".cells";
+    FILE* index = fopen(indexPath.c_str(), "w");
+    if (!index)
+    {
+        fprintf(stderr, "Error: Failed to open file for writing: %s\n", indexPath.c_str());
+        return false;
+    }
+    fprintf(index, "cells\n{\n");
+    fprintf(index, "    cellSize = %g\n", cellSize);
+    fprintf(index, "    bundle = %s\n", getFilenameFromFilePath(filepath).c_str());
+    fprintf(stderr, "Cells of %g units (nodes, bytes):\n", cellSize);
+    bool saved = true;
+    for (std::map<std::pair<int, int>, StreamCell>::const_iterator i = cells.begin(); i != cells.end(); ++i)
+    {
+        char suffix[32];
+        sprintf(suffix, "_%d_%d", i->first.first, i->first.second);
+        std::string cellPath = basePath + suffix + ".gpb";
+        std::string cellId = getFilenameFromFilePath(basePath) + suffix;
+
+        Scene scene;
+        scene.setId(cellId);
+        ReferenceTable refTable;
+        refTable.add(cellId, &scene);
+        std::list<Mesh*> geometry;
+        for (std::vector<Node*>::const_iterator j = i->second.nodes.begin(); j != i->second.nodes.end(); ++j)
+        {
+            scene.add(*j);
+            addCellObjects(*j, refTable, geometry);
+        }
+        std::list<Object*> objects;
+        objects.push_back(&scene);
+        if (!saveBinary(cellPath, refTable, geometry, objects))
+        {
+            fprintf(stderr, "Error writing binary file: %s\n", cellPath.c_str());
+            saved = false;
+            continue;
+        }
+
+        struct stat info;
+        unsigned int size = stat(cellPath.c_str(), &info) == 0 ? (unsigned int)info.st_size : 0;
+        fprintf(index, "\n    cell %s\n    {\n", cellId.c_str());
+        fprintf(index, "        bundle = %s\n", getFilenameFromFilePath(cellPath).c_str());
+        fprintf(index, "        min = %g, %g, %g\n", i->second.min.x, i->second.min.y, i->second.min.z);
+        fprintf(index, "        max = %g, %g, %g\n", i->second.max.x, i->second.max.y, i->second.max.z);
+        fprintf(index, "        size = %u\n", size);
+        fprintf(index, "    }\n");
+        fprintf(stderr, "  %s: %u, %u\n", cellId.c_str(), (unsigned int)i->second.nodes.size(), size);
+    }
+    fprintf(index, "}\n");
+    fclose(index);
+    fprintf(stderr, "Saved cell index: %s\n", indexPath.c_str());
+    return saved;
+}
+
 bool GPBFile::saveText(const std::string& filepath)
 {
     _file = fopen(filepath.c_str(), "w");
@@ -303,26 +553,46 @@ void GPBFile::adjust()
         }
     }
 
+    removeAmbientLights();
+
+    if (EncoderArguments::getInstance()->flattenNodesEnabled())
+    {
+        flattenNodes();
+    }
+
+    if (EncoderArguments::getInstance()->optimizeAnimationsEnabled())
+    {
+        mergeAnimationChannels();
+        reduceAnimationKeys();
+    }
+
+    if (EncoderArguments::getInstance()->optimizeMeshesEnabled())
+    {
+        optimizeMeshes();
+    }
+
+    if (EncoderArguments::getInstance()->getMaxJointCount() > 0)
+    {
+        splitSkins();
+    }
+
+    if (EncoderArguments::getInstance()->getLodCount() > 0)
+    {
+        generateLods();
+    }
+
     for (std::list<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
     {
         computeBounds(*i);
     }
 
+    if (EncoderArguments::getInstance()->quantizeMeshesEnabled())
+    {
+        quantizeMeshes();
+    }
+
     // try to convert joint transform animations into rotation animations
     //optimizeTransformAnimations();
-
-    // TODO:
-    // remove ambient _lights
-    // for each node
-    //   if node has ambient light
-    //     if node has no camera, mesh or children but 1 ambient light
-    //       delete node and remove from ref table
-    //     delete light and remove from ref table
-    //
-    // merge animations if possible
-    //   Search for animations that have the same target and key times and see if they can be merged.
-    //   Blender will output a simple translation animation to 3 separate animations with the same key times but targeting X, Y and Z.
-    //   This can be merged into one animation. Same for scale animations.
 }
 
 void GPBFile::groupMeshSkinAnimations()
@@ -376,6 +646,688 @@ void GPBFile::computeBounds(Node* node)
     }
 }
 
+/**
+ * A mesh to optimize with its vertex cache statistics.
+ */
+struct MeshOptimization
+{
+    Mesh* mesh;
+    MeshOptimizer::Statistics before;
+    MeshOptimizer::Statistics after;
+};
+
+static void optimizeMesh(unsigned int index, void* optimizations)
+{
+    MeshOptimization& optimization = (*(std::vector<MeshOptimization>*)optimizations)[index];
+    MeshOptimizer::optimize(optimization.mesh, &optimization.before, &optimization.after);
+}
+
+void GPBFile::optimizeMeshes()
+{
+    std::vector<MeshOptimization> optimizations;
+    for (std::list<Mesh*>::const_iterator i = _geometry.begin(); i != _geometry.end(); ++i)
+    {
+        Mesh* mesh = *i;
+        // Only static meshes are optimized.
+        if (mesh->model && mesh->model->getSkin())
+        {
+            continue;
+        }
+        MeshOptimization optimization;
+        optimization.mesh = mesh;
+        optimizations.push_back(optimization);
+    }
+    if (optimizations.empty())
+    {
+        return;
+    }
+
+    // The meshes are independent, so each thread only writes the mesh and statistics of its index.
+    Thread::parallelFor((unsigned int)optimizations.size(), &optimizeMesh, &optimizations);
+
+    fprintf(stderr, "Vertex cache (FIFO %u) ACMR and ATVR before -> after:\n", (unsigned int)MeshOptimizer::CACHE_SIZE);
+    MeshOptimizer::Statistics totalBefore;
+    MeshOptimizer::Statistics totalAfter;
+    for (std::vector<MeshOptimization>::const_iterator i = optimizations.begin(); i != optimizations.end(); ++i)
+    {
+        fprintf(stderr, "  %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", i->mesh->getId().c_str(),
+            i->before.getACMR(), i->after.getACMR(), i->before.getATVR(), i->after.getATVR());
+        totalBefore.triangleCount += i->before.triangleCount;
+        totalBefore.vertexCount += i->before.vertexCount;
+        totalBefore.transformCount += i->before.transformCount;
+        totalAfter.triangleCount += i->after.triangleCount;
+        totalAfter.vertexCount += i->after.vertexCount;
+        totalAfter.transformCount += i->after.transformCount;
+    }
+    fprintf(stderr, "  Total: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+        totalBefore.getACMR(), totalAfter.getACMR(), totalBefore.getATVR(), totalAfter.getATVR());
+}
+
+/**
+ * Returns the number of triangles of the parts.
+ */
+static unsigned int getTriangleCount(const std::vector<MeshPart*>& parts)
+{
+    unsigned int triangleCount = 0;
+    for (std::vector<MeshPart*>::const_iterator i = parts.begin(); i != parts.end(); ++i)
+    {
+        triangleCount += (unsigned int)(*i)->getIndicesCount() / 3;
+    }
+    return triangleCount;
+}
+
+static void generateMeshLods(unsigned int index, void* meshes)
+{
+    // Meshes that are too small to be worth simplifying are left as they are.
+    static const unsigned int MIN_TRIANGLE_COUNT = 64;
+
+    Mesh* mesh = (*(std::vector<Mesh*>*)meshes)[index];
+    bool skinned = mesh->model && mesh->model->getSkin();
+    unsigned int triangleCount = getTriangleCount(mesh->parts);
+    unsigned int lodCount = EncoderArguments::getInstance()->getLodCount();
+    float ratio = 1.0f;
+    for (unsigned int level = 0; level < lodCount && triangleCount >= MIN_TRIANGLE_COUNT; ++level)
+    {
+        // Each level of detail halves the triangles of the mesh, simplifying the original
+        // mesh each time so that the error is measured against it.
+        ratio *= 0.5f;
+        std::vector<std::vector<unsigned int> > lodIndices;
+        float error = MeshSimplifier::simplify(mesh, ratio, skinned, lodIndices);
+
+        unsigned int lodTriangleCount = 0;
+        bool empty = false;
+        for (std::vector<std::vector<unsigned int> >::const_iterator i = lodIndices.begin(); i != lodIndices.end(); ++i)
+        {
+            lodTriangleCount += (unsigned int)i->size() / 3;
+            empty = empty || i->empty();
+        }
+        if (empty || lodTriangleCount * 10 > triangleCount * 9)
+        {
+            // The locked borders and seams keep the mesh from getting much simpler.
+            break;
+        }
+
+        std::vector<MeshPart*> lodParts;
+        for (std::vector<std::vector<unsigned int> >::iterator i = lodIndices.begin(); i != lodIndices.end(); ++i)
+        {
+            MeshOptimizer::optimizeVertexCache(*i, (unsigned int)mesh->getVertexCount());
+            MeshPart* part = new MeshPart();
+            part->setIndices(*i);
+            lodParts.push_back(part);
+        }
+        mesh->addLod(error, lodParts);
+        triangleCount = lodTriangleCount;
+    }
+}
+
+void GPBFile::generateLods()
+{
+    std::vector<Mesh*> meshes;
+    for (std::list<Mesh*>::const_iterator i = _geometry.begin(); i != _geometry.end(); ++i)
+    {
+        Mesh* mesh = *i;
+        bool triangles = !mesh->parts.empty();
+        for (std::vector<MeshPart*>::const_iterator j = mesh->parts.begin(); j != mesh->parts.end(); ++j)
+        {
+            triangles = triangles && (*j)->getPrimitiveType() == MeshPart::TRIANGLES;
+        }
+        if (triangles)
+        {
+            meshes.push_back(mesh);
+        }
+    }
+    if (meshes.empty())
+    {
+        return;
+    }
+
+    // Each thread only adds levels of detail to the mesh of its index.
+    Thread::parallelFor((unsigned int)meshes.size(), &generateMeshLods, &meshes);
+
+    fprintf(stderr, "Levels of detail (triangles, error):\n");
+    for (std::vector<Mesh*>::const_iterator i = meshes.begin(); i != meshes.end(); ++i)
+    {
+        const Mesh* mesh = *i;
+        fprintf(stderr, "  %s: %u", mesh->getId().c_str(), getTriangleCount(mesh->parts));
+        for (std::vector<MeshLod>::const_iterator j = mesh->lods.begin(); j != mesh->lods.end(); ++j)
+        {
+            fprintf(stderr, " -> %u (%g)", getTriangleCount(j->parts), j->error);
+        }
+        fprintf(stderr, "\n");
+    }
+}
+
+/**
+ * A skin to split with the results of the split.
+ */
+struct SkinSplit
+{
+    MeshSkin* skin;
+    Mesh* mesh;
+    unsigned int partCount;
+    unsigned int vertexCount;
+    bool split;
+};
+
+static void splitSkin(unsigned int index, void* splits)
+{
+    SkinSplit& split = (*(std::vector<SkinSplit>*)splits)[index];
+    split.split = split.skin->splitParts(EncoderArguments::getInstance()->getMaxJointCount());
+}
+
+void GPBFile::splitSkins()
+{
+    std::vector<SkinSplit> splits;
+    std::set<Mesh*> meshes;
+    for (std::list<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+    {
+        Model* model = (*i)->getModel();
+        MeshSkin* skin = model ? model->getSkin() : NULL;
+        // A mesh that is shared by several skins is only split for the first of them.
+        if (skin && model->getMesh() && meshes.insert(model->getMesh()).second)
+        {
+            SkinSplit split;
+            split.skin = skin;
+            split.mesh = model->getMesh();
+            split.partCount = (unsigned int)split.mesh->parts.size();
+            split.vertexCount = (unsigned int)split.mesh->getVertexCount();
+            split.split = false;
+            splits.push_back(split);
+        }
+    }
+
+    // Each thread only changes the mesh of the skin of its index.
+    Thread::parallelFor((unsigned int)splits.size(), &splitSkin, &splits);
+
+    unsigned int maxJointCount = EncoderArguments::getInstance()->getMaxJointCount();
+    bool header = false;
+    for (std::vector<SkinSplit>::const_iterator i = splits.begin(); i != splits.end(); ++i)
+    {
+        if (!i->split)
+        {
+            continue;
+        }
+        if (!header)
+        {
+            fprintf(stderr, "Skinned mesh parts split to %u joints (parts, vertices, joints of each part):\n", maxJointCount);
+            header = true;
+        }
+        const Mesh* mesh = i->mesh;
+        const std::vector<std::vector<unsigned int> >& partJoints = i->skin->getPartJoints();
+        fprintf(stderr, "  %s: %u -> %u parts, %u -> %u vertices, joints", mesh->getId().c_str(),
+            i->partCount, (unsigned int)mesh->parts.size(), i->vertexCount, (unsigned int)mesh->getVertexCount());
+        for (std::vector<std::vector<unsigned int> >::const_iterator j = partJoints.begin(); j != partJoints.end(); ++j)
+        {
+            fprintf(stderr, " %u", (unsigned int)j->size());
+        }
+        fprintf(stderr, " of %u\n", (unsigned int)i->skin->getJoints().size());
+    }
+}
+
+/**
+ * Returns the size in bytes of the vertex data of the mesh.
+ */
+static unsigned int getVertexDataSize(const Mesh* mesh)
+{
+    unsigned int vertexSize = 0;
+    for (unsigned int i = 0, count = (unsigned int)mesh->getVertexElementCount(); i < count; ++i)
+    {
+        vertexSize += mesh->getVertexElement(i).byteSize();
+    }
+    return vertexSize * (unsigned int)mesh->getVertexCount();
+}
+
+static void quantizeMesh(unsigned int index, void* meshes)
+{
+    const EncoderArguments* arguments = EncoderArguments::getInstance();
+    Mesh* mesh = (*(std::vector<Mesh*>*)meshes)[index];
+    mesh->quantizeVertexFormat(arguments->getPositionError(), arguments->getTexCoordError(), arguments->getNormalError());
+}
+
+void GPBFile::quantizeMeshes()
+{
+    std::vector<Mesh*> meshes(_geometry.begin(), _geometry.end());
+    if (meshes.empty())
+    {
+        return;
+    }
+
+    std::vector<unsigned int> sizes;
+    for (std::vector<Mesh*>::const_iterator i = meshes.begin(); i != meshes.end(); ++i)
+    {
+        sizes.push_back(getVertexDataSize(*i));
+    }
+
+    // Each thread only changes the vertex format of the mesh of its index.
+    Thread::parallelFor((unsigned int)meshes.size(), &quantizeMesh, &meshes);
+
+    fprintf(stderr, "Vertex data bytes before -> after quantization:\n");
+    unsigned int totalBefore = 0;
+    unsigned int totalAfter = 0;
+    for (unsigned int i = 0, count = (unsigned int)meshes.size(); i < count; ++i)
+    {
+        unsigned int size = getVertexDataSize(meshes[i]);
+        fprintf(stderr, "  %s: %u -> %u\n", meshes[i]->getId().c_str(), sizes[i], size);
+        totalBefore += sizes[i];
+        totalAfter += size;
+    }
+    fprintf(stderr, "  Total: %u -> %u\n", totalBefore, totalAfter);
+}
+
+/**
+ * Gets the axes of a translate or scale animation property that animates some of the axes.
+ *
+ * @param attrib The animation property.
+ * @param base Returns ANIMATE_TRANSLATE or ANIMATE_SCALE.
+ *
+ * @return The axes as a mask of x = 1, y = 2 and z = 4, or zero for any other property.
+ */
+static unsigned int getAxisMask(unsigned int attrib, unsigned int* base)
+{
+    // The X, Y, Z, XY, XZ and YZ properties of translate and scale are in the same order.
+    static const unsigned int masks[] = { 1, 2, 4, 3, 5, 6 };
+    if (attrib >= Transform::ANIMATE_SCALE_X && attrib <= Transform::ANIMATE_SCALE_YZ)
+    {
+        *base = Transform::ANIMATE_SCALE;
+        return masks[attrib - Transform::ANIMATE_SCALE_X];
+    }
+    if (attrib >= Transform::ANIMATE_TRANSLATE_X && attrib <= Transform::ANIMATE_TRANSLATE_YZ)
+    {
+        *base = Transform::ANIMATE_TRANSLATE;
+        return masks[attrib - Transform::ANIMATE_TRANSLATE_X];
+    }
+    return 0;
+}
+
+/**
+ * Linearly interpolates one component of the key values of an animation channel at the given time.
+ * Times before the first or after the last key frame use the value of that key frame.
+ */
+static float interpolateComponent(const AnimationChannel* channel, unsigned int component, float time)
+{
+    const std::vector<float>& keyTimes = channel->getKeyTimes();
+    const std::vector<float>& keyValues = channel->getKeyValues();
+    const size_t propSize = keyValues.size() / keyTimes.size();
+
+    if (time <= keyTimes.front())
+    {
+        return keyValues[component];
+    }
+    if (time >= keyTimes.back())
+    {
+        return keyValues[(keyTimes.size() - 1) * propSize + component];
+    }
+    const size_t to = std::upper_bound(keyTimes.begin(), keyTimes.end(), time) - keyTimes.begin();
+    const size_t from = to - 1;
+    const float t = (time - keyTimes[from]) / (keyTimes[to] - keyTimes[from]);
+    const float a = keyValues[from * propSize + component];
+    const float b = keyValues[to * propSize + component];
+    return a + (b - a) * t;
+}
+
+void GPBFile::mergeAnimationChannels()
+{
+    typedef std::map<std::pair<std::string, unsigned int>, std::vector<AnimationChannel*> > ChannelGroups;
+
+    for (unsigned int i = 0, animationCount = _animations.getAnimationCount(); i < animationCount; ++i)
+    {
+        Animation* animation = _animations.getAnimation(i);
+
+        // Group the channels by their target and whether they translate or scale it.
+        ChannelGroups groups;
+        for (unsigned int j = 0, channelCount = animation->getAnimationChannelCount(); j < channelCount; ++j)
+        {
+            AnimationChannel* channel = animation->getAnimationChannel(j);
+            unsigned int base = 0;
+            const size_t propSize = Transform::getPropertySize(channel->getTargetAttribute());
+            if (getAxisMask(channel->getTargetAttribute(), &base) != 0 && channel->isLinear() &&
+                !channel->getKeyTimes().empty() && channel->getKeyValues().size() == channel->getKeyTimes().size() * propSize)
+            {
+                groups[std::make_pair(channel->getTargetId(), base)].push_back(channel);
+            }
+        }
+
+        for (ChannelGroups::iterator j = groups.begin(); j != groups.end(); ++j)
+        {
+            const std::string& targetId = j->first.first;
+            const unsigned int base = j->first.second;
+            std::vector<AnimationChannel*>& channels = j->second;
+            if (channels.size() < 2)
+            {
+                continue;
+            }
+
+            // Find the channel and component that animates each axis, and skip the group if two channels animate the same axis.
+            AnimationChannel* axisChannels[3] = { NULL, NULL, NULL };
+            unsigned int axisComponents[3] = { 0, 0, 0 };
+            bool overlap = false;
+            for (std::vector<AnimationChannel*>::const_iterator k = channels.begin(); k != channels.end(); ++k)
+            {
+                unsigned int channelBase;
+                const unsigned int mask = getAxisMask((*k)->getTargetAttribute(), &channelBase);
+                unsigned int component = 0;
+                for (unsigned int axis = 0; axis < 3; ++axis)
+                {
+                    if (mask & (1 << axis))
+                    {
+                        overlap |= axisChannels[axis] != NULL;
+                        axisChannels[axis] = *k;
+                        axisComponents[axis] = component++;
+                    }
+                }
+            }
+            if (overlap)
+            {
+                continue;
+            }
+
+            // The runtime plays each channel over its own duration, so channels that start or end
+            // at different times would play differently once merged.
+            bool sameDuration = true;
+            for (std::vector<AnimationChannel*>::const_iterator k = channels.begin() + 1; k != channels.end(); ++k)
+            {
+                sameDuration = sameDuration &&
+                    (*k)->getKeyTimes().front() == channels.front()->getKeyTimes().front() &&
+                    (*k)->getKeyTimes().back() == channels.front()->getKeyTimes().back();
+            }
+            if (!sameDuration)
+            {
+                continue;
+            }
+
+            // The axes that are not animated keep the value of the local transform of the target node.
+            Vector3 scale(1.0f, 1.0f, 1.0f);
+            Quaternion rotation;
+            Vector3 translation;
+            Object* obj = _refTable.get(targetId);
+            if (obj && obj->getTypeId() == Object::NODE_ID)
+            {
+                static_cast<Node*>(obj)->getTransformMatrix().decompose(&scale, &rotation, &translation);
+            }
+            const Vector3& values = base == Transform::ANIMATE_SCALE ? scale : translation;
+            const float defaults[3] = { values.x, values.y, values.z };
+
+            // Sample all of the channels at the key times of each of them, which is exact for linear channels.
+            std::vector<float> keyTimes;
+            for (std::vector<AnimationChannel*>::const_iterator k = channels.begin(); k != channels.end(); ++k)
+            {
+                keyTimes.insert(keyTimes.end(), (*k)->getKeyTimes().begin(), (*k)->getKeyTimes().end());
+            }
+            std::sort(keyTimes.begin(), keyTimes.end());
+            keyTimes.erase(std::unique(keyTimes.begin(), keyTimes.end()), keyTimes.end());
+
+            std::vector<float> keyValues;
+            keyValues.reserve(keyTimes.size() * 3);
+            for (std::vector<float>::const_iterator k = keyTimes.begin(); k != keyTimes.end(); ++k)
+            {
+                for (unsigned int axis = 0; axis < 3; ++axis)
+                {
+                    keyValues.push_back(axisChannels[axis] ? interpolateComponent(axisChannels[axis], axisComponents[axis], *k) : defaults[axis]);
+                }
+            }
+
+            AnimationChannel* merged = new AnimationChannel();
+            merged->setTargetId(targetId);
+            merged->setTargetAttribute(base);
+            merged->setKeyTimes(keyTimes);
+            merged->setKeyValues(keyValues);
+            merged->setInterpolation(AnimationChannel::LINEAR);
+
+            for (std::vector<AnimationChannel*>::iterator k = channels.begin(); k != channels.end(); ++k)
+            {
+                animation->remove(*k);
+                SAFE_DELETE(*k);
+            }
+            animation->add(merged);
+        }
+    }
+}
+
+/**
+ * Returns the number of key frames of all of the channels of the animation.
+ */
+static unsigned int getKeyCount(const Animation* animation)
+{
+    unsigned int keyCount = 0;
+    for (unsigned int i = 0, count = animation->getAnimationChannelCount(); i < count; ++i)
+    {
+        keyCount += (unsigned int)animation->getAnimationChannel(i)->getKeyTimes().size();
+    }
+    return keyCount;
+}
+
+static void reduceAnimationChannelKeys(unsigned int index, void* channels)
+{
+    const EncoderArguments* arguments = EncoderArguments::getInstance();
+    AnimationChannel* channel = (*(std::vector<AnimationChannel*>*)channels)[index];
+    channel->reduceKeys(arguments->getAnimationPositionTolerance(), arguments->getAnimationRotationTolerance(), arguments->getAnimationScaleTolerance());
+}
+
+void GPBFile::reduceAnimationKeys()
+{
+    const unsigned int animationCount = _animations.getAnimationCount();
+    std::vector<AnimationChannel*> channels;
+    std::vector<unsigned int> keyCounts;
+    for (unsigned int i = 0; i < animationCount; ++i)
+    {
+        Animation* animation = _animations.getAnimation(i);
+        for (unsigned int j = 0, count = animation->getAnimationChannelCount(); j < count; ++j)
+        {
+            channels.push_back(animation->getAnimationChannel(j));
+        }
+        keyCounts.push_back(getKeyCount(animation));
+    }
+    if (channels.empty())
+    {
+        return;
+    }
+
+    // Each thread only changes the key frames of the channel of its index.
+    Thread::parallelFor((unsigned int)channels.size(), &reduceAnimationChannelKeys, &channels);
+
+    fprintf(stderr, "Animation key frames before -> after reduction:\n");
+    unsigned int totalBefore = 0;
+    unsigned int totalAfter = 0;
+    for (unsigned int i = 0; i < animationCount; ++i)
+    {
+        const Animation* animation = _animations.getAnimation(i);
+        unsigned int keyCount = getKeyCount(animation);
+        fprintf(stderr, "  %s: %u -> %u\n", animation->getId().c_str(), keyCounts[i], keyCount);
+        totalBefore += keyCounts[i];
+        totalAfter += keyCount;
+    }
+    fprintf(stderr, "  Total: %u -> %u\n", totalBefore, totalAfter);
+}
+
+void GPBFile::removeAmbientLights()
+{
+    for (std::list<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+    {
+        Light* light = (*i)->getLight();
+        if (light && light->isAmbient())
+        {
+            (*i)->setLight(NULL);
+        }
+    }
+
+    // Lights may be shared by several nodes, so they are deleted after all of the nodes are updated.
+    for (std::list<Light*>::iterator i = _lights.begin(); i != _lights.end(); )
+    {
+        Light* light = *i;
+        if (light->isAmbient())
+        {
+            if (_refTable.get(light->getId()) == light)
+            {
+                _refTable.remove(light->getId());
+            }
+            i = _lights.erase(i);
+            SAFE_DELETE(light);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+/**
+ * Returns true if the node only transforms its children.
+ */
+static bool isTransformNode(const Node* node, const std::set<std::string>& keep)
+{
+    return !node->isJoint() && !node->hasCamera() && !node->hasLight() && node->getModel() == NULL &&
+        keep.find(node->getId()) == keep.end();
+}
+
+void GPBFile::getReferencedNodeIds(std::set<std::string>& ids) const
+{
+    for (unsigned int i = 0, animationCount = _animations.getAnimationCount(); i < animationCount; ++i)
+    {
+        const Animation* animation = _animations.getAnimation(i);
+        for (unsigned int j = 0, channelCount = animation->getAnimationChannelCount(); j < channelCount; ++j)
+        {
+            ids.insert(animation->getAnimationChannel(j)->getTargetId());
+        }
+    }
+    for (std::list<Node*>::const_iterator i = _nodes.begin(); i != _nodes.end(); ++i)
+    {
+        const Node* node = *i;
+        if (node->isJoint())
+        {
+            ids.insert(node->getId());
+        }
+        const MeshSkin* skin = node->getModel() ? node->getModel()->getSkin() : NULL;
+        if (skin)
+        {
+            const std::vector<Node*>& joints = skin->getJoints();
+            for (std::vector<Node*>::const_iterator j = joints.begin(); j != joints.end(); ++j)
+            {
+                ids.insert((*j)->getId());
+            }
+        }
+    }
+    const EncoderArguments* arguments = EncoderArguments::getInstance();
+    if (arguments->getNodeId())
+    {
+        ids.insert(arguments->getNodeId());
+    }
+    ids.insert(arguments->getGroupAnimationNodeId().begin(), arguments->getGroupAnimationNodeId().end());
+    ids.insert(arguments->getHeightmapNodeIds().begin(), arguments->getHeightmapNodeIds().end());
+}
+
+void GPBFile::flattenNodes()
+{
+    // Keep the nodes that animations, skins and the encoder arguments refer to by id.
+    std::set<std::string> keep;
+    getReferencedNodeIds(keep);
+
+    std::set<Node*> removed;
+    for (std::list<Object*>::const_iterator i = _objects.begin(); i != _objects.end(); ++i)
+    {
+        if ((*i)->getTypeId() == Object::SCENE_ID)
+        {
+            Scene* scene = static_cast<Scene*>(*i);
+            std::vector<Node*> roots(scene->getNodes().begin(), scene->getNodes().end());
+            for (std::vector<Node*>::const_iterator j = roots.begin(); j != roots.end(); ++j)
+            {
+                std::vector<Node*> nodes;
+                flattenNode(*j, keep, removed, nodes);
+                if (nodes.size() != 1 || nodes[0] != *j)
+                {
+                    scene->replace(*j, nodes);
+                }
+            }
+        }
+        else if ((*i)->getTypeId() == Object::NODE_ID)
+        {
+            // Nodes without a scene are written on their own, so only their children are flattened.
+            flattenChildren(static_cast<Node*>(*i), keep, removed);
+        }
+    }
+
+    const unsigned int nodeCount = (unsigned int)_nodes.size();
+    for (std::list<Node*>::iterator i = _nodes.begin(); i != _nodes.end(); )
+    {
+        Node* node = *i;
+        if (removed.find(node) != removed.end())
+        {
+            if (_refTable.get(node->getId()) == node)
+            {
+                _refTable.remove(node->getId());
+            }
+            i = _nodes.erase(i);
+            SAFE_DELETE(node);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    fprintf(stderr, "Nodes before -> after flattening: %u -> %u\n", nodeCount, (unsigned int)_nodes.size());
+}
+
+void GPBFile::flattenChildren(Node* node, const std::set<std::string>& keep, std::set<Node*>& removed)
+{
+    std::vector<Node*> children;
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        children.push_back(child);
+    }
+
+    bool changed = false;
+    std::vector<Node*> flattened;
+    for (std::vector<Node*>::const_iterator i = children.begin(); i != children.end(); ++i)
+    {
+        std::vector<Node*> nodes;
+        flattenNode(*i, keep, removed, nodes);
+        changed |= nodes.size() != 1 || nodes[0] != *i;
+        flattened.insert(flattened.end(), nodes.begin(), nodes.end());
+    }
+
+    // Re-adding all of the children keeps them in the same order.
+    if (changed)
+    {
+        node->removeChildren();
+        for (std::vector<Node*>::const_iterator i = flattened.begin(); i != flattened.end(); ++i)
+        {
+            node->addChild(*i);
+        }
+    }
+}
+
+void GPBFile::flattenNode(Node* node, const std::set<std::string>& keep, std::set<Node*>& removed, std::vector<Node*>& nodes)
+{
+    // Flatten the children first so that nodes whose children are all removed are removed too.
+    flattenChildren(node, keep, removed);
+
+    if (!isTransformNode(node, keep))
+    {
+        nodes.push_back(node);
+        return;
+    }
+
+    // The transforms of animated nodes and joints are replaced at runtime, so the transform of
+    // their parent can not be applied to them.
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        if (child->isJoint() || keep.find(child->getId()) != keep.end())
+        {
+            nodes.push_back(node);
+            return;
+        }
+    }
+
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        float transform[16];
+        Matrix::multiply(node->getTransformMatrix().m, child->getTransformMatrix().m, transform);
+        child->setTransformMatrix(transform);
+        nodes.push_back(child);
+    }
+    node->removeChildren();
+    removed.insert(node);
+}
+
 void GPBFile::optimizeTransformAnimations()
 {
     const unsigned int animationCount = _animations.getAnimationCount();
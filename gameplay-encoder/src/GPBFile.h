@@ -21,7 +21,7 @@ namespace gameplay
  * Increment the version number when making a change that break binary compatibility.
  * [0] is major, [1] is minor.
  */
-const unsigned char GPB_VERSION[2] = {1, 2};
+const unsigned char GPB_VERSION[2] = {1, 5};
 
 /**
  * The GamePlay Binary file class handles writing the GamePlay Binary file.
@@ -54,6 +54,17 @@ public:
      */
     bool saveBinary(const std::string& filepath);
 
+    /**
+     * Moves the root nodes of the scenes that only hold static models into cells of the size given by
+     * the encoder arguments, writes the nodes of each cell and their meshes to a GPB file next to the
+     * given file, and writes an index of the cells to a .cells file. The nodes are removed from this file.
+     *
+     * @param filepath The file name and path that the main file is saved to.
+     * 
+     * @return True if successful, false if error.
+     */
+    bool saveCells(const std::string& filepath);
+
     /**
      * Saves the GPBFile as a text file at filepath. Useful for debugging.
      *
@@ -120,6 +131,82 @@ private:
      * Computes the bounds of all meshes in the node hierarchy.
      */
     void computeBounds(Node* node);
+
+    /**
+     * Reorders the triangles and vertices of the static meshes for the vertex cache and
+     * overdraw, and reports the vertex cache statistics before and after.
+     */
+    void optimizeMeshes();
+
+    /**
+     * Adds simplified levels of detail to the meshes whose parts are all triangle lists,
+     * and reports the triangle count and error of each level.
+     */
+    void generateLods();
+
+    /**
+     * Splits the parts of skinned meshes so that each part uses at most the joint count of the
+     * encoder arguments, and reports the parts and joints of each split mesh.
+     */
+    void splitSkins();
+
+    /**
+     * Stores the vertex elements of all meshes in the smallest data types that are within
+     * the error tolerances of the encoder arguments, and reports the vertex data saved.
+     */
+    void quantizeMeshes();
+
+    /**
+     * Merges the linear animation channels that translate or scale the same node along different
+     * axes, such as the separate X, Y and Z channels that Blender writes, into one channel each.
+     * Only channels with the same first and last key times are merged, since the runtime plays
+     * each channel over its own duration.
+     */
+    void mergeAnimationChannels();
+
+    /**
+     * Removes the animation key frames that can be interpolated within the tolerances of the
+     * encoder arguments, and reports the key frame count of each animation before and after.
+     */
+    void reduceAnimationKeys();
+
+    /**
+     * Removes the ambient lights from the nodes and the reference table. They are only used to
+     * calculate the ambient color of the scenes and are not written to the file.
+     */
+    void removeAmbientLights();
+
+    /**
+     * Removes the nodes that have no children, camera, light or model, and the nodes that only
+     * transform their children, whose transforms are applied to their children instead. Nodes that
+     * are animated, joints, or named by the encoder arguments are kept, and so are their parents.
+     */
+    void flattenNodes();
+
+    /**
+     * Adds the ids of the nodes that animations, skins and the encoder arguments refer to.
+     */
+    void getReferencedNodeIds(std::set<std::string>& ids) const;
+
+    /**
+     * Flattens the children of the node.
+     *
+     * @param node The node whose children to flatten.
+     * @param keep The ids of the nodes to keep.
+     * @param removed The removed nodes are added to this set.
+     */
+    void flattenChildren(Node* node, const std::set<std::string>& keep, std::set<Node*>& removed);
+
+    /**
+     * Flattens the node and its descendants.
+     *
+     * @param node The node to flatten.
+     * @param keep The ids of the nodes to keep.
+     * @param removed The removed nodes are added to this set.
+     * @param nodes Returns the nodes that replace the node in its parent: the node itself if it is kept,
+     *      its children if its transform was applied to them, or no nodes if it was removed.
+     */
+    void flattenNode(Node* node, const std::set<std::string>& keep, std::set<Node*>& removed, std::vector<Node*>& nodes);
     void optimizeTransformAnimations();
 
     /**
@@ -138,6 +225,18 @@ private:
      */
     void moveAnimationChannels(Node* node, Animation* animation);
 
+    /**
+     * Writes the reference table, meshes and objects to a binary file.
+     *
+     * @param filepath The file name and path to save to.
+     * @param refTable The references of the file.
+     * @param geometry The meshes to write.
+     * @param objects The objects to write.
+     * 
+     * @return True if successful, false if error.
+     */
+    static bool saveBinary(const std::string& filepath, ReferenceTable& refTable, const std::list<Mesh*>& geometry, const std::list<Object*>& objects);
+
 private:
 
     FILE* _file;
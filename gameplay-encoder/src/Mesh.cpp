@@ -1,6 +1,8 @@
 #include "Base.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "EncoderArguments.h"
+#include "Thread.h"
 
 namespace gameplay
 {
@@ -36,157 +38,184 @@ void Mesh::writeBinary(FILE* file)
     writeBinaryVertices(file);
     // parts
     writeBinaryObjects(parts, file);
+    // levels of detail
+    write((unsigned int)lods.size(), file);
+    for (std::vector<MeshLod>::iterator i = lods.begin(); i != lods.end(); ++i)
+    {
+        write(i->error, file);
+        writeBinaryObjects(i->parts, file);
+    }
 }
 
-/////////////////////////////////////////////////////////////
-// 
-// Fast, Minimum Storage Ray-Triangle Intersection
-// 
-// Authors: Tomas Mller, Ben Trumbore
-// http://jgt.akpeters.com/papers/MollerTrumbore97
-//
-// Implementation of algorithm from Real-Time Rendering (vol 1), pg. 305.
-//
-// Adapted slightly for use here.
-// 
-#define EPSILON 0.000001
-#define CROSS(dest,v1,v2) \
-          dest[0]=v1[1]*v2[2]-v1[2]*v2[1]; \
-          dest[1]=v1[2]*v2[0]-v1[0]*v2[2]; \
-          dest[2]=v1[0]*v2[1]-v1[1]*v2[0];
-#define DOT(v1,v2) (v1[0]*v2[0]+v1[1]*v2[1]+v1[2]*v2[2])
-#define SUB(dest,v1,v2) \
-          dest[0]=v1[0]-v2[0]; \
-          dest[1]=v1[1]-v2[1]; \
-          dest[2]=v1[2]-v2[2]; 
-
-int
-intersect_triangle(const float orig[3], const float dir[3],
-                   const float vert0[3], const float vert1[3], const float vert2[3],
-                   float *t, float *u, float *v)
+/**
+ * A uniform grid over the X and Z axes of the triangles of a mesh, which finds the triangles
+ * below a point without testing all of them. Each cell lists the triangles whose X and Z
+ * bounds overlap it.
+ */
+struct HeightmapGrid
 {
-   float edge1[3], edge2[3], tvec[3], pvec[3], qvec[3];
-   float det,inv_det;
-
-   /* find vectors for two edges sharing vert0 */
-   SUB(edge1, vert1, vert0);
-   SUB(edge2, vert2, vert0);
-
-   /* begin calculating determinant - also used to calculate U parameter */
-   CROSS(pvec, dir, edge2);
-
-   /* if determinant is near zero, ray lies in plane of triangle */
-   det = DOT(edge1, pvec);
-
-   if (det > -EPSILON && det < EPSILON)
-     return 0;
-   inv_det = 1.0f / det;
-
-   /* calculate distance from vert0 to ray origin */
-   SUB(tvec, orig, vert0);
-
-   /* calculate U parameter and test bounds */
-   *u = DOT(tvec, pvec) * inv_det;
-   if (*u < 0.0 || *u > 1.0)
-     return 0;
-
-   /* prepare to test V parameter */
-   CROSS(qvec, tvec, edge1);
-
-   /* calculate V parameter and test bounds */
-   *v = DOT(dir, qvec) * inv_det;
-   if (*v < 0.0 || *u + *v > 1.0)
-     return 0;
-
-   /* calculate t, ray intersects triangle */
-   *t = DOT(edge2, qvec) * inv_det;
-
-   return 1;
+    const std::vector<Vertex>* vertices;
+    std::vector<unsigned int> triangles;
+    std::vector<unsigned int> cellStarts;
+    std::vector<unsigned int> cellTriangles;
+    float minX;
+    float minZ;
+    float cellSize;
+    int width;
+    int height;
+};
+
+/**
+ * The samples of a heightmap that are traced by Thread::parallelFor, one row per index.
+ */
+struct HeightmapSamples
+{
+    const HeightmapGrid* grid;
+    float x;
+    float z;
+    float spacing;
+    int width;
+    std::vector<float> heights;
+    std::vector<unsigned char> hits;
+};
+
+static int getGridCell(float value, float min, float cellSize, int count)
+{
+    return std::max(0, std::min(count - 1, (int)floor((value - min) / cellSize)));
 }
 
-// Performs an intersection test between a ray and the given mesh part
-// and stores the result in "point".
-bool intersect(const Vector3& rayOrigin, const Vector3& rayDirection, const std::vector<Vertex>& vertices, const std::vector<MeshPart*>& parts, Vector3* point)
+static void buildHeightmapGrid(const Mesh* mesh, HeightmapGrid* grid)
 {
-    const float* orig = &rayOrigin.x;
-    const float* dir = &rayDirection.x;
-
-    for (unsigned int i = 0, partCount = parts.size(); i < partCount; ++i)
+    grid->vertices = &mesh->vertices;
+    for (std::vector<MeshPart*>::const_iterator i = mesh->parts.begin(); i != mesh->parts.end(); ++i)
     {
-        MeshPart* part = parts[i];
-
-        for (unsigned int j = 0, indexCount = part->getIndicesCount(); j < indexCount; j += 3)
+        const MeshPart* part = *i;
+        if (part->getPrimitiveType() != MeshPart::TRIANGLES)
         {
-            const float* v0 = &vertices[part->getIndex( j )].position.x;
-            const float* v1 = &vertices[part->getIndex(j+1)].position.x;
-            const float* v2 = &vertices[part->getIndex(j+2)].position.x;
-
-            float t, u, v;
-            if (intersect_triangle(orig, dir, v0, v1, v2, &t, &u, &v))
+            continue;
+        }
+        for (unsigned int j = 0, indexCount = part->getIndicesCount() / 3 * 3; j < indexCount; ++j)
+        {
+            grid->triangles.push_back(part->getIndex(j));
+        }
+    }
+    const unsigned int triangleCount = (unsigned int)grid->triangles.size() / 3;
+
+    // Size the cells to hold about two triangles each.
+    const float sizeX = std::max(mesh->bounds.max.x - mesh->bounds.min.x, FLT_EPSILON);
+    const float sizeZ = std::max(mesh->bounds.max.z - mesh->bounds.min.z, FLT_EPSILON);
+    grid->minX = mesh->bounds.min.x;
+    grid->minZ = mesh->bounds.min.z;
+    grid->cellSize = sqrt(sizeX * sizeZ * 2.0f / std::max(triangleCount, 1u));
+    grid->width = std::max(1, std::min(4096, (int)ceil(sizeX / grid->cellSize)));
+    grid->height = std::max(1, std::min(4096, (int)ceil(sizeZ / grid->cellSize)));
+    grid->cellSize = std::max(sizeX / grid->width, sizeZ / grid->height);
+
+    // Count the triangles of each cell, then store the triangles of all cells in one array.
+    const std::vector<Vertex>& vertices = mesh->vertices;
+    std::vector<int> ranges(triangleCount * 4);
+    grid->cellStarts.assign(grid->width * grid->height + 1, 0);
+    for (unsigned int i = 0; i < triangleCount; ++i)
+    {
+        const Vector3& a = vertices[grid->triangles[i * 3]].position;
+        const Vector3& b = vertices[grid->triangles[i * 3 + 1]].position;
+        const Vector3& c = vertices[grid->triangles[i * 3 + 2]].position;
+        int* range = &ranges[i * 4];
+        range[0] = getGridCell(std::min(a.x, std::min(b.x, c.x)), grid->minX, grid->cellSize, grid->width);
+        range[1] = getGridCell(std::max(a.x, std::max(b.x, c.x)), grid->minX, grid->cellSize, grid->width);
+        range[2] = getGridCell(std::min(a.z, std::min(b.z, c.z)), grid->minZ, grid->cellSize, grid->height);
+        range[3] = getGridCell(std::max(a.z, std::max(b.z, c.z)), grid->minZ, grid->cellSize, grid->height);
+        for (int z = range[2]; z <= range[3]; ++z)
+        {
+            for (int x = range[0]; x <= range[1]; ++x)
             {
-                // Found an intersection!
-                if (point)
-                {
-                    Vector3 rd(rayDirection);
-                    rd.scale(t);
-                    Vector3::add(rayOrigin, rd, point);
-                }
-                return true;
+                ++grid->cellStarts[z * grid->width + x + 1];
+            }
+        }
+    }
+    for (size_t i = 1; i < grid->cellStarts.size(); ++i)
+    {
+        grid->cellStarts[i] += grid->cellStarts[i - 1];
+    }
+    grid->cellTriangles.resize(grid->cellStarts.back());
+    std::vector<unsigned int> offsets(grid->cellStarts.begin(), grid->cellStarts.end() - 1);
+    for (unsigned int i = 0; i < triangleCount; ++i)
+    {
+        const int* range = &ranges[i * 4];
+        for (int z = range[2]; z <= range[3]; ++z)
+        {
+            for (int x = range[0]; x <= range[1]; ++x)
+            {
+                grid->cellTriangles[offsets[z * grid->width + x]++] = i;
             }
         }
     }
-
-    return false;
 }
 
-void Mesh::generateHeightmap(const char* filename, bool highP)
+/**
+ * Finds the height of the highest triangle at the given X and Z position.
+ *
+ * @return True if a triangle covers the position.
+ */
+static bool getGridHeight(const HeightmapGrid* grid, float x, float z, float* height)
 {
-    // Shoot rays down from a point just above the max Y position of the mesh.
-    // Compute ray-triangle intersection tests against the ray and this mesh to 
-    // generate heightmap data.
-    Vector3 rayOrigin(0, bounds.max.y + 10, 0);
-    Vector3 rayDirection(0, -1, 0);
-    Vector3 intersectionPoint;
-    int minX = (int)ceil(bounds.min.x);
-    int maxX = (int)floor(bounds.max.x);
-    int minZ = (int)ceil(bounds.min.z);
-    int maxZ = (int)floor(bounds.max.z);
-    int width = maxX - minX + 1;
-    int height = maxZ - minZ + 1;
-    float* heights = new float[width * height];
-    int index = 0;
-    float minHeight = FLT_MAX;
-    float maxHeight = -FLT_MAX;
-    for (int z = minZ; z <= maxZ; z++)
+    const std::vector<Vertex>& vertices = *grid->vertices;
+    const int cell = getGridCell(z, grid->minZ, grid->cellSize, grid->height) * grid->width + getGridCell(x, grid->minX, grid->cellSize, grid->width);
+    bool hit = false;
+    for (unsigned int i = grid->cellStarts[cell], end = grid->cellStarts[cell + 1]; i < end; ++i)
     {
-        rayOrigin.z = (float)z;
-        for (int x = minX; x <= maxX; x++)
+        const unsigned int triangle = grid->cellTriangles[i];
+        const Vector3& a = vertices[grid->triangles[triangle * 3]].position;
+        const Vector3& b = vertices[grid->triangles[triangle * 3 + 1]].position;
+        const Vector3& c = vertices[grid->triangles[triangle * 3 + 2]].position;
+
+        // Barycentric coordinates of the position in the triangle projected onto the XZ plane,
+        // with a small tolerance so that samples on shared edges are not missed.
+        const float abx = b.x - a.x, abz = b.z - a.z;
+        const float acx = c.x - a.x, acz = c.z - a.z;
+        const float det = abx * acz - acx * abz;
+        if (fabs(det) <= FLT_EPSILON * (fabs(abx * acz) + fabs(acx * abz)))
         {
-            float h;
-            rayOrigin.x = (float)x;
-            if (intersect(rayOrigin, rayDirection, vertices, parts, &intersectionPoint))
-            {
-                h = intersectionPoint.y;
-            }
-            else
-            {
-                h = 0;
-                fprintf(stderr, "Warning: Heightmap triangle intersection failed for (%d, %d).\n", x, z);
-            }
-            if (h < minHeight)
-                minHeight = h;
-            if (h > maxHeight)
-                maxHeight = h;
-            heights[index++] = h;
+            // The triangle is vertical.
+            continue;
         }
+        const float px = x - a.x, pz = z - a.z;
+        const float u = (px * acz - acx * pz) / det;
+        const float v = (abx * pz - px * abz) / det;
+        const float tolerance = 0.00001f;
+        if (u < -tolerance || v < -tolerance || u + v > 1.0f + tolerance)
+        {
+            continue;
+        }
+        const float y = a.y + u * (b.y - a.y) + v * (c.y - a.y);
+        if (!hit || y > *height)
+        {
+            *height = y;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+static void traceHeightmapRow(unsigned int row, void* arg)
+{
+    HeightmapSamples* samples = (HeightmapSamples*)arg;
+    const float z = samples->z + row * samples->spacing;
+    for (int i = 0, index = row * samples->width; i < samples->width; ++i, ++index)
+    {
+        samples->hits[index] = getGridHeight(samples->grid, samples->x + i * samples->spacing, z, &samples->heights[index]) ? 1 : 0;
     }
-    
-    // Normalize the max height value
-    maxHeight = maxHeight - minHeight;
+}
 
+/**
+ * Writes the normalized heights to a PNG file in the 8-bit, 16-bit or 24-bit heightmap format.
+ */
+static void writeHeightmapPNG(const char* filename, unsigned int format, const std::vector<float>& heights, int width, int height, float minHeight, float maxHeight)
+{
     png_structp png_ptr = NULL;
     png_infop info_ptr = NULL;
     png_bytep row = NULL;
+    const float range = maxHeight > minHeight ? maxHeight - minHeight : 1.0f;
 
     FILE* fp = fopen(filename, "wb");
     if (fp == NULL)
@@ -211,7 +240,14 @@ void Mesh::generateHeightmap(const char* filename, bool highP)
 
     png_init_io(png_ptr, fp);
 
-    png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+    if (format == EncoderArguments::HEIGHTMAP_16BIT)
+    {
+        png_set_IHDR(png_ptr, info_ptr, width, height, 16, PNG_COLOR_TYPE_GRAY, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+    }
+    else
+    {
+        png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+    }
 
     png_write_info(png_ptr, info_ptr);
 
@@ -222,13 +258,20 @@ void Mesh::generateHeightmap(const char* filename, bool highP)
     {
         for (int x = 0; x < width; x++)
         {
-            // Write height value normalized between 0-255 (between min and max height)
+            // Write height value normalized between min and max height
             float h = heights[y*width + x];
-            float nh = (h - minHeight) / maxHeight;
-            int pos = x*3;
-            if (highP)
+            float nh = (h - minHeight) / range;
+            if (format == EncoderArguments::HEIGHTMAP_16BIT)
+            {
+                // 16-bit grayscale, stored most significant byte first
+                int bits = (int)(nh * 65535.0f + 0.5f);
+                row[x*2] = (png_byte)(bits >> 8);
+                row[x*2+1] = (png_byte)(bits & 0xff);
+            }
+            else if (format == EncoderArguments::HEIGHTMAP_24BIT)
             {
                 // high precision packed 24-bit (RGB)
+                int pos = x*3;
                 int bits = (int)(nh * 16777215.0f); // 2^24-1
 
                 row[pos+2] = (png_byte)(bits & 0xff);
@@ -240,6 +283,7 @@ void Mesh::generateHeightmap(const char* filename, bool highP)
             else
             {
                 // standard precision 8-bit (grayscale)
+                int pos = x*3;
                 png_byte b = (png_byte)(nh * 255.0f);
                 row[pos] = row[pos+1] = row[pos+2] = b;
             }
@@ -251,8 +295,6 @@ void Mesh::generateHeightmap(const char* filename, bool highP)
     DEBUGPRINT_VARG("> Saved heightmap: %s\n", filename);
 
 error:
-    if (heights)
-        delete[] heights;
     if (fp)
         fclose(fp);
     if (row)
@@ -261,23 +303,309 @@ error:
         png_free_data(png_ptr, info_ptr, PNG_FREE_ALL, -1);
     if (png_ptr)
         png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+}
+
+/**
+ * Writes the heights to a raw file of 32-bit floats, one row after another.
+ */
+static void writeHeightmapRAW(const char* filename, const std::vector<float>& heights)
+{
+    FILE* fp = fopen(filename, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Error: Failed to open file for writing: %s\n", filename);
+        return;
+    }
+    if (fwrite(&heights[0], sizeof(float), heights.size(), fp) != heights.size())
+    {
+        fprintf(stderr, "Error: Failed to write file: %s\n", filename);
+    }
+    fclose(fp);
+    DEBUGPRINT_VARG("> Saved heightmap: %s\n", filename);
+}
+
+void Mesh::generateHeightmap(const char* filename, unsigned int format, float spacing, unsigned int resolution)
+{
+    // Place the samples at multiples of the spacing inside of the bounds, or spread the
+    // requested number of samples over the longest side of the bounds.
+    float startX = 0.0f;
+    float startZ = 0.0f;
+    int width = 0;
+    int height = 0;
+    if (resolution > 1)
+    {
+        spacing = std::max(bounds.max.x - bounds.min.x, bounds.max.z - bounds.min.z) / (resolution - 1);
+        startX = bounds.min.x;
+        startZ = bounds.min.z;
+    }
+    if (spacing <= 0.0f)
+    {
+        fprintf(stderr, "Error: Invalid heightmap spacing %g for: %s\n", spacing, filename);
+        return;
+    }
+    if (resolution > 1)
+    {
+        width = (int)floor((bounds.max.x - startX) / spacing + 0.5f) + 1;
+        height = (int)floor((bounds.max.z - startZ) / spacing + 0.5f) + 1;
+    }
+    else
+    {
+        startX = ceil(bounds.min.x / spacing) * spacing;
+        startZ = ceil(bounds.min.z / spacing) * spacing;
+        width = (int)floor((bounds.max.x - startX) / spacing) + 1;
+        height = (int)floor((bounds.max.z - startZ) / spacing) + 1;
+    }
+    if (width <= 0 || height <= 0)
+    {
+        fprintf(stderr, "Error: Heightmap has no samples: %s\n", filename);
+        return;
+    }
+
+    HeightmapGrid grid;
+    buildHeightmapGrid(this, &grid);
+
+    // Each row of samples is traced on its own thread.
+    HeightmapSamples samples;
+    samples.grid = &grid;
+    samples.x = startX;
+    samples.z = startZ;
+    samples.spacing = spacing;
+    samples.width = width;
+    samples.heights.resize(width * height);
+    samples.hits.resize(width * height);
+    Thread::parallelFor((unsigned int)height, &traceHeightmapRow, &samples);
+
+    float minHeight = FLT_MAX;
+    float maxHeight = -FLT_MAX;
+    unsigned int missCount = 0;
+    for (size_t i = 0; i < samples.heights.size(); ++i)
+    {
+        if (samples.hits[i])
+        {
+            minHeight = std::min(minHeight, samples.heights[i]);
+            maxHeight = std::max(maxHeight, samples.heights[i]);
+        }
+        else
+        {
+            ++missCount;
+        }
+    }
+    if (missCount == samples.heights.size())
+    {
+        minHeight = maxHeight = 0.0f;
+    }
+    if (missCount > 0)
+    {
+        // Samples outside of the mesh use the lowest height.
+        fprintf(stderr, "Warning: No triangles found below %u of %u heightmap samples: %s\n", missCount, (unsigned int)samples.heights.size(), filename);
+        for (size_t i = 0; i < samples.heights.size(); ++i)
+        {
+            if (!samples.hits[i])
+            {
+                samples.heights[i] = minHeight;
+            }
+        }
+    }
 
+    if (format == EncoderArguments::HEIGHTMAP_FLOAT)
+    {
+        writeHeightmapRAW(filename, samples.heights);
+    }
+    else
+    {
+        writeHeightmapPNG(filename, format, samples.heights, width, height, minHeight, maxHeight);
+    }
+    fprintf(stderr, "Heightmap %s: %d x %d samples, %g apart, heights %g to %g\n", filename, width, height, spacing, minHeight, maxHeight);
+}
+
+/**
+ * Gets the 4 components of the vertex element with the given usage, padded with w = 1 for
+ * positions and zeros otherwise.
+ */
+static void getVertexValues(const Vertex& vertex, unsigned int usage, float* values)
+{
+    values[0] = values[1] = values[2] = values[3] = 0.0f;
+    switch (usage)
+    {
+        case POSITION:
+            memcpy(values, &vertex.position.x, 3 * sizeof(float));
+            values[3] = 1.0f;
+            break;
+        case NORMAL:
+            memcpy(values, &vertex.normal.x, 3 * sizeof(float));
+            break;
+        case TANGENT:
+            memcpy(values, &vertex.tangent.x, 3 * sizeof(float));
+            break;
+        case BINORMAL:
+            memcpy(values, &vertex.binormal.x, 3 * sizeof(float));
+            break;
+        case COLOR:
+            memcpy(values, &vertex.diffuse.x, 4 * sizeof(float));
+            break;
+        case BLENDWEIGHTS:
+            memcpy(values, &vertex.blendWeights.x, 4 * sizeof(float));
+            break;
+        case BLENDINDICES:
+            memcpy(values, &vertex.blendIndices.x, 4 * sizeof(float));
+            break;
+        default:
+            if (usage >= TEXCOORD0 && usage <= TEXCOORD7)
+            {
+                memcpy(values, &vertex.texCoord.x, 2 * sizeof(float));
+            }
+            break;
+    }
+}
+
+/**
+ * Packs the vertex element with the given format, keeping the sum of 8-bit blend weights exact.
+ */
+static void packVertexValues(const VertexElement& element, const float* values, unsigned char* data)
+{
+    element.pack(values, data);
+    if (element.usage == BLENDWEIGHTS && element.type == TYPE_UNORM8)
+    {
+        // Rounding each weight separately can change their sum, which scales the skinned
+        // vertex, so the difference is added to the largest weight.
+        float sum = 0.0f;
+        int packedSum = 0;
+        unsigned int largest = 0;
+        for (unsigned int i = 0; i < element.size; ++i)
+        {
+            sum += values[i];
+            packedSum += data[i];
+            if (data[i] > data[largest])
+            {
+                largest = i;
+            }
+        }
+        int difference = (int)floor(sum * 255.0f + 0.5f) - packedSum;
+        data[largest] = (unsigned char)std::max(0, std::min(255, (int)data[largest] + difference));
+    }
+}
+
+/**
+ * Returns the largest component error of packing the given vertex element for all vertices.
+ */
+static float computeVertexError(const std::vector<Vertex>& vertices, const VertexElement& element)
+{
+    float maxError = 0.0f;
+    float values[4];
+    float unpacked[4];
+    unsigned char data[16];
+    for (std::vector<Vertex>::const_iterator i = vertices.begin(); i != vertices.end(); ++i)
+    {
+        getVertexValues(*i, element.usage, values);
+        packVertexValues(element, values, data);
+        element.unpack(data, unpacked);
+        for (unsigned int j = 0; j < element.size; ++j)
+        {
+            maxError = std::max(maxError, (float)fabs(unpacked[j] - values[j]));
+        }
+    }
+    return maxError;
+}
+
+void Mesh::quantizeVertexFormat(float positionError, float texCoordError, float normalError)
+{
+    if (vertices.empty())
+    {
+        return;
+    }
+
+    // The position error is relative to the size of the mesh, which is measured
+    // from the vertices because skinned meshes are bounded by their skin.
+    Vector3 min = vertices[0].position;
+    Vector3 max = vertices[0].position;
+    for (std::vector<Vertex>::const_iterator i = vertices.begin(); i != vertices.end(); ++i)
+    {
+        min.x = std::min(min.x, i->position.x);
+        min.y = std::min(min.y, i->position.y);
+        min.z = std::min(min.z, i->position.z);
+        max.x = std::max(max.x, i->position.x);
+        max.y = std::max(max.y, i->position.y);
+        max.z = std::max(max.z, i->position.z);
+    }
+    float extent = std::max(max.x - min.x, std::max(max.y - min.y, max.z - min.z));
+
+    for (std::vector<VertexElement>::iterator i = _vertexFormat.begin(); i != _vertexFormat.end(); ++i)
+    {
+        // The candidate formats from smallest to largest, with the error that each may have.
+        std::vector<VertexElement> candidates;
+        float tolerance = 0.0f;
+        switch (i->usage)
+        {
+            case POSITION:
+                // Half floats are padded to 4 components to keep each element 4 byte aligned.
+                candidates.push_back(VertexElement(POSITION, 4, TYPE_HALF_FLOAT));
+                tolerance = positionError * extent;
+                break;
+            case NORMAL:
+            case TANGENT:
+            case BINORMAL:
+                candidates.push_back(VertexElement(i->usage, 4, TYPE_SNORM8));
+                candidates.push_back(VertexElement(i->usage, 4, TYPE_SNORM10_10_10_2));
+                tolerance = normalError;
+                break;
+            case COLOR:
+                candidates.push_back(VertexElement(COLOR, 4, TYPE_UNORM8));
+                tolerance = 0.5f / 255.0f + MATH_EPSILON;
+                break;
+            case BLENDWEIGHTS:
+                // The sum correction moves the largest weight by up to one more step.
+                candidates.push_back(VertexElement(BLENDWEIGHTS, 4, TYPE_UNORM8));
+                tolerance = 2.5f / 255.0f + MATH_EPSILON;
+                break;
+            case BLENDINDICES:
+                candidates.push_back(VertexElement(BLENDINDICES, 4, TYPE_UINT8));
+                break;
+            default:
+                if (i->usage >= TEXCOORD0 && i->usage <= TEXCOORD7)
+                {
+                    candidates.push_back(VertexElement(i->usage, i->size, TYPE_HALF_FLOAT));
+                    tolerance = texCoordError;
+                }
+                break;
+        }
+
+        for (std::vector<VertexElement>::const_iterator j = candidates.begin(); j != candidates.end(); ++j)
+        {
+            if (j->byteSize() < i->byteSize() && computeVertexError(vertices, *j) <= tolerance)
+            {
+                *i = *j;
+                break;
+            }
+        }
+    }
 }
 
 void Mesh::writeBinaryVertices(FILE* file)
 {
     if (vertices.size() > 0)
     {
-        // Assumes that all vertices are the same size.
         // Write the number of bytes for the vertex data
-        const Vertex& vertex = vertices.front();
-        write(vertices.size() * vertex.byteSize(), file); // (vertex count) * (vertex size)
+        unsigned int vertexSize = 0;
+        for (std::vector<VertexElement>::const_iterator i = _vertexFormat.begin(); i != _vertexFormat.end(); ++i)
+        {
+            vertexSize += i->byteSize();
+        }
+        write(vertices.size() * vertexSize, file); // (vertex count) * (vertex size)
 
         // for each vertex
+        std::vector<unsigned char> data(vertexSize);
+        float values[4];
         for (std::vector<Vertex>::const_iterator i = vertices.begin(); i != vertices.end(); ++i)
         {
-            // Write this vertex
-            i->writeBinary(file);
+            // Pack each element of this vertex in its format and write the vertex
+            unsigned int offset = 0;
+            for (std::vector<VertexElement>::const_iterator j = _vertexFormat.begin(); j != _vertexFormat.end(); ++j)
+            {
+                getVertexValues(*i, j->usage, values);
+                packVertexValues(*j, values, &data[offset]);
+                offset += j->byteSize();
+            }
+            fwrite(&data[0], 1, vertexSize, file);
         }
     }
     else
@@ -334,6 +662,17 @@ void Mesh::writeText(FILE* file)
         (*i)->writeText(file);
     }
 
+    // for each level of detail
+    for (std::vector<MeshLod>::iterator i = lods.begin(); i != lods.end(); ++i)
+    {
+        fprintf(file, "<lod error=\"%f\">\n", i->error);
+        for (std::vector<MeshPart*>::iterator j = i->parts.begin(); j != i->parts.end(); ++j)
+        {
+            (*j)->writeText(file);
+        }
+        fprintf(file, "</lod>\n");
+    }
+
     fprintElementEnd(file);
 }
 
@@ -347,6 +686,15 @@ void Mesh::addMeshPart(Vertex* vertex)
     vertices.push_back(*vertex);
 }
 
+void Mesh::addLod(float error, const std::vector<MeshPart*>& lodParts)
+{
+    assert(lodParts.size() == parts.size());
+    MeshLod lod;
+    lod.error = error;
+    lod.parts = lodParts;
+    lods.push_back(lod);
+}
+
 void Mesh::addVetexAttribute(unsigned int usage, unsigned int count)
 {
     _vertexFormat.push_back(VertexElement(usage, count));
@@ -374,22 +722,131 @@ const VertexElement& Mesh::getVertexElement(unsigned int index) const
 
 bool Mesh::contains(const Vertex& vertex) const
 {
-    return vertexLookupTable.count(vertex) > 0;
+    if (_vertexTable.empty())
+    {
+        return false;
+    }
+    return _vertexTable[findVertexSlot(vertex, vertex.hash())] != 0;
 }
 
 unsigned int Mesh::addVertex(const Vertex& vertex)
 {
     unsigned int index = getVertexCount();
+    unsigned int hash = vertex.hash();
     vertices.push_back(vertex);
-    vertexLookupTable[vertex] = index;
+    _vertexHashes.push_back(hash);
+
+    // Keep the table at most half full so that probe sequences stay short.
+    if (_vertexHashes.size() * 2 > _vertexTable.size())
+    {
+        rehashVertices(std::max((unsigned int)_vertexTable.size() * 2, 64u));
+    }
+    else
+    {
+        _vertexTable[findVertexSlot(vertex, hash)] = index + 1;
+    }
     return index;
 }
 
 unsigned int Mesh::getVertexIndex(const Vertex& vertex)
 {
-    std::map<Vertex,unsigned int>::iterator it;
-    it = vertexLookupTable.find(vertex);
-    return it->second;
+    assert(contains(vertex));
+    return _vertexTable[findVertexSlot(vertex, vertex.hash())] - 1;
+}
+
+unsigned int Mesh::addUniqueVertex(const Vertex& vertex)
+{
+    unsigned int hash = vertex.hash();
+    if (!_vertexTable.empty())
+    {
+        unsigned int slot = findVertexSlot(vertex, hash);
+        if (_vertexTable[slot] != 0)
+        {
+            return _vertexTable[slot] - 1;
+        }
+    }
+    return addVertex(vertex);
+}
+
+void Mesh::remapVertices(const std::vector<unsigned int>& newIndices)
+{
+    assert(newIndices.size() == vertices.size());
+
+    std::vector<Vertex> newVertices(vertices.size());
+    for (unsigned int i = 0, count = vertices.size(); i < count; ++i)
+    {
+        newVertices[newIndices[i]] = vertices[i];
+    }
+    vertices.swap(newVertices);
+
+    std::vector<MeshPart*> allParts(parts);
+    for (std::vector<MeshLod>::const_iterator i = lods.begin(); i != lods.end(); ++i)
+    {
+        allParts.insert(allParts.end(), i->parts.begin(), i->parts.end());
+    }
+    for (std::vector<MeshPart*>::iterator i = allParts.begin(); i != allParts.end(); ++i)
+    {
+        std::vector<unsigned int> indices = (*i)->getIndices();
+        for (std::vector<unsigned int>::iterator j = indices.begin(); j != indices.end(); ++j)
+        {
+            *j = newIndices[*j];
+        }
+        (*i)->setIndices(indices);
+    }
+
+    // The lookup table holds vertex indices, so it is rebuilt for the new order.
+    rebuildVertexTable();
+}
+
+void Mesh::setVertices(const std::vector<Vertex>& newVertices)
+{
+    vertices = newVertices;
+    rebuildVertexTable();
+}
+
+void Mesh::rebuildVertexTable()
+{
+    _vertexHashes.resize(vertices.size());
+    for (unsigned int i = 0, count = vertices.size(); i < count; ++i)
+    {
+        _vertexHashes[i] = vertices[i].hash();
+    }
+    unsigned int slotCount = 64;
+    while (slotCount < _vertexHashes.size() * 2)
+    {
+        slotCount *= 2;
+    }
+    rehashVertices(slotCount);
+}
+
+unsigned int Mesh::findVertexSlot(const Vertex& vertex, unsigned int hash) const
+{
+    // Linear probing, comparing the full vertex only when the hashes match.
+    unsigned int mask = _vertexTable.size() - 1;
+    unsigned int slot = hash & mask;
+    for (;;)
+    {
+        unsigned int entry = _vertexTable[slot];
+        if (entry == 0 || (_vertexHashes[entry - 1] == hash && vertices[entry - 1] == vertex))
+        {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+void Mesh::rehashVertices(unsigned int slotCount)
+{
+    _vertexTable.assign(slotCount, 0);
+    for (unsigned int i = 0, count = _vertexHashes.size(); i < count; ++i)
+    {
+        // Vertices that are equal to an earlier one keep the earlier index.
+        unsigned int slot = findVertexSlot(vertices[i], _vertexHashes[i]);
+        if (_vertexTable[slot] == 0)
+        {
+            _vertexTable[slot] = i + 1;
+        }
+    }
 }
 
 void Mesh::computeBounds()
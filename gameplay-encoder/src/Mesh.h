@@ -12,6 +12,18 @@ namespace gameplay
 
 class Model;
 
+/**
+ * A simplified level of detail of a mesh, which has a triangle list for each part of the mesh.
+ */
+struct MeshLod
+{
+    /**
+     * The geometric error of the simplified mesh, in the units of the mesh positions.
+     */
+    float error;
+    std::vector<MeshPart*> parts;
+};
+
 class Mesh : public Object
 {
     friend class Model;
@@ -40,6 +52,14 @@ public:
 
     void addMeshPart(MeshPart* part);
     void addMeshPart(Vertex* vertex);
+
+    /**
+     * Adds a level of detail, which must be coarser than the levels already added.
+     *
+     * @param error The geometric error of the level of detail.
+     * @param lodParts The parts of the level of detail, one for each part of this mesh.
+     */
+    void addLod(float error, const std::vector<MeshPart*>& lodParts);
     void addVetexAttribute(unsigned int usage, unsigned int count);
 
     size_t getVertexCount() const;
@@ -61,23 +81,81 @@ public:
     unsigned int getVertexIndex(const Vertex& vertex);
 
     /**
-     * Generates a heightmap with the given filename for this mesh.
-     * Optional high precision uses packed 24-bit (RGB) instead of
-     * standard 8-bit grayscale.
+     * Returns the index of the vertex that is equal to the given one, adding the
+     * vertex first if there is none. This welds vertices with a single hash lookup.
+     */
+    unsigned int addUniqueVertex(const Vertex& vertex);
+
+    /**
+     * Moves each vertex to a new index and updates the indices of the parts and levels of detail to match.
+     *
+     * @param newIndices The new index of each vertex, which must be a permutation of the vertex indices.
+     */
+    void remapVertices(const std::vector<unsigned int>& newIndices);
+
+    /**
+     * Replaces the vertices of this mesh. The parts and levels of detail must index the new vertices.
+     */
+    void setVertices(const std::vector<Vertex>& newVertices);
+
+    /**
+     * Generates a heightmap with the given filename for this mesh from the highest triangle
+     * above each sample of a grid over the X and Z bounds of the mesh. The heights are
+     * normalized between the lowest and highest samples, except in the float format.
+     *
+     * @param filename The file to write the heightmap to.
+     * @param format The format of the heightmap, from the EncoderArguments::HeightmapFormat enum.
+     * @param spacing The distance between samples. Samples are placed at multiples of the spacing.
+     * @param resolution The number of samples along the longest side of the bounds, starting at
+     *      the minimum of the bounds, or 0 to use the spacing.
+     */
+    void generateHeightmap(const char* filename, unsigned int format, float spacing, unsigned int resolution);
+
+    /**
+     * Chooses the smallest data type for each vertex element whose round trip error is within
+     * the given tolerance, falling back to floats. Positions use half floats, normals, tangents and
+     * binormals use 8-bit or 10:10:10:2 signed normalized values, texture coordinates use half floats,
+     * colors and blend weights use 8-bit unsigned normalized values and blend indices use bytes.
+     *
+     * @param positionError The largest position error, relative to the largest dimension of the mesh.
+     * @param texCoordError The largest texture coordinate error.
+     * @param normalError The largest error of each normal, tangent and binormal component.
      */
-    void generateHeightmap(const char* filename, bool highP = false);
+    void quantizeVertexFormat(float positionError, float texCoordError, float normalError);
 
     void computeBounds();
 
     Model* model;
     std::vector<Vertex> vertices;
     std::vector<MeshPart*> parts;
+    std::vector<MeshLod> lods;
     BoundingVolume bounds;
-    std::map<Vertex, unsigned int> vertexLookupTable;
 
 private:
+
+    /**
+     * Returns the slot of the vertex lookup table that holds the given vertex,
+     * or the empty slot where it would be inserted.
+     */
+    unsigned int findVertexSlot(const Vertex& vertex, unsigned int hash) const;
+
+    /**
+     * Rebuilds the vertex lookup table with the given number of slots, which must be a power of two.
+     */
+    void rehashVertices(unsigned int slotCount);
+
+    /**
+     * Rebuilds the vertex lookup table for the current vertices.
+     */
+    void rebuildVertexTable();
+
     std::vector<VertexElement> _vertexFormat;
 
+    // Open addressed hash table of the vertices added with addVertex, holding
+    // the vertex index plus one in each used slot and zero in empty slots.
+    std::vector<unsigned int> _vertexTable;
+    std::vector<unsigned int> _vertexHashes;
+
 };
 
 }
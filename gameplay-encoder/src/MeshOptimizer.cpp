@@ -0,0 +1,422 @@
+#include "Base.h"
+#include "MeshOptimizer.h"
+
+// Marks a vertex that has no index yet.
+#define NO_VERTEX 0xffffffff
+
+namespace gameplay
+{
+
+/**
+ * Simulates a FIFO vertex cache drawing the triangle at the given index and returns the number of cache misses.
+ *
+ * A vertex is in the cache if it was last transformed less than CACHE_SIZE transforms ago.
+ * Adding CACHE_SIZE to the time empties the cache.
+ */
+static unsigned int drawTriangle(const std::vector<unsigned int>& indices, unsigned int triangle,
+                                 std::vector<unsigned int>& cacheTime, unsigned int& time)
+{
+    unsigned int misses = 0;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+        unsigned int vertex = indices[triangle * 3 + k];
+        if (time - cacheTime[vertex] > MeshOptimizer::CACHE_SIZE)
+        {
+            cacheTime[vertex] = time;
+            ++time;
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+/**
+ * A cluster of triangles with its key for sorting by overdraw.
+ */
+struct TriangleCluster
+{
+    unsigned int begin;
+    unsigned int end;
+    float key;
+};
+
+/**
+ * Sorts the clusters that face outwards the most first, keeping the cache order between equal keys.
+ */
+static bool compareClusters(const TriangleCluster& a, const TriangleCluster& b)
+{
+    return a.key > b.key;
+}
+
+MeshOptimizer::Statistics::Statistics(void) :
+    triangleCount(0),
+    vertexCount(0),
+    transformCount(0)
+{
+}
+
+float MeshOptimizer::Statistics::getACMR() const
+{
+    return triangleCount > 0 ? (float)transformCount / (float)triangleCount : 0.0f;
+}
+
+float MeshOptimizer::Statistics::getATVR() const
+{
+    return vertexCount > 0 ? (float)transformCount / (float)vertexCount : 0.0f;
+}
+
+void MeshOptimizer::optimize(Mesh* mesh, Statistics* before, Statistics* after)
+{
+    assert(mesh);
+    if (before)
+    {
+        computeStatistics(mesh, before);
+    }
+
+    unsigned int vertexCount = (unsigned int)mesh->getVertexCount();
+    for (std::vector<MeshPart*>::iterator i = mesh->parts.begin(); i != mesh->parts.end(); ++i)
+    {
+        MeshPart* part = *i;
+        if (part->getPrimitiveType() != MeshPart::TRIANGLES)
+        {
+            continue;
+        }
+        std::vector<unsigned int> indices = part->getIndices();
+        optimizeVertexCache(indices, vertexCount);
+        optimizeOverdraw(indices, mesh->vertices, 1.05f);
+        part->setIndices(indices);
+    }
+    optimizeVertexFetch(mesh);
+
+    if (after)
+    {
+        computeStatistics(mesh, after);
+    }
+}
+
+void MeshOptimizer::computeStatistics(const Mesh* mesh, Statistics* statistics)
+{
+    assert(mesh);
+    assert(statistics);
+
+    unsigned int vertexCount = (unsigned int)mesh->getVertexCount();
+    std::vector<unsigned int> cacheTime(vertexCount, 0);
+    std::vector<bool> used(vertexCount, false);
+    unsigned int time = CACHE_SIZE + 1;
+
+    *statistics = Statistics();
+    for (std::vector<MeshPart*>::const_iterator i = mesh->parts.begin(); i != mesh->parts.end(); ++i)
+    {
+        const MeshPart* part = *i;
+        if (part->getPrimitiveType() != MeshPart::TRIANGLES)
+        {
+            continue;
+        }
+        const std::vector<unsigned int>& indices = part->getIndices();
+        unsigned int triangleCount = (unsigned int)indices.size() / 3;
+
+        // Each part is a separate draw call, so it starts with an empty cache.
+        time += CACHE_SIZE + 1;
+        for (unsigned int t = 0; t < triangleCount; ++t)
+        {
+            statistics->transformCount += drawTriangle(indices, t, cacheTime, time);
+        }
+        for (unsigned int j = 0; j < triangleCount * 3; ++j)
+        {
+            if (!used[indices[j]])
+            {
+                used[indices[j]] = true;
+                ++statistics->vertexCount;
+            }
+        }
+        statistics->triangleCount += triangleCount;
+    }
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int vertexCount)
+{
+    unsigned int triangleCount = (unsigned int)indices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // The number of triangles that use each vertex and are not emitted yet.
+    std::vector<unsigned int> liveCount(vertexCount, 0);
+    for (unsigned int i = 0; i < triangleCount * 3; ++i)
+    {
+        assert(indices[i] < vertexCount);
+        ++liveCount[indices[i]];
+    }
+
+    // The triangles that use each vertex, stored from adjacencyBegin[v] to adjacencyBegin[v + 1].
+    std::vector<unsigned int> adjacencyBegin(vertexCount + 1, 0);
+    for (unsigned int v = 0; v < vertexCount; ++v)
+    {
+        adjacencyBegin[v + 1] = adjacencyBegin[v] + liveCount[v];
+    }
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    std::vector<unsigned int> adjacencyEnd(adjacencyBegin.begin(), adjacencyBegin.end() - 1);
+    for (unsigned int t = 0; t < triangleCount; ++t)
+    {
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+            adjacency[adjacencyEnd[indices[t * 3 + k]]++] = t;
+        }
+    }
+
+    std::vector<unsigned int> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<unsigned int> deadEnd;
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned int> result;
+    deadEnd.reserve(triangleCount * 3);
+    result.reserve(triangleCount * 3);
+
+    unsigned int time = CACHE_SIZE + 1;
+    unsigned int cursor = 0;
+    unsigned int fanVertex = 0;
+    while (fanVertex != NO_VERTEX)
+    {
+        // Emit all of the triangles around the fanning vertex that are not emitted yet.
+        candidates.clear();
+        for (unsigned int j = adjacencyBegin[fanVertex]; j < adjacencyBegin[fanVertex + 1]; ++j)
+        {
+            unsigned int t = adjacency[j];
+            if (emitted[t])
+            {
+                continue;
+            }
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+                unsigned int v = indices[t * 3 + k];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --liveCount[v];
+                if (time - cacheTime[v] > CACHE_SIZE)
+                {
+                    cacheTime[v] = time;
+                    ++time;
+                }
+            }
+            emitted[t] = true;
+        }
+
+        // Fan around the oldest candidate that will still be in the cache after all of its triangles are emitted.
+        unsigned int next = NO_VERTEX;
+        int bestPriority = -1;
+        for (std::vector<unsigned int>::const_iterator i = candidates.begin(); i != candidates.end(); ++i)
+        {
+            unsigned int v = *i;
+            if (liveCount[v] == 0)
+            {
+                continue;
+            }
+            int priority = 0;
+            if (time - cacheTime[v] + 2 * liveCount[v] <= CACHE_SIZE)
+            {
+                priority = (int)(time - cacheTime[v]);
+            }
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        if (next == NO_VERTEX)
+        {
+            // Dead end: go back to a recently used vertex with live triangles, or the next one in input order.
+            while (!deadEnd.empty() && next == NO_VERTEX)
+            {
+                unsigned int v = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveCount[v] > 0)
+                {
+                    next = v;
+                }
+            }
+            while (cursor < vertexCount && next == NO_VERTEX)
+            {
+                if (liveCount[cursor] > 0)
+                {
+                    next = cursor;
+                }
+                ++cursor;
+            }
+        }
+        fanVertex = next;
+    }
+
+    assert(result.size() == triangleCount * 3);
+    // Keep any trailing indices that do not make a whole triangle.
+    result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices, float threshold)
+{
+    unsigned int triangleCount = (unsigned int)indices.size() / 3;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+
+    std::vector<unsigned int> cacheTime(vertices.size(), 0);
+    unsigned int time = CACHE_SIZE + 1;
+
+    // Split at the triangles where the cache order jumped to a new place in the mesh, so that all
+    // of their vertices missed the cache. Reordering these clusters does not add any cache misses.
+    std::vector<unsigned int> hardBegin;
+    for (unsigned int t = 0; t < triangleCount; ++t)
+    {
+        if (drawTriangle(indices, t, cacheTime, time) == 3)
+        {
+            hardBegin.push_back(t);
+        }
+    }
+    if (hardBegin.empty() || hardBegin[0] != 0)
+    {
+        hardBegin.insert(hardBegin.begin(), 0);
+    }
+    hardBegin.push_back(triangleCount);
+
+    // Split the clusters further wherever the part before has an ACMR within the threshold of the
+    // whole cluster, so that smaller clusters can be sorted for a small cost in cache misses.
+    std::vector<TriangleCluster> clusters;
+    for (unsigned int c = 0; c + 1 < hardBegin.size(); ++c)
+    {
+        unsigned int begin = hardBegin[c];
+        unsigned int end = hardBegin[c + 1];
+
+        time += CACHE_SIZE + 1;
+        unsigned int misses = 0;
+        for (unsigned int t = begin; t < end; ++t)
+        {
+            misses += drawTriangle(indices, t, cacheTime, time);
+        }
+        float clusterThreshold = threshold * (float)misses / (float)(end - begin);
+
+        TriangleCluster cluster;
+        cluster.begin = begin;
+        cluster.key = 0.0f;
+        misses = 0;
+        time += CACHE_SIZE + 1;
+        for (unsigned int t = begin; t < end; ++t)
+        {
+            misses += drawTriangle(indices, t, cacheTime, time);
+            if (t + 1 == end || (float)misses / (float)(t + 1 - cluster.begin) <= clusterThreshold)
+            {
+                cluster.end = t + 1;
+                clusters.push_back(cluster);
+                cluster.begin = t + 1;
+                misses = 0;
+                time += CACHE_SIZE + 1;
+            }
+        }
+    }
+
+    // Sort the clusters by how far they face away from the center of the mesh, using their area weighted
+    // centroids and normals, because those are drawn in front of the others from most directions.
+    std::vector<float> clusterData(clusters.size() * 6, 0.0f);
+    float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+    float meshArea = 0.0f;
+    for (unsigned int c = 0; c < clusters.size(); ++c)
+    {
+        float* centroid = &clusterData[c * 6];
+        float* normal = &clusterData[c * 6 + 3];
+        float clusterArea = 0.0f;
+        for (unsigned int t = clusters[c].begin; t < clusters[c].end; ++t)
+        {
+            const Vector3& p0 = vertices[indices[t * 3]].position;
+            const Vector3& p1 = vertices[indices[t * 3 + 1]].position;
+            const Vector3& p2 = vertices[indices[t * 3 + 2]].position;
+
+            float e1[3] = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
+            float e2[3] = {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z};
+            float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            float area = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            centroid[0] += (p0.x + p1.x + p2.x) / 3.0f * area;
+            centroid[1] += (p0.y + p1.y + p2.y) / 3.0f * area;
+            centroid[2] += (p0.z + p1.z + p2.z) / 3.0f * area;
+            normal[0] += n[0];
+            normal[1] += n[1];
+            normal[2] += n[2];
+            clusterArea += area;
+        }
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+            meshCentroid[k] += centroid[k];
+        }
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f)
+        {
+            centroid[0] /= clusterArea;
+            centroid[1] /= clusterArea;
+            centroid[2] /= clusterArea;
+        }
+        float length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length > 0.0f)
+        {
+            normal[0] /= length;
+            normal[1] /= length;
+            normal[2] /= length;
+        }
+    }
+    if (meshArea > 0.0f)
+    {
+        meshCentroid[0] /= meshArea;
+        meshCentroid[1] /= meshArea;
+        meshCentroid[2] /= meshArea;
+    }
+    for (unsigned int c = 0; c < clusters.size(); ++c)
+    {
+        const float* centroid = &clusterData[c * 6];
+        const float* normal = &clusterData[c * 6 + 3];
+        clusters[c].key = (centroid[0] - meshCentroid[0]) * normal[0] +
+                          (centroid[1] - meshCentroid[1]) * normal[1] +
+                          (centroid[2] - meshCentroid[2]) * normal[2];
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), compareClusters);
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (std::vector<TriangleCluster>::const_iterator i = clusters.begin(); i != clusters.end(); ++i)
+    {
+        result.insert(result.end(), indices.begin() + i->begin * 3, indices.begin() + i->end * 3);
+    }
+    result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeVertexFetch(Mesh* mesh)
+{
+    assert(mesh);
+
+    unsigned int vertexCount = (unsigned int)mesh->getVertexCount();
+    std::vector<unsigned int> remap(vertexCount, NO_VERTEX);
+    unsigned int next = 0;
+    for (std::vector<MeshPart*>::const_iterator i = mesh->parts.begin(); i != mesh->parts.end(); ++i)
+    {
+        const std::vector<unsigned int>& indices = (*i)->getIndices();
+        for (std::vector<unsigned int>::const_iterator j = indices.begin(); j != indices.end(); ++j)
+        {
+            if (remap[*j] == NO_VERTEX)
+            {
+                remap[*j] = next++;
+            }
+        }
+    }
+    for (unsigned int v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] == NO_VERTEX)
+        {
+            remap[v] = next++;
+        }
+    }
+    mesh->remapVertices(remap);
+}
+
+}
@@ -0,0 +1,108 @@
+#ifndef MESHOPTIMIZER_H_
+#define MESHOPTIMIZER_H_
+
+#include "Mesh.h"
+
+namespace gameplay
+{
+
+/**
+ * The MeshOptimizer reorders the indices and vertices of a mesh so that the GPU
+ * reuses more transformed vertices, draws less overdraw and fetches vertices in order.
+ */
+class MeshOptimizer
+{
+public:
+
+    /**
+     * The size of the FIFO post-transform vertex cache that the ACMR and ATVR are measured with.
+     */
+    static const unsigned int CACHE_SIZE = 16;
+
+    /**
+     * The vertex cache statistics of a mesh.
+     */
+    class Statistics
+    {
+    public:
+
+        /**
+         * Constructor.
+         */
+        Statistics(void);
+
+        /**
+         * Returns the average cache miss ratio, which is the number of transformed vertices per triangle.
+         * This is between 0.5 and 3, lower is better.
+         */
+        float getACMR() const;
+
+        /**
+         * Returns the average transform to vertex ratio, which is the number of transformed vertices per vertex.
+         * This is 1 when each vertex is only transformed once, lower is better.
+         */
+        float getATVR() const;
+
+        unsigned int triangleCount;
+        unsigned int vertexCount;
+        unsigned int transformCount;
+    };
+
+    /**
+     * Optimizes the triangle lists of all of the parts of the mesh for the vertex cache and
+     * for overdraw, then reorders the vertices in the order that they are first used.
+     *
+     * @param mesh The mesh to optimize.
+     * @param before Returns the statistics of the mesh before it is optimized. May be NULL.
+     * @param after Returns the statistics of the mesh after it is optimized. May be NULL.
+     */
+    static void optimize(Mesh* mesh, Statistics* before, Statistics* after);
+
+    /**
+     * Computes the vertex cache statistics of the triangle lists of all of the parts of the mesh.
+     *
+     * @param mesh The mesh to measure.
+     * @param statistics Returns the statistics.
+     */
+    static void computeStatistics(const Mesh* mesh, Statistics* statistics);
+
+    /**
+     * Reorders the triangles of a triangle list for the vertex cache, using the Tipsify
+     * algorithm from "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+     * by Sander, Nehab and Barczak.
+     *
+     * @param indices The triangle list to reorder.
+     * @param vertexCount The number of vertices that the indices refer to.
+     */
+    static void optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int vertexCount);
+
+    /**
+     * Reorders clusters of triangles of a triangle list that was optimized for the vertex cache so
+     * that triangles that face outwards are drawn first, which reduces overdraw from any direction.
+     *
+     * @param indices The triangle list to reorder.
+     * @param vertices The vertices that the indices refer to.
+     * @param threshold How much the ACMR may grow by splitting the list into smaller clusters.
+     *      1.05 allows 5% more cache misses.
+     */
+    static void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices, float threshold);
+
+    /**
+     * Reorders the vertices of the mesh in the order that they are first used by its parts,
+     * followed by the vertices that are not used. The indices of the parts are remapped.
+     *
+     * @param mesh The mesh to reorder.
+     */
+    static void optimizeVertexFetch(Mesh* mesh);
+
+private:
+
+    /**
+     * Hidden constructor.
+     */
+    MeshOptimizer(void);
+};
+
+}
+
+#endif
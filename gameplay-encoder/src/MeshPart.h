@@ -62,6 +62,21 @@ public:
      */
     unsigned int getIndex(unsigned int i) const;
 
+    /**
+     * Returns the primitive type.
+     */
+    unsigned int getPrimitiveType() const;
+
+    /**
+     * Returns the list of indices.
+     */
+    const std::vector<unsigned int>& getIndices() const;
+
+    /**
+     * Replaces the list of indices, updating the index format to fit them.
+     */
+    void setIndices(const std::vector<unsigned int>& indices);
+
 private:
 
     /**
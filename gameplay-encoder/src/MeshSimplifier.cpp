@@ -0,0 +1,571 @@
+#include "Base.h"
+#include "MeshSimplifier.h"
+
+namespace gameplay
+{
+
+const float MeshSimplifier::MAX_SKIN_DIFFERENCE = 0.5f;
+
+/**
+ * How an edge collapse may move a vertex.
+ */
+enum VertexKind
+{
+    KIND_MANIFOLD,  // Moves onto any neighbour.
+    KIND_SEAM,      // Moves along its seam, together with the other vertex at its position.
+    KIND_LOCKED     // Never moves.
+};
+
+typedef std::pair<unsigned int, unsigned int> Edge;
+
+/**
+ * The sum of the squared distances to a set of planes, each weighted by the area of its triangle.
+ */
+struct Quadric
+{
+    double a2, b2, c2, ab, ac, bc, ad, bd, cd, d2, w;
+};
+
+/**
+ * An edge collapse that moves vertex v0 onto vertex v1.
+ */
+struct Collapse
+{
+    unsigned int v0;
+    unsigned int v1;
+    float error;
+};
+
+/**
+ * Orders vertex indices by the positions of the vertices.
+ */
+struct PositionLess
+{
+    const std::vector<Vertex>* vertices;
+
+    bool operator()(unsigned int a, unsigned int b) const
+    {
+        return (*vertices)[a].position < (*vertices)[b].position;
+    }
+};
+
+static bool compareCollapses(const Collapse& a, const Collapse& b)
+{
+    return a.error < b.error;
+}
+
+static void addPlane(Quadric& q, const Vector3& n, float d, float w)
+{
+    q.a2 += w * n.x * n.x;
+    q.b2 += w * n.y * n.y;
+    q.c2 += w * n.z * n.z;
+    q.ab += w * n.x * n.y;
+    q.ac += w * n.x * n.z;
+    q.bc += w * n.y * n.z;
+    q.ad += w * n.x * d;
+    q.bd += w * n.y * d;
+    q.cd += w * n.z * d;
+    q.d2 += w * d * d;
+    q.w += w;
+}
+
+static void addQuadric(Quadric& q, const Quadric& r)
+{
+    q.a2 += r.a2;
+    q.b2 += r.b2;
+    q.c2 += r.c2;
+    q.ab += r.ab;
+    q.ac += r.ac;
+    q.bc += r.bc;
+    q.ad += r.ad;
+    q.bd += r.bd;
+    q.cd += r.cd;
+    q.d2 += r.d2;
+    q.w += r.w;
+}
+
+/**
+ * Returns the mean squared distance from the point to the planes of the quadric.
+ */
+static float evaluateQuadric(const Quadric& q, const Vector3& p)
+{
+    if (q.w <= 0.0)
+    {
+        return 0.0f;
+    }
+    double x = p.x;
+    double y = p.y;
+    double z = p.z;
+    double e = q.a2 * x * x + q.b2 * y * y + q.c2 * z * z +
+        2.0 * (q.ab * x * y + q.ac * x * z + q.bc * y * z) +
+        2.0 * (q.ad * x + q.bd * y + q.cd * z) + q.d2;
+    return (float)std::max(e / q.w, 0.0);
+}
+
+static bool hasEdge(const std::vector<Edge>& edges, unsigned int a, unsigned int b)
+{
+    return std::binary_search(edges.begin(), edges.end(), Edge(a, b));
+}
+
+/**
+ * Builds the sorted list of the directed edges of the triangles, after mapping each index through the remap table.
+ */
+static void buildEdges(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& remap, std::vector<Edge>& edges)
+{
+    edges.clear();
+    edges.reserve(indices.size());
+    for (unsigned int i = 0, count = (unsigned int)indices.size(); i < count; i += 3)
+    {
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+            edges.push_back(Edge(remap[indices[i + k]], remap[indices[i + (k + 1) % 3]]));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+}
+
+/**
+ * Maps each vertex to the first vertex with the same position and links the vertices
+ * with the same position into rings.
+ */
+static void buildPositionRemap(const std::vector<Vertex>& vertices, std::vector<unsigned int>& remap, std::vector<unsigned int>& wedge)
+{
+    unsigned int vertexCount = (unsigned int)vertices.size();
+    std::vector<unsigned int> order(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        order[i] = i;
+    }
+    PositionLess less;
+    less.vertices = &vertices;
+    std::sort(order.begin(), order.end(), less);
+
+    remap.resize(vertexCount);
+    wedge.resize(vertexCount);
+    for (unsigned int i = 0; i < vertexCount;)
+    {
+        unsigned int j = i;
+        while (j < vertexCount && vertices[order[j]].position == vertices[order[i]].position)
+        {
+            ++j;
+        }
+        for (unsigned int k = i; k < j; ++k)
+        {
+            remap[order[k]] = order[i];
+            wedge[order[k]] = order[k + 1 < j ? k + 1 : i];
+        }
+        i = j;
+    }
+}
+
+/**
+ * Classifies how each vertex may be moved by edge collapses.
+ */
+static void classifyVertices(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& triangleParts,
+                             const std::vector<unsigned int>& remap, const std::vector<unsigned int>& wedge,
+                             std::vector<unsigned char>& kinds)
+{
+    unsigned int vertexCount = (unsigned int)remap.size();
+    std::vector<unsigned char> locked(vertexCount, 0);
+
+    // Lock the positions that are used by more than one part, which keeps the boundaries between materials.
+    std::vector<unsigned int> parts(vertexCount, (unsigned int)-1);
+    for (unsigned int i = 0, count = (unsigned int)indices.size(); i < count; ++i)
+    {
+        unsigned int r = remap[indices[i]];
+        unsigned int part = triangleParts[i / 3];
+        if (parts[r] == (unsigned int)-1)
+        {
+            parts[r] = part;
+        }
+        else if (parts[r] != part)
+        {
+            locked[r] = 1;
+        }
+    }
+
+    // Lock the positions on open borders and on edges that are shared by more than two triangles.
+    std::vector<Edge> positionEdges;
+    buildEdges(indices, remap, positionEdges);
+    for (unsigned int i = 0, count = (unsigned int)positionEdges.size(); i < count; ++i)
+    {
+        const Edge& edge = positionEdges[i];
+        bool repeated = (i > 0 && positionEdges[i - 1] == edge) || (i + 1 < count && positionEdges[i + 1] == edge);
+        if (repeated || !hasEdge(positionEdges, edge.second, edge.first))
+        {
+            locked[edge.first] = 1;
+            locked[edge.second] = 1;
+        }
+    }
+
+    // Any other open edge between vertices is on a seam, where the positions are shared but the attributes are not.
+    std::vector<unsigned int> identity(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        identity[i] = i;
+    }
+    std::vector<Edge> edges;
+    buildEdges(indices, identity, edges);
+    std::vector<unsigned int> openEdgeCounts(vertexCount, 0);
+    for (std::vector<Edge>::const_iterator i = edges.begin(); i != edges.end(); ++i)
+    {
+        if (!hasEdge(edges, i->second, i->first))
+        {
+            ++openEdgeCounts[i->first];
+            ++openEdgeCounts[i->second];
+        }
+    }
+
+    kinds.resize(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        unsigned int wedgeCount = 1;
+        for (unsigned int w = wedge[i]; w != i; w = wedge[w])
+        {
+            ++wedgeCount;
+        }
+
+        if (locked[remap[i]])
+        {
+            kinds[i] = KIND_LOCKED;
+        }
+        else if (wedgeCount == 1 && openEdgeCounts[i] == 0)
+        {
+            kinds[i] = KIND_MANIFOLD;
+        }
+        else if (wedgeCount == 2 && openEdgeCounts[i] == 2 && openEdgeCounts[wedge[i]] == 2)
+        {
+            // A seam passes through this position, with one vertex on each side.
+            kinds[i] = KIND_SEAM;
+        }
+        else
+        {
+            // Where seams meet or end.
+            kinds[i] = KIND_LOCKED;
+        }
+    }
+}
+
+/**
+ * Gets the joints that influence the vertex, with the sum of their weights.
+ */
+static unsigned int getInfluences(const Vertex& vertex, float* joints, float* weights)
+{
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        float joint = (&vertex.blendIndices.x)[i];
+        float weight = (&vertex.blendWeights.x)[i];
+        if (weight <= 0.0f)
+        {
+            continue;
+        }
+        unsigned int j = 0;
+        while (j < count && joints[j] != joint)
+        {
+            ++j;
+        }
+        if (j == count)
+        {
+            joints[count] = joint;
+            weights[count] = 0.0f;
+            ++count;
+        }
+        weights[j] += weight;
+    }
+    return count;
+}
+
+/**
+ * Returns the sum of the differences of the weights of each joint that influences either vertex.
+ */
+static float getSkinDifference(const Vertex& a, const Vertex& b)
+{
+    float jointsA[4], weightsA[4], jointsB[4], weightsB[4];
+    unsigned int countA = getInfluences(a, jointsA, weightsA);
+    unsigned int countB = getInfluences(b, jointsB, weightsB);
+
+    float difference = 0.0f;
+    for (unsigned int i = 0; i < countA; ++i)
+    {
+        float weight = 0.0f;
+        for (unsigned int j = 0; j < countB; ++j)
+        {
+            if (jointsB[j] == jointsA[i])
+            {
+                weight = weightsB[j];
+            }
+        }
+        difference += fabs(weightsA[i] - weight);
+    }
+    for (unsigned int j = 0; j < countB; ++j)
+    {
+        bool shared = false;
+        for (unsigned int i = 0; i < countA; ++i)
+        {
+            shared = shared || jointsA[i] == jointsB[j];
+        }
+        if (!shared)
+        {
+            difference += weightsB[j];
+        }
+    }
+    return difference;
+}
+
+/**
+ * Returns true if moving the position r0 to the given position turns over any triangle that does not use position r1.
+ */
+static bool flipsTriangles(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const std::vector<unsigned int>& remap,
+                           const std::vector<unsigned int>& adjacencyOffsets, const std::vector<unsigned int>& adjacency,
+                           unsigned int r0, unsigned int r1, const Vector3& position)
+{
+    for (unsigned int i = adjacencyOffsets[r0]; i < adjacencyOffsets[r0 + 1]; ++i)
+    {
+        const unsigned int* triangle = &indices[adjacency[i] * 3];
+        if (remap[triangle[0]] == r1 || remap[triangle[1]] == r1 || remap[triangle[2]] == r1)
+        {
+            // This triangle collapses.
+            continue;
+        }
+
+        Vector3 p[3];
+        Vector3 q[3];
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+            p[k] = vertices[triangle[k]].position;
+            q[k] = remap[triangle[k]] == r0 ? position : p[k];
+        }
+        Vector3 e0, e1, before, after;
+        Vector3::subtract(p[1], p[0], &e0);
+        Vector3::subtract(p[2], p[0], &e1);
+        Vector3::cross(e0, e1, &before);
+        Vector3::subtract(q[1], q[0], &e0);
+        Vector3::subtract(q[2], q[0], &e1);
+        Vector3::cross(e0, e1, &after);
+        if (Vector3::dot(before, after) <= 0.0f)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+float MeshSimplifier::simplify(const Mesh* mesh, float ratio, bool skinned, std::vector<std::vector<unsigned int> >& lodIndices)
+{
+    assert(mesh);
+    const std::vector<Vertex>& vertices = mesh->vertices;
+    unsigned int vertexCount = (unsigned int)vertices.size();
+    unsigned int partCount = (unsigned int)mesh->parts.size();
+
+    // Gather the triangles of all of the parts, remembering the part of each triangle.
+    std::vector<unsigned int> indices;
+    std::vector<unsigned int> triangleParts;
+    for (unsigned int i = 0; i < partCount; ++i)
+    {
+        const std::vector<unsigned int>& partIndices = mesh->parts[i]->getIndices();
+        assert(mesh->parts[i]->getPrimitiveType() == MeshPart::TRIANGLES);
+        indices.insert(indices.end(), partIndices.begin(), partIndices.end() - partIndices.size() % 3);
+        triangleParts.insert(triangleParts.end(), partIndices.size() / 3, i);
+    }
+
+    std::vector<unsigned int> remap;
+    std::vector<unsigned int> wedge;
+    buildPositionRemap(vertices, remap, wedge);
+
+    std::vector<unsigned char> kinds;
+    classifyVertices(indices, triangleParts, remap, wedge, kinds);
+
+    // The quadrics are kept for each position, so that the vertices on either side of a seam share theirs.
+    Quadric zero;
+    memset(&zero, 0, sizeof(zero));
+    std::vector<Quadric> quadrics(vertexCount, zero);
+    for (unsigned int i = 0, count = (unsigned int)indices.size(); i < count; i += 3)
+    {
+        const Vector3& p0 = vertices[indices[i]].position;
+        const Vector3& p1 = vertices[indices[i + 1]].position;
+        const Vector3& p2 = vertices[indices[i + 2]].position;
+        Vector3 e0, e1, normal;
+        Vector3::subtract(p1, p0, &e0);
+        Vector3::subtract(p2, p0, &e1);
+        Vector3::cross(e0, e1, &normal);
+        float length = normal.length();
+        if (length <= 0.0f)
+        {
+            continue;
+        }
+        normal.scale(1.0f / length);
+        float d = -Vector3::dot(normal, p0);
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+            addPlane(quadrics[remap[indices[i + k]]], normal, d, length * 0.5f);
+        }
+    }
+
+    unsigned int targetTriangleCount = (unsigned int)(indices.size() / 3 * ratio);
+    float maxError = 0.0f;
+
+    std::vector<Edge> edges;
+    std::vector<unsigned int> adjacencyOffsets;
+    std::vector<unsigned int> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<unsigned int> targets(vertexCount);
+    std::vector<unsigned char> touched(vertexCount);
+    std::vector<unsigned int> identity(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        identity[i] = i;
+    }
+
+    while (indices.size() / 3 > targetTriangleCount)
+    {
+        unsigned int triangleCount = (unsigned int)indices.size() / 3;
+        buildEdges(indices, identity, edges);
+
+        // The triangles that use each position.
+        adjacencyOffsets.assign(vertexCount + 1, 0);
+        for (unsigned int i = 0, count = (unsigned int)indices.size(); i < count; ++i)
+        {
+            ++adjacencyOffsets[remap[indices[i]] + 1];
+        }
+        for (unsigned int i = 0; i < vertexCount; ++i)
+        {
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        }
+        adjacency.resize(indices.size());
+        std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (unsigned int i = 0, count = (unsigned int)indices.size(); i < count; ++i)
+        {
+            adjacency[fill[remap[indices[i]]]++] = i / 3;
+        }
+
+        // Find every edge collapse that is allowed, in both directions.
+        collapses.clear();
+        for (unsigned int i = 0, count = (unsigned int)indices.size(); i < count; ++i)
+        {
+            unsigned int a = indices[i];
+            unsigned int b = indices[i - i % 3 + (i + 1) % 3];
+            for (unsigned int k = 0; k < 2; ++k)
+            {
+                unsigned int v0 = k == 0 ? a : b;
+                unsigned int v1 = k == 0 ? b : a;
+                if (kinds[v0] == KIND_LOCKED || remap[v0] == remap[v1])
+                {
+                    continue;
+                }
+                if (kinds[v0] == KIND_SEAM && hasEdge(edges, v0, v1) && hasEdge(edges, v1, v0))
+                {
+                    // Seam vertices only move along the seam.
+                    continue;
+                }
+                if (skinned && getSkinDifference(vertices[v0], vertices[v1]) > MAX_SKIN_DIFFERENCE)
+                {
+                    continue;
+                }
+                Collapse collapse;
+                collapse.v0 = v0;
+                collapse.v1 = v1;
+                collapse.error = evaluateQuadric(quadrics[remap[v0]], vertices[v1].position);
+                collapses.push_back(collapse);
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(), compareCollapses);
+
+        // Apply the cheapest collapses whose neighbourhoods do not overlap, until enough triangles are removed.
+        for (unsigned int i = 0; i < vertexCount; ++i)
+        {
+            targets[i] = i;
+        }
+        touched.assign(vertexCount, 0);
+        unsigned int removedCount = 0;
+        for (std::vector<Collapse>::const_iterator i = collapses.begin(); i != collapses.end() && triangleCount - removedCount > targetTriangleCount; ++i)
+        {
+            unsigned int r0 = remap[i->v0];
+            unsigned int r1 = remap[i->v1];
+            if (touched[r0] || touched[r1])
+            {
+                continue;
+            }
+            if (flipsTriangles(vertices, indices, remap, adjacencyOffsets, adjacency, r0, r1, vertices[i->v1].position))
+            {
+                continue;
+            }
+
+            unsigned int sibling = i->v0;
+            unsigned int siblingTarget = i->v1;
+            if (kinds[i->v0] == KIND_SEAM)
+            {
+                // The other side of the seam moves along the seam to the vertex at the same position as v1.
+                sibling = wedge[i->v0];
+                siblingTarget = (unsigned int)-1;
+                unsigned int w = i->v1;
+                do
+                {
+                    if (hasEdge(edges, sibling, w) != hasEdge(edges, w, sibling))
+                    {
+                        siblingTarget = w;
+                    }
+                    w = wedge[w];
+                } while (w != i->v1);
+                if (siblingTarget == (unsigned int)-1)
+                {
+                    continue;
+                }
+            }
+
+            targets[i->v0] = i->v1;
+            targets[sibling] = siblingTarget;
+
+            for (unsigned int j = adjacencyOffsets[r0]; j < adjacencyOffsets[r0 + 1]; ++j)
+            {
+                const unsigned int* triangle = &indices[adjacency[j] * 3];
+                if (remap[triangle[0]] == r1 || remap[triangle[1]] == r1 || remap[triangle[2]] == r1)
+                {
+                    ++removedCount;
+                }
+                for (unsigned int k = 0; k < 3; ++k)
+                {
+                    touched[remap[triangle[k]]] = 1;
+                }
+            }
+            touched[r1] = 1;
+
+            addQuadric(quadrics[r1], quadrics[r0]);
+            maxError = std::max(maxError, i->error);
+        }
+        if (removedCount == 0)
+        {
+            break;
+        }
+
+        // Move the collapsed vertices and remove the triangles that became degenerate.
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < triangleCount; ++i)
+        {
+            unsigned int a = targets[indices[i * 3]];
+            unsigned int b = targets[indices[i * 3 + 1]];
+            unsigned int c = targets[indices[i * 3 + 2]];
+            if (remap[a] == remap[b] || remap[b] == remap[c] || remap[c] == remap[a])
+            {
+                continue;
+            }
+            indices[count * 3] = a;
+            indices[count * 3 + 1] = b;
+            indices[count * 3 + 2] = c;
+            triangleParts[count] = triangleParts[i];
+            ++count;
+        }
+        indices.resize(count * 3);
+        triangleParts.resize(count);
+    }
+
+    lodIndices.assign(partCount, std::vector<unsigned int>());
+    for (unsigned int i = 0, count = (unsigned int)triangleParts.size(); i < count; ++i)
+    {
+        std::vector<unsigned int>& partIndices = lodIndices[triangleParts[i]];
+        partIndices.insert(partIndices.end(), indices.begin() + i * 3, indices.begin() + i * 3 + 3);
+    }
+    return sqrt(maxError);
+}
+
+}
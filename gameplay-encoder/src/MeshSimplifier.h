@@ -0,0 +1,51 @@
+#ifndef MESHSIMPLIFIER_H_
+#define MESHSIMPLIFIER_H_
+
+#include "Mesh.h"
+
+namespace gameplay
+{
+
+/**
+ * The MeshSimplifier generates simplified levels of detail of a mesh by collapsing edges
+ * in the order of their quadric error, as in "Surface Simplification Using Quadric Error
+ * Metrics" by Garland and Heckbert.
+ *
+ * Each edge collapse moves a vertex onto one of its neighbours, so the simplified triangles
+ * index the vertices of the mesh and keep their attributes. Vertices on open borders, on the
+ * boundaries between parts and where more than two texture coordinate or normal seams meet are
+ * never moved, and vertices on a seam only move along the seam so that it stays closed.
+ */
+class MeshSimplifier
+{
+public:
+
+    /**
+     * The largest total difference of the blend weights of two vertices that may be collapsed
+     * in skinned meshes, so that vertices only move onto vertices that bend with the same joints.
+     */
+    static const float MAX_SKIN_DIFFERENCE;
+
+    /**
+     * Simplifies the triangle lists of all of the parts of the mesh together.
+     *
+     * @param mesh The mesh to simplify. All of its parts must be triangle lists.
+     * @param ratio The fraction of the triangles of the mesh to keep.
+     * @param skinned True to only collapse vertices that have similar blend weights.
+     * @param lodIndices Returns the triangle list of each part of the simplified mesh.
+     *
+     * @return The geometric error of the simplified mesh, in the units of the mesh positions.
+     */
+    static float simplify(const Mesh* mesh, float ratio, bool skinned, std::vector<std::vector<unsigned int> >& lodIndices);
+
+private:
+
+    /**
+     * Hidden constructor.
+     */
+    MeshSimplifier(void);
+};
+
+}
+
+#endif
@@ -46,6 +46,12 @@ void MeshSkin::writeBinary(FILE* file)
     {
         write(i->m, 16, file);
     }
+    // The joints of each mesh part, or zero parts if all parts use the joints of the skin.
+    write((unsigned int)_partJoints.size(), file);
+    for (std::vector<std::vector<unsigned int> >::const_iterator i = _partJoints.begin(); i != _partJoints.end(); ++i)
+    {
+        write(*i, file);
+    }
 
     /*
     // Write joint bounding spheres
@@ -82,6 +88,15 @@ void MeshSkin::writeText(FILE* file)
         }
     }
     fprintf(file, "</bindPoses>\n");
+    for (std::vector<std::vector<unsigned int> >::const_iterator i = _partJoints.begin(); i != _partJoints.end(); ++i)
+    {
+        fprintf(file, "<partJoints count=\"%lu\">", i->size());
+        for (std::vector<unsigned int>::const_iterator j = i->begin(); j != i->end(); ++j)
+        {
+            fprintf(file, "%u ", *j);
+        }
+        fprintf(file, "</partJoints>\n");
+    }
 
     fprintElementEnd(file);
 }
@@ -139,6 +154,162 @@ bool MeshSkin::hasJoint(const char* id)
     return false;
 }
 
+/**
+ * Adds the joints that influence the vertex and are not in the list yet to the list.
+ */
+static void addVertexJoints(const Vertex& vertex, std::vector<unsigned int>& joints)
+{
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        if (!ISZERO((&vertex.blendWeights.x)[i]))
+        {
+            unsigned int joint = (unsigned int)(&vertex.blendIndices.x)[i];
+            if (find(joints.begin(), joints.end(), joint) == joints.end())
+            {
+                joints.push_back(joint);
+            }
+        }
+    }
+}
+
+/**
+ * Returns true if the blend indices of the vertices, which index the given joint lists, have the same joints.
+ */
+static bool hasSameJoints(const Vertex& a, const std::vector<unsigned int>& aJoints, const Vertex& b, const std::vector<unsigned int>& bJoints)
+{
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        if (!ISZERO((&a.blendWeights.x)[i]) &&
+            (!((&a.blendIndices.x)[i] == (&b.blendIndices.x)[i]) ||
+            aJoints[(unsigned int)(&a.blendIndices.x)[i]] != bJoints[(unsigned int)(&b.blendIndices.x)[i]]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MeshSkin::splitParts(unsigned int maxJointCount)
+{
+    assert(_mesh);
+    if (_joints.size() <= maxJointCount || !_partJoints.empty())
+    {
+        return false;
+    }
+    for (std::vector<MeshPart*>::const_iterator i = _mesh->parts.begin(); i != _mesh->parts.end(); ++i)
+    {
+        if ((*i)->getPrimitiveType() != MeshPart::TRIANGLES)
+        {
+            fprintf(stderr, "Warning: Skinned mesh %s has parts that are not triangle lists and is not split.\n", _mesh->getId().c_str());
+            return false;
+        }
+    }
+
+    // Each part is split by adding the triangles whose joints still fit in the new part, in the
+    // order of the part, and starting a new part with the triangles that are left over.
+    const std::vector<Vertex>& vertices = _mesh->vertices;
+    std::vector<std::vector<unsigned int> > partIndices;
+    std::vector<std::vector<unsigned int> > partJoints;
+    std::vector<unsigned int> triangleJoints;
+    for (std::vector<MeshPart*>::const_iterator i = _mesh->parts.begin(); i != _mesh->parts.end(); ++i)
+    {
+        std::vector<unsigned int> remaining = (*i)->getIndices();
+        while (!remaining.empty())
+        {
+            std::vector<unsigned int> indices;
+            std::vector<unsigned int> joints;
+            std::vector<unsigned int> skipped;
+            for (size_t j = 0; j + 2 < remaining.size(); j += 3)
+            {
+                triangleJoints = joints;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    addVertexJoints(vertices[remaining[j + k]], triangleJoints);
+                }
+                if (triangleJoints.size() <= maxJointCount)
+                {
+                    joints.swap(triangleJoints);
+                    indices.insert(indices.end(), remaining.begin() + j, remaining.begin() + j + 3);
+                }
+                else
+                {
+                    skipped.insert(skipped.end(), remaining.begin() + j, remaining.begin() + j + 3);
+                }
+            }
+            if (indices.empty())
+            {
+                fprintf(stderr, "Error: Skinned mesh %s has a triangle that uses more than %u joints.\n", _mesh->getId().c_str(), maxJointCount);
+                return false;
+            }
+            partIndices.push_back(indices);
+            partJoints.push_back(joints);
+            remaining.swap(skipped);
+        }
+    }
+
+    // The blend indices of the vertices of each part index the joints of the part. Vertices
+    // that are shared with a part that gives them different blend indices are duplicated.
+    std::vector<Vertex> newVertices(vertices);
+    std::vector<int> vertexParts(vertices.size(), -1);
+    for (unsigned int i = 0, partCount = (unsigned int)partIndices.size(); i < partCount; ++i)
+    {
+        const std::vector<unsigned int>& joints = partJoints[i];
+        std::map<unsigned int, unsigned int> copies;
+        for (std::vector<unsigned int>::iterator j = partIndices[i].begin(); j != partIndices[i].end(); ++j)
+        {
+            Vertex vertex = vertices[*j];
+            for (unsigned int k = 0; k < 4; ++k)
+            {
+                float& index = (&vertex.blendIndices.x)[k];
+                if (ISZERO((&vertex.blendWeights.x)[k]))
+                {
+                    index = 0.0f;
+                }
+                else
+                {
+                    index = (float)(find(joints.begin(), joints.end(), (unsigned int)index) - joints.begin());
+                }
+            }
+
+            if (vertexParts[*j] == -1)
+            {
+                vertexParts[*j] = (int)i;
+                newVertices[*j] = vertex;
+            }
+            else if (vertexParts[*j] != (int)i && !hasSameJoints(vertex, joints, newVertices[*j], partJoints[vertexParts[*j]]))
+            {
+                std::map<unsigned int, unsigned int>::const_iterator copy = copies.find(*j);
+                if (copy == copies.end())
+                {
+                    copy = copies.insert(std::make_pair(*j, (unsigned int)newVertices.size())).first;
+                    newVertices.push_back(vertex);
+                }
+                *j = copy->second;
+            }
+        }
+    }
+
+    for (std::vector<MeshPart*>::iterator i = _mesh->parts.begin(); i != _mesh->parts.end(); ++i)
+    {
+        delete *i;
+    }
+    _mesh->parts.clear();
+    for (std::vector<std::vector<unsigned int> >::const_iterator i = partIndices.begin(); i != partIndices.end(); ++i)
+    {
+        MeshPart* part = new MeshPart();
+        part->setIndices(*i);
+        _mesh->parts.push_back(part);
+    }
+    _mesh->setVertices(newVertices);
+    _partJoints.swap(partJoints);
+    return true;
+}
+
+const std::vector<std::vector<unsigned int> >& MeshSkin::getPartJoints() const
+{
+    return _partJoints;
+}
+
 void MeshSkin::computeBounds()
 {
     // Find the offset of the blend indices and blend weights within the mesh vertices
@@ -200,6 +371,29 @@ void MeshSkin::computeBounds()
     std::vector<Vector3> vertices;
     _jointBounds.resize(jointCount);
 
+    // The blend indices of the vertices of split parts index the joints of their part.
+    std::vector<unsigned int> jointIndices(vertexCount * 4);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        const Vertex& v = _mesh->getVertex(i);
+        for (unsigned int j = 0; j < 4; ++j)
+        {
+            jointIndices[i * 4 + j] = (unsigned int)(&v.blendIndices.x)[j];
+        }
+    }
+    for (unsigned int i = 0, partCount = (unsigned int)_partJoints.size(); i < partCount; ++i)
+    {
+        const std::vector<unsigned int>& indices = _mesh->parts[i]->getIndices();
+        for (std::vector<unsigned int>::const_iterator j = indices.begin(); j != indices.end(); ++j)
+        {
+            const Vertex& v = _mesh->getVertex(*j);
+            for (unsigned int k = 0; k < 4; ++k)
+            {
+                jointIndices[*j * 4 + k] = _partJoints[i][(unsigned int)(&v.blendIndices.x)[k]];
+            }
+        }
+    }
+
     // Construct a list of all animation channels that target the joints affecting this mesh skin
     DEBUGPRINT("> Collecting animations...\n");
     DEBUGPRINT("> 0%%\r");
@@ -235,10 +429,11 @@ void MeshSkin::computeBounds()
         {
             const Vertex& v = _mesh->getVertex(j);
 
-            if ((v.blendIndices.x == i && !ISZERO(v.blendWeights.x)) ||
-                (v.blendIndices.y == i && !ISZERO(v.blendWeights.y)) ||
-                (v.blendIndices.z == i && !ISZERO(v.blendWeights.z)) ||
-                (v.blendIndices.w == i && !ISZERO(v.blendWeights.w)))
+            const unsigned int* indices = &jointIndices[j * 4];
+            if ((indices[0] == i && !ISZERO(v.blendWeights.x)) ||
+                (indices[1] == i && !ISZERO(v.blendWeights.y)) ||
+                (indices[2] == i && !ISZERO(v.blendWeights.z)) ||
+                (indices[3] == i && !ISZERO(v.blendWeights.w)))
             {
                 vertices.push_back(v.position);
                 // Update box min/max
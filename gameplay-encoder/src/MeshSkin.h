@@ -57,6 +57,26 @@ public:
      */
     bool hasJoint(const char* id);
 
+    /**
+     * Splits the parts of the mesh so that each part uses at most the given number of joints.
+     * The blend indices of the vertices of each part are changed to index the joints of the
+     * part, and vertices that are used by parts with different joints are duplicated.
+     *
+     * The new parts of each part follow each other in the order of the parts they came from.
+     *
+     * @param maxJointCount The largest number of joints of a part.
+     *
+     * @return True if the parts were split, false if the skin has few enough joints, the mesh has parts
+     *      that are not triangle lists or a triangle uses too many joints.
+     */
+    bool splitParts(unsigned int maxJointCount);
+
+    /**
+     * Returns the indices of the joints of this skin that each part of the mesh uses,
+     * or an empty list if the parts have not been split.
+     */
+    const std::vector<std::vector<unsigned int> >& getPartJoints() const;
+
     void computeBounds();
 
 private:
@@ -68,6 +88,7 @@ private:
     std::vector<std::string> _jointNames;
     unsigned int _vertexInfluenceCount;
     std::vector<BoundingVolume> _jointBounds;
+    std::vector<std::vector<unsigned int> > _partJoints;
 };
 
 }
@@ -135,9 +135,11 @@ void Node::generateHeightmap()
             std::string heightmapFilename(EncoderArguments::getInstance()->getOutputDirPath());
             heightmapFilename += "/heightmap_";
             heightmapFilename += getId();
-            heightmapFilename += ".png";
+            EncoderArguments::HeightmapFormat format = EncoderArguments::getInstance()->getHeightmapFormat();
+            heightmapFilename += format == EncoderArguments::HEIGHTMAP_FLOAT ? ".raw" : ".png";
 
-            mesh->generateHeightmap(heightmapFilename.c_str(), EncoderArguments::getInstance()->isHeightmapHighP());
+            mesh->generateHeightmap(heightmapFilename.c_str(), format,
+                EncoderArguments::getInstance()->getHeightmapSpacing(), EncoderArguments::getInstance()->getHeightmapResolution());
         }
     }
 }
@@ -35,6 +35,13 @@ public:
 
     Object* get(const std::string& xref);
 
+    /**
+     * Removes an object from the reference table.
+     * 
+     * @param xref The xref of the object to remove.
+     */
+    void remove(const std::string& xref);
+
     void writeBinary(FILE* file);
     void writeText(FILE* file);
 
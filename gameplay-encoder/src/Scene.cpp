@@ -61,6 +61,21 @@ void Scene::add(Node* node)
     _nodes.push_back(node);
 }
 
+const std::list<Node*>& Scene::getNodes() const
+{
+    return _nodes;
+}
+
+void Scene::replace(Node* node, const std::vector<Node*>& nodes)
+{
+    std::list<Node*>::iterator i = std::find(_nodes.begin(), _nodes.end(), node);
+    if (i != _nodes.end())
+    {
+        _nodes.insert(i, nodes.begin(), nodes.end());
+        _nodes.erase(i);
+    }
+}
+
 void Scene::setActiveCameraNode(Node* node)
 {
     _cameraNode = node;
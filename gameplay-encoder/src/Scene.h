@@ -34,6 +34,19 @@ public:
      */
     void add(Node* node);
 
+    /**
+     * Returns the root nodes of this scene.
+     */
+    const std::list<Node*>& getNodes() const;
+
+    /**
+     * Replaces a root node of this scene with the given nodes, in the same position.
+     * 
+     * @param node The root node to replace.
+     * @param nodes The nodes to replace it with. The node is removed if this is empty.
+     */
+    void replace(Node* node, const std::vector<Node*>& nodes);
+
     /**
      * Sets the activate camera node. This node should contain a camera.
      */
@@ -0,0 +1,248 @@
+#include "Base.h"
+#include "Thread.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace gameplay
+{
+
+static unsigned int __maxThreadCount = 0;
+
+/**
+ * The work shared by the threads of Thread::parallelFor.
+ */
+struct ParallelFor
+{
+    Thread::IndexFunction function;
+    void* arg;
+    unsigned int count;
+    unsigned int next;
+    Mutex mutex;
+};
+
+static void runParallelFor(void* arg)
+{
+    ParallelFor* work = (ParallelFor*)arg;
+    for (;;)
+    {
+        work->mutex.lock();
+        unsigned int index = work->next;
+        if (index < work->count)
+        {
+            ++work->next;
+        }
+        work->mutex.unlock();
+
+        if (index >= work->count)
+        {
+            break;
+        }
+        work->function(index, work->arg);
+    }
+}
+
+Thread::Thread() : _handle(NULL), _function(NULL), _arg(NULL), _running(false)
+{
+}
+
+Thread::~Thread()
+{
+    join();
+}
+
+void Thread::setMaxThreadCount(unsigned int count)
+{
+    __maxThreadCount = count;
+}
+
+unsigned int Thread::getMaxThreadCount()
+{
+    return __maxThreadCount > 0 ? __maxThreadCount : getProcessorCount();
+}
+
+void Thread::parallelFor(unsigned int count, IndexFunction function, void* arg)
+{
+    assert(function);
+
+    unsigned int threadCount = std::min(getMaxThreadCount(), count);
+    if (threadCount <= 1)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            function(i, arg);
+        }
+        return;
+    }
+
+    ParallelFor work;
+    work.function = function;
+    work.arg = arg;
+    work.count = count;
+    work.next = 0;
+
+    // The calling thread works too, so one less thread is started.
+    std::vector<Thread*> threads(threadCount - 1);
+    for (unsigned int i = 0; i < threads.size(); ++i)
+    {
+        threads[i] = new Thread();
+        threads[i]->start(&runParallelFor, &work);
+    }
+    runParallelFor(&work);
+    for (unsigned int i = 0; i < threads.size(); ++i)
+    {
+        SAFE_DELETE(threads[i]);
+    }
+}
+
+#ifdef WIN32
+
+unsigned long __stdcall Thread::run(void* thread)
+{
+    Thread* t = (Thread*)thread;
+    t->_function(t->_arg);
+    return 0;
+}
+
+bool Thread::start(Function function, void* arg)
+{
+    assert(function);
+    if (_running)
+    {
+        return false;
+    }
+
+    _function = function;
+    _arg = arg;
+    _handle = CreateThread(NULL, 0, &Thread::run, this, 0, NULL);
+    if (_handle == NULL)
+    {
+        fprintf(stderr, "Error: Failed to create thread.\n");
+        return false;
+    }
+    _running = true;
+    return true;
+}
+
+void Thread::join()
+{
+    if (_running)
+    {
+        WaitForSingleObject((HANDLE)_handle, INFINITE);
+        CloseHandle((HANDLE)_handle);
+        _handle = NULL;
+        _running = false;
+    }
+}
+
+unsigned int Thread::getProcessorCount()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+}
+
+Mutex::Mutex()
+{
+    CRITICAL_SECTION* section = new CRITICAL_SECTION;
+    InitializeCriticalSection(section);
+    _handle = section;
+}
+
+Mutex::~Mutex()
+{
+    CRITICAL_SECTION* section = (CRITICAL_SECTION*)_handle;
+    DeleteCriticalSection(section);
+    SAFE_DELETE(section);
+}
+
+void Mutex::lock()
+{
+    EnterCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+void Mutex::unlock()
+{
+    LeaveCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+#else
+
+void* Thread::run(void* thread)
+{
+    Thread* t = (Thread*)thread;
+    t->_function(t->_arg);
+    return NULL;
+}
+
+bool Thread::start(Function function, void* arg)
+{
+    assert(function);
+    if (_running)
+    {
+        return false;
+    }
+
+    _function = function;
+    _arg = arg;
+    pthread_t* thread = new pthread_t;
+    if (pthread_create(thread, NULL, &Thread::run, this) != 0)
+    {
+        fprintf(stderr, "Error: Failed to create thread.\n");
+        SAFE_DELETE(thread);
+        return false;
+    }
+    _handle = thread;
+    _running = true;
+    return true;
+}
+
+void Thread::join()
+{
+    if (_running)
+    {
+        pthread_t* thread = (pthread_t*)_handle;
+        pthread_join(*thread, NULL);
+        SAFE_DELETE(thread);
+        _handle = NULL;
+        _running = false;
+    }
+}
+
+unsigned int Thread::getProcessorCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned int)count : 1;
+}
+
+Mutex::Mutex()
+{
+    pthread_mutex_t* mutex = new pthread_mutex_t;
+    pthread_mutex_init(mutex, NULL);
+    _handle = mutex;
+}
+
+Mutex::~Mutex()
+{
+    pthread_mutex_t* mutex = (pthread_mutex_t*)_handle;
+    pthread_mutex_destroy(mutex);
+    SAFE_DELETE(mutex);
+}
+
+void Mutex::lock()
+{
+    pthread_mutex_lock((pthread_mutex_t*)_handle);
+}
+
+void Mutex::unlock()
+{
+    pthread_mutex_unlock((pthread_mutex_t*)_handle);
+}
+
+#endif
+
+}
@@ -0,0 +1,158 @@
+#ifndef THREAD_H_
+#define THREAD_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a native thread of execution, used by the encoder to process independent
+ * meshes, animations and files on all processors.
+ */
+class Thread
+{
+public:
+
+    /**
+     * The function run by a thread.
+     *
+     * @param arg The argument passed to Thread::start.
+     */
+    typedef void (*Function)(void* arg);
+
+    /**
+     * The function run by Thread::parallelFor for each index.
+     *
+     * @param index The index to process.
+     * @param arg The argument passed to Thread::parallelFor.
+     */
+    typedef void (*IndexFunction)(unsigned int index, void* arg);
+
+    /**
+     * Constructor.
+     */
+    Thread();
+
+    /**
+     * Destructor. Waits for the thread to finish if it is still running.
+     */
+    ~Thread();
+
+    /**
+     * Starts running the given function on a new thread.
+     *
+     * @param function The function to run.
+     * @param arg The argument to pass to the function.
+     *
+     * @return True if the thread was started; false if it could not be created
+     *      or this thread has already been started.
+     */
+    bool start(Function function, void* arg);
+
+    /**
+     * Waits for the thread to finish.
+     */
+    void join();
+
+    /**
+     * Gets the number of processors available to run threads on.
+     *
+     * @return The number of online processors, at least 1.
+     */
+    static unsigned int getProcessorCount();
+
+    /**
+     * Sets the number of threads that Thread::parallelFor may use.
+     *
+     * @param count The number of threads, or 0 to use one per processor.
+     */
+    static void setMaxThreadCount(unsigned int count);
+
+    /**
+     * Gets the number of threads that Thread::parallelFor may use.
+     *
+     * @return The number of threads, at least 1.
+     */
+    static unsigned int getMaxThreadCount();
+
+    /**
+     * Calls the given function once for each index from 0 to count - 1, spreading the
+     * calls over the threads and returning when all of them are done.
+     *
+     * The indices are handed out in order, but may complete in any order, so the function
+     * should only write to data owned by its index for the result to be deterministic.
+     *
+     * @param count The number of indices.
+     * @param function The function to call for each index.
+     * @param arg The argument to pass to the function.
+     */
+    static void parallelFor(unsigned int count, IndexFunction function, void* arg);
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    Thread(const Thread& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Thread& operator=(const Thread&);
+
+    void* _handle;
+    Function _function;
+    void* _arg;
+    bool _running;
+
+#ifdef WIN32
+    static unsigned long __stdcall run(void* thread);
+#else
+    static void* run(void* thread);
+#endif
+};
+
+/**
+ * Defines a lock that is held by one thread at a time.
+ */
+class Mutex
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    Mutex();
+
+    /**
+     * Destructor.
+     */
+    ~Mutex();
+
+    /**
+     * Waits until the lock is free and takes it.
+     */
+    void lock();
+
+    /**
+     * Frees the lock.
+     */
+    void unlock();
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    Mutex(const Mutex& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Mutex& operator=(const Mutex&);
+
+    void* _handle;
+};
+
+}
+
+#endif
@@ -13,6 +13,36 @@ Vertex::~Vertex(void)
 {
 }
 
+// Combines the bits of a float into an FNV-1a hash. Zero is hashed as +0 because -0 compares equal to it.
+static void hashFloat(float value, unsigned int* hash)
+{
+    unsigned int bits = 0;
+    if (value != 0.0f)
+    {
+        memcpy(&bits, &value, sizeof(bits));
+    }
+    for (unsigned int i = 0; i < sizeof(bits); ++i)
+    {
+        *hash = (*hash ^ ((bits >> (i * 8)) & 0xff)) * 16777619u;
+    }
+}
+
+unsigned int Vertex::hash() const
+{
+    // Hash the same components that operator== compares.
+    const float* components[] = { &position.x, &normal.x, &tangent.x, &binormal.x, &texCoord.x, &diffuse.x, &blendWeights.x, &blendIndices.x };
+    const unsigned int counts[] = { 3, 3, 3, 3, 2, 4, 4, 4 };
+    unsigned int hash = 2166136261u;
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+        for (unsigned int j = 0; j < counts[i]; ++j)
+        {
+            hashFloat(components[i][j], &hash);
+        }
+    }
+    return hash;
+}
+
 unsigned int Vertex::byteSize() const
 {
     unsigned int count = POSITION_COUNT;
@@ -87,6 +87,11 @@ public:
             diffuse==v.diffuse && blendWeights==v.blendWeights && blendIndices==v.blendIndices;
     }
 
+    /**
+     * Returns a hash of the components of this vertex, which is the same for vertices that are equal.
+     */
+    unsigned int hash() const;
+
     /**
      * Returns the size of this vertex in bytes.
      */
@@ -4,10 +4,85 @@
 namespace gameplay
 {
 
-VertexElement::VertexElement(unsigned int t, unsigned int c) :
+/**
+ * Converts a float to a half float, rounding to the nearest value.
+ */
+static unsigned short floatToHalf(float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    unsigned short sign = (unsigned short)((bits >> 16) & 0x8000);
+    int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+    unsigned int mantissa = bits & 0x7fffff;
+
+    if (exponent >= 31)
+    {
+        // Too large, infinity or NaN.
+        return sign | (((bits & 0x7fffffff) > 0x7f800000) ? 0x7e00 : 0x7c00);
+    }
+    if (exponent <= 0)
+    {
+        // Denormalized half or zero.
+        if (exponent < -10)
+        {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        unsigned int shift = (unsigned int)(14 - exponent);
+        unsigned int half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1)
+        {
+            ++half;
+        }
+        return sign | (unsigned short)half;
+    }
+    // Round the mantissa, which may carry into the exponent.
+    unsigned int half = ((unsigned int)exponent << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000)
+    {
+        ++half;
+    }
+    return sign | (unsigned short)std::min(half, 0x7c00u);
+}
+
+static float halfToFloat(unsigned short half)
+{
+    unsigned int sign = (unsigned int)(half & 0x8000) << 16;
+    unsigned int exponent = (half >> 10) & 0x1f;
+    unsigned int mantissa = half & 0x3ff;
+    float value;
+    if (exponent == 0)
+    {
+        value = ldexp((float)mantissa, -24);
+    }
+    else if (exponent == 31)
+    {
+        // Infinity and NaN unpack as the largest float, so they fail any error tolerance.
+        value = FLT_MAX;
+    }
+    else
+    {
+        value = ldexp((float)(mantissa | 0x400), (int)exponent - 25);
+    }
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits |= sign;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static int quantize(float value, float scale, int minValue, int maxValue)
+{
+    int i = (int)floor(value * scale + 0.5f);
+    return std::max(minValue, std::min(maxValue, i));
+}
+
+VertexElement::VertexElement(unsigned int t, unsigned int c, unsigned int dataType) :
     usage(t),
-    size(c)
+    size(c),
+    type(dataType)
 {
+    assert(type != TYPE_SNORM10_10_10_2 || size == 4);
 }
 
 VertexElement::~VertexElement(void)
@@ -23,15 +98,158 @@ void VertexElement::writeBinary(FILE* file)
     Object::writeBinary(file);
     write(usage, file);
     write(size, file);
+    write(type, file);
 }
 void VertexElement::writeText(FILE* file)
 {
     fprintElementStart(file);
     fprintfElement(file, "usage", usageStr(usage));
     fprintfElement(file, "size", size);
+    fprintfElement(file, "type", typeStr(type));
     fprintElementEnd(file);
 }
 
+unsigned int VertexElement::byteSize() const
+{
+    switch (type)
+    {
+        case TYPE_HALF_FLOAT:
+            return size * 2;
+        case TYPE_SNORM8:
+        case TYPE_UNORM8:
+        case TYPE_UINT8:
+            return size;
+        case TYPE_SNORM10_10_10_2:
+            return 4;
+        default:
+            return size * sizeof(float);
+    }
+}
+
+void VertexElement::pack(const float* values, unsigned char* data) const
+{
+    switch (type)
+    {
+        case TYPE_HALF_FLOAT:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                unsigned short half = floatToHalf(values[i]);
+                memcpy(data + i * 2, &half, sizeof(half));
+            }
+            break;
+        case TYPE_SNORM8:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                data[i] = (unsigned char)(signed char)quantize(values[i], 127.0f, -127, 127);
+            }
+            break;
+        case TYPE_UNORM8:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                data[i] = (unsigned char)quantize(values[i], 255.0f, 0, 255);
+            }
+            break;
+        case TYPE_UINT8:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                data[i] = (unsigned char)quantize(values[i], 1.0f, 0, 255);
+            }
+            break;
+        case TYPE_SNORM10_10_10_2:
+        {
+            unsigned int packed = 0;
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                packed |= ((unsigned int)quantize(values[i], 511.0f, -511, 511) & 0x3ff) << (i * 10);
+            }
+            packed |= ((unsigned int)quantize(values[3], 1.0f, -1, 1) & 0x3) << 30;
+            memcpy(data, &packed, sizeof(packed));
+            break;
+        }
+        default:
+            memcpy(data, values, size * sizeof(float));
+            break;
+    }
+}
+
+void VertexElement::unpack(const unsigned char* data, float* values) const
+{
+    switch (type)
+    {
+        case TYPE_HALF_FLOAT:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                unsigned short half;
+                memcpy(&half, data + i * 2, sizeof(half));
+                values[i] = halfToFloat(half);
+            }
+            break;
+        case TYPE_SNORM8:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                values[i] = std::max((float)(signed char)data[i] / 127.0f, -1.0f);
+            }
+            break;
+        case TYPE_UNORM8:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                values[i] = (float)data[i] / 255.0f;
+            }
+            break;
+        case TYPE_UINT8:
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                values[i] = (float)data[i];
+            }
+            break;
+        case TYPE_SNORM10_10_10_2:
+        {
+            unsigned int packed;
+            memcpy(&packed, data, sizeof(packed));
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                int value = (int)((packed >> (i * 10)) & 0x3ff);
+                if (value & 0x200)
+                {
+                    value -= 0x400;
+                }
+                values[i] = std::max((float)value / 511.0f, -1.0f);
+            }
+            int w = (int)(packed >> 30);
+            if (w & 0x2)
+            {
+                w -= 0x4;
+            }
+            values[3] = std::max((float)w, -1.0f);
+            break;
+        }
+        default:
+            memcpy(values, data, size * sizeof(float));
+            break;
+    }
+}
+
+const char* VertexElement::typeStr(unsigned int type)
+{
+    switch (type)
+    {
+        case TYPE_FLOAT:
+            return "FLOAT";
+        case TYPE_HALF_FLOAT:
+            return "HALF_FLOAT";
+        case TYPE_SNORM8:
+            return "SNORM8";
+        case TYPE_UNORM8:
+            return "UNORM8";
+        case TYPE_UINT8:
+            return "UINT8";
+        case TYPE_SNORM10_10_10_2:
+            return "SNORM10_10_10_2";
+        default:
+            return "";
+    }
+}
+
 const char* VertexElement::usageStr(unsigned int usage)
 {
     switch (usage)
@@ -13,7 +13,7 @@ public:
     /**
      * Constructor.
      */
-    VertexElement(unsigned int t, unsigned int c);
+    VertexElement(unsigned int t, unsigned int c, unsigned int dataType = TYPE_FLOAT);
 
     /**
      * Destructor.
@@ -24,10 +24,33 @@ public:
     virtual void writeBinary(FILE* file);
     virtual void writeText(FILE* file);
 
+    /**
+     * Returns the size of this element in bytes.
+     */
+    unsigned int byteSize() const;
+
+    /**
+     * Packs the components of this element into its data type.
+     *
+     * @param values The size components to pack.
+     * @param data Returns the byteSize() bytes of packed data.
+     */
+    void pack(const float* values, unsigned char* data) const;
+
+    /**
+     * Unpacks the components of this element from its data type, the inverse of pack().
+     *
+     * @param data The byteSize() bytes of packed data.
+     * @param values Returns the size components.
+     */
+    void unpack(const unsigned char* data, float* values) const;
+
     static const char* usageStr(unsigned int usage);
+    static const char* typeStr(unsigned int type);
 
     unsigned int usage;
     unsigned int size;
+    unsigned int type;
 };
 
 }
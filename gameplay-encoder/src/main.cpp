@@ -4,6 +4,8 @@
 #include "TTFFontEncoder.h"
 #include "GPBDecoder.h"
 #include "EncoderArguments.h"
+#include "BatchEncoder.h"
+#include "Thread.h"
 
 using namespace gameplay;
 
@@ -60,6 +62,16 @@ int main(int argc, const char** argv)
         return -1;
     }
 
+    if (arguments.batchEnabled())
+    {
+        // The threads of a batch encode its assets; each asset is built with the threads of -j.
+        Thread::setMaxThreadCount(arguments.getJobCount());
+        BatchEncoder batchEncoder(argv[0], arguments);
+        return batchEncoder.encode() == 0 ? 0 : -1;
+    }
+
+    Thread::setMaxThreadCount(arguments.getThreadCount());
+
     // File exists
     fprintf(stderr, "Encoding file: %s\n", arguments.getFilePathPointer());
 
@@ -28,6 +28,7 @@ LOCAL_SRC_FILES := \
     AnimationController.cpp \
     AnimationTarget.cpp \
     AnimationValue.cpp \
+    Atomic.cpp \
     AudioBuffer.cpp \
     AudioController.cpp \
     AudioListener.cpp \
@@ -48,25 +49,33 @@ LOCAL_SRC_FILES := \
     FlowLayout.cpp \
     Font.cpp \
     Form.cpp \
+    FrameArena.cpp \
     FrameBuffer.cpp \
+    FrameGovernor.cpp \
     Frustum.cpp \
     Game.cpp \
     Gamepad.cpp \
     gameplay-main-android.cpp \
+    GLCapture.cpp \
     Image.cpp \
+    InputRecorder.cpp \
     Joint.cpp \
     Joystick.cpp \
     Label.cpp \
     Layout.cpp \
     Light.cpp \
+    LoadTrace.cpp \
     Material.cpp \
     MaterialParameter.cpp \
     Matrix.cpp \
+    MemoryStats.cpp \
+    MemoryTracker.cpp \
     Mesh.cpp \
     MeshBatch.cpp \
     MeshPart.cpp \
     MeshSkin.cpp \
     Model.cpp \
+    Mutex.cpp \
     Node.cpp \
     ParticleEmitter.cpp \
     Pass.cpp \
@@ -91,19 +100,26 @@ LOCAL_SRC_FILES := \
     Rectangle.cpp \
     Ref.cpp \
     RenderState.cpp \
+    RenderStats.cpp \
     RenderTarget.cpp \
+    RenderTargetPool.cpp \
     Scene.cpp \
     SceneLoader.cpp \
+    SceneStreamer.cpp \
     ScreenDisplayer.cpp \
     ScriptController.cpp \
     ScriptTarget.cpp \
+    Semaphore.cpp \
     Slider.cpp \
+    SpinLock.cpp \
     SpriteBatch.cpp \
     Technique.cpp \
     TextBox.cpp \
     Texture.cpp \
     Theme.cpp \
     ThemeStyle.cpp \
+    Thread.cpp \
+    TimerWheel.cpp \
     Transform.cpp \
     Vector2.cpp \
     Vector3.cpp \
@@ -160,9 +176,12 @@ LOCAL_SRC_FILES := \
     lua/lua_FontText.cpp \
     lua/lua_Form.cpp \
     lua/lua_FrameBuffer.cpp \
+    lua/lua_FrameGovernor.cpp \
+    lua/lua_FrameGovernorSubsystem.cpp \
     lua/lua_Frustum.cpp \
     lua/lua_Game.cpp \
     lua/lua_GameClearFlags.cpp \
+    lua/lua_GameFramePhase.cpp \
     lua/lua_Gamepad.cpp \
     lua/lua_GamepadButtonState.cpp \
     lua/lua_GamepadGamepadEvent.cpp \
@@ -235,6 +254,8 @@ LOCAL_SRC_FILES := \
     lua/lua_RenderStateAutoBinding.cpp \
     lua/lua_RenderStateBlend.cpp \
     lua/lua_RenderStateStateBlock.cpp \
+    lua/lua_RenderStats.cpp \
+    lua/lua_RenderStatsCounter.cpp \
     lua/lua_RenderTarget.cpp \
     lua/lua_Scene.cpp \
     lua/lua_SceneDebugFlags.cpp \
@@ -266,6 +287,7 @@ LOCAL_SRC_FILES := \
     lua/lua_VertexAttributeBinding.cpp \
     lua/lua_VertexFormat.cpp \
     lua/lua_VertexFormatElement.cpp \
+    lua/lua_VertexFormatType.cpp \
     lua/lua_VertexFormatUsage.cpp \
     lua/lua_VerticalLayout.cpp
 
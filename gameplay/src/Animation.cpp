@@ -6,6 +6,7 @@
 #include "Game.h"
 #include "Transform.h"
 #include "Properties.h"
+#include "MemoryStats.h"
 
 #define ANIMATION_INDEFINITE_STR "INDEFINITE"
 #define ANIMATION_DEFAULT_CLIP 0
@@ -101,6 +102,9 @@ Animation::Channel::Channel(const Channel& copy, Animation* animation, Animation
 
 Animation::Channel::~Channel()
 {
+    // Curves are shared by the channels of cloned animations, so the last one out untracks it.
+    if (_curve && _curve->getRefCount() == 1)
+        MemoryStats::untrack(_curve);
     SAFE_RELEASE(_curve);
     SAFE_RELEASE(_animation);
 }
@@ -346,6 +350,8 @@ Animation::Channel* Animation::createChannel(AnimationTarget* target, int proper
 
     SAFE_DELETE(normalizedKeyTimes);
 
+    MemoryStats::track(curve, MemoryStats::ANIMATION, keyCount * (sizeof(Curve::Point) + 3 * curve->_componentSize), 0);
+
     Channel* channel = new Channel(this, target, propertyId, curve, duration);
     curve->release();
     addChannel(channel);
@@ -388,6 +394,8 @@ Animation::Channel* Animation::createChannel(AnimationTarget* target, int proper
 
     SAFE_DELETE(normalizedKeyTimes);
 
+    MemoryStats::track(curve, MemoryStats::ANIMATION, keyCount * (sizeof(Curve::Point) + 3 * curve->_componentSize), 0);
+
     Channel* channel = new Channel(this, target, propertyId, curve, duration);
     curve->release();
     addChannel(channel);
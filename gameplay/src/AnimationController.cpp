@@ -95,6 +95,7 @@ void AnimationController::unschedule(AnimationClip* clip)
 
 void AnimationController::update(float elapsedTime)
 {
+    GP_MEMORY_TAG(ANIMATION);
     if (_state != RUNNING)
         return;
 
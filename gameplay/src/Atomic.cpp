@@ -0,0 +1,82 @@
+#include "Base.h"
+#include "Atomic.h"
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+namespace gameplay
+{
+
+#ifdef WIN32
+
+int Atomic::increment(volatile int* value)
+{
+    return (int)InterlockedIncrement((volatile LONG*)value);
+}
+
+int Atomic::decrement(volatile int* value)
+{
+    return (int)InterlockedDecrement((volatile LONG*)value);
+}
+
+int Atomic::add(volatile int* value, int amount)
+{
+    return (int)InterlockedExchangeAdd((volatile LONG*)value, (LONG)amount) + amount;
+}
+
+bool Atomic::compareAndSwap(volatile int* value, int expected, int desired)
+{
+    return InterlockedCompareExchange((volatile LONG*)value, (LONG)desired, (LONG)expected) == (LONG)expected;
+}
+
+int Atomic::load(const volatile int* value)
+{
+    return (int)InterlockedCompareExchange((volatile LONG*)value, 0, 0);
+}
+
+void Atomic::store(volatile int* value, int newValue)
+{
+    InterlockedExchange((volatile LONG*)value, (LONG)newValue);
+}
+
+#else
+
+int Atomic::increment(volatile int* value)
+{
+    return __sync_add_and_fetch(value, 1);
+}
+
+int Atomic::decrement(volatile int* value)
+{
+    return __sync_sub_and_fetch(value, 1);
+}
+
+int Atomic::add(volatile int* value, int amount)
+{
+    return __sync_add_and_fetch(value, amount);
+}
+
+bool Atomic::compareAndSwap(volatile int* value, int expected, int desired)
+{
+    return __sync_bool_compare_and_swap(value, expected, desired);
+}
+
+int Atomic::load(const volatile int* value)
+{
+    __sync_synchronize();
+    int result = *value;
+    __sync_synchronize();
+    return result;
+}
+
+void Atomic::store(volatile int* value, int newValue)
+{
+    __sync_synchronize();
+    *value = newValue;
+    __sync_synchronize();
+}
+
+#endif
+
+}
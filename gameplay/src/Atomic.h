@@ -0,0 +1,84 @@
+#ifndef ATOMIC_H_
+#define ATOMIC_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines atomic operations on integers that are shared between threads.
+ *
+ * All operations are sequentially consistent: they act as full memory barriers.
+ *
+ * @script{ignore}
+ */
+class Atomic
+{
+public:
+
+    /**
+     * Atomically increments a value.
+     *
+     * @param value The value to increment.
+     *
+     * @return The incremented value.
+     */
+    static int increment(volatile int* value);
+
+    /**
+     * Atomically decrements a value.
+     *
+     * @param value The value to decrement.
+     *
+     * @return The decremented value.
+     */
+    static int decrement(volatile int* value);
+
+    /**
+     * Atomically adds an amount to a value.
+     *
+     * @param value The value to add to.
+     * @param amount The amount to add, which may be negative.
+     *
+     * @return The value after the addition.
+     */
+    static int add(volatile int* value, int amount);
+
+    /**
+     * Atomically replaces a value with another if it is equal to an expected value.
+     *
+     * @param value The value to replace.
+     * @param expected The value expected.
+     * @param desired The value to replace it with.
+     *
+     * @return true if the value was equal to the expected value and was replaced.
+     */
+    static bool compareAndSwap(volatile int* value, int expected, int desired);
+
+    /**
+     * Reads a value written by another thread.
+     *
+     * @param value The value to read.
+     *
+     * @return The value.
+     */
+    static int load(const volatile int* value);
+
+    /**
+     * Writes a value to be read by another thread.
+     *
+     * @param value The value to write to.
+     * @param newValue The value to write.
+     */
+    static void store(volatile int* value, int newValue);
+
+private:
+
+    /**
+     * Hidden constructor.
+     */
+    Atomic();
+};
+
+}
+
+#endif
@@ -1,12 +1,16 @@
 #include "Base.h"
 #include "AudioBuffer.h"
 #include "FileSystem.h"
+#include "SpinLock.h"
+#include "MemoryStats.h"
+#include "LoadTrace.h"
 
 namespace gameplay
 {
 
 // Audio buffer cache
 static std::vector<AudioBuffer*> __buffers;
+static SpinLock __buffersLock;
 
 AudioBuffer::AudioBuffer(const char* path, ALuint buffer)
     : _filePath(path), _alBuffer(buffer)
@@ -16,6 +20,7 @@ AudioBuffer::AudioBuffer(const char* path, ALuint buffer)
 AudioBuffer::~AudioBuffer()
 {
     // Remove the buffer from the cache.
+    __buffersLock.lock();
     unsigned int bufferCount = (unsigned int)__buffers.size();
     for (unsigned int i = 0; i < bufferCount; i++)
     {
@@ -25,33 +30,41 @@ AudioBuffer::~AudioBuffer()
             break;
         }
     }
+    __buffersLock.unlock();
 
     if (_alBuffer)
     {
         AL_CHECK( alDeleteBuffers(1, &_alBuffer) );
         _alBuffer = 0;
     }
+    MemoryStats::untrack(this);
 }
 
 AudioBuffer* AudioBuffer::create(const char* path)
 {
+    GP_MEMORY_TAG(ASSETS);
     GP_ASSERT(path);
+    LoadTrace::Asset trace("audio", path);
 
-    // Search the cache for a stream from this file.
-    unsigned int bufferCount = (unsigned int)__buffers.size();
+    // Search the cache for a stream from this file, skipping buffers that are being destroyed by another thread.
     AudioBuffer* buffer = NULL;
-    for (unsigned int i = 0; i < bufferCount; i++)
     {
-        buffer = __buffers[i];
-        GP_ASSERT(buffer);
-        if (buffer->_filePath.compare(path) == 0)
+        SpinLock::ScopedLock lock(__buffersLock);
+        unsigned int bufferCount = (unsigned int)__buffers.size();
+        for (unsigned int i = 0; i < bufferCount; i++)
         {
-            buffer->addRef();
-            return buffer;
+            buffer = __buffers[i];
+            GP_ASSERT(buffer);
+            if (buffer->_filePath.compare(path) == 0 && buffer->tryAddRef())
+            {
+                trace.setCacheHit();
+                return buffer;
+            }
         }
     }
 
     ALuint alBuffer;
+    ALint bufferSize = 0;
 
     // Load audio data into a buffer.
     AL_CHECK( alGenBuffers(1, &alBuffer) );
@@ -81,6 +94,7 @@ AudioBuffer* AudioBuffer::create(const char* path)
     // Check the file format
     if (memcmp(header, "RIFF", 4) == 0)
     {
+        LoadTrace::PhaseScope phase(LoadTrace::IO);
         if (!AudioBuffer::loadWav(file, alBuffer))
         {
             GP_ERROR("Invalid wave file: %s", path);
@@ -89,6 +103,7 @@ AudioBuffer* AudioBuffer::create(const char* path)
     }
     else if (memcmp(header, "OggS", 4) == 0)
     {
+        LoadTrace::PhaseScope phase(LoadTrace::DECODE);
         if (!AudioBuffer::loadOgg(file, alBuffer))
         {
             GP_ERROR("Invalid ogg file: %s", path);
@@ -105,8 +120,14 @@ AudioBuffer* AudioBuffer::create(const char* path)
 
     buffer = new AudioBuffer(path, alBuffer);
 
+    // The samples are owned by OpenAL, which may keep them in system or audio device memory.
+    AL_CHECK( alGetBufferi(alBuffer, AL_SIZE, &bufferSize) );
+    MemoryStats::track(buffer, MemoryStats::AUDIO, (unsigned int)bufferSize, 0);
+
     // Add the buffer to the cache.
+    __buffersLock.lock();
     __buffers.push_back(buffer);
+    __buffersLock.unlock();
 
     return buffer;
     
@@ -257,7 +278,10 @@ bool AudioBuffer::loadWav(FILE* file, ALuint buffer)
                 return false;
             }
 
-            AL_CHECK( alBufferData(buffer, format, data, dataSize, frequency) );
+            {
+                LoadTrace::PhaseScope phase(LoadTrace::UPLOAD);
+                AL_CHECK( alBufferData(buffer, format, data, dataSize, frequency) );
+            }
             SAFE_DELETE_ARRAY(data);
 
             // We've read the data, so return now.
@@ -360,7 +384,10 @@ bool AudioBuffer::loadOgg(FILE* file, ALuint buffer)
         return false;
     }
 
-    AL_CHECK( alBufferData(buffer, format, data, data_size, info->rate) );
+    {
+        LoadTrace::PhaseScope phase(LoadTrace::UPLOAD);
+        AL_CHECK( alBufferData(buffer, format, data, data_size, info->rate) );
+    }
 
     SAFE_DELETE_ARRAY(data);
     ov_clear(&ogg_file);
@@ -6,6 +6,7 @@
 #include <memory>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <cassert>
 #include <cwchar>
 #include <cwctype>
@@ -97,6 +98,9 @@ extern void printError(const char* format, ...);
 // Debug new for memory leak detection
 #include "DebugNew.h"
 
+// Per-subsystem allocation tracking
+#include "MemoryTracker.h"
+
 // Object deletion macro
 #define SAFE_DELETE(x) \
     { \
@@ -119,6 +123,13 @@ extern void printError(const char* format, ...);
         x = NULL; \
     }
 
+// Thread-local storage for static variables of plain types
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 // Math
 #define MATH_DEG_TO_RAD(x)          ((x) * 0.0174532925f)
 #define MATH_RAD_TO_DEG(x)          ((x)* 57.29577951f)
@@ -161,6 +172,9 @@ extern void printError(const char* format, ...);
 #elif __APPLE__
 #include <OpenAL/al.h>
 #include <OpenAL/alc.h>
+#elif __linux__
+#include <AL/al.h>
+#include <AL/alc.h>
 #endif
 #include <vorbis/vorbisfile.h>
 
@@ -231,6 +245,29 @@ using std::va_list;
     #else
         #error "Unsupported Apple Device"
     #endif
+#elif __linux__
+    // Linux only has the headless platform, whose null renderer needs the GL prototypes but no context.
+    #define GL_GLEXT_PROTOTYPES
+    #include <GL/gl.h>
+    #include <GL/glext.h>
+    #define USE_VAO
+#endif
+
+// Graphics (vertex attribute types that not every GL header defines)
+#ifndef GL_HALF_FLOAT
+    #ifdef GL_HALF_FLOAT_OES
+        #define GL_HALF_FLOAT GL_HALF_FLOAT_OES
+    #else
+        #define GL_HALF_FLOAT 0x140B
+    #endif
+#endif
+#ifndef GL_INT_2_10_10_10_REV
+    #define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
+
+// Graphics (GL capture)
+#ifdef GP_USE_GL_CAPTURE
+    #include "GLCapture.h"
 #endif
 
 // Graphics (GLSL)
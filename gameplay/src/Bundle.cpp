@@ -4,9 +4,13 @@
 #include "MeshPart.h"
 #include "Scene.h"
 #include "Joint.h"
+#include "SpinLock.h"
+#include "MemoryStats.h"
+#include "LoadTrace.h"
 
 #define BUNDLE_VERSION_MAJOR            1
-#define BUNDLE_VERSION_MINOR            2
+#define BUNDLE_VERSION_MINOR            5
+#define BUNDLE_VERSION_MINOR_OLDEST     2
 
 #define BUNDLE_TYPE_SCENE               1
 #define BUNDLE_TYPE_NODE                2
@@ -30,10 +34,13 @@ namespace gameplay
 {
 
 static std::vector<Bundle*> __bundleCache;
+static SpinLock __bundleCacheLock;
 
 Bundle::Bundle(const char* path) :
     _path(path), _referenceCount(0), _references(NULL), _file(NULL), _trackedNodes(NULL)
 {
+    _version[0] = BUNDLE_VERSION_MAJOR;
+    _version[1] = BUNDLE_VERSION_MINOR;
 }
 
 Bundle::~Bundle()
@@ -41,11 +48,13 @@ Bundle::~Bundle()
     clearLoadSession();
 
     // Remove this Bundle from the cache.
+    __bundleCacheLock.lock();
     std::vector<Bundle*>::iterator itr = std::find(__bundleCache.begin(), __bundleCache.end(), this);
     if (itr != __bundleCache.end())
     {
         __bundleCache.erase(itr);
     }
+    __bundleCacheLock.unlock();
 
     SAFE_DELETE_ARRAY(_references);
 
@@ -157,21 +166,29 @@ static std::string readString(FILE* fp)
 
 Bundle* Bundle::create(const char* path)
 {
+    GP_MEMORY_TAG(ASSETS);
     GP_ASSERT(path);
+    LoadTrace::Asset trace("bundle", path);
 
-    // Search the cache for this bundle.
-    for (unsigned int i = 0, count = __bundleCache.size(); i < count; ++i)
+    // Search the cache for this bundle, skipping bundles that are being destroyed by another thread.
     {
-        Bundle* p = __bundleCache[i];
-        GP_ASSERT(p);
-        if (p->_path == path)
+        SpinLock::ScopedLock lock(__bundleCacheLock);
+        for (unsigned int i = 0, count = __bundleCache.size(); i < count; ++i)
         {
-            // Found a match
-            p->addRef();
-            return p;
+            Bundle* p = __bundleCache[i];
+            GP_ASSERT(p);
+            if (p->_path == path && p->tryAddRef())
+            {
+                // Found a match
+                trace.setCacheHit();
+                return p;
+            }
         }
     }
 
+    // The header and reference table are read up front; objects are read as they are loaded.
+    LoadTrace::PhaseScope phase(LoadTrace::IO);
+
     // Open the bundle.
     FILE* fp = FileSystem::openFile(path, "rb");
     if (!fp)
@@ -203,9 +220,10 @@ Bundle* Bundle::create(const char* path)
         }
         return NULL;
     }
-    if (ver[0] != BUNDLE_VERSION_MAJOR || ver[1] != BUNDLE_VERSION_MINOR)
+    if (ver[0] != BUNDLE_VERSION_MAJOR || ver[1] < BUNDLE_VERSION_MINOR_OLDEST || ver[1] > BUNDLE_VERSION_MINOR)
     {
-        GP_ERROR("Unsupported version (%d.%d) for bundle '%s' (expected %d.%d).", (int)ver[0], (int)ver[1], path, BUNDLE_VERSION_MAJOR, BUNDLE_VERSION_MINOR);
+        GP_ERROR("Unsupported version (%d.%d) for bundle '%s' (expected %d.%d to %d.%d).", (int)ver[0], (int)ver[1], path,
+            BUNDLE_VERSION_MAJOR, BUNDLE_VERSION_MINOR_OLDEST, BUNDLE_VERSION_MAJOR, BUNDLE_VERSION_MINOR);
         if (fclose(fp) != 0)
         {
             GP_ERROR("Failed to close file '%s'.", path);
@@ -245,6 +263,8 @@ Bundle* Bundle::create(const char* path)
 
     // Keep file open for faster reading later.
     Bundle* bundle = new Bundle(path);
+    bundle->_version[0] = ver[0];
+    bundle->_version[1] = ver[1];
     bundle->_referenceCount = refCount;
     bundle->_references = refs;
     bundle->_file = fp;
@@ -372,6 +392,10 @@ bool Bundle::readMatrix(float* m)
 
 Scene* Bundle::loadScene(const char* id)
 {
+    GP_MEMORY_TAG(ASSETS);
+    MemoryStats::Source memorySource(MemoryStats::BUNDLE, _path.c_str());
+    LoadTrace::Asset trace("scene", _path.c_str(), id);
+    LoadTrace::PhaseScope phase(LoadTrace::PARSE);
     clearLoadSession();
 
     Reference* ref = NULL;
@@ -481,8 +505,12 @@ Node* Bundle::loadNode(const char* id)
 
 Node* Bundle::loadNode(const char* id, Scene* sceneContext)
 {
+    GP_MEMORY_TAG(ASSETS);
+    MemoryStats::Source memorySource(MemoryStats::BUNDLE, _path.c_str());
     GP_ASSERT(id);
     GP_ASSERT(_references);
+    LoadTrace::Asset trace("node", _path.c_str(), id);
+    LoadTrace::PhaseScope phase(LoadTrace::PARSE);
     GP_ASSERT(_file);
 
     clearLoadSession();
@@ -1064,6 +1092,42 @@ MeshSkin* Bundle::readMeshSkin()
         }
     }
 
+    // Bundles before version 1.5 have no joint palettes for the mesh parts.
+    if (_version[1] >= 5)
+    {
+        unsigned int partCount;
+        if (!read(&partCount))
+        {
+            GP_ERROR("Failed to load mesh part count for mesh skin in bundle '%s'.", _path.c_str());
+            SAFE_DELETE(meshSkin);
+            SAFE_DELETE(skinData);
+            return NULL;
+        }
+        std::vector<std::vector<unsigned int> > partJoints(partCount);
+        for (unsigned int i = 0; i < partCount; ++i)
+        {
+            unsigned int partJointCount;
+            if (!readArray(&partJointCount, &partJoints[i]))
+            {
+                GP_ERROR("Failed to load joints of mesh part with index %d for mesh skin in bundle '%s'.", i, _path.c_str());
+                SAFE_DELETE(meshSkin);
+                SAFE_DELETE(skinData);
+                return NULL;
+            }
+            for (unsigned int j = 0; j < partJointCount; ++j)
+            {
+                if (partJoints[i][j] >= jointCount)
+                {
+                    GP_ERROR("Invalid joint index (%d) in mesh part with index %d for mesh skin in bundle '%s'.", partJoints[i][j], i, _path.c_str());
+                    SAFE_DELETE(meshSkin);
+                    SAFE_DELETE(skinData);
+                    return NULL;
+                }
+            }
+        }
+        meshSkin->setPartJoints(partJoints);
+    }
+
     // Store the MeshSkinData so we can go back and resolve all joint references later.
     _meshSkins.push_back(skinData);
 
@@ -1333,8 +1397,11 @@ Mesh* Bundle::loadMesh(const char* id)
 
 Mesh* Bundle::loadMesh(const char* id, const char* nodeId)
 {
+    GP_MEMORY_TAG(ASSETS);
+    MemoryStats::Source memorySource(MemoryStats::BUNDLE, _path.c_str());
     GP_ASSERT(_file);
     GP_ASSERT(id);
+    LoadTrace::Asset trace("mesh", _path.c_str(), id);
 
     // Save the file position.
     long position = ftell(_file);
@@ -1353,14 +1420,20 @@ Mesh* Bundle::loadMesh(const char* id, const char* nodeId)
     }
 
     // Read mesh data.
-    MeshData* meshData = readMeshData();
+    MeshData* meshData;
+    {
+        LoadTrace::PhaseScope phase(LoadTrace::IO);
+        meshData = readMeshData();
+    }
     if (meshData == NULL)
     {
         GP_ERROR("Failed to load mesh data for mesh '%s'.", id);
         return NULL;
     }
+    convertUnsupportedVertexData(meshData);
 
     // Create mesh.
+    LoadTrace::PhaseScope phase(LoadTrace::UPLOAD);
     Mesh* mesh = Mesh::createMesh(meshData->vertexFormat, meshData->vertexCount, false);
     if (mesh == NULL)
     {
@@ -1394,6 +1467,27 @@ Mesh* Bundle::loadMesh(const char* id, const char* nodeId)
         part->setIndexData(partData->indexData, 0, partData->indexCount);
     }
 
+    // Create the index data of each level of detail for each part.
+    unsigned int partCount = (unsigned int)meshData->parts.size();
+    for (unsigned int lod = 0; lod < meshData->lodErrors.size(); ++lod)
+    {
+        mesh->addLod(meshData->lodErrors[lod]);
+        for (unsigned int i = 0; i < partCount; ++i)
+        {
+            MeshPartData* partData = meshData->lodParts[lod * partCount + i];
+            GP_ASSERT(partData);
+
+            MeshPart* part = mesh->addLodPart(i, partData->indexFormat, partData->indexCount);
+            if (part == NULL)
+            {
+                GP_ERROR("Failed to create level of detail %d of mesh part (with index %d) for mesh '%s'.", lod + 1, i, id);
+                SAFE_DELETE(meshData);
+                return NULL;
+            }
+            part->setIndexData(partData->indexData, 0, partData->indexCount);
+        }
+    }
+
     SAFE_DELETE(meshData);
 
     // Restore file pointer.
@@ -1438,8 +1532,24 @@ Bundle::MeshData* Bundle::readMeshData()
             return NULL;
         }
 
+        // Bundles before version 1.3 only store floats.
+        unsigned int vType = VertexFormat::FLOAT;
+        if (_version[1] >= 3 && fread(&vType, 4, 1, _file) != 1)
+        {
+            GP_ERROR("Failed to load vertex type.");
+            SAFE_DELETE_ARRAY(vertexElements);
+            return NULL;
+        }
+        if (vType > VertexFormat::SNORM10_10_10_2 || (vType == VertexFormat::SNORM10_10_10_2 && vSize != 4))
+        {
+            GP_ERROR("Invalid vertex type (%d) with size %d.", vType, vSize);
+            SAFE_DELETE_ARRAY(vertexElements);
+            return NULL;
+        }
+
         vertexElements[i].usage = (VertexFormat::Usage)vUsage;
         vertexElements[i].size = vSize;
+        vertexElements[i].type = (VertexFormat::Type)vType;
     }
 
     MeshData* meshData = new MeshData(VertexFormat(vertexElements, vertexElementCount));
@@ -1494,63 +1604,169 @@ Bundle::MeshData* Bundle::readMeshData()
     }
     for (unsigned int i = 0; i < meshPartCount; ++i)
     {
-        // Read primitive type, index format and index count.
-        unsigned int pType, iFormat, iByteCount;
-        if (fread(&pType, 4, 1, _file) != 1)
+        MeshPartData* partData = readMeshPartData(i);
+        if (partData == NULL)
         {
-            GP_ERROR("Failed to load primitive type for mesh part with index %d.", i);
             SAFE_DELETE(meshData);
             return NULL;
         }
-        if (fread(&iFormat, 4, 1, _file) != 1)
+        meshData->parts.push_back(partData);
+    }
+
+    // Bundles before version 1.4 have no levels of detail.
+    if (_version[1] >= 4)
+    {
+        unsigned int lodCount;
+        if (fread(&lodCount, 4, 1, _file) != 1)
         {
-            GP_ERROR("Failed to load index format for mesh part with index %d.", i);
+            GP_ERROR("Failed to load level of detail count.");
             SAFE_DELETE(meshData);
             return NULL;
         }
-        if (fread(&iByteCount, 4, 1, _file) != 1)
+        for (unsigned int lod = 0; lod < lodCount; ++lod)
         {
-            GP_ERROR("Failed to load index byte count for mesh part with index %d.", i);
-            SAFE_DELETE(meshData);
-            return NULL;
+            float error;
+            unsigned int lodPartCount;
+            if (fread(&error, 4, 1, _file) != 1 || fread(&lodPartCount, 4, 1, _file) != 1)
+            {
+                GP_ERROR("Failed to load level of detail %d.", lod + 1);
+                SAFE_DELETE(meshData);
+                return NULL;
+            }
+            if (lodPartCount != meshPartCount)
+            {
+                GP_ERROR("Invalid part count (%d) for level of detail %d (expected %d).", lodPartCount, lod + 1, meshPartCount);
+                SAFE_DELETE(meshData);
+                return NULL;
+            }
+            meshData->lodErrors.push_back(error);
+            for (unsigned int i = 0; i < lodPartCount; ++i)
+            {
+                MeshPartData* partData = readMeshPartData(i);
+                if (partData == NULL)
+                {
+                    SAFE_DELETE(meshData);
+                    return NULL;
+                }
+                meshData->lodParts.push_back(partData);
+            }
         }
+    }
 
-        MeshPartData* partData = new MeshPartData();
-        meshData->parts.push_back(partData);
+    return meshData;
+}
+
+Bundle::MeshPartData* Bundle::readMeshPartData(unsigned int partIndex)
+{
+    // Read primitive type, index format and index count.
+    unsigned int pType, iFormat, iByteCount;
+    if (fread(&pType, 4, 1, _file) != 1)
+    {
+        GP_ERROR("Failed to load primitive type for mesh part with index %d.", partIndex);
+        return NULL;
+    }
+    if (fread(&iFormat, 4, 1, _file) != 1)
+    {
+        GP_ERROR("Failed to load index format for mesh part with index %d.", partIndex);
+        return NULL;
+    }
+    if (fread(&iByteCount, 4, 1, _file) != 1)
+    {
+        GP_ERROR("Failed to load index byte count for mesh part with index %d.", partIndex);
+        return NULL;
+    }
+
+    MeshPartData* partData = new MeshPartData();
+    partData->primitiveType = (Mesh::PrimitiveType)pType;
+    partData->indexFormat = (Mesh::IndexFormat)iFormat;
+
+    unsigned int indexSize = 0;
+    switch (partData->indexFormat)
+    {
+    case Mesh::INDEX8:
+        indexSize = 1;
+        break;
+    case Mesh::INDEX16:
+        indexSize = 2;
+        break;
+    case Mesh::INDEX32:
+        indexSize = 4;
+        break;
+    default:
+        GP_ERROR("Unsupported index format for mesh part with index %d.", partIndex);
+        SAFE_DELETE(partData);
+        return NULL;
+    }
+
+    GP_ASSERT(indexSize);
+    partData->indexCount = iByteCount / indexSize;
 
-        partData->primitiveType = (Mesh::PrimitiveType)pType;
-        partData->indexFormat = (Mesh::IndexFormat)iFormat;
-        
-        unsigned int indexSize = 0;
-        switch (partData->indexFormat)
+    partData->indexData = new unsigned char[iByteCount];
+    if (fread(partData->indexData, 1, iByteCount, _file) != iByteCount)
+    {
+        GP_ERROR("Failed to read index data for mesh part with index %d.", partIndex);
+        SAFE_DELETE(partData);
+        return NULL;
+    }
+
+    return partData;
+}
+
+void Bundle::convertUnsupportedVertexData(MeshData* meshData)
+{
+    GP_ASSERT(meshData);
+
+    const VertexFormat& format = meshData->vertexFormat;
+    unsigned int elementCount = format.getElementCount();
+    bool supported = true;
+    for (unsigned int i = 0; i < elementCount && supported; ++i)
+    {
+        supported = VertexFormat::isTypeSupported(format.getElement(i).type);
+    }
+    if (supported)
+        return;
+
+    // Expand the unsupported elements to floats, keeping the others as they are.
+    std::vector<VertexFormat::Element> elements(elementCount);
+    for (unsigned int i = 0; i < elementCount; ++i)
+    {
+        elements[i] = format.getElement(i);
+        if (!VertexFormat::isTypeSupported(elements[i].type))
         {
-        case Mesh::INDEX8:
-            indexSize = 1;
-            break;
-        case Mesh::INDEX16:
-            indexSize = 2;
-            break;
-        case Mesh::INDEX32:
-            indexSize = 4;
-            break;
-        default:
-            GP_ERROR("Unsupported index format for mesh part with index %d.", i);
-            return NULL;
+            elements[i].type = VertexFormat::FLOAT;
         }
+    }
+    VertexFormat newFormat(&elements[0], elementCount);
 
-        GP_ASSERT(indexSize);
-        partData->indexCount = iByteCount / indexSize;
-
-        partData->indexData = new unsigned char[iByteCount];
-        if (fread(partData->indexData, 1, iByteCount, _file) != iByteCount)
+    unsigned int oldSize = format.getVertexSize();
+    unsigned int newSize = newFormat.getVertexSize();
+    unsigned char* vertexData = new unsigned char[newSize * meshData->vertexCount];
+    float values[4];
+    for (unsigned int v = 0; v < meshData->vertexCount; ++v)
+    {
+        const unsigned char* source = meshData->vertexData + v * oldSize;
+        unsigned char* destination = vertexData + v * newSize;
+        for (unsigned int i = 0; i < elementCount; ++i)
         {
-            GP_ERROR("Failed to read index data for mesh part with index %d.", i);
-            SAFE_DELETE(meshData);
-            return NULL;
+            const VertexFormat::Element& element = format.getElement(i);
+            if (element.type == elements[i].type)
+            {
+                memcpy(destination, source, element.getByteSize());
+            }
+            else
+            {
+                GP_ASSERT(element.size <= 4);
+                VertexFormat::unpack(element, source, values);
+                memcpy(destination, values, element.size * sizeof(float));
+            }
+            source += element.getByteSize();
+            destination += elements[i].getByteSize();
         }
     }
 
-    return meshData;
+    SAFE_DELETE_ARRAY(meshData->vertexData);
+    meshData->vertexData = vertexData;
+    meshData->vertexFormat = newFormat;
 }
 
 Bundle::MeshData* Bundle::readMeshData(const char* url)
@@ -1602,8 +1818,12 @@ Bundle::MeshData* Bundle::readMeshData(const char* url)
 
 Font* Bundle::loadFont(const char* id)
 {
+    GP_MEMORY_TAG(ASSETS);
+    MemoryStats::Source memorySource(MemoryStats::BUNDLE, _path.c_str());
     GP_ASSERT(id);
     GP_ASSERT(_file);
+    LoadTrace::Asset trace("font", _path.c_str(), id);
+    LoadTrace::PhaseScope phase(LoadTrace::IO);
 
     // Seek to the specified font.
     Reference* ref = seekTo(id, BUNDLE_TYPE_FONT);
@@ -1788,6 +2008,10 @@ Bundle::MeshData::~MeshData()
     {
         SAFE_DELETE(parts[i]);
     }
+    for (unsigned int i = 0; i < lodParts.size(); ++i)
+    {
+        SAFE_DELETE(lodParts[i]);
+    }
 }
 
 }
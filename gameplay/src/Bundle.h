@@ -147,6 +147,8 @@ private:
         BoundingSphere boundingSphere;
         Mesh::PrimitiveType primitiveType;
         std::vector<MeshPartData*> parts;
+        std::vector<float> lodErrors;
+        std::vector<MeshPartData*> lodParts;
     };
 
     Bundle(const char* path);
@@ -344,6 +346,22 @@ private:
      */
     MeshData* readMeshData();
 
+    /**
+     * Reads the primitive type and indices of a mesh part from the current file position.
+     *
+     * @param partIndex The index of the part, for error messages.
+     *
+     * @return The mesh part data or NULL if there was an error.
+     */
+    MeshPartData* readMeshPartData(unsigned int partIndex);
+
+    /**
+     * Converts the vertex elements of mesh data that the graphics driver cannot read to floats.
+     *
+     * @param meshData The mesh data to convert.
+     */
+    static void convertUnsupportedVertexData(MeshData* meshData);
+
     /**
      * Reads mesh data for the specified URL.
      *
@@ -427,6 +445,7 @@ private:
     bool skipNode();
 
     std::string _path;
+    unsigned char _version[2];
     unsigned int _referenceCount;
     Reference* _references;
     FILE* _file;
@@ -2,6 +2,7 @@
 #include "Camera.h"
 #include "Game.h"
 #include "Node.h"
+#include "Scene.h"
 #include "Game.h"
 #include "PhysicsController.h"
 
@@ -19,13 +20,13 @@ namespace gameplay
 
 Camera::Camera(float fieldOfView, float aspectRatio, float nearPlane, float farPlane)
     : _type(PERSPECTIVE), _fieldOfView(fieldOfView), _aspectRatio(aspectRatio), _nearPlane(nearPlane), _farPlane(farPlane),
-      _dirtyBits(CAMERA_DIRTY_ALL), _node(NULL)
+      _dirtyBits(CAMERA_DIRTY_ALL), _node(NULL), _hasSnapshot(false)
 {
 }
 
 Camera::Camera(float zoomX, float zoomY, float aspectRatio, float nearPlane, float farPlane)
     : _type(ORTHOGRAPHIC), _aspectRatio(aspectRatio), _nearPlane(nearPlane), _farPlane(farPlane),
-      _dirtyBits(CAMERA_DIRTY_ALL), _node(NULL)
+      _dirtyBits(CAMERA_DIRTY_ALL), _node(NULL), _hasSnapshot(false)
 {
     // Orthographic camera.
     _zoom[0] = zoomX;
@@ -155,8 +156,24 @@ void Camera::setNode(Node* node)
     }
 }
 
+void Camera::snapshot()
+{
+    // Clear the flag first so that the getters return the current values.
+    _hasSnapshot = false;
+    _snapshotView = getViewMatrix();
+    _snapshotProjection = getProjectionMatrix();
+    _snapshotViewProjection = getViewProjectionMatrix();
+    _snapshotInverseView = getInverseViewMatrix();
+    _snapshotInverseViewProjection = getInverseViewProjectionMatrix();
+    _snapshotBounds = getFrustum();
+    _hasSnapshot = true;
+}
+
 const Matrix& Camera::getViewMatrix() const
 {
+    if (_hasSnapshot && Scene::isRenderingSnapshot())
+        return _snapshotView;
+
     if (_dirtyBits & CAMERA_DIRTY_VIEW)
     {
         if (_node)
@@ -177,6 +194,9 @@ const Matrix& Camera::getViewMatrix() const
 
 const Matrix& Camera::getInverseViewMatrix() const
 {
+    if (_hasSnapshot && Scene::isRenderingSnapshot())
+        return _snapshotInverseView;
+
     if (_dirtyBits & CAMERA_DIRTY_INV_VIEW)
     {
         getViewMatrix().invert(&_inverseView);
@@ -189,6 +209,9 @@ const Matrix& Camera::getInverseViewMatrix() const
 
 const Matrix& Camera::getProjectionMatrix() const
 {
+    if (_hasSnapshot && Scene::isRenderingSnapshot())
+        return _snapshotProjection;
+
     if (_dirtyBits & CAMERA_DIRTY_PROJ)
     {
         if (_type == PERSPECTIVE)
@@ -208,6 +231,9 @@ const Matrix& Camera::getProjectionMatrix() const
 
 const Matrix& Camera::getViewProjectionMatrix() const
 {
+    if (_hasSnapshot && Scene::isRenderingSnapshot())
+        return _snapshotViewProjection;
+
     if (_dirtyBits & CAMERA_DIRTY_VIEW_PROJ)
     {
         Matrix::multiply(getProjectionMatrix(), getViewMatrix(), &_viewProjection);
@@ -220,6 +246,9 @@ const Matrix& Camera::getViewProjectionMatrix() const
 
 const Matrix& Camera::getInverseViewProjectionMatrix() const
 {
+    if (_hasSnapshot && Scene::isRenderingSnapshot())
+        return _snapshotInverseViewProjection;
+
     if (_dirtyBits & CAMERA_DIRTY_INV_VIEW_PROJ)
     {
         getViewProjectionMatrix().invert(&_inverseViewProjection);
@@ -232,6 +261,9 @@ const Matrix& Camera::getInverseViewProjectionMatrix() const
 
 const Frustum& Camera::getFrustum() const
 {
+    if (_hasSnapshot && Scene::isRenderingSnapshot())
+        return _snapshotBounds;
+
     if (_dirtyBits & CAMERA_DIRTY_BOUNDS)
     {
         // Update our bounding frustum from our view projection matrix.
@@ -18,6 +18,7 @@ class NodeCloneContext;
 class Camera : public Ref, public Transform::Listener
 {
     friend class Node;
+    friend class Scene;
 
 public:
 
@@ -269,6 +270,12 @@ private:
      */
     void setNode(Node* node);
 
+    /**
+     * Copies the matrices and frustum of the camera for pipelined rendering, which the render
+     * thread reads while the game thread updates the camera.
+     */
+    void snapshot();
+
     Camera::Type _type;
     float _fieldOfView;
     float _zoom[2];
@@ -283,6 +290,13 @@ private:
     mutable Frustum _bounds;
     mutable int _dirtyBits;
     Node* _node;
+    Matrix _snapshotView;
+    Matrix _snapshotProjection;
+    Matrix _snapshotViewProjection;
+    Matrix _snapshotInverseView;
+    Matrix _snapshotInverseViewProjection;
+    Frustum _snapshotBounds;
+    bool _hasSnapshot;
 };
 
 }
@@ -4,6 +4,7 @@
 #include <exception>
 #include <cstdio>
 #include <cstdarg>
+#include "MemoryTracker.h"
 
 #ifdef WIN32
 #include <windows.h>
@@ -20,6 +21,7 @@ struct MemoryAllocationRecord
     unsigned int size;              // size of the allocation request
     const char* file;               // source file of allocation request
     int line;                       // source line of the allocation request
+    gameplay::MemoryTracker::Tag tag; // tag the allocation was recorded against
     MemoryAllocationRecord* next;
     MemoryAllocationRecord* prev;
 #ifdef WIN32
@@ -94,6 +96,10 @@ void operator delete[] (void* p, const char* file, int line) throw()
 
 // Include Base.h (needed for logging macros) AFTER new operator impls
 #include "Base.h"
+#include "SpinLock.h"
+
+// Guards the allocation list, since allocations are made from several threads.
+gameplay::SpinLock __memoryAllocationsLock;
 
 void* debugAlloc(std::size_t size, const char* file, int line)
 {
@@ -109,7 +115,7 @@ void* debugAlloc(std::size_t size, const char* file, int line)
     rec->size = size;
     rec->file = file;
     rec->line = line;
-    rec->next = __memoryAllocations;
+    rec->tag = gameplay::MemoryTracker::recordAllocation((unsigned int)size);
     rec->prev = 0;
 
     // Capture the stack frame (up to MAX_STACK_FRAMES) if we 
@@ -160,6 +166,8 @@ void* debugAlloc(std::size_t size, const char* file, int line)
     }
 #endif
 
+    gameplay::SpinLock::ScopedLock lock(__memoryAllocationsLock);
+    rec->next = __memoryAllocations;
     if (__memoryAllocations)
         __memoryAllocations->prev = rec;
     __memoryAllocations = rec;
@@ -185,7 +193,10 @@ void debugFree(void* p)
         return;
     }
 
+    gameplay::MemoryTracker::recordFree(rec->size, rec->tag);
+
     // Link this item out
+    __memoryAllocationsLock.lock();
     if (__memoryAllocations == rec)
         __memoryAllocations = rec->next;
     if (rec->prev)
@@ -193,6 +204,7 @@ void debugFree(void* p)
     if (rec->next)
         rec->next->prev = rec->prev;
     --__memoryAllocationCount;
+    __memoryAllocationsLock.unlock();
 
     // Free the address from the original alloc location (before mem allocation record)
     free(mem);
@@ -303,4 +315,92 @@ void toggleTrackStackTrace()
 }
 #endif
 
+#elif defined(GAMEPLAY_MEM_TRACKING)
+
+#include <new>
+#include <exception>
+#include <cstdlib>
+#include "MemoryTracker.h"
+
+// Precedes each allocation with its size and tag, padded to keep the allocation aligned for any type.
+union MemoryTrackingHeader
+{
+    struct
+    {
+        unsigned int size;
+        gameplay::MemoryTracker::Tag tag;
+    } info;
+    double align[2];
+};
+
+static void* trackedAlloc(std::size_t size)
+{
+    MemoryTrackingHeader* header = (MemoryTrackingHeader*)malloc(size + sizeof(MemoryTrackingHeader));
+    if (header == 0)
+        return 0;
+    header->info.size = (unsigned int)size;
+    header->info.tag = gameplay::MemoryTracker::recordAllocation((unsigned int)size);
+    return header + 1;
+}
+
+static void trackedFree(void* p)
+{
+    if (p == 0)
+        return;
+    MemoryTrackingHeader* header = ((MemoryTrackingHeader*)p) - 1;
+    gameplay::MemoryTracker::recordFree(header->info.size, header->info.tag);
+    free(header);
+}
+
+#ifdef _MSC_VER
+#pragma warning( disable : 4290 )
+#endif
+
+void* operator new (std::size_t size) throw(std::bad_alloc)
+{
+    void* p = trackedAlloc(size);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[] (std::size_t size) throw(std::bad_alloc)
+{
+    return operator new (size);
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) throw()
+{
+    return trackedAlloc(size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) throw()
+{
+    return trackedAlloc(size);
+}
+
+void operator delete (void* p) throw()
+{
+    trackedFree(p);
+}
+
+void operator delete[] (void* p) throw()
+{
+    trackedFree(p);
+}
+
+void operator delete (void* p, const std::nothrow_t&) throw()
+{
+    trackedFree(p);
+}
+
+void operator delete[] (void* p, const std::nothrow_t&) throw()
+{
+    trackedFree(p);
+}
+
+#ifdef _MSC_VER
+#pragma warning( default : 4290 )
+#endif
+
 #endif
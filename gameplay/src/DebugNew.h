@@ -5,6 +5,10 @@
  * Global overrides of the new and delete operators for memory tracking.
  * This file is only included when memory leak detection is explicitly
  * request via the pre-processor definition GAMEPLAY_MEM_LEAK_DETECTION.
+ *
+ * Defining GAMEPLAY_MEM_TRACKING instead replaces the global new and delete
+ * operators with lightweight versions that only count allocations per
+ * MemoryTracker tag, without recording them for leak reports.
  */
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
 
@@ -1,6 +1,9 @@
 #include "Base.h"
 #include "Effect.h"
 #include "FileSystem.h"
+#include "SpinLock.h"
+#include "LoadTrace.h"
+#include "RenderStats.h"
 
 #define OPENGL_ES_DEFINE  "#define OPENGL_ES\n"
 
@@ -9,6 +12,7 @@ namespace gameplay
 
 // Cache of unique effects.
 static std::map<std::string, Effect*> __effectCache;
+static SpinLock __effectCacheLock;
 static Effect* __currentEffect = NULL;
 
 Effect::Effect() : _program(0)
@@ -17,8 +21,14 @@ Effect::Effect() : _program(0)
 
 Effect::~Effect()
 {
-    // Remove this effect from the cache.
-    __effectCache.erase(_id);
+    // Remove this effect from the cache, unless another thread has already replaced it.
+    __effectCacheLock.lock();
+    std::map<std::string, Effect*>::iterator cached = __effectCache.find(_id);
+    if (cached != __effectCache.end() && cached->second == this)
+    {
+        __effectCache.erase(cached);
+    }
+    __effectCacheLock.unlock();
 
     // Free uniforms.
     for (std::map<std::string, Uniform*>::iterator itr = _uniforms.begin(); itr != _uniforms.end(); itr++)
@@ -42,6 +52,7 @@ Effect::~Effect()
 
 Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const char* defines)
 {
+    GP_MEMORY_TAG(ASSETS);
     GP_ASSERT(vshPath);
     GP_ASSERT(fshPath);
 
@@ -54,31 +65,46 @@ Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const c
     {
         uniqueId += defines;
     }
-    std::map<std::string, Effect*>::const_iterator itr = __effectCache.find(uniqueId);
-    if (itr != __effectCache.end())
+    LoadTrace::Asset trace("effect", uniqueId.c_str());
     {
-        // Found an exiting effect with this id, so increase its ref count and return it.
-        GP_ASSERT(itr->second);
-        itr->second->addRef();
-        return itr->second;
+        SpinLock::ScopedLock lock(__effectCacheLock);
+        std::map<std::string, Effect*>::const_iterator itr = __effectCache.find(uniqueId);
+
+        // Found an exiting effect with this id, so increase its ref count and return it,
+        // unless it is being destroyed by another thread.
+        if (itr != __effectCache.end() && itr->second->tryAddRef())
+        {
+            trace.setCacheHit();
+            return itr->second;
+        }
     }
 
     // Read source from file.
-    char* vshSource = FileSystem::readAll(vshPath);
-    if (vshSource == NULL)
+    char* vshSource;
+    char* fshSource;
     {
-        GP_ERROR("Failed to read vertex shader from file '%s'.", vshPath);
-        return NULL;
+        LoadTrace::PhaseScope phase(LoadTrace::IO);
+        vshSource = FileSystem::readAll(vshPath);
+        if (vshSource == NULL)
+        {
+            GP_ERROR("Failed to read vertex shader from file '%s'.", vshPath);
+            return NULL;
+        }
+        fshSource = FileSystem::readAll(fshPath);
+        if (fshSource == NULL)
+        {
+            GP_ERROR("Failed to read fragment shader from file '%s'.", fshPath);
+            SAFE_DELETE_ARRAY(vshSource);
+            return NULL;
+        }
     }
-    char* fshSource = FileSystem::readAll(fshPath);
-    if (fshSource == NULL)
+
+    // Compiling and linking the program is counted as uploading it to the GPU.
+    Effect* effect;
     {
-        GP_ERROR("Failed to read fragment shader from file '%s'.", fshPath);
-        SAFE_DELETE_ARRAY(vshSource);
-        return NULL;
+        LoadTrace::PhaseScope phase(LoadTrace::UPLOAD);
+        effect = createFromSource(vshPath, vshSource, fshPath, fshSource, defines);
     }
-
-    Effect* effect = createFromSource(vshPath, vshSource, fshPath, fshSource, defines);
     
     SAFE_DELETE_ARRAY(vshSource);
     SAFE_DELETE_ARRAY(fshSource);
@@ -91,6 +117,7 @@ Effect* Effect::createFromFile(const char* vshPath, const char* fshPath, const c
     {
         // Store this effect in the cache.
         effect->_id = uniqueId;
+        SpinLock::ScopedLock lock(__effectCacheLock);
         __effectCache[uniqueId] = effect;
     }
 
@@ -462,6 +489,7 @@ void Effect::setValue(Uniform* uniform, float value)
 {
     GP_ASSERT(uniform);
     GL_ASSERT( glUniform1f(uniform->_location, value) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const float* values, unsigned int count)
@@ -469,12 +497,14 @@ void Effect::setValue(Uniform* uniform, const float* values, unsigned int count)
     GP_ASSERT(uniform);
     GP_ASSERT(values);
     GL_ASSERT( glUniform1fv(uniform->_location, count, values) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, int value)
 {
     GP_ASSERT(uniform);
     GL_ASSERT( glUniform1i(uniform->_location, value) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const int* values, unsigned int count)
@@ -482,12 +512,14 @@ void Effect::setValue(Uniform* uniform, const int* values, unsigned int count)
     GP_ASSERT(uniform);
     GP_ASSERT(values);
     GL_ASSERT( glUniform1iv(uniform->_location, count, values) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Matrix& value)
 {
     GP_ASSERT(uniform);
     GL_ASSERT( glUniformMatrix4fv(uniform->_location, 1, GL_FALSE, value.m) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Matrix* values, unsigned int count)
@@ -495,12 +527,14 @@ void Effect::setValue(Uniform* uniform, const Matrix* values, unsigned int count
     GP_ASSERT(uniform);
     GP_ASSERT(values);
     GL_ASSERT( glUniformMatrix4fv(uniform->_location, count, GL_FALSE, (GLfloat*)values) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Vector2& value)
 {
     GP_ASSERT(uniform);
     GL_ASSERT( glUniform2f(uniform->_location, value.x, value.y) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Vector2* values, unsigned int count)
@@ -508,12 +542,14 @@ void Effect::setValue(Uniform* uniform, const Vector2* values, unsigned int coun
     GP_ASSERT(uniform);
     GP_ASSERT(values);
     GL_ASSERT( glUniform2fv(uniform->_location, count, (GLfloat*)values) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Vector3& value)
 {
     GP_ASSERT(uniform);
     GL_ASSERT( glUniform3f(uniform->_location, value.x, value.y, value.z) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Vector3* values, unsigned int count)
@@ -521,12 +557,14 @@ void Effect::setValue(Uniform* uniform, const Vector3* values, unsigned int coun
     GP_ASSERT(uniform);
     GP_ASSERT(values);
     GL_ASSERT( glUniform3fv(uniform->_location, count, (GLfloat*)values) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Vector4& value)
 {
     GP_ASSERT(uniform);
     GL_ASSERT( glUniform4f(uniform->_location, value.x, value.y, value.z, value.w) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Vector4* values, unsigned int count)
@@ -534,6 +572,7 @@ void Effect::setValue(Uniform* uniform, const Vector4* values, unsigned int coun
     GP_ASSERT(uniform);
     GP_ASSERT(values);
     GL_ASSERT( glUniform4fv(uniform->_location, count, (GLfloat*)values) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::setValue(Uniform* uniform, const Texture::Sampler* sampler)
@@ -548,6 +587,7 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler* sampler)
     const_cast<Texture::Sampler*>(sampler)->bind();
 
     GL_ASSERT( glUniform1i(uniform->_location, uniform->_index) );
+    RenderStats::recordUniformUpload();
 }
 
 void Effect::bind()
@@ -555,6 +595,7 @@ void Effect::bind()
    glUseProgram(_program) ;
    GLenum test = glGetError();
     __currentEffect = this;
+    RenderStats::recordStateChanges(1);
 }
 
 Effect* Effect::getCurrentEffect()
@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "FileSystem.h"
 #include "Properties.h"
+#include "LoadTrace.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -251,6 +252,18 @@ FILE* FileSystem::openFile(const char* path, const char* mode)
     }
 #endif
 
+    // Count the size of a file opened for reading against the asset being loaded.
+    if (fp && mode[0] == 'r' && LoadTrace::isEnabled())
+    {
+        if (fseek(fp, 0, SEEK_END) == 0)
+        {
+            long size = ftell(fp);
+            if (size > 0)
+                LoadTrace::recordBytesRead((unsigned int)size);
+            fseek(fp, 0, SEEK_SET);
+        }
+    }
+
     return fp;
 }
 
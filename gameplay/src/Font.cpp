@@ -3,6 +3,8 @@
 #include "Game.h"
 #include "FileSystem.h"
 #include "Bundle.h"
+#include "SpinLock.h"
+#include "MemoryStats.h"
 
 // Default font vertex shader
 #define FONT_VSH \
@@ -37,6 +39,7 @@ namespace gameplay
 {
 
 static std::vector<Font*> __fontCache;
+static SpinLock __fontCacheLock;
 
 static Effect* __fontEffect = NULL;
 
@@ -48,31 +51,38 @@ Font::Font() :
 Font::~Font()
 {
     // Remove this Font from the font cache.
+    __fontCacheLock.lock();
     std::vector<Font*>::iterator itr = std::find(__fontCache.begin(), __fontCache.end(), this);
     if (itr != __fontCache.end())
     {
         __fontCache.erase(itr);
     }
+    __fontCacheLock.unlock();
 
     SAFE_DELETE(_batch);
     SAFE_DELETE_ARRAY(_glyphs);
     SAFE_RELEASE(_texture);
+    MemoryStats::untrack(this);
 }
 
 Font* Font::create(const char* path, const char* id)
 {
+    GP_MEMORY_TAG(ASSETS);
     GP_ASSERT(path);
 
-    // Search the font cache for a font with the given path and ID.
-    for (unsigned int i = 0, count = __fontCache.size(); i < count; ++i)
+    // Search the font cache for a font with the given path and ID,
+    // skipping fonts that are being destroyed by another thread.
     {
-        Font* f = __fontCache[i];
-        GP_ASSERT(f);
-        if (f->_path == path && (id == NULL || f->_id == id))
+        SpinLock::ScopedLock lock(__fontCacheLock);
+        for (unsigned int i = 0, count = __fontCache.size(); i < count; ++i)
         {
-            // Found a match.
-            f->addRef();
-            return f;
+            Font* f = __fontCache[i];
+            GP_ASSERT(f);
+            if (f->_path == path && (id == NULL || f->_id == id) && f->tryAddRef())
+            {
+                // Found a match.
+                return f;
+            }
         }
     }
 
@@ -107,6 +117,7 @@ Font* Font::create(const char* path, const char* id)
     if (font)
     {
         // Add this font to the cache.
+        SpinLock::ScopedLock lock(__fontCacheLock);
         __fontCache.push_back(font);
     }
 
@@ -168,6 +179,9 @@ Font* Font::create(const char* family, Style style, unsigned int size, Glyph* gl
     memcpy(font->_glyphs, glyphs, sizeof(Glyph) * glyphCount);
     font->_glyphCount = glyphCount;
 
+    // The glyph texture is accounted for with the textures.
+    MemoryStats::track(font, MemoryStats::FONT, sizeof(Glyph) * glyphCount, 0);
+
     return font;
 }
 
@@ -196,8 +210,8 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
     const int length = strlen(text);
     int yPos = area.y;
     const float areaHeight = area.height - size;
-    std::vector<int> xPositions;
-    std::vector<unsigned int> lineLengths;
+    PositionList xPositions;
+    LengthList lineLengths;
 
     getMeasurementInfo(text, area, size, justify, wrap, rightToLeft, &xPositions, &yPos, &lineLengths);
 
@@ -206,7 +220,7 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
     GP_ASSERT(batch->_indices);
 
     int xPos = area.x;
-    std::vector<int>::const_iterator xPositionsIt = xPositions.begin();
+    PositionList::const_iterator xPositionsIt = xPositions.begin();
     if (xPositionsIt != xPositions.end())
     {
         xPos = *xPositionsIt++;
@@ -217,7 +231,7 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
     unsigned int lineLength;
     unsigned int currentLineLength = 0;
     const char* lineStart;
-    std::vector<unsigned int>::const_iterator lineLengthsIt;
+    LengthList::const_iterator lineLengthsIt;
     if (rightToLeft)
     {
         lineStart = token;
@@ -552,14 +566,14 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
     const int length = strlen(text);
     int yPos = area.y;
     const float areaHeight = area.height - size;
-    std::vector<int> xPositions;
-    std::vector<unsigned int> lineLengths;
+    PositionList xPositions;
+    LengthList lineLengths;
 
     getMeasurementInfo(text, area, size, justify, wrap, rightToLeft, &xPositions, &yPos, &lineLengths);
 
     // Now we have the info we need in order to render.
     int xPos = area.x;
-    std::vector<int>::const_iterator xPositionsIt = xPositions.begin();
+    PositionList::const_iterator xPositionsIt = xPositions.begin();
     if (xPositionsIt != xPositions.end())
     {
         xPos = *xPositionsIt++;
@@ -570,7 +584,7 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
     unsigned int lineLength;
     unsigned int currentLineLength = 0;
     const char* lineStart;
-    std::vector<unsigned int>::const_iterator lineLengthsIt;
+    LengthList::const_iterator lineLengthsIt;
     if (rightToLeft)
     {
         lineStart = token;
@@ -810,8 +824,8 @@ void Font::measureText(const char* text, const Rectangle& clip, unsigned int siz
     }
 
     const char* token = text;
-    std::vector<bool> emptyLines;
-    std::vector<Vector2> lines;
+    std::vector<bool, FrameArena::Allocator<bool> > emptyLines;
+    std::vector<Vector2, FrameArena::Allocator<Vector2> > lines;
 
     unsigned int lineWidth = 0;
     int yPos = clip.y + size;
@@ -1116,7 +1130,7 @@ void Font::measureText(const char* text, const Rectangle& clip, unsigned int siz
 }
 
 void Font::getMeasurementInfo(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft,
-        std::vector<int>* xPositions, int* yPosition, std::vector<unsigned int>* lineLengths)
+        PositionList* xPositions, int* yPosition, LengthList* lineLengths)
 {
     GP_ASSERT(_size);
     GP_ASSERT(text);
@@ -1325,13 +1339,13 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
     const int length = strlen(text);
     int yPos = area.y;
     const float areaHeight = area.height - size;
-    std::vector<int> xPositions;
-    std::vector<unsigned int> lineLengths;
+    PositionList xPositions;
+    LengthList lineLengths;
 
     getMeasurementInfo(text, area, size, justify, wrap, rightToLeft, &xPositions, &yPos, &lineLengths);
 
     int xPos = area.x;
-    std::vector<int>::const_iterator xPositionsIt = xPositions.begin();
+    PositionList::const_iterator xPositionsIt = xPositions.begin();
     if (xPositionsIt != xPositions.end())
     {
         xPos = *xPositionsIt++;
@@ -1343,7 +1357,7 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
     unsigned int lineLength;
     unsigned int currentLineLength = 0;
     const char* lineStart;
-    std::vector<unsigned int>::const_iterator lineLengthsIt;
+    LengthList::const_iterator lineLengthsIt;
     if (rightToLeft)
     {
         lineStart = token;
@@ -1599,7 +1613,7 @@ unsigned int Font::getReversedTokenLength(const char* token, const char* bufStar
 }
 
 int Font::handleDelimiters(const char** token, const unsigned int size, const int iteration, const int areaX, int* xPos, int* yPos, unsigned int* lineLength,
-                          std::vector<int>::const_iterator* xPositionsIt, std::vector<int>::const_iterator xPositionsEnd, unsigned int* charIndex,
+                          PositionList::const_iterator* xPositionsIt, PositionList::const_iterator xPositionsEnd, unsigned int* charIndex,
                           const Vector2* stopAtPosition, const int currentIndex, const int destIndex)
 {
     GP_ASSERT(token);
@@ -1682,7 +1696,7 @@ int Font::handleDelimiters(const char** token, const unsigned int size, const in
 }
 
 void Font::addLineInfo(const Rectangle& area, int lineWidth, int lineLength, Justify hAlign,
-                       std::vector<int>* xPositions, std::vector<unsigned int>* lineLengths, bool rightToLeft)
+                       PositionList* xPositions, LengthList* lineLengths, bool rightToLeft)
 {
     int hWhitespace = area.width - lineWidth;
     if (hAlign == ALIGN_HCENTER)
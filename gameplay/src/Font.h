@@ -2,6 +2,7 @@
 #define FONT_H_
 
 #include "SpriteBatch.h"
+#include "FrameArena.h"
 
 namespace gameplay
 {
@@ -291,8 +292,15 @@ private:
      */
     static Font* create(const char* family, Style style, unsigned int size, Glyph* glyphs, int glyphCount, Texture* texture);
 
+    /**
+     * The line positions and lengths of laid out text, which only live while text is drawn
+     * or measured and are allocated from the frame arena.
+     */
+    typedef std::vector<int, FrameArena::Allocator<int> > PositionList;
+    typedef std::vector<unsigned int, FrameArena::Allocator<unsigned int> > LengthList;
+
     void getMeasurementInfo(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft,
-                            std::vector<int>* xPositions, int* yPosition, std::vector<unsigned int>* lineLengths);
+                            PositionList* xPositions, int* yPosition, LengthList* lineLengths);
 
     int getIndexOrLocation(const char* text, const Rectangle& clip, unsigned int size, const Vector2& inLocation, Vector2* outLocation,
                            const int destIndex = -1, Justify justify = ALIGN_TOP_LEFT, bool wrap = true, bool rightToLeft = false);
@@ -302,11 +310,11 @@ private:
     unsigned int getReversedTokenLength(const char* token, const char* bufStart);
 
     int handleDelimiters(const char** token, const unsigned int size, const int iteration, const int areaX, int* xPos, int* yPos, unsigned int* lineLength,
-                         std::vector<int>::const_iterator* xPositionsIt, std::vector<int>::const_iterator xPositionsEnd, unsigned int* charIndex = NULL,
+                         PositionList::const_iterator* xPositionsIt, PositionList::const_iterator xPositionsEnd, unsigned int* charIndex = NULL,
                          const Vector2* stopAtPosition = NULL, const int currentIndex = -1, const int destIndex = -1);
 
     void addLineInfo(const Rectangle& area, int lineWidth, int lineLength, Justify hAlign,
-                     std::vector<int>* xPositions, std::vector<unsigned int>* lineLengths, bool rightToLeft);
+                     PositionList* xPositions, LengthList* lineLengths, bool rightToLeft);
 
     std::string _path;
     std::string _id;
@@ -9,6 +9,7 @@
 #include "Button.h"
 #include "CheckBox.h"
 #include "Scene.h"
+#include "RenderTargetPool.h"
 
 #define FORM_VSH \
     "uniform mat4 u_worldViewProjectionMatrix;\n" \
@@ -49,6 +50,7 @@ Form::~Form()
     SAFE_DELETE(_spriteBatch);
     SAFE_RELEASE(_frameBuffer);
     SAFE_RELEASE(_theme);
+    RenderTargetPool::releaseOwner(this);
 
     if (__formEffect)
     {
@@ -243,37 +245,15 @@ void Form::setSize(float width, float height)
     if (width != _bounds.width || height != _bounds.height)
     {
         // Width and height must be powers of two to create a texture.
+        // The framebuffer itself is leased from the RenderTargetPool when the form is drawn.
         unsigned int w = nextPowerOfTwo(width);
         unsigned int h = nextPowerOfTwo(height);
         _u2 = width / (float)w;
         _v1 = height / (float)h;
 
-        // Create framebuffer if necessary.
-        if (_frameBuffer)
-            SAFE_RELEASE(_frameBuffer)
-        
-        _frameBuffer = FrameBuffer::create(_id.c_str(), w, h);
-        GP_ASSERT(_frameBuffer);
-
         // Re-create projection matrix.
         Matrix::createOrthographicOffCenter(0, width, height, 0, 0, 1, &_projectionMatrix);
 
-        // Re-create sprite batch.
-        SAFE_DELETE(_spriteBatch);
-        _spriteBatch = SpriteBatch::create(_frameBuffer->getRenderTarget()->getTexture());
-        GP_ASSERT(_spriteBatch);
-
-        // Clear the framebuffer black
-        Game* game = Game::getInstance();
-        _frameBuffer->bind();
-        Rectangle prevViewport = game->getViewport();
-        game->setViewport(Rectangle(0, 0, width, height));
-        _theme->setProjectionMatrix(_projectionMatrix);
-        game->clear(Game::CLEAR_COLOR, Vector4::zero(), 1.0, 0);
-        _theme->setProjectionMatrix(_defaultProjectionMatrix);
-        FrameBuffer::bindDefault();
-        game->setViewport(prevViewport);
-
         _bounds.width = width;
         _bounds.height = height;
         _dirty = true;
@@ -377,12 +357,8 @@ void Form::setNode(Node* node)
         // Bind the WorldViewProjection matrix.
         _nodeMaterial->setParameterAutoBinding("u_worldViewProjectionMatrix", RenderState::WORLD_VIEW_PROJECTION_MATRIX);
 
-        // Bind the texture from the framebuffer and set the texture to clamp
-        Texture::Sampler* sampler = Texture::Sampler::create(_frameBuffer->getRenderTarget()->getTexture());
-        GP_ASSERT(sampler);
-        sampler->setWrapMode(Texture::CLAMP, Texture::CLAMP);
-        _nodeMaterial->getParameter("u_texture")->setValue(sampler);
-        sampler->release();
+        // The texture from the framebuffer is bound to the material the next time the form is drawn.
+        SAFE_RELEASE(_frameBuffer);
 
         RenderState::StateBlock* rsBlock = _nodeMaterial->getStateBlock();
         rsBlock->setDepthWrite(true);
@@ -395,6 +371,7 @@ void Form::setNode(Node* node)
 
 void Form::update(float elapsedTime)
 {
+    GP_MEMORY_TAG(UI);
     if (isDirty())
     {
         _clearBounds.set(_absoluteClipBounds);
@@ -523,18 +500,31 @@ void Form::update(float elapsedTime)
 
 void Form::draw()
 {
-    // The first time a form is drawn, its contents are rendered into a framebuffer.
-    // The framebuffer will only be drawn into again when the contents of the form change.
+    GP_MEMORY_TAG(UI);
+    // The form's contents are rendered into a framebuffer leased from the RenderTargetPool.
+    // The framebuffer will only be drawn into again when the contents of the form change,
+    // or when the pool could not hand back the framebuffer this form used last time (its
+    // contents were lost to another user, or the form was resized).
     // If this form has a node then it's a 3D form and the framebuffer will be used
     // to texture a quad.  The quad will be given the same dimensions as the form and
     // must be transformed appropriately by the user, unless they call setQuad() themselves.
     // On the other hand, if this form has not been set on a node, SpriteBatch will be used
     // to render the contents of the frambuffer directly to the display.
+    if (_bounds.width <= 0 || _bounds.height <= 0)
+        return;
+
+    bool retained = false;
+    FrameBuffer* frameBuffer = RenderTargetPool::acquireTransient(nextPowerOfTwo(_bounds.width), nextPowerOfTwo(_bounds.height),
+                                                                  RenderTargetPool::COLOR, this, &retained);
+    GP_ASSERT(frameBuffer);
+    if (frameBuffer != _frameBuffer)
+    {
+        setFrameBuffer(frameBuffer);
+    }
 
     // Check whether this form has changed since the last call to draw() and if so, render into the framebuffer.
-    if (isDirty())
+    if (!retained || isDirty())
     {
-        GP_ASSERT(_frameBuffer);
         _frameBuffer->bind();
 
         Game* game = Game::getInstance();
@@ -543,7 +533,16 @@ void Form::draw()
 
         GP_ASSERT(_theme);
         _theme->setProjectionMatrix(_projectionMatrix);
-        Container::draw(_theme->getSpriteBatch(), Rectangle(0, 0, _bounds.width, _bounds.height), _skin != NULL, false, _bounds.height);
+        if (retained)
+        {
+            Container::draw(_theme->getSpriteBatch(), Rectangle(0, 0, _bounds.width, _bounds.height), _skin != NULL, false, _bounds.height);
+        }
+        else
+        {
+            // The framebuffer holds undefined contents, so clear it and redraw every control.
+            game->clear(Game::CLEAR_COLOR, Vector4::zero(), 1.0f, 0);
+            Container::draw(_theme->getSpriteBatch(), Rectangle(0, 0, _bounds.width, _bounds.height), false, true, _bounds.height);
+        }
         _theme->setProjectionMatrix(_defaultProjectionMatrix);
 
         // Rebind the default framebuffer and game viewport.
@@ -562,17 +561,42 @@ void Form::draw()
     else
     {
         // Otherwise we draw the framebuffer in ortho space with a spritebatch.
-        if (!_spriteBatch)
-        {
-            _spriteBatch = SpriteBatch::create(_frameBuffer->getRenderTarget()->getTexture());
-            GP_ASSERT(_spriteBatch);
-        }
+        GP_ASSERT(_spriteBatch);
         _spriteBatch->start();
         _spriteBatch->draw(_bounds.x, _bounds.y, 0, _bounds.width, _bounds.height, 0, _v1, _u2, 0, Vector4::one());
         _spriteBatch->finish();
     }
 }
 
+void Form::setFrameBuffer(FrameBuffer* frameBuffer)
+{
+    GP_ASSERT(frameBuffer);
+
+    // The form keeps a reference to the framebuffer, so it stays valid (and its address is not reused)
+    // if the pool destroys it while the form is not drawn.
+    frameBuffer->addRef();
+    SAFE_RELEASE(_frameBuffer);
+    _frameBuffer = frameBuffer;
+
+    Texture* texture = _frameBuffer->getRenderTarget()->getTexture();
+    GP_ASSERT(texture);
+
+    // Re-create sprite batch.
+    SAFE_DELETE(_spriteBatch);
+    _spriteBatch = SpriteBatch::create(texture);
+    GP_ASSERT(_spriteBatch);
+
+    // Bind the texture to the 3D quad and set the texture to clamp.
+    if (_nodeMaterial)
+    {
+        Texture::Sampler* sampler = Texture::Sampler::create(texture);
+        GP_ASSERT(sampler);
+        sampler->setWrapMode(Texture::CLAMP, Texture::CLAMP);
+        _nodeMaterial->getParameter("u_texture")->setValue(sampler);
+        sampler->release();
+    }
+}
+
 const char* Form::getType() const
 {
     return "form";
@@ -169,6 +169,14 @@ private:
      */
     void initializeQuad(Mesh* mesh);
 
+    /**
+     * Sets the pooled FrameBuffer this Form is rendered into, re-binding its texture
+     * to the sprite batch and the 3D quad material. The Form keeps a reference to it.
+     *
+     * @param frameBuffer The FrameBuffer leased from the RenderTargetPool.
+     */
+    void setFrameBuffer(FrameBuffer* frameBuffer);
+
     /**
      * Propagate touch events to enabled forms.
      *
@@ -213,7 +221,7 @@ private:
     bool projectPoint(int x, int y, Vector3* point);
 
     Theme* _theme;                      // The Theme applied to this Form.
-    FrameBuffer* _frameBuffer;          // FBO the Form is rendered into for texturing the quad. 
+    FrameBuffer* _frameBuffer;          // FBO leased from the RenderTargetPool that the Form is rendered into, referenced by the Form.
     SpriteBatch* _spriteBatch;
     Node* _node;                        // Node for transforming this Form in world-space.
     Model* _nodeQuad;                   // Quad for rendering this Form in 3d space.
@@ -0,0 +1,90 @@
+#include "Base.h"
+#include "FrameArena.h"
+#include "Atomic.h"
+
+// Allocations are rounded up to keep the next allocation aligned for any type.
+#define ARENA_ALIGNMENT 16
+
+// The smallest size the arena is created with.
+#define ARENA_MIN_CAPACITY (16 * 1024)
+
+namespace gameplay
+{
+
+static unsigned char* __arena = NULL;
+static unsigned int __capacity = 0;
+static unsigned int __maxCapacity = 4 * 1024 * 1024;
+static volatile int __used = 0;
+static unsigned int __frameUsage = 0;
+
+void* FrameArena::allocate(size_t size)
+{
+    int alignedSize = (int)((size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1));
+    int offset = Atomic::add(&__used, alignedSize) - alignedSize;
+    if (__arena && (unsigned int)(offset + alignedSize) <= __capacity)
+    {
+        return __arena + offset;
+    }
+
+    // The frame has outgrown the arena; use the heap until the arena grows at the end of the frame.
+    return malloc(size);
+}
+
+void FrameArena::deallocate(void* p)
+{
+    if (p < __arena || p >= __arena + __capacity)
+    {
+        free(p);
+    }
+}
+
+unsigned int FrameArena::getCapacity()
+{
+    return __capacity;
+}
+
+unsigned int FrameArena::getFrameUsage()
+{
+    return __frameUsage;
+}
+
+void FrameArena::setMaxCapacity(unsigned int capacity)
+{
+    __maxCapacity = capacity;
+}
+
+unsigned int FrameArena::getMaxCapacity()
+{
+    return __maxCapacity;
+}
+
+void FrameArena::endFrame()
+{
+    __frameUsage = (unsigned int)Atomic::load(&__used);
+    Atomic::store(&__used, 0);
+
+    // Grow the arena to fit the frame, up to the maximum size.
+    if (__frameUsage > __capacity && __capacity < __maxCapacity)
+    {
+        unsigned int capacity = __capacity > 0 ? __capacity : ARENA_MIN_CAPACITY;
+        while (capacity < __frameUsage && capacity < __maxCapacity)
+        {
+            capacity *= 2;
+        }
+        if (capacity > __maxCapacity)
+            capacity = __maxCapacity;
+
+        SAFE_DELETE_ARRAY(__arena);
+        __arena = new unsigned char[capacity];
+        __capacity = capacity;
+    }
+}
+
+void FrameArena::finalize()
+{
+    SAFE_DELETE_ARRAY(__arena);
+    __capacity = 0;
+    Atomic::store(&__used, 0);
+}
+
+}
@@ -0,0 +1,144 @@
+#ifndef FRAMEARENA_H_
+#define FRAMEARENA_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a linear allocator for transient data that lives no longer than the current frame.
+ *
+ * Allocating from the arena bumps a pointer, and freeing does nothing: all of the memory
+ * allocated in a frame is reclaimed at once when the game ends the frame. Allocations that
+ * do not fit in the arena fall back to the heap, and the arena grows at the end of the
+ * frame to fit the largest frame seen so far.
+ *
+ * Memory from the arena must be freed before the frame ends, so it is suited to the
+ * temporary buffers of a single function, such as the layout of a line of text.
+ * The FrameArena::Allocator adapts the arena for STL containers:
+ * @code
+ * std::vector<int, FrameArena::Allocator<int> > positions;
+ * @endcode
+ *
+ * The arena may be allocated from by any thread, but it must not be used while the
+ * game is ending the frame.
+ *
+ * @script{ignore}
+ */
+class FrameArena
+{
+    friend class Game;
+
+public:
+
+    /**
+     * An STL allocator that allocates from the frame arena.
+     */
+    template <class T>
+    class Allocator
+    {
+    public:
+
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef Allocator<U> other;
+        };
+
+        Allocator() {}
+        Allocator(const Allocator&) {}
+        template <class U> Allocator(const Allocator<U>&) {}
+
+        pointer address(reference value) const { return &value; }
+        const_pointer address(const_reference value) const { return &value; }
+        pointer allocate(size_type count, const void* hint = 0) { return (pointer)FrameArena::allocate(count * sizeof(T)); }
+        void deallocate(pointer p, size_type count) { FrameArena::deallocate(p); }
+        size_type max_size() const { return 0x7FFFFFFF / sizeof(T); }
+#ifdef GAMEPLAY_MEM_LEAK_DETECTION
+#undef new
+#endif
+        void construct(pointer p, const T& value) { ::new((void*)p) T(value); }
+#ifdef GAMEPLAY_MEM_LEAK_DETECTION
+#define new DEBUG_NEW
+#endif
+        void destroy(pointer p) { p->~T(); }
+
+        bool operator==(const Allocator&) const { return true; }
+        bool operator!=(const Allocator&) const { return false; }
+    };
+
+    /**
+     * Allocates memory that is valid until the end of the frame.
+     *
+     * @param size The number of bytes to allocate.
+     *
+     * @return The memory, aligned for any type.
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * Frees memory allocated from the arena in this frame.
+     *
+     * Memory in the arena itself is only reclaimed at the end of the frame.
+     *
+     * @param p The memory returned by FrameArena::allocate.
+     */
+    static void deallocate(void* p);
+
+    /**
+     * Gets the size of the arena.
+     *
+     * @return The number of bytes in the arena.
+     */
+    static unsigned int getCapacity();
+
+    /**
+     * Gets the number of bytes allocated from the arena in the last frame,
+     * including the bytes that did not fit and were allocated from the heap.
+     *
+     * @return The number of bytes.
+     */
+    static unsigned int getFrameUsage();
+
+    /**
+     * Sets the largest size the arena may grow to.
+     *
+     * @param capacity The maximum number of bytes in the arena. The default is 4 megabytes.
+     */
+    static void setMaxCapacity(unsigned int capacity);
+
+    /**
+     * Gets the largest size the arena may grow to.
+     *
+     * @return The maximum number of bytes in the arena.
+     */
+    static unsigned int getMaxCapacity();
+
+private:
+
+    /**
+     * Hidden constructor.
+     */
+    FrameArena();
+
+    /**
+     * Reclaims the memory allocated in the frame, growing the arena if the frame did not fit.
+     */
+    static void endFrame();
+
+    /**
+     * Frees the arena.
+     */
+    static void finalize();
+};
+
+}
+
+#endif
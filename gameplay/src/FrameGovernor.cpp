@@ -0,0 +1,227 @@
+#include "Base.h"
+#include "FrameGovernor.h"
+#include "Properties.h"
+
+// The weight of the latest frame in the averaged times.
+#define SMOOTHING 0.1f
+
+// The fraction of the target frame time a frame must stay under to count towards restoring quality.
+#define RESTORE_THRESHOLD 0.75f
+
+namespace gameplay
+{
+
+FrameGovernor::FrameGovernor()
+    : _enabled(false), _targetFrameTime(16.6f), _maxQualityLevel(3), _degradeFrames(10), _restoreFrames(120),
+      _overBudgetFrames(0), _underBudgetFrames(0), _frameTime(0)
+{
+    memset(_levels, 0, sizeof(_levels));
+    for (unsigned int i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        _governed[i] = i != SCRIPT;
+    }
+    memset(_subsystemTimes, 0, sizeof(_subsystemTimes));
+    memset(_addedTimes, 0, sizeof(_addedTimes));
+}
+
+FrameGovernor::~FrameGovernor()
+{
+}
+
+void FrameGovernor::load(Properties* properties)
+{
+    GP_ASSERT(properties);
+
+    if (properties->exists("targetFrameTime"))
+    {
+        float time = properties->getFloat("targetFrameTime");
+        if (time > 0)
+            _targetFrameTime = time;
+    }
+    if (properties->exists("maxQualityLevel"))
+    {
+        int level = properties->getInt("maxQualityLevel");
+        _maxQualityLevel = level > 0 ? (unsigned int)level : 0;
+    }
+    int degradeFrames = properties->exists("degradeFrames") ? properties->getInt("degradeFrames") : (int)_degradeFrames;
+    int restoreFrames = properties->exists("restoreFrames") ? properties->getInt("restoreFrames") : (int)_restoreFrames;
+    setHysteresis(degradeFrames > 0 ? degradeFrames : 1, restoreFrames > 0 ? restoreFrames : 1);
+    setEnabled(properties->getBool("enabled", true));
+}
+
+void FrameGovernor::setEnabled(bool enabled)
+{
+    if (!enabled)
+        reset();
+    _enabled = enabled;
+}
+
+bool FrameGovernor::isEnabled() const
+{
+    return _enabled;
+}
+
+void FrameGovernor::setTargetFrameTime(float time)
+{
+    GP_ASSERT(time > 0);
+    _targetFrameTime = time;
+}
+
+float FrameGovernor::getTargetFrameTime() const
+{
+    return _targetFrameTime;
+}
+
+void FrameGovernor::setMaxQualityLevel(unsigned int level)
+{
+    _maxQualityLevel = level;
+    for (unsigned int i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        if (_levels[i] > level)
+            _levels[i] = level;
+    }
+}
+
+unsigned int FrameGovernor::getMaxQualityLevel() const
+{
+    return _maxQualityLevel;
+}
+
+void FrameGovernor::setHysteresis(unsigned int degradeFrames, unsigned int restoreFrames)
+{
+    GP_ASSERT(degradeFrames > 0 && restoreFrames > 0);
+    _degradeFrames = degradeFrames;
+    _restoreFrames = restoreFrames;
+}
+
+unsigned int FrameGovernor::getDegradeFrames() const
+{
+    return _degradeFrames;
+}
+
+unsigned int FrameGovernor::getRestoreFrames() const
+{
+    return _restoreFrames;
+}
+
+void FrameGovernor::setGoverned(Subsystem subsystem, bool governed)
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    _governed[subsystem] = governed;
+    if (!governed)
+        _levels[subsystem] = 0;
+}
+
+bool FrameGovernor::isGoverned(Subsystem subsystem) const
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    return _governed[subsystem];
+}
+
+unsigned int FrameGovernor::getQualityLevel(Subsystem subsystem) const
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    return _levels[subsystem];
+}
+
+void FrameGovernor::setQualityLevel(Subsystem subsystem, unsigned int level)
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    _levels[subsystem] = level < _maxQualityLevel ? level : _maxQualityLevel;
+}
+
+float FrameGovernor::getQualityScale(Subsystem subsystem) const
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    return 1.0f - (float)_levels[subsystem] / (float)(_maxQualityLevel + 1);
+}
+
+unsigned int FrameGovernor::getUpdateInterval(Subsystem subsystem) const
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    return 1u << (_levels[subsystem] < 31 ? _levels[subsystem] : 31);
+}
+
+float FrameGovernor::getSubsystemTime(Subsystem subsystem) const
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    return _subsystemTimes[subsystem];
+}
+
+float FrameGovernor::getFrameTime() const
+{
+    return _frameTime;
+}
+
+void FrameGovernor::reset()
+{
+    memset(_levels, 0, sizeof(_levels));
+    _overBudgetFrames = 0;
+    _underBudgetFrames = 0;
+}
+
+void FrameGovernor::addSubsystemTime(Subsystem subsystem, double time)
+{
+    GP_ASSERT(subsystem < SUBSYSTEM_COUNT);
+    _addedTimes[subsystem] += time;
+}
+
+void FrameGovernor::update(double frameTime, const double* subsystemTimes)
+{
+    GP_ASSERT(subsystemTimes);
+
+    // Average the times over several frames so that single spikes do not change the levels.
+    _frameTime += ((float)frameTime - _frameTime) * SMOOTHING;
+    for (unsigned int i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        float time = (float)(subsystemTimes[i] + _addedTimes[i]);
+        _subsystemTimes[i] += (time - _subsystemTimes[i]) * SMOOTHING;
+        _addedTimes[i] = 0;
+    }
+
+    if (!_enabled)
+        return;
+
+    if (_frameTime > _targetFrameTime)
+    {
+        _underBudgetFrames = 0;
+        if (++_overBudgetFrames < _degradeFrames)
+            return;
+        _overBudgetFrames = 0;
+
+        // Degrade the most expensive governed subsystem that can still be degraded.
+        int costliest = -1;
+        for (unsigned int i = 0; i < SUBSYSTEM_COUNT; ++i)
+        {
+            if (_governed[i] && _levels[i] < _maxQualityLevel && (costliest < 0 || _subsystemTimes[i] > _subsystemTimes[costliest]))
+                costliest = i;
+        }
+        if (costliest >= 0)
+            ++_levels[costliest];
+    }
+    else if (_frameTime < _targetFrameTime * RESTORE_THRESHOLD)
+    {
+        _overBudgetFrames = 0;
+        if (++_underBudgetFrames < _restoreFrames)
+            return;
+        _underBudgetFrames = 0;
+
+        // Restore the most degraded subsystem, preferring the cheapest one since it is the least likely to go over budget again.
+        int degraded = -1;
+        for (unsigned int i = 0; i < SUBSYSTEM_COUNT; ++i)
+        {
+            if (_levels[i] > 0 && (degraded < 0 || _levels[i] > _levels[degraded] ||
+                (_levels[i] == _levels[degraded] && _subsystemTimes[i] < _subsystemTimes[degraded])))
+                degraded = i;
+        }
+        if (degraded >= 0)
+            --_levels[degraded];
+    }
+    else
+    {
+        _overBudgetFrames = 0;
+        _underBudgetFrames = 0;
+    }
+}
+
+}
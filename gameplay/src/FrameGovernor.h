@@ -0,0 +1,273 @@
+#ifndef FRAMEGOVERNOR_H_
+#define FRAMEGOVERNOR_H_
+
+namespace gameplay
+{
+
+class Properties;
+
+/**
+ * Defines a governor that scales the work of the game subsystems to keep frames within a time budget.
+ *
+ * Every frame the governor measures the time spent in each subsystem and the time of the
+ * whole frame. When the frame time stays over the target frame time, the quality level of the
+ * most expensive subsystem is lowered by one step. When it stays comfortably under the target,
+ * the quality level of the most degraded subsystem is raised by one step. A subsystem must be
+ * over budget for a number of frames before it is degraded, and under budget for a (longer)
+ * number of frames before it is restored, so the levels do not oscillate.
+ *
+ * Level zero is full quality. The engine applies the levels of the subsystems it governs:
+ * animations and AI are updated less often, physics takes fewer sub-steps to catch up,
+ * particle emitters emit fewer particles and models are drawn at coarser levels of detail.
+ * Only governed subsystems are degraded. Scripts are not governed by default, since the engine
+ * cannot lower their work; a game that reads the level of a subsystem to scale its own work,
+ * such as the quality of its scripts or shadows, governs it with setGoverned.
+ *
+ * The governor is disabled by default. It can be configured in the game config:
+ * @code
+ * frameGovernor
+ * {
+ *     enabled = true
+ *     targetFrameTime = 16.6
+ *     maxQualityLevel = 3
+ *     degradeFrames = 10
+ *     restoreFrames = 120
+ * }
+ * @endcode
+ */
+class FrameGovernor
+{
+    friend class Game;
+    friend class ParticleEmitter;
+
+public:
+
+    /**
+     * The subsystems whose work is governed.
+     */
+    enum Subsystem
+    {
+        ANIMATION,
+        PHYSICS,
+        AI,
+        SCRIPT,
+        PARTICLES,
+        RENDERING,
+        SUBSYSTEM_COUNT
+    };
+
+    /**
+     * Sets whether the governor adjusts quality levels.
+     *
+     * Disabling the governor restores all subsystems to full quality.
+     *
+     * @param enabled true to enable the governor, false to disable it.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Determines whether the governor adjusts quality levels.
+     *
+     * @return true if the governor is enabled.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Sets the frame time the governor tries to stay within.
+     *
+     * @param time The target frame time (in milliseconds). The default is 16.6 milliseconds.
+     */
+    void setTargetFrameTime(float time);
+
+    /**
+     * Gets the frame time the governor tries to stay within.
+     *
+     * @return The target frame time (in milliseconds).
+     */
+    float getTargetFrameTime() const;
+
+    /**
+     * Sets the lowest quality level (the highest level number) a subsystem may be lowered to.
+     *
+     * @param level The maximum quality level. The default is 3.
+     */
+    void setMaxQualityLevel(unsigned int level);
+
+    /**
+     * Gets the lowest quality level (the highest level number) a subsystem may be lowered to.
+     *
+     * @return The maximum quality level.
+     */
+    unsigned int getMaxQualityLevel() const;
+
+    /**
+     * Sets the number of consecutive frames over and under budget before a quality level is changed.
+     *
+     * @param degradeFrames The number of frames over budget before a subsystem is degraded.
+     * @param restoreFrames The number of frames under budget before a subsystem is restored.
+     */
+    void setHysteresis(unsigned int degradeFrames, unsigned int restoreFrames);
+
+    /**
+     * Gets the number of consecutive frames over budget before a subsystem is degraded.
+     *
+     * @return The number of frames.
+     */
+    unsigned int getDegradeFrames() const;
+
+    /**
+     * Gets the number of consecutive frames under budget before a subsystem is restored.
+     *
+     * @return The number of frames.
+     */
+    unsigned int getRestoreFrames() const;
+
+    /**
+     * Sets whether the governor may degrade a subsystem.
+     *
+     * A subsystem should only be governed when something acts on its level, or degrading it
+     * does not reduce the frame time. Ungoverning a subsystem restores it to full quality.
+     *
+     * @param subsystem The subsystem.
+     * @param governed true to let the governor degrade the subsystem, false otherwise.
+     */
+    void setGoverned(Subsystem subsystem, bool governed);
+
+    /**
+     * Determines whether the governor may degrade a subsystem.
+     *
+     * All subsystems but SCRIPT are governed by default.
+     *
+     * @param subsystem The subsystem.
+     *
+     * @return true if the subsystem is governed.
+     */
+    bool isGoverned(Subsystem subsystem) const;
+
+    /**
+     * Gets the quality level of a subsystem.
+     *
+     * @param subsystem The subsystem.
+     *
+     * @return The quality level, where zero is full quality.
+     */
+    unsigned int getQualityLevel(Subsystem subsystem) const;
+
+    /**
+     * Sets the quality level of a subsystem.
+     *
+     * The governor continues to adjust the level from the given value while it is enabled.
+     *
+     * @param subsystem The subsystem.
+     * @param level The quality level, where zero is full quality.
+     */
+    void setQualityLevel(Subsystem subsystem, unsigned int level);
+
+    /**
+     * Gets the fraction of full quality work a subsystem should do.
+     *
+     * This is 1 at level zero and decreases linearly with each level, down to
+     * 1 / (max level + 1) at the maximum level. It is used to scale things like
+     * particle emission rates and LOD distances.
+     *
+     * @param subsystem The subsystem.
+     *
+     * @return The quality scale, in the range (0, 1].
+     */
+    float getQualityScale(Subsystem subsystem) const;
+
+    /**
+     * Gets how often a subsystem should be updated.
+     *
+     * This is 1 at level zero and doubles with each level. It is used to update
+     * things like AI less often.
+     *
+     * @param subsystem The subsystem.
+     *
+     * @return The number of updates per update of the subsystem.
+     */
+    unsigned int getUpdateInterval(Subsystem subsystem) const;
+
+    /**
+     * Gets the averaged time spent in a subsystem each frame.
+     *
+     * @param subsystem The subsystem.
+     *
+     * @return The time (in milliseconds).
+     */
+    float getSubsystemTime(Subsystem subsystem) const;
+
+    /**
+     * Gets the averaged time of a frame.
+     *
+     * @return The time (in milliseconds).
+     */
+    float getFrameTime() const;
+
+    /**
+     * Restores all subsystems to full quality.
+     */
+    void reset();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    FrameGovernor();
+
+    /**
+     * Hidden copy constructor.
+     */
+    FrameGovernor(const FrameGovernor& copy);
+
+    /**
+     * Destructor.
+     */
+    ~FrameGovernor();
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    FrameGovernor& operator=(const FrameGovernor&);
+
+    /**
+     * Loads the governor settings from the game config.
+     *
+     * @param properties The frameGovernor namespace of the game config.
+     */
+    void load(Properties* properties);
+
+    /**
+     * Adds time spent in a subsystem outside of the frame phases measured by the game.
+     *
+     * @param subsystem The subsystem.
+     * @param time The time (in milliseconds).
+     */
+    void addSubsystemTime(Subsystem subsystem, double time);
+
+    /**
+     * Measures a frame and adjusts the quality levels.
+     *
+     * @param frameTime The time of the frame (in milliseconds).
+     * @param subsystemTimes The time spent in each subsystem in the frame, excluding the time added with addSubsystemTime.
+     */
+    void update(double frameTime, const double* subsystemTimes);
+
+    bool _enabled;
+    float _targetFrameTime;
+    unsigned int _maxQualityLevel;
+    unsigned int _degradeFrames;
+    unsigned int _restoreFrames;
+    unsigned int _overBudgetFrames;                 // The number of consecutive frames over budget.
+    unsigned int _underBudgetFrames;                // The number of consecutive frames under budget.
+    unsigned int _levels[SUBSYSTEM_COUNT];          // The quality level of each subsystem.
+    bool _governed[SUBSYSTEM_COUNT];                // Whether each subsystem may be degraded.
+    float _subsystemTimes[SUBSYSTEM_COUNT];         // The averaged time of each subsystem.
+    double _addedTimes[SUBSYSTEM_COUNT];            // The time added to each subsystem in the current frame.
+    float _frameTime;                               // The averaged frame time.
+};
+
+}
+
+#endif
@@ -0,0 +1,2460 @@
+// The wrappers call the GL functions they stand in for, so the redirection is not applied here.
+#define GP_GL_CAPTURE_IMPLEMENTATION
+#include "Base.h"
+#include "GLCapture.h"
+#include "FileSystem.h"
+#include "Properties.h"
+#include <sstream>
+
+// The identifier and version at the start of a stream.
+#define GL_CAPTURE_ID "GPGL"
+#define GL_CAPTURE_VERSION 1
+
+// The number of vertex attributes whose client-side arrays are tracked.
+#define GL_CAPTURE_MAX_ATTRIBUTES 16
+
+namespace gameplay
+{
+
+/**
+ * The records of a stream: one for each GL function, followed by the records that are not GL calls.
+ */
+enum GLRecord
+{
+    GLC_ACTIVE_TEXTURE,
+    GLC_ATTACH_SHADER,
+    GLC_BIND_BUFFER,
+    GLC_BIND_FRAMEBUFFER,
+    GLC_BIND_RENDERBUFFER,
+    GLC_BIND_TEXTURE,
+    GLC_BIND_VERTEX_ARRAY,
+    GLC_BLEND_FUNC,
+    GLC_BUFFER_DATA,
+    GLC_BUFFER_SUB_DATA,
+    GLC_CHECK_FRAMEBUFFER_STATUS,
+    GLC_CLEAR,
+    GLC_CLEAR_COLOR,
+    GLC_CLEAR_DEPTH,
+    GLC_CLEAR_STENCIL,
+    GLC_COMPILE_SHADER,
+    GLC_COMPRESSED_TEX_IMAGE_2D,
+    GLC_CREATE_PROGRAM,
+    GLC_CREATE_SHADER,
+    GLC_DELETE_BUFFERS,
+    GLC_DELETE_FRAMEBUFFERS,
+    GLC_DELETE_PROGRAM,
+    GLC_DELETE_RENDERBUFFERS,
+    GLC_DELETE_SHADER,
+    GLC_DELETE_TEXTURES,
+    GLC_DELETE_VERTEX_ARRAYS,
+    GLC_DEPTH_MASK,
+    GLC_DISABLE,
+    GLC_DISABLE_VERTEX_ATTRIB_ARRAY,
+    GLC_DRAW_ARRAYS,
+    GLC_DRAW_ELEMENTS,
+    GLC_ENABLE,
+    GLC_ENABLE_VERTEX_ATTRIB_ARRAY,
+    GLC_FRAMEBUFFER_RENDERBUFFER,
+    GLC_FRAMEBUFFER_TEXTURE_2D,
+    GLC_GEN_BUFFERS,
+    GLC_GENERATE_MIPMAP,
+    GLC_GEN_FRAMEBUFFERS,
+    GLC_GEN_RENDERBUFFERS,
+    GLC_GEN_TEXTURES,
+    GLC_GEN_VERTEX_ARRAYS,
+    GLC_GET_ACTIVE_ATTRIB,
+    GLC_GET_ACTIVE_UNIFORM,
+    GLC_GET_ATTRIB_LOCATION,
+    GLC_GET_INTEGERV,
+    GLC_GET_PROGRAM_INFO_LOG,
+    GLC_GET_PROGRAMIV,
+    GLC_GET_SHADER_INFO_LOG,
+    GLC_GET_SHADERIV,
+    GLC_GET_STRING,
+    GLC_GET_UNIFORM_LOCATION,
+    GLC_LINK_PROGRAM,
+    GLC_RENDERBUFFER_STORAGE,
+    GLC_SCISSOR,
+    GLC_SHADER_SOURCE,
+    GLC_TEX_IMAGE_2D,
+    GLC_TEX_PARAMETERF,
+    GLC_TEX_PARAMETERI,
+    GLC_UNIFORM_1F,
+    GLC_UNIFORM_1FV,
+    GLC_UNIFORM_1I,
+    GLC_UNIFORM_1IV,
+    GLC_UNIFORM_2F,
+    GLC_UNIFORM_2FV,
+    GLC_UNIFORM_3F,
+    GLC_UNIFORM_3FV,
+    GLC_UNIFORM_4F,
+    GLC_UNIFORM_4FV,
+    GLC_UNIFORM_MATRIX_4FV,
+    GLC_USE_PROGRAM,
+    GLC_VERTEX_ATTRIB_POINTER,
+    GLC_VIEWPORT,
+    GLC_FUNCTION_COUNT,
+
+    // The client-side vertex data read by the next draw.
+    GLC_CLIENT_DATA = GLC_FUNCTION_COUNT,
+    // The end of a frame.
+    GLC_END_FRAME
+};
+
+static const char* __functionNames[GLC_FUNCTION_COUNT] =
+{
+    "glActiveTexture",
+    "glAttachShader",
+    "glBindBuffer",
+    "glBindFramebuffer",
+    "glBindRenderbuffer",
+    "glBindTexture",
+    "glBindVertexArray",
+    "glBlendFunc",
+    "glBufferData",
+    "glBufferSubData",
+    "glCheckFramebufferStatus",
+    "glClear",
+    "glClearColor",
+    "glClearDepth",
+    "glClearStencil",
+    "glCompileShader",
+    "glCompressedTexImage2D",
+    "glCreateProgram",
+    "glCreateShader",
+    "glDeleteBuffers",
+    "glDeleteFramebuffers",
+    "glDeleteProgram",
+    "glDeleteRenderbuffers",
+    "glDeleteShader",
+    "glDeleteTextures",
+    "glDeleteVertexArrays",
+    "glDepthMask",
+    "glDisable",
+    "glDisableVertexAttribArray",
+    "glDrawArrays",
+    "glDrawElements",
+    "glEnable",
+    "glEnableVertexAttribArray",
+    "glFramebufferRenderbuffer",
+    "glFramebufferTexture2D",
+    "glGenBuffers",
+    "glGenerateMipmap",
+    "glGenFramebuffers",
+    "glGenRenderbuffers",
+    "glGenTextures",
+    "glGenVertexArrays",
+    "glGetActiveAttrib",
+    "glGetActiveUniform",
+    "glGetAttribLocation",
+    "glGetIntegerv",
+    "glGetProgramInfoLog",
+    "glGetProgramiv",
+    "glGetShaderInfoLog",
+    "glGetShaderiv",
+    "glGetString",
+    "glGetUniformLocation",
+    "glLinkProgram",
+    "glRenderbufferStorage",
+    "glScissor",
+    "glShaderSource",
+    "glTexImage2D",
+    "glTexParameterf",
+    "glTexParameteri",
+    "glUniform1f",
+    "glUniform1fv",
+    "glUniform1i",
+    "glUniform1iv",
+    "glUniform2f",
+    "glUniform2fv",
+    "glUniform3f",
+    "glUniform3fv",
+    "glUniform4f",
+    "glUniform4fv",
+    "glUniformMatrix4fv",
+    "glUseProgram",
+    "glVertexAttribPointer",
+    "glViewport"
+};
+
+/**
+ * A vertex attribute array set up by glVertexAttribPointer.
+ */
+struct ClientAttribute
+{
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    GLsizei stride;
+    const GLvoid* pointer;
+    bool client;        // Set when the array is in client memory rather than in a buffer.
+    bool enabled;
+};
+
+/**
+ * An attribute or uniform declared by the shaders of a program of the null renderer.
+ */
+struct NullVariable
+{
+    std::string name;
+    GLenum type;
+    GLint size;
+    GLint location;
+};
+
+/**
+ * A program of the null renderer.
+ */
+struct NullProgram
+{
+    std::vector<GLuint> shaders;
+    std::vector<NullVariable> attributes;
+    std::vector<NullVariable> uniforms;
+};
+
+/**
+ * A conditional block of the preprocessor of a shader.
+ */
+struct ConditionalBlock
+{
+    bool parentActive;  // Set when the code around the block is active.
+    bool taken;         // Set when a branch of the block has been active.
+};
+
+/**
+ * The names and uniform locations of a stream mapped to those created by its replay.
+ */
+struct ReplayNames
+{
+    ReplayNames() : program(0) { }
+
+    std::map<GLuint, GLuint> buffers;
+    std::map<GLuint, GLuint> framebuffers;
+    std::map<GLuint, GLuint> renderbuffers;
+    std::map<GLuint, GLuint> textures;
+    std::map<GLuint, GLuint> vertexArrays;
+    std::map<GLuint, GLuint> shaders;
+    std::map<GLuint, GLuint> programs;
+    std::map<std::pair<GLuint, GLint>, GLint> uniforms;
+    GLuint program;     // The program of the stream in use.
+};
+
+// The stream being written.
+static FILE* __file = NULL;
+static unsigned int __frameLimit = 0;
+static unsigned int __frames = 0;
+static std::vector<unsigned char> __record;
+
+// The counts of the calls.
+static unsigned int __callCounts[GLC_FUNCTION_COUNT];
+static unsigned int __payloadSizes[GLC_FUNCTION_COUNT];
+static unsigned int __totalCalls = 0;
+static unsigned int __frameStartCalls = 0;
+static unsigned int __frameCalls = 0;
+static bool __counting = true;
+
+// Set while a stream is replayed, so its calls are not written.
+static bool __replaying = false;
+
+// The bindings that the client-side vertex data and the null renderer depend on.
+static ClientAttribute __attributes[GL_CAPTURE_MAX_ATTRIBUTES];
+static GLuint __arrayBuffer = 0;
+static GLuint __elementBuffer = 0;
+static GLuint __vertexArray = 0;
+static GLuint __framebuffer = 0;
+static GLuint __texture = 0;
+
+// The state of the null renderer.
+static bool __nullRenderer = false;
+static GLuint __nullNextName = 1;
+static std::map<GLuint, std::string> __nullShaders;
+static std::map<GLuint, NullProgram> __nullPrograms;
+
+static bool isWriting()
+{
+    return __file != NULL && !__replaying;
+}
+
+/**
+ * Counts a GL call and writes it to the stream, with the arguments and data put into it, when it goes out of scope.
+ */
+class Record
+{
+public:
+
+    explicit Record(unsigned int record) : _record(record), _size(0)
+    {
+        __record.clear();
+    }
+
+    ~Record()
+    {
+        if (_record < GLC_FUNCTION_COUNT && __counting)
+        {
+            ++__callCounts[_record];
+            __payloadSizes[_record] += _size;
+            ++__totalCalls;
+        }
+        if (isWriting())
+        {
+            unsigned short record = (unsigned short)_record;
+            unsigned int size = __record.size();
+            fwrite(&record, sizeof(record), 1, __file);
+            fwrite(&size, sizeof(size), 1, __file);
+            if (size > 0)
+                fwrite(&__record[0], 1, size, __file);
+        }
+    }
+
+    template <class T> void put(T value)
+    {
+        put(&value, sizeof(value));
+    }
+
+    void put(const void* data, unsigned int size)
+    {
+        _size += size;
+        if (size > 0 && isWriting())
+        {
+            const unsigned char* bytes = (const unsigned char*)data;
+            __record.insert(__record.end(), bytes, bytes + size);
+        }
+    }
+
+    void putString(const char* str, int length = -1)
+    {
+        GLuint size = (GLuint)(length < 0 ? strlen(str) : length);
+        put(size);
+        put(str, size);
+    }
+
+private:
+
+    Record(const Record& copy);
+    Record& operator=(const Record&);
+
+    unsigned int _record;
+    unsigned int _size;
+};
+
+/**
+ * Reads the arguments and data of a record of a stream.
+ */
+class Reader
+{
+public:
+
+    Reader(const unsigned char* data, unsigned int size) : _data(data), _end(data + size), _failed(false)
+    {
+    }
+
+    template <class T> T get()
+    {
+        T value;
+        const unsigned char* data = read(sizeof(value));
+        if (data)
+            memcpy(&value, data, sizeof(value));
+        else
+            memset(&value, 0, sizeof(value));
+        return value;
+    }
+
+    const unsigned char* read(unsigned int size)
+    {
+        if (_failed || (unsigned int)(_end - _data) < size)
+        {
+            _failed = true;
+            return NULL;
+        }
+        const unsigned char* data = _data;
+        _data += size;
+        return data;
+    }
+
+    std::string getString()
+    {
+        GLuint size = get<GLuint>();
+        const unsigned char* data = read(size);
+        return data ? std::string((const char*)data, size) : std::string();
+    }
+
+    bool isEnd() const
+    {
+        return _data == _end;
+    }
+
+    bool hasFailed() const
+    {
+        return _failed;
+    }
+
+private:
+
+    const unsigned char* _data;
+    const unsigned char* _end;
+    bool _failed;
+};
+
+static unsigned int getTypeSize(GLenum type)
+{
+    switch (type)
+    {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:
+        return 1;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+// The bytes of pixels read by glTexImage2D, with rows aligned to the default unpack alignment of 4.
+static unsigned int getImageSize(GLsizei width, GLsizei height, GLenum format, GLenum type)
+{
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    unsigned int pixelSize;
+    switch (type)
+    {
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+        pixelSize = 2;
+        break;
+    default:
+        switch (format)
+        {
+        case GL_RGBA:
+            pixelSize = 4;
+            break;
+        case GL_RGB:
+            pixelSize = 3;
+            break;
+        case GL_LUMINANCE_ALPHA:
+            pixelSize = 2;
+            break;
+        default:
+            pixelSize = 1;
+            break;
+        }
+        pixelSize *= getTypeSize(type);
+        break;
+    }
+    unsigned int rowSize = width * pixelSize;
+    return ((rowSize + 3) & ~3) * (height - 1) + rowSize;
+}
+
+static void genNullNames(GLsizei n, GLuint* names)
+{
+    for (GLsizei i = 0; i < n; ++i)
+        names[i] = __nullNextName++;
+}
+
+/**
+ * Writes the client-side vertex data that a draw reads, since it is only known when the draw is made.
+ */
+static void recordClientData(unsigned int vertexCount)
+{
+    if (!isWriting() || __vertexArray != 0 || vertexCount == 0)
+        return;
+
+    for (GLuint i = 0; i < GL_CAPTURE_MAX_ATTRIBUTES; ++i)
+    {
+        const ClientAttribute& attribute = __attributes[i];
+        if (!attribute.client || !attribute.enabled || attribute.pointer == NULL)
+            continue;
+
+        // Packed types hold all of the values of an element in 4 bytes.
+        unsigned int elementSize = attribute.type == GL_INT_2_10_10_10_REV ? 4 : attribute.size * getTypeSize(attribute.type);
+        unsigned int stride = attribute.stride > 0 ? attribute.stride : elementSize;
+        GLuint size = (vertexCount - 1) * stride + elementSize;
+
+        Record record(GLC_CLIENT_DATA);
+        record.put(i);
+        record.put(size);
+        record.put(attribute.pointer, size);
+    }
+}
+
+static bool hasClientAttributes()
+{
+    if (__vertexArray != 0)
+        return false;
+    for (unsigned int i = 0; i < GL_CAPTURE_MAX_ATTRIBUTES; ++i)
+    {
+        if (__attributes[i].client && __attributes[i].enabled)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Evaluates the condition of a preprocessor directive of a shader, with the conditions
+ * that are not a single defined macro taken as true.
+ */
+static bool evaluateCondition(const std::string& directive, const std::string& expression, const std::map<std::string, std::string>& defines)
+{
+    std::string name = expression;
+    bool negate = directive == "ifndef";
+    if (directive == "if" || directive == "elif")
+    {
+        size_t start = name.find_first_not_of(" \t");
+        name = start == std::string::npos ? "" : name.substr(start);
+        if (!name.empty() && name[0] == '!')
+        {
+            negate = true;
+            name = name.substr(1);
+        }
+        if (name.compare(0, 7, "defined") == 0)
+        {
+            name = name.substr(7);
+        }
+        else
+        {
+            // A macro or a number that is tested for being non-zero.
+            std::string token;
+            for (size_t i = 0; i < name.size() && (isalnum(name[i]) || name[i] == '_'); ++i)
+                token += name[i];
+            if (token.empty() || name.find_first_not_of(" \t", token.size()) != std::string::npos)
+                return true;
+            std::map<std::string, std::string>::const_iterator itr = defines.find(token);
+            const char* value = isdigit(token[0]) ? token.c_str() : (itr != defines.end() ? itr->second.c_str() : "0");
+            return (atoi(value) != 0) != negate;
+        }
+    }
+
+    // Extract the macro name, ignoring parentheses and spaces.
+    std::string token;
+    for (size_t i = 0; i < name.size(); ++i)
+    {
+        char c = name[i];
+        if (isalnum(c) || c == '_')
+            token += c;
+        else if (!token.empty())
+            break;
+    }
+    return (defines.find(token) != defines.end()) != negate;
+}
+
+static GLenum getVariableType(const std::string& type)
+{
+    if (type == "float") return GL_FLOAT;
+    if (type == "vec2") return GL_FLOAT_VEC2;
+    if (type == "vec3") return GL_FLOAT_VEC3;
+    if (type == "vec4") return GL_FLOAT_VEC4;
+    if (type == "int") return GL_INT;
+    if (type == "bool") return GL_BOOL;
+    if (type == "mat2") return GL_FLOAT_MAT2;
+    if (type == "mat3") return GL_FLOAT_MAT3;
+    if (type == "mat4") return GL_FLOAT_MAT4;
+    if (type == "sampler2D") return GL_SAMPLER_2D;
+    if (type == "samplerCube") return GL_SAMPLER_CUBE;
+    return 0;
+}
+
+static void addVariable(std::vector<NullVariable>& variables, const std::string& name, GLenum type, GLint size)
+{
+    for (unsigned int i = 0, count = variables.size(); i < count; ++i)
+    {
+        if (variables[i].name == name)
+            return;
+    }
+
+    NullVariable variable;
+    variable.name = name;
+    variable.type = type;
+    variable.size = size;
+    variable.location = variables.empty() ? 0 : variables.back().location + variables.back().size;
+    variables.push_back(variable);
+}
+
+/**
+ * Adds the attributes and uniforms declared by the active code of a shader to a program of the null renderer.
+ */
+static void reflectShader(const std::string& source, NullProgram& program)
+{
+    // Strip the comments.
+    std::string code;
+    code.reserve(source.size());
+    for (size_t i = 0, size = source.size(); i < size; ++i)
+    {
+        if (source[i] == '/' && i + 1 < size && source[i + 1] == '/')
+        {
+            while (i < size && source[i] != '\n')
+                ++i;
+            code += '\n';
+        }
+        else if (source[i] == '/' && i + 1 < size && source[i + 1] == '*')
+        {
+            i += 2;
+            while (i + 1 < size && !(source[i] == '*' && source[i + 1] == '/'))
+                ++i;
+            ++i;
+            code += ' ';
+        }
+        else
+        {
+            code += source[i];
+        }
+    }
+
+    std::vector<ConditionalBlock> blocks;
+    std::map<std::string, std::string> defines;
+    bool active = true;
+
+    size_t lineStart = 0;
+    while (lineStart < code.size())
+    {
+        size_t lineEnd = code.find('\n', lineStart);
+        if (lineEnd == std::string::npos)
+            lineEnd = code.size();
+        std::string line = code.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        std::istringstream words(line);
+        std::string word;
+        if (!(words >> word))
+            continue;
+
+        if (word[0] == '#')
+        {
+            // The directive may be separated from the '#'.
+            std::string directive = word.substr(1);
+            if (directive.empty())
+                words >> directive;
+            std::string rest;
+            std::getline(words, rest);
+
+            if (directive == "define" && active)
+            {
+                std::istringstream definition(rest);
+                std::string name, value;
+                definition >> name >> value;
+                defines[name] = value;
+            }
+            else if (directive == "undef" && active)
+            {
+                std::istringstream definition(rest);
+                std::string name;
+                definition >> name;
+                defines.erase(name);
+            }
+            else if (directive == "if" || directive == "ifdef" || directive == "ifndef")
+            {
+                bool condition = evaluateCondition(directive, rest, defines);
+                ConditionalBlock block = { active, condition };
+                blocks.push_back(block);
+                active = active && condition;
+            }
+            else if (directive == "elif" && !blocks.empty())
+            {
+                ConditionalBlock& block = blocks.back();
+                bool condition = !block.taken && evaluateCondition(directive, rest, defines);
+                active = block.parentActive && condition;
+                block.taken = block.taken || condition;
+            }
+            else if (directive == "else" && !blocks.empty())
+            {
+                ConditionalBlock& block = blocks.back();
+                active = block.parentActive && !block.taken;
+                block.taken = true;
+            }
+            else if (directive == "endif" && !blocks.empty())
+            {
+                active = blocks.back().parentActive;
+                blocks.pop_back();
+            }
+            continue;
+        }
+
+        if (!active || (word != "attribute" && word != "uniform"))
+            continue;
+
+        // [attribute|uniform] [precision] type name[size], name[size];
+        bool uniform = word == "uniform";
+        std::string type;
+        while (words >> type && (type == "lowp" || type == "mediump" || type == "highp"))
+            ;
+        GLenum glType = getVariableType(type);
+        if (glType == 0)
+            continue;
+
+        std::string names;
+        std::getline(words, names);
+        names = names.substr(0, names.find(';'));
+        std::istringstream list(names);
+        std::string declaration;
+        while (std::getline(list, declaration, ','))
+        {
+            std::string name;
+            std::string size;
+            bool inSize = false;
+            for (size_t i = 0; i < declaration.size(); ++i)
+            {
+                char c = declaration[i];
+                if (c == '[')
+                    inSize = true;
+                else if (c == ']')
+                    inSize = false;
+                else if (isalnum(c) || c == '_')
+                    (inSize ? size : name) += c;
+            }
+            if (name.empty())
+                continue;
+
+            GLint arraySize = 1;
+            if (!size.empty())
+            {
+                std::map<std::string, std::string>::const_iterator itr = defines.find(size);
+                arraySize = std::max(1, atoi(itr != defines.end() ? itr->second.c_str() : size.c_str()));
+            }
+            addVariable(uniform ? program.uniforms : program.attributes, name, glType, uniform ? arraySize : 1);
+        }
+    }
+}
+
+static const NullVariable* findNullVariable(GLuint program, const char* name, bool uniform)
+{
+    std::map<GLuint, NullProgram>::const_iterator itr = __nullPrograms.find(program);
+    if (itr == __nullPrograms.end() || name == NULL)
+        return NULL;
+
+    // Arrays can be looked up with or without the index of their first element.
+    std::string base = name;
+    size_t bracket = base.find('[');
+    if (bracket != std::string::npos)
+        base = base.substr(0, bracket);
+
+    const std::vector<NullVariable>& variables = uniform ? itr->second.uniforms : itr->second.attributes;
+    for (unsigned int i = 0, count = variables.size(); i < count; ++i)
+    {
+        if (variables[i].name == base)
+            return &variables[i];
+    }
+    return NULL;
+}
+
+static void getNullActiveVariable(GLuint program, GLuint index, GLsizei bufsize, GLsizei* length, GLint* size, GLenum* type, GLchar* name, bool uniform)
+{
+    std::map<GLuint, NullProgram>::const_iterator itr = __nullPrograms.find(program);
+    const std::vector<NullVariable>* variables = itr == __nullPrograms.end() ? NULL : (uniform ? &itr->second.uniforms : &itr->second.attributes);
+    if (variables == NULL || index >= variables->size() || bufsize <= 0)
+    {
+        if (length)
+            *length = 0;
+        return;
+    }
+
+    const NullVariable& variable = (*variables)[index];
+    std::string variableName = variable.size > 1 ? variable.name + "[0]" : variable.name;
+    GLsizei nameLength = std::min((GLsizei)variableName.size(), bufsize - 1);
+    memcpy(name, variableName.c_str(), nameLength);
+    name[nameLength] = '\0';
+    if (length)
+        *length = nameLength;
+    if (size)
+        *size = variable.size;
+    if (type)
+        *type = variable.type;
+}
+
+static GLint getNullMaxNameLength(const std::vector<NullVariable>& variables)
+{
+    GLint length = 0;
+    for (unsigned int i = 0, count = variables.size(); i < count; ++i)
+        length = std::max(length, (GLint)variables[i].name.size() + (variables[i].size > 1 ? 4 : 1));
+    return length;
+}
+
+bool GLCapture::isAvailable()
+{
+#ifdef GP_USE_GL_CAPTURE
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool GLCapture::start(const char* path, unsigned int frameCount)
+{
+    GP_ASSERT(path);
+
+    stop();
+    if (!isAvailable())
+    {
+        GP_WARN("Failed to capture the GL calls to '%s'; the engine was built without GP_USE_GL_CAPTURE.", path);
+        return false;
+    }
+
+    __file = FileSystem::openFile(path, "wb");
+    if (__file == NULL)
+    {
+        GP_WARN("Failed to open GL capture '%s' for writing.", path);
+        return false;
+    }
+
+    unsigned int version = GL_CAPTURE_VERSION;
+    fwrite(GL_CAPTURE_ID, 1, 4, __file);
+    fwrite(&version, sizeof(version), 1, __file);
+    __frameLimit = frameCount;
+    __frames = 0;
+    return true;
+}
+
+void GLCapture::stop()
+{
+    if (__file)
+    {
+        fclose(__file);
+        __file = NULL;
+    }
+}
+
+bool GLCapture::isCapturing()
+{
+    return __file != NULL;
+}
+
+void GLCapture::setNullRenderer(bool enabled)
+{
+    __nullRenderer = enabled;
+}
+
+bool GLCapture::isNullRenderer()
+{
+    return __nullRenderer;
+}
+
+// Maps a uniform location of the program of the stream in use to the location in the replayed program.
+static GLint mapUniform(const ReplayNames& names, GLint location)
+{
+    std::map<std::pair<GLuint, GLint>, GLint>::const_iterator itr = names.uniforms.find(std::make_pair(names.program, location));
+    return itr != names.uniforms.end() ? itr->second : location;
+}
+
+/**
+ * Replays a record of a stream.
+ */
+static void replayRecord(unsigned int record, Reader& args, ReplayNames& names)
+{
+    // Maps a name of the stream to the name created by the replay; names made before the stream started are kept.
+    #define MAP_NAME(map, name) ((name) != 0 && (map).count(name) ? (map)[name] : (name))
+
+    GLint location;
+    switch (record)
+    {
+    case GLC_ACTIVE_TEXTURE:
+        glcActiveTexture(args.get<GLenum>());
+        break;
+    case GLC_ATTACH_SHADER:
+    {
+        GLuint program = args.get<GLuint>();
+        GLuint shader = args.get<GLuint>();
+        glcAttachShader(MAP_NAME(names.programs, program), MAP_NAME(names.shaders, shader));
+        break;
+    }
+    case GLC_BIND_BUFFER:
+    {
+        GLenum target = args.get<GLenum>();
+        GLuint buffer = args.get<GLuint>();
+        glcBindBuffer(target, MAP_NAME(names.buffers, buffer));
+        break;
+    }
+    case GLC_BIND_FRAMEBUFFER:
+    {
+        GLenum target = args.get<GLenum>();
+        GLuint framebuffer = args.get<GLuint>();
+        glcBindFramebuffer(target, MAP_NAME(names.framebuffers, framebuffer));
+        break;
+    }
+    case GLC_BIND_RENDERBUFFER:
+    {
+        GLenum target = args.get<GLenum>();
+        GLuint renderbuffer = args.get<GLuint>();
+        glcBindRenderbuffer(target, MAP_NAME(names.renderbuffers, renderbuffer));
+        break;
+    }
+    case GLC_BIND_TEXTURE:
+    {
+        GLenum target = args.get<GLenum>();
+        GLuint texture = args.get<GLuint>();
+        glcBindTexture(target, MAP_NAME(names.textures, texture));
+        break;
+    }
+    case GLC_BIND_VERTEX_ARRAY:
+    {
+        GLuint array = args.get<GLuint>();
+        glcBindVertexArray(MAP_NAME(names.vertexArrays, array));
+        break;
+    }
+    case GLC_BLEND_FUNC:
+    {
+        GLenum sfactor = args.get<GLenum>();
+        GLenum dfactor = args.get<GLenum>();
+        glcBlendFunc(sfactor, dfactor);
+        break;
+    }
+    case GLC_BUFFER_DATA:
+    {
+        GLenum target = args.get<GLenum>();
+        GLuint size = args.get<GLuint>();
+        GLenum usage = args.get<GLenum>();
+        const GLvoid* data = args.get<GLubyte>() ? args.read(size) : NULL;
+        glcBufferData(target, size, data, usage);
+        break;
+    }
+    case GLC_BUFFER_SUB_DATA:
+    {
+        GLenum target = args.get<GLenum>();
+        GLuint offset = args.get<GLuint>();
+        GLuint size = args.get<GLuint>();
+        const GLvoid* data = args.read(size);
+        if (data)
+            glcBufferSubData(target, offset, size, data);
+        break;
+    }
+    case GLC_CHECK_FRAMEBUFFER_STATUS:
+        glcCheckFramebufferStatus(args.get<GLenum>());
+        break;
+    case GLC_CLEAR:
+        glcClear(args.get<GLbitfield>());
+        break;
+    case GLC_CLEAR_COLOR:
+    {
+        GLfloat red = args.get<GLfloat>();
+        GLfloat green = args.get<GLfloat>();
+        GLfloat blue = args.get<GLfloat>();
+        GLfloat alpha = args.get<GLfloat>();
+        glcClearColor(red, green, blue, alpha);
+        break;
+    }
+    case GLC_CLEAR_DEPTH:
+        glcClearDepth(args.get<GLfloat>());
+        break;
+    case GLC_CLEAR_STENCIL:
+        glcClearStencil(args.get<GLint>());
+        break;
+    case GLC_COMPILE_SHADER:
+    {
+        GLuint shader = args.get<GLuint>();
+        glcCompileShader(MAP_NAME(names.shaders, shader));
+        break;
+    }
+    case GLC_COMPRESSED_TEX_IMAGE_2D:
+    {
+        GLenum target = args.get<GLenum>();
+        GLint level = args.get<GLint>();
+        GLenum internalformat = args.get<GLenum>();
+        GLsizei width = args.get<GLsizei>();
+        GLsizei height = args.get<GLsizei>();
+        GLint border = args.get<GLint>();
+        GLsizei imageSize = args.get<GLsizei>();
+        const GLvoid* data = args.get<GLubyte>() ? args.read(imageSize) : NULL;
+        glcCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+        break;
+    }
+    case GLC_CREATE_PROGRAM:
+    {
+        GLuint program = args.get<GLuint>();
+        names.programs[program] = glcCreateProgram();
+        break;
+    }
+    case GLC_CREATE_SHADER:
+    {
+        GLenum type = args.get<GLenum>();
+        GLuint shader = args.get<GLuint>();
+        names.shaders[shader] = glcCreateShader(type);
+        break;
+    }
+    case GLC_DELETE_BUFFERS:
+    case GLC_DELETE_FRAMEBUFFERS:
+    case GLC_DELETE_RENDERBUFFERS:
+    case GLC_DELETE_TEXTURES:
+    case GLC_DELETE_VERTEX_ARRAYS:
+    {
+        std::map<GLuint, GLuint>& map = record == GLC_DELETE_BUFFERS ? names.buffers :
+            record == GLC_DELETE_FRAMEBUFFERS ? names.framebuffers :
+            record == GLC_DELETE_RENDERBUFFERS ? names.renderbuffers :
+            record == GLC_DELETE_TEXTURES ? names.textures : names.vertexArrays;
+        GLsizei n = args.get<GLsizei>();
+        std::vector<GLuint> deleted;
+        for (GLsizei i = 0; i < n && !args.hasFailed(); ++i)
+        {
+            GLuint name = args.get<GLuint>();
+            deleted.push_back(MAP_NAME(map, name));
+            map.erase(name);
+        }
+        if (deleted.empty())
+            break;
+        switch (record)
+        {
+        case GLC_DELETE_BUFFERS:
+            glcDeleteBuffers(deleted.size(), &deleted[0]);
+            break;
+        case GLC_DELETE_FRAMEBUFFERS:
+            glcDeleteFramebuffers(deleted.size(), &deleted[0]);
+            break;
+        case GLC_DELETE_RENDERBUFFERS:
+            glcDeleteRenderbuffers(deleted.size(), &deleted[0]);
+            break;
+        case GLC_DELETE_TEXTURES:
+            glcDeleteTextures(deleted.size(), &deleted[0]);
+            break;
+        default:
+            glcDeleteVertexArrays(deleted.size(), &deleted[0]);
+            break;
+        }
+        break;
+    }
+    case GLC_DELETE_PROGRAM:
+    {
+        GLuint program = args.get<GLuint>();
+        glcDeleteProgram(MAP_NAME(names.programs, program));
+        names.programs.erase(program);
+        break;
+    }
+    case GLC_DELETE_SHADER:
+    {
+        GLuint shader = args.get<GLuint>();
+        glcDeleteShader(MAP_NAME(names.shaders, shader));
+        names.shaders.erase(shader);
+        break;
+    }
+    case GLC_DEPTH_MASK:
+        glcDepthMask(args.get<GLubyte>());
+        break;
+    case GLC_DISABLE:
+        glcDisable(args.get<GLenum>());
+        break;
+    case GLC_DISABLE_VERTEX_ATTRIB_ARRAY:
+        glcDisableVertexAttribArray(args.get<GLuint>());
+        break;
+    case GLC_DRAW_ARRAYS:
+    {
+        GLenum mode = args.get<GLenum>();
+        GLint first = args.get<GLint>();
+        GLsizei count = args.get<GLsizei>();
+        glcDrawArrays(mode, first, count);
+        break;
+    }
+    case GLC_DRAW_ELEMENTS:
+    {
+        GLenum mode = args.get<GLenum>();
+        GLsizei count = args.get<GLsizei>();
+        GLenum type = args.get<GLenum>();
+        const GLvoid* indices;
+        if (args.get<GLubyte>())
+            indices = args.read(count * getTypeSize(type));
+        else
+            indices = (const GLvoid*)(size_t)args.get<GLuint>();
+        if (!args.hasFailed())
+            glcDrawElements(mode, count, type, indices);
+        break;
+    }
+    case GLC_ENABLE:
+        glcEnable(args.get<GLenum>());
+        break;
+    case GLC_ENABLE_VERTEX_ATTRIB_ARRAY:
+        glcEnableVertexAttribArray(args.get<GLuint>());
+        break;
+    case GLC_FRAMEBUFFER_RENDERBUFFER:
+    {
+        GLenum target = args.get<GLenum>();
+        GLenum attachment = args.get<GLenum>();
+        GLenum renderbuffertarget = args.get<GLenum>();
+        GLuint renderbuffer = args.get<GLuint>();
+        glcFramebufferRenderbuffer(target, attachment, renderbuffertarget, MAP_NAME(names.renderbuffers, renderbuffer));
+        break;
+    }
+    case GLC_FRAMEBUFFER_TEXTURE_2D:
+    {
+        GLenum target = args.get<GLenum>();
+        GLenum attachment = args.get<GLenum>();
+        GLenum textarget = args.get<GLenum>();
+        GLuint texture = args.get<GLuint>();
+        GLint level = args.get<GLint>();
+        glcFramebufferTexture2D(target, attachment, textarget, MAP_NAME(names.textures, texture), level);
+        break;
+    }
+    case GLC_GEN_BUFFERS:
+    case GLC_GEN_FRAMEBUFFERS:
+    case GLC_GEN_RENDERBUFFERS:
+    case GLC_GEN_TEXTURES:
+    case GLC_GEN_VERTEX_ARRAYS:
+    {
+        GLsizei n = args.get<GLsizei>();
+        if (n <= 0)
+            break;
+        std::vector<GLuint> created(n);
+        switch (record)
+        {
+        case GLC_GEN_BUFFERS:
+            glcGenBuffers(n, &created[0]);
+            break;
+        case GLC_GEN_FRAMEBUFFERS:
+            glcGenFramebuffers(n, &created[0]);
+            break;
+        case GLC_GEN_RENDERBUFFERS:
+            glcGenRenderbuffers(n, &created[0]);
+            break;
+        case GLC_GEN_TEXTURES:
+            glcGenTextures(n, &created[0]);
+            break;
+        default:
+            glcGenVertexArrays(n, &created[0]);
+            break;
+        }
+        std::map<GLuint, GLuint>& map = record == GLC_GEN_BUFFERS ? names.buffers :
+            record == GLC_GEN_FRAMEBUFFERS ? names.framebuffers :
+            record == GLC_GEN_RENDERBUFFERS ? names.renderbuffers :
+            record == GLC_GEN_TEXTURES ? names.textures : names.vertexArrays;
+        for (GLsizei i = 0; i < n && !args.hasFailed(); ++i)
+            map[args.get<GLuint>()] = created[i];
+        break;
+    }
+    case GLC_GENERATE_MIPMAP:
+        glcGenerateMipmap(args.get<GLenum>());
+        break;
+    case GLC_GET_ACTIVE_ATTRIB:
+    case GLC_GET_ACTIVE_UNIFORM:
+    {
+        GLuint program = args.get<GLuint>();
+        GLuint index = args.get<GLuint>();
+        GLsizei bufsize = args.get<GLsizei>();
+        std::vector<GLchar> name(std::max(bufsize, 1));
+        GLint size;
+        GLenum type;
+        if (record == GLC_GET_ACTIVE_ATTRIB)
+            glcGetActiveAttrib(MAP_NAME(names.programs, program), index, name.size(), NULL, &size, &type, &name[0]);
+        else
+            glcGetActiveUniform(MAP_NAME(names.programs, program), index, name.size(), NULL, &size, &type, &name[0]);
+        break;
+    }
+    case GLC_GET_ATTRIB_LOCATION:
+    {
+        GLuint program = args.get<GLuint>();
+        std::string name = args.getString();
+        glcGetAttribLocation(MAP_NAME(names.programs, program), name.c_str());
+        break;
+    }
+    case GLC_GET_INTEGERV:
+    {
+        GLint params[16];
+        glcGetIntegerv(args.get<GLenum>(), params);
+        break;
+    }
+    case GLC_GET_PROGRAM_INFO_LOG:
+    case GLC_GET_SHADER_INFO_LOG:
+    {
+        GLuint object = args.get<GLuint>();
+        GLsizei bufsize = args.get<GLsizei>();
+        std::vector<GLchar> infolog(std::max(bufsize, 1));
+        if (record == GLC_GET_PROGRAM_INFO_LOG)
+            glcGetProgramInfoLog(MAP_NAME(names.programs, object), infolog.size(), NULL, &infolog[0]);
+        else
+            glcGetShaderInfoLog(MAP_NAME(names.shaders, object), infolog.size(), NULL, &infolog[0]);
+        break;
+    }
+    case GLC_GET_PROGRAMIV:
+    {
+        GLuint program = args.get<GLuint>();
+        GLenum pname = args.get<GLenum>();
+        GLint param;
+        glcGetProgramiv(MAP_NAME(names.programs, program), pname, &param);
+        break;
+    }
+    case GLC_GET_SHADERIV:
+    {
+        GLuint shader = args.get<GLuint>();
+        GLenum pname = args.get<GLenum>();
+        GLint param;
+        glcGetShaderiv(MAP_NAME(names.shaders, shader), pname, &param);
+        break;
+    }
+    case GLC_GET_STRING:
+        glcGetString(args.get<GLenum>());
+        break;
+    case GLC_GET_UNIFORM_LOCATION:
+    {
+        GLuint program = args.get<GLuint>();
+        std::string name = args.getString();
+        location = args.get<GLint>();
+        names.uniforms[std::make_pair(program, location)] = glcGetUniformLocation(MAP_NAME(names.programs, program), name.c_str());
+        break;
+    }
+    case GLC_LINK_PROGRAM:
+    {
+        GLuint program = args.get<GLuint>();
+        glcLinkProgram(MAP_NAME(names.programs, program));
+        break;
+    }
+    case GLC_RENDERBUFFER_STORAGE:
+    {
+        GLenum target = args.get<GLenum>();
+        GLenum internalformat = args.get<GLenum>();
+        GLsizei width = args.get<GLsizei>();
+        GLsizei height = args.get<GLsizei>();
+        glcRenderbufferStorage(target, internalformat, width, height);
+        break;
+    }
+    case GLC_SCISSOR:
+    case GLC_VIEWPORT:
+    {
+        GLint x = args.get<GLint>();
+        GLint y = args.get<GLint>();
+        GLsizei width = args.get<GLsizei>();
+        GLsizei height = args.get<GLsizei>();
+        if (record == GLC_SCISSOR)
+            glcScissor(x, y, width, height);
+        else
+            glcViewport(x, y, width, height);
+        break;
+    }
+    case GLC_SHADER_SOURCE:
+    {
+        GLuint shader = args.get<GLuint>();
+        GLsizei count = args.get<GLsizei>();
+        std::vector<const GLchar*> strings;
+        std::vector<GLint> lengths;
+        for (GLsizei i = 0; i < count && !args.hasFailed(); ++i)
+        {
+            GLuint length = args.get<GLuint>();
+            strings.push_back((const GLchar*)args.read(length));
+            lengths.push_back(length);
+        }
+        if (!strings.empty() && !args.hasFailed())
+            glcShaderSource(MAP_NAME(names.shaders, shader), strings.size(), &strings[0], &lengths[0]);
+        break;
+    }
+    case GLC_TEX_IMAGE_2D:
+    {
+        GLenum target = args.get<GLenum>();
+        GLint level = args.get<GLint>();
+        GLint internalformat = args.get<GLint>();
+        GLsizei width = args.get<GLsizei>();
+        GLsizei height = args.get<GLsizei>();
+        GLint border = args.get<GLint>();
+        GLenum format = args.get<GLenum>();
+        GLenum type = args.get<GLenum>();
+        const GLvoid* pixels = args.get<GLubyte>() ? args.read(getImageSize(width, height, format, type)) : NULL;
+        glcTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+        break;
+    }
+    case GLC_TEX_PARAMETERF:
+    {
+        GLenum target = args.get<GLenum>();
+        GLenum pname = args.get<GLenum>();
+        glcTexParameterf(target, pname, args.get<GLfloat>());
+        break;
+    }
+    case GLC_TEX_PARAMETERI:
+    {
+        GLenum target = args.get<GLenum>();
+        GLenum pname = args.get<GLenum>();
+        glcTexParameteri(target, pname, args.get<GLint>());
+        break;
+    }
+    case GLC_UNIFORM_1F:
+    case GLC_UNIFORM_2F:
+    case GLC_UNIFORM_3F:
+    case GLC_UNIFORM_4F:
+    {
+        location = args.get<GLint>();
+        location = mapUniform(names, location);
+        GLfloat v[4] = { 0, 0, 0, 0 };
+        for (unsigned int i = 0; i <= (unsigned int)(record - GLC_UNIFORM_1F) / 2; ++i)
+            v[i] = args.get<GLfloat>();
+        switch (record)
+        {
+        case GLC_UNIFORM_1F:
+            glcUniform1f(location, v[0]);
+            break;
+        case GLC_UNIFORM_2F:
+            glcUniform2f(location, v[0], v[1]);
+            break;
+        case GLC_UNIFORM_3F:
+            glcUniform3f(location, v[0], v[1], v[2]);
+            break;
+        default:
+            glcUniform4f(location, v[0], v[1], v[2], v[3]);
+            break;
+        }
+        break;
+    }
+    case GLC_UNIFORM_1I:
+    {
+        location = args.get<GLint>();
+        location = mapUniform(names, location);
+        glcUniform1i(location, args.get<GLint>());
+        break;
+    }
+    case GLC_UNIFORM_1FV:
+    case GLC_UNIFORM_1IV:
+    case GLC_UNIFORM_2FV:
+    case GLC_UNIFORM_3FV:
+    case GLC_UNIFORM_4FV:
+    case GLC_UNIFORM_MATRIX_4FV:
+    {
+        location = args.get<GLint>();
+        location = mapUniform(names, location);
+        GLsizei count = args.get<GLsizei>();
+        GLboolean transpose = record == GLC_UNIFORM_MATRIX_4FV ? args.get<GLubyte>() : GL_FALSE;
+        unsigned int components = record == GLC_UNIFORM_2FV ? 2 : record == GLC_UNIFORM_3FV ? 3 :
+            record == GLC_UNIFORM_4FV ? 4 : record == GLC_UNIFORM_MATRIX_4FV ? 16 : 1;
+        const GLvoid* v = args.read(count * components * 4);
+        if (v == NULL)
+            break;
+        switch (record)
+        {
+        case GLC_UNIFORM_1FV:
+            glcUniform1fv(location, count, (const GLfloat*)v);
+            break;
+        case GLC_UNIFORM_1IV:
+            glcUniform1iv(location, count, (const GLint*)v);
+            break;
+        case GLC_UNIFORM_2FV:
+            glcUniform2fv(location, count, (const GLfloat*)v);
+            break;
+        case GLC_UNIFORM_3FV:
+            glcUniform3fv(location, count, (const GLfloat*)v);
+            break;
+        case GLC_UNIFORM_4FV:
+            glcUniform4fv(location, count, (const GLfloat*)v);
+            break;
+        default:
+            glcUniformMatrix4fv(location, count, transpose, (const GLfloat*)v);
+            break;
+        }
+        break;
+    }
+    case GLC_USE_PROGRAM:
+        names.program = args.get<GLuint>();
+        glcUseProgram(MAP_NAME(names.programs, names.program));
+        break;
+    case GLC_VERTEX_ATTRIB_POINTER:
+    {
+        GLuint index = args.get<GLuint>();
+        GLint size = args.get<GLint>();
+        GLenum type = args.get<GLenum>();
+        GLboolean normalized = args.get<GLubyte>();
+        GLsizei stride = args.get<GLsizei>();
+        const GLvoid* pointer = args.get<GLubyte>() ? NULL : (const GLvoid*)(size_t)args.get<GLuint>();
+        glcVertexAttribPointer(index, size, type, normalized, stride, pointer);
+        break;
+    }
+    case GLC_CLIENT_DATA:
+    {
+        // The array is pointed at the data of the stream just before the draw that reads it.
+        GLuint index = args.get<GLuint>();
+        GLuint size = args.get<GLuint>();
+        const GLvoid* data = args.read(size);
+        if (data && index < GL_CAPTURE_MAX_ATTRIBUTES && !__nullRenderer)
+        {
+            const ClientAttribute& attribute = __attributes[index];
+            glVertexAttribPointer(index, attribute.size, attribute.type, attribute.normalized, attribute.stride, data);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    #undef MAP_NAME
+}
+
+bool GLCapture::replay(const char* path)
+{
+    GP_ASSERT(path);
+
+    int size = 0;
+    char* data = FileSystem::readAll(path, &size);
+    if (data == NULL)
+    {
+        GP_WARN("Failed to open GL capture '%s'.", path);
+        return false;
+    }
+
+    Reader stream((const unsigned char*)data, (unsigned int)size);
+    const unsigned char* id = stream.read(4);
+    if (id == NULL || memcmp(id, GL_CAPTURE_ID, 4) != 0 || stream.get<unsigned int>() != GL_CAPTURE_VERSION)
+    {
+        GP_WARN("Invalid GL capture '%s'.", path);
+        SAFE_DELETE_ARRAY(data);
+        return false;
+    }
+
+    __replaying = true;
+    ReplayNames names;
+    bool valid = true;
+    while (valid && !stream.isEnd())
+    {
+        unsigned short record = stream.get<unsigned short>();
+        unsigned int recordSize = stream.get<unsigned int>();
+        const unsigned char* payload = stream.read(recordSize);
+        if (payload == NULL)
+        {
+            valid = false;
+            break;
+        }
+
+        Reader args(payload, recordSize);
+        replayRecord(record, args, names);
+        valid = !args.hasFailed();
+    }
+    if (!valid)
+        GP_WARN("GL capture '%s' is truncated or corrupt.", path);
+
+    // Delete what the replay created and left, without counting it.
+    __counting = false;
+    glcUseProgram(0);
+    glcBindBuffer(GL_ARRAY_BUFFER, 0);
+    glcBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    for (std::map<GLuint, GLuint>::const_iterator itr = names.buffers.begin(); itr != names.buffers.end(); ++itr)
+        glcDeleteBuffers(1, &itr->second);
+    for (std::map<GLuint, GLuint>::const_iterator itr = names.framebuffers.begin(); itr != names.framebuffers.end(); ++itr)
+        glcDeleteFramebuffers(1, &itr->second);
+    for (std::map<GLuint, GLuint>::const_iterator itr = names.renderbuffers.begin(); itr != names.renderbuffers.end(); ++itr)
+        glcDeleteRenderbuffers(1, &itr->second);
+    for (std::map<GLuint, GLuint>::const_iterator itr = names.textures.begin(); itr != names.textures.end(); ++itr)
+        glcDeleteTextures(1, &itr->second);
+    for (std::map<GLuint, GLuint>::const_iterator itr = names.vertexArrays.begin(); itr != names.vertexArrays.end(); ++itr)
+        glcDeleteVertexArrays(1, &itr->second);
+    for (std::map<GLuint, GLuint>::const_iterator itr = names.shaders.begin(); itr != names.shaders.end(); ++itr)
+        glcDeleteShader(itr->second);
+    for (std::map<GLuint, GLuint>::const_iterator itr = names.programs.begin(); itr != names.programs.end(); ++itr)
+        glcDeleteProgram(itr->second);
+    __counting = true;
+    __replaying = false;
+
+    SAFE_DELETE_ARRAY(data);
+    return valid;
+}
+
+unsigned int GLCapture::getFunctionCount()
+{
+    return GLC_FUNCTION_COUNT;
+}
+
+const char* GLCapture::getFunctionName(unsigned int function)
+{
+    GP_ASSERT(function < GLC_FUNCTION_COUNT);
+    return __functionNames[function];
+}
+
+unsigned int GLCapture::getCallCount(unsigned int function)
+{
+    GP_ASSERT(function < GLC_FUNCTION_COUNT);
+    return __callCounts[function];
+}
+
+unsigned int GLCapture::getPayloadSize(unsigned int function)
+{
+    GP_ASSERT(function < GLC_FUNCTION_COUNT);
+    return __payloadSizes[function];
+}
+
+unsigned int GLCapture::getTotalCallCount()
+{
+    return __totalCalls;
+}
+
+unsigned int GLCapture::getFrameCallCount()
+{
+    return __frameCalls;
+}
+
+void GLCapture::resetCounts()
+{
+    memset(__callCounts, 0, sizeof(__callCounts));
+    memset(__payloadSizes, 0, sizeof(__payloadSizes));
+    __totalCalls = 0;
+    __frameStartCalls = 0;
+}
+
+void GLCapture::writeSummary(FILE* file)
+{
+    GP_ASSERT(file);
+
+    fprintf(file, "{\n  \"calls\": %u,\n  \"functions\": [", __totalCalls);
+    bool first = true;
+    for (unsigned int i = 0; i < GLC_FUNCTION_COUNT; ++i)
+    {
+        if (__callCounts[i] == 0)
+            continue;
+        fprintf(file, "%s\n    { \"name\": \"%s\", \"calls\": %u, \"bytes\": %u }", first ? "" : ",", __functionNames[i], __callCounts[i], __payloadSizes[i]);
+        first = false;
+    }
+    fprintf(file, "\n  ]\n}\n");
+}
+
+void GLCapture::initialize(Properties* properties)
+{
+    if (properties == NULL)
+        return;
+
+    setNullRenderer(properties->getBool("nullRenderer"));
+    if (properties->exists("file"))
+    {
+        int frames = properties->getInt("frames");
+        start(properties->getString("file"), frames > 0 ? frames : 0);
+    }
+}
+
+bool GLCapture::initializeHeadless(Properties* config)
+{
+    if (!isAvailable() || config == NULL)
+        return false;
+
+    Properties* properties = config->getNamespace("glCapture", true);
+    if (properties == NULL || !properties->getBool("nullRenderer"))
+        return false;
+
+    setNullRenderer(true);
+    return true;
+}
+
+void GLCapture::endFrame()
+{
+    __frameCalls = __totalCalls - __frameStartCalls;
+    __frameStartCalls = __totalCalls;
+
+    if (isWriting())
+    {
+        {
+            Record record(GLC_END_FRAME);
+        }
+        if (++__frames == __frameLimit)
+            stop();
+    }
+}
+
+void GLCapture::finalize()
+{
+    stop();
+}
+
+}
+
+using namespace gameplay;
+
+void glcActiveTexture(GLenum texture)
+{
+    Record record(GLC_ACTIVE_TEXTURE);
+    record.put(texture);
+    if (!__nullRenderer)
+        glActiveTexture(texture);
+}
+
+void glcAttachShader(GLuint program, GLuint shader)
+{
+    Record record(GLC_ATTACH_SHADER);
+    record.put(program);
+    record.put(shader);
+    if (!__nullRenderer)
+        glAttachShader(program, shader);
+    else
+        __nullPrograms[program].shaders.push_back(shader);
+}
+
+void glcBindBuffer(GLenum target, GLuint buffer)
+{
+    Record record(GLC_BIND_BUFFER);
+    record.put(target);
+    record.put(buffer);
+    if (target == GL_ARRAY_BUFFER)
+        __arrayBuffer = buffer;
+    else if (target == GL_ELEMENT_ARRAY_BUFFER)
+        __elementBuffer = buffer;
+    if (!__nullRenderer)
+        glBindBuffer(target, buffer);
+}
+
+void glcBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    Record record(GLC_BIND_FRAMEBUFFER);
+    record.put(target);
+    record.put(framebuffer);
+    __framebuffer = framebuffer;
+    if (!__nullRenderer)
+        glBindFramebuffer(target, framebuffer);
+}
+
+void glcBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    Record record(GLC_BIND_RENDERBUFFER);
+    record.put(target);
+    record.put(renderbuffer);
+    if (!__nullRenderer)
+        glBindRenderbuffer(target, renderbuffer);
+}
+
+void glcBindTexture(GLenum target, GLuint texture)
+{
+    Record record(GLC_BIND_TEXTURE);
+    record.put(target);
+    record.put(texture);
+    if (target == GL_TEXTURE_2D)
+        __texture = texture;
+    if (!__nullRenderer)
+        glBindTexture(target, texture);
+}
+
+void glcBindVertexArray(GLuint array)
+{
+    Record record(GLC_BIND_VERTEX_ARRAY);
+    record.put(array);
+    __vertexArray = array;
+#ifdef USE_VAO
+    if (!__nullRenderer)
+        glBindVertexArray(array);
+#endif
+}
+
+void glcBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    Record record(GLC_BLEND_FUNC);
+    record.put(sfactor);
+    record.put(dfactor);
+    if (!__nullRenderer)
+        glBlendFunc(sfactor, dfactor);
+}
+
+void glcBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage)
+{
+    Record record(GLC_BUFFER_DATA);
+    record.put(target);
+    record.put((GLuint)size);
+    record.put(usage);
+    record.put((GLubyte)(data != NULL));
+    if (data)
+        record.put(data, (unsigned int)size);
+    if (!__nullRenderer)
+        glBufferData(target, size, data, usage);
+}
+
+void glcBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data)
+{
+    Record record(GLC_BUFFER_SUB_DATA);
+    record.put(target);
+    record.put((GLuint)offset);
+    record.put((GLuint)size);
+    record.put(data, (unsigned int)size);
+    if (!__nullRenderer)
+        glBufferSubData(target, offset, size, data);
+}
+
+GLenum glcCheckFramebufferStatus(GLenum target)
+{
+    Record record(GLC_CHECK_FRAMEBUFFER_STATUS);
+    record.put(target);
+    return __nullRenderer ? GL_FRAMEBUFFER_COMPLETE : glCheckFramebufferStatus(target);
+}
+
+void glcClear(GLbitfield mask)
+{
+    Record record(GLC_CLEAR);
+    record.put(mask);
+    if (!__nullRenderer)
+        glClear(mask);
+}
+
+void glcClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+    Record record(GLC_CLEAR_COLOR);
+    record.put((GLfloat)red);
+    record.put((GLfloat)green);
+    record.put((GLfloat)blue);
+    record.put((GLfloat)alpha);
+    if (!__nullRenderer)
+        glClearColor(red, green, blue, alpha);
+}
+
+void glcClearDepth(GLclampf depth)
+{
+    Record record(GLC_CLEAR_DEPTH);
+    record.put((GLfloat)depth);
+    if (!__nullRenderer)
+        glClearDepth(depth);
+}
+
+void glcClearStencil(GLint s)
+{
+    Record record(GLC_CLEAR_STENCIL);
+    record.put(s);
+    if (!__nullRenderer)
+        glClearStencil(s);
+}
+
+void glcCompileShader(GLuint shader)
+{
+    Record record(GLC_COMPILE_SHADER);
+    record.put(shader);
+    if (!__nullRenderer)
+        glCompileShader(shader);
+}
+
+void glcCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data)
+{
+    Record record(GLC_COMPRESSED_TEX_IMAGE_2D);
+    record.put(target);
+    record.put(level);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+    record.put(border);
+    record.put(imageSize);
+    record.put((GLubyte)(data != NULL));
+    if (data)
+        record.put(data, imageSize);
+    if (!__nullRenderer)
+        glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+}
+
+GLuint glcCreateProgram()
+{
+    Record record(GLC_CREATE_PROGRAM);
+    GLuint program;
+    if (!__nullRenderer)
+    {
+        program = glCreateProgram();
+    }
+    else
+    {
+        program = __nullNextName++;
+        __nullPrograms[program] = NullProgram();
+    }
+    record.put(program);
+    return program;
+}
+
+GLuint glcCreateShader(GLenum type)
+{
+    Record record(GLC_CREATE_SHADER);
+    record.put(type);
+    GLuint shader;
+    if (!__nullRenderer)
+    {
+        shader = glCreateShader(type);
+    }
+    else
+    {
+        shader = __nullNextName++;
+        __nullShaders[shader] = std::string();
+    }
+    record.put(shader);
+    return shader;
+}
+
+void glcDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    Record record(GLC_DELETE_BUFFERS);
+    record.put(n);
+    record.put(buffers, n * sizeof(GLuint));
+    if (!__nullRenderer)
+        glDeleteBuffers(n, buffers);
+}
+
+void glcDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+    Record record(GLC_DELETE_FRAMEBUFFERS);
+    record.put(n);
+    record.put(framebuffers, n * sizeof(GLuint));
+    if (!__nullRenderer)
+        glDeleteFramebuffers(n, framebuffers);
+}
+
+void glcDeleteProgram(GLuint program)
+{
+    Record record(GLC_DELETE_PROGRAM);
+    record.put(program);
+    if (!__nullRenderer)
+        glDeleteProgram(program);
+    else
+        __nullPrograms.erase(program);
+}
+
+void glcDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+    Record record(GLC_DELETE_RENDERBUFFERS);
+    record.put(n);
+    record.put(renderbuffers, n * sizeof(GLuint));
+    if (!__nullRenderer)
+        glDeleteRenderbuffers(n, renderbuffers);
+}
+
+void glcDeleteShader(GLuint shader)
+{
+    Record record(GLC_DELETE_SHADER);
+    record.put(shader);
+    if (!__nullRenderer)
+        glDeleteShader(shader);
+    else
+        __nullShaders.erase(shader);
+}
+
+void glcDeleteTextures(GLsizei n, const GLuint* textures)
+{
+    Record record(GLC_DELETE_TEXTURES);
+    record.put(n);
+    record.put(textures, n * sizeof(GLuint));
+    if (!__nullRenderer)
+        glDeleteTextures(n, textures);
+}
+
+void glcDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+    Record record(GLC_DELETE_VERTEX_ARRAYS);
+    record.put(n);
+    record.put(arrays, n * sizeof(GLuint));
+#ifdef USE_VAO
+    if (!__nullRenderer)
+        glDeleteVertexArrays(n, arrays);
+#endif
+}
+
+void glcDepthMask(GLboolean flag)
+{
+    Record record(GLC_DEPTH_MASK);
+    record.put((GLubyte)flag);
+    if (!__nullRenderer)
+        glDepthMask(flag);
+}
+
+void glcDisable(GLenum cap)
+{
+    Record record(GLC_DISABLE);
+    record.put(cap);
+    if (!__nullRenderer)
+        glDisable(cap);
+}
+
+void glcDisableVertexAttribArray(GLuint index)
+{
+    Record record(GLC_DISABLE_VERTEX_ATTRIB_ARRAY);
+    record.put(index);
+    if (index < GL_CAPTURE_MAX_ATTRIBUTES && __vertexArray == 0)
+        __attributes[index].enabled = false;
+    if (!__nullRenderer)
+        glDisableVertexAttribArray(index);
+}
+
+void glcDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    recordClientData(first + count);
+
+    Record record(GLC_DRAW_ARRAYS);
+    record.put(mode);
+    record.put(first);
+    record.put(count);
+    if (!__nullRenderer)
+        glDrawArrays(mode, first, count);
+}
+
+void glcDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+    bool client = __elementBuffer == 0;
+    if (isWriting() && hasClientAttributes())
+    {
+        // The vertices read by the draw are up to the highest index.
+        if (client && indices)
+        {
+            unsigned int maxIndex = 0;
+            for (GLsizei i = 0; i < count; ++i)
+            {
+                unsigned int index = type == GL_UNSIGNED_BYTE ? ((const GLubyte*)indices)[i] :
+                    type == GL_UNSIGNED_SHORT ? ((const GLushort*)indices)[i] : ((const GLuint*)indices)[i];
+                maxIndex = std::max(maxIndex, index);
+            }
+            recordClientData(maxIndex + 1);
+        }
+        else
+        {
+            GP_WARN("Failed to capture the client-side vertex data of a draw with indices in a buffer.");
+        }
+    }
+
+    Record record(GLC_DRAW_ELEMENTS);
+    record.put(mode);
+    record.put(count);
+    record.put(type);
+    record.put((GLubyte)client);
+    if (client)
+        record.put(indices, count * getTypeSize(type));
+    else
+        record.put((GLuint)(size_t)indices);
+    if (!__nullRenderer)
+        glDrawElements(mode, count, type, indices);
+}
+
+void glcEnable(GLenum cap)
+{
+    Record record(GLC_ENABLE);
+    record.put(cap);
+    if (!__nullRenderer)
+        glEnable(cap);
+}
+
+void glcEnableVertexAttribArray(GLuint index)
+{
+    Record record(GLC_ENABLE_VERTEX_ATTRIB_ARRAY);
+    record.put(index);
+    if (index < GL_CAPTURE_MAX_ATTRIBUTES && __vertexArray == 0)
+        __attributes[index].enabled = true;
+    if (!__nullRenderer)
+        glEnableVertexAttribArray(index);
+}
+
+void glcFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    Record record(GLC_FRAMEBUFFER_RENDERBUFFER);
+    record.put(target);
+    record.put(attachment);
+    record.put(renderbuffertarget);
+    record.put(renderbuffer);
+    if (!__nullRenderer)
+        glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+}
+
+void glcFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    Record record(GLC_FRAMEBUFFER_TEXTURE_2D);
+    record.put(target);
+    record.put(attachment);
+    record.put(textarget);
+    record.put(texture);
+    record.put(level);
+    if (!__nullRenderer)
+        glFramebufferTexture2D(target, attachment, textarget, texture, level);
+}
+
+void glcGenBuffers(GLsizei n, GLuint* buffers)
+{
+    Record record(GLC_GEN_BUFFERS);
+    record.put(n);
+    if (!__nullRenderer)
+        glGenBuffers(n, buffers);
+    else
+        genNullNames(n, buffers);
+    record.put(buffers, n * sizeof(GLuint));
+}
+
+void glcGenerateMipmap(GLenum target)
+{
+    Record record(GLC_GENERATE_MIPMAP);
+    record.put(target);
+    if (!__nullRenderer)
+        glGenerateMipmap(target);
+}
+
+void glcGenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    Record record(GLC_GEN_FRAMEBUFFERS);
+    record.put(n);
+    if (!__nullRenderer)
+        glGenFramebuffers(n, framebuffers);
+    else
+        genNullNames(n, framebuffers);
+    record.put(framebuffers, n * sizeof(GLuint));
+}
+
+void glcGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+    Record record(GLC_GEN_RENDERBUFFERS);
+    record.put(n);
+    if (!__nullRenderer)
+        glGenRenderbuffers(n, renderbuffers);
+    else
+        genNullNames(n, renderbuffers);
+    record.put(renderbuffers, n * sizeof(GLuint));
+}
+
+void glcGenTextures(GLsizei n, GLuint* textures)
+{
+    Record record(GLC_GEN_TEXTURES);
+    record.put(n);
+    if (!__nullRenderer)
+        glGenTextures(n, textures);
+    else
+        genNullNames(n, textures);
+    record.put(textures, n * sizeof(GLuint));
+}
+
+void glcGenVertexArrays(GLsizei n, GLuint* arrays)
+{
+    Record record(GLC_GEN_VERTEX_ARRAYS);
+    record.put(n);
+#ifdef USE_VAO
+    if (!__nullRenderer)
+        glGenVertexArrays(n, arrays);
+    else
+#endif
+        genNullNames(n, arrays);
+    record.put(arrays, n * sizeof(GLuint));
+}
+
+void glcGetActiveAttrib(GLuint program, GLuint index, GLsizei bufsize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    Record record(GLC_GET_ACTIVE_ATTRIB);
+    record.put(program);
+    record.put(index);
+    record.put(bufsize);
+    if (!__nullRenderer)
+        glGetActiveAttrib(program, index, bufsize, length, size, type, name);
+    else
+        getNullActiveVariable(program, index, bufsize, length, size, type, name, false);
+}
+
+void glcGetActiveUniform(GLuint program, GLuint index, GLsizei bufsize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    Record record(GLC_GET_ACTIVE_UNIFORM);
+    record.put(program);
+    record.put(index);
+    record.put(bufsize);
+    if (!__nullRenderer)
+        glGetActiveUniform(program, index, bufsize, length, size, type, name);
+    else
+        getNullActiveVariable(program, index, bufsize, length, size, type, name, true);
+}
+
+GLint glcGetAttribLocation(GLuint program, const GLchar* name)
+{
+    Record record(GLC_GET_ATTRIB_LOCATION);
+    record.put(program);
+    record.putString(name);
+    GLint location;
+    if (!__nullRenderer)
+    {
+        location = glGetAttribLocation(program, name);
+    }
+    else
+    {
+        const NullVariable* attribute = findNullVariable(program, name, false);
+        location = attribute ? attribute->location : -1;
+    }
+    record.put(location);
+    return location;
+}
+
+GLenum glcGetError()
+{
+    // Errors are checked after every call in debug builds, so they are neither counted nor written.
+    return __nullRenderer ? GL_NO_ERROR : glGetError();
+}
+
+void glcGetIntegerv(GLenum pname, GLint* params)
+{
+    Record record(GLC_GET_INTEGERV);
+    record.put(pname);
+    if (!__nullRenderer)
+    {
+        glGetIntegerv(pname, params);
+        return;
+    }
+
+    switch (pname)
+    {
+    case GL_MAX_VERTEX_ATTRIBS:
+        *params = GL_CAPTURE_MAX_ATTRIBUTES;
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        *params = 4096;
+        break;
+    case GL_FRAMEBUFFER_BINDING:
+        *params = __framebuffer;
+        break;
+    case GL_TEXTURE_BINDING_2D:
+        *params = __texture;
+        break;
+#ifdef GL_MAX_COLOR_ATTACHMENTS
+    case GL_MAX_COLOR_ATTACHMENTS:
+        *params = 4;
+        break;
+#endif
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+void glcGetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* length, GLchar* infolog)
+{
+    Record record(GLC_GET_PROGRAM_INFO_LOG);
+    record.put(program);
+    record.put(bufsize);
+    if (!__nullRenderer)
+    {
+        glGetProgramInfoLog(program, bufsize, length, infolog);
+        return;
+    }
+    if (bufsize > 0)
+        infolog[0] = '\0';
+    if (length)
+        *length = 0;
+}
+
+void glcGetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+    Record record(GLC_GET_PROGRAMIV);
+    record.put(program);
+    record.put(pname);
+    if (!__nullRenderer)
+    {
+        glGetProgramiv(program, pname, params);
+        return;
+    }
+
+    const NullProgram& nullProgram = __nullPrograms[program];
+    switch (pname)
+    {
+    case GL_LINK_STATUS:
+        *params = GL_TRUE;
+        break;
+    case GL_ACTIVE_ATTRIBUTES:
+        *params = nullProgram.attributes.size();
+        break;
+    case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+        *params = getNullMaxNameLength(nullProgram.attributes);
+        break;
+    case GL_ACTIVE_UNIFORMS:
+        *params = nullProgram.uniforms.size();
+        break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+        *params = getNullMaxNameLength(nullProgram.uniforms);
+        break;
+    default:
+        *params = 0;
+        break;
+    }
+}
+
+void glcGetShaderInfoLog(GLuint shader, GLsizei bufsize, GLsizei* length, GLchar* infolog)
+{
+    Record record(GLC_GET_SHADER_INFO_LOG);
+    record.put(shader);
+    record.put(bufsize);
+    if (!__nullRenderer)
+    {
+        glGetShaderInfoLog(shader, bufsize, length, infolog);
+        return;
+    }
+    if (bufsize > 0)
+        infolog[0] = '\0';
+    if (length)
+        *length = 0;
+}
+
+void glcGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+    Record record(GLC_GET_SHADERIV);
+    record.put(shader);
+    record.put(pname);
+    if (!__nullRenderer)
+        glGetShaderiv(shader, pname, params);
+    else
+        *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+const GLubyte* glcGetString(GLenum name)
+{
+    Record record(GLC_GET_STRING);
+    record.put(name);
+    if (!__nullRenderer)
+        return glGetString(name);
+
+    switch (name)
+    {
+    case GL_VENDOR:
+        return (const GLubyte*)"gameplay";
+    case GL_RENDERER:
+        return (const GLubyte*)"null";
+    case GL_VERSION:
+        return (const GLubyte*)"2.0 null";
+    default:
+        return (const GLubyte*)"";
+    }
+}
+
+GLint glcGetUniformLocation(GLuint program, const GLchar* name)
+{
+    Record record(GLC_GET_UNIFORM_LOCATION);
+    record.put(program);
+    record.putString(name);
+    GLint location;
+    if (!__nullRenderer)
+    {
+        location = glGetUniformLocation(program, name);
+    }
+    else
+    {
+        const NullVariable* uniform = findNullVariable(program, name, true);
+        location = uniform ? uniform->location : -1;
+    }
+    record.put(location);
+    return location;
+}
+
+void glcLinkProgram(GLuint program)
+{
+    Record record(GLC_LINK_PROGRAM);
+    record.put(program);
+    if (!__nullRenderer)
+    {
+        glLinkProgram(program);
+        return;
+    }
+
+    NullProgram& nullProgram = __nullPrograms[program];
+    nullProgram.attributes.clear();
+    nullProgram.uniforms.clear();
+    for (unsigned int i = 0, count = nullProgram.shaders.size(); i < count; ++i)
+        reflectShader(__nullShaders[nullProgram.shaders[i]], nullProgram);
+}
+
+void glcRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    Record record(GLC_RENDERBUFFER_STORAGE);
+    record.put(target);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+    if (!__nullRenderer)
+        glRenderbufferStorage(target, internalformat, width, height);
+}
+
+void glcScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    Record record(GLC_SCISSOR);
+    record.put(x);
+    record.put(y);
+    record.put(width);
+    record.put(height);
+    if (!__nullRenderer)
+        glScissor(x, y, width, height);
+}
+
+void glcShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+    Record record(GLC_SHADER_SOURCE);
+    record.put(shader);
+    record.put(count);
+    for (GLsizei i = 0; i < count; ++i)
+        record.putString(string[i], length ? length[i] : -1);
+
+    if (!__nullRenderer)
+    {
+        glShaderSource(shader, count, (const GLchar**)string, length);
+        return;
+    }
+
+    std::string& source = __nullShaders[shader];
+    source.clear();
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (length && length[i] >= 0)
+            source.append(string[i], length[i]);
+        else
+            source.append(string[i]);
+    }
+}
+
+void glcTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    Record record(GLC_TEX_IMAGE_2D);
+    record.put(target);
+    record.put(level);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+    record.put(border);
+    record.put(format);
+    record.put(type);
+    record.put((GLubyte)(pixels != NULL));
+    if (pixels)
+        record.put(pixels, getImageSize(width, height, format, type));
+    if (!__nullRenderer)
+        glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+void glcTexParameterf(GLenum target, GLenum pname, GLfloat param)
+{
+    Record record(GLC_TEX_PARAMETERF);
+    record.put(target);
+    record.put(pname);
+    record.put(param);
+    if (!__nullRenderer)
+        glTexParameterf(target, pname, param);
+}
+
+void glcTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    Record record(GLC_TEX_PARAMETERI);
+    record.put(target);
+    record.put(pname);
+    record.put(param);
+    if (!__nullRenderer)
+        glTexParameteri(target, pname, param);
+}
+
+void glcUniform1f(GLint location, GLfloat x)
+{
+    Record record(GLC_UNIFORM_1F);
+    record.put(location);
+    record.put(x);
+    if (!__nullRenderer)
+        glUniform1f(location, x);
+}
+
+void glcUniform1fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    Record record(GLC_UNIFORM_1FV);
+    record.put(location);
+    record.put(count);
+    record.put(v, count * sizeof(GLfloat));
+    if (!__nullRenderer)
+        glUniform1fv(location, count, v);
+}
+
+void glcUniform1i(GLint location, GLint x)
+{
+    Record record(GLC_UNIFORM_1I);
+    record.put(location);
+    record.put(x);
+    if (!__nullRenderer)
+        glUniform1i(location, x);
+}
+
+void glcUniform1iv(GLint location, GLsizei count, const GLint* v)
+{
+    Record record(GLC_UNIFORM_1IV);
+    record.put(location);
+    record.put(count);
+    record.put(v, count * sizeof(GLint));
+    if (!__nullRenderer)
+        glUniform1iv(location, count, v);
+}
+
+void glcUniform2f(GLint location, GLfloat x, GLfloat y)
+{
+    Record record(GLC_UNIFORM_2F);
+    record.put(location);
+    record.put(x);
+    record.put(y);
+    if (!__nullRenderer)
+        glUniform2f(location, x, y);
+}
+
+void glcUniform2fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    Record record(GLC_UNIFORM_2FV);
+    record.put(location);
+    record.put(count);
+    record.put(v, count * 2 * sizeof(GLfloat));
+    if (!__nullRenderer)
+        glUniform2fv(location, count, v);
+}
+
+void glcUniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
+{
+    Record record(GLC_UNIFORM_3F);
+    record.put(location);
+    record.put(x);
+    record.put(y);
+    record.put(z);
+    if (!__nullRenderer)
+        glUniform3f(location, x, y, z);
+}
+
+void glcUniform3fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    Record record(GLC_UNIFORM_3FV);
+    record.put(location);
+    record.put(count);
+    record.put(v, count * 3 * sizeof(GLfloat));
+    if (!__nullRenderer)
+        glUniform3fv(location, count, v);
+}
+
+void glcUniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+{
+    Record record(GLC_UNIFORM_4F);
+    record.put(location);
+    record.put(x);
+    record.put(y);
+    record.put(z);
+    record.put(w);
+    if (!__nullRenderer)
+        glUniform4f(location, x, y, z, w);
+}
+
+void glcUniform4fv(GLint location, GLsizei count, const GLfloat* v)
+{
+    Record record(GLC_UNIFORM_4FV);
+    record.put(location);
+    record.put(count);
+    record.put(v, count * 4 * sizeof(GLfloat));
+    if (!__nullRenderer)
+        glUniform4fv(location, count, v);
+}
+
+void glcUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    Record record(GLC_UNIFORM_MATRIX_4FV);
+    record.put(location);
+    record.put(count);
+    record.put((GLubyte)transpose);
+    record.put(value, count * 16 * sizeof(GLfloat));
+    if (!__nullRenderer)
+        glUniformMatrix4fv(location, count, transpose, value);
+}
+
+void glcUseProgram(GLuint program)
+{
+    Record record(GLC_USE_PROGRAM);
+    record.put(program);
+    if (!__nullRenderer)
+        glUseProgram(program);
+}
+
+void glcVertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr)
+{
+    bool client = __arrayBuffer == 0;
+    if (indx < GL_CAPTURE_MAX_ATTRIBUTES && __vertexArray == 0)
+    {
+        ClientAttribute& attribute = __attributes[indx];
+        attribute.size = size;
+        attribute.type = type;
+        attribute.normalized = normalized;
+        attribute.stride = stride;
+        attribute.pointer = ptr;
+        attribute.client = client;
+    }
+
+    Record record(GLC_VERTEX_ATTRIB_POINTER);
+    record.put(indx);
+    record.put(size);
+    record.put(type);
+    record.put((GLubyte)normalized);
+    record.put(stride);
+    record.put((GLubyte)client);
+    if (!client)
+        record.put((GLuint)(size_t)ptr);
+
+    // A replayed client-side array is pointed at its data by the client data that precedes the draw.
+    if (!__nullRenderer && !(client && __replaying))
+        glVertexAttribPointer(indx, size, type, normalized, stride, ptr);
+}
+
+void glcViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    Record record(GLC_VIEWPORT);
+    record.put(x);
+    record.put(y);
+    record.put(width);
+    record.put(height);
+    if (!__nullRenderer)
+        glViewport(x, y, width, height);
+}
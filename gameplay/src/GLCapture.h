@@ -0,0 +1,446 @@
+#ifndef GLCAPTURE_H_
+#define GLCAPTURE_H_
+
+namespace gameplay
+{
+
+class Properties;
+
+/**
+ * Defines a shim between the engine and OpenGL that counts and records the GL calls of the engine.
+ *
+ * The shim is selected at build time by defining GP_USE_GL_CAPTURE for the engine and the game.
+ * The GL functions used by the engine are then redirected to wrappers that count the calls and
+ * the bytes of data passed to each GL function, and that can write every call with its data to
+ * a binary stream. Without GP_USE_GL_CAPTURE, GL is called directly and nothing is counted.
+ *
+ * The wrappers can also run against a null renderer, which makes no GL calls: it hands out names,
+ * reports shaders as compiled and linked, and reflects the attributes and uniforms declared by the
+ * shader source, so the engine submits the same work it would to a GPU. This measures the CPU cost
+ * of rendering on machines without a GPU.
+ *
+ * A stream can be replayed against the current GL context, such as a software GL, or against the
+ * null renderer to measure the cost of submitting its calls. Replay maps the names and uniform
+ * locations of the stream to those created while replaying, and assumes vertex attribute locations
+ * are assigned as they were when the stream was recorded.
+ *
+ * The shim is configured by the glCapture section of game.config:
+ * @code
+ * glCapture
+ * {
+ *     file = frames.glc
+ *     frames = 300
+ *     nullRenderer = true
+ * }
+ * @endcode
+ * The stream starts with the first GL call of the game, so it holds the resources the frames use.
+ *
+ * When the null renderer is enabled by game.config, the desktop platforms start the game without
+ * a window or GL context and run its frames until it exits, so it can run on build machines that
+ * have no GPU or display. The game must then exit by itself, as the benchmarks do, or through an
+ * input replay with exitAtEnd (see InputRecorder).
+ *
+ * @script{ignore}
+ */
+class GLCapture
+{
+    friend class Game;
+    friend class Platform;
+
+public:
+
+    /**
+     * Determines whether the engine was built with the shim, so its GL calls are counted and can be recorded.
+     *
+     * @return true if the engine was built with GP_USE_GL_CAPTURE.
+     */
+    static bool isAvailable();
+
+    /**
+     * Starts writing the GL calls to a stream, stopping any stream being written.
+     *
+     * @param path The path of the stream to write.
+     * @param frameCount The number of frames after which to stop, or zero to write until stop is called.
+     *
+     * @return true if the stream was opened, false if it could not be or the shim is not available.
+     */
+    static bool start(const char* path, unsigned int frameCount = 0);
+
+    /**
+     * Stops writing the GL calls and closes the stream.
+     */
+    static void stop();
+
+    /**
+     * Determines whether the GL calls are being written to a stream.
+     *
+     * @return true if a stream is being written.
+     */
+    static bool isCapturing();
+
+    /**
+     * Enables or disables the null renderer, which makes no GL calls.
+     *
+     * The null renderer must be enabled before the first GL call, since the names created by GL
+     * are not known to it.
+     *
+     * @param enabled true to stop calling GL.
+     */
+    static void setNullRenderer(bool enabled);
+
+    /**
+     * Determines whether the null renderer is enabled.
+     *
+     * @return true if GL is not called.
+     */
+    static bool isNullRenderer();
+
+    /**
+     * Replays a stream against the current GL context, or the null renderer when it is enabled.
+     *
+     * The replayed calls are counted like the calls of the engine. The names created by the
+     * replay are deleted when it ends.
+     *
+     * @param path The path of the stream to replay.
+     *
+     * @return true if the whole stream was replayed.
+     */
+    static bool replay(const char* path);
+
+    /**
+     * Gets the number of GL functions that are counted.
+     *
+     * @return The number of functions.
+     */
+    static unsigned int getFunctionCount();
+
+    /**
+     * Gets the name of a counted GL function.
+     *
+     * @param function The index of the function.
+     *
+     * @return The name of the function, such as "glDrawElements".
+     */
+    static const char* getFunctionName(unsigned int function);
+
+    /**
+     * Gets the number of calls of a GL function since the counts were reset.
+     *
+     * @param function The index of the function.
+     *
+     * @return The number of calls.
+     */
+    static unsigned int getCallCount(unsigned int function);
+
+    /**
+     * Gets the bytes of data passed to a GL function since the counts were reset,
+     * including the arguments and the data read by GL, such as buffer and texture data.
+     *
+     * @param function The index of the function.
+     *
+     * @return The number of bytes.
+     */
+    static unsigned int getPayloadSize(unsigned int function);
+
+    /**
+     * Gets the number of GL calls since the counts were reset.
+     *
+     * @return The number of calls.
+     */
+    static unsigned int getTotalCallCount();
+
+    /**
+     * Gets the number of GL calls made in the last frame.
+     *
+     * @return The number of calls.
+     */
+    static unsigned int getFrameCallCount();
+
+    /**
+     * Resets the call counts and payload sizes of the GL functions.
+     */
+    static void resetCounts();
+
+    /**
+     * Writes the call counts and payload sizes of the GL functions as JSON, so they can be
+     * compared between builds to catch changes in the calls the engine makes.
+     *
+     * @param file The file to write to.
+     */
+    static void writeSummary(FILE* file);
+
+private:
+
+    /**
+     * Constructor.
+     */
+    GLCapture();
+
+    /**
+     * Sets the null renderer and starts the stream from the glCapture section of game.config.
+     *
+     * Called by the Game before it makes any GL call.
+     */
+    static void initialize(Properties* properties);
+
+    /**
+     * Determines whether the game runs without a window or GL context, which is when the engine
+     * is built with the shim and the glCapture section of game.config enables the null renderer.
+     * The null renderer is then enabled right away, since the platform makes no GL calls after.
+     *
+     * Called by the Platform before it creates the window.
+     *
+     * @param config The configuration of the game, or NULL.
+     *
+     * @return true if the platform must not create a window or GL context.
+     */
+    static bool initializeHeadless(Properties* config);
+
+    /**
+     * Marks the end of a frame in the stream and publishes the call count of the frame.
+     *
+     * Called by the Game at the end of every frame.
+     */
+    static void endFrame();
+
+    /**
+     * Stops the stream.
+     *
+     * Called by the Game when it shuts down.
+     */
+    static void finalize();
+};
+
+}
+
+// The wrappers that the GL functions used by the engine are redirected to.
+#if defined(GP_USE_GL_CAPTURE) || defined(GP_GL_CAPTURE_IMPLEMENTATION)
+void glcActiveTexture(GLenum texture);
+void glcAttachShader(GLuint program, GLuint shader);
+void glcBindBuffer(GLenum target, GLuint buffer);
+void glcBindFramebuffer(GLenum target, GLuint framebuffer);
+void glcBindRenderbuffer(GLenum target, GLuint renderbuffer);
+void glcBindTexture(GLenum target, GLuint texture);
+void glcBindVertexArray(GLuint array);
+void glcBlendFunc(GLenum sfactor, GLenum dfactor);
+void glcBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage);
+void glcBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data);
+GLenum glcCheckFramebufferStatus(GLenum target);
+void glcClear(GLbitfield mask);
+void glcClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+void glcClearDepth(GLclampf depth);
+void glcClearStencil(GLint s);
+void glcCompileShader(GLuint shader);
+void glcCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data);
+GLuint glcCreateProgram();
+GLuint glcCreateShader(GLenum type);
+void glcDeleteBuffers(GLsizei n, const GLuint* buffers);
+void glcDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void glcDeleteProgram(GLuint program);
+void glcDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+void glcDeleteShader(GLuint shader);
+void glcDeleteTextures(GLsizei n, const GLuint* textures);
+void glcDeleteVertexArrays(GLsizei n, const GLuint* arrays);
+void glcDepthMask(GLboolean flag);
+void glcDisable(GLenum cap);
+void glcDisableVertexAttribArray(GLuint index);
+void glcDrawArrays(GLenum mode, GLint first, GLsizei count);
+void glcDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+void glcEnable(GLenum cap);
+void glcEnableVertexAttribArray(GLuint index);
+void glcFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+void glcFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+void glcGenBuffers(GLsizei n, GLuint* buffers);
+void glcGenerateMipmap(GLenum target);
+void glcGenFramebuffers(GLsizei n, GLuint* framebuffers);
+void glcGenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+void glcGenTextures(GLsizei n, GLuint* textures);
+void glcGenVertexArrays(GLsizei n, GLuint* arrays);
+void glcGetActiveAttrib(GLuint program, GLuint index, GLsizei bufsize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+void glcGetActiveUniform(GLuint program, GLuint index, GLsizei bufsize, GLsizei* length, GLint* size, GLenum* type, GLchar* name);
+GLint glcGetAttribLocation(GLuint program, const GLchar* name);
+GLenum glcGetError();
+void glcGetIntegerv(GLenum pname, GLint* params);
+void glcGetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* length, GLchar* infolog);
+void glcGetProgramiv(GLuint program, GLenum pname, GLint* params);
+void glcGetShaderInfoLog(GLuint shader, GLsizei bufsize, GLsizei* length, GLchar* infolog);
+void glcGetShaderiv(GLuint shader, GLenum pname, GLint* params);
+const GLubyte* glcGetString(GLenum name);
+GLint glcGetUniformLocation(GLuint program, const GLchar* name);
+void glcLinkProgram(GLuint program);
+void glcRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+void glcScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+void glcShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void glcTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+void glcTexParameterf(GLenum target, GLenum pname, GLfloat param);
+void glcTexParameteri(GLenum target, GLenum pname, GLint param);
+void glcUniform1f(GLint location, GLfloat x);
+void glcUniform1fv(GLint location, GLsizei count, const GLfloat* v);
+void glcUniform1i(GLint location, GLint x);
+void glcUniform1iv(GLint location, GLsizei count, const GLint* v);
+void glcUniform2f(GLint location, GLfloat x, GLfloat y);
+void glcUniform2fv(GLint location, GLsizei count, const GLfloat* v);
+void glcUniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z);
+void glcUniform3fv(GLint location, GLsizei count, const GLfloat* v);
+void glcUniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+void glcUniform4fv(GLint location, GLsizei count, const GLfloat* v);
+void glcUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+void glcUseProgram(GLuint program);
+void glcVertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr);
+void glcViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+#endif
+
+#if defined(GP_USE_GL_CAPTURE) && !defined(GP_GL_CAPTURE_IMPLEMENTATION)
+// Some GL functions are macros of the platform, such as those loaded by GLEW, so each is undefined first.
+#undef glActiveTexture
+#define glActiveTexture glcActiveTexture
+#undef glAttachShader
+#define glAttachShader glcAttachShader
+#undef glBindBuffer
+#define glBindBuffer glcBindBuffer
+#undef glBindFramebuffer
+#define glBindFramebuffer glcBindFramebuffer
+#undef glBindRenderbuffer
+#define glBindRenderbuffer glcBindRenderbuffer
+#undef glBindTexture
+#define glBindTexture glcBindTexture
+#undef glBlendFunc
+#define glBlendFunc glcBlendFunc
+#undef glBufferData
+#define glBufferData glcBufferData
+#undef glBufferSubData
+#define glBufferSubData glcBufferSubData
+#undef glCheckFramebufferStatus
+#define glCheckFramebufferStatus glcCheckFramebufferStatus
+#undef glClear
+#define glClear glcClear
+#undef glClearColor
+#define glClearColor glcClearColor
+#undef glClearDepth
+#define glClearDepth glcClearDepth
+#undef glClearStencil
+#define glClearStencil glcClearStencil
+#undef glCompileShader
+#define glCompileShader glcCompileShader
+#undef glCompressedTexImage2D
+#define glCompressedTexImage2D glcCompressedTexImage2D
+#undef glCreateProgram
+#define glCreateProgram glcCreateProgram
+#undef glCreateShader
+#define glCreateShader glcCreateShader
+#undef glDeleteBuffers
+#define glDeleteBuffers glcDeleteBuffers
+#undef glDeleteFramebuffers
+#define glDeleteFramebuffers glcDeleteFramebuffers
+#undef glDeleteProgram
+#define glDeleteProgram glcDeleteProgram
+#undef glDeleteRenderbuffers
+#define glDeleteRenderbuffers glcDeleteRenderbuffers
+#undef glDeleteShader
+#define glDeleteShader glcDeleteShader
+#undef glDeleteTextures
+#define glDeleteTextures glcDeleteTextures
+#undef glDepthMask
+#define glDepthMask glcDepthMask
+#undef glDisable
+#define glDisable glcDisable
+#undef glDisableVertexAttribArray
+#define glDisableVertexAttribArray glcDisableVertexAttribArray
+#undef glDrawArrays
+#define glDrawArrays glcDrawArrays
+#undef glDrawElements
+#define glDrawElements glcDrawElements
+#undef glEnable
+#define glEnable glcEnable
+#undef glEnableVertexAttribArray
+#define glEnableVertexAttribArray glcEnableVertexAttribArray
+#undef glFramebufferRenderbuffer
+#define glFramebufferRenderbuffer glcFramebufferRenderbuffer
+#undef glFramebufferTexture2D
+#define glFramebufferTexture2D glcFramebufferTexture2D
+#undef glGenBuffers
+#define glGenBuffers glcGenBuffers
+#undef glGenerateMipmap
+#define glGenerateMipmap glcGenerateMipmap
+#undef glGenFramebuffers
+#define glGenFramebuffers glcGenFramebuffers
+#undef glGenRenderbuffers
+#define glGenRenderbuffers glcGenRenderbuffers
+#undef glGenTextures
+#define glGenTextures glcGenTextures
+#undef glGetActiveAttrib
+#define glGetActiveAttrib glcGetActiveAttrib
+#undef glGetActiveUniform
+#define glGetActiveUniform glcGetActiveUniform
+#undef glGetAttribLocation
+#define glGetAttribLocation glcGetAttribLocation
+#undef glGetError
+#define glGetError glcGetError
+#undef glGetIntegerv
+#define glGetIntegerv glcGetIntegerv
+#undef glGetProgramInfoLog
+#define glGetProgramInfoLog glcGetProgramInfoLog
+#undef glGetProgramiv
+#define glGetProgramiv glcGetProgramiv
+#undef glGetShaderInfoLog
+#define glGetShaderInfoLog glcGetShaderInfoLog
+#undef glGetShaderiv
+#define glGetShaderiv glcGetShaderiv
+#undef glGetString
+#define glGetString glcGetString
+#undef glGetUniformLocation
+#define glGetUniformLocation glcGetUniformLocation
+#undef glLinkProgram
+#define glLinkProgram glcLinkProgram
+#undef glRenderbufferStorage
+#define glRenderbufferStorage glcRenderbufferStorage
+#undef glScissor
+#define glScissor glcScissor
+#undef glShaderSource
+#define glShaderSource glcShaderSource
+#undef glTexImage2D
+#define glTexImage2D glcTexImage2D
+#undef glTexParameterf
+#define glTexParameterf glcTexParameterf
+#undef glTexParameteri
+#define glTexParameteri glcTexParameteri
+#undef glUniform1f
+#define glUniform1f glcUniform1f
+#undef glUniform1fv
+#define glUniform1fv glcUniform1fv
+#undef glUniform1i
+#define glUniform1i glcUniform1i
+#undef glUniform1iv
+#define glUniform1iv glcUniform1iv
+#undef glUniform2f
+#define glUniform2f glcUniform2f
+#undef glUniform2fv
+#define glUniform2fv glcUniform2fv
+#undef glUniform3f
+#define glUniform3f glcUniform3f
+#undef glUniform3fv
+#define glUniform3fv glcUniform3fv
+#undef glUniform4f
+#define glUniform4f glcUniform4f
+#undef glUniform4fv
+#define glUniform4fv glcUniform4fv
+#undef glUniformMatrix4fv
+#define glUniformMatrix4fv glcUniformMatrix4fv
+#undef glUseProgram
+#define glUseProgram glcUseProgram
+#undef glVertexAttribPointer
+#define glVertexAttribPointer glcVertexAttribPointer
+#undef glViewport
+#define glViewport glcViewport
+// The vertex array functions are pointers loaded at runtime on the platforms without VAO support.
+#ifdef USE_VAO
+#undef glBindVertexArray
+#undef glDeleteVertexArrays
+#undef glGenVertexArrays
+#define glBindVertexArray glcBindVertexArray
+#define glDeleteVertexArrays glcDeleteVertexArrays
+#define glGenVertexArrays glcGenVertexArrays
+#endif
+#endif
+
+#endif
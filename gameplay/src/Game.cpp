@@ -4,7 +4,16 @@
 #include "RenderState.h"
 #include "FileSystem.h"
 #include "FrameBuffer.h"
+#include "RenderTargetPool.h"
+#include "RenderStats.h"
+#include "InputRecorder.h"
+#include "LoadTrace.h"
+#include "GLCapture.h"
+#include "SpinLock.h"
+#include "FrameArena.h"
 #include "SceneLoader.h"
+#include "Semaphore.h"
+#include "Thread.h"
 
 /** @script{ignore} */
 GLenum __gl_error_code = GL_NO_ERROR;
@@ -17,28 +26,65 @@ namespace gameplay
 static Game* __gameInstance = NULL;
 double Game::_pausedTimeLast = 0.0;
 double Game::_pausedTimeTotal = 0.0;
+float Game::_clockStep = 0.0f;
+double Game::_clockTime = 0.0;
+
+/**
+ * The thread and the work of the simulation when the game is pipelined.
+ */
+struct Game::SimulationPipeline
+{
+    Thread thread;
+    Semaphore start;            // Posted by the game thread to start a simulation.
+    Semaphore done;             // Posted by the simulation thread when it has finished.
+    bool exit;                  // Set to stop the simulation thread.
+    unsigned int updateCount;   // The arguments of the simulation to run.
+    double updateTime;
+    double endTime;
+
+    SimulationPipeline() : exit(false), updateCount(0), updateTime(0), endTime(0)
+    {
+    }
+};
+
+static double endPhase(double* phaseTimes, Game::FramePhase phase, double startTime)
+{
+    double time = Platform::getAbsoluteTime();
+    phaseTimes[phase] += time - startTime;
+    return time;
+}
 
 Game::Game() 
     : _initialized(false), _state(UNINITIALIZED), 
-      _frameLastFPS(0), _frameCount(0), _frameRate(0), 
+      _frameLastFPS(0), _lastFrameTime(0), _simulationTime(0), _accumulatedTime(0),
+      _fixedUpdateRate(0), _maxUpdatesPerFrame(5), _frameUpdateCount(0), _frameInterpolation(1.0f),
+      _pipeline(NULL), _frameCount(0), _frameRate(0), 
       _clearDepth(1.0f), _clearStencil(0), _properties(NULL),
       _animationController(NULL), _audioController(NULL), 
-      _physicsController(NULL), _aiController(NULL), _audioListener(NULL), 
-      _gamepads(NULL), _timeEvents(NULL), _scriptController(NULL), _scriptListeners(NULL)
+      _physicsController(NULL), _aiController(NULL), _frameGovernor(NULL), _lazySubsystems(0),
+      _animationSkippedUpdates(0), _animationElapsedTime(0), _aiSkippedUpdates(0), _aiElapsedTime(0),
+      _audioListener(NULL), 
+      _gamepads(NULL), _timeEvents(NULL), _scriptController(NULL), _scriptListeners(NULL),
+      _timeEventsMutex(NULL), _memoryStatsFile(NULL), _memoryStatsInterval(0), _memoryStatsLastTime(0)
 {
     GP_ASSERT(__gameInstance == NULL);
     __gameInstance = this;
     _gamepads = new std::vector<Gamepad*>;
-    _timeEvents = new std::priority_queue<TimeEvent, std::vector<TimeEvent>, std::less<TimeEvent> >();
+    _timeEvents = new TimerWheel();
+    _timeEventsMutex = new Mutex();
+    _frameGovernor = new FrameGovernor();
+    memset(_phaseTimes, 0, sizeof(_phaseTimes));
+    memset(_simulationPhaseTimes, 0, sizeof(_simulationPhaseTimes));
 }
 
 Game::~Game()
 {
     if (_scriptListeners)
     {
-        for (unsigned int i = 0; i < _scriptListeners->size(); i++)
+        std::map<std::string, ScriptListener*>::iterator itr;
+        for (itr = _scriptListeners->begin(); itr != _scriptListeners->end(); ++itr)
         {
-            SAFE_DELETE((*_scriptListeners)[i]);
+            SAFE_DELETE(itr->second);
         }
         SAFE_DELETE(_scriptListeners);
     }
@@ -52,6 +98,8 @@ Game::~Game()
     // Do not call any virtual functions from the destructor.
     // Finalization is done from outside this class.
     SAFE_DELETE(_timeEvents);
+    SAFE_DELETE(_timeEventsMutex);
+    SAFE_DELETE(_frameGovernor);
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
     Ref::printLeaks();
     printMemoryLeaks();
@@ -71,9 +119,29 @@ double Game::getAbsoluteTime()
 
 double Game::getGameTime()
 {
+    if (_clockStep > 0)
+        return _clockTime;
     return Platform::getAbsoluteTime() - _pausedTimeTotal;
 }
 
+void Game::setClockStep(float step)
+{
+    GP_ASSERT(step >= 0);
+
+    // Continue from the current game time when switching clocks.
+    double time = getGameTime();
+    _clockStep = step;
+    if (step > 0)
+        _clockTime = time;
+    else
+        _pausedTimeTotal = Platform::getAbsoluteTime() - time;
+}
+
+float Game::getClockStep()
+{
+    return _clockStep;
+}
+
 void Game::setVsync(bool enable)
 {
     Platform::setVsync(enable);
@@ -108,26 +176,82 @@ bool Game::startup()
     if (_state != UNINITIALIZED)
         return false;
 
+    // Start tracing and capturing the GL calls before anything is loaded, when enabled by the configuration.
+    if (_properties)
+    {
+        Properties* loadTrace = _properties->getNamespace("loadTrace", true);
+        if (loadTrace)
+            LoadTrace::initialize(loadTrace);
+        Properties* glCapture = _properties->getNamespace("glCapture", true);
+        if (glCapture)
+            GLCapture::initialize(glCapture);
+    }
+
     setViewport(Rectangle(0.0f, 0.0f, (float)_width, (float)_height));
     RenderState::initialize();
     FrameBuffer::initialize();
     
-    _animationController = new AnimationController();
-    _animationController->initialize();
+    // Create the controllers, except those created when they are first used.
+    loadSubsystems();
+    if (!(_lazySubsystems & SUBSYSTEM_ANIMATION))
+        createSubsystem(SUBSYSTEM_ANIMATION);
+    if (!(_lazySubsystems & SUBSYSTEM_AUDIO))
+        createSubsystem(SUBSYSTEM_AUDIO);
+    if (!(_lazySubsystems & SUBSYSTEM_PHYSICS))
+        createSubsystem(SUBSYSTEM_PHYSICS);
+    if (!(_lazySubsystems & SUBSYSTEM_AI))
+        createSubsystem(SUBSYSTEM_AI);
 
-    _audioController = new AudioController();
-    _audioController->initialize();
+    loadGamepads();
 
-    _physicsController = new PhysicsController();
-    _physicsController->initialize();
+    // Load the simulation update rate.
+    if (_properties)
+    {
+        Properties* fixedUpdate = _properties->getNamespace("fixedUpdate", true);
+        if (fixedUpdate)
+        {
+            int rate = fixedUpdate->getInt("rate");
+            int maxUpdates = fixedUpdate->exists("maxUpdatesPerFrame") ? fixedUpdate->getInt("maxUpdatesPerFrame") : 5;
+            setFixedUpdateRate(rate > 0 ? rate : 0, maxUpdates > 0 ? maxUpdates : 1);
+        }
 
-    _aiController = new AIController();
-    _aiController->initialize();
+        Properties* frameGovernor = _properties->getNamespace("frameGovernor", true);
+        if (frameGovernor)
+        {
+            _frameGovernor->load(frameGovernor);
+        }
 
-    loadGamepads();
+        Properties* memoryStats = _properties->getNamespace("memoryStats", true);
+        if (memoryStats && memoryStats->exists("dumpFile"))
+        {
+            int interval = memoryStats->exists("dumpInterval") ? memoryStats->getInt("dumpInterval") : 1000;
+            setMemoryStatsDump(memoryStats->getString("dumpFile"), interval > 0 ? interval : 0);
+        }
+
+        Properties* renderStats = _properties->getNamespace("renderStats", true);
+        if (renderStats)
+        {
+            RenderStats::setPassStatsEnabled(renderStats->getBool("passStats"));
+            if (renderStats->exists("overlay"))
+                RenderStats::setOverlay(renderStats->getString("overlay"));
+        }
+
+        Properties* inputRecorder = _properties->getNamespace("inputRecorder", true);
+        if (inputRecorder)
+        {
+            if (inputRecorder->exists("replay"))
+                InputRecorder::startReplay(inputRecorder->getString("replay"), inputRecorder->getBool("exitAtEnd"));
+            else if (inputRecorder->exists("record"))
+                InputRecorder::startRecording(inputRecorder->getString("record"));
+        }
+    }
+    _lastFrameTime = getGameTime();
+    _simulationTime = _lastFrameTime;
     
+    // A lazy script controller creates the Lua state when it is first used.
     _scriptController = new ScriptController();
-    _scriptController->initialize();
+    if (!(_lazySubsystems & SUBSYSTEM_SCRIPT))
+        _scriptController->initialize();
 
     // Set the script callback functions.
     if (_properties)
@@ -174,14 +298,14 @@ void Game::shutdown()
     // Call user finalization.
     if (_state != UNINITIALIZED)
     {
-        GP_ASSERT(_animationController);
-        GP_ASSERT(_audioController);
-        GP_ASSERT(_physicsController);
-        GP_ASSERT(_aiController);
-
         Platform::signalShutdown();
         finalize();
 
+        // Do not create the controllers that were never used while they are torn down.
+        _lazySubsystems = 0;
+
+        setPipelined(false);
+
         
         std::vector<Gamepad*>::iterator itr = _gamepads->begin();
         std::vector<Gamepad*>::iterator end = _gamepads->end();
@@ -195,22 +319,42 @@ void Game::shutdown()
         
         _scriptController->finalizeGame();
 
-        _animationController->finalize();
-        SAFE_DELETE(_animationController);
+        if (_animationController)
+        {
+            _animationController->finalize();
+            SAFE_DELETE(_animationController);
+        }
 
-        _audioController->finalize();
-        SAFE_DELETE(_audioController);
+        if (_audioController)
+        {
+            _audioController->finalize();
+            SAFE_DELETE(_audioController);
+        }
 
-        _physicsController->finalize();
-        SAFE_DELETE(_physicsController);
-        _aiController->finalize();
-        SAFE_DELETE(_aiController);
+        if (_physicsController)
+        {
+            _physicsController->finalize();
+            SAFE_DELETE(_physicsController);
+        }
+        if (_aiController)
+        {
+            _aiController->finalize();
+            SAFE_DELETE(_aiController);
+        }
 
         // Note: we do not clean up the script controller here
         // because users can call Game::exit() from a script.
 
         SAFE_DELETE(_audioListener);
 
+        setMemoryStatsDump(NULL);
+        InputRecorder::stop();
+        LoadTrace::finalize();
+        RenderStats::finalize();
+        GLCapture::finalize();
+
+        RenderTargetPool::finalize();
+        FrameArena::finalize();
         RenderState::finalize();
 
         SAFE_DELETE(_properties);
@@ -223,16 +367,16 @@ void Game::pause()
 {
     if (_state == RUNNING)
     {
-        GP_ASSERT(_animationController);
-        GP_ASSERT(_audioController);
-        GP_ASSERT(_physicsController);
-        GP_ASSERT(_aiController);
         _state = PAUSED;
         _pausedTimeLast = Platform::getAbsoluteTime();
-        _animationController->pause();
-        _audioController->pause();
-        _physicsController->pause();
-        _aiController->pause();
+        if (_animationController)
+            _animationController->pause();
+        if (_audioController)
+            _audioController->pause();
+        if (_physicsController)
+            _physicsController->pause();
+        if (_aiController)
+            _aiController->pause();
     }
 }
 
@@ -240,16 +384,16 @@ void Game::resume()
 {
     if (_state == PAUSED)
     {
-        GP_ASSERT(_animationController);
-        GP_ASSERT(_audioController);
-        GP_ASSERT(_physicsController);
-        GP_ASSERT(_aiController);
         _state = RUNNING;
         _pausedTimeTotal += Platform::getAbsoluteTime() - _pausedTimeLast;
-        _animationController->resume();
-        _audioController->resume();
-        _physicsController->resume();
-        _aiController->resume();
+        if (_animationController)
+            _animationController->resume();
+        if (_audioController)
+            _audioController->resume();
+        if (_physicsController)
+            _physicsController->resume();
+        if (_aiController)
+            _aiController->resume();
     }
 }
 
@@ -265,47 +409,149 @@ void Game::frame()
         initialize();
         _scriptController->initializeGame();
         _initialized = true;
+
+        // Do not count the time spent initializing as elapsed time.
+        _lastFrameTime = getGameTime();
+        _simulationTime = _lastFrameTime;
     }
 
+    // Phase times are collected for the frame in progress and published when it ends.
+    double phaseTimes[PHASE_COUNT];
+    memset(phaseTimes, 0, sizeof(phaseTimes));
+
     if (_state == Game::RUNNING)
     {
-        GP_ASSERT(_animationController);
-        GP_ASSERT(_audioController);
-        GP_ASSERT(_physicsController);
-        GP_ASSERT(_aiController);
+        double frameStartTime = Platform::getAbsoluteTime();
+
+        // Replay the input and the time step of a recorded frame.
+        InputRecorder::beginFrame();
 
         // Update Time.
-        static double lastFrameTime = Game::getGameTime();
+        if (_clockStep > 0)
+            _clockTime += _clockStep;
         double frameTime = getGameTime();
-        float elapsedTime = (frameTime - lastFrameTime);
-        lastFrameTime = frameTime;
+        float elapsedTime = (frameTime - _lastFrameTime);
+        _lastFrameTime = frameTime;
+
+        // Work out the simulation updates to run this frame.
+        unsigned int updateCount;
+        double updateTime;
+        double endTime;
+        float interpolation;
+        if (_fixedUpdateRate > 0)
+        {
+            // Update the simulation in fixed steps, carrying the remainder over to the next frame.
+            updateTime = 1000.0 / _fixedUpdateRate;
+            _accumulatedTime += elapsedTime;
+            updateCount = 0;
+            while (_accumulatedTime >= updateTime && updateCount < _maxUpdatesPerFrame)
+            {
+                _accumulatedTime -= updateTime;
+                ++updateCount;
+            }
 
-        // Update the scheduled and running animations.
-        _animationController->update(elapsedTime);
+            // Drop the time that could not be caught up on, rather than adding it to the next frame.
+            if (_accumulatedTime >= updateTime)
+                _accumulatedTime = fmod(_accumulatedTime, updateTime);
+            endTime = _simulationTime + updateCount * updateTime;
+            interpolation = (float)(_accumulatedTime / updateTime);
+        }
+        else
+        {
+            updateCount = 1;
+            updateTime = elapsedTime;
+            endTime = frameTime;
+            interpolation = 1.0f;
+        }
 
-        // Fire time events to scheduled TimeListeners
-        fireTimeEvents(frameTime);
-    
-        // Update the physics.
-        _physicsController->update(elapsedTime);
+        memset(_simulationPhaseTimes, 0, sizeof(_simulationPhaseTimes));
+        double phaseTime;
 
-        // Update AI.
-        _aiController->update(elapsedTime);
+        if (_pipeline)
+        {
+            // Audio reads the simulation state, so it is updated before the next simulation starts.
+            phaseTime = Platform::getAbsoluteTime();
+            if (_audioController)
+                _audioController->update(elapsedTime);
+            phaseTime = endPhase(phaseTimes, PHASE_AUDIO, phaseTime);
+
+            // The render thread reads the matrices, bounds and visible nodes of the scenes as they
+            // are now, while the simulation thread updates them.
+            Scene::snapshotScenes();
+            snapshot();
+
+            // Simulate the next frame while this one is rendered.
+            _pipeline->updateCount = updateCount;
+            _pipeline->updateTime = updateTime;
+            _pipeline->endTime = endTime;
+            _pipeline->start.post();
+
+            // Graphics Rendering.
+            Scene::setRenderingSnapshot(true);
+            phaseTime = Platform::getAbsoluteTime();
+            render(elapsedTime);
+            phaseTime = endPhase(phaseTimes, PHASE_RENDER, phaseTime);
+
+            // Run script render.
+            _scriptController->render(elapsedTime);
+            endPhase(phaseTimes, PHASE_SCRIPT_RENDER, phaseTime);
+            Scene::setRenderingSnapshot(false);
+
+            // The interpolation of the simulation applies to the snapshot taken next frame.
+            _pipeline->done.wait();
+            _frameUpdateCount = updateCount;
+            _frameInterpolation = interpolation;
+        }
+        else
+        {
+            simulate(updateCount, updateTime, endTime);
+            _frameUpdateCount = updateCount;
+            _frameInterpolation = interpolation;
 
-        // Application Update.
-        update(elapsedTime);
+            phaseTime = Platform::getAbsoluteTime();
 
-        // Run script update.
-        _scriptController->update(elapsedTime);
+            // Audio Rendering.
+            if (_audioController)
+                _audioController->update(elapsedTime);
+            phaseTime = endPhase(phaseTimes, PHASE_AUDIO, phaseTime);
 
-        // Audio Rendering.
-        _audioController->update(elapsedTime);
+            // Graphics Rendering.
+            render(elapsedTime);
+            phaseTime = endPhase(phaseTimes, PHASE_RENDER, phaseTime);
 
-        // Graphics Rendering.
-        render(elapsedTime);
+            // Run script render.
+            _scriptController->render(elapsedTime);
+            endPhase(phaseTimes, PHASE_SCRIPT_RENDER, phaseTime);
+        }
+
+        for (unsigned int i = 0; i < PHASE_COUNT; ++i)
+        {
+            phaseTimes[i] += _simulationPhaseTimes[i];
+        }
 
-        // Run script render.
-        _scriptController->render(elapsedTime);
+        // Adjust the quality of the subsystems to the cost of this frame.
+        // The cost of rendering includes the application's render, which draws the scene.
+        double subsystemTimes[FrameGovernor::SUBSYSTEM_COUNT];
+        subsystemTimes[FrameGovernor::ANIMATION] = phaseTimes[PHASE_ANIMATION];
+        subsystemTimes[FrameGovernor::PHYSICS] = phaseTimes[PHASE_PHYSICS];
+        subsystemTimes[FrameGovernor::AI] = phaseTimes[PHASE_AI];
+        subsystemTimes[FrameGovernor::SCRIPT] = phaseTimes[PHASE_SCRIPT_UPDATE] + phaseTimes[PHASE_SCRIPT_RENDER];
+        // Particle emitters are updated by the application, so they add their own time to the governor.
+        subsystemTimes[FrameGovernor::PARTICLES] = 0;
+        subsystemTimes[FrameGovernor::RENDERING] = phaseTimes[PHASE_RENDER];
+        _frameGovernor->update(Platform::getAbsoluteTime() - frameStartTime, subsystemTimes);
+
+        // Return transient render targets to the pool and publish the render statistics of the frame.
+        RenderTargetPool::endFrame();
+        RenderStats::endFrame();
+        GLCapture::endFrame();
+
+        // Reclaim the transient memory of the frame and record its allocations.
+        FrameArena::endFrame();
+        MemoryTracker::endFrame();
+
+        if (_memoryStatsFile)
+            dumpMemoryStats();
 
         // Update FPS.
         ++_frameCount;
@@ -315,21 +561,113 @@ void Game::frame()
             _frameCount = 0;
             _frameLastFPS = getGameTime();
         }
+
+        // Record the input and the time step of the frame, or finish a replay that reached its last frame.
+        InputRecorder::endFrame(elapsedTime);
     }
     else
     {
+        double phaseTime = Platform::getAbsoluteTime();
+
         // Application Update.
         update(0);
+        phaseTime = endPhase(phaseTimes, PHASE_UPDATE, phaseTime);
 
         // Script update.
         _scriptController->update(0);
+        phaseTime = endPhase(phaseTimes, PHASE_SCRIPT_UPDATE, phaseTime);
 
         // Graphics Rendering.
         render(0);
+        phaseTime = endPhase(phaseTimes, PHASE_RENDER, phaseTime);
 
         // Script render.
         _scriptController->render(0);
+        endPhase(phaseTimes, PHASE_SCRIPT_RENDER, phaseTime);
+
+        // Return transient render targets to the pool and publish the render statistics of the frame.
+        RenderTargetPool::endFrame();
+        RenderStats::endFrame();
+        GLCapture::endFrame();
+
+        // Reclaim the transient memory of the frame and record its allocations.
+        FrameArena::endFrame();
+        MemoryTracker::endFrame();
     }
+
+    memcpy(_phaseTimes, phaseTimes, sizeof(_phaseTimes));
+}
+
+void Game::simulate(unsigned int updateCount, double updateTime, double endTime)
+{
+    float elapsedTime = (float)updateTime;
+    for (unsigned int i = 0; i < updateCount; ++i)
+    {
+        _timeEventsMutex->lock();
+        _simulationTime = endTime - (updateCount - 1 - i) * updateTime;
+        _timeEventsMutex->unlock();
+
+        double phaseTime = Platform::getAbsoluteTime();
+
+        // Update the scheduled and running animations, every few updates when the frame governor has lowered their quality.
+        _animationElapsedTime += elapsedTime;
+        if (++_animationSkippedUpdates >= _frameGovernor->getUpdateInterval(FrameGovernor::ANIMATION))
+        {
+            if (_animationController)
+                _animationController->update(_animationElapsedTime);
+            _animationSkippedUpdates = 0;
+            _animationElapsedTime = 0;
+        }
+        phaseTime = endPhase(_simulationPhaseTimes, PHASE_ANIMATION, phaseTime);
+
+        // Fire time events to scheduled TimeListeners
+        fireTimeEvents(_simulationTime);
+        phaseTime = endPhase(_simulationPhaseTimes, PHASE_TIME_EVENTS, phaseTime);
+
+        // Update the physics.
+        if (_physicsController)
+            _physicsController->update(elapsedTime);
+        phaseTime = endPhase(_simulationPhaseTimes, PHASE_PHYSICS, phaseTime);
+
+        // Update AI, every few updates when the frame governor has lowered its quality.
+        _aiElapsedTime += elapsedTime;
+        if (++_aiSkippedUpdates >= _frameGovernor->getUpdateInterval(FrameGovernor::AI))
+        {
+            if (_aiController)
+                _aiController->update(_aiElapsedTime);
+            _aiSkippedUpdates = 0;
+            _aiElapsedTime = 0;
+        }
+        phaseTime = endPhase(_simulationPhaseTimes, PHASE_AI, phaseTime);
+
+        // Application Update.
+        update(elapsedTime);
+        phaseTime = endPhase(_simulationPhaseTimes, PHASE_UPDATE, phaseTime);
+
+        // Run script update.
+        _scriptController->update(elapsedTime);
+        endPhase(_simulationPhaseTimes, PHASE_SCRIPT_UPDATE, phaseTime);
+    }
+}
+
+void Game::simulationThread(void* game)
+{
+    Game* g = (Game*)game;
+    GP_ASSERT(g && g->_pipeline);
+    SimulationPipeline* pipeline = g->_pipeline;
+    while (true)
+    {
+        pipeline->start.wait();
+        if (pipeline->exit)
+            break;
+
+        g->simulate(pipeline->updateCount, pipeline->updateTime, pipeline->endTime);
+        pipeline->done.post();
+    }
+}
+
+void Game::snapshot()
+{
 }
 
 void Game::renderOnce(const char* function)
@@ -340,25 +678,114 @@ void Game::renderOnce(const char* function)
 
 void Game::updateOnce()
 {
-    GP_ASSERT(_animationController);
-    GP_ASSERT(_audioController);
-    GP_ASSERT(_physicsController);
-    GP_ASSERT(_aiController);
-
     // Update Time.
-    static double lastFrameTime = getGameTime();
     double frameTime = getGameTime();
-    float elapsedTime = (frameTime - lastFrameTime);
-    lastFrameTime = frameTime;
+    float elapsedTime = (frameTime - _lastFrameTime);
+    _lastFrameTime = frameTime;
 
     // Update the internal controllers.
-    _animationController->update(elapsedTime);
-    _physicsController->update(elapsedTime);
-    _aiController->update(elapsedTime);
-    _audioController->update(elapsedTime);
+    if (_animationController)
+        _animationController->update(elapsedTime);
+    if (_physicsController)
+        _physicsController->update(elapsedTime);
+    if (_aiController)
+        _aiController->update(elapsedTime);
+    if (_audioController)
+        _audioController->update(elapsedTime);
     _scriptController->update(elapsedTime);
 }
 
+void Game::setFixedUpdateRate(unsigned int updatesPerSecond, unsigned int maxUpdatesPerFrame)
+{
+    GP_ASSERT(maxUpdatesPerFrame > 0);
+
+    if (updatesPerSecond != _fixedUpdateRate)
+    {
+        // Continue the simulation from the current game time.
+        _simulationTime = getGameTime();
+        _accumulatedTime = 0;
+        _frameInterpolation = updatesPerSecond > 0 ? 0.0f : 1.0f;
+    }
+    _fixedUpdateRate = updatesPerSecond;
+    _maxUpdatesPerFrame = maxUpdatesPerFrame;
+}
+
+double Game::getPhaseTime(FramePhase phase) const
+{
+    GP_ASSERT(phase < PHASE_COUNT);
+    return _phaseTimes[phase];
+}
+
+MemoryStats Game::getMemoryStats() const
+{
+    MemoryStats stats = MemoryStats::capture();
+
+    // The Lua state grows and shrinks with every script allocation, so it is measured when asked for.
+    if (_scriptController && _scriptController->_lua)
+    {
+        lua_State* lua = _scriptController->_lua;
+        MemoryStats::Usage& usage = stats._usage[MemoryStats::SCRIPT];
+        usage.count += 1;
+        usage.cpuBytes += (unsigned int)lua_gc(lua, LUA_GCCOUNT, 0) * 1024 + (unsigned int)lua_gc(lua, LUA_GCCOUNTB, 0);
+    }
+    return stats;
+}
+
+void Game::setMemoryStatsDump(const char* path, unsigned int interval)
+{
+    if (_memoryStatsFile)
+    {
+        fclose(_memoryStatsFile);
+        _memoryStatsFile = NULL;
+    }
+
+    if (path)
+    {
+        _memoryStatsFile = FileSystem::openFile(path, "a");
+        if (_memoryStatsFile == NULL)
+        {
+            GP_WARN("Failed to open memory stats dump file '%s'.", path);
+        }
+    }
+    _memoryStatsInterval = interval;
+    _memoryStatsLastTime = -(double)interval;
+}
+
+void Game::dumpMemoryStats()
+{
+    GP_ASSERT(_memoryStatsFile);
+
+    double time = getGameTime();
+    if (time - _memoryStatsLastTime < _memoryStatsInterval)
+        return;
+    _memoryStatsLastTime = time;
+
+    getMemoryStats().write(_memoryStatsFile, time);
+    fflush(_memoryStatsFile);
+}
+
+void Game::setPipelined(bool pipelined)
+{
+    if (pipelined && _pipeline == NULL)
+    {
+        _pipeline = new SimulationPipeline();
+        if (!_pipeline->thread.start(&Game::simulationThread, this))
+        {
+            GP_WARN("Failed to start the simulation thread; simulation and rendering will not be pipelined.");
+            SAFE_DELETE(_pipeline);
+        }
+    }
+    else if (!pipelined && _pipeline)
+    {
+        // The simulation thread is idle between frames, so it can be stopped right away.
+        _pipeline->exit = true;
+        _pipeline->start.post();
+        _pipeline->thread.join();
+        SAFE_DELETE(_pipeline);
+        Scene::releaseSnapshots();
+    }
+}
+
 void Game::setViewport(const Rectangle& viewport)
 {
     _viewport = viewport;
@@ -438,40 +865,89 @@ void Game::gamepadEvent(Gamepad::GamepadEvent evt, Gamepad* gamepad)
 {
 }
 
-void Game::schedule(float timeOffset, TimeListener* timeListener, void* cookie)
+unsigned int Game::schedule(float timeOffset, TimeListener* timeListener, void* cookie)
 {
     GP_ASSERT(_timeEvents);
-    TimeEvent timeEvent(getGameTime() + timeOffset, timeListener, cookie);
-    _timeEvents->push(timeEvent);
+    Mutex::ScopedLock lock(*_timeEventsMutex);
+    double time = getScheduleTime();
+    return _timeEvents->schedule(time, time + timeOffset, timeListener, cookie);
 }
 
-void Game::schedule(float timeOffset, const char* function)
+unsigned int Game::schedule(float timeOffset, const char* function)
 {
+    GP_ASSERT(function);
+
+    // Reuse the listener of the function if it has been scheduled before.
+    // The listener loads the script, so it is created without holding the lock.
+    ScriptListener* listener = NULL;
+    _timeEventsMutex->lock();
     if (!_scriptListeners)
-        _scriptListeners = new std::vector<ScriptListener*>();
+        _scriptListeners = new std::map<std::string, ScriptListener*>();
+    std::map<std::string, ScriptListener*>::const_iterator itr = _scriptListeners->find(function);
+    if (itr != _scriptListeners->end())
+        listener = itr->second;
+    _timeEventsMutex->unlock();
 
-    ScriptListener* listener = new ScriptListener(function);
-    _scriptListeners->push_back(listener);
-    schedule(timeOffset, listener, NULL);
+    if (listener == NULL)
+    {
+        ScriptListener* newListener = new ScriptListener(function);
+
+        Mutex::ScopedLock lock(*_timeEventsMutex);
+        ScriptListener*& mapped = (*_scriptListeners)[function];
+        if (mapped == NULL)
+            mapped = newListener;
+        else
+            SAFE_DELETE(newListener);
+        listener = mapped;
+    }
+    return schedule(timeOffset, listener, NULL);
+}
+
+bool Game::unschedule(unsigned int timeEventId)
+{
+    GP_ASSERT(_timeEvents);
+    Mutex::ScopedLock lock(*_timeEventsMutex);
+    return _timeEvents->cancel(timeEventId);
+}
+
+void Game::unschedule(TimeListener* timeListener)
+{
+    GP_ASSERT(_timeEvents);
+    Mutex::ScopedLock lock(*_timeEventsMutex);
+    _timeEvents->cancel(timeListener);
 }
 
 void Game::fireTimeEvents(double frameTime)
 {
-    while (_timeEvents->size() > 0)
+    // Take the due events off the wheel before firing any of them, so that events
+    // scheduled by the listeners are not fired until the next update.
+    _timeEventsMutex->lock();
+    unsigned int count = _timeEvents->advance(frameTime);
+    _timeEventsMutex->unlock();
+
+    for (unsigned int i = 0; i < count; ++i)
     {
-        const TimeEvent* timeEvent = &_timeEvents->top();
-        if (timeEvent->time > frameTime)
-        {
-            break;
-        }
-        if (timeEvent->listener)
+        // Events cancelled by the listeners of earlier events are skipped.
+        TimerWheel::Event timeEvent;
+        _timeEventsMutex->lock();
+        bool fire = _timeEvents->expire(i, &timeEvent);
+        _timeEventsMutex->unlock();
+
+        // Do not hold the lock while calling out, since a listener may wait on the game thread.
+        if (fire && timeEvent.listener)
         {
-            timeEvent->listener->timeEvent(frameTime - timeEvent->time, timeEvent->cookie);
+            timeEvent.listener->timeEvent(frameTime - timeEvent.time, timeEvent.cookie);
         }
-        _timeEvents->pop();
     }
 }
 
+double Game::getScheduleTime() const
+{
+    // Time events are fired from the simulation updates, so in fixed update mode
+    // they are measured against the simulation time rather than the game time.
+    return _fixedUpdateRate > 0 ? _simulationTime : getGameTime();
+}
+
 Game::ScriptListener::ScriptListener(const char* url)
 {
     function = Game::getInstance()->getScriptController()->loadUrl(url);
@@ -482,17 +958,6 @@ void Game::ScriptListener::timeEvent(long timeDiff, void* cookie)
     Game::getInstance()->getScriptController()->executeFunction<void>(function.c_str(), "l", timeDiff);
 }
 
-Game::TimeEvent::TimeEvent(double time, TimeListener* timeListener, void* cookie)
-    : time(time), listener(timeListener), cookie(cookie)
-{
-}
-
-bool Game::TimeEvent::operator<(const TimeEvent& v) const
-{
-    // The first element of std::priority_queue is the greatest.
-    return time > v.time;
-}
-
 Properties* Game::getConfig() const
 {
     if (_properties == NULL)
@@ -520,6 +985,85 @@ void Game::loadConfig()
     }
 }
 
+void Game::loadSubsystems()
+{
+    _lazySubsystems = 0;
+    if (_properties == NULL)
+        return;
+
+    Properties* subsystems = _properties->getNamespace("subsystems", true);
+    if (subsystems == NULL)
+        return;
+
+    static const char* names[] = { "animation", "audio", "physics", "ai", "script" };
+    for (unsigned int i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+        const char* value = subsystems->getString(names[i]);
+        if (value == NULL || strcmp(value, "startup") == 0)
+            continue;
+
+        if (strcmp(value, "lazy") == 0)
+            _lazySubsystems |= (1 << i);
+        else
+            GP_WARN("Invalid value '%s' for subsystem '%s'; expected 'startup' or 'lazy'.", value, names[i]);
+    }
+}
+
+void Game::createSubsystem(Subsystem subsystem)
+{
+    // Subsystems can be first used by the simulation thread while the game thread renders.
+    static SpinLock lock;
+    SpinLock::ScopedLock scopedLock(lock);
+
+    // The controller is published after it is initialized, so the other thread never uses it before.
+    switch (subsystem)
+    {
+    case SUBSYSTEM_ANIMATION:
+        if (_animationController == NULL)
+        {
+            AnimationController* controller = new AnimationController();
+            controller->initialize();
+            if (_state == PAUSED)
+                controller->pause();
+            _animationController = controller;
+        }
+        break;
+    case SUBSYSTEM_AUDIO:
+        if (_audioController == NULL)
+        {
+            AudioController* controller = new AudioController();
+            controller->initialize();
+            if (_state == PAUSED)
+                controller->pause();
+            _audioController = controller;
+        }
+        break;
+    case SUBSYSTEM_PHYSICS:
+        if (_physicsController == NULL)
+        {
+            PhysicsController* controller = new PhysicsController();
+            controller->initialize();
+            if (_state == PAUSED)
+                controller->pause();
+            _physicsController = controller;
+        }
+        break;
+    case SUBSYSTEM_AI:
+        if (_aiController == NULL)
+        {
+            AIController* controller = new AIController();
+            controller->initialize();
+            if (_state == PAUSED)
+                controller->pause();
+            _aiController = controller;
+        }
+        break;
+    default:
+        // The script controller always exists, and creates its Lua state on first use.
+        break;
+    }
+}
+
 void Game::loadGamepads()
 {
     if (_properties)
@@ -1,8 +1,6 @@
 #ifndef GAME_H_
 #define GAME_H_
 
-#include <queue>
-
 #include "Keyboard.h"
 #include "Touch.h"
 #include "Mouse.h"
@@ -15,6 +13,10 @@
 #include "Vector4.h"
 #include "TimeListener.h"
 #include "Gamepad.h"
+#include "Mutex.h"
+#include "TimerWheel.h"
+#include "FrameGovernor.h"
+#include "MemoryStats.h"
 
 namespace gameplay
 {
@@ -52,6 +54,25 @@ public:
         CLEAR_COLOR_DEPTH_STENCIL = CLEAR_COLOR | CLEAR_DEPTH | CLEAR_STENCIL
     };
 
+    /**
+     * The phases of a frame, in the order they are run.
+     *
+     * @see Game::getPhaseTime
+     */
+    enum FramePhase
+    {
+        PHASE_ANIMATION,
+        PHASE_TIME_EVENTS,
+        PHASE_PHYSICS,
+        PHASE_AI,
+        PHASE_UPDATE,
+        PHASE_SCRIPT_UPDATE,
+        PHASE_AUDIO,
+        PHASE_RENDER,
+        PHASE_SCRIPT_RENDER,
+        PHASE_COUNT
+    };
+
     /**
      * Destructor.
      */
@@ -95,6 +116,26 @@ public:
      */
     static double getGameTime();
 
+    /**
+     * Sets a deterministic game clock that advances by a fixed step every frame.
+     *
+     * While a step is set, the game time no longer follows the wall clock. It advances
+     * by exactly the step at the start of each running frame, so every frame sees the
+     * same elapsed time however long it takes to run, which makes benchmark and test
+     * runs reproducible. Setting the step back to zero resumes the wall clock from the
+     * current game time.
+     *
+     * @param step The game time that passes each frame (in milliseconds), or zero to follow the wall clock.
+     */
+    static void setClockStep(float step);
+
+    /**
+     * Gets the step of the deterministic game clock.
+     *
+     * @return The game time that passes each frame (in milliseconds), or zero if the game time follows the wall clock.
+     */
+    static float getClockStep();
+
     /**
      * Gets the game state.
      *
@@ -156,6 +197,113 @@ public:
      */
     inline unsigned int getFrameRate() const;
 
+    /**
+     * Sets the rate at which the game simulation is updated.
+     *
+     * By default the simulation (animation, time events, physics, AI, Game::update and
+     * the script update) is updated once per frame with the elapsed wall-clock time.
+     * When a fixed update rate is set, the simulation is instead updated zero or more
+     * times per frame with a constant elapsed time of 1000 / updatesPerSecond milliseconds,
+     * which makes it reproducible regardless of the frame rate. Audio and rendering are
+     * still run once per frame; use Game::getFrameInterpolation to blend between the
+     * previous and current simulation states when rendering.
+     *
+     * If a frame takes so long that more than maxUpdatesPerFrame updates are due, the
+     * remaining time is dropped rather than carried over, so that a single hitch does
+     * not make the following frames more expensive.
+     *
+     * The update rate can also be set from the game config:
+     * @code
+     * fixedUpdate
+     * {
+     *     rate = 60
+     *     maxUpdatesPerFrame = 5
+     * }
+     * @endcode
+     *
+     * @param updatesPerSecond The number of simulation updates per second, or zero to
+     *      update the simulation once per frame.
+     * @param maxUpdatesPerFrame The maximum number of simulation updates run in one frame.
+     */
+    void setFixedUpdateRate(unsigned int updatesPerSecond, unsigned int maxUpdatesPerFrame = 5);
+
+    /**
+     * Gets the number of simulation updates per second.
+     *
+     * @return The fixed update rate, or zero if the simulation is updated once per frame.
+     */
+    inline unsigned int getFixedUpdateRate() const;
+
+    /**
+     * Gets the maximum number of simulation updates run in one frame when a fixed update rate is set.
+     *
+     * @return The maximum number of simulation updates per frame.
+     */
+    inline unsigned int getMaxUpdatesPerFrame() const;
+
+    /**
+     * Gets the number of simulation updates that were run in the last frame.
+     *
+     * @return The number of simulation updates in the last frame.
+     */
+    inline unsigned int getFrameUpdateCount() const;
+
+    /**
+     * Gets how far the current frame is between the last simulation update and the next one.
+     *
+     * This is the time that has not yet been simulated, as a fraction of the fixed update
+     * interval. Render code can use it to interpolate between the previous and current
+     * simulation states. When no fixed update rate is set this is always 1.
+     *
+     * @return The interpolation factor, in the range [0, 1].
+     */
+    inline float getFrameInterpolation() const;
+
+    /**
+     * Gets the time spent in the given phase of the last frame.
+     *
+     * When a fixed update rate is set, the simulation phases include the
+     * time of all the simulation updates run in the frame.
+     *
+     * @param phase The frame phase.
+     *
+     * @return The time spent in the phase (in milliseconds).
+     */
+    double getPhaseTime(FramePhase phase) const;
+
+    /**
+     * Sets whether the simulation of the next frame runs concurrently with the rendering of the current frame.
+     *
+     * When pipelined, each frame first snapshots the scenes and calls Game::snapshot, then
+     * starts the simulation (animation, time events, physics, AI, Game::update and the script
+     * update) of the next frame on a separate thread, while render() and the script render draw
+     * the snapshot on the game thread. The frame ends once both have finished, so input events
+     * and the rest of the game loop never run concurrently with the simulation.
+     *
+     * While render() is called, the world matrices and bounds of the nodes, the matrices of the
+     * cameras and the matrix palettes of the skins are read from the snapshot, so the material
+     * parameters bound to them are safe. Other material parameter values, such as those set
+     * with MaterialParameter::setValue, are not snapshot: the simulation must not change them,
+     * or the game must copy them in Game::snapshot and set them in render(). render() should
+     * draw the nodes returned by Scene::getVisibleNode instead of visiting the scene, and must
+     * not modify the scene. The simulation must not make any OpenGL calls. Calls into Lua are
+     * serialized between the two threads, so script callbacks remain safe. The rendered frame
+     * is one simulation frame behind the simulation.
+     *
+     * Pipelining is disabled by default.
+     *
+     * @param pipelined true to pipeline simulation and rendering, false to run them in sequence.
+     */
+    void setPipelined(bool pipelined);
+
+    /**
+     * Determines if the simulation and rendering are pipelined.
+     *
+     * @return true if the simulation runs concurrently with rendering, false otherwise.
+     * @see Game::setPipelined
+     */
+    inline bool isPipelined() const;
+
     /**
      * Gets the game window width.
      * 
@@ -200,6 +348,9 @@ public:
      * Gets the audio controller for managing control of audio
      * associated with the game.
      *
+     * When the subsystem is lazy in the subsystems section of game.config,
+     * it is created by the first call.
+     *
      * @return The audio controller for this game.
      */
     inline AudioController* getAudioController() const;
@@ -207,7 +358,10 @@ public:
     /**
      * Gets the animation controller for managing control of animations
      * associated with the game.
-     * 
+     *
+     * When the subsystem is lazy in the subsystems section of game.config,
+     * it is created by the first call.
+     *
      * @return The animation controller for this game.
      */
     inline AnimationController* getAnimationController() const;
@@ -215,7 +369,10 @@ public:
     /**
      * Gets the physics controller for managing control of physics
      * associated with the game.
-     * 
+     *
+     * When the subsystem is lazy in the subsystems section of game.config,
+     * it is created by the first call.
+     *
      * @return The physics controller for this game.
      */
     inline PhysicsController* getPhysicsController() const;
@@ -224,10 +381,42 @@ public:
      * Gets the AI controller for managing control of artificial
      * intelligence associated with the game.
      *
+     * When the subsystem is lazy in the subsystems section of game.config,
+     * it is created by the first call.
+     *
      * @return The AI controller for this game.
      */
     inline AIController* getAIController() const;
 
+    /**
+     * Gets the frame governor that scales the work of the subsystems to keep
+     * frames within the target frame time.
+     *
+     * @return The frame governor for this game.
+     */
+    inline FrameGovernor* getFrameGovernor() const;
+
+    /**
+     * Gets a snapshot of the memory owned by the textures, meshes, audio buffers,
+     * animations, fonts and scripts of the game.
+     *
+     * @return The memory stats.
+     * @script{ignore}
+     */
+    MemoryStats getMemoryStats() const;
+
+    /**
+     * Sets a file that a snapshot of the memory stats is appended to periodically,
+     * as one line of JSON per snapshot.
+     *
+     * The dump can also be set with the dumpFile and dumpInterval properties
+     * of the memoryStats section of game.config.
+     *
+     * @param path The path of the file, or NULL to stop dumping the memory stats.
+     * @param interval The game time between snapshots (in milliseconds).
+     */
+    void setMemoryStatsDump(const char* path, unsigned int interval = 1000);
+
     /**
      * Gets the script controller for managing control of Lua scripts
      * associated with the game.
@@ -386,9 +575,11 @@ public:
      * @param timeOffset The number of game milliseconds in the future to schedule the event to be fired.
      * @param timeListener The TimeListener that will receive the event.
      * @param cookie The cookie data that the time event will contain.
+     *
+     * @return The id of the time event, which can be passed to Game::unschedule, or zero if it could not be scheduled.
      * @script{ignore}
      */
-    void schedule(float timeOffset, TimeListener* timeListener, void* cookie = 0);
+    unsigned int schedule(float timeOffset, TimeListener* timeListener, void* cookie = 0);
 
     /**
      * Schedules a time event to be sent to the given TimeListener a given number of game milliseconds from now.
@@ -399,8 +590,29 @@ public:
      * 
      * @param timeOffset The number of game milliseconds in the future to schedule the event to be fired.
      * @param function The Lua script function that will receive the event.
+     *
+     * @return The id of the time event, which can be passed to Game::unschedule, or zero if it could not be scheduled.
+     */
+    unsigned int schedule(float timeOffset, const char* function);
+
+    /**
+     * Cancels a time event scheduled with Game::schedule that has not been fired yet.
+     *
+     * @param timeEventId The id of the time event returned by Game::schedule.
+     *
+     * @return true if the time event was cancelled, false if it was already fired or cancelled.
+     */
+    bool unschedule(unsigned int timeEventId);
+
+    /**
+     * Cancels all the time events scheduled for a TimeListener.
+     *
+     * This should be called before a TimeListener with pending time events is destroyed.
+     *
+     * @param timeListener The TimeListener.
+     * @script{ignore}
      */
-    void schedule(float timeOffset, const char* function);
+    void unschedule(TimeListener* timeListener);
 
 protected:
 
@@ -439,6 +651,17 @@ protected:
      */
     virtual void render(float elapsedTime) = 0;
 
+    /**
+     * Snapshot callback for copying the simulation state that is read when rendering.
+     *
+     * Only called when the game is pipelined (see Game::setPipelined), on the game thread,
+     * after the simulation of a frame has finished and before it is rendered. The scenes have
+     * already been snapshot (see Scene::getVisibleNodeCount); copy any other state render()
+     * needs, such as material parameters set by the game, since the live state is modified by
+     * the simulation of the next frame while rendering.
+     */
+    virtual void snapshot();
+
     /**
      * Renders a single frame once and then swaps it to the display.
      *
@@ -485,18 +708,18 @@ private:
         std::string function;
     };
 
+    struct SimulationPipeline;
+
     /**
-     * TimeEvent represents the event that is sent to TimeListeners as a result of calling Game::schedule().
+     * The subsystems that can be created when they are first used.
      */
-    class TimeEvent
+    enum Subsystem
     {
-    public:
-
-        TimeEvent(double time, TimeListener* timeListener, void* cookie);
-        bool operator<(const TimeEvent& v) const;
-        double time;
-        TimeListener* listener;
-        void* cookie;
+        SUBSYSTEM_ANIMATION = 1,
+        SUBSYSTEM_AUDIO = 2,
+        SUBSYSTEM_PHYSICS = 4,
+        SUBSYSTEM_AI = 8,
+        SUBSYSTEM_SCRIPT = 16
     };
 
     /**
@@ -523,11 +746,51 @@ private:
      */
     void fireTimeEvents(double frameTime);
 
+    /**
+     * Runs the simulation updates of a frame.
+     *
+     * @param updateCount The number of simulation updates to run.
+     * @param updateTime The simulated elapsed time of each update (in milliseconds).
+     * @param endTime The simulation time after the last update. Used to fire time events.
+     */
+    void simulate(unsigned int updateCount, double updateTime, double endTime);
+
+    /**
+     * Appends a snapshot of the memory stats to the dump file when the dump interval has elapsed.
+     */
+    void dumpMemoryStats();
+
+    /**
+     * Entry point of the thread that runs the simulation when the game is pipelined.
+     *
+     * @param game The game.
+     */
+    static void simulationThread(void* game);
+
+    /**
+     * Gets the time that scheduled time events are measured against.
+     *
+     * @return The simulation time when a fixed update rate is set, otherwise the game time.
+     */
+    double getScheduleTime() const;
+
     /**
      * Loads the game configuration.
      */
     void loadConfig();
 
+    /**
+     * Reads the subsystems to create on first use from the subsystems section of game.config.
+     */
+    void loadSubsystems();
+
+    /**
+     * Creates and initializes a controller that was not created at startup.
+     *
+     * @param subsystem The subsystem of the controller.
+     */
+    void createSubsystem(Subsystem subsystem);
+
     /**
      * Loads the gamepads from the configuration file.
      */
@@ -545,7 +808,19 @@ private:
     State _state;                               // The game state.
     static double _pausedTimeLast;              // The last time paused.
     static double _pausedTimeTotal;             // The total time paused.
+    static float _clockStep;                    // The game time that passes each frame, or zero to follow the wall clock.
+    static double _clockTime;                   // The game time of the deterministic clock.
     double _frameLastFPS;                       // The last time the frame count was updated.
+    double _lastFrameTime;                      // The game time of the last frame.
+    double _simulationTime;                     // The game time the simulation has been updated to.
+    double _accumulatedTime;                    // Elapsed time not yet consumed by fixed simulation updates.
+    unsigned int _fixedUpdateRate;              // The number of fixed simulation updates per second, or zero.
+    unsigned int _maxUpdatesPerFrame;           // The maximum number of fixed simulation updates per frame.
+    unsigned int _frameUpdateCount;             // The number of simulation updates in the last frame.
+    float _frameInterpolation;                  // The fraction of a fixed update interval not yet simulated.
+    double _phaseTimes[PHASE_COUNT];            // The time spent in each phase of the last frame.
+    double _simulationPhaseTimes[PHASE_COUNT];  // The time spent in each phase of the simulation in progress.
+    SimulationPipeline* _pipeline;              // The simulation thread, when pipelined.
     unsigned int _frameCount;                   // The current frame count.
     unsigned int _frameRate;                    // The current frame rate.
     unsigned int _width;                        // The game's display width.
@@ -559,11 +834,21 @@ private:
     AudioController* _audioController;          // Controls audio sources that are playing in the game.
     PhysicsController* _physicsController;      // Controls the simulation of a physics scene and entities.
     AIController* _aiController;                // Controls AI simulation.
+    FrameGovernor* _frameGovernor;              // Scales the work of the subsystems under load.
+    unsigned int _lazySubsystems;               // The subsystems created on first use, and not at startup.
+    unsigned int _animationSkippedUpdates;      // The number of simulation updates since animations were last updated.
+    float _animationElapsedTime;                // The elapsed time of the simulation updates animations have skipped.
+    unsigned int _aiSkippedUpdates;             // The number of simulation updates since AI was last updated.
+    float _aiElapsedTime;                       // The elapsed time of the simulation updates AI has skipped.
     AudioListener* _audioListener;              // The audio listener in 3D space.
     std::vector<Gamepad*>* _gamepads;           // The connected gamepads.
-    std::priority_queue<TimeEvent, std::vector<TimeEvent>, std::less<TimeEvent> >* _timeEvents;     // Contains the scheduled time events.
+    TimerWheel* _timeEvents;                    // Contains the scheduled time events.
     ScriptController* _scriptController;            // Controls the scripting engine.
-    std::vector<ScriptListener*>* _scriptListeners; // Lua script listeners.
+    std::map<std::string, ScriptListener*>* _scriptListeners; // Lua script listeners, shared by all the time events of a function.
+    Mutex* _timeEventsMutex;                        // Guards the time events while the simulation is pipelined.
+    FILE* _memoryStatsFile;                     // The file the memory stats are dumped to, or NULL.
+    unsigned int _memoryStatsInterval;          // The game time between memory stats dumps.
+    double _memoryStatsLastTime;                // The game time of the last memory stats dump.
 
     // Note: Do not add STL object member variables on the stack; this will cause false memory leaks to be reported.
 
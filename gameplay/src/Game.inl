@@ -19,6 +19,31 @@ inline unsigned int Game::getFrameRate() const
     return _frameRate;
 }
 
+inline unsigned int Game::getFixedUpdateRate() const
+{
+    return _fixedUpdateRate;
+}
+
+inline unsigned int Game::getMaxUpdatesPerFrame() const
+{
+    return _maxUpdatesPerFrame;
+}
+
+inline unsigned int Game::getFrameUpdateCount() const
+{
+    return _frameUpdateCount;
+}
+
+inline float Game::getFrameInterpolation() const
+{
+    return _frameInterpolation;
+}
+
+inline bool Game::isPipelined() const
+{
+    return _pipeline != NULL;
+}
+
 inline unsigned int Game::getWidth() const
 {
     return _width;
@@ -36,16 +61,22 @@ inline const Rectangle& Game::getViewport() const
 
 inline AnimationController* Game::getAnimationController() const
 {
+    if (_animationController == NULL && (_lazySubsystems & SUBSYSTEM_ANIMATION))
+        const_cast<Game*>(this)->createSubsystem(SUBSYSTEM_ANIMATION);
     return _animationController;
 }
 
 inline AudioController* Game::getAudioController() const
 {
+    if (_audioController == NULL && (_lazySubsystems & SUBSYSTEM_AUDIO))
+        const_cast<Game*>(this)->createSubsystem(SUBSYSTEM_AUDIO);
     return _audioController;
 }
 
 inline PhysicsController* Game::getPhysicsController() const
 {
+    if (_physicsController == NULL && (_lazySubsystems & SUBSYSTEM_PHYSICS))
+        const_cast<Game*>(this)->createSubsystem(SUBSYSTEM_PHYSICS);
     return _physicsController;
 }
 
@@ -55,9 +86,16 @@ inline ScriptController* Game::getScriptController() const
 }
 inline AIController* Game::getAIController() const
 {
+    if (_aiController == NULL && (_lazySubsystems & SUBSYSTEM_AI))
+        const_cast<Game*>(this)->createSubsystem(SUBSYSTEM_AI);
     return _aiController;
 }
 
+inline FrameGovernor* Game::getFrameGovernor() const
+{
+    return _frameGovernor;
+}
+
 template <class T>
 void Game::renderOnce(T* instance, void (T::*method)(void*), void* cookie)
 {
@@ -7,6 +7,7 @@ namespace gameplay
 
 Image* Image::create(const char* path)
 {
+    GP_MEMORY_TAG(ASSETS);
     GP_ASSERT(path);
 
     // Open the file.
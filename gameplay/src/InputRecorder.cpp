@@ -0,0 +1,334 @@
+#include "Base.h"
+#include "InputRecorder.h"
+#include "Platform.h"
+#include "FileSystem.h"
+#include "Game.h"
+
+// The identifier and version at the start of a recording.
+#define INPUT_RECORDING_ID "GPIR"
+#define INPUT_RECORDING_VERSION 1
+
+// The offset of the frame count in the header, which is written when the recording stops.
+#define INPUT_RECORDING_FRAME_COUNT_OFFSET 20
+
+namespace gameplay
+{
+
+/**
+ * The kinds of recorded events.
+ */
+enum InputEventKind
+{
+    INPUT_TOUCH,
+    INPUT_KEY,
+    INPUT_MOUSE
+};
+
+/**
+ * A recorded input event.
+ *
+ * The values are the position and contact index of a touch event, the key of a key
+ * event, and the position and wheel delta of a mouse event.
+ */
+struct InputEvent
+{
+    unsigned char kind;
+    unsigned char evt;
+    int values[3];
+};
+
+enum InputRecorderMode
+{
+    INPUT_IDLE,
+    INPUT_RECORDING,
+    INPUT_REPLAYING
+};
+
+static InputRecorderMode __mode = INPUT_IDLE;
+static FILE* __file = NULL;
+static std::string __path;
+static std::vector<InputEvent> __events;    // The events received or replayed for the frame.
+static bool __started = false;              // Set by the first frame after starting.
+static unsigned int __frame = 0;            // The number of frames recorded or replayed.
+static unsigned int __frameCount = 0;       // The number of frames in the recording replayed, or zero if unknown.
+static float __previousClockStep = 0.0f;    // The clock step of the game before the replay.
+static bool __dispatching = false;          // Set while the replayed events are delivered.
+static bool __exitAtEnd = false;
+static bool __exitPending = false;
+
+static bool writeUint(unsigned int value)
+{
+    return fwrite(&value, sizeof(value), 1, __file) == 1;
+}
+
+static bool readUint(unsigned int* value)
+{
+    return fread(value, sizeof(*value), 1, __file) == 1;
+}
+
+static void addEvent(InputEventKind kind, int evt, int value0, int value1, int value2)
+{
+    InputEvent event;
+    event.kind = (unsigned char)kind;
+    event.evt = (unsigned char)evt;
+    event.values[0] = value0;
+    event.values[1] = value1;
+    event.values[2] = value2;
+    __events.push_back(event);
+}
+
+// The number of values written for each kind of event, since key events only have a key.
+static unsigned int getValueCount(unsigned char kind)
+{
+    return kind == INPUT_KEY ? 1 : 3;
+}
+
+static void finishReplay()
+{
+    GP_ASSERT(__mode == INPUT_REPLAYING);
+
+    GP_WARN("Finished replaying %u frames of input recording '%s'.", __frame, __path.c_str());
+    __exitPending = __exitAtEnd;
+    InputRecorder::stop();
+}
+
+bool InputRecorder::startRecording(const char* path)
+{
+    GP_ASSERT(path);
+
+    stop();
+
+    __file = FileSystem::openFile(path, "wb");
+    if (__file == NULL)
+    {
+        GP_WARN("Failed to open input recording '%s' for writing.", path);
+        return false;
+    }
+
+    // Seed the random number generator so the replay can reproduce its numbers.
+    unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)(Platform::getAbsoluteTime() * 1000.0);
+    srand(seed);
+
+    Game* game = Game::getInstance();
+    fwrite(INPUT_RECORDING_ID, 1, 4, __file);
+    writeUint(INPUT_RECORDING_VERSION);
+    writeUint(seed);
+    writeUint(game->getWidth());
+    writeUint(game->getHeight());
+    writeUint(0);
+
+    __mode = INPUT_RECORDING;
+    __path = path;
+    __events.clear();
+    __started = false;
+    __frame = 0;
+    __frameCount = 0;
+    return true;
+}
+
+bool InputRecorder::startReplay(const char* path, bool exitAtEnd)
+{
+    GP_ASSERT(path);
+
+    stop();
+
+    __file = FileSystem::openFile(path, "rb");
+    if (__file == NULL)
+    {
+        GP_WARN("Failed to open input recording '%s'.", path);
+        return false;
+    }
+
+    char id[4];
+    unsigned int version, seed, width, height, frameCount;
+    if (fread(id, 1, 4, __file) != 4 || memcmp(id, INPUT_RECORDING_ID, 4) != 0 ||
+        !readUint(&version) || version != INPUT_RECORDING_VERSION ||
+        !readUint(&seed) || !readUint(&width) || !readUint(&height) || !readUint(&frameCount))
+    {
+        GP_WARN("Invalid input recording '%s'.", path);
+        fclose(__file);
+        __file = NULL;
+        return false;
+    }
+
+    Game* game = Game::getInstance();
+    if (width != game->getWidth() || height != game->getHeight())
+    {
+        GP_WARN("Input recording '%s' was recorded at %ux%u, and is replayed at %ux%u.", path, width, height, game->getWidth(), game->getHeight());
+    }
+
+    srand(seed);
+
+    // Stop the game time until the first frame is replayed, so no time passes that was not recorded.
+    __previousClockStep = Game::getClockStep();
+    Game::setClockStep(std::numeric_limits<float>::min());
+
+    __mode = INPUT_REPLAYING;
+    __path = path;
+    __events.clear();
+    __started = false;
+    __frame = 0;
+    __frameCount = frameCount;
+    __exitAtEnd = exitAtEnd;
+    return true;
+}
+
+void InputRecorder::stop()
+{
+    if (__mode == INPUT_RECORDING)
+    {
+        // Write the number of frames, so the replay knows where the recording ends.
+        if (fseek(__file, INPUT_RECORDING_FRAME_COUNT_OFFSET, SEEK_SET) == 0)
+            writeUint(__frame);
+    }
+    else if (__mode == INPUT_REPLAYING)
+    {
+        Game::setClockStep(__previousClockStep);
+    }
+
+    if (__file)
+    {
+        fclose(__file);
+        __file = NULL;
+    }
+    __mode = INPUT_IDLE;
+    __events.clear();
+}
+
+bool InputRecorder::isRecording()
+{
+    return __mode == INPUT_RECORDING;
+}
+
+bool InputRecorder::isReplaying()
+{
+    return __mode == INPUT_REPLAYING;
+}
+
+unsigned int InputRecorder::getFrameCount()
+{
+    return __frame;
+}
+
+bool InputRecorder::recordTouchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (__mode == INPUT_REPLAYING)
+        return __dispatching;
+
+    if (__mode == INPUT_RECORDING)
+        addEvent(INPUT_TOUCH, evt, x, y, (int)contactIndex);
+    return true;
+}
+
+bool InputRecorder::recordKeyEvent(Keyboard::KeyEvent evt, int key)
+{
+    if (__mode == INPUT_REPLAYING)
+        return __dispatching;
+
+    if (__mode == INPUT_RECORDING)
+        addEvent(INPUT_KEY, evt, key, 0, 0);
+    return true;
+}
+
+bool InputRecorder::recordMouseEvent(Mouse::MouseEvent evt, int x, int y, int wheelDelta)
+{
+    if (__mode == INPUT_REPLAYING)
+        return __dispatching;
+
+    if (__mode == INPUT_RECORDING)
+        addEvent(INPUT_MOUSE, evt, x, y, wheelDelta);
+    return true;
+}
+
+void InputRecorder::beginFrame()
+{
+    __started = true;
+    if (__mode != INPUT_REPLAYING)
+        return;
+
+    if (__frameCount > 0 && __frame >= __frameCount)
+    {
+        finishReplay();
+        return;
+    }
+
+    // Read the frame; a recording that was not stopped has no frame count and ends where it was cut off.
+    float elapsedTime;
+    unsigned int eventCount;
+    bool valid = fread(&elapsedTime, sizeof(elapsedTime), 1, __file) == 1 && readUint(&eventCount);
+    __events.clear();
+    for (unsigned int i = 0; valid && i < eventCount; ++i)
+    {
+        InputEvent event;
+        memset(&event, 0, sizeof(event));
+        valid = fread(&event.kind, 1, 1, __file) == 1 && fread(&event.evt, 1, 1, __file) == 1 &&
+                event.kind <= INPUT_MOUSE;
+        if (valid)
+        {
+            unsigned int valueCount = getValueCount(event.kind);
+            valid = fread(event.values, sizeof(int), valueCount, __file) == valueCount;
+        }
+        __events.push_back(event);
+    }
+    if (!valid)
+    {
+        finishReplay();
+        return;
+    }
+
+    // Deliver the events through the platform, as they were received when recorded.
+    __dispatching = true;
+    for (unsigned int i = 0, count = __events.size(); i < count; ++i)
+    {
+        const InputEvent& event = __events[i];
+        switch (event.kind)
+        {
+        case INPUT_TOUCH:
+            Platform::touchEventInternal((Touch::TouchEvent)event.evt, event.values[0], event.values[1], (unsigned int)event.values[2]);
+            break;
+        case INPUT_KEY:
+            Platform::keyEventInternal((Keyboard::KeyEvent)event.evt, event.values[0]);
+            break;
+        case INPUT_MOUSE:
+            // A mouse event that is not consumed was recorded with the touch event the platform made of it.
+            Platform::mouseEventInternal((Mouse::MouseEvent)event.evt, event.values[0], event.values[1], event.values[2]);
+            break;
+        }
+    }
+    __dispatching = false;
+    __events.clear();
+
+    // A clock step of zero would switch the game back to the real time, so a frame without time steps the least.
+    Game::setClockStep(elapsedTime > 0 ? elapsedTime : std::numeric_limits<float>::min());
+    ++__frame;
+}
+
+void InputRecorder::endFrame(float elapsedTime)
+{
+    if (__mode == INPUT_RECORDING && __started)
+    {
+        fwrite(&elapsedTime, sizeof(elapsedTime), 1, __file);
+        writeUint(__events.size());
+        for (unsigned int i = 0, count = __events.size(); i < count; ++i)
+        {
+            const InputEvent& event = __events[i];
+            fwrite(&event.kind, 1, 1, __file);
+            fwrite(&event.evt, 1, 1, __file);
+            fwrite(event.values, sizeof(int), getValueCount(event.kind), __file);
+        }
+        __events.clear();
+        ++__frame;
+    }
+    else if (__mode == INPUT_REPLAYING && __frameCount > 0 && __frame >= __frameCount)
+    {
+        finishReplay();
+    }
+
+    if (__exitPending)
+    {
+        __exitPending = false;
+        Game::getInstance()->exit();
+    }
+}
+
+}
@@ -0,0 +1,156 @@
+#ifndef INPUTRECORDER_H_
+#define INPUTRECORDER_H_
+
+#include "Touch.h"
+#include "Keyboard.h"
+#include "Mouse.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a recorder of the input of the game, for replaying a session deterministically.
+ *
+ * While recording, the touch, key and mouse events received from the platform are
+ * written to a file together with the elapsed time of every frame and the seed of
+ * the random number generator. Replaying the file seeds the random number generator
+ * with the same seed, steps the game clock by the recorded time of each frame and
+ * delivers the recorded events before the frame they were received before, so a
+ * session can be run again as many times as needed, such as under a profiler.
+ * Events from the platform are ignored while a recording is replayed.
+ *
+ * Recording or replaying starts with the next frame, and is best started from the
+ * inputRecorder section of game.config so the session includes the initialization
+ * of the game:
+ * @code
+ * inputRecorder
+ * {
+ *     record = session.input
+ * }
+ * @endcode
+ * or:
+ * @code
+ * inputRecorder
+ * {
+ *     replay = session.input
+ *     exitAtEnd = true
+ * }
+ * @endcode
+ *
+ * A replay reproduces the session only if the game behaves the same given the same
+ * input, time steps and random numbers, and is played at the same resolution.
+ * Frames run while the game is paused are not recorded, and input received while
+ * paused is delivered before the next frame that runs.
+ *
+ * @script{ignore}
+ */
+class InputRecorder
+{
+    friend class Game;
+
+public:
+
+    /**
+     * Starts recording the input of the game to a file, stopping any recording or replay in progress.
+     *
+     * The random number generator is seeded with a new seed, which is written to the file.
+     *
+     * @param path The path of the file to write.
+     *
+     * @return true if the file was opened.
+     */
+    static bool startRecording(const char* path);
+
+    /**
+     * Starts replaying a recording, stopping any recording or replay in progress.
+     *
+     * @param path The path of the recording to replay.
+     * @param exitAtEnd true to exit the game when the last recorded frame has been replayed.
+     *
+     * @return true if the recording was opened.
+     */
+    static bool startReplay(const char* path, bool exitAtEnd = false);
+
+    /**
+     * Stops the recording or replay in progress.
+     *
+     * A recording is closed, and the game clock is restored when a replay is stopped.
+     */
+    static void stop();
+
+    /**
+     * Determines whether the input is being recorded.
+     *
+     * @return true if the input is being recorded.
+     */
+    static bool isRecording();
+
+    /**
+     * Determines whether a recording is being replayed.
+     *
+     * @return true if a recording is being replayed.
+     */
+    static bool isReplaying();
+
+    /**
+     * Gets the number of frames recorded or replayed since the recording or replay started.
+     *
+     * @return The number of frames.
+     */
+    static unsigned int getFrameCount();
+
+    /**
+     * Records a touch event received from the platform.
+     *
+     * This is called by the platform and should not be called directly.
+     *
+     * @return false if the event must be ignored because a recording is being replayed.
+     */
+    static bool recordTouchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex);
+
+    /**
+     * Records a key event received from the platform.
+     *
+     * This is called by the platform and should not be called directly.
+     *
+     * @return false if the event must be ignored because a recording is being replayed.
+     */
+    static bool recordKeyEvent(Keyboard::KeyEvent evt, int key);
+
+    /**
+     * Records a mouse event received from the platform.
+     *
+     * This is called by the platform and should not be called directly.
+     *
+     * @return false if the event must be ignored because a recording is being replayed.
+     */
+    static bool recordMouseEvent(Mouse::MouseEvent evt, int x, int y, int wheelDelta);
+
+private:
+
+    /**
+     * Constructor.
+     */
+    InputRecorder();
+
+    /**
+     * Delivers the recorded events of the next frame and sets the game clock to its
+     * recorded time step, when a recording is being replayed.
+     *
+     * Called by the Game at the start of every frame that runs, before the game time is updated.
+     */
+    static void beginFrame();
+
+    /**
+     * Writes the events received for the frame and its elapsed time, when the input is being recorded.
+     *
+     * Called by the Game at the end of every frame that runs.
+     *
+     * @param elapsedTime The elapsed game time of the frame.
+     */
+    static void endFrame(float elapsedTime);
+};
+
+}
+
+#endif
@@ -0,0 +1,434 @@
+#include "Base.h"
+#include "LoadTrace.h"
+#include "Platform.h"
+#include "Properties.h"
+#include "FileSystem.h"
+#include "SpinLock.h"
+#include "Atomic.h"
+
+namespace gameplay
+{
+
+/**
+ * The loads of an asset.
+ */
+struct AssetRecord
+{
+    std::string type;
+    std::string path;
+    unsigned int loadCount;
+    unsigned int cacheHitCount;
+    unsigned int bytes;
+    double times[LoadTrace::PHASE_COUNT];
+};
+
+/**
+ * A span of time of the trace, for an asset or a phase of loading it.
+ */
+struct TraceEvent
+{
+    std::string name;
+    const char* category;
+    double startTime;
+    double duration;
+    int thread;
+};
+
+/**
+ * The totals of a group of assets in the report.
+ */
+struct ReportTotal
+{
+    std::string name;
+    unsigned int loadCount;
+    unsigned int cacheHitCount;
+    unsigned int bytes;
+    double times[LoadTrace::PHASE_COUNT];
+
+    ReportTotal() : loadCount(0), cacheHitCount(0), bytes(0)
+    {
+        memset(times, 0, sizeof(times));
+    }
+};
+
+static bool __enabled = false;
+static double __startTime = 0;
+static std::map<std::string, AssetRecord> __assets;
+static std::vector<TraceEvent> __events;
+static SpinLock __registryLock;
+static std::string __reportPath;
+static std::string __tracePath;
+
+// The asset being loaded on each thread, and a small number identifying the thread in the trace.
+static THREAD_LOCAL LoadTrace::Asset* __currentAsset = NULL;
+static THREAD_LOCAL int __threadIndex = 0;
+static volatile int __threadCount = 0;
+
+static const char* __phaseNames[LoadTrace::PHASE_COUNT] =
+{
+    "io",
+    "parse",
+    "decode",
+    "upload",
+    "other"
+};
+
+static int getThreadIndex()
+{
+    if (__threadIndex == 0)
+        __threadIndex = Atomic::increment(&__threadCount);
+    return __threadIndex;
+}
+
+static void addEvent(const std::string& name, const char* category, double startTime, double endTime)
+{
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.startTime = startTime;
+    event.duration = endTime - startTime;
+    event.thread = getThreadIndex();
+
+    SpinLock::ScopedLock lock(__registryLock);
+    __events.push_back(event);
+}
+
+static double getTotalTime(const double* times)
+{
+    double total = 0;
+    for (unsigned int i = 0; i < LoadTrace::PHASE_COUNT; ++i)
+    {
+        total += times[i];
+    }
+    return total;
+}
+
+// Gets the file extension of an asset path, ignoring the id of an object in the file.
+static std::string getFormat(const std::string& path)
+{
+    std::string file = path.substr(0, path.find_first_of("#;"));
+    size_t dot = file.rfind('.');
+    if (dot == std::string::npos || file.find('/', dot) != std::string::npos)
+        return "(none)";
+
+    std::string format = file.substr(dot + 1);
+    for (unsigned int i = 0, count = format.size(); i < count; ++i)
+    {
+        format[i] = (char)tolower(format[i]);
+    }
+    return format;
+}
+
+static void addTotal(ReportTotal& total, const AssetRecord& asset)
+{
+    total.loadCount += asset.loadCount;
+    total.cacheHitCount += asset.cacheHitCount;
+    total.bytes += asset.bytes;
+    for (unsigned int i = 0; i < LoadTrace::PHASE_COUNT; ++i)
+    {
+        total.times[i] += asset.times[i];
+    }
+}
+
+static bool compareAssets(const AssetRecord* a, const AssetRecord* b)
+{
+    return getTotalTime(a->times) > getTotalTime(b->times);
+}
+
+static bool compareTotals(const ReportTotal& a, const ReportTotal& b)
+{
+    return getTotalTime(a.times) > getTotalTime(b.times);
+}
+
+static void writeTimes(FILE* file, const double* times, unsigned int loadCount, unsigned int cacheHitCount, unsigned int bytes)
+{
+    fprintf(file, "%10.2f", getTotalTime(times));
+    for (unsigned int i = 0; i < LoadTrace::PHASE_COUNT; ++i)
+    {
+        fprintf(file, " %9.2f", times[i]);
+    }
+    fprintf(file, " %12u %6u %6u %6u", bytes, loadCount, loadCount - cacheHitCount, cacheHitCount);
+}
+
+static void writeHeader(FILE* file, const char* name)
+{
+    fprintf(file, "  %10s", "total ms");
+    for (unsigned int i = 0; i < LoadTrace::PHASE_COUNT; ++i)
+    {
+        fprintf(file, " %6s ms", __phaseNames[i]);
+    }
+    fprintf(file, " %12s %6s %6s %6s  %s\n", "bytes", "loads", "misses", "hits", name);
+}
+
+static void writeTotals(FILE* file, const char* title, const char* name, std::map<std::string, ReportTotal>& totals)
+{
+    std::vector<ReportTotal> sorted;
+    for (std::map<std::string, ReportTotal>::iterator itr = totals.begin(); itr != totals.end(); ++itr)
+    {
+        itr->second.name = itr->first;
+        sorted.push_back(itr->second);
+    }
+    std::sort(sorted.begin(), sorted.end(), compareTotals);
+
+    fprintf(file, "%s:\n", title);
+    writeHeader(file, name);
+    for (unsigned int i = 0, count = sorted.size(); i < count; ++i)
+    {
+        const ReportTotal& total = sorted[i];
+        fprintf(file, "  ");
+        writeTimes(file, total.times, total.loadCount, total.cacheHitCount, total.bytes);
+        fprintf(file, "  %s\n", total.name.c_str());
+    }
+    fprintf(file, "\n");
+}
+
+static void writeString(FILE* file, const char* str)
+{
+    fputc('"', file);
+    for (; *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+            fputc('\\', file);
+        fputc(*str, file);
+    }
+    fputc('"', file);
+}
+
+LoadTrace::Asset::Asset(const char* type, const char* path, const char* id)
+    : _active(__enabled), _parent(NULL), _type(type), _phase(OTHER), _startTime(0), _lastTime(0), _bytes(0), _cacheHit(false)
+{
+    if (!_active)
+        return;
+
+    GP_ASSERT(type);
+    _path = path ? path : "";
+    if (id)
+    {
+        _path += '#';
+        _path += id;
+    }
+    memset(_times, 0, sizeof(_times));
+
+    // Stop charging time to the asset that loads this one until it has loaded.
+    double time = Platform::getAbsoluteTime();
+    _parent = __currentAsset;
+    if (_parent)
+        _parent->charge(time);
+    __currentAsset = this;
+    _startTime = time;
+    _lastTime = time;
+}
+
+LoadTrace::Asset::~Asset()
+{
+    if (!_active)
+        return;
+
+    double time = Platform::getAbsoluteTime();
+    charge(time);
+    __currentAsset = _parent;
+    if (_parent)
+        _parent->_lastTime = time;
+
+    std::string key = _type;
+    key += ':';
+    key += _path;
+    {
+        SpinLock::ScopedLock lock(__registryLock);
+        std::map<std::string, AssetRecord>::iterator itr = __assets.find(key);
+        if (itr == __assets.end())
+        {
+            AssetRecord record;
+            record.type = _type;
+            record.path = _path;
+            record.loadCount = 0;
+            record.cacheHitCount = 0;
+            record.bytes = 0;
+            memset(record.times, 0, sizeof(record.times));
+            itr = __assets.insert(std::make_pair(key, record)).first;
+        }
+        AssetRecord& record = itr->second;
+        ++record.loadCount;
+        if (_cacheHit)
+            ++record.cacheHitCount;
+        record.bytes += _bytes;
+        for (unsigned int i = 0; i < PHASE_COUNT; ++i)
+        {
+            record.times[i] += _times[i];
+        }
+    }
+    addEvent(key, _cacheHit ? "cache" : "asset", _startTime, time);
+}
+
+void LoadTrace::Asset::setCacheHit()
+{
+    _cacheHit = true;
+}
+
+void LoadTrace::Asset::charge(double time)
+{
+    _times[_phase] += time - _lastTime;
+    _lastTime = time;
+}
+
+LoadTrace::PhaseScope::PhaseScope(Phase phase)
+    : _asset(__currentAsset), _previousPhase(OTHER), _startTime(0)
+{
+    GP_ASSERT(phase < PHASE_COUNT);
+
+    if (_asset)
+    {
+        _startTime = Platform::getAbsoluteTime();
+        _asset->charge(_startTime);
+        _previousPhase = _asset->_phase;
+        _asset->_phase = phase;
+    }
+}
+
+LoadTrace::PhaseScope::~PhaseScope()
+{
+    if (_asset)
+    {
+        GP_ASSERT(__currentAsset == _asset);
+
+        double time = Platform::getAbsoluteTime();
+        Phase phase = _asset->_phase;
+        _asset->charge(time);
+        _asset->_phase = _previousPhase;
+        addEvent(__phaseNames[phase], "phase", _startTime, time);
+    }
+}
+
+void LoadTrace::setEnabled(bool enabled)
+{
+    if (enabled && !__enabled)
+        __startTime = Platform::getAbsoluteTime();
+    __enabled = enabled;
+}
+
+bool LoadTrace::isEnabled()
+{
+    return __enabled;
+}
+
+void LoadTrace::recordBytesRead(unsigned int bytes)
+{
+    if (__currentAsset)
+        __currentAsset->_bytes += bytes;
+}
+
+void LoadTrace::reset()
+{
+    SpinLock::ScopedLock lock(__registryLock);
+    __assets.clear();
+    __events.clear();
+    __startTime = Platform::getAbsoluteTime();
+}
+
+void LoadTrace::writeReport(FILE* file)
+{
+    GP_ASSERT(file);
+
+    SpinLock::ScopedLock lock(__registryLock);
+
+    std::vector<const AssetRecord*> assets;
+    std::map<std::string, ReportTotal> types;
+    std::map<std::string, ReportTotal> formats;
+    ReportTotal total;
+    for (std::map<std::string, AssetRecord>::const_iterator itr = __assets.begin(); itr != __assets.end(); ++itr)
+    {
+        const AssetRecord& asset = itr->second;
+        assets.push_back(&asset);
+        addTotal(types[asset.type], asset);
+        addTotal(formats[getFormat(asset.path)], asset);
+        addTotal(total, asset);
+    }
+    std::sort(assets.begin(), assets.end(), compareAssets);
+
+    fprintf(file, "Load time report: %u assets, %u loads (%u cache hits), %.2f ms, %u bytes\n\n",
+        (unsigned int)assets.size(), total.loadCount, total.cacheHitCount, getTotalTime(total.times), total.bytes);
+    writeTotals(file, "By type", "type", types);
+    writeTotals(file, "By format", "format", formats);
+
+    fprintf(file, "By asset:\n");
+    writeHeader(file, "asset");
+    for (unsigned int i = 0, count = assets.size(); i < count; ++i)
+    {
+        const AssetRecord& asset = *assets[i];
+        fprintf(file, "  ");
+        writeTimes(file, asset.times, asset.loadCount, asset.cacheHitCount, asset.bytes);
+        fprintf(file, "  %s %s\n", asset.type.c_str(), asset.path.c_str());
+    }
+}
+
+void LoadTrace::writeTrace(FILE* file)
+{
+    GP_ASSERT(file);
+
+    SpinLock::ScopedLock lock(__registryLock);
+
+    // Times are in microseconds from when tracing started.
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (unsigned int i = 0, count = __events.size(); i < count; ++i)
+    {
+        const TraceEvent& event = __events[i];
+        fprintf(file, "{\"name\":");
+        writeString(file, event.name.c_str());
+        fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.1f,\"dur\":%.1f,\"pid\":1,\"tid\":%d}%s\n",
+            event.category, (event.startTime - __startTime) * 1000.0, event.duration * 1000.0, event.thread, i + 1 < count ? "," : "");
+    }
+    fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+const char* LoadTrace::getPhaseName(Phase phase)
+{
+    GP_ASSERT(phase < PHASE_COUNT);
+    return __phaseNames[phase];
+}
+
+void LoadTrace::initialize(Properties* properties)
+{
+    GP_ASSERT(properties);
+
+    const char* reportPath = properties->getString("report");
+    const char* tracePath = properties->getString("trace");
+    __reportPath = reportPath ? reportPath : "";
+    __tracePath = tracePath ? tracePath : "";
+    reset();
+    setEnabled(true);
+}
+
+void LoadTrace::finalize()
+{
+    if (!__reportPath.empty())
+    {
+        FILE* file = FileSystem::openFile(__reportPath.c_str(), "w");
+        if (file)
+        {
+            writeReport(file);
+            fclose(file);
+        }
+        else
+        {
+            GP_WARN("Failed to open load time report '%s'.", __reportPath.c_str());
+        }
+    }
+    if (!__tracePath.empty())
+    {
+        FILE* file = FileSystem::openFile(__tracePath.c_str(), "w");
+        if (file)
+        {
+            writeTrace(file);
+            fclose(file);
+        }
+        else
+        {
+            GP_WARN("Failed to open load time trace '%s'.", __tracePath.c_str());
+        }
+    }
+    __reportPath.clear();
+    __tracePath.clear();
+    setEnabled(false);
+}
+
+}
@@ -0,0 +1,200 @@
+#ifndef LOADTRACE_H_
+#define LOADTRACE_H_
+
+namespace gameplay
+{
+
+class Properties;
+
+/**
+ * Defines a tracer of the time spent loading assets.
+ *
+ * Scenes, bundles and the meshes, nodes and scenes read from them, materials, effects,
+ * textures and audio buffers each trace their loading, split into the time spent in I/O,
+ * parsing, decoding and uploading to the GPU or audio device. The bytes of the files
+ * opened and whether the asset was found in its cache are also recorded. Time is
+ * charged to the innermost asset being loaded, so the time of a scene excludes the
+ * time of the bundles, materials and textures it loads.
+ *
+ * Tracing is disabled by default, and is enabled with the loadTrace section of game.config:
+ * @code
+ * loadTrace
+ * {
+ *     report = load.txt
+ *     trace = load.json
+ * }
+ * @endcode
+ * The report lists the assets sorted by cost, with totals for each type and file format,
+ * and the trace can be opened with the trace viewer of Chrome (chrome://tracing). Both are
+ * written when the game exits, or can be written at any time with writeReport and writeTrace.
+ *
+ * @script{ignore}
+ */
+class LoadTrace
+{
+    friend class Game;
+
+public:
+
+    /**
+     * The phases of loading an asset.
+     */
+    enum Phase
+    {
+        IO,
+        PARSE,
+        DECODE,
+        UPLOAD,
+        OTHER,
+        PHASE_COUNT
+    };
+
+    /**
+     * Traces the loading of an asset on the calling thread for the lifetime of the scope object.
+     */
+    class Asset
+    {
+        friend class LoadTrace;
+
+    public:
+
+        /**
+         * Constructor. Starts tracing the asset if tracing is enabled.
+         *
+         * @param type The type of asset, such as "texture".
+         * @param path The path of the asset.
+         * @param id The id of the asset within the file, or NULL.
+         */
+        Asset(const char* type, const char* path, const char* id = NULL);
+
+        /**
+         * Destructor. Records the load of the asset.
+         */
+        ~Asset();
+
+        /**
+         * Marks the asset as found in its cache, rather than loaded.
+         */
+        void setCacheHit();
+
+    private:
+
+        Asset(const Asset& copy);
+        Asset& operator=(const Asset&);
+
+        void charge(double time);
+
+        bool _active;
+        Asset* _parent;
+        const char* _type;
+        std::string _path;
+        Phase _phase;
+        double _startTime;
+        double _lastTime;
+        double _times[PHASE_COUNT];
+        unsigned int _bytes;
+        bool _cacheHit;
+    };
+
+    /**
+     * Charges the time spent by the calling thread to a phase of the asset being loaded,
+     * for the lifetime of the scope object.
+     */
+    class PhaseScope
+    {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param phase The phase.
+         */
+        explicit PhaseScope(Phase phase);
+
+        /**
+         * Destructor. Restores the previous phase of the asset.
+         */
+        ~PhaseScope();
+
+    private:
+
+        PhaseScope(const PhaseScope& copy);
+        PhaseScope& operator=(const PhaseScope&);
+
+        Asset* _asset;
+        Phase _previousPhase;
+        double _startTime;
+    };
+
+    /**
+     * Enables or disables tracing.
+     *
+     * @param enabled true to trace the loading of assets.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Determines whether tracing is enabled.
+     *
+     * @return true if tracing is enabled.
+     */
+    static bool isEnabled();
+
+    /**
+     * Records bytes read for the asset being loaded on the calling thread.
+     *
+     * This is called by the file system and should not be called directly.
+     *
+     * @param bytes The number of bytes.
+     */
+    static void recordBytesRead(unsigned int bytes);
+
+    /**
+     * Discards the recorded loads.
+     */
+    static void reset();
+
+    /**
+     * Writes a report of the recorded loads, sorted by the time spent loading each asset.
+     *
+     * @param file The file to write to.
+     */
+    static void writeReport(FILE* file);
+
+    /**
+     * Writes the recorded loads as a trace in the Trace Event format of Chrome.
+     *
+     * @param file The file to write to.
+     */
+    static void writeTrace(FILE* file);
+
+    /**
+     * Gets the name of a phase.
+     *
+     * @param phase The phase.
+     *
+     * @return The name of the phase.
+     */
+    static const char* getPhaseName(Phase phase);
+
+private:
+
+    /**
+     * Constructor.
+     */
+    LoadTrace();
+
+    /**
+     * Enables tracing and sets the files to write when the game exits, from the loadTrace section of game.config.
+     */
+    static void initialize(Properties* properties);
+
+    /**
+     * Writes the files set by initialize and disables tracing.
+     */
+    static void finalize();
+};
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "Pass.h"
 #include "Properties.h"
 #include "Node.h"
+#include "LoadTrace.h"
 
 namespace gameplay
 {
@@ -30,8 +31,14 @@ Material::~Material()
 
 Material* Material::create(const char* url)
 {
+    LoadTrace::Asset trace("material", url);
+
     // Load the material properties from file.
-    Properties* properties = Properties::create(url);
+    Properties* properties;
+    {
+        LoadTrace::PhaseScope phase(LoadTrace::PARSE);
+        properties = Properties::create(url);
+    }
     if (properties == NULL)
     {
         GP_ERROR("Failed to create material from file.");
@@ -0,0 +1,272 @@
+#include "Base.h"
+#include "MemoryStats.h"
+#include "SpinLock.h"
+
+namespace gameplay
+{
+
+/**
+ * The resources created by loading a scene or bundle file.
+ */
+struct SourceRecord
+{
+    MemoryStats::SourceType type;
+    std::string path;
+    MemoryStats::Usage usage[MemoryStats::RESOURCE_TYPE_COUNT];
+    unsigned int resourceCount;
+};
+
+/**
+ * The memory owned by a resource.
+ */
+struct ResourceRecord
+{
+    MemoryStats::ResourceType type;
+    unsigned int cpuBytes;
+    unsigned int gpuBytes;
+    SourceRecord* sources[2];
+};
+
+static std::map<const void*, ResourceRecord> __resources;
+static std::map<std::string, SourceRecord> __sources;
+static MemoryStats::Usage __usage[MemoryStats::RESOURCE_TYPE_COUNT];
+static SpinLock __registryLock;
+
+// The paths are plain pointers so they can be thread local; the scope objects own their lifetime.
+static THREAD_LOCAL const char* __currentSourcePaths[2];
+
+static const char* __resourceTypeNames[MemoryStats::RESOURCE_TYPE_COUNT] =
+{
+    "texture",
+    "mesh",
+    "audio",
+    "animation",
+    "font",
+    "script"
+};
+
+static void addUsage(MemoryStats::Usage& usage, int count, int cpuBytes, int gpuBytes)
+{
+    usage.count += count;
+    usage.cpuBytes += cpuBytes;
+    usage.gpuBytes += gpuBytes;
+}
+
+static void writeString(FILE* file, const char* str)
+{
+    fputc('"', file);
+    for (; *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+            fputc('\\', file);
+        fputc(*str, file);
+    }
+    fputc('"', file);
+}
+
+static void writeUsage(FILE* file, const MemoryStats::Usage& usage)
+{
+    fprintf(file, "{\"count\":%u,\"cpu\":%u,\"gpu\":%u}", usage.count, usage.cpuBytes, usage.gpuBytes);
+}
+
+MemoryStats::Usage::Usage() : count(0), cpuBytes(0), gpuBytes(0)
+{
+}
+
+MemoryStats::Source::Source(SourceType type, const char* path)
+    : _type(type), _previousPath(__currentSourcePaths[type])
+{
+    GP_ASSERT(type == SCENE || type == BUNDLE);
+    __currentSourcePaths[type] = path;
+}
+
+MemoryStats::Source::~Source()
+{
+    __currentSourcePaths[_type] = _previousPath;
+}
+
+MemoryStats::MemoryStats()
+{
+}
+
+const MemoryStats::Usage& MemoryStats::getUsage(ResourceType type) const
+{
+    GP_ASSERT(type < RESOURCE_TYPE_COUNT);
+    return _usage[type];
+}
+
+MemoryStats::Usage MemoryStats::getTotalUsage() const
+{
+    Usage total;
+    for (unsigned int i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+    {
+        addUsage(total, _usage[i].count, _usage[i].cpuBytes, _usage[i].gpuBytes);
+    }
+    return total;
+}
+
+unsigned int MemoryStats::getSourceCount() const
+{
+    return _sources.size();
+}
+
+MemoryStats::SourceType MemoryStats::getSourceType(unsigned int index) const
+{
+    GP_ASSERT(index < _sources.size());
+    return _sources[index].type;
+}
+
+const char* MemoryStats::getSourcePath(unsigned int index) const
+{
+    GP_ASSERT(index < _sources.size());
+    return _sources[index].path.c_str();
+}
+
+const MemoryStats::Usage& MemoryStats::getSourceUsage(unsigned int index, ResourceType type) const
+{
+    GP_ASSERT(index < _sources.size());
+    GP_ASSERT(type < RESOURCE_TYPE_COUNT);
+    return _sources[index].usage[type];
+}
+
+const char* MemoryStats::getResourceTypeName(ResourceType type)
+{
+    GP_ASSERT(type < RESOURCE_TYPE_COUNT);
+    return __resourceTypeNames[type];
+}
+
+void MemoryStats::write(FILE* file, double time) const
+{
+    GP_ASSERT(file);
+
+    Usage total = getTotalUsage();
+    fprintf(file, "{\"time\":%.0f,\"total\":", time);
+    writeUsage(file, total);
+    for (unsigned int i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+    {
+        fprintf(file, ",\"%s\":", __resourceTypeNames[i]);
+        writeUsage(file, _usage[i]);
+    }
+
+    fputs(",\"sources\":[", file);
+    for (unsigned int i = 0, count = _sources.size(); i < count; ++i)
+    {
+        const SourceStats& source = _sources[i];
+        fputs(i > 0 ? ",{\"type\":" : "{\"type\":", file);
+        writeString(file, source.type == SCENE ? "scene" : "bundle");
+        fputs(",\"path\":", file);
+        writeString(file, source.path.c_str());
+        for (unsigned int j = 0; j < RESOURCE_TYPE_COUNT; ++j)
+        {
+            if (source.usage[j].count > 0)
+            {
+                fprintf(file, ",\"%s\":", __resourceTypeNames[j]);
+                writeUsage(file, source.usage[j]);
+            }
+        }
+        fputc('}', file);
+    }
+    fputs("]}\n", file);
+}
+
+void MemoryStats::track(const void* resource, ResourceType type, unsigned int cpuBytes, unsigned int gpuBytes)
+{
+    GP_ASSERT(resource);
+    GP_ASSERT(type < RESOURCE_TYPE_COUNT);
+
+    SpinLock::ScopedLock lock(__registryLock);
+
+    std::map<const void*, ResourceRecord>::iterator itr = __resources.find(resource);
+    if (itr != __resources.end())
+    {
+        // The resource has changed size, such as a texture that generated mipmaps.
+        ResourceRecord& record = itr->second;
+        int cpuDelta = (int)cpuBytes - (int)record.cpuBytes;
+        int gpuDelta = (int)gpuBytes - (int)record.gpuBytes;
+        addUsage(__usage[record.type], 0, cpuDelta, gpuDelta);
+        for (unsigned int i = 0; i < 2; ++i)
+        {
+            if (record.sources[i])
+                addUsage(record.sources[i]->usage[record.type], 0, cpuDelta, gpuDelta);
+        }
+        record.cpuBytes = cpuBytes;
+        record.gpuBytes = gpuBytes;
+        return;
+    }
+
+    ResourceRecord record;
+    record.type = type;
+    record.cpuBytes = cpuBytes;
+    record.gpuBytes = gpuBytes;
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        // A resource loaded from a bundle by a scene is attributed to both files.
+        record.sources[i] = NULL;
+        const char* path = __currentSourcePaths[i];
+        if (path == NULL)
+            continue;
+
+        std::string key = std::string(i == SCENE ? "scene:" : "bundle:") + path;
+        std::map<std::string, SourceRecord>::iterator sourceItr = __sources.find(key);
+        if (sourceItr == __sources.end())
+        {
+            sourceItr = __sources.insert(std::make_pair(key, SourceRecord())).first;
+            sourceItr->second.type = (SourceType)i;
+            sourceItr->second.path = path;
+            sourceItr->second.resourceCount = 0;
+        }
+        record.sources[i] = &sourceItr->second;
+        addUsage(record.sources[i]->usage[type], 1, cpuBytes, gpuBytes);
+        ++record.sources[i]->resourceCount;
+    }
+    addUsage(__usage[type], 1, cpuBytes, gpuBytes);
+    __resources[resource] = record;
+}
+
+void MemoryStats::untrack(const void* resource)
+{
+    SpinLock::ScopedLock lock(__registryLock);
+
+    std::map<const void*, ResourceRecord>::iterator itr = __resources.find(resource);
+    if (itr == __resources.end())
+        return;
+
+    ResourceRecord& record = itr->second;
+    addUsage(__usage[record.type], -1, -(int)record.cpuBytes, -(int)record.gpuBytes);
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        SourceRecord* source = record.sources[i];
+        if (source == NULL)
+            continue;
+
+        addUsage(source->usage[record.type], -1, -(int)record.cpuBytes, -(int)record.gpuBytes);
+
+        // Forget the file once all of its resources are gone.
+        if (--source->resourceCount == 0)
+        {
+            __sources.erase(std::string(i == SCENE ? "scene:" : "bundle:") + source->path);
+        }
+    }
+    __resources.erase(itr);
+}
+
+MemoryStats MemoryStats::capture()
+{
+    MemoryStats stats;
+
+    SpinLock::ScopedLock lock(__registryLock);
+
+    memcpy(stats._usage, __usage, sizeof(__usage));
+    stats._sources.reserve(__sources.size());
+    for (std::map<std::string, SourceRecord>::const_iterator itr = __sources.begin(); itr != __sources.end(); ++itr)
+    {
+        SourceStats source;
+        source.type = itr->second.type;
+        source.path = itr->second.path;
+        memcpy(source.usage, itr->second.usage, sizeof(source.usage));
+        stats._sources.push_back(source);
+    }
+    return stats;
+}
+
+}
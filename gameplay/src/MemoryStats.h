@@ -0,0 +1,234 @@
+#ifndef MEMORYSTATS_H_
+#define MEMORYSTATS_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a snapshot of the memory owned by the resources of the game.
+ *
+ * Textures, meshes, audio buffers, animation curves and fonts report the CPU and GPU
+ * memory they own to a registry as they are created and destroyed, and the script
+ * controller reports the memory of the Lua state. Resources created while a scene or
+ * bundle is being loaded are also attributed to the scene or bundle file, so the
+ * memory of each level and asset package can be budgeted on its own.
+ *
+ * A snapshot of the registry is taken with Game::getMemoryStats, and the game can
+ * append a snapshot to a file periodically with the memoryStats section of game.config:
+ * @code
+ * memoryStats
+ * {
+ *     dumpFile = memory.log
+ *     dumpInterval = 1000
+ * }
+ * @endcode
+ *
+ * @script{ignore}
+ */
+class MemoryStats
+{
+    friend class Game;
+
+public:
+
+    /**
+     * The types of resources that memory is accounted for.
+     */
+    enum ResourceType
+    {
+        TEXTURE,
+        MESH,
+        AUDIO,
+        ANIMATION,
+        FONT,
+        SCRIPT,
+        RESOURCE_TYPE_COUNT
+    };
+
+    /**
+     * The types of files that resources are attributed to.
+     */
+    enum SourceType
+    {
+        SCENE,
+        BUNDLE
+    };
+
+    /**
+     * The memory owned by a set of resources.
+     */
+    class Usage
+    {
+    public:
+
+        /**
+         * Constructor.
+         */
+        Usage();
+
+        /**
+         * The number of resources.
+         */
+        unsigned int count;
+
+        /**
+         * The number of bytes of system memory owned by the resources.
+         */
+        unsigned int cpuBytes;
+
+        /**
+         * The number of bytes of graphics memory owned by the resources.
+         */
+        unsigned int gpuBytes;
+    };
+
+    /**
+     * Attributes the resources created on the calling thread to a scene or bundle
+     * file for the lifetime of the scope object, restoring the previous file of the
+     * same type when it is destroyed.
+     *
+     * A scene and a bundle can be current at once, such as while a scene file loads
+     * the bundle it references, and resources are then attributed to both files.
+     */
+    class Source
+    {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param type The type of the file.
+         * @param path The path of the file, which must remain valid for the lifetime of the scope.
+         */
+        Source(SourceType type, const char* path);
+
+        /**
+         * Destructor.
+         */
+        ~Source();
+
+    private:
+
+        Source(const Source& copy);
+        Source& operator=(const Source&);
+
+        SourceType _type;
+        const char* _previousPath;
+    };
+
+    /**
+     * Constructor. Creates an empty snapshot.
+     */
+    MemoryStats();
+
+    /**
+     * Gets the memory owned by the resources of a type.
+     *
+     * @param type The type of resource.
+     *
+     * @return The memory owned by the resources.
+     */
+    const Usage& getUsage(ResourceType type) const;
+
+    /**
+     * Gets the memory owned by all resources.
+     *
+     * @return The memory owned by the resources.
+     */
+    Usage getTotalUsage() const;
+
+    /**
+     * Gets the number of scene and bundle files that own resources.
+     *
+     * @return The number of files.
+     */
+    unsigned int getSourceCount() const;
+
+    /**
+     * Gets the type of a file that owns resources.
+     *
+     * @param index The index of the file, less than getSourceCount.
+     *
+     * @return The type of the file.
+     */
+    SourceType getSourceType(unsigned int index) const;
+
+    /**
+     * Gets the path of a file that owns resources.
+     *
+     * @param index The index of the file, less than getSourceCount.
+     *
+     * @return The path of the file.
+     */
+    const char* getSourcePath(unsigned int index) const;
+
+    /**
+     * Gets the memory owned by the resources of a type that were created by loading a file.
+     *
+     * @param index The index of the file, less than getSourceCount.
+     * @param type The type of resource.
+     *
+     * @return The memory owned by the resources.
+     */
+    const Usage& getSourceUsage(unsigned int index, ResourceType type) const;
+
+    /**
+     * Gets the name of a resource type.
+     *
+     * @param type The type of resource.
+     *
+     * @return The name of the type.
+     */
+    static const char* getResourceTypeName(ResourceType type);
+
+    /**
+     * Writes the snapshot to a file as a single line of JSON.
+     *
+     * @param file The file to write to.
+     * @param time The game time the snapshot was taken at.
+     */
+    void write(FILE* file, double time) const;
+
+    /**
+     * Records the memory owned by a resource, or updates it if the resource is already recorded.
+     *
+     * A new resource is attributed to the files that are current on the calling thread.
+     * This is called by the resources and should not be called directly.
+     *
+     * @param resource The resource.
+     * @param type The type of resource.
+     * @param cpuBytes The number of bytes of system memory owned by the resource.
+     * @param gpuBytes The number of bytes of graphics memory owned by the resource.
+     */
+    static void track(const void* resource, ResourceType type, unsigned int cpuBytes, unsigned int gpuBytes);
+
+    /**
+     * Removes the record of a resource when it is destroyed.
+     *
+     * This is called by the resources and should not be called directly.
+     *
+     * @param resource The resource.
+     */
+    static void untrack(const void* resource);
+
+private:
+
+    struct SourceStats
+    {
+        SourceType type;
+        std::string path;
+        Usage usage[RESOURCE_TYPE_COUNT];
+    };
+
+    /**
+     * Takes a snapshot of the resources in the registry.
+     */
+    static MemoryStats capture();
+
+    Usage _usage[RESOURCE_TYPE_COUNT];
+    std::vector<SourceStats> _sources;
+};
+
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "Base.h"
+#include "MemoryTracker.h"
+#include "Atomic.h"
+
+namespace gameplay
+{
+
+// The counters are updated from the global allocation functions, so they are plain
+// statics that are valid before any constructor runs, and nothing here may allocate.
+static THREAD_LOCAL int __currentTag = MemoryTracker::GENERAL;
+static volatile int __bytes[MemoryTracker::TAG_COUNT];
+static volatile int __peakBytes[MemoryTracker::TAG_COUNT];
+static volatile int __allocationCount[MemoryTracker::TAG_COUNT];
+static volatile int __totalAllocationCount[MemoryTracker::TAG_COUNT];
+static volatile int __pendingFrameAllocationCount[MemoryTracker::TAG_COUNT];
+static unsigned int __frameAllocationCount[MemoryTracker::TAG_COUNT];
+static unsigned int __frameHistogram[MemoryTracker::TAG_COUNT][MemoryTracker::HISTOGRAM_BUCKET_COUNT];
+
+static const char* __tagNames[MemoryTracker::TAG_COUNT] =
+{
+    "general",
+    "animation",
+    "physics",
+    "script",
+    "ui",
+    "assets"
+};
+
+MemoryTracker::Scope::Scope(Tag tag) : _previous((Tag)__currentTag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    __currentTag = tag;
+}
+
+MemoryTracker::Scope::~Scope()
+{
+    __currentTag = _previous;
+}
+
+bool MemoryTracker::isEnabled()
+{
+#ifdef GAMEPLAY_MEM_TAGGING
+    return true;
+#else
+    return false;
+#endif
+}
+
+MemoryTracker::Tag MemoryTracker::getCurrentTag()
+{
+    return (Tag)__currentTag;
+}
+
+const char* MemoryTracker::getTagName(Tag tag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    return __tagNames[tag];
+}
+
+unsigned int MemoryTracker::getBytes(Tag tag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    return (unsigned int)Atomic::load(&__bytes[tag]);
+}
+
+unsigned int MemoryTracker::getPeakBytes(Tag tag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    return (unsigned int)Atomic::load(&__peakBytes[tag]);
+}
+
+unsigned int MemoryTracker::getAllocationCount(Tag tag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    return (unsigned int)Atomic::load(&__allocationCount[tag]);
+}
+
+unsigned int MemoryTracker::getTotalAllocationCount(Tag tag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    return (unsigned int)Atomic::load(&__totalAllocationCount[tag]);
+}
+
+unsigned int MemoryTracker::getFrameAllocationCount(Tag tag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    return __frameAllocationCount[tag];
+}
+
+unsigned int MemoryTracker::getFrameHistogram(Tag tag, unsigned int bucket)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    GP_ASSERT(bucket < HISTOGRAM_BUCKET_COUNT);
+    return __frameHistogram[tag][bucket];
+}
+
+void MemoryTracker::resetHistograms()
+{
+    memset(__frameHistogram, 0, sizeof(__frameHistogram));
+    for (unsigned int i = 0; i < TAG_COUNT; ++i)
+    {
+        Atomic::store(&__peakBytes[i], Atomic::load(&__bytes[i]));
+    }
+}
+
+MemoryTracker::Tag MemoryTracker::recordAllocation(unsigned int size)
+{
+    int tag = __currentTag;
+    int bytes = Atomic::add(&__bytes[tag], (int)size);
+    Atomic::increment(&__allocationCount[tag]);
+    Atomic::increment(&__totalAllocationCount[tag]);
+    Atomic::increment(&__pendingFrameAllocationCount[tag]);
+
+    // Raise the peak unless another thread has raised it further.
+    int peak = Atomic::load(&__peakBytes[tag]);
+    while (bytes > peak && !Atomic::compareAndSwap(&__peakBytes[tag], peak, bytes))
+    {
+        peak = Atomic::load(&__peakBytes[tag]);
+    }
+    return (Tag)tag;
+}
+
+void MemoryTracker::recordFree(unsigned int size, Tag tag)
+{
+    GP_ASSERT(tag < TAG_COUNT);
+    Atomic::add(&__bytes[tag], -(int)size);
+    Atomic::decrement(&__allocationCount[tag]);
+}
+
+void MemoryTracker::endFrame()
+{
+    for (unsigned int i = 0; i < TAG_COUNT; ++i)
+    {
+        // Take the count of the frame, keeping any allocations made concurrently for the next frame.
+        int count = Atomic::load(&__pendingFrameAllocationCount[i]);
+        Atomic::add(&__pendingFrameAllocationCount[i], -count);
+        __frameAllocationCount[i] = (unsigned int)count;
+
+        unsigned int bucket = 0;
+        while (count > 0 && bucket < HISTOGRAM_BUCKET_COUNT - 1)
+        {
+            count >>= 1;
+            ++bucket;
+        }
+        ++__frameHistogram[i][bucket];
+    }
+}
+
+}
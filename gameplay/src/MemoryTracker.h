@@ -0,0 +1,215 @@
+#ifndef MEMORYTRACKER_H_
+#define MEMORYTRACKER_H_
+
+// Allocation tracking is compiled in with leak detection, or on its own with GAMEPLAY_MEM_TRACKING,
+// which only adds a small header to each heap allocation and is cheap enough for release builds.
+#if defined(GAMEPLAY_MEM_LEAK_DETECTION) || defined(GAMEPLAY_MEM_TRACKING)
+#define GAMEPLAY_MEM_TAGGING
+#define GP_MEMORY_TAG(tag) gameplay::MemoryTracker::Scope memoryTagScope(gameplay::MemoryTracker::tag)
+#else
+#define GP_MEMORY_TAG(tag)
+#endif
+
+namespace gameplay
+{
+
+/**
+ * Defines per-subsystem counters of the heap allocations made by the game.
+ *
+ * Each heap allocation is attributed to the tag that is current on the allocating
+ * thread when it is made, and to the same tag when it is freed. The engine tags the
+ * work of its subsystems with GP_MEMORY_TAG, and games can tag their own code the same way:
+ * @code
+ * void MyGame::loadLevel()
+ * {
+ *     GP_MEMORY_TAG(ASSETS);
+ *     ...
+ * }
+ * @endcode
+ *
+ * Besides the bytes and allocations live for each tag, the tracker keeps a histogram
+ * of the number of allocations made for each tag per frame, to find the subsystems that
+ * allocate in the steady state.
+ *
+ * Counters are only updated when the engine is built with GAMEPLAY_MEM_TRACKING or
+ * GAMEPLAY_MEM_LEAK_DETECTION defined; otherwise they are all zero.
+ *
+ * @script{ignore}
+ */
+class MemoryTracker
+{
+    friend class Game;
+
+public:
+
+    /**
+     * The subsystems that allocations are attributed to.
+     */
+    enum Tag
+    {
+        GENERAL,
+        ANIMATION,
+        PHYSICS,
+        SCRIPT,
+        UI,
+        ASSETS,
+        TAG_COUNT
+    };
+
+    /**
+     * The number of buckets in the per-frame allocation histograms.
+     *
+     * Bucket zero counts the frames without allocations, and bucket n counts the
+     * frames with at least 2^(n-1) and fewer than 2^n allocations. The last bucket
+     * also counts all frames with more allocations.
+     */
+    static const unsigned int HISTOGRAM_BUCKET_COUNT = 16;
+
+    /**
+     * Makes a tag current on the calling thread for the lifetime of the scope object,
+     * restoring the previous tag when it is destroyed.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param tag The tag to make current.
+         */
+        explicit Scope(Tag tag);
+
+        /**
+         * Destructor.
+         */
+        ~Scope();
+
+    private:
+
+        Scope(const Scope& copy);
+        Scope& operator=(const Scope&);
+
+        Tag _previous;
+    };
+
+    /**
+     * Determines whether allocations are being tracked in this build.
+     *
+     * @return true if allocations are tracked.
+     */
+    static bool isEnabled();
+
+    /**
+     * Gets the tag that is current on the calling thread.
+     *
+     * @return The current tag.
+     */
+    static Tag getCurrentTag();
+
+    /**
+     * Gets the name of a tag.
+     *
+     * @param tag The tag.
+     *
+     * @return The name of the tag.
+     */
+    static const char* getTagName(Tag tag);
+
+    /**
+     * Gets the number of bytes currently allocated for a tag.
+     *
+     * @param tag The tag.
+     *
+     * @return The number of bytes.
+     */
+    static unsigned int getBytes(Tag tag);
+
+    /**
+     * Gets the largest number of bytes that have been allocated for a tag at once.
+     *
+     * @param tag The tag.
+     *
+     * @return The number of bytes.
+     */
+    static unsigned int getPeakBytes(Tag tag);
+
+    /**
+     * Gets the number of allocations currently live for a tag.
+     *
+     * @param tag The tag.
+     *
+     * @return The number of allocations.
+     */
+    static unsigned int getAllocationCount(Tag tag);
+
+    /**
+     * Gets the total number of allocations made for a tag.
+     *
+     * @param tag The tag.
+     *
+     * @return The number of allocations.
+     */
+    static unsigned int getTotalAllocationCount(Tag tag);
+
+    /**
+     * Gets the number of allocations made for a tag in the last frame.
+     *
+     * @param tag The tag.
+     *
+     * @return The number of allocations.
+     */
+    static unsigned int getFrameAllocationCount(Tag tag);
+
+    /**
+     * Gets the number of frames counted in a bucket of the per-frame allocation histogram of a tag.
+     *
+     * @param tag The tag.
+     * @param bucket The bucket, less than HISTOGRAM_BUCKET_COUNT.
+     *
+     * @return The number of frames.
+     */
+    static unsigned int getFrameHistogram(Tag tag, unsigned int bucket);
+
+    /**
+     * Clears the per-frame allocation histograms and the peak byte counts.
+     */
+    static void resetHistograms();
+
+    /**
+     * Records an allocation against the current tag.
+     *
+     * This is called by the global allocation functions and should not be called directly.
+     *
+     * @param size The size of the allocation.
+     *
+     * @return The tag the allocation was recorded against, to pass to recordFree.
+     */
+    static Tag recordAllocation(unsigned int size);
+
+    /**
+     * Records the freeing of an allocation.
+     *
+     * This is called by the global allocation functions and should not be called directly.
+     *
+     * @param size The size of the allocation.
+     * @param tag The tag returned by recordAllocation.
+     */
+    static void recordFree(unsigned int size, Tag tag);
+
+private:
+
+    /**
+     * Hidden constructor.
+     */
+    MemoryTracker();
+
+    /**
+     * Adds the allocations of the frame to the histograms.
+     */
+    static void endFrame();
+};
+
+}
+
+#endif
@@ -4,10 +4,27 @@
 #include "Effect.h"
 #include "Model.h"
 #include "Material.h"
+#include "MemoryStats.h"
 
 namespace gameplay
 {
 
+// Computes the size of the vertex buffer and the index buffers of all the parts and levels of detail of a mesh.
+static unsigned int computeMeshSize(Mesh* mesh)
+{
+    unsigned int size = mesh->getVertexSize() * mesh->getVertexCount();
+    for (unsigned int i = 0, count = mesh->getPartCount(); i < count; ++i)
+    {
+        for (unsigned int lod = 0, lodCount = mesh->getPart(i)->getLodCount(); lod < lodCount; ++lod)
+        {
+            MeshPart* part = mesh->getPart(i)->getLod(lod);
+            unsigned int indexSize = part->getIndexFormat() == Mesh::INDEX8 ? 1 : (part->getIndexFormat() == Mesh::INDEX16 ? 2 : 4);
+            size += indexSize * part->getIndexCount();
+        }
+    }
+    return size;
+}
+
 Mesh::Mesh(const VertexFormat& vertexFormat) 
     : _vertexFormat(vertexFormat), _vertexCount(0), _vertexBuffer(0), _primitiveType(TRIANGLES), 
       _partCount(0), _parts(NULL), _dynamic(false)
@@ -30,6 +47,7 @@ Mesh::~Mesh()
         glDeleteBuffers(1, &_vertexBuffer);
         _vertexBuffer = 0;
     }
+    MemoryStats::untrack(this);
 }
 
 Mesh* Mesh::createMesh(const VertexFormat& vertexFormat, unsigned int vertexCount, bool dynamic)
@@ -63,6 +81,7 @@ Mesh* Mesh::createMesh(const VertexFormat& vertexFormat, unsigned int vertexCoun
     mesh->_vertexCount = vertexCount;
     mesh->_vertexBuffer = vbo;
     mesh->_dynamic = dynamic;
+    MemoryStats::track(mesh, MemoryStats::MESH, 0, computeMeshSize(mesh));
 
     return mesh;
 }
@@ -319,6 +338,8 @@ MeshPart* Mesh::addPart(PrimitiveType primitiveType, IndexFormat indexFormat, un
 
         // Delete old part array.
         SAFE_DELETE_ARRAY(oldParts);
+
+        MemoryStats::track(this, MemoryStats::MESH, 0, computeMeshSize(this));
     }
 
     return part;
@@ -335,6 +356,48 @@ MeshPart* Mesh::getPart(unsigned int index)
     return _parts[index];
 }
 
+unsigned int Mesh::addLod(float error)
+{
+    GP_ASSERT(_lodErrors.empty() || error >= _lodErrors.back());
+    _lodErrors.push_back(error);
+    return (unsigned int)_lodErrors.size();
+}
+
+MeshPart* Mesh::addLodPart(unsigned int partIndex, IndexFormat indexFormat, unsigned int indexCount)
+{
+    GP_ASSERT(partIndex < _partCount);
+    GP_ASSERT(_parts[partIndex]->getLodCount() == _lodErrors.size());
+
+    MeshPart* part = _parts[partIndex]->addLod(indexFormat, indexCount);
+    if (part)
+    {
+        MemoryStats::track(this, MemoryStats::MESH, 0, computeMeshSize(this));
+    }
+    return part;
+}
+
+unsigned int Mesh::getLodCount() const
+{
+    return (unsigned int)_lodErrors.size() + 1;
+}
+
+float Mesh::getLodError(unsigned int lod) const
+{
+    GP_ASSERT(lod <= _lodErrors.size());
+    return lod == 0 ? 0.0f : _lodErrors[lod - 1];
+}
+
+unsigned int Mesh::getLod(float maxError) const
+{
+    // The errors grow with each level, so this finds the first one that is too large.
+    unsigned int lod = 0;
+    while (lod < _lodErrors.size() && _lodErrors[lod] <= maxError)
+    {
+        ++lod;
+    }
+    return lod;
+}
+
 const BoundingBox& Mesh::getBoundingBox() const
 {
     return _boundingBox;
@@ -227,6 +227,52 @@ public:
      */
     MeshPart* getPart(unsigned int index);
 
+    /**
+     * Adds a simplified level of detail to this mesh, which must be coarser than the levels
+     * of detail already added. Its index data is added to each part with addLodPart.
+     *
+     * @param error The geometric error of the level of detail, in the units of the mesh positions.
+     *
+     * @return The index of the new level of detail, where 0 is the mesh itself.
+     */
+    unsigned int addLod(float error);
+
+    /**
+     * Creates and adds the index data of the last level of detail that was added for a part.
+     *
+     * @param partIndex The index of the part.
+     * @param indexFormat The format of the indices.
+     * @param indexCount The number of indices of the part in the level of detail.
+     *
+     * @return The mesh part that holds the indices of the level of detail.
+     */
+    MeshPart* addLodPart(unsigned int partIndex, Mesh::IndexFormat indexFormat, unsigned int indexCount);
+
+    /**
+     * Gets the number of levels of detail of the mesh, including the mesh itself.
+     *
+     * @return The number of levels of detail.
+     */
+    unsigned int getLodCount() const;
+
+    /**
+     * Gets the geometric error of a level of detail, which is 0 for the mesh itself.
+     *
+     * @param lod The level of detail.
+     *
+     * @return The error, in the units of the mesh positions.
+     */
+    float getLodError(unsigned int lod) const;
+
+    /**
+     * Gets the coarsest level of detail whose error is at most the given error.
+     *
+     * @param maxError The largest error allowed, in the units of the mesh positions.
+     *
+     * @return The level of detail.
+     */
+    unsigned int getLod(float maxError) const;
+
     /**
      * Returns the bounding box for the points in this mesh.
      * 
@@ -314,6 +360,7 @@ private:
     PrimitiveType _primitiveType;
     unsigned int _partCount;
     MeshPart** _parts;
+    std::vector<float> _lodErrors;
     bool _dynamic;
     BoundingBox _boundingBox;
     BoundingSphere _boundingSphere;
@@ -1,5 +1,6 @@
 #include "Base.h"
 #include "MeshBatch.h"
+#include "RenderStats.h"
 
 namespace gameplay
 {
@@ -194,11 +195,14 @@ void MeshBatch::draw()
         if (_indexed)
         {
             GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)_indices) );
+            RenderStats::recordDrawCall(_primitiveType, _indexCount);
         }
         else
         {
             GL_ASSERT( glDrawArrays(_primitiveType, 0, _vertexCount) );
+            RenderStats::recordDrawCall(_primitiveType, _vertexCount);
         }
+        RenderStats::recordBatchVertices(_vertexCount);
 
         pass->unbind();
     }
@@ -11,6 +11,11 @@ MeshPart::MeshPart() :
 
 MeshPart::~MeshPart()
 {
+    for (std::vector<MeshPart*>::iterator itr = _lods.begin(); itr != _lods.end(); ++itr)
+    {
+        SAFE_DELETE(*itr);
+    }
+
     if (_indexBuffer)
     {
         glDeleteBuffers(1, &_indexBuffer);
@@ -74,6 +79,28 @@ MeshPart* MeshPart::create(Mesh* mesh, unsigned int meshIndex, Mesh::PrimitiveTy
     return part;
 }
 
+MeshPart* MeshPart::addLod(Mesh::IndexFormat indexFormat, unsigned int indexCount)
+{
+    MeshPart* part = create(_mesh, _meshIndex, _primitiveType, indexFormat, indexCount, false);
+    if (part)
+    {
+        _lods.push_back(part);
+    }
+    return part;
+}
+
+unsigned int MeshPart::getLodCount() const
+{
+    return (unsigned int)_lods.size() + 1;
+}
+
+MeshPart* MeshPart::getLod(unsigned int lod)
+{
+    if (lod == 0 || _lods.empty())
+        return this;
+    return _lods[std::min(lod, (unsigned int)_lods.size()) - 1];
+}
+
 unsigned int MeshPart::getMeshIndex() const
 {
     return _meshIndex;
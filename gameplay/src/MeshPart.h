@@ -74,6 +74,23 @@ public:
      */
     void setIndexData(void* indexData, unsigned int indexStart, unsigned int indexCount);
 
+    /**
+     * Gets the number of levels of detail of the part, including the part itself.
+     *
+     * @return The number of levels of detail.
+     */
+    unsigned int getLodCount() const;
+
+    /**
+     * Gets the part that holds the indices of a level of detail of this part.
+     *
+     * @param lod The level of detail, where 0 is this part. Levels past the
+     *      coarsest one get the coarsest one.
+     *
+     * @return The part of the level of detail.
+     */
+    MeshPart* getLod(unsigned int lod);
+
 private:
 
     /**
@@ -98,6 +115,14 @@ private:
      */
     static MeshPart* create(Mesh* mesh, unsigned int meshIndex, Mesh::PrimitiveType primitiveType, Mesh::IndexFormat indexFormat, unsigned int indexCount, bool dynamic = false);
 
+    /**
+     * Creates and adds the part that holds the indices of the next level of detail of this part.
+     *
+     * @param indexFormat The index format.
+     * @param indexCount The number of indices.
+     */
+    MeshPart* addLod(Mesh::IndexFormat indexFormat, unsigned int indexCount);
+
     Mesh* _mesh;
     unsigned int _meshIndex;
     Mesh::PrimitiveType _primitiveType;
@@ -105,6 +130,7 @@ private:
     unsigned int _indexCount;
     IndexBufferHandle _indexBuffer;
     bool _dynamic;
+    std::vector<MeshPart*> _lods;
 };
 
 }
@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "MeshSkin.h"
 #include "Joint.h"
+#include "Scene.h"
 
 // The number of rows in each palette matrix.
 #define PALETTE_ROWS 3
@@ -9,7 +10,7 @@ namespace gameplay
 {
 
 MeshSkin::MeshSkin()
-    : _rootJoint(NULL), _rootNode(NULL), _matrixPalette(NULL), _model(NULL)
+    : _rootJoint(NULL), _rootNode(NULL), _matrixPalette(NULL), _snapshotPalette(NULL), _partPalette(NULL), _activePart(-1), _model(NULL)
 {
 }
 
@@ -18,6 +19,8 @@ MeshSkin::~MeshSkin()
     clearJoints();
 
     SAFE_DELETE_ARRAY(_matrixPalette);
+    SAFE_DELETE_ARRAY(_snapshotPalette);
+    SAFE_DELETE_ARRAY(_partPalette);
 }
 
 const Matrix& MeshSkin::getBindShape() const
@@ -61,6 +64,7 @@ MeshSkin* MeshSkin::clone(NodeCloneContext &context) const
 {
     MeshSkin* skin = new MeshSkin();
     skin->_bindShape = _bindShape;
+    skin->setPartJoints(_partJoints);
     if (_rootNode && _rootJoint)
     {
         const unsigned int jointCount = getJointCount();
@@ -122,6 +126,7 @@ void MeshSkin::setJointCount(unsigned int jointCount)
 
     // Rebuild the matrix palette. Each matrix is 3 rows of Vector4.
     SAFE_DELETE_ARRAY(_matrixPalette);
+    SAFE_DELETE_ARRAY(_snapshotPalette);
 
     if (jointCount > 0)
     {
@@ -154,10 +159,87 @@ void MeshSkin::setJoint(Joint* joint, unsigned int index)
     }
 }
 
+unsigned int MeshSkin::getPartCount() const
+{
+    return _partJoints.size();
+}
+
+unsigned int MeshSkin::getPartJointCount(unsigned int partIndex) const
+{
+    GP_ASSERT(partIndex < _partJoints.size());
+    return _partJoints[partIndex].size();
+}
+
+Joint* MeshSkin::getPartJoint(unsigned int partIndex, unsigned int index) const
+{
+    GP_ASSERT(partIndex < _partJoints.size());
+    GP_ASSERT(index < _partJoints[partIndex].size());
+    return getJoint(_partJoints[partIndex][index]);
+}
+
+void MeshSkin::setPartJoints(const std::vector<std::vector<unsigned int> >& partJoints)
+{
+    _partJoints = partJoints;
+
+    SAFE_DELETE_ARRAY(_partPalette);
+
+    unsigned int maxJointCount = 0;
+    for (unsigned int i = 0, count = _partJoints.size(); i < count; ++i)
+    {
+        maxJointCount = std::max(maxJointCount, (unsigned int)_partJoints[i].size());
+    }
+    if (maxJointCount > 0)
+    {
+        _partPalette = new Vector4[maxJointCount * PALETTE_ROWS];
+    }
+}
+
+const std::vector<unsigned int>* MeshSkin::getActivePartJoints() const
+{
+    if (_activePart >= 0 && (unsigned int)_activePart < _partJoints.size())
+    {
+        return &_partJoints[_activePart];
+    }
+    return NULL;
+}
+
 Vector4* MeshSkin::getMatrixPalette() const
 {
     GP_ASSERT(_matrixPalette);
 
+    // The render thread of a pipelined game reads the palette the scene was snapshot with,
+    // since updating the joints would consume the dirty flags set by the simulation thread.
+    if (_snapshotPalette && Scene::isRenderingSnapshot())
+    {
+        const std::vector<unsigned int>* partJoints = getActivePartJoints();
+        if (partJoints == NULL)
+            return _snapshotPalette;
+
+        GP_ASSERT(_partPalette);
+        for (unsigned int i = 0, count = partJoints->size(); i < count; ++i)
+        {
+            unsigned int joint = (*partJoints)[i];
+            std::copy(&_snapshotPalette[joint * PALETTE_ROWS], &_snapshotPalette[(joint + 1) * PALETTE_ROWS], &_partPalette[i * PALETTE_ROWS]);
+        }
+        return _partPalette;
+    }
+
+    const std::vector<unsigned int>* partJoints = getActivePartJoints();
+    if (partJoints)
+    {
+        // Each joint keeps its matrix in its row of the full palette, which is only updated
+        // when the joint moves, and the rows of the part's joints are gathered from it.
+        GP_ASSERT(_partPalette);
+        for (unsigned int i = 0, count = partJoints->size(); i < count; ++i)
+        {
+            unsigned int joint = (*partJoints)[i];
+            GP_ASSERT(joint < _joints.size() && _joints[joint]);
+            _joints[joint]->updateJointMatrix(getBindShape(), &_matrixPalette[joint * PALETTE_ROWS]);
+            std::copy(&_matrixPalette[joint * PALETTE_ROWS], &_matrixPalette[(joint + 1) * PALETTE_ROWS], &_partPalette[i * PALETTE_ROWS]);
+        }
+        return _partPalette;
+    }
+
     unsigned int count = _joints.size();
     for (unsigned int i = 0; i < count; i++)
     {
@@ -167,8 +249,31 @@ Vector4* MeshSkin::getMatrixPalette() const
     return _matrixPalette;
 }
 
+void MeshSkin::snapshot()
+{
+    unsigned int count = _joints.size();
+    if (count == 0)
+        return;
+
+    GP_ASSERT(_matrixPalette);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        GP_ASSERT(_joints[i]);
+        _joints[i]->updateJointMatrix(getBindShape(), &_matrixPalette[i * PALETTE_ROWS]);
+    }
+
+    if (_snapshotPalette == NULL)
+        _snapshotPalette = new Vector4[count * PALETTE_ROWS];
+    std::copy(_matrixPalette, _matrixPalette + count * PALETTE_ROWS, _snapshotPalette);
+}
+
 unsigned int MeshSkin::getMatrixPaletteSize() const
 {
+    const std::vector<unsigned int>* partJoints = getActivePartJoints();
+    if (partJoints)
+    {
+        return partJoints->size() * PALETTE_ROWS;
+    }
     return _joints.size() * PALETTE_ROWS;
 }
 
@@ -21,6 +21,7 @@ class MeshSkin : public Transform::Listener
     friend class Model;
     friend class Joint;
     friend class Node;
+    friend class Scene;
 
 public:
 
@@ -84,8 +85,41 @@ public:
      */
     int getJointIndex(Joint* joint) const;
 
+    /**
+     * Returns the number of mesh parts that have their own joint palette.
+     *
+     * The encoder gives each part of a skinned mesh its own palette when it splits the parts
+     * to use fewer joints. The blend indices of the vertices of each part then index the
+     * joints of the part instead of the joints of this MeshSkin.
+     *
+     * @return The number of mesh parts, or zero if all mesh parts use the joints of this MeshSkin.
+     */
+    unsigned int getPartCount() const;
+
+    /**
+     * Returns the number of joints in the palette of the given mesh part.
+     *
+     * @param partIndex The index of the mesh part.
+     *
+     * @return The number of joints of the mesh part.
+     */
+    unsigned int getPartJointCount(unsigned int partIndex) const;
+
+    /**
+     * Returns a joint in the palette of the given mesh part.
+     *
+     * @param partIndex The index of the mesh part.
+     * @param index The index of the joint in the palette of the mesh part.
+     *
+     * @return The joint.
+     */
+    Joint* getPartJoint(unsigned int partIndex, unsigned int index) const;
+
     /**
      * Returns the pointer to the Vector4 array for the purpose of binding to a shader.
+     *
+     * While the Model draws a mesh part that has its own joint palette, only the matrices
+     * of the joints of that part are returned, in the order of the part's palette.
      * 
      * @return The pointer to the matrix palette.
      */
@@ -164,11 +198,29 @@ private:
      */
     void setRootNode(Node* node);
 
+    /**
+     * Sets the joint palette of each mesh part, which hold indices into the joints of this skin.
+     *
+     * @param partJoints The joint indices of each mesh part, or an empty list to use the joints of this skin for all parts.
+     */
+    void setPartJoints(const std::vector<std::vector<unsigned int> >& partJoints);
+
+    /**
+     * Returns the joint palette of the mesh part being drawn, or NULL if it uses the joints of this skin.
+     */
+    const std::vector<unsigned int>* getActivePartJoints() const;
+
     /**
      * Clears the list of joints and releases each joint.
      */
     void clearJoints();
 
+    /**
+     * Updates the matrix palette and copies it for pipelined rendering, so the render thread
+     * neither reads the joints nor consumes their dirty flags while the simulation moves them.
+     */
+    void snapshot();
+
     Matrix _bindShape;
     std::vector<Joint*> _joints;
     Joint* _rootJoint;
@@ -183,6 +235,20 @@ private:
     // Each 4x3 row-wise matrix is represented as 3 Vector4's.
     // The number of Vector4's is (_joints.size() * 3).
     Vector4* _matrixPalette;
+
+    // The matrix palette when the scene was last snapshot, read while rendering the snapshot.
+    Vector4* _snapshotPalette;
+
+    // The joint indices of the palette of each mesh part, which is empty when
+    // all mesh parts use the joints of this skin.
+    std::vector<std::vector<unsigned int> > _partJoints;
+
+    // The matrices of the joints of the mesh part being drawn, which are copied
+    // from the matrix palette. Sized for the largest mesh part palette.
+    Vector4* _partPalette;
+
+    // The index of the mesh part that the model is drawing, or -1.
+    int _activePart;
     Model* _model;
 };
 
@@ -5,12 +5,14 @@
 #include "Technique.h"
 #include "Pass.h"
 #include "Node.h"
+#include "RenderStats.h"
+#include "Game.h"
 
 namespace gameplay
 {
 
 Model::Model(Mesh* mesh) :
-    _mesh(mesh), _material(NULL), _partCount(0), _partMaterials(NULL), _node(NULL), _skin(NULL)
+    _mesh(mesh), _material(NULL), _partCount(0), _partMaterials(NULL), _node(NULL), _skin(NULL), _lodThreshold(1.0f)
 {
     GP_ASSERT(mesh);
     _partCount = mesh->getPartCount();
@@ -253,6 +255,54 @@ void Model::setNode(Node* node)
     }
 }
 
+void Model::setLodThreshold(float pixels)
+{
+    _lodThreshold = pixels;
+}
+
+float Model::getLodThreshold() const
+{
+    return _lodThreshold;
+}
+
+unsigned int Model::getLod() const
+{
+    GP_ASSERT(_mesh);
+
+    if (_mesh->getLodCount() <= 1 || !_node || !_node->getScene())
+        return 0;
+    Camera* camera = _node->getScene()->getActiveCamera();
+    if (!camera || !camera->getNode())
+        return 0;
+
+    // The errors are in mesh units, so they are scaled like the bounds of the mesh are by the node.
+    const BoundingSphere& sphere = _node->getBoundingSphere();
+    float meshRadius = _mesh->getBoundingSphere().radius;
+    float scale = meshRadius > 0.0f ? sphere.radius / meshRadius : 1.0f;
+
+    // The number of pixels that a unit in world space covers at the nearest point of the bounds.
+    float viewportHeight = Game::getInstance()->getViewport().height;
+    float pixelsPerUnit;
+    if (camera->getCameraType() == Camera::PERSPECTIVE)
+    {
+        float distance = camera->getNode()->getTranslationWorld().distance(sphere.center) - sphere.radius;
+        if (distance <= 0.0f)
+            return 0;
+        pixelsPerUnit = viewportHeight / (2.0f * distance * tan(MATH_DEG_TO_RAD(camera->getFieldOfView()) * 0.5f));
+    }
+    else
+    {
+        pixelsPerUnit = viewportHeight / camera->getZoomY();
+    }
+    if (pixelsPerUnit * scale <= 0.0f)
+        return 0;
+
+    // The frame governor allows a larger error, and so coarser levels, while rendering is over budget.
+    float threshold = _lodThreshold / Game::getInstance()->getFrameGovernor()->getQualityScale(FrameGovernor::RENDERING);
+
+    return _mesh->getLod(threshold / (pixelsPerUnit * scale));
+}
+
 void Model::draw(bool wireframe)
 {
     GP_ASSERT(_mesh);
@@ -278,11 +328,13 @@ void Model::draw(bool wireframe)
                     for (unsigned int j = 0; j < vertexCount; j += 3)
                     {
                         GL_ASSERT( glDrawArrays(GL_LINE_LOOP, j, 3) );
+                        RenderStats::recordDrawCall(GL_LINE_LOOP, 3);
                     }
                 }
                 else
                 {
                     GL_ASSERT( glDrawArrays(_mesh->getPrimitiveType(), 0, _mesh->getVertexCount()) );
+                    RenderStats::recordDrawCall(_mesh->getPrimitiveType(), _mesh->getVertexCount());
                 }
                 pass->unbind();
             }
@@ -290,15 +342,22 @@ void Model::draw(bool wireframe)
     }
     else
     {
+        unsigned int lod = getLod();
         for (unsigned int i = 0; i < partCount; ++i)
         {
-            MeshPart* part = _mesh->getPart(i);
+            MeshPart* part = _mesh->getPart(i)->getLod(lod);
             GP_ASSERT(part);
 
             // Get the material for this mesh part.
             Material* material = getMaterial(i);
             if (material)
             {
+                // Mesh parts that have their own joint palette only upload the matrices of their joints.
+                if (_skin)
+                {
+                    _skin->_activePart = i;
+                }
+
                 Technique* technique = material->getTechnique();
                 GP_ASSERT(technique);
                 unsigned int passCount = technique->getPassCount();
@@ -331,16 +390,22 @@ void Model::draw(bool wireframe)
                         for (unsigned int k = 0; k < indexCount; k += 3)
                         {
                             GL_ASSERT( glDrawElements(GL_LINE_LOOP, 3, part->getIndexFormat(), ((const GLvoid*)(k*indexSize))) );
+                            RenderStats::recordDrawCall(GL_LINE_LOOP, 3);
                         }
                     }
                     else
                     {
                         GL_ASSERT( glDrawElements(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0) );
+                        RenderStats::recordDrawCall(part->getPrimitiveType(), part->getIndexCount());
                     }
                     pass->unbind();
                 }
             }
         }
+        if (_skin)
+        {
+            _skin->_activePart = -1;
+        }
     }
 }
 
@@ -381,6 +446,7 @@ Model* Model::clone(NodeCloneContext &context)
         return NULL;
     }
 
+    model->setLodThreshold(getLodThreshold());
     if (getSkin())
     {
         model->setSkin(getSkin()->clone(context));
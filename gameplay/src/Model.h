@@ -134,11 +134,36 @@ public:
      */
     Node* getNode() const;
 
+    /**
+     * Sets the largest error, in pixels on the screen, that a level of detail of the mesh may have
+     * to be drawn. The default is 1 pixel.
+     *
+     * @param pixels The largest screen space error of the level of detail to draw.
+     */
+    void setLodThreshold(float pixels);
+
+    /**
+     * Gets the largest error, in pixels on the screen, that a level of detail of the mesh may have to be drawn.
+     *
+     * @return The largest screen space error of the level of detail to draw.
+     */
+    float getLodThreshold() const;
+
+    /**
+     * Gets the level of detail of the mesh that this model draws with, which is the coarsest one
+     * whose error projects to at most the LOD threshold in pixels from the active camera of the
+     * scene of the node. The threshold is divided by the quality scale of rendering in the frame
+     * governor, so coarser levels are drawn while rendering is over budget.
+     *
+     * @return The level of detail, where 0 is the mesh itself.
+     */
+    unsigned int getLod() const;
+
     /**
      * Draws this mesh instance.
      *
      * This method binds the vertex buffer and index buffers for the Mesh and
-     * all of its MeshParts and draws the mesh geometry. Any other state
+     * all of its MeshParts at the level of detail returned by getLod and draws the mesh geometry. Any other state
      * necessary to render the Mesh, such as rendering states, shader state,
      * and so on, should be set up before calling this method.
      *
@@ -198,6 +223,7 @@ private:
     Material** _partMaterials;
     Node* _node;
     MeshSkin* _skin;
+    float _lodThreshold;
 };
 
 }
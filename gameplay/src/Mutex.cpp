@@ -0,0 +1,92 @@
+#include "Base.h"
+#include "Mutex.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace gameplay
+{
+
+#ifdef WIN32
+
+Mutex::Mutex()
+{
+    CRITICAL_SECTION* criticalSection = new CRITICAL_SECTION;
+    InitializeCriticalSection(criticalSection);
+    _handle = criticalSection;
+}
+
+Mutex::~Mutex()
+{
+    CRITICAL_SECTION* criticalSection = (CRITICAL_SECTION*)_handle;
+    DeleteCriticalSection(criticalSection);
+    SAFE_DELETE(criticalSection);
+}
+
+void Mutex::lock()
+{
+    EnterCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+bool Mutex::tryLock()
+{
+    return TryEnterCriticalSection((CRITICAL_SECTION*)_handle) != 0;
+}
+
+void Mutex::unlock()
+{
+    LeaveCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+#else
+
+Mutex::Mutex()
+{
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+
+    pthread_mutex_t* mutex = new pthread_mutex_t;
+    pthread_mutex_init(mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    _handle = mutex;
+}
+
+Mutex::~Mutex()
+{
+    pthread_mutex_t* mutex = (pthread_mutex_t*)_handle;
+    pthread_mutex_destroy(mutex);
+    SAFE_DELETE(mutex);
+}
+
+void Mutex::lock()
+{
+    pthread_mutex_lock((pthread_mutex_t*)_handle);
+}
+
+bool Mutex::tryLock()
+{
+    return pthread_mutex_trylock((pthread_mutex_t*)_handle) == 0;
+}
+
+void Mutex::unlock()
+{
+    pthread_mutex_unlock((pthread_mutex_t*)_handle);
+}
+
+#endif
+
+Mutex::ScopedLock::ScopedLock(Mutex& mutex) : _mutex(mutex)
+{
+    _mutex.lock();
+}
+
+Mutex::ScopedLock::~ScopedLock()
+{
+    _mutex.unlock();
+}
+
+}
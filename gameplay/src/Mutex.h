@@ -0,0 +1,90 @@
+#ifndef MUTEX_H_
+#define MUTEX_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a recursive mutual exclusion lock.
+ *
+ * The thread that holds the lock may lock it again, as long as
+ * every call to lock() is matched with a call to unlock().
+ *
+ * @script{ignore}
+ */
+class Mutex
+{
+public:
+
+    /**
+     * Locks a Mutex for the lifetime of the ScopedLock.
+     */
+    class ScopedLock
+    {
+    public:
+
+        /**
+         * Constructor. Locks the mutex.
+         *
+         * @param mutex The mutex to lock.
+         */
+        explicit ScopedLock(Mutex& mutex);
+
+        /**
+         * Destructor. Unlocks the mutex.
+         */
+        ~ScopedLock();
+
+    private:
+
+        ScopedLock(const ScopedLock& copy);
+        ScopedLock& operator=(const ScopedLock&);
+
+        Mutex& _mutex;
+    };
+
+    /**
+     * Constructor.
+     */
+    Mutex();
+
+    /**
+     * Destructor.
+     */
+    ~Mutex();
+
+    /**
+     * Locks the mutex, blocking until it is available.
+     */
+    void lock();
+
+    /**
+     * Attempts to lock the mutex without blocking.
+     *
+     * @return true if the mutex was locked, false if another thread holds it.
+     */
+    bool tryLock();
+
+    /**
+     * Unlocks the mutex.
+     */
+    void unlock();
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    Mutex(const Mutex& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Mutex& operator=(const Mutex&);
+
+    void* _handle;
+};
+
+}
+
+#endif
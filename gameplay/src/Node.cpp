@@ -21,10 +21,30 @@
 namespace gameplay
 {
 
+/**
+ * Storage for a matrix that a getter returns by reference. The storage is per thread, so the render
+ * thread of a pipelined game and the simulation thread do not overwrite each other's results, and
+ * holds plain floats since thread-local variables cannot have constructors.
+ */
+struct ScratchMatrix
+{
+    float m[16];
+
+    Matrix& get()
+    {
+        return *reinterpret_cast<Matrix*>(m);
+    }
+};
+
+static THREAD_LOCAL ScratchMatrix __worldView;
+static THREAD_LOCAL ScratchMatrix __invTransWorldView;
+static THREAD_LOCAL ScratchMatrix __invTransWorld;
+static THREAD_LOCAL ScratchMatrix __worldViewProj;
+
 Node::Node(const char* id)
     : _scene(NULL), _firstChild(NULL), _nextSibling(NULL), _prevSibling(NULL), _parent(NULL), _childCount(0),
     _nodeFlags(NODE_FLAG_VISIBLE), _camera(NULL), _light(NULL), _model(NULL), _form(NULL), _audioSource(NULL), _particleEmitter(NULL),
-    _collisionObject(NULL), _agent(NULL), _dirtyBits(NODE_DIRTY_ALL), _notifyHierarchyChanged(true), _userData(NULL)
+    _collisionObject(NULL), _agent(NULL), _dirtyBits(NODE_DIRTY_ALL), _notifyHierarchyChanged(true), _hasSnapshot(false), _userData(NULL)
 {
     if (id)
     {
@@ -385,6 +405,11 @@ Node* Node::getRootNode() const
 
 const Matrix& Node::getWorldMatrix() const
 {
+    // The render thread of a pipelined game reads the matrix the scene was snapshot with,
+    // since the game thread updates the node concurrently.
+    if (Scene::isRenderingSnapshot())
+        return _hasSnapshot ? _snapshotWorld : _world;
+
     if (_dirtyBits & NODE_DIRTY_WORLD)
     {
         // Clear our dirty flag immediately to prevent this block from being entered if our
@@ -416,7 +441,7 @@ const Matrix& Node::getWorldMatrix() const
 
 const Matrix& Node::getWorldViewMatrix() const
 {
-    static Matrix worldView;
+    Matrix& worldView = __worldView.get();
 
     Matrix::multiply(getViewMatrix(), getWorldMatrix(), &worldView);
 
@@ -425,7 +450,7 @@ const Matrix& Node::getWorldViewMatrix() const
 
 const Matrix& Node::getInverseTransposeWorldViewMatrix() const
 {
-    static Matrix invTransWorldView;
+    Matrix& invTransWorldView = __invTransWorldView.get();
     Matrix::multiply(getViewMatrix(), getWorldMatrix(), &invTransWorldView);
     invTransWorldView.invert();
     invTransWorldView.transpose();
@@ -434,7 +459,7 @@ const Matrix& Node::getInverseTransposeWorldViewMatrix() const
 
 const Matrix& Node::getInverseTransposeWorldMatrix() const
 {
-    static Matrix invTransWorld;
+    Matrix& invTransWorld = __invTransWorld.get();
     invTransWorld = getWorldMatrix();
     invTransWorld.invert();
     invTransWorld.transpose();
@@ -511,7 +536,7 @@ const Matrix& Node::getInverseViewProjectionMatrix() const
 
 const Matrix& Node::getWorldViewProjectionMatrix() const
 {
-    static Matrix worldViewProj;
+    Matrix& worldViewProj = __worldViewProj.get();
 
     // Always re-calculate worldViewProjection matrix since it's extremely difficult
     // to track whether the camera has changed (it may frequently change every frame).
@@ -806,6 +831,9 @@ Form* Node::getForm() const
 
 const BoundingSphere& Node::getBoundingSphere() const
 {
+    if (Scene::isRenderingSnapshot())
+        return _hasSnapshot ? _snapshotBounds : _bounds;
+
     if (_dirtyBits & NODE_DIRTY_BOUNDS)
     {
         _dirtyBits &= ~NODE_DIRTY_BOUNDS;
@@ -794,6 +794,21 @@ protected:
      */
     mutable BoundingSphere _bounds;
 
+    /**
+     * The world matrix of the Node when the scene was last snapshot for pipelined rendering.
+     */
+    Matrix _snapshotWorld;
+
+    /**
+     * The bounding sphere of the Node when the scene was last snapshot for pipelined rendering.
+     */
+    BoundingSphere _snapshotBounds;
+
+    /**
+     * A flag indicating if the snapshot matrix and bounds are set.
+     */
+    bool _hasSnapshot;
+
     /**
      * Pointer to custom UserData and cleanup call back that can be stored in a Node.
      */
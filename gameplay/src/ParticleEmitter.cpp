@@ -797,13 +797,20 @@ void ParticleEmitter::update(float elapsedTime)
         return;
     }
 
+    // Measure the cost of particles for the frame governor, which scales down emission under load.
+    // The governor may be enabled during the update, so it is only checked once.
+    FrameGovernor* governor = Game::getInstance()->getFrameGovernor();
+    GP_ASSERT(governor);
+    bool governed = governor->isEnabled();
+    double startTime = governed ? Platform::getAbsoluteTime() : 0;
+
     // Calculate the time passed since last update.
     float elapsedSecs = elapsedTime * 0.001f;
 
     if (_started && _emissionRate)
     {
         // Calculate how much time has passed since we last emitted particles.
-        _timeRunning += elapsedTime;
+        _timeRunning += elapsedTime * governor->getQualityScale(FrameGovernor::PARTICLES);
 
         // How many particles should we emit this frame?
         GP_ASSERT(_timePerEmission);
@@ -912,6 +919,11 @@ void ParticleEmitter::update(float elapsedTime)
             --_particleCount;
         }
     }
+
+    if (governed)
+    {
+        governor->addSubsystemTime(FrameGovernor::PARTICLES, Platform::getAbsoluteTime() - startTime);
+    }
 }
 
 void ParticleEmitter::draw()
@@ -3,6 +3,7 @@
 #include "Technique.h"
 #include "Material.h"
 #include "Node.h"
+#include "RenderStats.h"
 
 namespace gameplay
 {
@@ -63,6 +64,9 @@ void Pass::bind()
 {
     GP_ASSERT(_effect);
 
+    // Count the work that follows to this pass.
+    RenderStats::recordPass(this);
+
     // Bind our effect.
     _effect->bind();
 
@@ -83,6 +87,8 @@ void Pass::unbind()
     {
         _vaBinding->unbind();
     }
+
+    RenderStats::recordPass(NULL);
 }
 
 Pass* Pass::clone(Technique* technique, NodeCloneContext &context) const
@@ -22,6 +22,7 @@ class Pass : public RenderState
     friend class Technique;
     friend class Material;
     friend class RenderState;
+    friend class RenderStats;
 
 public:
 
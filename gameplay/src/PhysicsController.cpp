@@ -465,15 +465,20 @@ void PhysicsController::resume()
 
 void PhysicsController::update(float elapsedTime)
 {
+    GP_MEMORY_TAG(PHYSICS);
     GP_ASSERT(_world);
     _isUpdating = true;
 
     // Update the physics simulation, with a maximum
     // of 10 simulation steps being performed in a given frame.
+    // The fixed step is doubled for each level the frame governor
+    // has lowered the quality of physics to, so that fewer steps
+    // simulate the same time instead of dropping time under load.
     //
     // Note that stepSimulation takes elapsed time in seconds
     // so we divide by 1000 to convert from milliseconds.
-    _world->stepSimulation(elapsedTime * 0.001f, 10);
+    float interval = (float)Game::getInstance()->getFrameGovernor()->getUpdateInterval(FrameGovernor::PHYSICS);
+    _world->stepSimulation(elapsedTime * 0.001f, 10, interval / 60.0f);
 
     // If we have status listeners, then check if our status has changed.
     if (_listeners || _callbacks["statusEvent"])
@@ -1182,11 +1187,14 @@ PhysicsCollisionShape* PhysicsController::createMesh(Mesh* mesh, const Vector3&
     shapeMeshData->vertexData = new float[vertexCount * 3];
     Vector3 v;
     int vertexStride = data->vertexFormat.getVertexSize();
+    // The position is the first element of the vertex and may be stored as half floats.
+    const VertexFormat::Element& positionElement = data->vertexFormat.getElement(0);
+    GP_ASSERT(positionElement.usage == VertexFormat::POSITION && positionElement.size >= 3 && positionElement.size <= 4);
+    float position[4];
     for (unsigned int i = 0; i < data->vertexCount; i++)
     {
-        v.set(*((float*)&data->vertexData[i * vertexStride + 0 * sizeof(float)]),
-              *((float*)&data->vertexData[i * vertexStride + 1 * sizeof(float)]),
-              *((float*)&data->vertexData[i * vertexStride + 2 * sizeof(float)]));
+        VertexFormat::unpack(positionElement, &data->vertexData[i * vertexStride], position);
+        v.set(position[0], position[1], position[2]);
         v *= m;
         memcpy(&(shapeMeshData->vertexData[i * 3]), &v, sizeof(float) * 3);
     }
@@ -6,6 +6,7 @@
 #include "Game.h"
 #include "Form.h"
 #include "ScriptController.h"
+#include "InputRecorder.h"
 #include <unistd.h>
 
 #include <android/sensor.h>
@@ -963,6 +964,9 @@ void Platform::displayKeyboard(bool display)
 
 void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
 {
+    if (!InputRecorder::recordTouchEvent(evt, x, y, contactIndex))
+        return;
+
     if (!Form::touchEventInternal(evt, x, y, contactIndex))
     {
         Game::getInstance()->touchEvent(evt, x, y, contactIndex);
@@ -972,6 +976,9 @@ void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned
 
 void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 {
+    if (!InputRecorder::recordKeyEvent(evt, key))
+        return;
+
     if (!Form::keyEventInternal(evt, key))
     {
         Game::getInstance()->keyEvent(evt, key);
@@ -981,6 +988,10 @@ void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 
 bool Platform::mouseEventInternal(Mouse::MouseEvent evt, int x, int y, int wheelDelta)
 {
+    // An ignored event is consumed, so the platform does not deliver it as a touch instead.
+    if (!InputRecorder::recordMouseEvent(evt, x, y, wheelDelta))
+        return true;
+
     if (Form::mouseEventInternal(evt, x, y, wheelDelta))
     {
         return true;
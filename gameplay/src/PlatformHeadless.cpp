@@ -0,0 +1,259 @@
+#if defined(GP_PLATFORM_HEADLESS) || (defined(__linux__) && !defined(__ANDROID__))
+
+#include "Base.h"
+#include "Platform.h"
+#include "FileSystem.h"
+#include "Game.h"
+#include "Form.h"
+#include "ScriptController.h"
+#include "InputRecorder.h"
+#include "GLCapture.h"
+#ifndef WIN32
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// The headless platform has no window or GL context, so the game runs on the null renderer (see
+// GLCapture), such as for benchmarks and captures on build machines without a GPU or display. It is
+// the platform of Linux, and of any build that defines GP_PLATFORM_HEADLESS.
+
+// Default to 720p
+static int __width = 1280;
+static int __height = 720;
+static double __timeStart;
+static double __timeAbsolute;
+static bool __vsync = WINDOW_VSYNC;
+static bool __mouseCaptured = false;
+static bool __cursorVisible = true;
+
+/**
+ * Gets the time of the monotonic clock (in milliseconds).
+ */
+static double getMonotonicTime()
+{
+#ifdef WIN32
+    LARGE_INTEGER ticksPerSecond;
+    LARGE_INTEGER ticks;
+    QueryPerformanceFrequency(&ticksPerSecond);
+    QueryPerformanceCounter(&ticks);
+    return (1000.0 * ticks.QuadPart) / ticksPerSecond.QuadPart;
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (1000.0 * time.tv_sec) + (0.000001 * time.tv_nsec);
+#endif
+}
+
+namespace gameplay
+{
+
+extern void printError(const char* format, ...)
+{
+    va_list argptr;
+    va_start(argptr, format);
+    vfprintf(stderr, format, argptr);
+    va_end(argptr);
+}
+
+Platform::Platform(Game* game)
+    : _game(game)
+{
+}
+
+Platform::~Platform()
+{
+}
+
+Platform* Platform::create(Game* game, void* attachToWindow)
+{
+    GP_ASSERT(game);
+
+    FileSystem::setResourcePath("./");
+
+    if (attachToWindow || !GLCapture::initializeHeadless(game->getConfig()))
+    {
+        GP_ERROR("The headless platform only runs on the null renderer; build with GP_USE_GL_CAPTURE and set nullRenderer in the glCapture section of game.config.");
+        return NULL;
+    }
+
+    // The size of the window the game would have, which sets the viewport.
+    if (game->getConfig())
+    {
+        Properties* config = game->getConfig()->getNamespace("window", true);
+        if (config)
+        {
+            int width = config->getInt("width");
+            if (width != 0)
+                __width = width;
+            int height = config->getInt("height");
+            if (height != 0)
+                __height = height;
+        }
+    }
+
+    return new Platform(game);
+}
+
+int Platform::enterMessagePump()
+{
+    GP_ASSERT(_game);
+
+    __timeStart = getMonotonicTime();
+
+    if (_game->getState() != Game::RUNNING)
+        _game->run();
+
+    // There are no messages to dispatch, so frames run until the game exits.
+    while (_game->getState() != Game::UNINITIALIZED)
+    {
+        _game->frame();
+    }
+    return 0;
+}
+
+void Platform::signalShutdown()
+{
+    // nothing to do
+}
+
+unsigned int Platform::getDisplayWidth()
+{
+    return __width;
+}
+
+unsigned int Platform::getDisplayHeight()
+{
+    return __height;
+}
+
+double Platform::getAbsoluteTime()
+{
+    __timeAbsolute = getMonotonicTime() - __timeStart;
+    return __timeAbsolute;
+}
+
+void Platform::setAbsoluteTime(double time)
+{
+    __timeAbsolute = time;
+}
+
+bool Platform::isVsync()
+{
+    return __vsync;
+}
+
+void Platform::setVsync(bool enable)
+{
+    __vsync = enable;
+}
+
+void Platform::setMultiTouch(bool enabled)
+{
+    // not supported
+}
+
+bool Platform::isMultiTouch()
+{
+    return false;
+}
+
+void Platform::getAccelerometerValues(float* pitch, float* roll)
+{
+    GP_ASSERT(pitch);
+    GP_ASSERT(roll);
+
+    *pitch = 0.0f;
+    *roll = 0.0f;
+}
+
+bool Platform::hasMouse()
+{
+    return false;
+}
+
+void Platform::setMouseCaptured(bool captured)
+{
+    __mouseCaptured = captured;
+}
+
+bool Platform::isMouseCaptured()
+{
+    return __mouseCaptured;
+}
+
+void Platform::setCursorVisible(bool visible)
+{
+    __cursorVisible = visible;
+}
+
+bool Platform::isCursorVisible()
+{
+    return __cursorVisible;
+}
+
+void Platform::swapBuffers()
+{
+    // Nothing is presented.
+}
+
+void Platform::displayKeyboard(bool display)
+{
+    // Do nothing.
+}
+
+void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
+{
+    if (!InputRecorder::recordTouchEvent(evt, x, y, contactIndex))
+        return;
+
+    if (!Form::touchEventInternal(evt, x, y, contactIndex))
+    {
+        Game::getInstance()->touchEvent(evt, x, y, contactIndex);
+        Game::getInstance()->getScriptController()->touchEvent(evt, x, y, contactIndex);
+    }
+}
+
+void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
+{
+    if (!InputRecorder::recordKeyEvent(evt, key))
+        return;
+
+    if (!Form::keyEventInternal(evt, key))
+    {
+        Game::getInstance()->keyEvent(evt, key);
+        Game::getInstance()->getScriptController()->keyEvent(evt, key);
+    }
+}
+
+bool Platform::mouseEventInternal(Mouse::MouseEvent evt, int x, int y, int wheelDelta)
+{
+    // An ignored event is consumed, so the platform does not deliver it as a touch instead.
+    if (!InputRecorder::recordMouseEvent(evt, x, y, wheelDelta))
+        return true;
+
+    if (Form::mouseEventInternal(evt, x, y, wheelDelta))
+    {
+        return true;
+    }
+    else if (Game::getInstance()->mouseEvent(evt, x, y, wheelDelta))
+    {
+        return true;
+    }
+    else
+    {
+        return Game::getInstance()->getScriptController()->mouseEvent(evt, x, y, wheelDelta);
+    }
+}
+
+void Platform::sleep(long ms)
+{
+#ifdef WIN32
+    Sleep(ms);
+#else
+    usleep(ms * 1000);
+#endif
+}
+
+}
+
+#endif
@@ -1,4 +1,4 @@
-#ifdef __APPLE__
+#if defined(__APPLE__) && !defined(GP_PLATFORM_HEADLESS)
 
 #include "Base.h"
 #include "Platform.h"
@@ -6,6 +6,8 @@
 #include "Game.h"
 #include "Form.h"
 #include "ScriptController.h"
+#include "InputRecorder.h"
+#include "GLCapture.h"
 #include <unistd.h>
 #import <Cocoa/Cocoa.h>
 #import <QuartzCore/CVDisplayLink.h>
@@ -676,6 +678,18 @@ int Platform::enterMessagePump()
     ACCELEROMETER_FACTOR_X = 90.0f / __width;
     ACCELEROMETER_FACTOR_Y = 90.0f / __height;
 
+    // The null renderer makes no GL calls, so no window or context is needed and
+    // frames run until the game exits.
+    if (GLCapture::initializeHeadless(_game->getConfig()))
+    {
+        _game->run();
+        while (_game->getState() != Game::UNINITIALIZED)
+        {
+            _game->frame();
+        }
+        return EXIT_SUCCESS;
+    }
+
     NSAutoreleasePool* pool = [NSAutoreleasePool new];
     NSApplication* app = [NSApplication sharedApplication];
     NSRect screenBounds = [[NSScreen mainScreen] frame];
@@ -842,6 +856,9 @@ void Platform::displayKeyboard(bool display)
 
 void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
 {
+    if (!InputRecorder::recordTouchEvent(evt, x, y, contactIndex))
+        return;
+
     if (!Form::touchEventInternal(evt, x, y, contactIndex))
     {
         Game::getInstance()->touchEvent(evt, x, y, contactIndex);
@@ -851,6 +868,9 @@ void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned
     
 void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 {
+    if (!InputRecorder::recordKeyEvent(evt, key))
+        return;
+
     if (!Form::keyEventInternal(evt, key))
     {
         Game::getInstance()->keyEvent(evt, key);
@@ -860,6 +880,10 @@ void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 
 bool Platform::mouseEventInternal(Mouse::MouseEvent evt, int x, int y, int wheelDelta)
 {
+    // An ignored event is consumed, so the platform does not deliver it as a touch instead.
+    if (!InputRecorder::recordMouseEvent(evt, x, y, wheelDelta))
+        return true;
+
     if (Form::mouseEventInternal(evt, x, y, wheelDelta))
     {
         return true;
@@ -6,6 +6,7 @@
 #include "Game.h"
 #include "Form.h"
 #include "ScriptController.h"
+#include "InputRecorder.h"
 #include <unistd.h>
 #include <sys/keycodes.h>
 #include <screen/screen.h>
@@ -1159,6 +1160,9 @@ void Platform::displayKeyboard(bool display)
 
 void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
 {
+    if (!InputRecorder::recordTouchEvent(evt, x, y, contactIndex))
+        return;
+
     if (!Form::touchEventInternal(evt, x, y, contactIndex))
     {
         Game::getInstance()->touchEvent(evt, x, y, contactIndex);
@@ -1168,6 +1172,9 @@ void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned
 
 void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 {
+    if (!InputRecorder::recordKeyEvent(evt, key))
+        return;
+
     if (!Form::keyEventInternal(evt, key))
     {
         Game::getInstance()->keyEvent(evt, key);
@@ -1177,6 +1184,10 @@ void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 
 bool Platform::mouseEventInternal(Mouse::MouseEvent evt, int x, int y, int wheelDelta)
 {
+    // An ignored event is consumed, so the platform does not deliver it as a touch instead.
+    if (!InputRecorder::recordMouseEvent(evt, x, y, wheelDelta))
+        return true;
+
     if (Form::mouseEventInternal(evt, x, y, wheelDelta))
     {
         return true;
@@ -1,4 +1,4 @@
-#ifdef WIN32
+#if defined(WIN32) && !defined(GP_PLATFORM_HEADLESS)
 
 #include "Base.h"
 #include "Platform.h"
@@ -6,6 +6,8 @@
 #include "Game.h"
 #include "Form.h"
 #include "ScriptController.h"
+#include "InputRecorder.h"
+#include "GLCapture.h"
 #include <GL/wglew.h>
 #include <windowsx.h>
 
@@ -26,6 +28,7 @@ static HWND __attachToWindow = 0;
 static HWND __hwnd = 0;
 static HDC __hdc = 0;
 static HGLRC __hrc = 0;
+static bool __headless = false;
 static bool __mouseCaptured = false;
 static POINT __mouseCapturePoint = { 0, 0 };
 static bool __cursorVisible = true;
@@ -547,6 +550,7 @@ Platform* Platform::create(Game* game, void* attachToWindow)
     __hinstance = ::GetModuleHandle(NULL);
 
     __attachToWindow = (HWND)attachToWindow;
+    __headless = !__attachToWindow && GLCapture::initializeHeadless(game->getConfig());
     if (!__attachToWindow)
     {
         LPCTSTR windowClass = L"gameplay";
@@ -583,6 +587,10 @@ Platform* Platform::create(Game* game, void* attachToWindow)
             }
         }
 
+        // The null renderer makes no GL calls, so no window or context is needed.
+        if (__headless)
+            return platform;
+
         RECT rect = { 0, 0, __width, __height };
 
         // Register our window class.
@@ -687,7 +695,8 @@ int Platform::enterMessagePump()
     __pitch = 0.0;
     __roll = 0.0;
 
-    SwapBuffers(__hdc);
+    if (!__headless)
+        SwapBuffers(__hdc);
 
     if (_game->getState() != Game::RUNNING)
         _game->run();
@@ -695,6 +704,16 @@ int Platform::enterMessagePump()
     if (__attachToWindow)
         return 0;
 
+    // Without a window there are no messages to dispatch, so frames run until the game exits.
+    if (__headless)
+    {
+        while (_game->getState() != Game::UNINITIALIZED)
+        {
+            _game->frame();
+        }
+        return 0;
+    }
+
     // Enter event dispatch loop.
     MSG msg;
     while (true)
@@ -760,7 +779,8 @@ bool Platform::isVsync()
 
 void Platform::setVsync(bool enable)
 {
-     wglSwapIntervalEXT(enable ? 1 : 0);
+    if (!__headless)
+        wglSwapIntervalEXT(enable ? 1 : 0);
     __vsync = enable;
 }
 
@@ -844,6 +864,9 @@ void Platform::displayKeyboard(bool display)
 
 void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
 {
+    if (!InputRecorder::recordTouchEvent(evt, x, y, contactIndex))
+        return;
+
     if (!Form::touchEventInternal(evt, x, y, contactIndex))
     {
         Game::getInstance()->touchEvent(evt, x, y, contactIndex);
@@ -853,6 +876,9 @@ void Platform::touchEventInternal(Touch::TouchEvent evt, int x, int y, unsigned
 
 void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 {
+    if (!InputRecorder::recordKeyEvent(evt, key))
+        return;
+
     if (!Form::keyEventInternal(evt, key))
     {
         Game::getInstance()->keyEvent(evt, key);
@@ -862,6 +888,10 @@ void Platform::keyEventInternal(Keyboard::KeyEvent evt, int key)
 
 bool Platform::mouseEventInternal(Mouse::MouseEvent evt, int x, int y, int wheelDelta)
 {
+    // An ignored event is consumed, so the platform does not deliver it as a touch instead.
+    if (!InputRecorder::recordMouseEvent(evt, x, y, wheelDelta))
+        return true;
+
     if (Form::mouseEventInternal(evt, x, y, wheelDelta))
     {
         return true;
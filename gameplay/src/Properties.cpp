@@ -55,6 +55,7 @@ Properties::Properties(FILE* file, const char* name, const char* id, const char*
 
 Properties* Properties::create(const char* url)
 {
+    GP_MEMORY_TAG(ASSETS);
     if (!url || strlen(url) == 0)
     {
         GP_ERROR("Attempting to create a Properties object from an empty URL!");
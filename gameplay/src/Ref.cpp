@@ -1,6 +1,8 @@
 #include "Base.h"
 #include "Ref.h"
 #include "Game.h"
+#include "Atomic.h"
+#include "SpinLock.h"
 
 namespace gameplay
 {
@@ -32,12 +34,24 @@ Ref::~Ref()
 
 void Ref::addRef()
 {
-    ++_refCount;
+    Atomic::increment(&_refCount);
+}
+
+bool Ref::tryAddRef()
+{
+    int refCount = Atomic::load(&_refCount);
+    while (refCount > 0)
+    {
+        if (Atomic::compareAndSwap(&_refCount, refCount, refCount + 1))
+            return true;
+        refCount = Atomic::load(&_refCount);
+    }
+    return false;
 }
 
 void Ref::release()
 {
-    if ((--_refCount) <= 0)
+    if (Atomic::decrement(&_refCount) <= 0)
     {
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
         untrackRef(this, __record);
@@ -48,7 +62,7 @@ void Ref::release()
 
 unsigned int Ref::getRefCount() const
 {
-    return _refCount;
+    return (unsigned int)Atomic::load(&_refCount);
 }
 
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
@@ -62,9 +76,12 @@ struct RefAllocationRecord
 
 RefAllocationRecord* __refAllocations = 0;
 int __refAllocationCount = 0;
+SpinLock __refAllocationsLock;
 
 void Ref::printLeaks()
 {
+    SpinLock::ScopedLock lock(__refAllocationsLock);
+
     // Dump Ref object memory leaks
     if (__refAllocationCount == 0)
     {
@@ -93,6 +110,7 @@ void* trackRef(Ref* ref)
     rec->next = __refAllocations;
     rec->prev = 0;
 
+    SpinLock::ScopedLock lock(__refAllocationsLock);
     if (__refAllocations)
         __refAllocations->prev = rec;
     __refAllocations = rec;
@@ -117,6 +135,7 @@ void untrackRef(Ref* ref, void* record)
     }
 
     // Link this item out.
+    SpinLock::ScopedLock lock(__refAllocationsLock);
     if (__refAllocations == rec)
         __refAllocations = rec->next;
     if (rec->prev)
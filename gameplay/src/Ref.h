@@ -13,6 +13,9 @@ namespace gameplay
  * reference counting eliminates the need for programmers to manually
  * keep track of object ownership and having to worry about when to
  * safely delete such objects.
+ *
+ * Reference counts are updated atomically, so objects may be shared
+ * between threads and released from any of them.
  */
 class Ref
 {
@@ -62,9 +65,22 @@ protected:
      */
     virtual ~Ref();
 
+    /**
+     * Increments the reference count of this object unless it has
+     * already dropped to zero and the object is being destroyed.
+     *
+     * This is used by caches that hold weak pointers to their objects,
+     * to avoid handing out an object that another thread is releasing.
+     * It must be called while holding the lock that the destructor of
+     * the object takes to remove itself from the cache.
+     *
+     * @return true if a reference was added, false if the object is being destroyed.
+     */
+    bool tryAddRef();
+
 private:
 
-    unsigned int _refCount;
+    volatile int _refCount;
 
     // Memory leak diagnostic data (only included when GAMEPLAY_MEM_LEAK_DETECTION is defined)
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
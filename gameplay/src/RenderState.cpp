@@ -3,6 +3,7 @@
 #include "Node.h"
 #include "Pass.h"
 #include "Technique.h"
+#include "RenderStats.h"
 #include "Node.h"
 
 // Render state override bits
@@ -397,17 +398,20 @@ void RenderState::StateBlock::bindNoRestore()
     GP_ASSERT(_defaultState);
 
     // Update any state that differs from _defaultState and flip _defaultState bits
+    unsigned int changes = 0;
     if ((_bits & RS_BLEND) && (_blendEnabled != _defaultState->_blendEnabled))
     {
         if (_blendEnabled)
             GL_ASSERT( glEnable(GL_BLEND) );
         else
             GL_ASSERT( glDisable(GL_BLEND) );
+        ++changes;
         _defaultState->_blendEnabled = _blendEnabled;
     }
     if ((_bits & RS_BLEND_FUNC) && (_blendSrc != _defaultState->_blendSrc || _blendDst != _defaultState->_blendDst))
     {
         GL_ASSERT( glBlendFunc((GLenum)_blendSrc, (GLenum)_blendDst) );
+        ++changes;
         _defaultState->_blendSrc = _blendSrc;
         _defaultState->_blendDst = _blendDst;
     }
@@ -417,6 +421,7 @@ void RenderState::StateBlock::bindNoRestore()
             GL_ASSERT( glEnable(GL_CULL_FACE) );
         else
             GL_ASSERT( glDisable(GL_CULL_FACE) );
+        ++changes;
         _defaultState->_cullFaceEnabled = _cullFaceEnabled;
     }
     if ((_bits & RS_DEPTH_TEST) && (_depthTestEnabled != _defaultState->_depthTestEnabled))
@@ -425,15 +430,18 @@ void RenderState::StateBlock::bindNoRestore()
             GL_ASSERT( glEnable(GL_DEPTH_TEST) );
         else 
             GL_ASSERT( glDisable(GL_DEPTH_TEST) );
+        ++changes;
         _defaultState->_depthTestEnabled = _depthTestEnabled;
     }
     if ((_bits & RS_DEPTH_WRITE) && (_depthWriteEnabled != _defaultState->_depthWriteEnabled))
     {
         GL_ASSERT( glDepthMask(_depthWriteEnabled ? GL_TRUE : GL_FALSE) );
+        ++changes;
         _defaultState->_depthWriteEnabled = _depthWriteEnabled;
     }
 
     _defaultState->_bits |= _bits;
+    RenderStats::recordStateChanges(changes);
 }
 
 void RenderState::StateBlock::restore(long stateOverrideBits)
@@ -447,15 +455,18 @@ void RenderState::StateBlock::restore(long stateOverrideBits)
     }
 
     // Restore any state that is not overridden and is not default
+    unsigned int changes = 0;
     if (!(stateOverrideBits & RS_BLEND) && (_defaultState->_bits & RS_BLEND))
     {
         GL_ASSERT( glDisable(GL_BLEND) );
+        ++changes;
         _defaultState->_bits &= ~RS_BLEND;
         _defaultState->_blendEnabled = false;
     }
     if (!(stateOverrideBits & RS_BLEND_FUNC) && (_defaultState->_bits & RS_BLEND_FUNC))
     {
         GL_ASSERT( glBlendFunc(GL_ONE, GL_ZERO) );
+        ++changes;
         _defaultState->_bits &= ~RS_BLEND_FUNC;
         _defaultState->_blendSrc = RenderState::BLEND_ONE;
         _defaultState->_blendDst = RenderState::BLEND_ZERO;
@@ -463,21 +474,26 @@ void RenderState::StateBlock::restore(long stateOverrideBits)
     if (!(stateOverrideBits & RS_CULL_FACE) && (_defaultState->_bits & RS_CULL_FACE))
     {
         GL_ASSERT( glDisable(GL_CULL_FACE) );
+        ++changes;
         _defaultState->_bits &= ~RS_CULL_FACE;
         _defaultState->_cullFaceEnabled = false;
     }
     if (!(stateOverrideBits & RS_DEPTH_TEST) && (_defaultState->_bits & RS_DEPTH_TEST))
     {
         GL_ASSERT( glDisable(GL_DEPTH_TEST) );
+        ++changes;
         _defaultState->_bits &= ~RS_DEPTH_TEST;
         _defaultState->_depthTestEnabled = false;
     }
     if (!(stateOverrideBits & RS_DEPTH_WRITE) && (_defaultState->_bits & RS_DEPTH_WRITE))
     {
         GL_ASSERT( glDepthMask(GL_TRUE) );
+        ++changes;
         _defaultState->_bits &= ~RS_DEPTH_WRITE;
         _defaultState->_depthWriteEnabled = true;
     }
+
+    RenderStats::recordStateChanges(changes);
 }
 
 void RenderState::StateBlock::enableDepthWrite()
@@ -0,0 +1,301 @@
+#include "Base.h"
+#include "RenderStats.h"
+#include "Pass.h"
+#include "Technique.h"
+#include "Font.h"
+
+// The number of frames kept in the history of the counters.
+#define RENDER_STATS_HISTORY_SIZE 120
+
+// The number of passes listed by the overlay.
+#define RENDER_STATS_OVERLAY_PASSES 8
+
+namespace gameplay
+{
+
+/**
+ * The counters of a pass.
+ */
+struct PassCounts
+{
+    PassCounts() { memset(counts, 0, sizeof(counts)); }
+
+    std::string name;
+    unsigned int counts[RenderStats::COUNTER_COUNT];
+};
+
+static bool sortPassCounts(const PassCounts& a, const PassCounts& b)
+{
+    return a.counts[RenderStats::DRAW_CALLS] > b.counts[RenderStats::DRAW_CALLS];
+}
+
+static const char* __counterNames[RenderStats::COUNTER_COUNT] =
+{
+    "Draw calls",
+    "Triangles",
+    "State changes",
+    "Uniform uploads",
+    "Texture binds",
+    "Batch vertices"
+};
+
+// The counters of the frame in progress.
+static unsigned int __counts[RenderStats::COUNTER_COUNT];
+static std::map<Pass*, PassCounts> __framePasses;
+static unsigned int* __passCounts = NULL;   // The counters of the pass that is bound, or NULL.
+static bool __passStatsEnabled = false;
+
+// The counters of the last complete frames.
+static unsigned int __history[RENDER_STATS_HISTORY_SIZE][RenderStats::COUNTER_COUNT];
+static unsigned int __historyCount = 0;
+static unsigned int __historyLast = RENDER_STATS_HISTORY_SIZE - 1;  // The index of the last frame in the history.
+static std::vector<PassCounts> __passes;
+
+static Font* __overlayFont = NULL;
+
+static inline void add(RenderStats::Counter counter, unsigned int value)
+{
+    __counts[counter] += value;
+    if (__passCounts)
+        __passCounts[counter] += value;
+}
+
+unsigned int RenderStats::getCount(Counter counter)
+{
+    GP_ASSERT(counter < COUNTER_COUNT);
+    return __historyCount > 0 ? __history[__historyLast][counter] : 0;
+}
+
+unsigned int RenderStats::getDrawCallCount()
+{
+    return getCount(DRAW_CALLS);
+}
+
+unsigned int RenderStats::getTriangleCount()
+{
+    return getCount(TRIANGLES);
+}
+
+unsigned int RenderStats::getHistoryCount()
+{
+    return __historyCount;
+}
+
+unsigned int RenderStats::getHistoryValue(Counter counter, unsigned int frame)
+{
+    GP_ASSERT(counter < COUNTER_COUNT);
+    if (frame >= __historyCount)
+        return 0;
+    unsigned int index = (__historyLast + RENDER_STATS_HISTORY_SIZE - frame) % RENDER_STATS_HISTORY_SIZE;
+    return __history[index][counter];
+}
+
+float RenderStats::getAverage(Counter counter)
+{
+    GP_ASSERT(counter < COUNTER_COUNT);
+    if (__historyCount == 0)
+        return 0.0f;
+
+    double total = 0;
+    for (unsigned int i = 0; i < __historyCount; ++i)
+        total += __history[i][counter];
+    return (float)(total / __historyCount);
+}
+
+unsigned int RenderStats::getPeak(Counter counter)
+{
+    GP_ASSERT(counter < COUNTER_COUNT);
+    unsigned int peak = 0;
+    for (unsigned int i = 0; i < __historyCount; ++i)
+        peak = std::max(peak, __history[i][counter]);
+    return peak;
+}
+
+void RenderStats::setPassStatsEnabled(bool enabled)
+{
+    __passStatsEnabled = enabled;
+    if (!enabled)
+    {
+        __framePasses.clear();
+        __passCounts = NULL;
+        __passes.clear();
+    }
+}
+
+bool RenderStats::isPassStatsEnabled()
+{
+    return __passStatsEnabled;
+}
+
+unsigned int RenderStats::getPassCount()
+{
+    return __passes.size();
+}
+
+const char* RenderStats::getPassName(unsigned int index)
+{
+    GP_ASSERT(index < __passes.size());
+    return __passes[index].name.c_str();
+}
+
+unsigned int RenderStats::getPassValue(unsigned int index, Counter counter)
+{
+    GP_ASSERT(index < __passes.size());
+    GP_ASSERT(counter < COUNTER_COUNT);
+    return __passes[index].counts[counter];
+}
+
+void RenderStats::setOverlay(const char* fontPath)
+{
+    SAFE_RELEASE(__overlayFont);
+    if (fontPath)
+    {
+        __overlayFont = Font::create(fontPath);
+        if (__overlayFont == NULL)
+            GP_WARN("Failed to load font '%s' for the render stats overlay.", fontPath);
+    }
+}
+
+bool RenderStats::isOverlayVisible()
+{
+    return __overlayFont != NULL;
+}
+
+void RenderStats::recordDrawCall(GLenum primitiveType, unsigned int vertexCount)
+{
+    add(DRAW_CALLS, 1);
+    switch (primitiveType)
+    {
+    case GL_TRIANGLES:
+        add(TRIANGLES, vertexCount / 3);
+        break;
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+        if (vertexCount > 2)
+            add(TRIANGLES, vertexCount - 2);
+        break;
+    default:
+        break;
+    }
+}
+
+void RenderStats::recordPass(Pass* pass)
+{
+    if (!__passStatsEnabled)
+        return;
+
+    if (pass == NULL)
+    {
+        __passCounts = NULL;
+        return;
+    }
+
+    std::map<Pass*, PassCounts>::iterator itr = __framePasses.find(pass);
+    if (itr == __framePasses.end())
+    {
+        itr = __framePasses.insert(std::make_pair(pass, PassCounts())).first;
+        itr->second.name = pass->_technique ? pass->_technique->getId() : "";
+        itr->second.name += "/";
+        itr->second.name += pass->getId();
+    }
+    __passCounts = itr->second.counts;
+}
+
+void RenderStats::recordStateChanges(unsigned int count)
+{
+    add(STATE_CHANGES, count);
+}
+
+void RenderStats::recordUniformUpload()
+{
+    add(UNIFORM_UPLOADS, 1);
+}
+
+void RenderStats::recordTextureBind()
+{
+    add(TEXTURE_BINDS, 1);
+}
+
+void RenderStats::recordBatchVertices(unsigned int vertexCount)
+{
+    add(BATCH_VERTICES, vertexCount);
+}
+
+void RenderStats::endFrame()
+{
+    // Publish the counters of the frame.
+    __historyLast = (__historyLast + 1) % RENDER_STATS_HISTORY_SIZE;
+    memcpy(__history[__historyLast], __counts, sizeof(__counts));
+    if (__historyCount < RENDER_STATS_HISTORY_SIZE)
+        ++__historyCount;
+
+    // Combine the passes with the same name, such as those of cloned materials.
+    __passes.clear();
+    if (__passStatsEnabled)
+    {
+        std::map<std::string, unsigned int> indices;
+        for (std::map<Pass*, PassCounts>::const_iterator itr = __framePasses.begin(); itr != __framePasses.end(); ++itr)
+        {
+            std::map<std::string, unsigned int>::iterator index = indices.find(itr->second.name);
+            if (index == indices.end())
+            {
+                indices[itr->second.name] = __passes.size();
+                __passes.push_back(itr->second);
+            }
+            else
+            {
+                PassCounts& passCounts = __passes[index->second];
+                for (unsigned int i = 0; i < COUNTER_COUNT; ++i)
+                    passCounts.counts[i] += itr->second.counts[i];
+            }
+        }
+        std::stable_sort(__passes.begin(), __passes.end(), sortPassCounts);
+    }
+
+    // The overlay is drawn between frames, so its own work is discarded with the counters.
+    if (__overlayFont)
+        drawOverlay();
+
+    memset(__counts, 0, sizeof(__counts));
+    __framePasses.clear();
+    __passCounts = NULL;
+}
+
+void RenderStats::finalize()
+{
+    SAFE_RELEASE(__overlayFont);
+    setPassStatsEnabled(false);
+    __historyCount = 0;
+    __historyLast = RENDER_STATS_HISTORY_SIZE - 1;
+}
+
+void RenderStats::drawOverlay()
+{
+    GP_ASSERT(__overlayFont);
+
+    static const Vector4 color(1.0f, 1.0f, 0.0f, 1.0f);
+    int lineHeight = (int)__overlayFont->getSize();
+    int y = 5;
+    char text[256];
+
+    __overlayFont->start();
+    for (unsigned int i = 0; i < COUNTER_COUNT; ++i)
+    {
+        Counter counter = (Counter)i;
+        sprintf(text, "%s: %u (avg %.0f, peak %u)", __counterNames[i], getCount(counter), getAverage(counter), getPeak(counter));
+        __overlayFont->drawText(text, 5, y, color);
+        y += lineHeight;
+    }
+    unsigned int passCount = std::min((unsigned int)__passes.size(), (unsigned int)RENDER_STATS_OVERLAY_PASSES);
+    for (unsigned int i = 0; i < passCount; ++i)
+    {
+        const PassCounts& pass = __passes[i];
+        sprintf(text, "%.96s: %u draws, %u tris, %u uniforms", pass.name.c_str(),
+            pass.counts[DRAW_CALLS], pass.counts[TRIANGLES], pass.counts[UNIFORM_UPLOADS]);
+        __overlayFont->drawText(text, 5, y, color);
+        y += lineHeight;
+    }
+    __overlayFont->finish();
+}
+
+}
@@ -0,0 +1,263 @@
+#ifndef RENDERSTATS_H_
+#define RENDERSTATS_H_
+
+namespace gameplay
+{
+
+class Pass;
+
+/**
+ * Defines per-frame counters of the rendering work submitted by the game.
+ *
+ * Models and mesh batches count each draw call they issue, the triangles it draws
+ * and the vertices of mesh batches. Render states count the GL state they change,
+ * including the shader programs they bind, and effects count the uniforms they
+ * upload and the textures they bind. The counters accumulate over a frame and are
+ * published when the frame ends, so the getters return the totals of the last
+ * complete frame. The totals of the last frames are kept as a history, from which
+ * the average and peak of each counter are computed.
+ *
+ * The counters can also be split by the pass of the material that was bound when
+ * the work was submitted, which costs a lookup each time a pass is bound and so is
+ * disabled by default. Passes are named by their technique and pass ids, and passes
+ * with the same ids are combined, such as those of materials cloned from one material.
+ *
+ * The counters of the last frame can be drawn over the game, and both options can
+ * be set with the renderStats section of game.config:
+ * @code
+ * renderStats
+ * {
+ *     overlay = res/ui/arial.gpb
+ *     passStats = true
+ * }
+ * @endcode
+ */
+class RenderStats
+{
+    friend class Game;
+
+public:
+
+    /**
+     * The counters of the rendering work of a frame.
+     */
+    enum Counter
+    {
+        DRAW_CALLS,
+        TRIANGLES,
+        STATE_CHANGES,
+        UNIFORM_UPLOADS,
+        TEXTURE_BINDS,
+        BATCH_VERTICES,
+        COUNTER_COUNT
+    };
+
+    /**
+     * Gets the value of a counter in the last frame.
+     *
+     * @param counter The counter.
+     *
+     * @return The value of the counter.
+     */
+    static unsigned int getCount(Counter counter);
+
+    /**
+     * Gets the number of draw calls issued in the last frame.
+     *
+     * @return The number of draw calls.
+     */
+    static unsigned int getDrawCallCount();
+
+    /**
+     * Gets the number of triangles drawn in the last frame.
+     *
+     * Line and point primitives are not counted.
+     *
+     * @return The number of triangles.
+     */
+    static unsigned int getTriangleCount();
+
+    /**
+     * Gets the number of frames kept in the history of the counters.
+     *
+     * @return The number of frames, up to the size of the history.
+     */
+    static unsigned int getHistoryCount();
+
+    /**
+     * Gets the value of a counter in a frame of the history.
+     *
+     * @param counter The counter.
+     * @param frame The number of frames before the last frame, where zero is the last frame.
+     *
+     * @return The value of the counter, or zero if the frame is not in the history.
+     */
+    static unsigned int getHistoryValue(Counter counter, unsigned int frame);
+
+    /**
+     * Gets the average value of a counter over the frames of the history.
+     *
+     * @param counter The counter.
+     *
+     * @return The average value of the counter.
+     */
+    static float getAverage(Counter counter);
+
+    /**
+     * Gets the highest value of a counter over the frames of the history.
+     *
+     * @param counter The counter.
+     *
+     * @return The highest value of the counter.
+     */
+    static unsigned int getPeak(Counter counter);
+
+    /**
+     * Enables or disables splitting the counters by pass.
+     *
+     * @param enabled true to count the work of each pass.
+     */
+    static void setPassStatsEnabled(bool enabled);
+
+    /**
+     * Determines whether the counters are split by pass.
+     *
+     * @return true if the work of each pass is counted.
+     */
+    static bool isPassStatsEnabled();
+
+    /**
+     * Gets the number of passes that submitted work in the last frame.
+     *
+     * The passes are sorted by their number of draw calls, highest first.
+     *
+     * @return The number of passes.
+     */
+    static unsigned int getPassCount();
+
+    /**
+     * Gets the name of a pass that submitted work in the last frame.
+     *
+     * @param index The index of the pass.
+     *
+     * @return The technique and pass ids of the pass, separated by a slash.
+     */
+    static const char* getPassName(unsigned int index);
+
+    /**
+     * Gets the value of a counter for a pass in the last frame.
+     *
+     * State changes are counted for the pass when it is bound.
+     *
+     * @param index The index of the pass.
+     * @param counter The counter.
+     *
+     * @return The value of the counter.
+     */
+    static unsigned int getPassValue(unsigned int index, Counter counter);
+
+    /**
+     * Shows or hides an overlay of the counters of the last frame, drawn at the end of every frame.
+     *
+     * The work of drawing the overlay is not counted.
+     *
+     * @param fontPath The path of the font to draw the overlay with, or NULL to hide the overlay.
+     */
+    static void setOverlay(const char* fontPath);
+
+    /**
+     * Determines whether the overlay is shown.
+     *
+     * @return true if the overlay is shown.
+     */
+    static bool isOverlayVisible();
+
+    /**
+     * Records a draw call.
+     *
+     * This is called by the renderers and should not be called directly.
+     *
+     * @param primitiveType The type of primitive drawn, such as GL_TRIANGLES.
+     * @param vertexCount The number of vertices or indices drawn.
+     * @script{ignore}
+     */
+    static void recordDrawCall(GLenum primitiveType, unsigned int vertexCount);
+
+    /**
+     * Records the binding of a pass, to which the work that follows is counted.
+     *
+     * This is called by passes and should not be called directly.
+     *
+     * @param pass The pass.
+     * @script{ignore}
+     */
+    static void recordPass(Pass* pass);
+
+    /**
+     * Records changes of GL state.
+     *
+     * This is called by the renderers and should not be called directly.
+     *
+     * @param count The number of state changes.
+     * @script{ignore}
+     */
+    static void recordStateChanges(unsigned int count);
+
+    /**
+     * Records the upload of a uniform.
+     *
+     * This is called by effects and should not be called directly.
+     *
+     * @script{ignore}
+     */
+    static void recordUniformUpload();
+
+    /**
+     * Records the binding of a texture.
+     *
+     * This is called by texture samplers and should not be called directly.
+     *
+     * @script{ignore}
+     */
+    static void recordTextureBind();
+
+    /**
+     * Records the vertices of a mesh batch that are drawn.
+     *
+     * This is called by mesh batches and should not be called directly.
+     *
+     * @param vertexCount The number of vertices.
+     * @script{ignore}
+     */
+    static void recordBatchVertices(unsigned int vertexCount);
+
+private:
+
+    /**
+     * Constructor.
+     */
+    RenderStats();
+
+    /**
+     * Publishes the counters of the frame, draws the overlay and resets the counters for the next one.
+     *
+     * Called by the Game at the end of every frame.
+     */
+    static void endFrame();
+
+    /**
+     * Releases the font of the overlay.
+     *
+     * Called by the Game when it shuts down.
+     */
+    static void finalize();
+
+    /**
+     * Draws the overlay with the counters of the last frame.
+     */
+    static void drawOverlay();
+};
+
+}
+
+#endif
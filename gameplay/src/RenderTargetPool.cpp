@@ -0,0 +1,235 @@
+#include "Base.h"
+#include "RenderTargetPool.h"
+
+namespace gameplay
+{
+
+/**
+ * A FrameBuffer owned by the pool.
+ */
+struct PooledFrameBuffer
+{
+    FrameBuffer* frameBuffer;
+    unsigned int width;
+    unsigned int height;
+    RenderTargetPool::Format format;
+    bool leased;
+    bool transient;
+    const void* owner;          // The last owner the FrameBuffer was leased to.
+    unsigned int lastFrame;     // The frame the FrameBuffer was last leased in.
+};
+
+static std::vector<PooledFrameBuffer*> __pooledFrameBuffers;
+static unsigned int __frame = 0;
+static unsigned int __maxIdleFrames = 60;
+static unsigned int __nextId = 0;
+
+static PooledFrameBuffer* createPooledFrameBuffer(unsigned int width, unsigned int height, RenderTargetPool::Format format)
+{
+    char id[64];
+    sprintf(id, "__renderTargetPool_%ux%u_%u", width, height, __nextId++);
+
+    FrameBuffer* frameBuffer = FrameBuffer::create(id, width, height);
+    if (frameBuffer == NULL)
+    {
+        GP_ERROR("Failed to create pooled frame buffer of size %ux%u.", width, height);
+        return NULL;
+    }
+
+    if (format != RenderTargetPool::COLOR)
+    {
+        DepthStencilTarget* depthStencilTarget = DepthStencilTarget::create(id,
+            format == RenderTargetPool::COLOR_DEPTH_STENCIL ? DepthStencilTarget::DEPTH_STENCIL : DepthStencilTarget::DEPTH,
+            width, height);
+        GP_ASSERT(depthStencilTarget);
+        frameBuffer->setDepthStencilTarget(depthStencilTarget);
+        SAFE_RELEASE(depthStencilTarget);
+    }
+
+    PooledFrameBuffer* pooled = new PooledFrameBuffer();
+    pooled->frameBuffer = frameBuffer;
+    pooled->width = width;
+    pooled->height = height;
+    pooled->format = format;
+    pooled->leased = false;
+    pooled->transient = false;
+    pooled->owner = NULL;
+    pooled->lastFrame = __frame;
+    __pooledFrameBuffers.push_back(pooled);
+
+    return pooled;
+}
+
+FrameBuffer* RenderTargetPool::acquire(unsigned int width, unsigned int height, Format format)
+{
+    return lease(width, height, format, false, NULL, NULL);
+}
+
+FrameBuffer* RenderTargetPool::acquireTransient(unsigned int width, unsigned int height, Format format, const void* owner, bool* retained)
+{
+    return lease(width, height, format, true, owner, retained);
+}
+
+FrameBuffer* RenderTargetPool::lease(unsigned int width, unsigned int height, Format format, bool transient, const void* owner, bool* retained)
+{
+    PooledFrameBuffer* match = NULL;
+    bool matchRetained = false;
+
+    // Prefer the FrameBuffer this owner leased last time, since its contents are still intact.
+    // Otherwise take the least recently used FrameBuffer that has no owner, or whose owner
+    // has not used it since before the previous frame. FrameBuffers leased by another owner
+    // in the previous frame are left alone, since that owner will most likely ask for it again.
+    std::vector<PooledFrameBuffer*>::iterator it;
+    for (it = __pooledFrameBuffers.begin(); it != __pooledFrameBuffers.end(); ++it)
+    {
+        PooledFrameBuffer* pooled = *it;
+        GP_ASSERT(pooled);
+        if (pooled->leased || pooled->width != width || pooled->height != height || pooled->format != format)
+            continue;
+
+        if (owner && pooled->owner == owner)
+        {
+            match = pooled;
+            matchRetained = true;
+            break;
+        }
+
+        if (pooled->owner && pooled->owner != owner && pooled->lastFrame + 1 >= __frame)
+            continue;
+
+        if (match == NULL || (match->owner && !pooled->owner) ||
+            ((match->owner != NULL) == (pooled->owner != NULL) && pooled->lastFrame < match->lastFrame))
+        {
+            match = pooled;
+        }
+    }
+
+    if (match == NULL)
+    {
+        match = createPooledFrameBuffer(width, height, format);
+        if (match == NULL)
+            return NULL;
+    }
+
+    match->leased = true;
+    match->transient = transient;
+    match->owner = owner;
+    match->lastFrame = __frame;
+
+    if (retained)
+        *retained = matchRetained;
+
+    return match->frameBuffer;
+}
+
+void RenderTargetPool::release(FrameBuffer* frameBuffer)
+{
+    std::vector<PooledFrameBuffer*>::iterator it;
+    for (it = __pooledFrameBuffers.begin(); it != __pooledFrameBuffers.end(); ++it)
+    {
+        PooledFrameBuffer* pooled = *it;
+        GP_ASSERT(pooled);
+        if (pooled->frameBuffer == frameBuffer)
+        {
+            GP_ASSERT(pooled->leased && !pooled->transient);
+            pooled->leased = false;
+            pooled->lastFrame = __frame;
+            return;
+        }
+    }
+    GP_WARN("Frame buffer '%s' was not leased from the render target pool.", frameBuffer ? frameBuffer->getId() : "");
+}
+
+void RenderTargetPool::releaseOwner(const void* owner)
+{
+    std::vector<PooledFrameBuffer*>::iterator it;
+    for (it = __pooledFrameBuffers.begin(); it != __pooledFrameBuffers.end(); ++it)
+    {
+        PooledFrameBuffer* pooled = *it;
+        GP_ASSERT(pooled);
+        if (pooled->owner == owner)
+        {
+            pooled->owner = NULL;
+        }
+    }
+}
+
+void RenderTargetPool::setMaxIdleFrames(unsigned int frames)
+{
+    __maxIdleFrames = frames;
+}
+
+unsigned int RenderTargetPool::getMaxIdleFrames()
+{
+    return __maxIdleFrames;
+}
+
+unsigned int RenderTargetPool::getFrameBufferCount()
+{
+    return __pooledFrameBuffers.size();
+}
+
+unsigned int RenderTargetPool::getMemoryUsage()
+{
+    unsigned int bytes = 0;
+    std::vector<PooledFrameBuffer*>::const_iterator it;
+    for (it = __pooledFrameBuffers.begin(); it != __pooledFrameBuffers.end(); ++it)
+    {
+        const PooledFrameBuffer* pooled = *it;
+        GP_ASSERT(pooled);
+
+        // 32-bit RGBA color, plus a packed 24-bit depth / 8-bit stencil render buffer.
+        unsigned int pixels = pooled->width * pooled->height;
+        bytes += pixels * 4;
+        if (pooled->format != COLOR)
+            bytes += pixels * 4;
+    }
+    return bytes;
+}
+
+void RenderTargetPool::endFrame()
+{
+    std::vector<PooledFrameBuffer*>::iterator it = __pooledFrameBuffers.begin();
+    while (it != __pooledFrameBuffers.end())
+    {
+        PooledFrameBuffer* pooled = *it;
+        GP_ASSERT(pooled);
+
+        if (pooled->leased && pooled->transient)
+        {
+            pooled->leased = false;
+        }
+
+        if (!pooled->leased && __frame - pooled->lastFrame > __maxIdleFrames)
+        {
+            SAFE_RELEASE(pooled->frameBuffer);
+            SAFE_DELETE(pooled);
+            it = __pooledFrameBuffers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    ++__frame;
+}
+
+void RenderTargetPool::finalize()
+{
+    std::vector<PooledFrameBuffer*>::iterator it;
+    for (it = __pooledFrameBuffers.begin(); it != __pooledFrameBuffers.end(); ++it)
+    {
+        PooledFrameBuffer* pooled = *it;
+        GP_ASSERT(pooled);
+        if (pooled->leased && !pooled->transient)
+        {
+            GP_WARN("Frame buffer '%s' is still leased from the render target pool.", pooled->frameBuffer->getId());
+        }
+        SAFE_RELEASE(pooled->frameBuffer);
+        SAFE_DELETE(pooled);
+    }
+    __pooledFrameBuffers.clear();
+    __frame = 0;
+}
+
+}
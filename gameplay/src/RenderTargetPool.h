@@ -0,0 +1,167 @@
+#ifndef RENDERTARGETPOOL_H_
+#define RENDERTARGETPOOL_H_
+
+#include "FrameBuffer.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a pool of off-screen FrameBuffers keyed by size and format.
+ *
+ * Rather than each Form or off-screen effect creating its own FrameBuffer,
+ * RenderTarget and DepthStencilTarget, users lease a FrameBuffer from the pool.
+ * Transient leases are only valid until the end of the current frame, after which
+ * the FrameBuffer returns to the pool and may be handed to another user. This lets
+ * users that are not drawn in the same frame alias the same GPU memory, and lets
+ * resizes reuse existing allocations instead of creating new ones.
+ *
+ * Users that cache rendered contents across frames (such as Forms) pass themselves
+ * as the lease owner. When the pool hands an owner back the same FrameBuffer it
+ * leased last time, and nobody else has used it since, the contents are reported
+ * as retained and do not need to be redrawn.
+ *
+ * FrameBuffers that have not been leased for a number of frames are released by the pool.
+ * A user that keeps a pointer to a leased FrameBuffer across frames, as a Form does to tell
+ * when it is handed a different one, must hold a reference to it, since the FrameBuffer may
+ * otherwise be destroyed and another one created at the same address.
+ *
+ * @script{ignore}
+ */
+class RenderTargetPool
+{
+    friend class Game;
+
+public:
+
+    /**
+     * Defines the attachment formats of pooled FrameBuffers.
+     */
+    enum Format
+    {
+        /**
+         * A 32-bit color target only.
+         */
+        COLOR,
+
+        /**
+         * A 32-bit color target with a depth target.
+         */
+        COLOR_DEPTH,
+
+        /**
+         * A 32-bit color target with a combined depth and stencil target.
+         */
+        COLOR_DEPTH_STENCIL
+    };
+
+    /**
+     * Leases a FrameBuffer from the pool until it is explicitly released.
+     *
+     * @param width The width of the FrameBuffer. Must be a power of two.
+     * @param height The height of the FrameBuffer. Must be a power of two.
+     * @param format The attachment format of the FrameBuffer.
+     *
+     * @return The leased FrameBuffer, or NULL if one could not be created.
+     * @see RenderTargetPool::release
+     */
+    static FrameBuffer* acquire(unsigned int width, unsigned int height, Format format = COLOR);
+
+    /**
+     * Leases a FrameBuffer from the pool until the end of the current frame.
+     *
+     * The returned FrameBuffer must not be used after the current frame ends.
+     *
+     * @param width The width of the FrameBuffer. Must be a power of two.
+     * @param height The height of the FrameBuffer. Must be a power of two.
+     * @param format The attachment format of the FrameBuffer.
+     * @param owner An optional identifier for the user of the FrameBuffer, used to hand
+     *      the same FrameBuffer back to the same user on subsequent frames.
+     * @param retained Set to true if the returned FrameBuffer still holds the contents the
+     *      owner last rendered into it, or false if its contents are undefined. May be NULL.
+     *
+     * @return The leased FrameBuffer, or NULL if one could not be created.
+     */
+    static FrameBuffer* acquireTransient(unsigned int width, unsigned int height, Format format = COLOR,
+                                         const void* owner = NULL, bool* retained = NULL);
+
+    /**
+     * Returns a FrameBuffer leased with RenderTargetPool::acquire to the pool.
+     *
+     * @param frameBuffer The FrameBuffer to return.
+     */
+    static void release(FrameBuffer* frameBuffer);
+
+    /**
+     * Forgets an owner passed to RenderTargetPool::acquireTransient.
+     *
+     * Must be called when the owner is destroyed, so that the contents of its
+     * FrameBuffers are never reported as retained to a new owner at the same address.
+     *
+     * @param owner The owner to forget.
+     */
+    static void releaseOwner(const void* owner);
+
+    /**
+     * Sets the number of frames an unleased FrameBuffer is kept in the pool before it is destroyed.
+     *
+     * @param frames The number of frames. The default is 60.
+     */
+    static void setMaxIdleFrames(unsigned int frames);
+
+    /**
+     * Gets the number of frames an unleased FrameBuffer is kept in the pool before it is destroyed.
+     *
+     * @return The number of frames.
+     */
+    static unsigned int getMaxIdleFrames();
+
+    /**
+     * Gets the number of FrameBuffers currently allocated by the pool (leased or not).
+     *
+     * @return The number of allocated FrameBuffers.
+     */
+    static unsigned int getFrameBufferCount();
+
+    /**
+     * Gets the approximate amount of GPU memory currently allocated by the pool.
+     *
+     * @return The number of bytes allocated for color, depth and stencil targets.
+     */
+    static unsigned int getMemoryUsage();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    RenderTargetPool();
+
+    /**
+     * Hidden copy constructor.
+     */
+    RenderTargetPool(const RenderTargetPool& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    RenderTargetPool& operator=(const RenderTargetPool&);
+
+    /**
+     * Returns transient leases to the pool and destroys idle FrameBuffers.
+     *
+     * Called by the Game at the end of every frame.
+     */
+    static void endFrame();
+
+    /**
+     * Destroys all pooled FrameBuffers.
+     */
+    static void finalize();
+
+    static FrameBuffer* lease(unsigned int width, unsigned int height, Format format, bool transient, const void* owner, bool* retained);
+};
+
+}
+
+#endif
@@ -4,16 +4,39 @@
 #include "SceneLoader.h"
 #include "MeshSkin.h"
 #include "Joint.h"
+#include "SpinLock.h"
 
 namespace gameplay
 {
 
+// The scenes that are snapshot while the game is pipelined.
+static std::vector<Scene*> __sceneList;
+static SpinLock __sceneListLock;
+
+// Set on the game thread while it renders the snapshot.
+static THREAD_LOCAL bool __renderingSnapshot = false;
+
 Scene::Scene() : _activeCamera(NULL), _firstNode(NULL), _lastNode(NULL), _nodeCount(0), _bindAudioListenerToCamera(true), _debugBatch(NULL)
 {
+    SpinLock::ScopedLock lock(__sceneListLock);
+    __sceneList.push_back(this);
 }
 
 Scene::~Scene()
 {
+    {
+        SpinLock::ScopedLock lock(__sceneListLock);
+        std::vector<Scene*>::iterator itr = std::find(__sceneList.begin(), __sceneList.end(), this);
+        if (itr != __sceneList.end())
+        {
+            __sceneList.erase(itr);
+        }
+    }
+    for (unsigned int i = 0, count = _visibleNodes.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_visibleNodes[i]);
+    }
+
     // Unbind our active camera from the audio listener
     if (_activeCamera)
     {
@@ -213,6 +236,105 @@ unsigned int Scene::getNodeCount() const
     return _nodeCount;
 }
 
+unsigned int Scene::getVisibleNodeCount() const
+{
+    return _visibleNodes.size();
+}
+
+Node* Scene::getVisibleNode(unsigned int index) const
+{
+    GP_ASSERT(index < _visibleNodes.size());
+    return _visibleNodes[index];
+}
+
+void Scene::snapshotScenes()
+{
+    SpinLock::ScopedLock lock(__sceneListLock);
+    for (unsigned int i = 0, count = __sceneList.size(); i < count; ++i)
+    {
+        __sceneList[i]->snapshot();
+    }
+}
+
+void Scene::releaseSnapshots()
+{
+    SpinLock::ScopedLock lock(__sceneListLock);
+    for (unsigned int i = 0, count = __sceneList.size(); i < count; ++i)
+    {
+        std::vector<Node*>& visibleNodes = __sceneList[i]->_visibleNodes;
+        for (unsigned int j = 0, nodeCount = visibleNodes.size(); j < nodeCount; ++j)
+        {
+            SAFE_RELEASE(visibleNodes[j]);
+        }
+        visibleNodes.clear();
+    }
+}
+
+void Scene::snapshot()
+{
+    // The visible nodes are referenced until the next snapshot, so that the simulation
+    // can remove them from the scene while they are rendered.
+    for (unsigned int i = 0, count = _visibleNodes.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_visibleNodes[i]);
+    }
+    _visibleNodes.clear();
+
+    const Frustum* frustum = NULL;
+    if (_activeCamera)
+    {
+        _activeCamera->snapshot();
+        frustum = &_activeCamera->getFrustum();
+    }
+    for (Node* node = _firstNode; node != NULL; node = node->getNextSibling())
+    {
+        snapshotNode(node, frustum);
+    }
+}
+
+void Scene::snapshotNode(Node* node, const Frustum* frustum)
+{
+    GP_ASSERT(node);
+
+    node->_snapshotWorld = node->getWorldMatrix();
+    node->_snapshotBounds = node->getBoundingSphere();
+    node->_hasSnapshot = true;
+    if (node->getCamera())
+    {
+        node->getCamera()->snapshot();
+    }
+    if (node->getModel() && node->getModel()->getSkin())
+    {
+        node->getModel()->getSkin()->snapshot();
+    }
+
+    bool visible = node->getForm() || node->getParticleEmitter();
+    if (node->getModel())
+    {
+        visible = visible || !frustum || node->_snapshotBounds.intersects(*frustum);
+    }
+    if (visible)
+    {
+        node->addRef();
+        _visibleNodes.push_back(node);
+    }
+
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        snapshotNode(child, frustum);
+    }
+}
+
+bool Scene::isRenderingSnapshot()
+{
+    return __renderingSnapshot;
+}
+
+void Scene::setRenderingSnapshot(bool rendering)
+{
+    __renderingSnapshot = rendering;
+}
+
 Node* Scene::getFirstNode() const
 {
     return _firstNode;
@@ -13,6 +13,11 @@ namespace gameplay
  */
 class Scene : public Ref
 {
+    friend class Game;
+    friend class Node;
+    friend class Camera;
+    friend class MeshSkin;
+
 public:
 
     /**
@@ -122,6 +127,31 @@ public:
      */
     Node* getFirstNode() const;
 
+    /**
+     * Gets the number of nodes that were visible when the scene was last snapshot.
+     *
+     * While the game is pipelined (see Game::setPipelined), the scenes are snapshot before
+     * the simulation of each frame starts. The snapshot holds the world matrices and bounds
+     * of the nodes, the matrices of the cameras, and the visible nodes: the nodes with models
+     * that intersect the view frustum of the active camera, and the nodes with forms or
+     * particle emitters. While render() runs, the node and camera matrices and bounds are read
+     * from the snapshot, and render() should draw the visible nodes instead of visiting the
+     * scene, since the simulation may add and remove nodes meanwhile.
+     *
+     * @return The number of visible nodes, or 0 if the game is not pipelined.
+     */
+    unsigned int getVisibleNodeCount() const;
+
+    /**
+     * Gets a node that was visible when the scene was last snapshot.
+     *
+     * @param index The index of the node, less than getVisibleNodeCount.
+     *
+     * @return The visible node.
+     * @see Scene::getVisibleNodeCount
+     */
+    Node* getVisibleNode(unsigned int index) const;
+
     /**
      * Gets the active camera for the scene.
      *
@@ -254,6 +284,40 @@ private:
      */
     inline bool visitNode(Node* node, const char* visitMethod);
 
+    /**
+     * Snapshots all of the scenes. Called by the game before the simulation of a frame starts.
+     */
+    static void snapshotScenes();
+
+    /**
+     * Releases the visible nodes of all of the scenes when the game is no longer pipelined.
+     */
+    static void releaseSnapshots();
+
+    /**
+     * Copies the world matrices, bounds and camera matrices of the nodes and finds the visible nodes.
+     */
+    void snapshot();
+
+    /**
+     * Snapshots the node and its children.
+     *
+     * @param node The node to snapshot.
+     * @param frustum The view frustum of the active camera, or NULL to make all nodes visible.
+     */
+    void snapshotNode(Node* node, const Frustum* frustum);
+
+    /**
+     * Determines if the calling thread is rendering the snapshot, when the node and camera
+     * matrices and bounds are read from the snapshot.
+     */
+    static bool isRenderingSnapshot();
+
+    /**
+     * Sets whether the calling thread is rendering the snapshot.
+     */
+    static void setRenderingSnapshot(bool rendering);
+
     std::string _id;
     Camera* _activeCamera;
     Node* _firstNode;
@@ -262,6 +326,7 @@ private:
     Vector3 _ambientColor;
     bool _bindAudioListenerToCamera;
     MeshBatch* _debugBatch;
+    std::vector<Node*> _visibleNodes;
 };
 
 template <class T>
@@ -3,6 +3,8 @@
 #include "Game.h"
 #include "Bundle.h"
 #include "SceneLoader.h"
+#include "MemoryStats.h"
+#include "LoadTrace.h"
 
 namespace gameplay
 {
@@ -20,13 +22,20 @@ std::string SceneLoader::_path;
 
 Scene* SceneLoader::load(const char* url)
 {
+    GP_MEMORY_TAG(ASSETS);
     // Get the file part of the url that we are loading the scene from.
     std::string urlStr = url ? url : "";
     std::string id;
     splitURL(urlStr, &_path, &id);
+    MemoryStats::Source memorySource(MemoryStats::SCENE, _path.c_str());
+    LoadTrace::Asset trace("scene", _path.c_str());
 
     // Load the scene properties from file.
-    Properties* properties = Properties::create(url);
+    Properties* properties;
+    {
+        LoadTrace::PhaseScope phase(LoadTrace::PARSE);
+        properties = Properties::create(url);
+    }
     if (properties == NULL)
     {
         GP_ERROR("Failed to load scene file '%s'.", url);
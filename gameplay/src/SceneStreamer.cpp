@@ -0,0 +1,475 @@
+#include "Base.h"
+#include "SceneStreamer.h"
+#include "Game.h"
+#include "FileSystem.h"
+#include "MemoryStats.h"
+
+namespace gameplay
+{
+
+/**
+ * Sets the material on the models of the node and its descendants that have no material.
+ */
+static void setDefaultMaterial(Node* node, const char* materialPath)
+{
+    Model* model = node->getModel();
+    if (model && model->getMaterial() == NULL)
+    {
+        model->setMaterial(materialPath);
+    }
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        setDefaultMaterial(child, materialPath);
+    }
+}
+
+/**
+ * Reads a file to the end so that it is in the file cache when it is loaded.
+ */
+static void prefetchFile(const char* path)
+{
+    FILE* fp = FileSystem::openFile(path, "rb");
+    if (fp)
+    {
+        char buffer[4096];
+        while (fread(buffer, 1, sizeof(buffer), fp) == sizeof(buffer))
+        {
+        }
+        fclose(fp);
+    }
+}
+
+SceneStreamer::SceneStreamer(Scene* scene)
+    : _scene(scene), _cellSize(0), _loadDistance(0), _unloadDistance(0), _memoryBudget(0), _exit(false)
+{
+    GP_ASSERT(_scene);
+    _scene->addRef();
+}
+
+SceneStreamer::~SceneStreamer()
+{
+    if (_thread.isRunning())
+    {
+        {
+            Mutex::ScopedLock lock(_mutex);
+            _exit = true;
+        }
+        _requests.post();
+        _thread.join();
+    }
+
+    for (unsigned int i = 0, count = _cells.size(); i < count; ++i)
+    {
+        unloadCell(_cells[i]);
+        SAFE_DELETE(_cells[i]);
+    }
+    SAFE_RELEASE(_scene);
+}
+
+SceneStreamer* SceneStreamer::create(const char* path, Scene* scene)
+{
+    GP_ASSERT(path);
+    GP_ASSERT(scene);
+
+    Properties* properties = Properties::create(path);
+    if (properties == NULL)
+    {
+        GP_ERROR("Failed to load cell index '%s'.", path);
+        return NULL;
+    }
+    Properties* cells = (strlen(properties->getNamespace()) > 0) ? properties : properties->getNextNamespace();
+    if (!cells || strcmp(cells->getNamespace(), "cells") != 0)
+    {
+        GP_ERROR("Cell index '%s' must have a 'cells' namespace.", path);
+        SAFE_DELETE(properties);
+        return NULL;
+    }
+
+    // The paths of the cell bundles are relative to the index.
+    std::string directory(path);
+    size_t slash = directory.find_last_of("/\\");
+    directory = (slash == std::string::npos) ? std::string() : directory.substr(0, slash + 1);
+
+    SceneStreamer* streamer = new SceneStreamer(scene);
+    streamer->_cellSize = cells->getFloat("cellSize");
+    streamer->_loadDistance = cells->exists("loadDistance") ? cells->getFloat("loadDistance") : streamer->_cellSize;
+    streamer->_unloadDistance = cells->exists("unloadDistance") ? cells->getFloat("unloadDistance") : streamer->_cellSize * 1.5f;
+    const char* defaultMaterial = cells->getString("material");
+
+    for (Properties* cellProperties = cells->getNextNamespace(); cellProperties != NULL; cellProperties = cells->getNextNamespace())
+    {
+        if (strcmp(cellProperties->getNamespace(), "cell") != 0)
+        {
+            continue;
+        }
+        const char* bundle = cellProperties->getString("bundle");
+        if (bundle == NULL || strlen(bundle) == 0)
+        {
+            GP_WARN("Cell '%s' of index '%s' has no bundle.", cellProperties->getId(), path);
+            continue;
+        }
+
+        Cell* cell = new Cell();
+        cell->id = cellProperties->getId();
+        cell->path = directory + bundle;
+        const char* scenePath = cellProperties->getString("scene");
+        if (scenePath && strlen(scenePath) > 0)
+        {
+            cell->scenePath = directory + scenePath;
+        }
+        const char* materialPath = cellProperties->exists("material") ? cellProperties->getString("material") : defaultMaterial;
+        if (materialPath && strlen(materialPath) > 0)
+        {
+            cell->materialPath = materialPath;
+        }
+        cellProperties->getVector3("min", &cell->min);
+        cellProperties->getVector3("max", &cell->max);
+        cell->memory = (unsigned int)cellProperties->getLong("size");
+        cell->state = CELL_UNLOADED;
+        cell->bundle = NULL;
+        cell->distance = 0;
+        streamer->_cells.push_back(cell);
+    }
+    streamer->_sortedCells = streamer->_cells;
+    SAFE_DELETE(properties);
+
+    if (!streamer->_thread.start(&SceneStreamer::openThread, streamer))
+    {
+        GP_ERROR("Failed to start the loading thread for cell index '%s'.", path);
+        SAFE_RELEASE(streamer);
+        return NULL;
+    }
+
+    return streamer;
+}
+
+Scene* SceneStreamer::getScene() const
+{
+    return _scene;
+}
+
+float SceneStreamer::getCellSize() const
+{
+    return _cellSize;
+}
+
+float SceneStreamer::getLoadDistance() const
+{
+    return _loadDistance;
+}
+
+void SceneStreamer::setLoadDistance(float distance)
+{
+    _loadDistance = distance;
+}
+
+float SceneStreamer::getUnloadDistance() const
+{
+    return _unloadDistance;
+}
+
+void SceneStreamer::setUnloadDistance(float distance)
+{
+    _unloadDistance = distance;
+}
+
+unsigned int SceneStreamer::getMemoryBudget() const
+{
+    return _memoryBudget;
+}
+
+void SceneStreamer::setMemoryBudget(unsigned int bytes)
+{
+    _memoryBudget = bytes;
+}
+
+unsigned int SceneStreamer::getCellCount() const
+{
+    return _cells.size();
+}
+
+unsigned int SceneStreamer::getLoadedCellCount() const
+{
+    unsigned int count = 0;
+    for (unsigned int i = 0, cellCount = _cells.size(); i < cellCount; ++i)
+    {
+        if (_cells[i]->state == CELL_LOADED)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+unsigned int SceneStreamer::getMemoryUsage() const
+{
+    unsigned int bytes = 0;
+    for (unsigned int i = 0, count = _cells.size(); i < count; ++i)
+    {
+        if (_cells[i]->state == CELL_LOADED)
+        {
+            bytes += _cells[i]->memory;
+        }
+    }
+    return bytes;
+}
+
+void SceneStreamer::addListener(Listener* listener)
+{
+    GP_ASSERT(listener);
+    _listeners.push_back(listener);
+}
+
+void SceneStreamer::removeListener(Listener* listener)
+{
+    std::vector<Listener*>::iterator itr = std::find(_listeners.begin(), _listeners.end(), listener);
+    if (itr != _listeners.end())
+    {
+        _listeners.erase(itr);
+    }
+}
+
+void SceneStreamer::update()
+{
+    Camera* camera = _scene->getActiveCamera();
+    if (camera && camera->getNode())
+    {
+        update(camera->getNode()->getTranslationWorld());
+    }
+}
+
+void SceneStreamer::update(const Vector3& position)
+{
+    // The nodes of an opened cell are loaded after the mutex is released, so that
+    // the background thread can open the next bundles meanwhile.
+    Cell* opened = NULL;
+    updateCells(position, &opened);
+    if (opened)
+    {
+        loadCell(opened);
+    }
+}
+
+void SceneStreamer::updateCells(const Vector3& position, Cell** opened)
+{
+    Mutex::ScopedLock lock(_mutex);
+    const float unloadDistance = std::max(_unloadDistance, _loadDistance);
+
+    // Unload the cells that are beyond the unload distance and cancel their requests.
+    unsigned int usage = 0;
+    for (unsigned int i = 0, count = _cells.size(); i < count; ++i)
+    {
+        Cell* cell = _cells[i];
+        const float dx = std::max(std::max(cell->min.x - position.x, position.x - cell->max.x), 0.0f);
+        const float dz = std::max(std::max(cell->min.z - position.z, position.z - cell->max.z), 0.0f);
+        cell->distance = sqrt(dx * dx + dz * dz);
+        if (cell->distance > unloadDistance)
+        {
+            if (cell->state == CELL_QUEUED)
+            {
+                // The background thread skips the cell when it is no longer queued.
+                cell->state = CELL_UNLOADED;
+            }
+            else if (cell->state == CELL_OPENED || cell->state == CELL_LOADED)
+            {
+                unloadCell(cell);
+            }
+        }
+        if (cell->state != CELL_UNLOADED && cell->state != CELL_FAILED)
+        {
+            usage += cell->memory;
+        }
+    }
+
+    // Request the nearest cells within the load distance first, while they fit the budget,
+    // and load the nodes of one opened cell since that creates GL resources.
+    std::sort(_sortedCells.begin(), _sortedCells.end(), &SceneStreamer::compareDistance);
+    bool full = false;
+    for (unsigned int i = 0, count = _sortedCells.size(); i < count && _sortedCells[i]->distance <= _loadDistance; ++i)
+    {
+        Cell* cell = _sortedCells[i];
+        if (cell->state == CELL_UNLOADED && !full)
+        {
+            if (!evictCells(&usage, cell->memory))
+            {
+                full = true;
+                continue;
+            }
+            cell->state = CELL_QUEUED;
+            usage += cell->memory;
+            _queue.push_back(cell);
+            _requests.post();
+        }
+        else if (cell->state == CELL_OPENED && *opened == NULL)
+        {
+            // The background thread does not touch the cell while it is loading.
+            cell->state = CELL_LOADING;
+            *opened = cell;
+        }
+    }
+}
+
+bool SceneStreamer::compareDistance(const Cell* a, const Cell* b)
+{
+    return a->distance < b->distance;
+}
+
+void SceneStreamer::loadCell(Cell* cell)
+{
+    GP_ASSERT(cell && cell->bundle && cell->state == CELL_LOADING);
+
+    // A .scene file loads the bundle of the cell again, which finds it in the bundle
+    // cache while the cell still holds it.
+    Scene* scene = cell->scenePath.empty() ? cell->bundle->loadScene() : Scene::load(cell->scenePath.c_str());
+    SAFE_RELEASE(cell->bundle);
+    if (scene == NULL)
+    {
+        GP_ERROR("Failed to load the scene of cell '%s' from '%s'.", cell->id.c_str(),
+            cell->scenePath.empty() ? cell->path.c_str() : cell->scenePath.c_str());
+        Mutex::ScopedLock lock(_mutex);
+        cell->state = CELL_FAILED;
+        return;
+    }
+
+    // Adding the nodes to the scene removes them from the scene of the cell.
+    std::vector<Node*> nodes;
+    while (Node* node = scene->getFirstNode())
+    {
+        node->addRef();
+        nodes.push_back(node);
+        _scene->addNode(node);
+        if (!cell->materialPath.empty())
+        {
+            setDefaultMaterial(node, cell->materialPath.c_str());
+        }
+    }
+    SAFE_RELEASE(scene);
+
+    // Replace the estimate from the file size with the memory of the resources created from the
+    // bundle, or from the scene file, which is also current while its bundle is loaded.
+    const MemoryStats::SourceType sourceType = cell->scenePath.empty() ? MemoryStats::BUNDLE : MemoryStats::SCENE;
+    const std::string& sourcePath = cell->scenePath.empty() ? cell->path : cell->scenePath;
+    unsigned int bytes = 0;
+    Game* game = Game::getInstance();
+    if (game)
+    {
+        MemoryStats stats = game->getMemoryStats();
+        for (unsigned int i = 0, count = stats.getSourceCount(); i < count; ++i)
+        {
+            if (stats.getSourceType(i) == sourceType && sourcePath == stats.getSourcePath(i))
+            {
+                for (unsigned int type = 0; type < MemoryStats::RESOURCE_TYPE_COUNT; ++type)
+                {
+                    const MemoryStats::Usage& usage = stats.getSourceUsage(i, (MemoryStats::ResourceType)type);
+                    bytes += usage.cpuBytes + usage.gpuBytes;
+                }
+            }
+        }
+    }
+
+    {
+        Mutex::ScopedLock lock(_mutex);
+        cell->nodes = nodes;
+        cell->state = CELL_LOADED;
+        if (bytes > 0)
+        {
+            cell->memory = bytes;
+        }
+    }
+    fireEvent(Listener::LOADED, cell);
+}
+
+void SceneStreamer::fireEvent(Listener::EventType type, Cell* cell)
+{
+    for (unsigned int i = 0, count = _listeners.size(); i < count; ++i)
+    {
+        _listeners[i]->cellEvent(this, type, cell->id.c_str(), cell->nodes);
+    }
+}
+
+void SceneStreamer::unloadCell(Cell* cell)
+{
+    GP_ASSERT(cell);
+
+    if (cell->state == CELL_LOADED)
+    {
+        fireEvent(Listener::UNLOADED, cell);
+    }
+    for (unsigned int i = 0, count = cell->nodes.size(); i < count; ++i)
+    {
+        _scene->removeNode(cell->nodes[i]);
+        SAFE_RELEASE(cell->nodes[i]);
+    }
+    cell->nodes.clear();
+    SAFE_RELEASE(cell->bundle);
+    if (cell->state != CELL_FAILED)
+    {
+        cell->state = CELL_UNLOADED;
+    }
+}
+
+bool SceneStreamer::evictCells(unsigned int* usage, unsigned int bytes)
+{
+    GP_ASSERT(usage);
+
+    if (_memoryBudget == 0)
+    {
+        return true;
+    }
+
+    // The cells are sorted by distance, so the farthest cells are unloaded first.
+    for (unsigned int i = _sortedCells.size(); i > 0 && *usage > 0 && *usage + bytes > _memoryBudget; --i)
+    {
+        Cell* cell = _sortedCells[i - 1];
+        if (cell->distance > _loadDistance && (cell->state == CELL_OPENED || cell->state == CELL_LOADED))
+        {
+            *usage -= std::min(cell->memory, *usage);
+            unloadCell(cell);
+        }
+    }
+
+    // A cell that does not fit the budget on its own is still loaded when nothing else is.
+    return *usage == 0 || *usage + bytes <= _memoryBudget;
+}
+
+void SceneStreamer::openThread(void* streamer)
+{
+    SceneStreamer* s = (SceneStreamer*)streamer;
+    GP_ASSERT(s);
+
+    while (true)
+    {
+        s->_requests.wait();
+
+        Cell* cell = NULL;
+        {
+            Mutex::ScopedLock lock(s->_mutex);
+            if (s->_exit)
+            {
+                break;
+            }
+            if (s->_queue.empty())
+            {
+                continue;
+            }
+            cell = s->_queue.front();
+            s->_queue.pop_front();
+
+            // The request was cancelled, or the cell was queued again and already opened.
+            if (cell->state != CELL_QUEUED)
+            {
+                continue;
+            }
+            cell->state = CELL_OPENING;
+        }
+
+        prefetchFile(cell->path.c_str());
+        Bundle* bundle = Bundle::create(cell->path.c_str());
+
+        Mutex::ScopedLock lock(s->_mutex);
+        cell->bundle = bundle;
+        cell->state = bundle ? CELL_OPENED : CELL_FAILED;
+    }
+}
+
+}
@@ -0,0 +1,337 @@
+#ifndef SCENESTREAMER_H_
+#define SCENESTREAMER_H_
+
+#include "Ref.h"
+#include "Scene.h"
+#include "Bundle.h"
+#include "Mutex.h"
+#include "Semaphore.h"
+#include "Thread.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a streamer that loads the cells of a world into a scene as the camera approaches
+ * them and unloads them as it moves away.
+ *
+ * The encoder splits the static models of a scene into square cells on the XZ plane when it
+ * is run with -cells, and writes each cell to its own bundle next to a .cells index file:
+ * @code
+ * cells
+ * {
+ *     cellSize = 100
+ *     bundle = world.gpb
+ *
+ *     cell world_0_0
+ *     {
+ *         bundle = world_0_0.gpb
+ *         min = 0, 0, 0
+ *         max = 100, 20, 100
+ *         size = 52431
+ *     }
+ * }
+ * @endcode
+ * The scene is loaded from the main bundle as usual, and the streamer adds the nodes of each
+ * cell to it. The index may also set loadDistance and unloadDistance.
+ *
+ * Bundles do not hold materials, so the models of a cell need them from somewhere else. A cell
+ * may name a .scene file with a scene property, whose path is the bundle of the cell, and the
+ * cell is then loaded through it like Scene::load, which sets the materials and other properties
+ * of its nodes. The index or a cell may also name a material with a material property, which is
+ * set on the models of the cell that have no material. Listeners are told when the nodes of a
+ * cell are added to the scene and before they are removed, and may set up the nodes themselves.
+ *
+ * The headers of cell bundles are read by a background thread, which also reads the rest of
+ * the file ahead so that it is cached. The objects of at most one cell are created on the
+ * game thread in each update, since creating meshes and textures needs the GL context, and
+ * the background thread keeps opening bundles while they are created.
+ *
+ * A cell is loaded when the camera comes within the load distance of its bounds and unloaded
+ * when it moves beyond the unload distance, which is larger so that cells on the border are not
+ * loaded and unloaded repeatedly. When a memory budget is set, the nearest cells are loaded first
+ * and loaded cells outside the load distance are unloaded early to make room for them. The memory
+ * of a cell is measured with MemoryStats once it is loaded and estimated from its file size before.
+ *
+ * @script{ignore}
+ */
+class SceneStreamer : public Ref
+{
+public:
+
+    /**
+     * Defines an interface for objects that are told when cells are loaded and unloaded.
+     */
+    class Listener
+    {
+    public:
+
+        /**
+         * The type of cell event.
+         */
+        enum EventType
+        {
+            /**
+             * Event fired after the nodes of a cell are added to the scene.
+             */
+            LOADED,
+
+            /**
+             * Event fired before the nodes of a cell are removed from the scene.
+             */
+            UNLOADED
+        };
+
+        /**
+         * Destructor.
+         */
+        virtual ~Listener() { }
+
+        /**
+         * Handles when a cell is loaded or unloaded.
+         *
+         * @param streamer The streamer of the cell.
+         * @param type The type of event.
+         * @param cellId The id of the cell in the index.
+         * @param nodes The nodes of the cell, which are root nodes of the scene.
+         */
+        virtual void cellEvent(SceneStreamer* streamer, EventType type, const char* cellId, const std::vector<Node*>& nodes) = 0;
+    };
+
+    /**
+     * Creates a streamer for the cells of a .cells index file.
+     *
+     * The paths of the cell bundles are relative to the directory of the index.
+     *
+     * @param path The path of the .cells index file.
+     * @param scene The scene to add the nodes of the cells to.
+     *
+     * @return The new streamer, or NULL if the index could not be read.
+     */
+    static SceneStreamer* create(const char* path, Scene* scene);
+
+    /**
+     * Gets the scene that the nodes of the cells are added to.
+     *
+     * @return The scene.
+     */
+    Scene* getScene() const;
+
+    /**
+     * Gets the size of the cells.
+     *
+     * @return The size of the cells on the X and Z axes.
+     */
+    float getCellSize() const;
+
+    /**
+     * Gets the distance from the bounds of a cell on the XZ plane within which it is loaded.
+     *
+     * @return The load distance.
+     */
+    float getLoadDistance() const;
+
+    /**
+     * Sets the distance from the bounds of a cell on the XZ plane within which it is loaded.
+     *
+     * @param distance The load distance. The default is the cell size.
+     */
+    void setLoadDistance(float distance);
+
+    /**
+     * Gets the distance from the bounds of a cell on the XZ plane beyond which it is unloaded.
+     *
+     * @return The unload distance.
+     */
+    float getUnloadDistance() const;
+
+    /**
+     * Sets the distance from the bounds of a cell on the XZ plane beyond which it is unloaded.
+     *
+     * @param distance The unload distance, which is at least the load distance. The default
+     *      is one and a half times the cell size.
+     */
+    void setUnloadDistance(float distance);
+
+    /**
+     * Gets the number of bytes of memory that the loaded cells may use.
+     *
+     * @return The memory budget, or 0 if it is unlimited.
+     */
+    unsigned int getMemoryBudget() const;
+
+    /**
+     * Sets the number of bytes of memory that the loaded cells may use.
+     *
+     * @param bytes The memory budget, or 0 for no limit, which is the default.
+     */
+    void setMemoryBudget(unsigned int bytes);
+
+    /**
+     * Gets the number of cells in the index.
+     *
+     * @return The number of cells.
+     */
+    unsigned int getCellCount() const;
+
+    /**
+     * Gets the number of cells whose nodes are in the scene.
+     *
+     * @return The number of loaded cells.
+     */
+    unsigned int getLoadedCellCount() const;
+
+    /**
+     * Gets the number of bytes of system and graphics memory used by the loaded cells.
+     *
+     * @return The memory used by the loaded cells.
+     */
+    unsigned int getMemoryUsage() const;
+
+    /**
+     * Adds a listener that is told when cells are loaded and unloaded.
+     *
+     * @param listener The listener to add.
+     */
+    void addListener(Listener* listener);
+
+    /**
+     * Removes a listener.
+     *
+     * @param listener The listener to remove.
+     */
+    void removeListener(Listener* listener);
+
+    /**
+     * Loads and unloads cells around the active camera of the scene.
+     *
+     * This must be called on the game thread, usually once per frame.
+     */
+    void update();
+
+    /**
+     * Loads and unloads cells around a position.
+     *
+     * This must be called on the game thread, usually once per frame.
+     *
+     * @param position The position in world space to stream the cells around.
+     */
+    void update(const Vector3& position);
+
+private:
+
+    /**
+     * The states of a cell.
+     */
+    enum State
+    {
+        CELL_UNLOADED,   // Not loaded.
+        CELL_QUEUED,     // Waiting for the background thread to open its bundle.
+        CELL_OPENING,    // The background thread is opening its bundle.
+        CELL_OPENED,     // The bundle is open and the nodes can be loaded.
+        CELL_LOADING,    // The game thread is loading the nodes.
+        CELL_LOADED,     // The nodes are in the scene.
+        CELL_FAILED      // The bundle could not be opened.
+    };
+
+    /**
+     * A cell of the index.
+     */
+    struct Cell
+    {
+        std::string id;
+        std::string path;
+        std::string scenePath;      // The .scene file to load the cell through, or empty.
+        std::string materialPath;   // The material of models that have none, or empty.
+        Vector3 min;
+        Vector3 max;
+        unsigned int memory;        // The measured memory, or the file size until it is loaded.
+        State state;
+        Bundle* bundle;
+        std::vector<Node*> nodes;
+        float distance;
+    };
+
+    /**
+     * Orders cells by their distance.
+     */
+    static bool compareDistance(const Cell* a, const Cell* b);
+
+    /**
+     * Constructor.
+     */
+    SceneStreamer(Scene* scene);
+
+    /**
+     * Destructor.
+     */
+    ~SceneStreamer();
+
+    /**
+     * Hidden copy constructor.
+     */
+    SceneStreamer(const SceneStreamer& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    SceneStreamer& operator=(const SceneStreamer&);
+
+    /**
+     * Unloads the cells beyond the unload distance, requests the cells within the load distance
+     * and picks the nearest opened cell to load, while holding the mutex.
+     *
+     * @param position The position in world space to stream the cells around.
+     * @param opened Returns the cell to load, or NULL.
+     */
+    void updateCells(const Vector3& position, Cell** opened);
+
+    /**
+     * Adds the nodes of a cell whose bundle is open to the scene. Called without holding the mutex.
+     */
+    void loadCell(Cell* cell);
+
+    /**
+     * Tells the listeners about an event of a cell.
+     */
+    void fireEvent(Listener::EventType type, Cell* cell);
+
+    /**
+     * Removes the nodes of a cell from the scene, or closes its bundle if it is open.
+     */
+    void unloadCell(Cell* cell);
+
+    /**
+     * Unloads the cells beyond the load distance, farthest first, until the memory they
+     * use with the given number of bytes more fits the budget.
+     *
+     * @param usage The memory used by the cells, which is reduced by the unloaded cells.
+     * @param bytes The memory of the cell to load.
+     *
+     * @return true if the cell may be loaded.
+     */
+    bool evictCells(unsigned int* usage, unsigned int bytes);
+
+    /**
+     * Opens the bundles of the queued cells. Runs on the background thread.
+     */
+    static void openThread(void* streamer);
+
+    Scene* _scene;
+    float _cellSize;
+    float _loadDistance;
+    float _unloadDistance;
+    unsigned int _memoryBudget;
+    std::vector<Cell*> _cells;
+    std::vector<Cell*> _sortedCells;
+    std::list<Cell*> _queue;
+    std::vector<Listener*> _listeners;
+    Mutex _mutex;               // Guards the queue and the state and bundle of the cells.
+    Semaphore _requests;        // Posted once for each cell added to the queue.
+    Thread _thread;
+    bool _exit;
+};
+
+}
+
+#endif
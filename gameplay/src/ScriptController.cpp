@@ -337,6 +337,9 @@ bool ScriptUtil::luaCheckBool(lua_State* state, int n)
 
 void ScriptController::loadScript(const char* path, bool forceReload)
 {
+    GP_MEMORY_TAG(SCRIPT);
+    Mutex::ScopedLock lock(_mutex);
+    initializeLua();
     std::set<std::string>::iterator iter = _loadedScripts.find(path);
     if (iter == _loadedScripts.end() || forceReload)
     {
@@ -374,144 +377,168 @@ std::string ScriptController::loadUrl(const char* url)
 
 bool ScriptController::getBool(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return ScriptUtil::luaCheckBool(_lua, -1);
 }
 
 char ScriptController::getChar(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (char)luaL_checkint(_lua, -1);
 }
 
 short ScriptController::getShort(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (short)luaL_checkint(_lua, -1);
 }
 
 int ScriptController::getInt(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return luaL_checkint(_lua, -1);
 }
 
 long ScriptController::getLong(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return luaL_checklong(_lua, -1);
 }
 
 unsigned char ScriptController::getUnsignedChar(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (unsigned char)luaL_checkunsigned(_lua, -1);
 }
 
 unsigned short ScriptController::getUnsignedShort(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (unsigned short)luaL_checkunsigned(_lua, -1);
 }
 
 unsigned int ScriptController::getUnsignedInt(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (unsigned int)luaL_checkunsigned(_lua, -1);
 }
 
 unsigned long ScriptController::getUnsignedLong(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (unsigned long)luaL_checkunsigned(_lua, -1);
 }
 
 float ScriptController::getFloat(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (float)luaL_checknumber(_lua, -1);
 }
 
 double ScriptController::getDouble(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return (double)luaL_checknumber(_lua, -1);
 }
 
 const char* ScriptController::getString(const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     return luaL_checkstring(_lua, -1);
 }
 
 void ScriptController::setBool(const char* name, bool v)
 {
+    initializeLua();
     lua_pushboolean(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setChar(const char* name, char v)
 {
+    initializeLua();
     lua_pushinteger(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setShort(const char* name, short v)
 {
+    initializeLua();
     lua_pushinteger(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setInt(const char* name, int v)
 {
+    initializeLua();
     lua_pushinteger(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setLong(const char* name, long v)
 {
+    initializeLua();
     lua_pushinteger(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setUnsignedChar(const char* name, unsigned char v)
 {
+    initializeLua();
     lua_pushunsigned(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setUnsignedShort(const char* name, unsigned short v)
 {
+    initializeLua();
     lua_pushunsigned(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setUnsignedInt(const char* name, unsigned int v)
 {
+    initializeLua();
     lua_pushunsigned(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setUnsignedLong(const char* name, unsigned long v)
 {
+    initializeLua();
     lua_pushunsigned(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setFloat(const char* name, float v)
 {
+    initializeLua();
     lua_pushnumber(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setDouble(const char* name, double v)
 {
+    initializeLua();
     lua_pushnumber(_lua, v);
     lua_setglobal(_lua, name);
 }
 
 void ScriptController::setString(const char* name, const char* v)
 {
+    initializeLua();
     lua_pushstring(_lua, v);
     lua_setglobal(_lua, name);
 }
@@ -540,12 +567,21 @@ ScriptController::~ScriptController()
 }
 
 static const char* lua_print_function = 
-    "function print(...)\n"
-    "    ScriptController.print(table.concat({...},\"\\t\"), \"\\n\")\n"
+    "function print(...)\n"
+    "    ScriptController.print(table.concat({...},\"\\t\"), \"\\n\")\n"
     "end\n";
 
 void ScriptController::initialize()
 {
+    initializeLua();
+}
+
+void ScriptController::initializeLua()
+{
+    Mutex::ScopedLock lock(_mutex);
+    if (_lua)
+        return;
+
     _lua = luaL_newstate();
     if (!_lua)
         GP_ERROR("Failed to initialize Lua scripting engine.");
@@ -579,7 +615,8 @@ void ScriptController::finalizeGame()
     }
 
     // Perform a full garbage collection cycle.
-    lua_gc(_lua, LUA_GCCOLLECT, 0);
+    if (_lua)
+        lua_gc(_lua, LUA_GCCOLLECT, 0);
 }
 
 void ScriptController::update(float elapsedTime)
@@ -633,6 +670,11 @@ void ScriptController::gamepadEvent(Gamepad::GamepadEvent evt, Gamepad* gamepad)
 
 void ScriptController::executeFunctionHelper(int resultCount, const char* func, const char* args, va_list* list)
 {
+    GP_MEMORY_TAG(SCRIPT);
+    // Callers that read results off the stack also hold the lock until they are popped.
+    Mutex::ScopedLock lock(_mutex);
+    initializeLua();
+
     if (func == NULL)
     {
         GP_ERROR("Lua function name must be non-null.");
@@ -781,12 +823,14 @@ ScriptController::ScriptCallback ScriptController::toCallback(const char* name)
 
 // Helper macros.
 #define SCRIPT_EXECUTE_FUNCTION_NO_PARAM(type, checkfunc) \
+    Mutex::ScopedLock lock(_mutex); \
     executeFunctionHelper(1, func, NULL, NULL); \
     type value = (type)checkfunc(_lua, -1); \
     lua_pop(_lua, -1); \
     return value;
 
 #define SCRIPT_EXECUTE_FUNCTION_PARAM(type, checkfunc) \
+    Mutex::ScopedLock lock(_mutex); \
     va_list list; \
     va_start(list, args); \
     executeFunctionHelper(1, func, args, &list); \
@@ -796,6 +840,7 @@ ScriptController::ScriptCallback ScriptController::toCallback(const char* name)
     return value;
 
 #define SCRIPT_EXECUTE_FUNCTION_PARAM_LIST(type, checkfunc) \
+    Mutex::ScopedLock lock(_mutex); \
     executeFunctionHelper(1, func, args, list); \
     type value = (type)checkfunc(_lua, -1); \
     lua_pop(_lua, -1); \
@@ -4,6 +4,7 @@
 #include "Base.h"
 #include "Game.h"
 #include "Gamepad.h"
+#include "Mutex.h"
 
 namespace gameplay
 {
@@ -608,6 +609,14 @@ private:
      */
     void initialize();
 
+    /**
+     * Creates the Lua state and registers the script bindings, unless they have been created already.
+     *
+     * Every function that uses the Lua state calls this, so a controller that was not initialized
+     * at startup creates the state when it is first used.
+     */
+    void initializeLua();
+
     /**
      * Initializes the game using the appropriate callback script (if it was specified).
      */
@@ -752,6 +761,7 @@ private:
     std::string* _callbacks[CALLBACK_COUNT];
     std::set<std::string> _loadedScripts;
     std::vector<luaStringEnumConversionFunction> _stringFromEnum;
+    Mutex _mutex;
 };
 
 /** Template specialization. */
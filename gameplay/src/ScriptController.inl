@@ -64,10 +64,10 @@ template<typename T>T* ScriptUtil::getObjectPointer(int index, const char* type,
                             T* ptr = (T*)((ScriptUtil::LuaObject*)p)->instance;
                             if (ptr)
                                 memcpy((void*)&values[i], (void*)ptr, sizeof(T));
-                            else
-                                memset((void*)&values[i], 0, sizeof(T));
-
-                            lua_pop(sc->_lua, 1);
+                            else
+                                memset((void*)&values[i], 0, sizeof(T));
+
+                            lua_pop(sc->_lua, 1);
                             continue;
                         }
                         lua_pop(sc->_lua, 1);
@@ -132,6 +132,7 @@ template<typename T>T* ScriptUtil::getObjectPointer(int index, const char* type,
     
 template<typename T> T ScriptController::executeFunction(const char* func)
 {
+    Mutex::ScopedLock lock(_mutex);
     executeFunctionHelper(1, func, NULL, NULL);
     T value = (T)((ScriptUtil::LuaObject*)lua_touserdata(_lua, -1))->instance;
     lua_pop(_lua, -1);
@@ -140,6 +141,7 @@ template<typename T> T ScriptController::executeFunction(const char* func)
 
 template<typename T> T ScriptController::executeFunction(const char* func, const char* args, ...)
 {
+    Mutex::ScopedLock lock(_mutex);
     va_list list;
     va_start(list, args);
     executeFunctionHelper(1, func, args, &list);
@@ -152,6 +154,7 @@ template<typename T> T ScriptController::executeFunction(const char* func, const
 
 template<typename T> T ScriptController::executeFunction(const char* func, const char* args, va_list* list)
 {
+    Mutex::ScopedLock lock(_mutex);
     executeFunctionHelper(1, func, args, list);
 
     T value = (T)((ScriptUtil::LuaObject*)lua_touserdata(_lua, -1))->instance;
@@ -161,6 +164,7 @@ template<typename T> T ScriptController::executeFunction(const char* func, const
 
 template<typename T>T* ScriptController::getObjectPointer(const char* type, const char* name)
 {
+    initializeLua();
     lua_getglobal(_lua, name);
     void* userdata = luaL_checkudata(_lua, -1, type);
     std::string msg = std::string("'") + std::string(type) + std::string("' expected.");
@@ -170,6 +174,7 @@ template<typename T>T* ScriptController::getObjectPointer(const char* type, cons
 
 template<typename T>void ScriptController::setObjectPointer(const char* type, const char* name, T* v)
 {
+    initializeLua();
     ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)lua_newuserdata(_lua, sizeof(ScriptUtil::LuaObject));
     object->instance = (void*)v;
     object->owns = false;
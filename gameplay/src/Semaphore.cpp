@@ -0,0 +1,106 @@
+#include "Base.h"
+#include "Semaphore.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace gameplay
+{
+
+#ifdef WIN32
+
+Semaphore::Semaphore(unsigned int count)
+{
+    _handle = CreateSemaphore(NULL, count, LONG_MAX, NULL);
+    GP_ASSERT(_handle);
+}
+
+Semaphore::~Semaphore()
+{
+    CloseHandle((HANDLE)_handle);
+}
+
+void Semaphore::wait()
+{
+    WaitForSingleObject((HANDLE)_handle, INFINITE);
+}
+
+bool Semaphore::tryWait()
+{
+    return WaitForSingleObject((HANDLE)_handle, 0) == WAIT_OBJECT_0;
+}
+
+void Semaphore::post()
+{
+    ReleaseSemaphore((HANDLE)_handle, 1, NULL);
+}
+
+#else
+
+// Unnamed POSIX semaphores are not supported on every platform (such as MacOSX),
+// so the semaphore is built from a mutex and a condition variable.
+struct SemaphoreHandle
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    unsigned int count;
+};
+
+Semaphore::Semaphore(unsigned int count)
+{
+    SemaphoreHandle* semaphore = new SemaphoreHandle();
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    pthread_cond_init(&semaphore->condition, NULL);
+    semaphore->count = count;
+    _handle = semaphore;
+}
+
+Semaphore::~Semaphore()
+{
+    SemaphoreHandle* semaphore = (SemaphoreHandle*)_handle;
+    pthread_cond_destroy(&semaphore->condition);
+    pthread_mutex_destroy(&semaphore->mutex);
+    SAFE_DELETE(semaphore);
+}
+
+void Semaphore::wait()
+{
+    SemaphoreHandle* semaphore = (SemaphoreHandle*)_handle;
+    pthread_mutex_lock(&semaphore->mutex);
+    while (semaphore->count == 0)
+    {
+        pthread_cond_wait(&semaphore->condition, &semaphore->mutex);
+    }
+    --semaphore->count;
+    pthread_mutex_unlock(&semaphore->mutex);
+}
+
+bool Semaphore::tryWait()
+{
+    SemaphoreHandle* semaphore = (SemaphoreHandle*)_handle;
+    bool acquired = false;
+    pthread_mutex_lock(&semaphore->mutex);
+    if (semaphore->count > 0)
+    {
+        --semaphore->count;
+        acquired = true;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+    return acquired;
+}
+
+void Semaphore::post()
+{
+    SemaphoreHandle* semaphore = (SemaphoreHandle*)_handle;
+    pthread_mutex_lock(&semaphore->mutex);
+    ++semaphore->count;
+    pthread_cond_signal(&semaphore->condition);
+    pthread_mutex_unlock(&semaphore->mutex);
+}
+
+#endif
+
+}
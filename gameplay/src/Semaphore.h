@@ -0,0 +1,62 @@
+#ifndef SEMAPHORE_H_
+#define SEMAPHORE_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a counting semaphore, used to signal work between threads.
+ *
+ * @script{ignore}
+ */
+class Semaphore
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param count The initial count of the semaphore.
+     */
+    explicit Semaphore(unsigned int count = 0);
+
+    /**
+     * Destructor.
+     */
+    ~Semaphore();
+
+    /**
+     * Blocks until the count is greater than zero, then decrements it.
+     */
+    void wait();
+
+    /**
+     * Decrements the count if it is greater than zero, without blocking.
+     *
+     * @return true if the count was decremented, false otherwise.
+     */
+    bool tryWait();
+
+    /**
+     * Increments the count, waking up one waiting thread.
+     */
+    void post();
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    Semaphore(const Semaphore& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Semaphore& operator=(const Semaphore&);
+
+    void* _handle;
+};
+
+}
+
+#endif
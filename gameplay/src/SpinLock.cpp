@@ -0,0 +1,43 @@
+#include "Base.h"
+#include "SpinLock.h"
+#include "Atomic.h"
+#include "Thread.h"
+
+namespace gameplay
+{
+
+SpinLock::SpinLock() : _locked(0)
+{
+}
+
+void SpinLock::lock()
+{
+    while (!Atomic::compareAndSwap(&_locked, 0, 1))
+    {
+        // Let the thread holding the lock run rather than burn the rest of the time slice.
+        Thread::yield();
+    }
+}
+
+bool SpinLock::tryLock()
+{
+    return Atomic::compareAndSwap(&_locked, 0, 1);
+}
+
+void SpinLock::unlock()
+{
+    GP_ASSERT(_locked);
+    Atomic::store(&_locked, 0);
+}
+
+SpinLock::ScopedLock::ScopedLock(SpinLock& lock) : _lock(lock)
+{
+    _lock.lock();
+}
+
+SpinLock::ScopedLock::~ScopedLock()
+{
+    _lock.unlock();
+}
+
+}
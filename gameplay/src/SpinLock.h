@@ -0,0 +1,86 @@
+#ifndef SPINLOCK_H_
+#define SPINLOCK_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a lock that busy-waits, yielding to other threads, until it can be acquired.
+ *
+ * Unlike Mutex, a spin lock allocates no resources, so it can guard static data,
+ * such as resource caches, from static initialization until after Game shuts down.
+ * It should only be held for short sections of code and is not recursive.
+ *
+ * @script{ignore}
+ */
+class SpinLock
+{
+public:
+
+    /**
+     * Acquires a spin lock for the lifetime of the scoped lock object.
+     */
+    class ScopedLock
+    {
+    public:
+
+        /**
+         * Constructor. Acquires the spin lock.
+         *
+         * @param lock The spin lock to acquire.
+         */
+        explicit ScopedLock(SpinLock& lock);
+
+        /**
+         * Destructor. Releases the spin lock.
+         */
+        ~ScopedLock();
+
+    private:
+
+        ScopedLock(const ScopedLock& copy);
+        ScopedLock& operator=(const ScopedLock&);
+
+        SpinLock& _lock;
+    };
+
+    /**
+     * Constructor.
+     */
+    SpinLock();
+
+    /**
+     * Acquires the lock, waiting until it is released by another thread if needed.
+     */
+    void lock();
+
+    /**
+     * Acquires the lock if it is not held by another thread.
+     *
+     * @return true if the lock was acquired.
+     */
+    bool tryLock();
+
+    /**
+     * Releases the lock.
+     */
+    void unlock();
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    SpinLock(const SpinLock& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    SpinLock& operator=(const SpinLock&);
+
+    volatile int _locked;
+};
+
+}
+
+#endif
@@ -2,6 +2,10 @@
 #include "Image.h"
 #include "Texture.h"
 #include "FileSystem.h"
+#include "SpinLock.h"
+#include "MemoryStats.h"
+#include "LoadTrace.h"
+#include "RenderStats.h"
 
 // PVRTC (GL_IMG_texture_compression_pvrtc) : Imagination based gpus
 #ifndef GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG
@@ -43,6 +47,14 @@ namespace gameplay
 {
 
 static std::vector<Texture*> __textureCache;
+static SpinLock __textureCacheLock;
+
+// Computes the size of an uncompressed texture in graphics memory, including its mipmaps.
+static unsigned int computeTextureSize(Texture::Format format, unsigned int width, unsigned int height, bool mipmapped)
+{
+    unsigned int size = width * height * (format == Texture::RGBA ? 4 : (format == Texture::RGB ? 3 : 1));
+    return mipmapped ? size + size / 3 : size;
+}
 
 Texture::Texture() : _handle(0), _format(RGBA), _width(0), _height(0), _mipmapped(false), _cached(false), _compressed(false)
 {
@@ -55,10 +67,12 @@ Texture::~Texture()
         GL_ASSERT( glDeleteTextures(1, &_handle) );
         _handle = 0;
     }
+    MemoryStats::untrack(this);
 
     // Remove ourself from the texture cache.
     if (_cached)
     {
+        SpinLock::ScopedLock lock(__textureCacheLock);
         std::vector<Texture*>::iterator itr = std::find(__textureCache.begin(), __textureCache.end(), this);
         if (itr != __textureCache.end())
         {
@@ -69,27 +83,40 @@ Texture::~Texture()
 
 Texture* Texture::create(const char* path, bool generateMipmaps)
 {
+    GP_MEMORY_TAG(ASSETS);
     GP_ASSERT(path);
+    LoadTrace::Asset trace("texture", path);
 
     // Search texture cache first.
+    Texture* cached = NULL;
+    __textureCacheLock.lock();
     for (unsigned int i = 0, count = __textureCache.size(); i < count; ++i)
     {
         Texture* t = __textureCache[i];
         GP_ASSERT(t);
-        if (t->_path == path)
-        {
-            // If 'generateMipmaps' is true, call Texture::generateMipamps() to force the 
-            // texture to generate its mipmap chain if it hasn't already done so.
-            if (generateMipmaps)
-            {
-                t->generateMipmaps();
-            }
 
+        // Skip textures that are being destroyed by another thread.
+        if (t->_path == path && t->tryAddRef())
+        {
             // Found a match.
-            t->addRef();
+            cached = t;
+            break;
+        }
+    }
+    __textureCacheLock.unlock();
 
-            return t;
+    if (cached)
+    {
+        trace.setCacheHit();
+
+        // If 'generateMipmaps' is true, call Texture::generateMipamps() to force the 
+        // texture to generate its mipmap chain if it hasn't already done so.
+        if (generateMipmaps)
+        {
+            cached->generateMipmaps();
         }
+
+        return cached;
     }
 
     Texture* texture = NULL;
@@ -103,7 +130,11 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
         case 4:
             if (tolower(ext[1]) == 'p' && tolower(ext[2]) == 'n' && tolower(ext[3]) == 'g')
             {
-                Image* image = Image::create(path);
+                Image* image;
+                {
+                    LoadTrace::PhaseScope phase(LoadTrace::DECODE);
+                    image = Image::create(path);
+                }
                 if (image)
                     texture = create(image, generateMipmaps);
                 SAFE_RELEASE(image);
@@ -111,11 +142,13 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
             else if (tolower(ext[1]) == 'p' && tolower(ext[2]) == 'v' && tolower(ext[3]) == 'r')
             {
                 // PowerVR Compressed Texture RGBA.
+                LoadTrace::PhaseScope phase(LoadTrace::IO);
                 texture = createCompressedPVRTC(path);
             }
             else if (tolower(ext[1]) == 'd' && tolower(ext[2]) == 'd' && tolower(ext[3]) == 's')
             {
                 // DDS file format (DXT/S3TC) compressed textures
+                LoadTrace::PhaseScope phase(LoadTrace::IO);
                 texture = createCompressedDDS(path);
             }
             break;
@@ -128,7 +161,9 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
         texture->_cached = true;
 
         // Add to texture cache.
+        __textureCacheLock.lock();
         __textureCache.push_back(texture);
+        __textureCacheLock.unlock();
 
         return texture;
     }
@@ -155,6 +190,8 @@ Texture* Texture::create(Image* image, bool generateMipmaps)
 
 Texture* Texture::create(Format format, unsigned int width, unsigned int height, unsigned char* data, bool generateMipmaps)
 {
+    LoadTrace::PhaseScope phase(LoadTrace::UPLOAD);
+
     // Create and load the texture.
     GLuint textureId;
     GL_ASSERT( glGenTextures(1, &textureId) );
@@ -175,6 +212,7 @@ Texture* Texture::create(Format format, unsigned int width, unsigned int height,
         texture->generateMipmaps();
         texture->_mipmapped = true;
     }
+    MemoryStats::track(texture, MemoryStats::TEXTURE, 0, computeTextureSize(format, width, height, texture->_mipmapped));
 
     return texture;
 }
@@ -287,10 +325,13 @@ Texture* Texture::createCompressedPVRTC(const char* path)
     texture->_compressed = true;
 
     // Load the data for each level.
+    LoadTrace::PhaseScope phase(LoadTrace::UPLOAD);
     GLubyte* ptr = data;
+    unsigned int textureSize = 0;
     for (unsigned int level = 0; level < mipMapCount; ++level)
     {
         unsigned int dataSize = computePVRTCDataSize(width, height, bpp);
+        textureSize += dataSize;
 
         // Upload data to GL.
         GL_ASSERT( glCompressedTexImage2D(GL_TEXTURE_2D, level, format, width, height, 0, dataSize, ptr) );
@@ -303,6 +344,8 @@ Texture* Texture::createCompressedPVRTC(const char* path)
     // Free data.
     SAFE_DELETE_ARRAY(data);
 
+    MemoryStats::track(texture, MemoryStats::TEXTURE, 0, textureSize);
+
     return texture;
 }
 
@@ -714,8 +757,11 @@ Texture* Texture::createCompressedDDS(const char* path)
     texture->_mipmapped = header.dwMipMapCount > 1;
 
     // Load texture data.
+    LoadTrace::PhaseScope phase(LoadTrace::UPLOAD);
+    unsigned int textureSize = 0;
     for (unsigned int i = 0; i < header.dwMipMapCount; ++i)
     {
+        textureSize += mipLevels[i].size;
         if (compressed)
         {
             GL_ASSERT( glCompressedTexImage2D(GL_TEXTURE_2D, i, format, mipLevels[i].width, mipLevels[i].height, 0, mipLevels[i].size, mipLevels[i].data) );
@@ -733,6 +779,8 @@ Texture* Texture::createCompressedDDS(const char* path)
     // Clean up mip levels structure.
     SAFE_DELETE_ARRAY(mipLevels);
 
+    MemoryStats::track(texture, MemoryStats::TEXTURE, 0, textureSize);
+
     return texture;
 }
 
@@ -787,6 +835,8 @@ void Texture::generateMipmaps()
         GL_ASSERT( glBindTexture(GL_TEXTURE_2D, (GLuint)currentTextureId) );
 
         _mipmapped = true;
+        if (!_compressed)
+            MemoryStats::track(this, MemoryStats::TEXTURE, 0, computeTextureSize(_format, _width, _height, true));
     }
 }
 
@@ -847,6 +897,7 @@ void Texture::Sampler::bind()
     GP_ASSERT(_texture);
 
     GL_ASSERT( glBindTexture(GL_TEXTURE_2D, _texture->_handle) );
+    RenderStats::recordTextureBind();
     GL_ASSERT( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLenum)_wrapS) );
     GL_ASSERT( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLenum)_wrapT) );
     GL_ASSERT( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLenum)_minFilter) );
@@ -0,0 +1,133 @@
+#include "Base.h"
+#include "Thread.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace gameplay
+{
+
+Thread::Thread() : _handle(NULL), _function(NULL), _arg(NULL), _running(false)
+{
+}
+
+Thread::~Thread()
+{
+    join();
+}
+
+bool Thread::isRunning() const
+{
+    return _running;
+}
+
+#ifdef WIN32
+
+unsigned long __stdcall Thread::run(void* thread)
+{
+    Thread* t = (Thread*)thread;
+    t->_function(t->_arg);
+    return 0;
+}
+
+bool Thread::start(Function function, void* arg)
+{
+    GP_ASSERT(function);
+    if (_running)
+        return false;
+
+    _function = function;
+    _arg = arg;
+    _handle = CreateThread(NULL, 0, &Thread::run, this, 0, NULL);
+    if (_handle == NULL)
+    {
+        GP_ERROR("Failed to create thread.");
+        return false;
+    }
+    _running = true;
+    return true;
+}
+
+void Thread::join()
+{
+    if (_running)
+    {
+        WaitForSingleObject((HANDLE)_handle, INFINITE);
+        CloseHandle((HANDLE)_handle);
+        _handle = NULL;
+        _running = false;
+    }
+}
+
+unsigned int Thread::getProcessorCount()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+}
+
+void Thread::yield()
+{
+    SwitchToThread();
+}
+
+#else
+
+void* Thread::run(void* thread)
+{
+    Thread* t = (Thread*)thread;
+    t->_function(t->_arg);
+    return NULL;
+}
+
+bool Thread::start(Function function, void* arg)
+{
+    GP_ASSERT(function);
+    if (_running)
+        return false;
+
+    _function = function;
+    _arg = arg;
+    pthread_t* thread = new pthread_t;
+    if (pthread_create(thread, NULL, &Thread::run, this) != 0)
+    {
+        GP_ERROR("Failed to create thread.");
+        SAFE_DELETE(thread);
+        return false;
+    }
+    _handle = thread;
+    _running = true;
+    return true;
+}
+
+void Thread::join()
+{
+    if (_running)
+    {
+        pthread_t* thread = (pthread_t*)_handle;
+        pthread_join(*thread, NULL);
+        SAFE_DELETE(thread);
+        _handle = NULL;
+        _running = false;
+    }
+}
+
+unsigned int Thread::getProcessorCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned int)count : 1;
+}
+
+void Thread::yield()
+{
+    sched_yield();
+}
+
+#endif
+
+}
@@ -0,0 +1,97 @@
+#ifndef THREAD_H_
+#define THREAD_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a native thread of execution.
+ *
+ * Note that OpenGL calls may only be made from the thread the
+ * game was started on.
+ *
+ * @script{ignore}
+ */
+class Thread
+{
+public:
+
+    /**
+     * The function run by a thread.
+     *
+     * @param arg The argument passed to Thread::start.
+     */
+    typedef void (*Function)(void* arg);
+
+    /**
+     * Constructor.
+     */
+    Thread();
+
+    /**
+     * Destructor. Waits for the thread to finish if it is still running.
+     */
+    ~Thread();
+
+    /**
+     * Starts running the given function on a new thread.
+     *
+     * @param function The function to run.
+     * @param arg The argument to pass to the function.
+     *
+     * @return true if the thread was started, false if it could not be created
+     *      or this thread has already been started.
+     */
+    bool start(Function function, void* arg);
+
+    /**
+     * Waits for the thread to finish.
+     */
+    void join();
+
+    /**
+     * Determines if the thread has been started and not yet joined.
+     *
+     * @return true if the thread is running.
+     */
+    bool isRunning() const;
+
+    /**
+     * Gets the number of processors available to run threads on.
+     *
+     * @return The number of online processors, at least 1.
+     */
+    static unsigned int getProcessorCount();
+
+    /**
+     * Gives up the rest of the calling thread's time slice to other threads.
+     */
+    static void yield();
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    Thread(const Thread& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Thread& operator=(const Thread&);
+
+    void* _handle;
+    Function _function;
+    void* _arg;
+    bool _running;
+
+#ifdef WIN32
+    static unsigned long __stdcall run(void* thread);
+#else
+    static void* run(void* thread);
+#endif
+};
+
+}
+
+#endif
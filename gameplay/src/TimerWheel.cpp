@@ -0,0 +1,303 @@
+#include "Base.h"
+#include "TimerWheel.h"
+
+// The wheel has LEVEL_COUNT levels of SLOT_COUNT slots, each slot of a level spanning all the slots of the level below.
+#define LEVEL_COUNT 4
+#define SLOT_BITS 8
+#define SLOT_COUNT (1 << SLOT_BITS)
+#define SLOT_MASK (SLOT_COUNT - 1)
+
+// Event ids hold the index of the record in the low bits and the generation of the record in the high bits.
+#define INDEX_BITS 20
+#define INDEX_MASK ((1 << INDEX_BITS) - 1)
+#define GENERATION_MASK ((1 << (32 - INDEX_BITS)) - 1)
+
+// Events are never scheduled further than this many milliseconds ahead; later events are re-scheduled when they come up.
+#define MAX_TICK_DELTA 0x7FFFFFFF
+
+#define RECORD_FREE 0
+#define RECORD_SCHEDULED 1
+#define RECORD_DUE 2
+
+namespace gameplay
+{
+
+static unsigned int toTick(double time)
+{
+    // Ticks are milliseconds, wrapping around every 2^32 milliseconds.
+    return (unsigned int)(time - floor(time / 4294967296.0) * 4294967296.0);
+}
+
+static unsigned int toId(unsigned int index, unsigned int generation)
+{
+    return ((generation & GENERATION_MASK) << INDEX_BITS) | (index + 1);
+}
+
+struct TimerWheel::DueOrder
+{
+    DueOrder(const std::vector<Record>& records) : records(records)
+    {
+    }
+
+    bool operator()(unsigned int a, unsigned int b) const
+    {
+        const Record& ra = records[(a & INDEX_MASK) - 1];
+        const Record& rb = records[(b & INDEX_MASK) - 1];
+        if (ra.time != rb.time)
+            return ra.time < rb.time;
+
+        // Sequence numbers wrap around, so compare their distance.
+        return (int)(ra.sequence - rb.sequence) < 0;
+    }
+
+    const std::vector<Record>& records;
+};
+
+TimerWheel::TimerWheel() : _currentTick(0), _nextSequence(0), _eventCount(0), _started(false)
+{
+    for (unsigned int level = 0; level < LEVEL_COUNT; ++level)
+    {
+        for (unsigned int slot = 0; slot < SLOT_COUNT; ++slot)
+        {
+            _slots[level][slot] = -1;
+        }
+    }
+}
+
+TimerWheel::~TimerWheel()
+{
+}
+
+unsigned int TimerWheel::schedule(double currentTime, double time, TimeListener* listener, void* cookie)
+{
+    if (!_started)
+    {
+        _currentTick = toTick(floor(currentTime));
+        _started = true;
+    }
+
+    int index;
+    if (_freeRecords.empty())
+    {
+        if (_records.size() >= INDEX_MASK)
+        {
+            GP_ERROR("Failed to schedule time event; too many time events are pending.");
+            return 0;
+        }
+        index = (int)_records.size();
+        _records.push_back(Record());
+        _records[index].generation = 0;
+    }
+    else
+    {
+        index = _freeRecords.back();
+        _freeRecords.pop_back();
+    }
+
+    Record& record = _records[index];
+    record.time = time;
+    record.listener = listener;
+    record.cookie = cookie;
+    record.sequence = _nextSequence++;
+    record.state = RECORD_SCHEDULED;
+
+    // Events that are already due fire on the next advance.
+    unsigned int tick = toTick(ceil(time));
+    int delta = (int)(tick - _currentTick);
+    if (delta <= 0)
+        tick = _currentTick + 1;
+    else if ((unsigned int)delta > MAX_TICK_DELTA)
+        tick = _currentTick + MAX_TICK_DELTA;
+    record.tick = tick;
+
+    insert(index);
+    ++_eventCount;
+
+    return toId(index, record.generation);
+}
+
+bool TimerWheel::cancel(unsigned int id)
+{
+    unsigned int index = (id & INDEX_MASK);
+    if (index == 0 || index > _records.size())
+        return false;
+    --index;
+
+    Record& record = _records[index];
+    if (record.state == RECORD_FREE || toId(index, record.generation) != id)
+        return false;
+
+    if (record.state == RECORD_SCHEDULED)
+    {
+        unlink(index);
+        --_eventCount;
+    }
+    release(index);
+    return true;
+}
+
+void TimerWheel::cancel(TimeListener* listener)
+{
+    for (unsigned int i = 0; i < _records.size(); ++i)
+    {
+        Record& record = _records[i];
+        if (record.state != RECORD_FREE && record.listener == listener)
+        {
+            cancel(toId(i, record.generation));
+        }
+    }
+}
+
+unsigned int TimerWheel::advance(double time)
+{
+    _due.clear();
+    if (!_started)
+        return 0;
+
+    unsigned int targetTick = toTick(floor(time));
+    while ((int)(targetTick - _currentTick) > 0)
+    {
+        // Nothing can expire, so skip straight to the target.
+        if (_eventCount == 0)
+        {
+            _currentTick = targetTick;
+            break;
+        }
+
+        ++_currentTick;
+
+        // When the lowest level wraps around, move the events of the next slot
+        // of each higher level down, for as long as the levels wrap around.
+        unsigned int slot = _currentTick & SLOT_MASK;
+        if (slot == 0)
+        {
+            for (unsigned int level = 1; level < LEVEL_COUNT; ++level)
+            {
+                unsigned int levelSlot = (_currentTick >> (level * SLOT_BITS)) & SLOT_MASK;
+                cascade(level, levelSlot);
+                if (levelSlot != 0)
+                    break;
+            }
+        }
+
+        // Expire the whole slot of this tick at once.
+        int index = _slots[0][slot];
+        _slots[0][slot] = -1;
+        while (index >= 0)
+        {
+            Record& record = _records[index];
+            int next = record.next;
+            if (record.time > time)
+            {
+                // Events further ahead than the wheel spans come up early and are re-scheduled.
+                unsigned int tick = toTick(ceil(record.time));
+                unsigned int delta = tick - _currentTick;
+                record.tick = _currentTick + (delta > MAX_TICK_DELTA ? MAX_TICK_DELTA : delta);
+                insert(index);
+            }
+            else
+            {
+                record.state = RECORD_DUE;
+                --_eventCount;
+                _due.push_back(toId(index, record.generation));
+            }
+            index = next;
+        }
+    }
+
+    if (_due.size() > 1)
+    {
+        std::sort(_due.begin(), _due.end(), DueOrder(_records));
+    }
+    return _due.size();
+}
+
+bool TimerWheel::expire(unsigned int index, Event* event)
+{
+    GP_ASSERT(index < _due.size());
+    GP_ASSERT(event);
+
+    unsigned int id = _due[index];
+    unsigned int recordIndex = (id & INDEX_MASK) - 1;
+    Record& record = _records[recordIndex];
+
+    // The event was cancelled since it became due.
+    if (record.state != RECORD_DUE || toId(recordIndex, record.generation) != id)
+        return false;
+
+    event->time = record.time;
+    event->listener = record.listener;
+    event->cookie = record.cookie;
+    release(recordIndex);
+    return true;
+}
+
+unsigned int TimerWheel::getEventCount() const
+{
+    return _eventCount;
+}
+
+void TimerWheel::insert(int index)
+{
+    Record& record = _records[index];
+    unsigned int delta = record.tick - _currentTick;
+
+    unsigned int level = 0;
+    while (level < LEVEL_COUNT - 1 && delta >= (1u << ((level + 1) * SLOT_BITS)))
+    {
+        ++level;
+    }
+    record.slot = level * SLOT_COUNT + ((record.tick >> (level * SLOT_BITS)) & SLOT_MASK);
+
+    int* slot = &_slots[0][0] + record.slot;
+    record.prev = -1;
+    record.next = *slot;
+    if (*slot >= 0)
+        _records[*slot].prev = index;
+    *slot = index;
+}
+
+void TimerWheel::unlink(int index)
+{
+    Record& record = _records[index];
+    if (record.prev >= 0)
+    {
+        _records[record.prev].next = record.next;
+    }
+    else
+    {
+        int* slot = &_slots[0][0] + record.slot;
+        GP_ASSERT(*slot == index);
+        *slot = record.next;
+    }
+    if (record.next >= 0)
+    {
+        _records[record.next].prev = record.prev;
+    }
+    record.prev = -1;
+    record.next = -1;
+}
+
+void TimerWheel::release(int index)
+{
+    Record& record = _records[index];
+    record.state = RECORD_FREE;
+    record.listener = NULL;
+    record.cookie = NULL;
+    ++record.generation;
+    _freeRecords.push_back(index);
+}
+
+void TimerWheel::cascade(unsigned int level, unsigned int slot)
+{
+    int index = _slots[level][slot];
+    _slots[level][slot] = -1;
+    while (index >= 0)
+    {
+        int next = _records[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+}
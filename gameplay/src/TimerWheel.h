@@ -0,0 +1,155 @@
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include "TimeListener.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a hierarchical timer wheel that holds the time events scheduled with Game::schedule.
+ *
+ * Events are bucketed by the millisecond they are due in, across four levels of 256 slots
+ * each, so scheduling and cancelling an event are constant time regardless of how many
+ * events are pending. Advancing the wheel expires the due events of every millisecond that
+ * has passed as one batch, cascading the events of the higher levels down as their slots
+ * come up. Event records are pooled and referred to by ids, which stay unique for as long
+ * as a record may be reused, so that stale ids can safely be cancelled.
+ *
+ * Since events are bucketed by millisecond, an event fires in the first update whose time
+ * is at least the event time rounded up to the next millisecond.
+ *
+ * @script{ignore}
+ */
+class TimerWheel
+{
+    friend class Game;
+
+public:
+
+    /**
+     * A due time event.
+     */
+    struct Event
+    {
+        double time;
+        TimeListener* listener;
+        void* cookie;
+    };
+
+private:
+
+    /**
+     * A pooled time event record.
+     */
+    struct Record
+    {
+        double time;
+        TimeListener* listener;
+        void* cookie;
+        unsigned int tick;
+        unsigned int sequence;
+        unsigned int generation;
+        unsigned int slot;
+        int prev;
+        int next;
+        unsigned char state;
+    };
+
+    /**
+     * Constructor.
+     */
+    TimerWheel();
+
+    /**
+     * Hidden copy constructor.
+     */
+    TimerWheel(const TimerWheel& copy);
+
+    /**
+     * Destructor.
+     */
+    ~TimerWheel();
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    TimerWheel& operator=(const TimerWheel&);
+
+    /**
+     * Schedules a time event.
+     *
+     * @param currentTime The current time (in milliseconds).
+     * @param time The time to fire the event at (in milliseconds).
+     * @param listener The TimeListener that will receive the event.
+     * @param cookie The cookie data that the time event will contain.
+     *
+     * @return The id of the event, or zero if it could not be scheduled.
+     */
+    unsigned int schedule(double currentTime, double time, TimeListener* listener, void* cookie);
+
+    /**
+     * Cancels a scheduled time event that has not been fired yet.
+     *
+     * @param id The id of the event returned by TimerWheel::schedule.
+     *
+     * @return true if the event was cancelled, false if it was already fired or cancelled.
+     */
+    bool cancel(unsigned int id);
+
+    /**
+     * Cancels all the scheduled time events of a listener.
+     *
+     * @param listener The listener.
+     */
+    void cancel(TimeListener* listener);
+
+    /**
+     * Advances the wheel, collecting the events that are due at the given time.
+     *
+     * The due events are ordered by time, then by the order they were scheduled in,
+     * and must be retrieved with TimerWheel::expire before the wheel is advanced again.
+     *
+     * @param time The current time (in milliseconds).
+     *
+     * @return The number of due events.
+     */
+    unsigned int advance(double time);
+
+    /**
+     * Retrieves and releases a due event collected by the last TimerWheel::advance.
+     *
+     * @param index The index of the due event, less than the count returned by TimerWheel::advance.
+     * @param event Populated with the due event.
+     *
+     * @return true if the event should be fired, false if it was cancelled since it became due.
+     */
+    bool expire(unsigned int index, Event* event);
+
+    /**
+     * Gets the number of scheduled events that have not yet been fired or cancelled.
+     *
+     * @return The number of pending events.
+     */
+    unsigned int getEventCount() const;
+
+    void insert(int index);
+    void unlink(int index);
+    void release(int index);
+    void cascade(unsigned int level, unsigned int slot);
+
+    struct DueOrder;
+
+    std::vector<Record> _records;
+    std::vector<int> _freeRecords;
+    std::vector<unsigned int> _due;
+    int _slots[4][256];
+    unsigned int _currentTick;
+    unsigned int _nextSequence;
+    unsigned int _eventCount;
+    bool _started;
+};
+
+}
+
+#endif
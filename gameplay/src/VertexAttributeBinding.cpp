@@ -2,12 +2,14 @@
 #include "VertexAttributeBinding.h"
 #include "Mesh.h"
 #include "Effect.h"
+#include "SpinLock.h"
 
 namespace gameplay
 {
 
 static GLuint __maxVertexAttribs = 0;
 static std::vector<VertexAttributeBinding*> __vertexAttributeBindingCache;
+static SpinLock __vertexAttributeBindingCacheLock;
 
 VertexAttributeBinding::VertexAttributeBinding() :
     _handle(0), _attributes(NULL), _mesh(NULL), _effect(NULL)
@@ -17,11 +19,13 @@ VertexAttributeBinding::VertexAttributeBinding() :
 VertexAttributeBinding::~VertexAttributeBinding()
 {
     // Delete from the vertex attribute binding cache.
+    __vertexAttributeBindingCacheLock.lock();
     std::vector<VertexAttributeBinding*>::iterator itr = std::find(__vertexAttributeBindingCache.begin(), __vertexAttributeBindingCache.end(), this);
     if (itr != __vertexAttributeBindingCache.end())
     {
         __vertexAttributeBindingCache.erase(itr);
     }
+    __vertexAttributeBindingCacheLock.unlock();
 
     SAFE_RELEASE(_mesh);
     SAFE_RELEASE(_effect);
@@ -38,17 +42,20 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, Effect* effec
 {
     GP_ASSERT(mesh);
 
-    // Search for an existing vertex attribute binding that can be used.
+    // Search for an existing vertex attribute binding that can be used,
+    // skipping bindings that are being destroyed by another thread.
     VertexAttributeBinding* b;
-    for (unsigned int i = 0, count = __vertexAttributeBindingCache.size(); i < count; ++i)
     {
-        b = __vertexAttributeBindingCache[i];
-        GP_ASSERT(b);
-        if (b->_mesh == mesh && b->_effect == effect)
+        SpinLock::ScopedLock lock(__vertexAttributeBindingCacheLock);
+        for (unsigned int i = 0, count = __vertexAttributeBindingCache.size(); i < count; ++i)
         {
-            // Found a match!
-            b->addRef();
-            return b;
+            b = __vertexAttributeBindingCache[i];
+            GP_ASSERT(b);
+            if (b->_mesh == mesh && b->_effect == effect && b->tryAddRef())
+            {
+                // Found a match!
+                return b;
+            }
         }
     }
 
@@ -57,6 +64,7 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, Effect* effec
     // Add the new vertex attribute binding to the cache.
     if (b)
     {
+        SpinLock::ScopedLock lock(__vertexAttributeBindingCacheLock);
         __vertexAttributeBindingCache.push_back(b);
     }
 
@@ -204,10 +212,12 @@ VertexAttributeBinding* VertexAttributeBinding::create(Mesh* mesh, const VertexF
         else
         {
             void* pointer = vertexPointer ? (void*)(((unsigned char*)vertexPointer) + offset) : (void*)offset;
-            b->setVertexAttribPointer(attrib, (GLint)e.size, GL_FLOAT, GL_FALSE, (GLsizei)vertexFormat.getVertexSize(), pointer);
+            GLboolean normalized;
+            GLenum type = VertexFormat::getGLType(e.type, &normalized);
+            b->setVertexAttribPointer(attrib, (GLint)e.size, type, normalized, (GLsizei)vertexFormat.getVertexSize(), pointer);
         }
 
-        offset += e.size * sizeof(float);
+        offset += e.getByteSize();
     }
 
     if (b->_handle)
@@ -4,6 +4,44 @@
 namespace gameplay
 {
 
+// Whether the driver supports the vertex element types that need GL 3 or an extension, once a context exists.
+static bool __typeSupportQueried = false;
+static bool __halfFloatSupported = false;
+static bool __packedSupported = false;
+
+/**
+ * Converts a 16-bit float to a float.
+ */
+static float halfToFloat(unsigned short half)
+{
+    unsigned int sign = (unsigned int)(half & 0x8000) << 16;
+    unsigned int exponent = (half >> 10) & 0x1f;
+    unsigned int mantissa = half & 0x3ff;
+    unsigned int bits;
+    if (exponent == 0x1f)
+    {
+        // Infinity or NaN.
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else if (mantissa != 0)
+    {
+        // Denormal, which is 2^-24 times the mantissa.
+        float value = (float)mantissa * (1.0f / 16777216.0f);
+        return sign ? -value : value;
+    }
+    else
+    {
+        bits = sign;
+    }
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
 VertexFormat::VertexFormat(const Element* elements, unsigned int elementCount)
     : _vertexSize(0)
 {
@@ -17,7 +55,7 @@ VertexFormat::VertexFormat(const Element* elements, unsigned int elementCount)
         memcpy(&element, &elements[i], sizeof(Element));
         _elements.push_back(element);
 
-        _vertexSize += element.size * sizeof(float);
+        _vertexSize += element.getByteSize();
     }
 }
 
@@ -62,18 +100,41 @@ bool VertexFormat::operator != (const VertexFormat& f) const
 }
 
 VertexFormat::Element::Element() :
-    usage(POSITION), size(0)
+    usage(POSITION), size(0), type(FLOAT)
 {
 }
 
 VertexFormat::Element::Element(Usage usage, unsigned int size) :
-    usage(usage), size(size)
+    usage(usage), size(size), type(FLOAT)
 {
 }
 
+VertexFormat::Element::Element(Usage usage, unsigned int size, Type type) :
+    usage(usage), size(size), type(type)
+{
+    GP_ASSERT(type != SNORM10_10_10_2 || size == 4);
+}
+
+unsigned int VertexFormat::Element::getByteSize() const
+{
+    switch (type)
+    {
+    case HALF_FLOAT:
+        return size * 2;
+    case SNORM8:
+    case UNORM8:
+    case UINT8:
+        return size;
+    case SNORM10_10_10_2:
+        return 4;
+    default:
+        return size * sizeof(float);
+    }
+}
+
 bool VertexFormat::Element::operator == (const VertexFormat::Element& e) const
 {
-    return (size == e.size && usage == e.usage);
+    return (size == e.size && usage == e.usage && type == e.type);
 }
 
 bool VertexFormat::Element::operator != (const VertexFormat::Element& e) const
@@ -120,4 +181,125 @@ const char* VertexFormat::toString(Usage usage)
     }
 }
 
+bool VertexFormat::isTypeSupported(Type type)
+{
+    switch (type)
+    {
+    case HALF_FLOAT:
+    case SNORM10_10_10_2:
+        break;
+    default:
+        return true;
+    }
+
+    if (!__typeSupportQueried)
+    {
+        const char* version = (const char*)glGetString(GL_VERSION);
+        const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+        if (version == NULL || extensions == NULL)
+        {
+            // No context is current on this thread, so assume the types are not supported and ask again later.
+            return false;
+        }
+#ifdef OPENGL_ES
+        __halfFloatSupported = strstr(extensions, "GL_OES_vertex_half_float") != NULL;
+        // GL_OES_vertex_type_10_10_10_2 packs the values in the opposite order, so it is not used.
+        __packedSupported = false;
+#else
+        int major = 0;
+        int minor = 0;
+        sscanf(version, "%d.%d", &major, &minor);
+        __halfFloatSupported = major >= 3 || strstr(extensions, "GL_ARB_half_float_vertex") != NULL;
+        __packedSupported = major > 3 || (major == 3 && minor >= 3) || strstr(extensions, "GL_ARB_vertex_type_2_10_10_10_rev") != NULL;
+#endif
+        __typeSupportQueried = true;
+    }
+    return type == HALF_FLOAT ? __halfFloatSupported : __packedSupported;
+}
+
+GLenum VertexFormat::getGLType(Type type, GLboolean* normalized)
+{
+    GP_ASSERT(normalized);
+
+    switch (type)
+    {
+    case HALF_FLOAT:
+        *normalized = GL_FALSE;
+        return GL_HALF_FLOAT;
+    case SNORM8:
+        *normalized = GL_TRUE;
+        return GL_BYTE;
+    case UNORM8:
+        *normalized = GL_TRUE;
+        return GL_UNSIGNED_BYTE;
+    case UINT8:
+        *normalized = GL_FALSE;
+        return GL_UNSIGNED_BYTE;
+    case SNORM10_10_10_2:
+        *normalized = GL_TRUE;
+        return GL_INT_2_10_10_10_REV;
+    default:
+        *normalized = GL_FALSE;
+        return GL_FLOAT;
+    }
+}
+
+void VertexFormat::unpack(const Element& element, const void* data, float* values)
+{
+    GP_ASSERT(data);
+    GP_ASSERT(values);
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    switch (element.type)
+    {
+    case HALF_FLOAT:
+        for (unsigned int i = 0; i < element.size; ++i)
+        {
+            unsigned short half;
+            memcpy(&half, bytes + i * 2, sizeof(half));
+            values[i] = halfToFloat(half);
+        }
+        break;
+    case SNORM8:
+        for (unsigned int i = 0; i < element.size; ++i)
+        {
+            values[i] = std::max((float)(signed char)bytes[i] / 127.0f, -1.0f);
+        }
+        break;
+    case UNORM8:
+        for (unsigned int i = 0; i < element.size; ++i)
+        {
+            values[i] = (float)bytes[i] / 255.0f;
+        }
+        break;
+    case UINT8:
+        for (unsigned int i = 0; i < element.size; ++i)
+        {
+            values[i] = (float)bytes[i];
+        }
+        break;
+    case SNORM10_10_10_2:
+        {
+            unsigned int packed;
+            memcpy(&packed, bytes, sizeof(packed));
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                // Sign extend each 10-bit value.
+                int value = (int)((packed >> (i * 10)) & 0x3ff);
+                if (value & 0x200)
+                    value -= 0x400;
+                values[i] = std::max((float)value / 511.0f, -1.0f);
+            }
+            int w = (int)(packed >> 30);
+            if (w & 0x2)
+                w -= 0x4;
+            values[3] = std::max((float)w, -1.0f);
+        }
+        break;
+    default:
+        memcpy(values, bytes, element.size * sizeof(float));
+        break;
+    }
+}
+
 }
@@ -36,13 +36,33 @@ public:
         TEXCOORD7 = 15
     };
 
+    /**
+     * Defines the types that the values of a vertex element are stored as.
+     *
+     * The values of all types are passed to shaders as floats.
+     */
+    enum Type
+    {
+        /** 32-bit floats. */
+        FLOAT = 0,
+        /** 16-bit floats. */
+        HALF_FLOAT = 1,
+        /** Signed bytes, normalized to [-1, 1]. */
+        SNORM8 = 2,
+        /** Unsigned bytes, normalized to [0, 1]. */
+        UNORM8 = 3,
+        /** Unsigned bytes, passed as their integer value. */
+        UINT8 = 4,
+        /** Three signed 10-bit values and a signed 2-bit value packed in 32 bits, normalized to [-1, 1]. The size must be 4. */
+        SNORM10_10_10_2 = 5
+    };
+
     /**
      * Defines a single element within a vertex format.
      *
-     * All vertex elements are assumed to be of type float, but can
-     * have a varying number of float values (1-4), which is represented
-     * by the size attribute. Additionally, vertex elements are assumed
-     * to be tightly packed.
+     * Vertex elements have a varying number of values (1-4), which is
+     * represented by the size attribute, stored as the type attribute.
+     * Additionally, vertex elements are assumed to be tightly packed.
      */
     class Element
     {
@@ -57,6 +77,11 @@ public:
          */
         unsigned int size;
 
+        /**
+         * The type that the values of the vertex element are stored as.
+         */
+        Type type;
+
         /**
          * Constructor.
          */
@@ -70,6 +95,20 @@ public:
          */
         Element(Usage usage, unsigned int size);
 
+        /**
+         * Constructor.
+         *
+         * @param usage The vertex element usage semantic.
+         * @param size The number of values in the vertex element.
+         * @param type The type that the values are stored as.
+         */
+        Element(Usage usage, unsigned int size, Type type);
+
+        /**
+         * Gets the size (in bytes) of this element within a vertex.
+         */
+        unsigned int getByteSize() const;
+
         /**
          * Compares two vertex elements for equality.
          *
@@ -146,6 +185,36 @@ public:
      */
     static const char* toString(Usage usage);
 
+    /**
+     * Determines if the current graphics driver can read vertex elements of the given type.
+     *
+     * Elements of unsupported types must be converted to floats, which Bundle does when it loads meshes.
+     *
+     * @param type The type to check.
+     *
+     * @return true if the type is supported, false otherwise.
+     */
+    static bool isTypeSupported(Type type);
+
+    /**
+     * Gets the GL type and normalization of a vertex element type, for glVertexAttribPointer.
+     *
+     * @param type The vertex element type.
+     * @param normalized Set to whether the values are normalized.
+     *
+     * @return The GL type.
+     */
+    static GLenum getGLType(Type type, GLboolean* normalized);
+
+    /**
+     * Reads the values of a vertex element from vertex data as floats.
+     *
+     * @param element The vertex element.
+     * @param data A pointer to the element within the vertex data.
+     * @param values Set to the element.size values of the element.
+     */
+    static void unpack(const Element& element, const void* data, float* values);
+
 private:
 
     std::vector<Element> _elements;
@@ -0,0 +1,21 @@
+#if defined(GP_PLATFORM_HEADLESS) || (defined(__linux__) && !defined(__ANDROID__))
+
+#include "gameplay.h"
+
+using namespace gameplay;
+
+/**
+ * Main entry point.
+ */
+int main(int argc, char** argv)
+{
+    Game* game = Game::getInstance();
+    Platform* platform = Platform::create(game);
+    if (!platform)
+        return 1;
+    int result = platform->enterMessagePump();
+    delete platform;
+    return result;
+}
+
+#endif
@@ -1,4 +1,4 @@
-#ifdef __APPLE__
+#if defined(__APPLE__) && !defined(GP_PLATFORM_HEADLESS)
 
 #import <Foundation/Foundation.h>
 #include "gameplay.h"
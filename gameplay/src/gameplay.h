@@ -8,6 +8,17 @@
 #include "FileSystem.h"
 #include "Bundle.h"
 #include "Gamepad.h"
+#include "Thread.h"
+#include "Mutex.h"
+#include "Semaphore.h"
+#include "SpinLock.h"
+#include "Atomic.h"
+#include "MemoryTracker.h"
+#include "FrameArena.h"
+#include "MemoryStats.h"
+#include "InputRecorder.h"
+#include "LoadTrace.h"
+#include "FrameGovernor.h"
 
 // Math
 #include "Rectangle.h"
@@ -37,6 +48,7 @@
 #include "Camera.h"
 #include "Light.h"
 #include "Scene.h"
+#include "SceneStreamer.h"
 #include "Node.h"
 #include "Joint.h"
 #include "Font.h"
@@ -45,6 +57,9 @@
 #include "FrameBuffer.h"
 #include "RenderTarget.h"
 #include "DepthStencilTarget.h"
+#include "RenderTargetPool.h"
+#include "RenderStats.h"
+#include "GLCapture.h"
 #include "ScreenDisplayer.h"
 
 // Audio
@@ -0,0 +1,31 @@
+#ifndef LUA_FRAMEGOVERNOR_H_
+#define LUA_FRAMEGOVERNOR_H_
+
+namespace gameplay
+{
+
+// Lua bindings for FrameGovernor.
+int lua_FrameGovernor_getDegradeFrames(lua_State* state);
+int lua_FrameGovernor_getFrameTime(lua_State* state);
+int lua_FrameGovernor_getMaxQualityLevel(lua_State* state);
+int lua_FrameGovernor_getQualityLevel(lua_State* state);
+int lua_FrameGovernor_getQualityScale(lua_State* state);
+int lua_FrameGovernor_getRestoreFrames(lua_State* state);
+int lua_FrameGovernor_getSubsystemTime(lua_State* state);
+int lua_FrameGovernor_getTargetFrameTime(lua_State* state);
+int lua_FrameGovernor_getUpdateInterval(lua_State* state);
+int lua_FrameGovernor_isEnabled(lua_State* state);
+int lua_FrameGovernor_isGoverned(lua_State* state);
+int lua_FrameGovernor_reset(lua_State* state);
+int lua_FrameGovernor_setEnabled(lua_State* state);
+int lua_FrameGovernor_setGoverned(lua_State* state);
+int lua_FrameGovernor_setHysteresis(lua_State* state);
+int lua_FrameGovernor_setMaxQualityLevel(lua_State* state);
+int lua_FrameGovernor_setQualityLevel(lua_State* state);
+int lua_FrameGovernor_setTargetFrameTime(lua_State* state);
+
+void luaRegister_FrameGovernor();
+
+}
+
+#endif
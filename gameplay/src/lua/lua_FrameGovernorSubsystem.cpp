@@ -0,0 +1,57 @@
+#include "Base.h"
+#include "lua_FrameGovernorSubsystem.h"
+
+namespace gameplay
+{
+
+static const char* enumStringEmpty = "";
+
+static const char* luaEnumString_FrameGovernorSubsystem_ANIMATION = "ANIMATION";
+static const char* luaEnumString_FrameGovernorSubsystem_PHYSICS = "PHYSICS";
+static const char* luaEnumString_FrameGovernorSubsystem_AI = "AI";
+static const char* luaEnumString_FrameGovernorSubsystem_SCRIPT = "SCRIPT";
+static const char* luaEnumString_FrameGovernorSubsystem_PARTICLES = "PARTICLES";
+static const char* luaEnumString_FrameGovernorSubsystem_RENDERING = "RENDERING";
+static const char* luaEnumString_FrameGovernorSubsystem_SUBSYSTEM_COUNT = "SUBSYSTEM_COUNT";
+
+FrameGovernor::Subsystem lua_enumFromString_FrameGovernorSubsystem(const char* s)
+{
+    if (strcmp(s, luaEnumString_FrameGovernorSubsystem_ANIMATION) == 0)
+        return FrameGovernor::ANIMATION;
+    if (strcmp(s, luaEnumString_FrameGovernorSubsystem_PHYSICS) == 0)
+        return FrameGovernor::PHYSICS;
+    if (strcmp(s, luaEnumString_FrameGovernorSubsystem_AI) == 0)
+        return FrameGovernor::AI;
+    if (strcmp(s, luaEnumString_FrameGovernorSubsystem_SCRIPT) == 0)
+        return FrameGovernor::SCRIPT;
+    if (strcmp(s, luaEnumString_FrameGovernorSubsystem_PARTICLES) == 0)
+        return FrameGovernor::PARTICLES;
+    if (strcmp(s, luaEnumString_FrameGovernorSubsystem_RENDERING) == 0)
+        return FrameGovernor::RENDERING;
+    if (strcmp(s, luaEnumString_FrameGovernorSubsystem_SUBSYSTEM_COUNT) == 0)
+        return FrameGovernor::SUBSYSTEM_COUNT;
+    GP_ERROR("Invalid enumeration value '%s' for enumeration FrameGovernor::Subsystem.", s);
+    return FrameGovernor::ANIMATION;
+}
+
+const char* lua_stringFromEnum_FrameGovernorSubsystem(FrameGovernor::Subsystem e)
+{
+    if (e == FrameGovernor::ANIMATION)
+        return luaEnumString_FrameGovernorSubsystem_ANIMATION;
+    if (e == FrameGovernor::PHYSICS)
+        return luaEnumString_FrameGovernorSubsystem_PHYSICS;
+    if (e == FrameGovernor::AI)
+        return luaEnumString_FrameGovernorSubsystem_AI;
+    if (e == FrameGovernor::SCRIPT)
+        return luaEnumString_FrameGovernorSubsystem_SCRIPT;
+    if (e == FrameGovernor::PARTICLES)
+        return luaEnumString_FrameGovernorSubsystem_PARTICLES;
+    if (e == FrameGovernor::RENDERING)
+        return luaEnumString_FrameGovernorSubsystem_RENDERING;
+    if (e == FrameGovernor::SUBSYSTEM_COUNT)
+        return luaEnumString_FrameGovernorSubsystem_SUBSYSTEM_COUNT;
+    GP_ERROR("Invalid enumeration value '%d' for enumeration FrameGovernor::Subsystem.", e);
+    return enumStringEmpty;
+}
+
+}
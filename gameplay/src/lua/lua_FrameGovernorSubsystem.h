@@ -0,0 +1,15 @@
+#ifndef LUA_FRAMEGOVERNORSUBSYSTEM_H_
+#define LUA_FRAMEGOVERNORSUBSYSTEM_H_
+
+#include "FrameGovernor.h"
+
+namespace gameplay
+{
+
+// Lua bindings for enum conversion functions for FrameGovernor::Subsystem.
+FrameGovernor::Subsystem lua_enumFromString_FrameGovernorSubsystem(const char* s);
+const char* lua_stringFromEnum_FrameGovernorSubsystem(FrameGovernor::Subsystem e);
+
+}
+
+#endif
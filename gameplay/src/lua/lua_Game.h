@@ -17,10 +17,16 @@ int lua_Game_getAnimationController(lua_State* state);
 int lua_Game_getAudioController(lua_State* state);
 int lua_Game_getAudioListener(lua_State* state);
 int lua_Game_getConfig(lua_State* state);
+int lua_Game_getFixedUpdateRate(lua_State* state);
+int lua_Game_getFrameGovernor(lua_State* state);
+int lua_Game_getFrameInterpolation(lua_State* state);
 int lua_Game_getFrameRate(lua_State* state);
+int lua_Game_getFrameUpdateCount(lua_State* state);
 int lua_Game_getGamepad(lua_State* state);
 int lua_Game_getGamepadCount(lua_State* state);
 int lua_Game_getHeight(lua_State* state);
+int lua_Game_getMaxUpdatesPerFrame(lua_State* state);
+int lua_Game_getPhaseTime(lua_State* state);
 int lua_Game_getPhysicsController(lua_State* state);
 int lua_Game_getScriptController(lua_State* state);
 int lua_Game_getState(lua_State* state);
@@ -31,6 +37,7 @@ int lua_Game_isCursorVisible(lua_State* state);
 int lua_Game_isInitialized(lua_State* state);
 int lua_Game_isMouseCaptured(lua_State* state);
 int lua_Game_isMultiTouch(lua_State* state);
+int lua_Game_isPipelined(lua_State* state);
 int lua_Game_keyEvent(lua_State* state);
 int lua_Game_menuEvent(lua_State* state);
 int lua_Game_mouseEvent(lua_State* state);
@@ -39,15 +46,21 @@ int lua_Game_resume(lua_State* state);
 int lua_Game_run(lua_State* state);
 int lua_Game_schedule(lua_State* state);
 int lua_Game_setCursorVisible(lua_State* state);
+int lua_Game_setFixedUpdateRate(lua_State* state);
+int lua_Game_setMemoryStatsDump(lua_State* state);
 int lua_Game_setMouseCaptured(lua_State* state);
 int lua_Game_setMultiTouch(lua_State* state);
+int lua_Game_setPipelined(lua_State* state);
 int lua_Game_setViewport(lua_State* state);
 int lua_Game_static_getAbsoluteTime(lua_State* state);
+int lua_Game_static_getClockStep(lua_State* state);
 int lua_Game_static_getGameTime(lua_State* state);
 int lua_Game_static_getInstance(lua_State* state);
 int lua_Game_static_isVsync(lua_State* state);
+int lua_Game_static_setClockStep(lua_State* state);
 int lua_Game_static_setVsync(lua_State* state);
 int lua_Game_touchEvent(lua_State* state);
+int lua_Game_unschedule(lua_State* state);
 
 void luaRegister_Game();
 
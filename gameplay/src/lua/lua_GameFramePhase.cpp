@@ -0,0 +1,72 @@
+#include "Base.h"
+#include "lua_GameFramePhase.h"
+
+namespace gameplay
+{
+
+static const char* enumStringEmpty = "";
+
+static const char* luaEnumString_GameFramePhase_PHASE_ANIMATION = "PHASE_ANIMATION";
+static const char* luaEnumString_GameFramePhase_PHASE_TIME_EVENTS = "PHASE_TIME_EVENTS";
+static const char* luaEnumString_GameFramePhase_PHASE_PHYSICS = "PHASE_PHYSICS";
+static const char* luaEnumString_GameFramePhase_PHASE_AI = "PHASE_AI";
+static const char* luaEnumString_GameFramePhase_PHASE_UPDATE = "PHASE_UPDATE";
+static const char* luaEnumString_GameFramePhase_PHASE_SCRIPT_UPDATE = "PHASE_SCRIPT_UPDATE";
+static const char* luaEnumString_GameFramePhase_PHASE_AUDIO = "PHASE_AUDIO";
+static const char* luaEnumString_GameFramePhase_PHASE_RENDER = "PHASE_RENDER";
+static const char* luaEnumString_GameFramePhase_PHASE_SCRIPT_RENDER = "PHASE_SCRIPT_RENDER";
+static const char* luaEnumString_GameFramePhase_PHASE_COUNT = "PHASE_COUNT";
+
+Game::FramePhase lua_enumFromString_GameFramePhase(const char* s)
+{
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_ANIMATION) == 0)
+        return Game::PHASE_ANIMATION;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_TIME_EVENTS) == 0)
+        return Game::PHASE_TIME_EVENTS;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_PHYSICS) == 0)
+        return Game::PHASE_PHYSICS;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_AI) == 0)
+        return Game::PHASE_AI;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_UPDATE) == 0)
+        return Game::PHASE_UPDATE;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_SCRIPT_UPDATE) == 0)
+        return Game::PHASE_SCRIPT_UPDATE;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_AUDIO) == 0)
+        return Game::PHASE_AUDIO;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_RENDER) == 0)
+        return Game::PHASE_RENDER;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_SCRIPT_RENDER) == 0)
+        return Game::PHASE_SCRIPT_RENDER;
+    if (strcmp(s, luaEnumString_GameFramePhase_PHASE_COUNT) == 0)
+        return Game::PHASE_COUNT;
+    GP_ERROR("Invalid enumeration value '%s' for enumeration Game::FramePhase.", s);
+    return Game::PHASE_ANIMATION;
+}
+
+const char* lua_stringFromEnum_GameFramePhase(Game::FramePhase e)
+{
+    if (e == Game::PHASE_ANIMATION)
+        return luaEnumString_GameFramePhase_PHASE_ANIMATION;
+    if (e == Game::PHASE_TIME_EVENTS)
+        return luaEnumString_GameFramePhase_PHASE_TIME_EVENTS;
+    if (e == Game::PHASE_PHYSICS)
+        return luaEnumString_GameFramePhase_PHASE_PHYSICS;
+    if (e == Game::PHASE_AI)
+        return luaEnumString_GameFramePhase_PHASE_AI;
+    if (e == Game::PHASE_UPDATE)
+        return luaEnumString_GameFramePhase_PHASE_UPDATE;
+    if (e == Game::PHASE_SCRIPT_UPDATE)
+        return luaEnumString_GameFramePhase_PHASE_SCRIPT_UPDATE;
+    if (e == Game::PHASE_AUDIO)
+        return luaEnumString_GameFramePhase_PHASE_AUDIO;
+    if (e == Game::PHASE_RENDER)
+        return luaEnumString_GameFramePhase_PHASE_RENDER;
+    if (e == Game::PHASE_SCRIPT_RENDER)
+        return luaEnumString_GameFramePhase_PHASE_SCRIPT_RENDER;
+    if (e == Game::PHASE_COUNT)
+        return luaEnumString_GameFramePhase_PHASE_COUNT;
+    GP_ERROR("Invalid enumeration value '%d' for enumeration Game::FramePhase.", e);
+    return enumStringEmpty;
+}
+
+}
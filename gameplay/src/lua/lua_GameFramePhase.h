@@ -0,0 +1,15 @@
+#ifndef LUA_GAMEFRAMEPHASE_H_
+#define LUA_GAMEFRAMEPHASE_H_
+
+#include "Game.h"
+
+namespace gameplay
+{
+
+// Lua bindings for enum conversion functions for Game::FramePhase.
+Game::FramePhase lua_enumFromString_GameFramePhase(const char* s);
+const char* lua_stringFromEnum_GameFramePhase(Game::FramePhase e);
+
+}
+
+#endif
@@ -319,6 +319,19 @@ void luaRegister_lua_Global()
         ScriptUtil::registerConstantString("BOLD_ITALIC", "BOLD_ITALIC", scopePath);
     }
 
+    // Register enumeration FrameGovernor::Subsystem.
+    {
+        std::vector<std::string> scopePath;
+        scopePath.push_back("FrameGovernor");
+        ScriptUtil::registerConstantString("ANIMATION", "ANIMATION", scopePath);
+        ScriptUtil::registerConstantString("PHYSICS", "PHYSICS", scopePath);
+        ScriptUtil::registerConstantString("AI", "AI", scopePath);
+        ScriptUtil::registerConstantString("SCRIPT", "SCRIPT", scopePath);
+        ScriptUtil::registerConstantString("PARTICLES", "PARTICLES", scopePath);
+        ScriptUtil::registerConstantString("RENDERING", "RENDERING", scopePath);
+        ScriptUtil::registerConstantString("SUBSYSTEM_COUNT", "SUBSYSTEM_COUNT", scopePath);
+    }
+
     // Register enumeration Game::ClearFlags.
     {
         std::vector<std::string> scopePath;
@@ -332,6 +345,22 @@ void luaRegister_lua_Global()
         ScriptUtil::registerConstantString("CLEAR_COLOR_DEPTH_STENCIL", "CLEAR_COLOR_DEPTH_STENCIL", scopePath);
     }
 
+    // Register enumeration Game::FramePhase.
+    {
+        std::vector<std::string> scopePath;
+        scopePath.push_back("Game");
+        ScriptUtil::registerConstantString("PHASE_ANIMATION", "PHASE_ANIMATION", scopePath);
+        ScriptUtil::registerConstantString("PHASE_TIME_EVENTS", "PHASE_TIME_EVENTS", scopePath);
+        ScriptUtil::registerConstantString("PHASE_PHYSICS", "PHASE_PHYSICS", scopePath);
+        ScriptUtil::registerConstantString("PHASE_AI", "PHASE_AI", scopePath);
+        ScriptUtil::registerConstantString("PHASE_UPDATE", "PHASE_UPDATE", scopePath);
+        ScriptUtil::registerConstantString("PHASE_SCRIPT_UPDATE", "PHASE_SCRIPT_UPDATE", scopePath);
+        ScriptUtil::registerConstantString("PHASE_AUDIO", "PHASE_AUDIO", scopePath);
+        ScriptUtil::registerConstantString("PHASE_RENDER", "PHASE_RENDER", scopePath);
+        ScriptUtil::registerConstantString("PHASE_SCRIPT_RENDER", "PHASE_SCRIPT_RENDER", scopePath);
+        ScriptUtil::registerConstantString("PHASE_COUNT", "PHASE_COUNT", scopePath);
+    }
+
     // Register enumeration Game::State.
     {
         std::vector<std::string> scopePath;
@@ -696,6 +725,19 @@ void luaRegister_lua_Global()
         ScriptUtil::registerConstantString("BLEND_SRC_ALPHA_SATURATE", "BLEND_SRC_ALPHA_SATURATE", scopePath);
     }
 
+    // Register enumeration RenderStats::Counter.
+    {
+        std::vector<std::string> scopePath;
+        scopePath.push_back("RenderStats");
+        ScriptUtil::registerConstantString("DRAW_CALLS", "DRAW_CALLS", scopePath);
+        ScriptUtil::registerConstantString("TRIANGLES", "TRIANGLES", scopePath);
+        ScriptUtil::registerConstantString("STATE_CHANGES", "STATE_CHANGES", scopePath);
+        ScriptUtil::registerConstantString("UNIFORM_UPLOADS", "UNIFORM_UPLOADS", scopePath);
+        ScriptUtil::registerConstantString("TEXTURE_BINDS", "TEXTURE_BINDS", scopePath);
+        ScriptUtil::registerConstantString("BATCH_VERTICES", "BATCH_VERTICES", scopePath);
+        ScriptUtil::registerConstantString("COUNTER_COUNT", "COUNTER_COUNT", scopePath);
+    }
+
     // Register enumeration Scene::DebugFlags.
     {
         std::vector<std::string> scopePath;
@@ -742,6 +784,18 @@ void luaRegister_lua_Global()
         ScriptUtil::registerConstantString("TOUCH_MOVE", "TOUCH_MOVE", scopePath);
     }
 
+    // Register enumeration VertexFormat::Type.
+    {
+        std::vector<std::string> scopePath;
+        scopePath.push_back("VertexFormat");
+        ScriptUtil::registerConstantString("FLOAT", "FLOAT", scopePath);
+        ScriptUtil::registerConstantString("HALF_FLOAT", "HALF_FLOAT", scopePath);
+        ScriptUtil::registerConstantString("SNORM8", "SNORM8", scopePath);
+        ScriptUtil::registerConstantString("UNORM8", "UNORM8", scopePath);
+        ScriptUtil::registerConstantString("UINT8", "UINT8", scopePath);
+        ScriptUtil::registerConstantString("SNORM10_10_10_2", "SNORM10_10_10_2", scopePath);
+    }
+
     // Register enumeration VertexFormat::Usage.
     {
         std::vector<std::string> scopePath;
@@ -828,8 +882,12 @@ const char* lua_stringFromEnumGlobal(std::string& enumname, unsigned int value)
         return lua_stringFromEnum_FontJustify((Font::Justify)value);
     if (enumname == "Font::Style")
         return lua_stringFromEnum_FontStyle((Font::Style)value);
+    if (enumname == "FrameGovernor::Subsystem")
+        return lua_stringFromEnum_FrameGovernorSubsystem((FrameGovernor::Subsystem)value);
     if (enumname == "Game::ClearFlags")
         return lua_stringFromEnum_GameClearFlags((Game::ClearFlags)value);
+    if (enumname == "Game::FramePhase")
+        return lua_stringFromEnum_GameFramePhase((Game::FramePhase)value);
     if (enumname == "Game::State")
         return lua_stringFromEnum_GameState((Game::State)value);
     if (enumname == "Gamepad::ButtonState")
@@ -870,6 +928,8 @@ const char* lua_stringFromEnumGlobal(std::string& enumname, unsigned int value)
         return lua_stringFromEnum_RenderStateAutoBinding((RenderState::AutoBinding)value);
     if (enumname == "RenderState::Blend")
         return lua_stringFromEnum_RenderStateBlend((RenderState::Blend)value);
+    if (enumname == "RenderStats::Counter")
+        return lua_stringFromEnum_RenderStatsCounter((RenderStats::Counter)value);
     if (enumname == "Scene::DebugFlags")
         return lua_stringFromEnum_SceneDebugFlags((Scene::DebugFlags)value);
     if (enumname == "Texture::Filter")
@@ -880,6 +940,8 @@ const char* lua_stringFromEnumGlobal(std::string& enumname, unsigned int value)
         return lua_stringFromEnum_TextureWrap((Texture::Wrap)value);
     if (enumname == "Touch::TouchEvent")
         return lua_stringFromEnum_TouchTouchEvent((Touch::TouchEvent)value);
+    if (enumname == "VertexFormat::Type")
+        return lua_stringFromEnum_VertexFormatType((VertexFormat::Type)value);
     if (enumname == "VertexFormat::Usage")
         return lua_stringFromEnum_VertexFormatUsage((VertexFormat::Usage)value);
 
@@ -13,7 +13,9 @@
 #include "lua_DepthStencilTargetFormat.h"
 #include "lua_FontJustify.h"
 #include "lua_FontStyle.h"
+#include "lua_FrameGovernorSubsystem.h"
 #include "lua_GameClearFlags.h"
+#include "lua_GameFramePhase.h"
 #include "lua_GameState.h"
 #include "lua_GamepadButtonState.h"
 #include "lua_GamepadGamepadEvent.h"
@@ -34,11 +36,13 @@
 #include "lua_PropertiesType.h"
 #include "lua_RenderStateAutoBinding.h"
 #include "lua_RenderStateBlend.h"
+#include "lua_RenderStatsCounter.h"
 #include "lua_SceneDebugFlags.h"
 #include "lua_TextureFilter.h"
 #include "lua_TextureFormat.h"
 #include "lua_TextureWrap.h"
 #include "lua_TouchTouchEvent.h"
+#include "lua_VertexFormatType.h"
 #include "lua_VertexFormatUsage.h"
 
 namespace gameplay
@@ -6,10 +6,15 @@ namespace gameplay
 
 // Lua bindings for Mesh.
 int lua_Mesh__gc(lua_State* state);
+int lua_Mesh_addLod(lua_State* state);
+int lua_Mesh_addLodPart(lua_State* state);
 int lua_Mesh_addPart(lua_State* state);
 int lua_Mesh_addRef(lua_State* state);
 int lua_Mesh_getBoundingBox(lua_State* state);
 int lua_Mesh_getBoundingSphere(lua_State* state);
+int lua_Mesh_getLod(lua_State* state);
+int lua_Mesh_getLodCount(lua_State* state);
+int lua_Mesh_getLodError(lua_State* state);
 int lua_Mesh_getPart(lua_State* state);
 int lua_Mesh_getPartCount(lua_State* state);
 int lua_Mesh_getPrimitiveType(lua_State* state);
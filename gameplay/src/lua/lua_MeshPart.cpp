@@ -16,6 +16,8 @@ void luaRegister_MeshPart()
         {"getIndexBuffer", lua_MeshPart_getIndexBuffer},
         {"getIndexCount", lua_MeshPart_getIndexCount},
         {"getIndexFormat", lua_MeshPart_getIndexFormat},
+        {"getLod", lua_MeshPart_getLod},
+        {"getLodCount", lua_MeshPart_getLodCount},
         {"getMeshIndex", lua_MeshPart_getMeshIndex},
         {"getPrimitiveType", lua_MeshPart_getPrimitiveType},
         {"isDynamic", lua_MeshPart_isDynamic},
@@ -194,6 +196,93 @@ int lua_MeshPart_getIndexFormat(lua_State* state)
     return 0;
 }
 
+int lua_MeshPart_getLod(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                unsigned int param1 = (unsigned int)luaL_checkunsigned(state, 2);
+
+                MeshPart* instance = getInstance(state);
+                void* returnPtr = (void*)instance->getLod(param1);
+                if (returnPtr)
+                {
+                    ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(ScriptUtil::LuaObject));
+                    object->instance = returnPtr;
+                    object->owns = false;
+                    luaL_getmetatable(state, "MeshPart");
+                    lua_setmetatable(state, -2);
+                }
+                else
+                {
+                    lua_pushnil(state);
+                }
+
+                return 1;
+            }
+            else
+            {
+                lua_pushstring(state, "lua_MeshPart_getLod - Failed to match the given parameters to a valid function signature.");
+                lua_error(state);
+            }
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_MeshPart_getLodCount(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                MeshPart* instance = getInstance(state);
+                unsigned int result = instance->getLodCount();
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+            else
+            {
+                lua_pushstring(state, "lua_MeshPart_getLodCount - Failed to match the given parameters to a valid function signature.");
+                lua_error(state);
+            }
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_MeshPart_getMeshIndex(lua_State* state)
 {
     // Get the number of parameters.
@@ -9,6 +9,8 @@ int lua_MeshPart__gc(lua_State* state);
 int lua_MeshPart_getIndexBuffer(lua_State* state);
 int lua_MeshPart_getIndexCount(lua_State* state);
 int lua_MeshPart_getIndexFormat(lua_State* state);
+int lua_MeshPart_getLod(lua_State* state);
+int lua_MeshPart_getLodCount(lua_State* state);
 int lua_MeshPart_getMeshIndex(lua_State* state);
 int lua_MeshPart_getPrimitiveType(lua_State* state);
 int lua_MeshPart_isDynamic(lua_State* state);
@@ -12,6 +12,9 @@ int lua_MeshSkin_getJointIndex(lua_State* state);
 int lua_MeshSkin_getMatrixPalette(lua_State* state);
 int lua_MeshSkin_getMatrixPaletteSize(lua_State* state);
 int lua_MeshSkin_getModel(lua_State* state);
+int lua_MeshSkin_getPartCount(lua_State* state);
+int lua_MeshSkin_getPartJoint(lua_State* state);
+int lua_MeshSkin_getPartJointCount(lua_State* state);
 int lua_MeshSkin_getRootJoint(lua_State* state);
 int lua_MeshSkin_setBindShape(lua_State* state);
 int lua_MeshSkin_setRootJoint(lua_State* state);
@@ -20,6 +20,8 @@ void luaRegister_Model()
     {
         {"addRef", lua_Model_addRef},
         {"draw", lua_Model_draw},
+        {"getLod", lua_Model_getLod},
+        {"getLodThreshold", lua_Model_getLodThreshold},
         {"getMaterial", lua_Model_getMaterial},
         {"getMesh", lua_Model_getMesh},
         {"getMeshPartCount", lua_Model_getMeshPartCount},
@@ -28,6 +30,7 @@ void luaRegister_Model()
         {"getSkin", lua_Model_getSkin},
         {"hasMaterial", lua_Model_hasMaterial},
         {"release", lua_Model_release},
+        {"setLodThreshold", lua_Model_setLodThreshold},
         {"setMaterial", lua_Model_setMaterial},
         {NULL, NULL}
     };
@@ -176,6 +179,80 @@ int lua_Model_draw(lua_State* state)
     return 0;
 }
 
+int lua_Model_getLod(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                Model* instance = getInstance(state);
+                unsigned int result = instance->getLod();
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+            else
+            {
+                lua_pushstring(state, "lua_Model_getLod - Failed to match the given parameters to a valid function signature.");
+                lua_error(state);
+            }
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_Model_getLodThreshold(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                Model* instance = getInstance(state);
+                float result = instance->getLodThreshold();
+
+                // Push the return value onto the stack.
+                lua_pushnumber(state, result);
+
+                return 1;
+            }
+            else
+            {
+                lua_pushstring(state, "lua_Model_getLodThreshold - Failed to match the given parameters to a valid function signature.");
+                lua_error(state);
+            }
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Model_getMaterial(lua_State* state)
 {
     // Get the number of parameters.
@@ -541,6 +618,44 @@ int lua_Model_release(lua_State* state)
     return 0;
 }
 
+int lua_Model_setLodThreshold(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TNUMBER)
+            {
+                // Get parameter 1 off the stack.
+                float param1 = (float)luaL_checknumber(state, 2);
+
+                Model* instance = getInstance(state);
+                instance->setLodThreshold(param1);
+                
+                return 0;
+            }
+            else
+            {
+                lua_pushstring(state, "lua_Model_setLodThreshold - Failed to match the given parameters to a valid function signature.");
+                lua_error(state);
+            }
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Model_setMaterial(lua_State* state)
 {
     // Get the number of parameters.
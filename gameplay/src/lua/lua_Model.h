@@ -8,6 +8,8 @@ namespace gameplay
 int lua_Model__gc(lua_State* state);
 int lua_Model_addRef(lua_State* state);
 int lua_Model_draw(lua_State* state);
+int lua_Model_getLod(lua_State* state);
+int lua_Model_getLodThreshold(lua_State* state);
 int lua_Model_getMaterial(lua_State* state);
 int lua_Model_getMesh(lua_State* state);
 int lua_Model_getMeshPartCount(lua_State* state);
@@ -16,6 +18,7 @@ int lua_Model_getRefCount(lua_State* state);
 int lua_Model_getSkin(lua_State* state);
 int lua_Model_hasMaterial(lua_State* state);
 int lua_Model_release(lua_State* state);
+int lua_Model_setLodThreshold(lua_State* state);
 int lua_Model_setMaterial(lua_State* state);
 int lua_Model_static_create(lua_State* state);
 
@@ -0,0 +1,28 @@
+#ifndef LUA_RENDERSTATS_H_
+#define LUA_RENDERSTATS_H_
+
+namespace gameplay
+{
+
+// Lua bindings for RenderStats.
+int lua_RenderStats__gc(lua_State* state);
+int lua_RenderStats_static_getAverage(lua_State* state);
+int lua_RenderStats_static_getCount(lua_State* state);
+int lua_RenderStats_static_getDrawCallCount(lua_State* state);
+int lua_RenderStats_static_getHistoryCount(lua_State* state);
+int lua_RenderStats_static_getHistoryValue(lua_State* state);
+int lua_RenderStats_static_getPassCount(lua_State* state);
+int lua_RenderStats_static_getPassName(lua_State* state);
+int lua_RenderStats_static_getPassValue(lua_State* state);
+int lua_RenderStats_static_getPeak(lua_State* state);
+int lua_RenderStats_static_getTriangleCount(lua_State* state);
+int lua_RenderStats_static_isOverlayVisible(lua_State* state);
+int lua_RenderStats_static_isPassStatsEnabled(lua_State* state);
+int lua_RenderStats_static_setOverlay(lua_State* state);
+int lua_RenderStats_static_setPassStatsEnabled(lua_State* state);
+
+void luaRegister_RenderStats();
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include "Base.h"
+#include "lua_RenderStatsCounter.h"
+
+namespace gameplay
+{
+
+static const char* enumStringEmpty = "";
+
+static const char* luaEnumString_RenderStatsCounter_DRAW_CALLS = "DRAW_CALLS";
+static const char* luaEnumString_RenderStatsCounter_TRIANGLES = "TRIANGLES";
+static const char* luaEnumString_RenderStatsCounter_STATE_CHANGES = "STATE_CHANGES";
+static const char* luaEnumString_RenderStatsCounter_UNIFORM_UPLOADS = "UNIFORM_UPLOADS";
+static const char* luaEnumString_RenderStatsCounter_TEXTURE_BINDS = "TEXTURE_BINDS";
+static const char* luaEnumString_RenderStatsCounter_BATCH_VERTICES = "BATCH_VERTICES";
+static const char* luaEnumString_RenderStatsCounter_COUNTER_COUNT = "COUNTER_COUNT";
+
+RenderStats::Counter lua_enumFromString_RenderStatsCounter(const char* s)
+{
+    if (strcmp(s, luaEnumString_RenderStatsCounter_DRAW_CALLS) == 0)
+        return RenderStats::DRAW_CALLS;
+    if (strcmp(s, luaEnumString_RenderStatsCounter_TRIANGLES) == 0)
+        return RenderStats::TRIANGLES;
+    if (strcmp(s, luaEnumString_RenderStatsCounter_STATE_CHANGES) == 0)
+        return RenderStats::STATE_CHANGES;
+    if (strcmp(s, luaEnumString_RenderStatsCounter_UNIFORM_UPLOADS) == 0)
+        return RenderStats::UNIFORM_UPLOADS;
+    if (strcmp(s, luaEnumString_RenderStatsCounter_TEXTURE_BINDS) == 0)
+        return RenderStats::TEXTURE_BINDS;
+    if (strcmp(s, luaEnumString_RenderStatsCounter_BATCH_VERTICES) == 0)
+        return RenderStats::BATCH_VERTICES;
+    if (strcmp(s, luaEnumString_RenderStatsCounter_COUNTER_COUNT) == 0)
+        return RenderStats::COUNTER_COUNT;
+    GP_ERROR("Invalid enumeration value '%s' for enumeration RenderStats::Counter.", s);
+    return RenderStats::DRAW_CALLS;
+}
+
+const char* lua_stringFromEnum_RenderStatsCounter(RenderStats::Counter e)
+{
+    if (e == RenderStats::DRAW_CALLS)
+        return luaEnumString_RenderStatsCounter_DRAW_CALLS;
+    if (e == RenderStats::TRIANGLES)
+        return luaEnumString_RenderStatsCounter_TRIANGLES;
+    if (e == RenderStats::STATE_CHANGES)
+        return luaEnumString_RenderStatsCounter_STATE_CHANGES;
+    if (e == RenderStats::UNIFORM_UPLOADS)
+        return luaEnumString_RenderStatsCounter_UNIFORM_UPLOADS;
+    if (e == RenderStats::TEXTURE_BINDS)
+        return luaEnumString_RenderStatsCounter_TEXTURE_BINDS;
+    if (e == RenderStats::BATCH_VERTICES)
+        return luaEnumString_RenderStatsCounter_BATCH_VERTICES;
+    if (e == RenderStats::COUNTER_COUNT)
+        return luaEnumString_RenderStatsCounter_COUNTER_COUNT;
+    GP_ERROR("Invalid enumeration value '%d' for enumeration RenderStats::Counter.", e);
+    return enumStringEmpty;
+}
+
+}
@@ -0,0 +1,15 @@
+#ifndef LUA_RENDERSTATSCOUNTER_H_
+#define LUA_RENDERSTATSCOUNTER_H_
+
+#include "RenderStats.h"
+
+namespace gameplay
+{
+
+// Lua bindings for enum conversion functions for RenderStats::Counter.
+RenderStats::Counter lua_enumFromString_RenderStatsCounter(const char* s);
+const char* lua_stringFromEnum_RenderStatsCounter(RenderStats::Counter e);
+
+}
+
+#endif
@@ -17,6 +17,8 @@ int lua_Scene_getFirstNode(lua_State* state);
 int lua_Scene_getId(lua_State* state);
 int lua_Scene_getNodeCount(lua_State* state);
 int lua_Scene_getRefCount(lua_State* state);
+int lua_Scene_getVisibleNode(lua_State* state);
+int lua_Scene_getVisibleNodeCount(lua_State* state);
 int lua_Scene_release(lua_State* state);
 int lua_Scene_removeAllNodes(lua_State* state);
 int lua_Scene_removeNode(lua_State* state);
@@ -3,6 +3,7 @@
 #include "lua_VertexFormatElement.h"
 #include "Base.h"
 #include "VertexFormat.h"
+#include "lua_VertexFormatType.h"
 #include "lua_VertexFormatUsage.h"
 
 namespace gameplay
@@ -12,7 +13,9 @@ void luaRegister_VertexFormatElement()
 {
     const luaL_Reg lua_members[] = 
     {
+        {"getByteSize", lua_VertexFormatElement_getByteSize},
         {"size", lua_VertexFormatElement_size},
+        {"type", lua_VertexFormatElement_type},
         {"usage", lua_VertexFormatElement_usage},
         {NULL, NULL}
     };
@@ -131,9 +134,84 @@ int lua_VertexFormatElement__init(lua_State* state)
             }
             break;
         }
+        case 3:
+        {
+            if ((lua_type(state, 1) == LUA_TSTRING || lua_type(state, 1) == LUA_TNIL) &&
+                lua_type(state, 2) == LUA_TNUMBER &&
+                (lua_type(state, 3) == LUA_TSTRING || lua_type(state, 3) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                VertexFormat::Usage param1 = (VertexFormat::Usage)lua_enumFromString_VertexFormatUsage(luaL_checkstring(state, 1));
+
+                // Get parameter 2 off the stack.
+                unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 2);
+
+                // Get parameter 3 off the stack.
+                VertexFormat::Type param3 = (VertexFormat::Type)lua_enumFromString_VertexFormatType(luaL_checkstring(state, 3));
+
+                void* returnPtr = (void*)new VertexFormat::Element(param1, param2, param3);
+                if (returnPtr)
+                {
+                    ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)lua_newuserdata(state, sizeof(ScriptUtil::LuaObject));
+                    object->instance = returnPtr;
+                    object->owns = true;
+                    luaL_getmetatable(state, "VertexFormatElement");
+                    lua_setmetatable(state, -2);
+                }
+                else
+                {
+                    lua_pushnil(state);
+                }
+
+                return 1;
+            }
+            else
+            {
+                lua_pushstring(state, "lua_VertexFormatElement__init - Failed to match the given parameters to a valid function signature.");
+                lua_error(state);
+            }
+            break;
+        }
         default:
         {
-            lua_pushstring(state, "Invalid number of parameters (expected 0 or 2).");
+            lua_pushstring(state, "Invalid number of parameters (expected 0, 2 or 3).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_VertexFormatElement_getByteSize(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                VertexFormat::Element* instance = getInstance(state);
+                unsigned int result = instance->getByteSize();
+
+                // Push the return value onto the stack.
+                lua_pushunsigned(state, result);
+
+                return 1;
+            }
+            else
+            {
+                lua_pushstring(state, "lua_VertexFormatElement_getByteSize - Failed to match the given parameters to a valid function signature.");
+                lua_error(state);
+            }
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
             lua_error(state);
             break;
         }
@@ -170,6 +248,35 @@ int lua_VertexFormatElement_size(lua_State* state)
     }
 }
 
+int lua_VertexFormatElement_type(lua_State* state)
+{
+    // Validate the number of parameters.
+    if (lua_gettop(state) > 2)
+    {
+        lua_pushstring(state, "Invalid number of parameters (expected 1 or 2).");
+        lua_error(state);
+    }
+
+    VertexFormat::Element* instance = getInstance(state);
+    if (lua_gettop(state) == 2)
+    {
+        // Get parameter 2 off the stack.
+        VertexFormat::Type param2 = (VertexFormat::Type)lua_enumFromString_VertexFormatType(luaL_checkstring(state, 2));
+
+        instance->type = param2;
+        return 0;
+    }
+    else
+    {
+        VertexFormat::Type result = instance->type;
+
+        // Push the return value onto the stack.
+        lua_pushstring(state, lua_stringFromEnum_VertexFormatType(result));
+
+        return 1;
+    }
+}
+
 int lua_VertexFormatElement_usage(lua_State* state)
 {
     // Validate the number of parameters.
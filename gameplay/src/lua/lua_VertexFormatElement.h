@@ -7,7 +7,9 @@ namespace gameplay
 // Lua bindings for VertexFormat::Element.
 int lua_VertexFormatElement__gc(lua_State* state);
 int lua_VertexFormatElement__init(lua_State* state);
+int lua_VertexFormatElement_getByteSize(lua_State* state);
 int lua_VertexFormatElement_size(lua_State* state);
+int lua_VertexFormatElement_type(lua_State* state);
 int lua_VertexFormatElement_usage(lua_State* state);
 
 void luaRegister_VertexFormatElement();
@@ -0,0 +1,52 @@
+#include "Base.h"
+#include "lua_VertexFormatType.h"
+
+namespace gameplay
+{
+
+static const char* enumStringEmpty = "";
+
+static const char* luaEnumString_VertexFormatType_FLOAT = "FLOAT";
+static const char* luaEnumString_VertexFormatType_HALF_FLOAT = "HALF_FLOAT";
+static const char* luaEnumString_VertexFormatType_SNORM8 = "SNORM8";
+static const char* luaEnumString_VertexFormatType_UNORM8 = "UNORM8";
+static const char* luaEnumString_VertexFormatType_UINT8 = "UINT8";
+static const char* luaEnumString_VertexFormatType_SNORM10_10_10_2 = "SNORM10_10_10_2";
+
+VertexFormat::Type lua_enumFromString_VertexFormatType(const char* s)
+{
+    if (strcmp(s, luaEnumString_VertexFormatType_FLOAT) == 0)
+        return VertexFormat::FLOAT;
+    if (strcmp(s, luaEnumString_VertexFormatType_HALF_FLOAT) == 0)
+        return VertexFormat::HALF_FLOAT;
+    if (strcmp(s, luaEnumString_VertexFormatType_SNORM8) == 0)
+        return VertexFormat::SNORM8;
+    if (strcmp(s, luaEnumString_VertexFormatType_UNORM8) == 0)
+        return VertexFormat::UNORM8;
+    if (strcmp(s, luaEnumString_VertexFormatType_UINT8) == 0)
+        return VertexFormat::UINT8;
+    if (strcmp(s, luaEnumString_VertexFormatType_SNORM10_10_10_2) == 0)
+        return VertexFormat::SNORM10_10_10_2;
+    GP_ERROR("Invalid enumeration value '%s' for enumeration VertexFormat::Type.", s);
+    return VertexFormat::FLOAT;
+}
+
+const char* lua_stringFromEnum_VertexFormatType(VertexFormat::Type e)
+{
+    if (e == VertexFormat::FLOAT)
+        return luaEnumString_VertexFormatType_FLOAT;
+    if (e == VertexFormat::HALF_FLOAT)
+        return luaEnumString_VertexFormatType_HALF_FLOAT;
+    if (e == VertexFormat::SNORM8)
+        return luaEnumString_VertexFormatType_SNORM8;
+    if (e == VertexFormat::UNORM8)
+        return luaEnumString_VertexFormatType_UNORM8;
+    if (e == VertexFormat::UINT8)
+        return luaEnumString_VertexFormatType_UINT8;
+    if (e == VertexFormat::SNORM10_10_10_2)
+        return luaEnumString_VertexFormatType_SNORM10_10_10_2;
+    GP_ERROR("Invalid enumeration value '%d' for enumeration VertexFormat::Type.", e);
+    return enumStringEmpty;
+}
+
+}
@@ -0,0 +1,15 @@
+#ifndef LUA_VERTEXFORMATTYPE_H_
+#define LUA_VERTEXFORMATTYPE_H_
+
+#include "VertexFormat.h"
+
+namespace gameplay
+{
+
+// Lua bindings for enum conversion functions for VertexFormat::Type.
+VertexFormat::Type lua_enumFromString_VertexFormatType(const char* s);
+const char* lua_stringFromEnum_VertexFormatType(VertexFormat::Type e);
+
+}
+
+#endif
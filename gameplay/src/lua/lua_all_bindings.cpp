@@ -42,6 +42,7 @@ void lua_RegisterAllBindings()
     luaRegister_FontText();
     luaRegister_Form();
     luaRegister_FrameBuffer();
+    luaRegister_FrameGovernor();
     luaRegister_Frustum();
     luaRegister_Game();
     luaRegister_Gamepad();
@@ -95,6 +96,7 @@ void lua_RegisterAllBindings()
     luaRegister_Ref();
     luaRegister_RenderState();
     luaRegister_RenderStateStateBlock();
+    luaRegister_RenderStats();
     luaRegister_RenderTarget();
     luaRegister_Scene();
     luaRegister_ScreenDisplayer();
@@ -37,6 +37,7 @@
 #include "lua_FontText.h"
 #include "lua_Form.h"
 #include "lua_FrameBuffer.h"
+#include "lua_FrameGovernor.h"
 #include "lua_Frustum.h"
 #include "lua_Game.h"
 #include "lua_Gamepad.h"
@@ -90,6 +91,7 @@
 #include "lua_Ref.h"
 #include "lua_RenderState.h"
 #include "lua_RenderStateStateBlock.h"
+#include "lua_RenderStats.h"
 #include "lua_RenderTarget.h"
 #include "lua_Scene.h"
 #include "lua_ScreenDisplayer.h"